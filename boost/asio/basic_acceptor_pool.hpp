@@ -0,0 +1,241 @@
+//
+// basic_acceptor_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_BASIC_ACCEPTOR_POOL_HPP
+#define BOOST_ASIO_BASIC_ACCEPTOR_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_SO_REUSEPORT) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include <vector>
+#include <boost/asio/basic_socket_acceptor.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/throw_error.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/socket_acceptor_service.hpp>
+#include <boost/asio/socket_base.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// A set of acceptors listening on the same endpoint.
+/**
+ * The basic_acceptor_pool class template opens one acceptor per io_service,
+ * each bound to the same endpoint with the @c socket_base::reuse_port option
+ * set. The kernel distributes incoming connections between the acceptors, so
+ * that a server running one io_service per thread can accept connections on
+ * every thread without the threads contending for a single listening socket.
+ *
+ * If the endpoint passed to the constructor has a port number of 0, the port
+ * chosen for the first acceptor is used for the rest.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe. The acceptors themselves have the same thread
+ * safety as basic_socket_acceptor.
+ *
+ * @par Example
+ * Accepting connections on several threads:
+ * @code
+ * std::vector<boost::asio::io_service*> io_services = ...;
+ * boost::asio::ip::tcp::acceptor_pool pool(
+ *     boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port));
+ * for (std::size_t i = 0; i < io_services.size(); ++i)
+ *   pool.add(*io_services[i]);
+ * for (std::size_t i = 0; i < pool.size(); ++i)
+ *   start_accept(pool[i]);
+ * @endcode
+ */
+template <typename Protocol,
+    typename SocketAcceptorService = socket_acceptor_service<Protocol> >
+class basic_acceptor_pool
+  : private noncopyable
+{
+public:
+  /// The protocol type.
+  typedef Protocol protocol_type;
+
+  /// The endpoint type.
+  typedef typename Protocol::endpoint endpoint_type;
+
+  /// The type of the acceptors in the pool.
+  typedef basic_socket_acceptor<Protocol, SocketAcceptorService> acceptor_type;
+
+  /// Construct an empty acceptor pool.
+  /**
+   * @param endpoint The endpoint to which every acceptor will be bound.
+   *
+   * @param backlog The maximum length of the queue of pending connections for
+   * each acceptor.
+   */
+  explicit basic_acceptor_pool(const endpoint_type& endpoint,
+      int backlog = socket_base::max_connections)
+    : endpoint_(endpoint),
+      backlog_(backlog)
+  {
+  }
+
+  /// Destroys the acceptor pool, closing all of its acceptors.
+  ~basic_acceptor_pool()
+  {
+    for (std::size_t i = 0; i < acceptors_.size(); ++i)
+      delete acceptors_[i];
+  }
+
+  /// Add an acceptor that dispatches its handlers using the given io_service.
+  /**
+   * Opens an acceptor, sets the @c socket_base::reuse_address and
+   * @c socket_base::reuse_port options, binds it to the pool's endpoint and
+   * puts it into the listening state.
+   *
+   * @param io_service The io_service object that the acceptor will use to
+   * dispatch handlers for any asynchronous operations performed on it.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   */
+  void add(boost::asio::io_service& io_service)
+  {
+    boost::system::error_code ec;
+    add(io_service, ec);
+    boost::asio::detail::throw_error(ec, "add");
+  }
+
+  /// Add an acceptor that dispatches its handlers using the given io_service.
+  /**
+   * Opens an acceptor, sets the @c socket_base::reuse_address and
+   * @c socket_base::reuse_port options, binds it to the pool's endpoint and
+   * puts it into the listening state.
+   *
+   * @param io_service The io_service object that the acceptor will use to
+   * dispatch handlers for any asynchronous operations performed on it.
+   *
+   * @param ec Set to indicate what error occurred, if any. On failure the pool
+   * is unchanged.
+   */
+  boost::system::error_code add(boost::asio::io_service& io_service,
+      boost::system::error_code& ec)
+  {
+    acceptors_.reserve(acceptors_.size() + 1);
+    acceptor_type* acceptor = new acceptor_type(io_service);
+
+    acceptor->open(endpoint_.protocol(), ec);
+    if (!ec)
+      acceptor->set_option(socket_base::reuse_address(true), ec);
+    if (!ec)
+      acceptor->set_option(socket_base::reuse_port(true), ec);
+    if (!ec)
+      acceptor->bind(endpoint_, ec);
+    if (!ec)
+      acceptor->listen(backlog_, ec);
+
+    // Later acceptors must bind to the port chosen for the first one.
+    if (!ec && acceptors_.empty())
+    {
+      endpoint_type bound_endpoint = acceptor->local_endpoint(ec);
+      if (!ec)
+        endpoint_ = bound_endpoint;
+    }
+
+    if (ec)
+    {
+      delete acceptor;
+      return ec;
+    }
+
+    acceptors_.push_back(acceptor);
+    return ec;
+  }
+
+  /// Get the number of acceptors in the pool.
+  std::size_t size() const
+  {
+    return acceptors_.size();
+  }
+
+  /// Get the acceptor at the given position in the pool.
+  acceptor_type& operator[](std::size_t i)
+  {
+    return *acceptors_[i];
+  }
+
+  /// Get the acceptor at the given position in the pool.
+  const acceptor_type& operator[](std::size_t i) const
+  {
+    return *acceptors_[i];
+  }
+
+  /// Get the endpoint to which the acceptors are bound.
+  /**
+   * Once an acceptor has been added, the returned endpoint holds the port
+   * number actually in use.
+   */
+  endpoint_type local_endpoint() const
+  {
+    return endpoint_;
+  }
+
+  /// Close all acceptors in the pool.
+  /**
+   * Any asynchronous accept operations will be cancelled immediately. The
+   * acceptors remain in the pool, but are no longer open.
+   */
+  void close()
+  {
+    boost::system::error_code ec;
+    close(ec);
+    boost::asio::detail::throw_error(ec, "close");
+  }
+
+  /// Close all acceptors in the pool.
+  /**
+   * Any asynchronous accept operations will be cancelled immediately. The
+   * acceptors remain in the pool, but are no longer open.
+   *
+   * @param ec Set to indicate what error occurred, if any. Every acceptor is
+   * closed even if an earlier one fails.
+   */
+  boost::system::error_code close(boost::system::error_code& ec)
+  {
+    ec = boost::system::error_code();
+    for (std::size_t i = 0; i < acceptors_.size(); ++i)
+    {
+      boost::system::error_code close_ec;
+      acceptors_[i]->close(close_ec);
+      if (close_ec && !ec)
+        ec = close_ec;
+    }
+    return ec;
+  }
+
+private:
+  endpoint_type endpoint_;
+  int backlog_;
+  std::vector<acceptor_type*> acceptors_;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_SO_REUSEPORT)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // BOOST_ASIO_BASIC_ACCEPTOR_POOL_HPP
@@ -576,6 +576,197 @@ public:
         BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
   }
 
+#if !defined(BOOST_ASIO_HAS_IOCP) || defined(GENERATING_DOCUMENTATION)
+  /// Send a batch of datagrams to the specified endpoints.
+  /**
+   * This function is used to send several datagrams using a single system
+   * call, where supported. The function call will block until at least one
+   * datagram has been sent successfully or an error occurs.
+   *
+   * @param buffers An array of buffers, each of which is sent as one datagram.
+   *
+   * @param destinations An array of the remote endpoints to which the
+   * corresponding datagrams will be sent.
+   *
+   * @param count The number of elements in the buffers and destinations
+   * arrays.
+   *
+   * @returns The number of datagrams sent. This may be fewer than @c count.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   *
+   * @note Not available when I/O completion ports are used.
+   */
+  std::size_t send_batch(const boost::asio::const_buffer* buffers,
+      const endpoint_type* destinations, std::size_t count)
+  {
+    boost::system::error_code ec;
+    std::size_t s = this->get_service().send_batch(
+        this->get_implementation(), buffers, destinations, count, 0, ec);
+    boost::asio::detail::throw_error(ec, "send_batch");
+    return s;
+  }
+
+  /// Send a batch of datagrams to the specified endpoints.
+  /**
+   * This function is used to send several datagrams using a single system
+   * call, where supported. The function call will block until at least one
+   * datagram has been sent successfully or an error occurs.
+   *
+   * @param buffers An array of buffers, each of which is sent as one datagram.
+   *
+   * @param destinations An array of the remote endpoints to which the
+   * corresponding datagrams will be sent.
+   *
+   * @param count The number of elements in the buffers and destinations
+   * arrays.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @returns The number of datagrams sent. This may be fewer than @c count.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   */
+  std::size_t send_batch(const boost::asio::const_buffer* buffers,
+      const endpoint_type* destinations, std::size_t count,
+      socket_base::message_flags flags)
+  {
+    boost::system::error_code ec;
+    std::size_t s = this->get_service().send_batch(
+        this->get_implementation(), buffers, destinations, count, flags, ec);
+    boost::asio::detail::throw_error(ec, "send_batch");
+    return s;
+  }
+
+  /// Send a batch of datagrams to the specified endpoints.
+  /**
+   * This function is used to send several datagrams using a single system
+   * call, where supported. The function call will block until at least one
+   * datagram has been sent successfully or an error occurs.
+   *
+   * @param buffers An array of buffers, each of which is sent as one datagram.
+   *
+   * @param destinations An array of the remote endpoints to which the
+   * corresponding datagrams will be sent.
+   *
+   * @param count The number of elements in the buffers and destinations
+   * arrays.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of datagrams sent.
+   */
+  std::size_t send_batch(const boost::asio::const_buffer* buffers,
+      const endpoint_type* destinations, std::size_t count,
+      socket_base::message_flags flags, boost::system::error_code& ec)
+  {
+    return this->get_service().send_batch(this->get_implementation(),
+        buffers, destinations, count, flags, ec);
+  }
+
+  /// Start an asynchronous send of a batch of datagrams.
+  /**
+   * This function is used to asynchronously send several datagrams using a
+   * single system call, where supported. The function call always returns
+   * immediately.
+   *
+   * @param buffers An array of buffers, each of which is sent as one datagram.
+   * Ownership of the array and the underlying memory blocks is retained by
+   * the caller, which must guarantee that they remain valid until the handler
+   * is called.
+   *
+   * @param destinations An array of the remote endpoints to which the
+   * corresponding datagrams will be sent. Ownership of the array is retained
+   * by the caller, which must guarantee that it remains valid until the
+   * handler is called.
+   *
+   * @param count The number of elements in the buffers and destinations
+   * arrays.
+   *
+   * @param handler The handler to be called when the send operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t datagrams_transferred       // Number of datagrams sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   *
+   * @note The operation may send fewer than @c count datagrams. Consider
+   * starting another send for the remainder.
+   */
+  template <typename WriteHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(WriteHandler,
+      void (boost::system::error_code, std::size_t))
+  async_send_batch(const boost::asio::const_buffer* buffers,
+      const endpoint_type* destinations, std::size_t count,
+      BOOST_ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a WriteHandler.
+    BOOST_ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+    return this->get_service().async_send_batch(
+        this->get_implementation(), buffers, destinations, count, 0,
+        BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
+  }
+
+  /// Start an asynchronous send of a batch of datagrams.
+  /**
+   * This function is used to asynchronously send several datagrams using a
+   * single system call, where supported. The function call always returns
+   * immediately.
+   *
+   * @param buffers An array of buffers, each of which is sent as one datagram.
+   * Ownership of the array and the underlying memory blocks is retained by
+   * the caller, which must guarantee that they remain valid until the handler
+   * is called.
+   *
+   * @param destinations An array of the remote endpoints to which the
+   * corresponding datagrams will be sent. Ownership of the array is retained
+   * by the caller, which must guarantee that it remains valid until the
+   * handler is called.
+   *
+   * @param count The number of elements in the buffers and destinations
+   * arrays.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param handler The handler to be called when the send operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t datagrams_transferred       // Number of datagrams sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   */
+  template <typename WriteHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(WriteHandler,
+      void (boost::system::error_code, std::size_t))
+  async_send_batch(const boost::asio::const_buffer* buffers,
+      const endpoint_type* destinations, std::size_t count,
+      socket_base::message_flags flags,
+      BOOST_ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a WriteHandler.
+    BOOST_ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+    return this->get_service().async_send_batch(
+        this->get_implementation(), buffers, destinations, count, flags,
+        BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
+  }
+#endif // !defined(BOOST_ASIO_HAS_IOCP) || defined(GENERATING_DOCUMENTATION)
+
   /// Receive some data on a connected socket.
   /**
    * This function is used to receive data on the datagram socket. The function
@@ -943,6 +1134,221 @@ public:
         this->get_implementation(), buffers, sender_endpoint, flags,
         BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
   }
+
+#if !defined(BOOST_ASIO_HAS_IOCP) || defined(GENERATING_DOCUMENTATION)
+  /// Receive a batch of datagrams with the endpoints of the senders.
+  /**
+   * This function is used to receive several datagrams using a single system
+   * call, where supported. The function call will block until at least one
+   * datagram has been received successfully or an error occurs.
+   *
+   * @param buffers An array of buffers, each of which receives one datagram.
+   *
+   * @param sender_endpoints An array of endpoint objects that receive the
+   * endpoints of the remote senders of the corresponding datagrams.
+   *
+   * @param sizes An array that receives the length of each datagram.
+   *
+   * @param count The number of elements in the buffers, sender_endpoints and
+   * sizes arrays.
+   *
+   * @returns The number of datagrams received. Only this many elements of the
+   * arrays are updated.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   *
+   * @note Not available when I/O completion ports are used.
+   */
+  std::size_t receive_batch(const boost::asio::mutable_buffer* buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes, std::size_t count)
+  {
+    boost::system::error_code ec;
+    std::size_t s = this->get_service().receive_batch(
+        this->get_implementation(), buffers, sender_endpoints,
+        sizes, count, 0, ec);
+    boost::asio::detail::throw_error(ec, "receive_batch");
+    return s;
+  }
+
+  /// Receive a batch of datagrams with the endpoints of the senders.
+  /**
+   * This function is used to receive several datagrams using a single system
+   * call, where supported. The function call will block until at least one
+   * datagram has been received successfully or an error occurs.
+   *
+   * @param buffers An array of buffers, each of which receives one datagram.
+   *
+   * @param sender_endpoints An array of endpoint objects that receive the
+   * endpoints of the remote senders of the corresponding datagrams.
+   *
+   * @param sizes An array that receives the length of each datagram.
+   *
+   * @param count The number of elements in the buffers, sender_endpoints and
+   * sizes arrays.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @returns The number of datagrams received. Only this many elements of the
+   * arrays are updated.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   */
+  std::size_t receive_batch(const boost::asio::mutable_buffer* buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes, std::size_t count,
+      socket_base::message_flags flags)
+  {
+    boost::system::error_code ec;
+    std::size_t s = this->get_service().receive_batch(
+        this->get_implementation(), buffers, sender_endpoints,
+        sizes, count, flags, ec);
+    boost::asio::detail::throw_error(ec, "receive_batch");
+    return s;
+  }
+
+  /// Receive a batch of datagrams with the endpoints of the senders.
+  /**
+   * This function is used to receive several datagrams using a single system
+   * call, where supported. The function call will block until at least one
+   * datagram has been received successfully or an error occurs.
+   *
+   * @param buffers An array of buffers, each of which receives one datagram.
+   *
+   * @param sender_endpoints An array of endpoint objects that receive the
+   * endpoints of the remote senders of the corresponding datagrams.
+   *
+   * @param sizes An array that receives the length of each datagram.
+   *
+   * @param count The number of elements in the buffers, sender_endpoints and
+   * sizes arrays.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of datagrams received.
+   */
+  std::size_t receive_batch(const boost::asio::mutable_buffer* buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes, std::size_t count,
+      socket_base::message_flags flags, boost::system::error_code& ec)
+  {
+    return this->get_service().receive_batch(this->get_implementation(),
+        buffers, sender_endpoints, sizes, count, flags, ec);
+  }
+
+  /// Start an asynchronous receive of a batch of datagrams.
+  /**
+   * This function is used to asynchronously receive several datagrams using a
+   * single system call, where supported. The function call always returns
+   * immediately.
+   *
+   * @param buffers An array of buffers, each of which receives one datagram.
+   * Ownership of the array and the underlying memory blocks is retained by
+   * the caller, which must guarantee that they remain valid until the handler
+   * is called.
+   *
+   * @param sender_endpoints An array of endpoint objects that receive the
+   * endpoints of the remote senders of the corresponding datagrams. Ownership
+   * of the array is retained by the caller, which must guarantee that it
+   * remains valid until the handler is called.
+   *
+   * @param sizes An array that receives the length of each datagram. Ownership
+   * of the array is retained by the caller, which must guarantee that it
+   * remains valid until the handler is called.
+   *
+   * @param count The number of elements in the buffers, sender_endpoints and
+   * sizes arrays.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t datagrams_transferred       // Number of datagrams received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   *
+   * @par Example
+   * @code boost::asio::mutable_buffer buffers[16];
+   * boost::asio::ip::udp::endpoint senders[16];
+   * std::size_t sizes[16];
+   * for (int i = 0; i < 16; ++i)
+   *   buffers[i] = boost::asio::buffer(data[i]);
+   * socket.async_receive_batch(buffers, senders, sizes, 16, handler);
+   * @endcode
+   */
+  template <typename ReadHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(ReadHandler,
+      void (boost::system::error_code, std::size_t))
+  async_receive_batch(const boost::asio::mutable_buffer* buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes, std::size_t count,
+      BOOST_ASIO_MOVE_ARG(ReadHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a ReadHandler.
+    BOOST_ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+    return this->get_service().async_receive_batch(
+        this->get_implementation(), buffers, sender_endpoints, sizes, count,
+        0, BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
+  }
+
+  /// Start an asynchronous receive of a batch of datagrams.
+  /**
+   * This function is used to asynchronously receive several datagrams using a
+   * single system call, where supported. The function call always returns
+   * immediately.
+   *
+   * @param buffers An array of buffers, each of which receives one datagram.
+   * Ownership of the array and the underlying memory blocks is retained by
+   * the caller, which must guarantee that they remain valid until the handler
+   * is called.
+   *
+   * @param sender_endpoints An array of endpoint objects that receive the
+   * endpoints of the remote senders of the corresponding datagrams. Ownership
+   * of the array is retained by the caller, which must guarantee that it
+   * remains valid until the handler is called.
+   *
+   * @param sizes An array that receives the length of each datagram. Ownership
+   * of the array is retained by the caller, which must guarantee that it
+   * remains valid until the handler is called.
+   *
+   * @param count The number of elements in the buffers, sender_endpoints and
+   * sizes arrays.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t datagrams_transferred       // Number of datagrams received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   */
+  template <typename ReadHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(ReadHandler,
+      void (boost::system::error_code, std::size_t))
+  async_receive_batch(const boost::asio::mutable_buffer* buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes, std::size_t count,
+      socket_base::message_flags flags,
+      BOOST_ASIO_MOVE_ARG(ReadHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a ReadHandler.
+    BOOST_ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+    return this->get_service().async_receive_batch(
+        this->get_implementation(), buffers, sender_endpoints, sizes, count,
+        flags, BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
+  }
+#endif // !defined(BOOST_ASIO_HAS_IOCP) || defined(GENERATING_DOCUMENTATION)
 };
 
 } // namespace asio
@@ -0,0 +1,254 @@
+//
+// basic_ring_buffer.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_BASIC_RING_BUFFER_HPP
+#define BOOST_ASIO_BASIC_RING_BUFFER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <boost/array.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/detail/limits.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/throw_exception.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Automatically resizable buffer class based on a circular character array.
+/**
+ * The @c basic_ring_buffer class provides the same prepare, commit, data and
+ * consume operations as @c basic_streambuf, and may be used with read_until
+ * and async_read_until in its place. Rather than moving the unread data to
+ * the start of the storage when more space is needed, the buffer wraps
+ * around. Consuming data never copies, and the input and output sequences are
+ * each represented by up to two buffers. A read operation can therefore fill
+ * the free space at both ends of the storage as a single scatter read.
+ *
+ * The storage only grows, and the data is copied, when the free space is
+ * smaller than the size passed to prepare.
+ *
+ * The constructor for basic_ring_buffer accepts a @c size_t argument specifying
+ * the maximum of the sum of the sizes of the input sequence and output
+ * sequence. During the lifetime of the @c basic_ring_buffer object, the
+ * following invariant holds:
+ * @code size() <= max_size()@endcode
+ * Any member function that would, if successful, cause the invariant to be
+ * violated shall throw an exception of class @c std::length_error.
+ *
+ * @par Examples
+ * Reading lines from a socket:
+ * @code
+ * boost::asio::ring_buffer b;
+ * std::size_t n = boost::asio::read_until(sock, b, '\n');
+ * std::string line(boost::asio::buffers_begin(b.data()),
+ *     boost::asio::buffers_begin(b.data()) + n);
+ * b.consume(n);
+ * @endcode
+ */
+template <typename Allocator = std::allocator<char> >
+class basic_ring_buffer
+  : private noncopyable
+{
+public:
+#if defined(GENERATING_DOCUMENTATION)
+  /// The type used to represent the input sequence as a list of buffers.
+  typedef implementation_defined const_buffers_type;
+
+  /// The type used to represent the output sequence as a list of buffers.
+  typedef implementation_defined mutable_buffers_type;
+#else
+  typedef boost::array<boost::asio::const_buffer, 2> const_buffers_type;
+  typedef boost::array<boost::asio::mutable_buffer, 2> mutable_buffers_type;
+#endif
+
+  /// Construct a basic_ring_buffer object.
+  /**
+   * Constructs a ring buffer with the specified maximum size. The initial size
+   * of the ring buffer's input sequence is 0.
+   */
+  explicit basic_ring_buffer(
+      std::size_t maximum_size = (std::numeric_limits<std::size_t>::max)(),
+      const Allocator& allocator = Allocator())
+    : max_size_(maximum_size),
+      buffer_(allocator),
+      head_(0),
+      size_(0),
+      prepared_(0)
+  {
+  }
+
+  /// Get the size of the input sequence.
+  std::size_t size() const
+  {
+    return size_;
+  }
+
+  /// Get the maximum size of the basic_ring_buffer.
+  std::size_t max_size() const
+  {
+    return max_size_;
+  }
+
+  /// Get the size of the underlying storage.
+  std::size_t capacity() const
+  {
+    return buffer_.size();
+  }
+
+  /// Get a list of buffers that represents the input sequence.
+  /**
+   * @returns An object of type @c const_buffers_type that satisfies
+   * ConstBufferSequence requirements, representing all character arrays in the
+   * input sequence.
+   *
+   * @note The returned object is invalidated by any @c basic_ring_buffer member
+   * function that modifies the input sequence or output sequence.
+   */
+  const_buffers_type data() const
+  {
+    std::size_t first = (std::min)(size_, buffer_.size() - head_);
+    const_buffers_type buffers = { {
+      boost::asio::const_buffer(first ? &buffer_[head_] : 0, first),
+      boost::asio::const_buffer(size_ - first ? &buffer_[0] : 0, size_ - first)
+    } };
+    return buffers;
+  }
+
+  /// Get a list of buffers that represents the output sequence, with the given
+  /// size.
+  /**
+   * Ensures that the output sequence can accommodate @c n characters,
+   * reallocating character array objects as necessary.
+   *
+   * @returns An object of type @c mutable_buffers_type that satisfies
+   * MutableBufferSequence requirements, representing character array objects
+   * at the start of the output sequence such that the sum of the buffer sizes
+   * is @c n.
+   *
+   * @throws std::length_error If <tt>size() + n > max_size()</tt>.
+   *
+   * @note The returned object is invalidated by any @c basic_ring_buffer member
+   * function that modifies the input sequence or output sequence.
+   */
+  mutable_buffers_type prepare(std::size_t n)
+  {
+    reserve(n);
+    prepared_ = n;
+
+    std::size_t tail = (head_ + size_) % (std::max)(buffer_.size(),
+        static_cast<std::size_t>(1));
+    std::size_t first = (std::min)(n, buffer_.size() - tail);
+    mutable_buffers_type buffers = { {
+      boost::asio::mutable_buffer(first ? &buffer_[tail] : 0, first),
+      boost::asio::mutable_buffer(n - first ? &buffer_[0] : 0, n - first)
+    } };
+    return buffers;
+  }
+
+  /// Move characters from the output sequence to the input sequence.
+  /**
+   * Appends @c n characters from the start of the output sequence to the input
+   * sequence. The beginning of the output sequence is advanced by @c n
+   * characters.
+   *
+   * Requires a preceding call <tt>prepare(x)</tt> where <tt>x >= n</tt>, and
+   * no intervening operations that modify the input or output sequence.
+   *
+   * @note If @c n is greater than the size of the output sequence, the entire
+   * output sequence is moved to the input sequence and no error is issued.
+   */
+  void commit(std::size_t n)
+  {
+    n = (std::min)(n, prepared_);
+    size_ += n;
+    prepared_ -= n;
+  }
+
+  /// Remove characters from the input sequence.
+  /**
+   * Removes @c n characters from the beginning of the input sequence.
+   *
+   * @note If @c n is greater than the size of the input sequence, the entire
+   * input sequence is consumed and no error is issued.
+   */
+  void consume(std::size_t n)
+  {
+    n = (std::min)(n, size_);
+    size_ -= n;
+    prepared_ = 0;
+
+    // Restart at the beginning of the storage when the buffer empties, so
+    // that subsequent data is more likely to be contiguous.
+    head_ = size_ ? (head_ + n) % buffer_.size() : 0;
+  }
+
+private:
+  void reserve(std::size_t n)
+  {
+    if (n <= buffer_.size() - size_)
+      return;
+
+    if (n > max_size_ || size_ > max_size_ - n)
+    {
+      std::length_error ex("boost::asio::ring_buffer too long");
+      boost::asio::detail::throw_exception(ex);
+    }
+
+    // Grow geometrically, moving the input sequence to the start of the new
+    // storage.
+    std::size_t new_size = (std::max)(size_ + n, (std::min)(
+          max_size_, (std::max)(buffer_.size() * 2,
+            static_cast<std::size_t>(buffer_delta))));
+    std::vector<char, Allocator> new_buffer(new_size, 0,
+        buffer_.get_allocator());
+    std::size_t first = (std::min)(size_, buffer_.size() - head_);
+    if (first)
+      std::memcpy(&new_buffer[0], &buffer_[head_], first);
+    if (size_ - first)
+      std::memcpy(&new_buffer[first], &buffer_[0], size_ - first);
+    buffer_.swap(new_buffer);
+    head_ = 0;
+  }
+
+  enum { buffer_delta = 512 };
+
+  std::size_t max_size_;
+  std::vector<char, Allocator> buffer_;
+  std::size_t head_;
+  std::size_t size_;
+  std::size_t prepared_;
+
+  // Helper function to get the preferred size for reading data.
+  friend std::size_t read_size_helper(
+      basic_ring_buffer& b, std::size_t max_size)
+  {
+    return std::min<std::size_t>(
+        std::max<std::size_t>(512, b.capacity() - b.size()),
+        std::min<std::size_t>(max_size, b.max_size() - b.size()));
+  }
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_BASIC_RING_BUFFER_HPP
@@ -28,6 +28,7 @@
 
 namespace boost {
 namespace asio {
+namespace detail { class reactive_socket_service_base; }
 
 /// Provides socket functionality.
 /**
@@ -1510,6 +1511,10 @@ protected:
   ~basic_socket()
   {
   }
+
+private:
+  // Accept operations record the state of accepted sockets.
+  friend class detail::reactive_socket_service_base;
 };
 
 } // namespace asio
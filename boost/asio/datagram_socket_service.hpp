@@ -355,6 +355,38 @@ public:
     return init.result.get();
   }
 
+#if !defined(BOOST_ASIO_HAS_IOCP)
+  /// Send a batch of datagrams to the specified endpoints.
+  std::size_t send_batch(implementation_type& impl,
+      const boost::asio::const_buffer* buffers,
+      const endpoint_type* destinations, std::size_t count,
+      socket_base::message_flags flags, boost::system::error_code& ec)
+  {
+    return service_impl_.send_batch(impl,
+        buffers, destinations, count, flags, ec);
+  }
+
+  /// Start an asynchronous send of a batch of datagrams.
+  template <typename WriteHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(WriteHandler,
+      void (boost::system::error_code, std::size_t))
+  async_send_batch(implementation_type& impl,
+      const boost::asio::const_buffer* buffers,
+      const endpoint_type* destinations, std::size_t count,
+      socket_base::message_flags flags,
+      BOOST_ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    detail::async_result_init<
+      WriteHandler, void (boost::system::error_code, std::size_t)> init(
+        BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
+
+    service_impl_.async_send_batch(impl, buffers,
+        destinations, count, flags, init.handler);
+
+    return init.result.get();
+  }
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
+
   /// Receive some data from the peer.
   template <typename MutableBufferSequence>
   std::size_t receive(implementation_type& impl,
@@ -411,6 +443,38 @@ public:
     return init.result.get();
   }
 
+#if !defined(BOOST_ASIO_HAS_IOCP)
+  /// Receive a batch of datagrams with the endpoints of the senders.
+  std::size_t receive_batch(implementation_type& impl,
+      const boost::asio::mutable_buffer* buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes, std::size_t count,
+      socket_base::message_flags flags, boost::system::error_code& ec)
+  {
+    return service_impl_.receive_batch(impl, buffers,
+        sender_endpoints, sizes, count, flags, ec);
+  }
+
+  /// Start an asynchronous receive of a batch of datagrams.
+  template <typename ReadHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(ReadHandler,
+      void (boost::system::error_code, std::size_t))
+  async_receive_batch(implementation_type& impl,
+      const boost::asio::mutable_buffer* buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes, std::size_t count,
+      socket_base::message_flags flags,
+      BOOST_ASIO_MOVE_ARG(ReadHandler) handler)
+  {
+    detail::async_result_init<
+      ReadHandler, void (boost::system::error_code, std::size_t)> init(
+        BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
+
+    service_impl_.async_receive_batch(impl, buffers,
+        sender_endpoints, sizes, count, flags, init.handler);
+
+    return init.result.get();
+  }
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
+
 private:
   // Destroy all user-defined handler objects owned by the service.
   void shutdown_service()
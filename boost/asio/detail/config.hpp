@@ -426,7 +426,7 @@
 # endif // defined(BOOST_ASIO_WINDOWS) || defined(__CYGWIN__)
 #endif // !defined(BOOST_ASIO_HAS_IOCP)
 
-// Linux: epoll, eventfd and timerfd.
+// Linux: epoll, eventfd, timerfd and io_uring.
 #if defined(__linux__)
 # include <linux/version.h>
 # if !defined(BOOST_ASIO_HAS_EPOLL)
@@ -450,6 +450,52 @@
 #   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 8)
 #  endif // defined(BOOST_ASIO_HAS_EPOLL)
 # endif // !defined(BOOST_ASIO_HAS_TIMERFD)
+# if !defined(BOOST_ASIO_HAS_IO_URING)
+#  if defined(BOOST_ASIO_ENABLE_IO_URING)
+#   if defined(BOOST_ASIO_HAS_EPOLL) && defined(BOOST_ASIO_HAS_EVENTFD)
+#    if LINUX_VERSION_CODE >= KERNEL_VERSION(5,6,0)
+#     define BOOST_ASIO_HAS_IO_URING 1
+#    endif // LINUX_VERSION_CODE >= KERNEL_VERSION(5,6,0)
+#   endif // defined(BOOST_ASIO_HAS_EPOLL) && defined(BOOST_ASIO_HAS_EVENTFD)
+#  endif // defined(BOOST_ASIO_ENABLE_IO_URING)
+# endif // !defined(BOOST_ASIO_HAS_IO_URING)
+# if !defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+#  if !defined(BOOST_ASIO_DISABLE_MSG_ZEROCOPY)
+#   if defined(BOOST_ASIO_HAS_EPOLL)
+#    if LINUX_VERSION_CODE >= KERNEL_VERSION(4,14,0)
+#     define BOOST_ASIO_HAS_MSG_ZEROCOPY 1
+#    endif // LINUX_VERSION_CODE >= KERNEL_VERSION(4,14,0)
+#   endif // defined(BOOST_ASIO_HAS_EPOLL)
+#  endif // !defined(BOOST_ASIO_DISABLE_MSG_ZEROCOPY)
+# endif // !defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+# if !defined(BOOST_ASIO_HAS_MMSG)
+#  if !defined(BOOST_ASIO_DISABLE_MMSG)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(3,0,0)
+#    define BOOST_ASIO_HAS_MMSG 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(3,0,0)
+#  endif // !defined(BOOST_ASIO_DISABLE_MMSG)
+# endif // !defined(BOOST_ASIO_HAS_MMSG)
+# if !defined(BOOST_ASIO_HAS_UDP_SEGMENT)
+#  if !defined(BOOST_ASIO_DISABLE_UDP_SEGMENT)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(4,18,0)
+#    define BOOST_ASIO_HAS_UDP_SEGMENT 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(4,18,0)
+#  endif // !defined(BOOST_ASIO_DISABLE_UDP_SEGMENT)
+# endif // !defined(BOOST_ASIO_HAS_UDP_SEGMENT)
+# if !defined(BOOST_ASIO_HAS_ACCEPT4)
+#  if !defined(BOOST_ASIO_DISABLE_ACCEPT4)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,28)
+#    define BOOST_ASIO_HAS_ACCEPT4 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,28)
+#  endif // !defined(BOOST_ASIO_DISABLE_ACCEPT4)
+# endif // !defined(BOOST_ASIO_HAS_ACCEPT4)
+# if !defined(BOOST_ASIO_HAS_SO_REUSEPORT)
+#  if !defined(BOOST_ASIO_DISABLE_SO_REUSEPORT)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(3,9,0)
+#    define BOOST_ASIO_HAS_SO_REUSEPORT 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(3,9,0)
+#  endif // !defined(BOOST_ASIO_DISABLE_SO_REUSEPORT)
+# endif // !defined(BOOST_ASIO_HAS_SO_REUSEPORT)
 #endif // defined(__linux__)
 
 // Mac OS X, FreeBSD, NetBSD, OpenBSD: kqueue.
@@ -632,6 +678,24 @@
 # endif // defined(BOOST_ASIO_HAS_THREADS)
 #endif // !defined(BOOST_ASIO_HAS_PTHREADS)
 
+// Per-thread lock-free handler queues in task_io_service.
+#if !defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+# if defined(BOOST_ASIO_ENABLE_LOCKFREE_QUEUES)
+#  if defined(BOOST_ASIO_HAS_THREADS) && !defined(BOOST_ASIO_HAS_IOCP)
+#   define BOOST_ASIO_HAS_LOCKFREE_QUEUES 1
+#  endif // defined(BOOST_ASIO_HAS_THREADS) && !defined(BOOST_ASIO_HAS_IOCP)
+# endif // defined(BOOST_ASIO_ENABLE_LOCKFREE_QUEUES)
+#endif // !defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+
+// Lock-free handler queues for strands that do not share an implementation.
+#if !defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+# if !defined(BOOST_ASIO_DISABLE_LOCKFREE_STRANDS)
+#  if defined(BOOST_ASIO_HAS_THREADS) && defined(BOOST_ASIO_HAS_STD_ATOMIC)
+#   define BOOST_ASIO_HAS_LOCKFREE_STRANDS 1
+#  endif // defined(BOOST_ASIO_HAS_THREADS) && defined(BOOST_ASIO_HAS_STD_ATOMIC)
+# endif // !defined(BOOST_ASIO_DISABLE_LOCKFREE_STRANDS)
+#endif // !defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+
 // Helper to prevent macro expansion.
 #define BOOST_ASIO_PREVENT_MACRO_SUBSTITUTION
 
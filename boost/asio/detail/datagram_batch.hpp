@@ -0,0 +1,141 @@
+//
+// detail/datagram_batch.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_DATAGRAM_BATCH_HPP
+#define BOOST_ASIO_DETAIL_DATAGRAM_BATCH_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/detail/buffer_sequence_adapter.hpp>
+#include <boost/asio/detail/socket_types.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Helper class to translate arrays of buffers and endpoints into the native
+// representation used to receive a batch of datagrams. Each buffer receives
+// one datagram. At most max_batch_len datagrams are received at a time.
+template <typename Endpoint>
+class datagram_receive_batch
+  : buffer_sequence_adapter_base
+{
+public:
+  datagram_receive_batch(const boost::asio::mutable_buffer* buffers,
+      Endpoint* endpoints, std::size_t count)
+    : endpoints_(endpoints),
+      count_(count < static_cast<std::size_t>(max_batch_len)
+          ? count : static_cast<std::size_t>(max_batch_len))
+  {
+    for (std::size_t i = 0; i < count_; ++i)
+    {
+      init_native_buffer(buffers_[i], buffers[i]);
+      addrs_[i] = endpoints[i].data();
+      addrlens_[i] = endpoints[i].capacity();
+    }
+  }
+
+  native_buffer_type* buffers()
+  {
+    return buffers_;
+  }
+
+  socket_addr_type** addrs()
+  {
+    return addrs_;
+  }
+
+  std::size_t* addrlens()
+  {
+    return addrlens_;
+  }
+
+  std::size_t count() const
+  {
+    return count_;
+  }
+
+  // Update the endpoints of the first n datagrams with the sender addresses.
+  void resize_endpoints(std::size_t n)
+  {
+    for (std::size_t i = 0; i < n && i < count_; ++i)
+      endpoints_[i].resize(addrlens_[i]);
+  }
+
+private:
+  Endpoint* endpoints_;
+  native_buffer_type buffers_[max_batch_len];
+  socket_addr_type* addrs_[max_batch_len];
+  std::size_t addrlens_[max_batch_len];
+  std::size_t count_;
+};
+
+// Helper class to translate arrays of buffers and endpoints into the native
+// representation used to send a batch of datagrams. Each buffer is sent as
+// one datagram. At most max_batch_len datagrams are sent at a time.
+template <typename Endpoint>
+class datagram_send_batch
+  : buffer_sequence_adapter_base
+{
+public:
+  datagram_send_batch(const boost::asio::const_buffer* buffers,
+      const Endpoint* endpoints, std::size_t count)
+    : count_(count < static_cast<std::size_t>(max_batch_len)
+          ? count : static_cast<std::size_t>(max_batch_len))
+  {
+    for (std::size_t i = 0; i < count_; ++i)
+    {
+      init_native_buffer(buffers_[i], buffers[i]);
+      addrs_[i] = endpoints[i].data();
+      addrlens_[i] = endpoints[i].size();
+    }
+  }
+
+  native_buffer_type* buffers()
+  {
+    return buffers_;
+  }
+
+  const socket_addr_type** addrs()
+  {
+    return addrs_;
+  }
+
+  std::size_t* addrlens()
+  {
+    return addrlens_;
+  }
+
+  std::size_t count() const
+  {
+    return count_;
+  }
+
+private:
+  native_buffer_type buffers_[max_batch_len];
+  const socket_addr_type* addrs_[max_batch_len];
+  std::size_t addrlens_[max_batch_len];
+  std::size_t count_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_DATAGRAM_BATCH_HPP
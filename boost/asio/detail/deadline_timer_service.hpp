@@ -30,6 +30,10 @@
 #include <boost/asio/detail/wait_handler.hpp>
 #include <boost/asio/detail/wait_op.hpp>
 
+#if defined(BOOST_ASIO_ENABLE_TIMER_WHEEL)
+# include <boost/asio/detail/timer_queue_wheel.hpp>
+#endif // defined(BOOST_ASIO_ENABLE_TIMER_WHEEL)
+
 #include <boost/asio/detail/push_options.hpp>
 
 namespace boost {
@@ -46,6 +50,13 @@ public:
   // The duration type.
   typedef typename Time_Traits::duration_type duration_type;
 
+  // The queue used to hold the timers.
+#if defined(BOOST_ASIO_ENABLE_TIMER_WHEEL)
+  typedef timer_queue<timer_wheel_traits<Time_Traits> > queue_type;
+#else // defined(BOOST_ASIO_ENABLE_TIMER_WHEEL)
+  typedef timer_queue<Time_Traits> queue_type;
+#endif // defined(BOOST_ASIO_ENABLE_TIMER_WHEEL)
+
   // The implementation type of the timer. This type is dependent on the
   // underlying implementation of the timer service.
   struct implementation_type
@@ -53,7 +64,7 @@ public:
   {
     time_type expiry;
     bool might_have_pending_waits;
-    typename timer_queue<Time_Traits>::per_timer_data timer_data;
+    typename queue_type::per_timer_data timer_data;
   };
 
   // Constructor.
@@ -202,7 +213,7 @@ private:
   }
 
   // The queue of timers.
-  timer_queue<Time_Traits> timer_queue_;
+  queue_type timer_queue_;
 
   // The object that schedules and executes timers. Usually a reactor.
   timer_scheduler& scheduler_;
@@ -270,6 +270,11 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
     }
   }
 
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+  if (op->wait_for_error_queue_)
+    op_type = except_op;
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
   descriptor_data->op_queue_[op_type].push(op);
   io_service_.work_started();
 }
@@ -625,6 +630,15 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
           op_queue_[j].pop();
           io_cleanup.ops_.push(op);
         }
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+        else if (op->wait_for_error_queue_ && j != except_op)
+        {
+          // Notifications on the error queue are reported as EPOLLERR, which
+          // also causes the exception queue to be processed.
+          op_queue_[j].pop();
+          op_queue_[except_op].push(op);
+        }
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
         else
           break;
       }
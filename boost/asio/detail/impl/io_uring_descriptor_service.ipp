@@ -0,0 +1,130 @@
+//
+// detail/impl/io_uring_descriptor_service.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IMPL_IO_URING_DESCRIPTOR_SERVICE_IPP
+#define BOOST_ASIO_DETAIL_IMPL_IO_URING_DESCRIPTOR_SERVICE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <boost/asio/error.hpp>
+#include <boost/asio/detail/io_uring_descriptor_service.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+io_uring_descriptor_service::io_uring_descriptor_service(
+    boost::asio::io_service& io_service)
+  : reactive_descriptor_service(io_service),
+    io_uring_service_(boost::asio::use_service<io_uring_service>(io_service))
+{
+}
+
+void io_uring_descriptor_service::construct(
+    io_uring_descriptor_service::implementation_type& impl)
+{
+  reactive_descriptor_service::construct(impl);
+  impl.io_object_data_ = 0;
+}
+
+void io_uring_descriptor_service::move_construct(
+    io_uring_descriptor_service::implementation_type& impl,
+    io_uring_descriptor_service::implementation_type& other_impl)
+{
+  reactive_descriptor_service::move_construct(impl, other_impl);
+  io_uring_service_.move_io_object(
+      impl.io_object_data_, other_impl.io_object_data_);
+}
+
+void io_uring_descriptor_service::move_assign(
+    io_uring_descriptor_service::implementation_type& impl,
+    io_uring_descriptor_service& other_service,
+    io_uring_descriptor_service::implementation_type& other_impl)
+{
+  io_uring_service_.deregister_io_object(impl.io_object_data_);
+  reactive_descriptor_service::move_assign(impl, other_service, other_impl);
+
+  if (&other_service.io_uring_service_ == &io_uring_service_)
+  {
+    io_uring_service_.move_io_object(
+        impl.io_object_data_, other_impl.io_object_data_);
+  }
+  else
+  {
+    // Operations cannot migrate between rings, so any that are outstanding
+    // on the other object are cancelled.
+    other_service.io_uring_service_.deregister_io_object(
+        other_impl.io_object_data_);
+  }
+}
+
+void io_uring_descriptor_service::destroy(
+    io_uring_descriptor_service::implementation_type& impl)
+{
+  io_uring_service_.deregister_io_object(impl.io_object_data_);
+  reactive_descriptor_service::destroy(impl);
+}
+
+boost::system::error_code io_uring_descriptor_service::close(
+    io_uring_descriptor_service::implementation_type& impl,
+    boost::system::error_code& ec)
+{
+  io_uring_service_.deregister_io_object(impl.io_object_data_);
+  return reactive_descriptor_service::close(impl, ec);
+}
+
+io_uring_descriptor_service::native_handle_type
+io_uring_descriptor_service::release(
+    io_uring_descriptor_service::implementation_type& impl)
+{
+  io_uring_service_.deregister_io_object(impl.io_object_data_);
+  return reactive_descriptor_service::release(impl);
+}
+
+boost::system::error_code io_uring_descriptor_service::cancel(
+    io_uring_descriptor_service::implementation_type& impl,
+    boost::system::error_code& ec)
+{
+  if (!reactive_descriptor_service::cancel(impl, ec))
+    io_uring_service_.cancel_ops(impl.io_object_data_);
+  return ec;
+}
+
+void io_uring_descriptor_service::start_op(
+    io_uring_descriptor_service::implementation_type& impl,
+    io_uring_operation* op, bool is_continuation, bool noop)
+{
+  if (!noop && !is_open(impl))
+  {
+    op->ec_ = boost::asio::error::bad_descriptor;
+    io_uring_service_.post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  io_uring_service_.start_op(impl.io_object_data_, op, is_continuation, noop);
+}
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IMPL_IO_URING_DESCRIPTOR_SERVICE_IPP
@@ -0,0 +1,554 @@
+//
+// detail/impl/io_uring_service.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IMPL_IO_URING_SERVICE_IPP
+#define BOOST_ASIO_DETAIL_IMPL_IO_URING_SERVICE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <cerrno>
+#include <cstring>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <boost/asio/error.hpp>
+#include <boost/asio/detail/cstdint.hpp>
+#include <boost/asio/detail/io_uring_service.hpp>
+#include <boost/asio/detail/reactor_op.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+class io_uring_service::event_fd_read_op : public reactor_op
+{
+public:
+  explicit event_fd_read_op(io_uring_service* service)
+    : reactor_op(&event_fd_read_op::do_perform,
+        &event_fd_read_op::do_complete),
+      service_(service)
+  {
+  }
+
+  static bool do_perform(reactor_op* base)
+  {
+    io_uring_service* service = static_cast<event_fd_read_op*>(base)->service_;
+
+    // Reset the eventfd before reaping, so that any completion that arrives
+    // after the queue has been drained signals the eventfd again.
+    uint64_t counter(0);
+    int bytes_read = ::read(service->event_fd_, &counter, sizeof(uint64_t));
+    (void)bytes_read;
+
+    op_queue<operation> ops;
+    mutex::scoped_lock lock(service->mutex_);
+    service->reap(lock, ops);
+    lock.unlock();
+    service->io_service_.post_deferred_completions(ops);
+
+    // Never complete, so that the eventfd stays registered with the reactor.
+    return false;
+  }
+
+  static void do_complete(io_service_impl* /*owner*/, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    event_fd_read_op* o(static_cast<event_fd_read_op*>(base));
+    delete o;
+  }
+
+private:
+  io_uring_service* service_;
+};
+
+class io_uring_service::submit_op : public operation
+{
+public:
+  explicit submit_op(io_uring_service* service)
+    : operation(&submit_op::do_complete),
+      service_(service)
+  {
+  }
+
+  static void do_complete(io_service_impl* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    if (owner)
+    {
+      io_uring_service* service = static_cast<submit_op*>(base)->service_;
+
+      op_queue<operation> ops;
+      mutex::scoped_lock lock(service->mutex_);
+      service->submit_scheduled_ = false;
+      service->submit_pending(lock);
+
+      // Operations that could be satisfied immediately have already been
+      // completed by the kernel, so pick them up without waiting for the
+      // reactor to notice the eventfd.
+      service->reap(lock, ops);
+
+      // Try again later if the kernel could not accept every entry.
+      if (service->pending_ > 0)
+        service->schedule_submit(lock, false);
+
+      lock.unlock();
+      service->io_service_.post_deferred_completions(ops);
+    }
+  }
+
+private:
+  io_uring_service* service_;
+};
+
+io_uring_service::io_uring_service(boost::asio::io_service& io_service)
+  : boost::asio::detail::service_base<io_uring_service>(io_service),
+    io_service_(use_service<io_service_impl>(io_service)),
+    reactor_(use_service<reactor>(io_service)),
+    reactor_data_(),
+    mutex_(),
+    ring_fd_(-1),
+    event_fd_(-1),
+    sq_ring_(0),
+    sq_ring_size_(0),
+    cq_ring_(0),
+    cq_ring_size_(0),
+    sqes_(0),
+    sqes_size_(0),
+    sq_head_(0),
+    sq_tail_(0),
+    sq_mask_(0),
+    sq_entries_(0),
+    sq_array_(0),
+    sq_flags_(0),
+    cq_head_(0),
+    cq_tail_(0),
+    cq_mask_(0),
+    cq_entries_(0),
+    cqes_(0),
+    pending_(0),
+    outstanding_(0),
+    submit_scheduled_(false),
+    submit_op_(new submit_op(this)),
+    shutdown_(false)
+{
+  reactor_.init_task();
+
+  open_ring();
+
+  if (ring_fd_ != -1)
+  {
+    if (reactor_.register_internal_descriptor(reactor::read_op,
+          event_fd_, reactor_data_, new event_fd_read_op(this)) != 0)
+    {
+      reactor_.deregister_internal_descriptor(event_fd_, reactor_data_);
+      close_ring();
+    }
+  }
+}
+
+io_uring_service::~io_uring_service()
+{
+  close_ring();
+  delete submit_op_;
+}
+
+void io_uring_service::shutdown_service()
+{
+  mutex::scoped_lock lock(mutex_);
+  shutdown_ = true;
+  lock.unlock();
+
+  if (ring_fd_ == -1)
+    return;
+
+  reactor_.deregister_internal_descriptor(event_fd_, reactor_data_);
+
+  // Cancel everything that is still in flight, and wait for the kernel to
+  // finish with each operation before it is destroyed.
+  op_queue<operation> ops;
+  lock.lock();
+  for (io_object* object = registered_io_objects_.first();
+      object; object = object->next_)
+    cancel_object_ops(lock, object);
+  submit_pending(lock);
+  reap(lock, ops);
+  while (outstanding_ > 0)
+  {
+    int result = enter(0, 1, IORING_ENTER_GETEVENTS);
+    if (result < 0 && result != -EINTR)
+      break;
+    reap(lock, ops);
+  }
+  lock.unlock();
+
+  io_service_.abandon_operations(ops);
+}
+
+void io_uring_service::start_op(
+    io_uring_service::per_io_object_data& io_object_data,
+    io_uring_operation* op, bool is_continuation, bool noop)
+{
+  if (noop)
+  {
+    io_service_.post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  mutex::scoped_lock lock(mutex_);
+
+  if (shutdown_)
+  {
+    lock.unlock();
+    io_service_.post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  ::io_uring_sqe* sqe = get_sqe(lock);
+  if (!sqe)
+  {
+    lock.unlock();
+    op->ec_ = boost::asio::error::no_buffer_space;
+    io_service_.post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  if (!io_object_data)
+  {
+    io_object_data = registered_io_objects_.alloc();
+    io_object_data->ops_ = 0;
+  }
+
+  op->prepare(sqe);
+  sqe->user_data = reinterpret_cast<uintptr_t>(op);
+  op->object_ops_ = &io_object_data->ops_;
+  op->object_next_ = io_object_data->ops_;
+  io_object_data->ops_ = op;
+
+  ++outstanding_;
+  io_service_.work_started();
+  schedule_submit(lock, is_continuation);
+}
+
+void io_uring_service::cancel_ops(
+    io_uring_service::per_io_object_data& io_object_data)
+{
+  if (!io_object_data)
+    return;
+
+  mutex::scoped_lock lock(mutex_);
+  cancel_object_ops(lock, io_object_data);
+  submit_pending(lock);
+}
+
+void io_uring_service::deregister_io_object(
+    io_uring_service::per_io_object_data& io_object_data)
+{
+  if (!io_object_data)
+    return;
+
+  mutex::scoped_lock lock(mutex_);
+  cancel_object_ops(lock, io_object_data);
+  submit_pending(lock);
+
+  // Any operations still outstanding will complete with operation_aborted,
+  // but they no longer belong to an object.
+  io_uring_operation* op = io_object_data->ops_;
+  while (op)
+  {
+    io_uring_operation* next_op = op->object_next_;
+    op->object_ops_ = 0;
+    op->object_next_ = 0;
+    op = next_op;
+  }
+  io_object_data->ops_ = 0;
+
+  registered_io_objects_.free(io_object_data);
+  io_object_data = 0;
+}
+
+void io_uring_service::open_ring()
+{
+  ::io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+#if defined(IORING_SETUP_CLAMP)
+  params.flags |= IORING_SETUP_CLAMP;
+#endif // defined(IORING_SETUP_CLAMP)
+  params.flags |= IORING_SETUP_CQSIZE;
+  params.cq_entries = ring_cq_entries;
+
+  ring_fd_ = static_cast<int>(::syscall(
+        __NR_io_uring_setup, static_cast<unsigned>(ring_entries), &params));
+  if (ring_fd_ < 0)
+  {
+    ring_fd_ = -1;
+    return;
+  }
+
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ = params.cq_off.cqes
+    + params.cq_entries * sizeof(::io_uring_cqe);
+  bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap)
+  {
+    if (cq_ring_size_ > sq_ring_size_)
+      sq_ring_size_ = cq_ring_size_;
+    cq_ring_size_ = sq_ring_size_;
+  }
+
+  sq_ring_ = ::mmap(0, sq_ring_size_, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+  if (sq_ring_ == MAP_FAILED)
+  {
+    sq_ring_ = 0;
+    close_ring();
+    return;
+  }
+
+  if (single_mmap)
+    cq_ring_ = sq_ring_;
+  else
+  {
+    cq_ring_ = ::mmap(0, cq_ring_size_, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+    if (cq_ring_ == MAP_FAILED)
+    {
+      cq_ring_ = 0;
+      close_ring();
+      return;
+    }
+  }
+
+  sqes_size_ = params.sq_entries * sizeof(::io_uring_sqe);
+  void* sqes = ::mmap(0, sqes_size_, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED)
+  {
+    close_ring();
+    return;
+  }
+  sqes_ = static_cast< ::io_uring_sqe*>(sqes);
+
+  char* sq = static_cast<char*>(sq_ring_);
+  sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  sq_entries_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_entries);
+  sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+  sq_flags_ = reinterpret_cast<unsigned*>(sq + params.sq_off.flags);
+
+  char* cq = static_cast<char*>(cq_ring_);
+  cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  cq_entries_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_entries);
+  cqes_ = reinterpret_cast< ::io_uring_cqe*>(cq + params.cq_off.cqes);
+
+  event_fd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (event_fd_ == -1)
+  {
+    close_ring();
+    return;
+  }
+
+  if (::syscall(__NR_io_uring_register, ring_fd_,
+        IORING_REGISTER_EVENTFD, &event_fd_, 1) != 0)
+  {
+    close_ring();
+    return;
+  }
+}
+
+void io_uring_service::close_ring()
+{
+  if (sqes_)
+    ::munmap(sqes_, sqes_size_);
+  if (cq_ring_ && cq_ring_ != sq_ring_)
+    ::munmap(cq_ring_, cq_ring_size_);
+  if (sq_ring_)
+    ::munmap(sq_ring_, sq_ring_size_);
+  if (event_fd_ != -1)
+    ::close(event_fd_);
+  if (ring_fd_ != -1)
+    ::close(ring_fd_);
+
+  sqes_ = 0;
+  cq_ring_ = 0;
+  sq_ring_ = 0;
+  event_fd_ = -1;
+  ring_fd_ = -1;
+}
+
+::io_uring_sqe* io_uring_service::get_sqe(mutex::scoped_lock& lock)
+{
+  unsigned tail = *sq_tail_;
+  unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  if (tail - head >= sq_entries_)
+  {
+    submit_pending(lock);
+    head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (tail - head >= sq_entries_)
+      return 0;
+  }
+
+  // The kernel only reads the submission queue when we enter it with the
+  // mutex held, so the entry may be filled in after the tail is advanced.
+  unsigned index = tail & sq_mask_;
+  ::io_uring_sqe* sqe = &sqes_[index];
+  std::memset(sqe, 0, sizeof(::io_uring_sqe));
+  sq_array_[index] = index;
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  ++pending_;
+  return sqe;
+}
+
+void io_uring_service::submit_pending(mutex::scoped_lock&)
+{
+  while (pending_ > 0)
+  {
+    int result = enter(pending_, 0, 0);
+    if (result > 0)
+      pending_ -= result;
+    else if (result != -EINTR)
+      break;
+  }
+}
+
+int io_uring_service::enter(unsigned to_submit,
+    unsigned min_complete, unsigned flags)
+{
+  int result = static_cast<int>(::syscall(__NR_io_uring_enter,
+        ring_fd_, to_submit, min_complete, flags, 0, 0));
+  return result < 0 ? -errno : result;
+}
+
+void io_uring_service::schedule_submit(
+    mutex::scoped_lock&, bool is_continuation)
+{
+  if (!submit_scheduled_)
+  {
+    submit_scheduled_ = true;
+    io_service_.post_immediate_completion(submit_op_, is_continuation);
+  }
+}
+
+void io_uring_service::reap(mutex::scoped_lock& lock,
+    op_queue<operation>& ops)
+{
+  bool resubmitted = false;
+  for (;;)
+  {
+    unsigned head = *cq_head_;
+    unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+#if !defined(IORING_SQ_CQ_OVERFLOW)
+    bool full = (tail - head >= cq_entries_);
+#endif // !defined(IORING_SQ_CQ_OVERFLOW)
+    for (; head != tail; ++head)
+    {
+      const ::io_uring_cqe& cqe = cqes_[head & cq_mask_];
+
+      // Cancellation requests are submitted without an associated operation.
+      io_uring_operation* op = reinterpret_cast<io_uring_operation*>(
+          static_cast<uintptr_t>(cqe.user_data));
+      if (!op)
+        continue;
+
+      if (op->perform(cqe.res) || shutdown_)
+      {
+        unlink_op(op);
+        --outstanding_;
+        ops.push(op);
+      }
+      else if (::io_uring_sqe* sqe = get_sqe(lock))
+      {
+        op->prepare(sqe);
+        sqe->user_data = reinterpret_cast<uintptr_t>(op);
+        resubmitted = true;
+      }
+      else
+      {
+        op->ec_ = boost::asio::error::no_buffer_space;
+        unlink_op(op);
+        --outstanding_;
+        ops.push(op);
+      }
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+
+    // Completions that arrive while the queue is full are kept on an overflow
+    // list in the kernel, and are only moved into the queue when the ring is
+    // entered to get events.
+#if defined(IORING_SQ_CQ_OVERFLOW)
+    if ((__atomic_load_n(sq_flags_, __ATOMIC_ACQUIRE)
+          & IORING_SQ_CQ_OVERFLOW) == 0)
+      break;
+#else // defined(IORING_SQ_CQ_OVERFLOW)
+    if (!full)
+      break;
+#endif // defined(IORING_SQ_CQ_OVERFLOW)
+
+    int result = enter(0, 0, IORING_ENTER_GETEVENTS);
+    if (result < 0 && result != -EINTR)
+      break;
+  }
+
+  if (resubmitted)
+    schedule_submit(lock, false);
+}
+
+void io_uring_service::cancel_object_ops(
+    mutex::scoped_lock& lock, io_object* object)
+{
+  for (io_uring_operation* op = object->ops_; op; op = op->object_next_)
+  {
+    ::io_uring_sqe* sqe = get_sqe(lock);
+    if (!sqe)
+      break;
+
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = reinterpret_cast<uintptr_t>(op);
+    sqe->user_data = 0;
+  }
+}
+
+void io_uring_service::unlink_op(io_uring_operation* op)
+{
+  if (io_uring_operation** p = op->object_ops_)
+  {
+    while (*p && *p != op)
+      p = &(*p)->object_next_;
+    if (*p)
+      *p = op->object_next_;
+  }
+
+  op->object_ops_ = 0;
+  op->object_next_ = 0;
+}
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IMPL_IO_URING_SERVICE_IPP
@@ -43,6 +43,9 @@ void reactive_socket_service_base::construct(
 {
   impl.socket_ = invalid_socket;
   impl.state_ = 0;
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+  impl.zero_copy_ids_ = 0;
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
 }
 
 void reactive_socket_service_base::base_move_construct(
@@ -55,6 +58,11 @@ void reactive_socket_service_base::base_move_construct(
   impl.state_ = other_impl.state_;
   other_impl.state_ = 0;
 
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+  impl.zero_copy_ids_ = other_impl.zero_copy_ids_;
+  other_impl.zero_copy_ids_ = 0;
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
   reactor_.move_descriptor(impl.socket_,
       impl.reactor_data_, other_impl.reactor_data_);
 }
@@ -72,6 +80,11 @@ void reactive_socket_service_base::base_move_assign(
   impl.state_ = other_impl.state_;
   other_impl.state_ = 0;
 
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+  impl.zero_copy_ids_ = other_impl.zero_copy_ids_;
+  other_impl.zero_copy_ids_ = 0;
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
   other_service.reactor_.move_descriptor(impl.socket_,
       impl.reactor_data_, other_impl.reactor_data_);
 }
@@ -89,6 +102,12 @@ void reactive_socket_service_base::destroy(
     boost::system::error_code ignored_ec;
     socket_ops::close(impl.socket_, impl.state_, true, ignored_ec);
   }
+
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+  // No operations that refer to the zero-copy id remain.
+  delete impl.zero_copy_ids_;
+  impl.zero_copy_ids_ = 0;
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
 }
 
 boost::system::error_code reactive_socket_service_base::close(
@@ -105,6 +124,11 @@ boost::system::error_code reactive_socket_service_base::close(
 
   socket_ops::close(impl.socket_, impl.state_, false, ec);
 
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+  // No operations that refer to the zero-copy id remain.
+  delete impl.zero_copy_ids_;
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
   // The descriptor is closed by the OS even if close() returns an error.
   //
   // (Actually, POSIX says the state of the descriptor is unspecified. On
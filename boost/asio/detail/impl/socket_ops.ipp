@@ -86,8 +86,28 @@ inline socket_type call_accept(SockLenType msghdr::*,
   return result;
 }
 
+#if defined(BOOST_ASIO_HAS_ACCEPT4)
+template <typename SockLenType>
+inline socket_type call_accept4(SockLenType msghdr::*, socket_type s,
+    socket_addr_type* addr, std::size_t* addrlen, int flags)
+{
+  SockLenType tmp_addrlen = addrlen ? (SockLenType)*addrlen : 0;
+  socket_type result = ::accept4(s, addr, addrlen ? &tmp_addrlen : 0, flags);
+  if (addrlen)
+    *addrlen = (std::size_t)tmp_addrlen;
+  return result;
+}
+#endif // defined(BOOST_ASIO_HAS_ACCEPT4)
+
 socket_type accept(socket_type s, socket_addr_type* addr,
     std::size_t* addrlen, boost::system::error_code& ec)
+{
+  state_type new_state = 0;
+  return socket_ops::accept(s, addr, addrlen, new_state, ec);
+}
+
+socket_type accept(socket_type s, socket_addr_type* addr,
+    std::size_t* addrlen, state_type& new_state, boost::system::error_code& ec)
 {
   if (s == invalid_socket)
   {
@@ -97,8 +117,27 @@ socket_type accept(socket_type s, socket_addr_type* addr,
 
   clear_last_error();
 
+#if defined(BOOST_ASIO_HAS_ACCEPT4)
+  // Create the new socket with the close-on-exec flag, and the non-blocking
+  // flag if requested, already set. Fall back to accept() if the C library or
+  // kernel does not provide accept4().
+  int flags = SOCK_CLOEXEC;
+  if (new_state & internal_non_blocking)
+    flags |= SOCK_NONBLOCK;
+  socket_type new_s = error_wrapper(call_accept4(
+        &msghdr::msg_namelen, s, addr, addrlen, flags), ec);
+  if (new_s == invalid_socket && ec.value() == ENOSYS)
+  {
+    new_state &= ~internal_non_blocking;
+    clear_last_error();
+    new_s = error_wrapper(call_accept(
+          &msghdr::msg_namelen, s, addr, addrlen), ec);
+  }
+#else // defined(BOOST_ASIO_HAS_ACCEPT4)
+  new_state &= ~internal_non_blocking;
   socket_type new_s = error_wrapper(call_accept(
         &msghdr::msg_namelen, s, addr, addrlen), ec);
+#endif // defined(BOOST_ASIO_HAS_ACCEPT4)
   if (new_s == invalid_socket)
     return new_s;
 
@@ -118,13 +157,15 @@ socket_type accept(socket_type s, socket_addr_type* addr,
 }
 
 socket_type sync_accept(socket_type s, state_type state,
-    socket_addr_type* addr, std::size_t* addrlen, boost::system::error_code& ec)
+    socket_addr_type* addr, std::size_t* addrlen,
+    state_type& new_state, boost::system::error_code& ec)
 {
   // Accept a socket.
   for (;;)
   {
     // Try to complete the operation without blocking.
-    socket_type new_socket = socket_ops::accept(s, addr, addrlen, ec);
+    socket_type new_socket = socket_ops::accept(
+        s, addr, addrlen, new_state, ec);
 
     // Check if operation succeeded.
     if (new_socket != invalid_socket)
@@ -210,12 +251,13 @@ void complete_iocp_accept(socket_type s,
 
 bool non_blocking_accept(socket_type s,
     state_type state, socket_addr_type* addr, std::size_t* addrlen,
-    boost::system::error_code& ec, socket_type& new_socket)
+    boost::system::error_code& ec, socket_type& new_socket,
+    state_type& new_state)
 {
   for (;;)
   {
     // Accept the waiting connection.
-    new_socket = socket_ops::accept(s, addr, addrlen, ec);
+    new_socket = socket_ops::accept(s, addr, addrlen, new_state, ec);
 
     // Check if operation succeeded.
     if (new_socket != invalid_socket)
@@ -1195,6 +1237,67 @@ bool non_blocking_send(socket_type s,
   }
 }
 
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+bool non_blocking_zero_copy_wait(socket_type s,
+    uint32_t id, uint32_t& released, boost::system::error_code& ec)
+{
+  // Ids wrap around, so they are compared as offsets.
+  while (static_cast<int32_t>(released - id) <= 0)
+  {
+    // Read a notification from the error queue.
+    union
+    {
+      cmsghdr header;
+      char buffer[CMSG_SPACE(sizeof(sock_extended_err))];
+    } control;
+    msghdr msg = msghdr();
+    msg.msg_control = control.buffer;
+    msg.msg_controllen = sizeof(control.buffer);
+    clear_last_error();
+    signed_size_type result = error_wrapper(
+        ::recvmsg(s, &msg, MSG_ERRQUEUE | MSG_DONTWAIT), ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    // The error queue is empty.
+    if (ec == boost::asio::error::would_block
+        || ec == boost::asio::error::try_again)
+    {
+      ec = boost::system::error_code();
+      return false;
+    }
+
+    if (result < 0)
+      return true;
+
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+      if ((cmsg->cmsg_level != SOL_IP || cmsg->cmsg_type != IP_RECVERR)
+          && (cmsg->cmsg_level != SOL_IPV6 || cmsg->cmsg_type != IPV6_RECVERR))
+        continue;
+
+      sock_extended_err serr;
+      std::memcpy(&serr, CMSG_DATA(cmsg), sizeof(serr));
+      if (serr.ee_errno != 0 || serr.ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+        continue;
+
+      // The notification covers the sends with ids from ee_info to ee_data
+      // inclusive.
+      uint32_t end = serr.ee_data + 1;
+      if (static_cast<int32_t>(end - released) > 0)
+        released = end;
+    }
+  }
+
+  return true;
+}
+
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
 #endif // defined(BOOST_ASIO_HAS_IOCP)
 
 signed_size_type sendto(socket_type s, const buf* bufs, size_t count,
@@ -1301,6 +1404,237 @@ bool non_blocking_sendto(socket_type s,
   }
 }
 
+signed_size_type recvmmsg(socket_type s, buf* bufs,
+    socket_addr_type** addrs, std::size_t* addrlens, std::size_t* sizes,
+    size_t count, int flags, boost::system::error_code& ec)
+{
+  if (count > static_cast<size_t>(max_batch_len))
+    count = max_batch_len;
+#if defined(BOOST_ASIO_HAS_MMSG)
+  mmsghdr msgs[max_batch_len];
+  for (size_t i = 0; i < count; ++i)
+  {
+    msgs[i].msg_hdr = msghdr();
+    init_msghdr_msg_name(msgs[i].msg_hdr.msg_name, addrs[i]);
+    msgs[i].msg_hdr.msg_namelen = static_cast<int>(addrlens[i]);
+    msgs[i].msg_hdr.msg_iov = &bufs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    msgs[i].msg_len = 0;
+  }
+
+  // Without MSG_WAITFORONE a blocking socket would wait until the whole
+  // batch has been filled.
+  clear_last_error();
+  int result = error_wrapper(::recvmmsg(s, msgs,
+        static_cast<unsigned int>(count), flags | MSG_WAITFORONE, 0), ec);
+  if (result < 0)
+    return socket_error_retval;
+
+  for (int i = 0; i < result; ++i)
+  {
+    addrlens[i] = msgs[i].msg_hdr.msg_namelen;
+    sizes[i] = msgs[i].msg_len;
+  }
+  ec = boost::system::error_code();
+  return result;
+#else // defined(BOOST_ASIO_HAS_MMSG)
+  // Receive one datagram at a time. Only the first receive may block.
+  size_t n = 0;
+  for (; n < count; ++n)
+  {
+    signed_size_type bytes = socket_ops::recvfrom(
+        s, &bufs[n], 1, flags, addrs[n], &addrlens[n], ec);
+    if (bytes < 0)
+      break;
+    sizes[n] = bytes;
+# if defined(MSG_DONTWAIT)
+    flags |= MSG_DONTWAIT;
+# else // defined(MSG_DONTWAIT)
+    n = n + 1;
+    break;
+# endif // defined(MSG_DONTWAIT)
+  }
+  if (n == 0)
+    return socket_error_retval;
+  ec = boost::system::error_code();
+  return n;
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+}
+
+size_t sync_recvmmsg(socket_type s, state_type state, buf* bufs,
+    socket_addr_type** addrs, std::size_t* addrlens, std::size_t* sizes,
+    size_t count, int flags, boost::system::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = boost::asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // Read some datagrams.
+  for (;;)
+  {
+    // Try to complete the operation without blocking.
+    signed_size_type messages = socket_ops::recvmmsg(
+        s, bufs, addrs, addrlens, sizes, count, flags, ec);
+
+    // Check if operation succeeded.
+    if (messages >= 0)
+      return messages;
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != boost::asio::error::would_block
+          && ec != boost::asio::error::try_again))
+      return 0;
+
+    // Wait for socket to become ready.
+    if (socket_ops::poll_read(s, 0, ec) < 0)
+      return 0;
+  }
+}
+
+bool non_blocking_recvmmsg(socket_type s,
+    buf* bufs, socket_addr_type** addrs, std::size_t* addrlens,
+    std::size_t* sizes, size_t count, int flags,
+    boost::system::error_code& ec, size_t& messages_transferred)
+{
+  for (;;)
+  {
+    // Read some datagrams.
+    signed_size_type messages = socket_ops::recvmmsg(
+        s, bufs, addrs, addrlens, sizes, count, flags, ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == boost::asio::error::would_block
+        || ec == boost::asio::error::try_again)
+      return false;
+
+    // Operation is complete.
+    if (messages >= 0)
+    {
+      ec = boost::system::error_code();
+      messages_transferred = messages;
+    }
+    else
+      messages_transferred = 0;
+
+    return true;
+  }
+}
+
+signed_size_type sendmmsg(socket_type s, const buf* bufs,
+    const socket_addr_type** addrs, const std::size_t* addrlens,
+    size_t count, int flags, boost::system::error_code& ec)
+{
+  if (count > static_cast<size_t>(max_batch_len))
+    count = max_batch_len;
+#if defined(BOOST_ASIO_HAS_MMSG)
+  mmsghdr msgs[max_batch_len];
+  for (size_t i = 0; i < count; ++i)
+  {
+    msgs[i].msg_hdr = msghdr();
+    init_msghdr_msg_name(msgs[i].msg_hdr.msg_name, addrs[i]);
+    msgs[i].msg_hdr.msg_namelen = static_cast<int>(addrlens[i]);
+    msgs[i].msg_hdr.msg_iov = const_cast<buf*>(&bufs[i]);
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    msgs[i].msg_len = 0;
+  }
+
+  clear_last_error();
+  int result = error_wrapper(::sendmmsg(s, msgs,
+        static_cast<unsigned int>(count), flags | MSG_NOSIGNAL), ec);
+  if (result < 0)
+    return socket_error_retval;
+  ec = boost::system::error_code();
+  return result;
+#else // defined(BOOST_ASIO_HAS_MMSG)
+  // Send one datagram at a time, stopping at the first failure.
+  size_t n = 0;
+  for (; n < count; ++n)
+  {
+    signed_size_type bytes = socket_ops::sendto(
+        s, &bufs[n], 1, flags, addrs[n], addrlens[n], ec);
+    if (bytes < 0)
+      break;
+  }
+  if (n == 0)
+    return socket_error_retval;
+  ec = boost::system::error_code();
+  return n;
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+}
+
+size_t sync_sendmmsg(socket_type s, state_type state, const buf* bufs,
+    const socket_addr_type** addrs, const std::size_t* addrlens,
+    size_t count, int flags, boost::system::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = boost::asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // Write some datagrams.
+  for (;;)
+  {
+    // Try to complete the operation without blocking.
+    signed_size_type messages = socket_ops::sendmmsg(
+        s, bufs, addrs, addrlens, count, flags, ec);
+
+    // Check if operation succeeded.
+    if (messages >= 0)
+      return messages;
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != boost::asio::error::would_block
+          && ec != boost::asio::error::try_again))
+      return 0;
+
+    // Wait for socket to become ready.
+    if (socket_ops::poll_write(s, 0, ec) < 0)
+      return 0;
+  }
+}
+
+bool non_blocking_sendmmsg(socket_type s,
+    const buf* bufs, const socket_addr_type** addrs,
+    const std::size_t* addrlens, size_t count, int flags,
+    boost::system::error_code& ec, size_t& messages_transferred)
+{
+  for (;;)
+  {
+    // Write some datagrams.
+    signed_size_type messages = socket_ops::sendmmsg(
+        s, bufs, addrs, addrlens, count, flags, ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == boost::asio::error::would_block
+        || ec == boost::asio::error::try_again)
+      return false;
+
+    // Operation is complete.
+    if (messages >= 0)
+    {
+      ec = boost::system::error_code();
+      messages_transferred = messages;
+    }
+    else
+      messages_transferred = 0;
+
+    return true;
+  }
+}
+
 #endif // !defined(BOOST_ASIO_HAS_IOCP)
 
 socket_type socket(int af, int type, int protocol,
@@ -1418,6 +1752,18 @@ int setsockopt(socket_type s, state_type& state, int level, int optname,
   {
     ec = boost::system::error_code();
 
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+    // Remember the zero_copy option, so that sends need not query it.
+    if (level == SOL_SOCKET && optname == zero_copy_option
+        && optlen == sizeof(int))
+    {
+      if (*static_cast<const int*>(optval))
+        state |= user_set_zero_copy;
+      else
+        state &= ~user_set_zero_copy;
+    }
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
 #if defined(__MACH__) && defined(__APPLE__) \
   || defined(__NetBSD__) || defined(__FreeBSD__) || defined(__OpenBSD__)
     // To implement portable behaviour for SO_REUSEADDR with UDP sockets we
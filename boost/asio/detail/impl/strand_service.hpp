@@ -30,7 +30,17 @@ namespace detail {
 
 inline strand_service::strand_impl::strand_impl()
   : operation(&strand_service::do_complete),
-    locked_(false)
+    locked_(false),
+    service_(0),
+    ref_count_(1),
+    destroy_op_(this),
+    destroyed_(false),
+    next_impl_(0),
+    prev_impl_(0)
+#if defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+    , incoming_(0),
+    pending_(0)
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
 {
 }
 
@@ -41,6 +51,17 @@ struct strand_service::on_dispatch_exit
 
   ~on_dispatch_exit()
   {
+#if defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+    if (impl_->service_)
+    {
+      // Release the hold taken for the direct call. Any handlers added in
+      // the meantime mean the strand must now be scheduled.
+      if (impl_->pending_.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        io_service_->post_immediate_completion(impl_, false);
+      return;
+    }
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+
     impl_->mutex_.lock();
     impl_->ready_queue_.push(impl_->waiting_queue_);
     bool more_handlers = impl_->locked_ = !impl_->ready_queue_.empty();
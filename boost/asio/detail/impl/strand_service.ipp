@@ -32,6 +32,12 @@ struct strand_service::on_do_complete_exit
 
   ~on_do_complete_exit()
   {
+    if (impl_->destroyed_)
+    {
+      impl_->service_->free_impl(impl_);
+      return;
+    }
+
     impl_->mutex_.lock();
     impl_->ready_queue_.push(impl_->waiting_queue_);
     bool more_handlers = impl_->locked_ = !impl_->ready_queue_.empty();
@@ -42,20 +48,57 @@ struct strand_service::on_do_complete_exit
   }
 };
 
+#if defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+struct strand_service::on_unshared_complete_exit
+{
+  io_service_impl* owner_;
+  strand_impl* impl_;
+  std::size_t completed_;
+
+  ~on_unshared_complete_exit()
+  {
+    if (impl_->destroyed_)
+      impl_->service_->free_impl(impl_);
+    else if (impl_->pending_.fetch_sub(completed_,
+          std::memory_order_acq_rel) != completed_)
+      owner_->post_immediate_completion(impl_, true);
+  }
+};
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+
 strand_service::strand_service(boost::asio::io_service& io_service)
   : boost::asio::detail::service_base<strand_service>(io_service),
     io_service_(boost::asio::use_service<io_service_impl>(io_service)),
     mutex_(),
-    salt_(0)
+    salt_(0),
+#if defined(BOOST_ASIO_DISABLE_STRAND_POOL)
+    pool_size_(0),
+#else // defined(BOOST_ASIO_DISABLE_STRAND_POOL)
+    pool_size_(num_implementations),
+#endif // defined(BOOST_ASIO_DISABLE_STRAND_POOL)
+    unshared_impls_(0),
+    shutdown_(false)
 {
 }
 
+strand_service::~strand_service()
+{
+  while (unshared_impls_)
+  {
+    strand_impl* impl = unshared_impls_;
+    unshared_impls_ = impl->next_impl_;
+    delete impl;
+  }
+}
+
 void strand_service::shutdown_service()
 {
   op_queue<operation> ops;
 
   boost::asio::detail::mutex::scoped_lock lock(mutex_);
 
+  shutdown_ = true;
+
   for (std::size_t i = 0; i < num_implementations; ++i)
   {
     if (strand_impl* impl = implementations_[i].get())
@@ -64,12 +107,39 @@ void strand_service::shutdown_service()
       ops.push(impl->ready_queue_);
     }
   }
+
+  for (strand_impl* impl = unshared_impls_; impl; impl = impl->next_impl_)
+  {
+#if defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+    take_unshared(impl);
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+    ops.push(impl->waiting_queue_);
+    ops.push(impl->ready_queue_);
+  }
+}
+
+void strand_service::set_pool_size(std::size_t n)
+{
+  boost::asio::detail::mutex::scoped_lock lock(mutex_);
+  pool_size_ = n < num_implementations ? n : num_implementations;
 }
 
 void strand_service::construct(strand_service::implementation_type& impl)
 {
   boost::asio::detail::mutex::scoped_lock lock(mutex_);
 
+  if (pool_size_ == 0)
+  {
+    // The strand gets an implementation of its own.
+    impl = new strand_impl;
+    impl->service_ = this;
+    impl->next_impl_ = unshared_impls_;
+    if (unshared_impls_)
+      unshared_impls_->prev_impl_ = impl;
+    unshared_impls_ = impl;
+    return;
+  }
+
   std::size_t salt = salt_++;
 #if defined(BOOST_ASIO_ENABLE_SEQUENTIAL_STRAND_ALLOCATION)
   std::size_t index = salt;
@@ -78,13 +148,61 @@ void strand_service::construct(strand_service::implementation_type& impl)
   index += (reinterpret_cast<std::size_t>(&impl) >> 3);
   index ^= salt + 0x9e3779b9 + (index << 6) + (index >> 2);
 #endif // defined(BOOST_ASIO_ENABLE_SEQUENTIAL_STRAND_ALLOCATION)
-  index = index % num_implementations;
+  index = index % pool_size_;
 
   if (!implementations_[index].get())
     implementations_[index].reset(new strand_impl);
   impl = implementations_[index].get();
 }
 
+void strand_service::copy_construct(strand_service::implementation_type& impl,
+    const strand_service::implementation_type& other_impl)
+{
+  impl = other_impl;
+  if (impl->service_)
+    ++impl->ref_count_;
+}
+
+void strand_service::destroy(strand_service::implementation_type& impl)
+{
+  if (!impl->service_ || --impl->ref_count_ != 0)
+    return;
+
+  {
+    // Implementations left after shutdown are freed by the destructor.
+    boost::asio::detail::mutex::scoped_lock lock(mutex_);
+    if (shutdown_)
+      return;
+  }
+
+  // An idle implementation can be freed immediately. Otherwise the handlers
+  // already queued must run first, so the implementation is freed by an
+  // operation queued after them.
+#if defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+  std::size_t idle = 0;
+  if (impl->pending_.compare_exchange_strong(idle, 1,
+        std::memory_order_acq_rel))
+  {
+    free_impl(impl);
+    return;
+  }
+
+  if (push_unshared(impl, &impl->destroy_op_))
+    io_service_.post_immediate_completion(impl, false);
+#else // defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+  impl->mutex_.lock();
+  if (!impl->locked_)
+  {
+    impl->mutex_.unlock();
+    free_impl(impl);
+    return;
+  }
+
+  impl->waiting_queue_.push(&impl->destroy_op_);
+  impl->mutex_.unlock();
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+}
+
 bool strand_service::running_in_this_thread(
     const implementation_type& impl) const
 {
@@ -96,6 +214,21 @@ bool strand_service::do_dispatch(implementation_type& impl, operation* op)
   // If we are running inside the io_service, and no other handler already
   // holds the strand lock, then the handler can run immediately.
   bool can_dispatch = io_service_.can_dispatch();
+
+#if defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+  if (impl->service_)
+  {
+    std::size_t idle = 0;
+    if (can_dispatch && impl->pending_.compare_exchange_strong(
+          idle, 1, std::memory_order_acq_rel))
+      return true;
+
+    if (push_unshared(impl, op))
+      io_service_.post_immediate_completion(impl, false);
+    return false;
+  }
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+
   impl->mutex_.lock();
   if (can_dispatch && !impl->locked_)
   {
@@ -127,6 +260,15 @@ bool strand_service::do_dispatch(implementation_type& impl, operation* op)
 void strand_service::do_post(implementation_type& impl,
     operation* op, bool is_continuation)
 {
+#if defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+  if (impl->service_)
+  {
+    if (push_unshared(impl, op))
+      io_service_.post_immediate_completion(impl, is_continuation);
+    return;
+  }
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+
   impl->mutex_.lock();
   if (impl->locked_)
   {
@@ -152,6 +294,14 @@ void strand_service::do_complete(io_service_impl* owner, operation* base,
   {
     strand_impl* impl = static_cast<strand_impl*>(base);
 
+#if defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+    if (impl->service_)
+    {
+      do_complete_unshared(owner, impl, ec);
+      return;
+    }
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+
     // Indicate that this strand is executing on the current thread.
     call_stack<strand_impl>::context ctx(impl);
 
@@ -169,6 +319,93 @@ void strand_service::do_complete(io_service_impl* owner, operation* base,
   }
 }
 
+void strand_service::do_destroy(io_service_impl* owner, operation* base,
+    const boost::system::error_code& /*ec*/,
+    std::size_t /*bytes_transferred*/)
+{
+  if (owner)
+  {
+    // The implementation is freed when the strand finishes running handlers.
+    destroy_op* op = static_cast<destroy_op*>(base);
+    static_cast<strand_impl*>(op->impl_)->destroyed_ = true;
+  }
+}
+
+void strand_service::free_impl(strand_impl* impl)
+{
+  boost::asio::detail::mutex::scoped_lock lock(mutex_);
+
+  if (impl->next_impl_)
+    impl->next_impl_->prev_impl_ = impl->prev_impl_;
+  if (impl->prev_impl_)
+    impl->prev_impl_->next_impl_ = impl->next_impl_;
+  if (impl == unshared_impls_)
+    unshared_impls_ = impl->next_impl_;
+
+  lock.unlock();
+  delete impl;
+}
+
+#if defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+bool strand_service::push_unshared(strand_impl* impl, operation* op)
+{
+  // Count the handler before making it visible, so that the strand cannot be
+  // released while the handler is being added.
+  bool acquired = impl->pending_.fetch_add(1, std::memory_order_acq_rel) == 0;
+
+  operation* head = impl->incoming_.load(std::memory_order_relaxed);
+  do
+  {
+    op_queue_access::next(op, head);
+  } while (!impl->incoming_.compare_exchange_weak(head, op,
+        std::memory_order_release, std::memory_order_relaxed));
+
+  return acquired;
+}
+
+void strand_service::take_unshared(strand_impl* impl)
+{
+  operation* head = impl->incoming_.exchange(0, std::memory_order_acquire);
+
+  // The list is in reverse order of arrival.
+  operation* reversed = 0;
+  while (head)
+  {
+    operation* next = op_queue_access::next(head);
+    op_queue_access::next(head, reversed);
+    reversed = head;
+    head = next;
+  }
+
+  while (reversed)
+  {
+    operation* next = op_queue_access::next(reversed);
+    impl->ready_queue_.push(reversed);
+    reversed = next;
+  }
+}
+
+void strand_service::do_complete_unshared(io_service_impl* owner,
+    strand_impl* impl, const boost::system::error_code& ec)
+{
+  // Indicate that this strand is executing on the current thread.
+  call_stack<strand_impl>::context ctx(impl);
+
+  // Ensure the next handler, if any, is scheduled on block exit.
+  on_unshared_complete_exit on_exit = { owner, impl, 0 };
+
+  // Run the handlers that have been added so far. Handlers added while these
+  // run are left for the next time the strand is scheduled.
+  take_unshared(impl);
+  while (operation* o = impl->ready_queue_.front())
+  {
+    impl->ready_queue_.pop();
+    ++on_exit.completed_;
+    o->complete(*owner, ec, 0);
+  }
+}
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+
 } // namespace detail
 } // namespace asio
 } // namespace boost
@@ -47,6 +47,10 @@ struct task_io_service::task_cleanup
     // the operation queue.
     lock_->lock();
     task_io_service_->task_interrupted_ = true;
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+    task_io_service_->task_blocked_hint_.store(
+        false, boost::memory_order_relaxed);
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
     task_io_service_->op_queue_.push(this_thread_->private_op_queue);
     task_io_service_->op_queue_.push(&task_io_service_->task_operation_);
   }
@@ -86,6 +90,21 @@ struct task_io_service::work_cleanup
   thread_info* this_thread_;
 };
 
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+struct task_io_service::local_queue_cleanup
+{
+  ~local_queue_cleanup()
+  {
+    lock_->lock();
+    task_io_service_->release_local_queue(*lock_, *this_thread_);
+  }
+
+  task_io_service* task_io_service_;
+  mutex::scoped_lock* lock_;
+  thread_info* this_thread_;
+};
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+
 task_io_service::task_io_service(
     boost::asio::io_service& io_service, std::size_t concurrency_hint)
   : boost::asio::detail::service_base<task_io_service>(io_service),
@@ -97,9 +116,37 @@ task_io_service::task_io_service(
     stopped_(false),
     shutdown_(false),
     first_idle_thread_(0)
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+    , local_queues_(),
+    idle_thread_count_(0),
+    stopped_hint_(false),
+    task_blocked_hint_(false),
+    task_deferred_(false)
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
 {
   BOOST_ASIO_HANDLER_TRACKING_INIT;
+
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+  // A single thread already queues its handlers privately.
+  if (!one_thread_)
+  {
+    std::size_t count = concurrency_hint < max_local_queues
+      ? concurrency_hint : static_cast<std::size_t>(max_local_queues);
+    local_queues_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+      local_queues_.push_back(
+          new lockfree_op_queue<operation>(local_queue_capacity));
+  }
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+}
+
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+task_io_service::~task_io_service()
+{
+  for (std::size_t i = 0; i < local_queues_.size(); ++i)
+    delete local_queues_[i];
 }
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
 
 void task_io_service::shutdown_service()
 {
@@ -116,6 +163,12 @@ void task_io_service::shutdown_service()
       o->destroy();
   }
 
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+  for (std::size_t i = 0; i < local_queues_.size(); ++i)
+    while (operation* o = local_queues_[i]->pop())
+      o->destroy();
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+
   // Reset to initial state.
   task_ = 0;
 }
@@ -144,15 +197,34 @@ std::size_t task_io_service::run(boost::system::error_code& ec)
   event wakeup_event;
   this_thread.wakeup_event = &wakeup_event;
   this_thread.private_outstanding_work = 0;
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+  this_thread.local_op_queue = 0;
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
   this_thread.next = 0;
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
 
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+  claim_local_queue(this_thread);
+  local_queue_cleanup on_exit = { this, &lock, &this_thread };
+  (void)on_exit;
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+
   std::size_t n = 0;
   for (; do_run_one(lock, this_thread, ec); lock.lock())
+  {
     if (n != (std::numeric_limits<std::size_t>::max)())
       ++n;
+
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+    std::size_t local_n = do_run_local(lock, this_thread, ec);
+    if (local_n > (std::numeric_limits<std::size_t>::max)() - n)
+      n = (std::numeric_limits<std::size_t>::max)();
+    else
+      n += local_n;
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+  }
   return n;
 }
 
@@ -169,6 +241,9 @@ std::size_t task_io_service::run_one(boost::system::error_code& ec)
   event wakeup_event;
   this_thread.wakeup_event = &wakeup_event;
   this_thread.private_outstanding_work = 0;
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+  this_thread.local_op_queue = 0;
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
   this_thread.next = 0;
   thread_call_stack::context ctx(this, this_thread);
 
@@ -189,6 +264,9 @@ std::size_t task_io_service::poll(boost::system::error_code& ec)
   thread_info this_thread;
   this_thread.wakeup_event = 0;
   this_thread.private_outstanding_work = 0;
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+  this_thread.local_op_queue = 0;
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
   this_thread.next = 0;
   thread_call_stack::context ctx(this, this_thread);
 
@@ -222,6 +300,9 @@ std::size_t task_io_service::poll_one(boost::system::error_code& ec)
   thread_info this_thread;
   this_thread.wakeup_event = 0;
   this_thread.private_outstanding_work = 0;
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+  this_thread.local_op_queue = 0;
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
   this_thread.next = 0;
   thread_call_stack::context ctx(this, this_thread);
 
@@ -255,6 +336,9 @@ void task_io_service::reset()
 {
   mutex::scoped_lock lock(mutex_);
   stopped_ = false;
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+  stopped_hint_.store(false, boost::memory_order_release);
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
 }
 
 void task_io_service::post_immediate_completion(
@@ -273,6 +357,10 @@ void task_io_service::post_immediate_completion(
 #endif // defined(BOOST_ASIO_HAS_THREADS)
 
   work_started();
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+  if (push_local(op))
+    return;
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
@@ -291,6 +379,10 @@ void task_io_service::post_deferred_completion(task_io_service::operation* op)
   }
 #endif // defined(BOOST_ASIO_HAS_THREADS)
 
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+  if (push_local(op))
+    return;
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
@@ -312,6 +404,13 @@ void task_io_service::post_deferred_completions(
     }
 #endif // defined(BOOST_ASIO_HAS_THREADS)
 
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+    while (!ops.empty() && push_local(ops.front()))
+      ops.pop();
+    if (ops.empty())
+      return;
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+
     mutex::scoped_lock lock(mutex_);
     op_queue_.push(ops);
     wake_one_thread_and_unlock(lock);
@@ -322,6 +421,10 @@ void task_io_service::do_dispatch(
     task_io_service::operation* op)
 {
   work_started();
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+  if (push_local(op))
+    return;
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
@@ -349,6 +452,48 @@ std::size_t task_io_service::do_run_one(mutex::scoped_lock& lock,
 
       if (o == &task_operation_)
       {
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+        if (!more_handlers && !task_deferred_)
+        {
+          // Run a handler from the per-thread queues before the task, as
+          // the task would otherwise be found at the front of the queue
+          // again and keep this thread from ever stealing.
+          if (operation* local_op = pop_local(this_thread))
+          {
+            task_deferred_ = true;
+            op_queue_.push(&task_operation_);
+
+            std::size_t task_result = local_op->task_result_;
+
+            lock.unlock();
+
+            // Ensure the count of outstanding work is decremented on block
+            // exit.
+            work_cleanup on_exit = { this, &lock, &this_thread };
+            (void)on_exit;
+
+            // Complete the operation. May throw an exception. Deletes the
+            // object.
+            local_op->complete(*this, ec, task_result);
+
+            return 1;
+          }
+        }
+        task_deferred_ = false;
+
+        if (!more_handlers)
+        {
+          // Pairs with the fence in push_local, so that either the task sees
+          // the operation or the pushing thread sees that it must interrupt
+          // the task.
+          task_blocked_hint_.store(true, boost::memory_order_relaxed);
+          boost::atomic_thread_fence(boost::memory_order_seq_cst);
+          more_handlers = !local_queues_empty();
+          if (more_handlers)
+            task_blocked_hint_.store(false, boost::memory_order_relaxed);
+        }
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+
         task_interrupted_ = more_handlers;
 
         if (more_handlers && !one_thread_)
@@ -386,12 +531,44 @@ std::size_t task_io_service::do_run_one(mutex::scoped_lock& lock,
         return 1;
       }
     }
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+    else if (operation* o = pop_local(this_thread))
+    {
+      std::size_t task_result = o->task_result_;
+
+      lock.unlock();
+
+      // Ensure the count of outstanding work is decremented on block exit.
+      work_cleanup on_exit = { this, &lock, &this_thread };
+      (void)on_exit;
+
+      // Complete the operation. May throw an exception. Deletes the object.
+      o->complete(*this, ec, task_result);
+
+      return 1;
+    }
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
     else
     {
       // Nothing to run right now, so just wait for work to do.
       this_thread.next = first_idle_thread_;
       first_idle_thread_ = &this_thread;
       this_thread.wakeup_event->clear(lock);
+
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+      // Threads pushing to their own queues only wake an idle thread if they
+      // can see one, so check the queues again after becoming visible.
+      ++idle_thread_count_;
+      boost::atomic_thread_fence(boost::memory_order_seq_cst);
+      if (!local_queues_empty())
+      {
+        first_idle_thread_ = this_thread.next;
+        this_thread.next = 0;
+        --idle_thread_count_;
+        continue;
+      }
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+
       this_thread.wakeup_event->wait(lock);
     }
   }
@@ -425,10 +602,38 @@ std::size_t task_io_service::do_poll_one(mutex::scoped_lock& lock,
     o = op_queue_.front();
     if (o == &task_operation_)
     {
-      wake_one_idle_thread_and_unlock(lock);
-      return 0;
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+      // Handlers on the per-thread queues can still be run.
+      o = 0;
+      if (local_queues_empty())
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+      {
+        wake_one_idle_thread_and_unlock(lock);
+        return 0;
+      }
+    }
+  }
+
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+  if (o == 0)
+  {
+    if (operation* local_op = pop_local(this_thread))
+    {
+      std::size_t task_result = local_op->task_result_;
+
+      lock.unlock();
+
+      // Ensure the count of outstanding work is decremented on block exit.
+      work_cleanup on_exit = { this, &lock, &this_thread };
+      (void)on_exit;
+
+      // Complete the operation. May throw an exception. Deletes the object.
+      local_op->complete(*this, ec, task_result);
+
+      return 1;
     }
   }
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
 
   if (o == 0)
     return 0;
@@ -457,12 +662,18 @@ void task_io_service::stop_all_threads(
     mutex::scoped_lock& lock)
 {
   stopped_ = true;
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+  stopped_hint_.store(true, boost::memory_order_release);
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
 
   while (first_idle_thread_)
   {
     thread_info* idle_thread = first_idle_thread_;
     first_idle_thread_ = idle_thread->next;
     idle_thread->next = 0;
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+    --idle_thread_count_;
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
     idle_thread->wakeup_event->signal(lock);
   }
 
@@ -481,6 +692,9 @@ bool task_io_service::wake_one_idle_thread_and_unlock(
     thread_info* idle_thread = first_idle_thread_;
     first_idle_thread_ = idle_thread->next;
     idle_thread->next = 0;
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+    --idle_thread_count_;
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
     idle_thread->wakeup_event->signal_and_unlock(lock);
     return true;
   }
@@ -495,12 +709,129 @@ void task_io_service::wake_one_thread_and_unlock(
     if (!task_interrupted_ && task_)
     {
       task_interrupted_ = true;
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+      task_blocked_hint_.store(false, boost::memory_order_relaxed);
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
       task_->interrupt();
     }
     lock.unlock();
   }
 }
 
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+void task_io_service::claim_local_queue(
+    task_io_service::thread_info& this_thread)
+{
+  for (std::size_t i = 0; i < local_queues_.size(); ++i)
+  {
+    if (!local_queues_[i]->owned())
+    {
+      local_queues_[i]->owned(true);
+      this_thread.local_op_queue = local_queues_[i];
+      return;
+    }
+  }
+}
+
+void task_io_service::release_local_queue(mutex::scoped_lock& lock,
+    task_io_service::thread_info& this_thread)
+{
+  if (lockfree_op_queue<operation>* queue = this_thread.local_op_queue)
+  {
+    this_thread.local_op_queue = 0;
+    queue->owned(false);
+
+    // Only the owning thread pushes to a queue, so it cannot refill.
+    bool moved = false;
+    while (operation* o = queue->pop())
+    {
+      op_queue_.push(o);
+      moved = true;
+    }
+
+    if (moved)
+      wake_one_thread_and_unlock(lock);
+  }
+}
+
+bool task_io_service::push_local(task_io_service::operation* op)
+{
+  thread_info* this_thread = thread_call_stack::contains(this);
+  if (!this_thread || !this_thread->local_op_queue)
+    return false;
+
+  if (!this_thread->local_op_queue->push(op))
+    return false;
+
+  // Pairs with the fences in do_run_one, so that either the idle thread or
+  // the thread about to block in the task sees the operation, or we see that
+  // thread. Without an idle thread, the task is interrupted so that the
+  // thread running it can steal the operation.
+  boost::atomic_thread_fence(boost::memory_order_seq_cst);
+  if (idle_thread_count_ > 0
+      || task_blocked_hint_.load(boost::memory_order_relaxed))
+  {
+    mutex::scoped_lock lock(mutex_);
+    wake_one_thread_and_unlock(lock);
+  }
+
+  return true;
+}
+
+task_io_service::operation* task_io_service::pop_local(
+    task_io_service::thread_info& this_thread)
+{
+  if (this_thread.local_op_queue)
+    if (operation* o = this_thread.local_op_queue->pop())
+      return o;
+
+  for (std::size_t i = 0; i < local_queues_.size(); ++i)
+    if (local_queues_[i] != this_thread.local_op_queue)
+      if (operation* o = local_queues_[i]->pop())
+        return o;
+
+  return 0;
+}
+
+bool task_io_service::local_queues_empty()
+{
+  for (std::size_t i = 0; i < local_queues_.size(); ++i)
+    if (!local_queues_[i]->empty())
+      return false;
+  return true;
+}
+
+std::size_t task_io_service::do_run_local(mutex::scoped_lock& lock,
+    task_io_service::thread_info& this_thread,
+    const boost::system::error_code& ec)
+{
+  if (!this_thread.local_op_queue)
+    return 0;
+
+  std::size_t n = 0;
+  while (n < local_batch_size && !lock.locked()
+      && !stopped_hint_.load(boost::memory_order_acquire))
+  {
+    operation* o = this_thread.local_op_queue->pop();
+    if (!o)
+      break;
+
+    std::size_t task_result = o->task_result_;
+
+    // Ensure the count of outstanding work is decremented on block exit.
+    work_cleanup on_exit = { this, &lock, &this_thread };
+    (void)on_exit;
+
+    // Complete the operation. May throw an exception. Deletes the object.
+    o->complete(*this, ec, task_result);
+
+    ++n;
+  }
+
+  return n;
+}
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+
 } // namespace detail
 } // namespace asio
 } // namespace boost
@@ -0,0 +1,141 @@
+//
+// detail/io_uring_operation.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IO_URING_OPERATION_HPP
+#define BOOST_ASIO_DETAIL_IO_URING_OPERATION_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <cerrno>
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <boost/asio/error.hpp>
+#include <boost/asio/detail/operation.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+class io_uring_operation
+  : public operation
+{
+public:
+  // The error code to be passed to the completion handler.
+  boost::system::error_code ec_;
+
+  // The number of bytes transferred, to be passed to the completion handler.
+  std::size_t bytes_transferred_;
+
+  // Fill in the submission queue entry for the operation.
+  void prepare(::io_uring_sqe* sqe)
+  {
+    prepare_func_(this, sqe);
+  }
+
+  // Process the result of a completion queue entry. Returns true if the
+  // operation is finished, or false if it must be submitted again.
+  bool perform(int result)
+  {
+    return perform_func_(this, result);
+  }
+
+protected:
+  typedef void (*prepare_func_type)(io_uring_operation*, ::io_uring_sqe*);
+  typedef bool (*perform_func_type)(io_uring_operation*, int);
+
+  io_uring_operation(prepare_func_type prepare_func,
+      perform_func_type perform_func, func_type complete_func)
+    : operation(complete_func),
+      bytes_transferred_(0),
+      prepare_func_(prepare_func),
+      perform_func_(perform_func),
+      polling_(false),
+      object_ops_(0),
+      object_next_(0)
+  {
+  }
+
+  // Store a negated errno value from a completion queue entry as an error.
+  void set_error(int result)
+  {
+    if (result == -ECANCELED)
+      ec_ = boost::asio::error::operation_aborted;
+    else
+      ec_ = boost::system::error_code(-result,
+          boost::asio::error::get_system_category());
+  }
+
+  // Whether the next submission should wait for the descriptor to become
+  // ready, rather than retry the operation itself.
+  bool polling() const
+  {
+    return polling_;
+  }
+
+  // Fill in a submission queue entry that waits for readiness.
+  static void prepare_poll(::io_uring_sqe* sqe, int descriptor, int events)
+  {
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = descriptor;
+    sqe->poll_events = static_cast<__u16>(events);
+  }
+
+  // Returns true if the operation must be submitted again. The kernel reports
+  // EAGAIN for descriptors in non-blocking mode, in which case the operation
+  // waits for readiness before being retried.
+  bool wait_ready(int result)
+  {
+    if (polling_)
+    {
+      polling_ = false;
+      return result >= 0;
+    }
+
+    if (result == -EAGAIN || result == -EWOULDBLOCK)
+    {
+      polling_ = true;
+      return true;
+    }
+
+    return result == -EINTR;
+  }
+
+private:
+  friend class io_uring_service;
+  prepare_func_type prepare_func_;
+  perform_func_type perform_func_;
+
+  // Whether the last submission was a readiness poll.
+  bool polling_;
+
+  // The head of the owning I/O object's list of outstanding operations, if
+  // the operation is still associated with an object, and the next operation
+  // in that list.
+  io_uring_operation** object_ops_;
+  io_uring_operation* object_next_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IO_URING_OPERATION_HPP
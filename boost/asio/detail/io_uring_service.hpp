@@ -0,0 +1,238 @@
+//
+// detail/io_uring_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IO_URING_SERVICE_HPP
+#define BOOST_ASIO_DETAIL_IO_URING_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <linux/io_uring.h>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/detail/io_uring_operation.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/object_pool.hpp>
+#include <boost/asio/detail/op_queue.hpp>
+#include <boost/asio/detail/reactor.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Submits operations to a Linux io_uring instance and delivers their
+// completions through the io_service. The ring's completion queue is tied to
+// an eventfd that is watched by the reactor, so the reactor remains the single
+// place where the io_service blocks.
+class io_uring_service
+  : public boost::asio::detail::service_base<io_uring_service>
+{
+public:
+  // Per I/O object state.
+  class io_object
+  {
+    friend class io_uring_service;
+    friend class object_pool_access;
+
+    io_object* next_;
+    io_object* prev_;
+
+    // The operations started on the object that have not yet completed.
+    io_uring_operation* ops_;
+  };
+
+  // Per I/O object data.
+  typedef io_object* per_io_object_data;
+
+  // Constructor.
+  BOOST_ASIO_DECL io_uring_service(boost::asio::io_service& io_service);
+
+  // Destructor.
+  BOOST_ASIO_DECL ~io_uring_service();
+
+  // Destroy all user-defined handler objects owned by the service.
+  BOOST_ASIO_DECL void shutdown_service();
+
+  // Whether the ring could be created. If not, callers must fall back to the
+  // reactor.
+  bool enabled() const
+  {
+    return ring_fd_ != -1;
+  }
+
+  // Post an operation for immediate completion.
+  void post_immediate_completion(operation* op, bool is_continuation)
+  {
+    io_service_.post_immediate_completion(op, is_continuation);
+  }
+
+  // Start a new operation. The operation's submission queue entry is not
+  // passed to the kernel immediately, but is batched with any other entries
+  // prepared before the io_service next runs the submission handler.
+  BOOST_ASIO_DECL void start_op(per_io_object_data& io_object_data,
+      io_uring_operation* op, bool is_continuation, bool noop);
+
+  // Cancel all outstanding operations associated with the I/O object. The
+  // cancelled operations complete with the operation_aborted error.
+  BOOST_ASIO_DECL void cancel_ops(per_io_object_data& io_object_data);
+
+  // Cancel any outstanding operations and release the per-object state.
+  BOOST_ASIO_DECL void deregister_io_object(
+      per_io_object_data& io_object_data);
+
+  // Move the per-object state from one I/O object to another.
+  void move_io_object(per_io_object_data& target_io_object_data,
+      per_io_object_data& source_io_object_data)
+  {
+    target_io_object_data = source_io_object_data;
+    source_io_object_data = 0;
+  }
+
+private:
+  // The reactor operation that watches the ring's eventfd.
+  class event_fd_read_op;
+  friend class event_fd_read_op;
+
+  // The operation used to submit batched entries to the kernel.
+  class submit_op;
+  friend class submit_op;
+
+  // Create the ring and map its queues. Leaves the service disabled on
+  // failure.
+  BOOST_ASIO_DECL void open_ring();
+
+  // Unmap the ring's queues and close its descriptors.
+  BOOST_ASIO_DECL void close_ring();
+
+  // Get a free submission queue entry, submitting pending entries to make
+  // room if necessary. Returns 0 if no entry can be obtained.
+  BOOST_ASIO_DECL ::io_uring_sqe* get_sqe(mutex::scoped_lock& lock);
+
+  // Pass all pending submission queue entries to the kernel.
+  BOOST_ASIO_DECL void submit_pending(mutex::scoped_lock& lock);
+
+  // Enter the kernel to submit entries or wait for completions. Returns the
+  // number of entries consumed, or a negated errno value.
+  BOOST_ASIO_DECL int enter(unsigned to_submit,
+      unsigned min_complete, unsigned flags);
+
+  // Ensure that a submit_op is queued with the io_service.
+  BOOST_ASIO_DECL void schedule_submit(mutex::scoped_lock& lock,
+      bool is_continuation);
+
+  // Process all available completion queue entries, including any that the
+  // kernel held back because the queue was full. Finished operations are
+  // added to the given queue.
+  BOOST_ASIO_DECL void reap(mutex::scoped_lock& lock,
+      op_queue<operation>& ops);
+
+  // Queue cancellation entries for all of an object's operations.
+  BOOST_ASIO_DECL void cancel_object_ops(mutex::scoped_lock& lock,
+      io_object* object);
+
+  // Remove an operation from its object's list of outstanding operations.
+  BOOST_ASIO_DECL static void unlink_op(io_uring_operation* op);
+
+  // The number of submission queue entries to request for the ring.
+#if defined(BOOST_ASIO_IO_URING_ENTRIES)
+  enum { ring_entries = BOOST_ASIO_IO_URING_ENTRIES };
+#else // defined(BOOST_ASIO_IO_URING_ENTRIES)
+  enum { ring_entries = 256 };
+#endif // defined(BOOST_ASIO_IO_URING_ENTRIES)
+
+  // The number of completion queue entries to request for the ring. Every
+  // outstanding operation may complete at once, so this is larger than the
+  // submission queue. Completions that still do not fit are held back by the
+  // kernel until they are flushed by reap().
+#if defined(BOOST_ASIO_IO_URING_CQ_ENTRIES)
+  enum { ring_cq_entries = BOOST_ASIO_IO_URING_CQ_ENTRIES };
+#else // defined(BOOST_ASIO_IO_URING_CQ_ENTRIES)
+  enum { ring_cq_entries = 16 * ring_entries };
+#endif // defined(BOOST_ASIO_IO_URING_CQ_ENTRIES)
+
+  // The io_service implementation used to post completions.
+  io_service_impl& io_service_;
+
+  // The reactor used to wait for the ring's eventfd to become readable.
+  reactor& reactor_;
+
+  // Per-descriptor data used by the reactor for the eventfd.
+  reactor::per_descriptor_data reactor_data_;
+
+  // Mutex to protect access to internal data.
+  mutex mutex_;
+
+  // The io_uring file descriptor.
+  int ring_fd_;
+
+  // The eventfd that is signalled when completions are available.
+  int event_fd_;
+
+  // The mapped submission and completion queue rings.
+  void* sq_ring_;
+  std::size_t sq_ring_size_;
+  void* cq_ring_;
+  std::size_t cq_ring_size_;
+  ::io_uring_sqe* sqes_;
+  std::size_t sqes_size_;
+
+  // Pointers into the mapped submission queue ring.
+  unsigned* sq_head_;
+  unsigned* sq_tail_;
+  unsigned sq_mask_;
+  unsigned sq_entries_;
+  unsigned* sq_array_;
+  unsigned* sq_flags_;
+
+  // Pointers into the mapped completion queue ring.
+  unsigned* cq_head_;
+  unsigned* cq_tail_;
+  unsigned cq_mask_;
+  unsigned cq_entries_;
+  ::io_uring_cqe* cqes_;
+
+  // The number of prepared entries not yet passed to the kernel.
+  unsigned pending_;
+
+  // The number of operations passed to the kernel that have not completed.
+  std::size_t outstanding_;
+
+  // Whether a submit_op is currently queued with the io_service.
+  bool submit_scheduled_;
+
+  // The operation used to submit batched entries.
+  submit_op* submit_op_;
+
+  // Whether the service has been shut down.
+  bool shutdown_;
+
+  // The per-object state.
+  object_pool<io_object> registered_io_objects_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/detail/impl/io_uring_service.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IO_URING_SERVICE_HPP
@@ -0,0 +1,265 @@
+//
+// detail/io_uring_socket_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IO_URING_SOCKET_SERVICE_HPP
+#define BOOST_ASIO_DETAIL_IO_URING_SOCKET_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/socket_base.hpp>
+#include <boost/asio/detail/addressof.hpp>
+#include <boost/asio/detail/buffer_sequence_adapter.hpp>
+#include <boost/asio/detail/io_uring_service.hpp>
+#include <boost/asio/detail/io_uring_socket_recv_op.hpp>
+#include <boost/asio/detail/io_uring_socket_send_op.hpp>
+#include <boost/asio/detail/reactive_socket_service.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A socket service that performs sends and receives using io_uring. All other
+// operations, including connects, accepts and waits for readiness, use the
+// reactor.
+template <typename Protocol>
+class io_uring_socket_service :
+  public reactive_socket_service<Protocol>
+{
+public:
+  // The protocol type.
+  typedef Protocol protocol_type;
+
+  // The base service type.
+  typedef reactive_socket_service<Protocol> base_service_type;
+
+  // The implementation type of the socket.
+  struct implementation_type :
+    base_service_type::implementation_type
+  {
+    // Default constructor.
+    implementation_type()
+      : io_object_data_(0)
+    {
+    }
+
+    // Per-object data used by the io_uring service.
+    io_uring_service::per_io_object_data io_object_data_;
+  };
+
+  // Constructor.
+  io_uring_socket_service(boost::asio::io_service& io_service)
+    : base_service_type(io_service),
+      io_uring_service_(boost::asio::use_service<io_uring_service>(io_service))
+  {
+  }
+
+  // Construct a new socket implementation.
+  void construct(implementation_type& impl)
+  {
+    base_service_type::construct(impl);
+    impl.io_object_data_ = 0;
+  }
+
+  // Move-construct a new socket implementation.
+  void move_construct(implementation_type& impl,
+      implementation_type& other_impl)
+  {
+    base_service_type::move_construct(impl, other_impl);
+    io_uring_service_.move_io_object(
+        impl.io_object_data_, other_impl.io_object_data_);
+  }
+
+  // Move-assign from another socket implementation.
+  void move_assign(implementation_type& impl,
+      io_uring_socket_service& other_service,
+      implementation_type& other_impl)
+  {
+    io_uring_service_.deregister_io_object(impl.io_object_data_);
+    base_service_type::move_assign(impl, other_service, other_impl);
+
+    if (&other_service.io_uring_service_ == &io_uring_service_)
+    {
+      io_uring_service_.move_io_object(
+          impl.io_object_data_, other_impl.io_object_data_);
+    }
+    else
+    {
+      // Operations cannot migrate between rings, so any that are outstanding
+      // on the other object are cancelled.
+      other_service.io_uring_service_.deregister_io_object(
+          other_impl.io_object_data_);
+    }
+  }
+
+  // Move-construct a new socket implementation from another protocol type.
+  template <typename Protocol1>
+  void converting_move_construct(implementation_type& impl,
+      typename io_uring_socket_service<
+        Protocol1>::implementation_type& other_impl)
+  {
+    base_service_type::template converting_move_construct<Protocol1>(
+        impl, other_impl);
+    io_uring_service_.move_io_object(
+        impl.io_object_data_, other_impl.io_object_data_);
+  }
+
+  // Destroy a socket implementation.
+  void destroy(implementation_type& impl)
+  {
+    io_uring_service_.deregister_io_object(impl.io_object_data_);
+    base_service_type::destroy(impl);
+  }
+
+  // Destroy a socket implementation.
+  boost::system::error_code close(implementation_type& impl,
+      boost::system::error_code& ec)
+  {
+    io_uring_service_.deregister_io_object(impl.io_object_data_);
+    return base_service_type::close(impl, ec);
+  }
+
+  // Cancel all operations associated with the socket.
+  boost::system::error_code cancel(implementation_type& impl,
+      boost::system::error_code& ec)
+  {
+    if (!base_service_type::cancel(impl, ec))
+      io_uring_service_.cancel_ops(impl.io_object_data_);
+    return ec;
+  }
+
+  // Start an asynchronous send. The data being sent must be valid for the
+  // lifetime of the asynchronous operation.
+  template <typename ConstBufferSequence, typename Handler>
+  void async_send(implementation_type& impl,
+      const ConstBufferSequence& buffers,
+      socket_base::message_flags flags, Handler handler)
+  {
+    // Zero-copy sends must wait for notifications on the socket's error
+    // queue, which only the reactor can watch.
+    if (!io_uring_service_.enabled()
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+        || (flags & socket_base::message_zero_copy) != 0
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+        )
+    {
+      base_service_type::async_send(impl, buffers, flags, handler);
+      return;
+    }
+
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_send_op<ConstBufferSequence, Handler> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      boost_asio_handler_alloc_helpers::allocate(
+        sizeof(op), handler), 0 };
+    p.p = new (p.v) op(impl.socket_, impl.state_, buffers, flags, handler);
+
+    BOOST_ASIO_HANDLER_CREATION((p.p, "socket", &impl, "async_send"));
+
+    start_op(impl, p.p, is_continuation,
+        ((impl.state_ & socket_ops::stream_oriented)
+          && buffer_sequence_adapter<boost::asio::const_buffer,
+            ConstBufferSequence>::all_empty(buffers)));
+    p.v = p.p = 0;
+  }
+
+  // Start an asynchronous wait until data can be sent without blocking.
+  template <typename Handler>
+  void async_send(implementation_type& impl, const null_buffers& buffers,
+      socket_base::message_flags flags, Handler handler)
+  {
+    base_service_type::async_send(impl, buffers, flags, handler);
+  }
+
+  // Start an asynchronous receive. The buffer for the data being received
+  // must be valid for the lifetime of the asynchronous operation.
+  template <typename MutableBufferSequence, typename Handler>
+  void async_receive(implementation_type& impl,
+      const MutableBufferSequence& buffers,
+      socket_base::message_flags flags, Handler handler)
+  {
+    // Out-of-band data is signalled as an exceptional condition, which only
+    // the reactor can wait for.
+    if (!io_uring_service_.enabled()
+        || (flags & socket_base::message_out_of_band) != 0)
+    {
+      base_service_type::async_receive(impl, buffers, flags, handler);
+      return;
+    }
+
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_recv_op<MutableBufferSequence, Handler> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      boost_asio_handler_alloc_helpers::allocate(
+        sizeof(op), handler), 0 };
+    p.p = new (p.v) op(impl.socket_, impl.state_, buffers, flags, handler);
+
+    BOOST_ASIO_HANDLER_CREATION((p.p, "socket", &impl, "async_receive"));
+
+    start_op(impl, p.p, is_continuation,
+        ((impl.state_ & socket_ops::stream_oriented)
+          && buffer_sequence_adapter<boost::asio::mutable_buffer,
+            MutableBufferSequence>::all_empty(buffers)));
+    p.v = p.p = 0;
+  }
+
+  // Wait until data can be received without blocking.
+  template <typename Handler>
+  void async_receive(implementation_type& impl, const null_buffers& buffers,
+      socket_base::message_flags flags, Handler handler)
+  {
+    base_service_type::async_receive(impl, buffers, flags, handler);
+  }
+
+private:
+  // Start the asynchronous operation.
+  void start_op(implementation_type& impl,
+      io_uring_operation* op, bool is_continuation, bool noop)
+  {
+    if (!noop && !this->is_open(impl))
+    {
+      op->ec_ = boost::asio::error::bad_descriptor;
+      io_uring_service_.post_immediate_completion(op, is_continuation);
+      return;
+    }
+
+    io_uring_service_.start_op(impl.io_object_data_,
+        op, is_continuation, noop);
+  }
+
+  // The io_uring service used to perform sends and receives.
+  io_uring_service& io_uring_service_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IO_URING_SOCKET_SERVICE_HPP
@@ -0,0 +1,98 @@
+//
+// detail/lockfree_op_queue.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_LOCKFREE_OP_QUEUE_HPP
+#define BOOST_ASIO_DETAIL_LOCKFREE_OP_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+
+#include <cstddef>
+#include <boost/lockfree/queue.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A bounded queue of operations that may be pushed and popped concurrently
+// without a lock. Each queue is owned by one thread, which is the only thread
+// to push to it, while any thread may pop from it to steal work.
+template <typename Operation>
+class lockfree_op_queue
+  : private noncopyable
+{
+public:
+  // Constructor.
+  explicit lockfree_op_queue(std::size_t capacity)
+    : queue_(capacity),
+      owned_(false)
+  {
+  }
+
+  // Add an operation to the back of the queue. Returns false if the queue is
+  // full.
+  bool push(Operation* op)
+  {
+    return queue_.bounded_push(op);
+  }
+
+  // Remove the operation at the front of the queue, if any.
+  Operation* pop()
+  {
+    Operation* op = 0;
+    return queue_.pop(op) ? op : 0;
+  }
+
+  // Whether the queue appears to be empty. The result is only a snapshot when
+  // other threads are using the queue.
+  bool empty()
+  {
+    return queue_.empty();
+  }
+
+  // Whether the queue is currently owned by a thread. Protected by the mutex
+  // of the owning task_io_service.
+  bool owned() const
+  {
+    return owned_;
+  }
+
+  // Set whether the queue is owned by a thread.
+  void owned(bool value)
+  {
+    owned_ = value;
+  }
+
+private:
+  // The underlying queue.
+  boost::lockfree::queue<Operation*,
+      boost::lockfree::fixed_sized<true> > queue_;
+
+  // Whether the queue is owned by a thread.
+  bool owned_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+
+#endif // BOOST_ASIO_DETAIL_LOCKFREE_OP_QUEUE_HPP
@@ -20,6 +20,7 @@
 #include <boost/asio/detail/bind_handler.hpp>
 #include <boost/asio/detail/buffer_sequence_adapter.hpp>
 #include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/reactive_socket_service_base.hpp>
 #include <boost/asio/detail/reactor_op.hpp>
 #include <boost/asio/detail/socket_holder.hpp>
 #include <boost/asio/detail/socket_ops.hpp>
@@ -53,9 +54,10 @@ public:
 
     std::size_t addrlen = o->peer_endpoint_ ? o->peer_endpoint_->capacity() : 0;
     socket_type new_socket = invalid_socket;
+    socket_ops::state_type new_state = socket_ops::internal_non_blocking;
     bool result = socket_ops::non_blocking_accept(o->socket_,
           o->state_, o->peer_endpoint_ ? o->peer_endpoint_->data() : 0,
-          o->peer_endpoint_ ? &addrlen : 0, o->ec_, new_socket);
+          o->peer_endpoint_ ? &addrlen : 0, o->ec_, new_socket, new_state);
 
     // On success, assign new connection to peer socket object.
     if (new_socket >= 0)
@@ -64,7 +66,10 @@ public:
       if (o->peer_endpoint_)
         o->peer_endpoint_->resize(addrlen);
       if (!o->peer_.assign(o->protocol_, new_socket, o->ec_))
+      {
         new_socket_holder.release();
+        reactive_socket_service_base::set_accepted_state(o->peer_, new_state);
+      }
     }
 
     return result;
@@ -25,11 +25,14 @@
 #include <boost/asio/socket_base.hpp>
 #include <boost/asio/detail/addressof.hpp>
 #include <boost/asio/detail/buffer_sequence_adapter.hpp>
+#include <boost/asio/detail/datagram_batch.hpp>
 #include <boost/asio/detail/noncopyable.hpp>
 #include <boost/asio/detail/reactive_null_buffers_op.hpp>
 #include <boost/asio/detail/reactive_socket_accept_op.hpp>
 #include <boost/asio/detail/reactive_socket_connect_op.hpp>
 #include <boost/asio/detail/reactive_socket_recvfrom_op.hpp>
+#include <boost/asio/detail/reactive_socket_recvmmsg_op.hpp>
+#include <boost/asio/detail/reactive_socket_sendmmsg_op.hpp>
 #include <boost/asio/detail/reactive_socket_sendto_op.hpp>
 #include <boost/asio/detail/reactive_socket_service_base.hpp>
 #include <boost/asio/detail/reactor.hpp>
@@ -206,7 +209,7 @@ public:
         ConstBufferSequence> bufs(buffers);
 
     return socket_ops::sync_sendto(impl.socket_, impl.state_,
-        bufs.buffers(), bufs.count(), flags,
+        bufs.buffers(), bufs.count(), without_zero_copy(flags),
         destination.data(), destination.size(), ec);
   }
 
@@ -238,7 +241,8 @@ public:
     typename op::ptr p = { boost::asio::detail::addressof(handler),
       boost_asio_handler_alloc_helpers::allocate(
         sizeof(op), handler), 0 };
-    p.p = new (p.v) op(impl.socket_, buffers, destination, flags, handler);
+    p.p = new (p.v) op(impl.socket_, buffers,
+        destination, without_zero_copy(flags), handler);
 
     BOOST_ASIO_HANDLER_CREATION((p.p, "socket", &impl, "async_send_to"));
 
@@ -268,6 +272,46 @@ public:
     p.v = p.p = 0;
   }
 
+  // Send a batch of datagrams, one from each buffer, to the corresponding
+  // endpoints. Returns the number of datagrams sent.
+  size_t send_batch(implementation_type& impl,
+      const boost::asio::const_buffer* buffers,
+      const endpoint_type* destinations, std::size_t count,
+      socket_base::message_flags flags, boost::system::error_code& ec)
+  {
+    datagram_send_batch<endpoint_type> batch(buffers, destinations, count);
+
+    return socket_ops::sync_sendmmsg(impl.socket_, impl.state_,
+        batch.buffers(), batch.addrs(), batch.addrlens(),
+        batch.count(), without_zero_copy(flags), ec);
+  }
+
+  // Start an asynchronous send of a batch of datagrams. The buffers and
+  // endpoints must be valid for the lifetime of the asynchronous operation.
+  template <typename Handler>
+  void async_send_batch(implementation_type& impl,
+      const boost::asio::const_buffer* buffers,
+      const endpoint_type* destinations, std::size_t count,
+      socket_base::message_flags flags, Handler& handler)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_sendmmsg_op<endpoint_type, Handler> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      boost_asio_handler_alloc_helpers::allocate(
+        sizeof(op), handler), 0 };
+    p.p = new (p.v) op(impl.socket_, buffers,
+        destinations, count, without_zero_copy(flags), handler);
+
+    BOOST_ASIO_HANDLER_CREATION((p.p, "socket", &impl, "async_send_batch"));
+
+    start_op(impl, reactor::write_op, p.p,
+        is_continuation, true, count == 0);
+    p.v = p.p = 0;
+  }
+
   // Receive a datagram with the endpoint of the sender. Returns the number of
   // bytes received.
   template <typename MutableBufferSequence>
@@ -364,6 +408,56 @@ public:
     p.v = p.p = 0;
   }
 
+  // Receive a batch of datagrams, one into each buffer, with the endpoints of
+  // the senders. Returns the number of datagrams received.
+  size_t receive_batch(implementation_type& impl,
+      const boost::asio::mutable_buffer* buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes, std::size_t count,
+      socket_base::message_flags flags, boost::system::error_code& ec)
+  {
+    datagram_receive_batch<endpoint_type> batch(
+        buffers, sender_endpoints, count);
+
+    std::size_t messages = socket_ops::sync_recvmmsg(impl.socket_,
+        impl.state_, batch.buffers(), batch.addrs(), batch.addrlens(),
+        sizes, batch.count(), flags, ec);
+
+    if (!ec)
+      batch.resize_endpoints(messages);
+
+    return messages;
+  }
+
+  // Start an asynchronous receive of a batch of datagrams. The buffers,
+  // endpoints and sizes must be valid for the lifetime of the asynchronous
+  // operation.
+  template <typename Handler>
+  void async_receive_batch(implementation_type& impl,
+      const boost::asio::mutable_buffer* buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes, std::size_t count,
+      socket_base::message_flags flags, Handler& handler)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recvmmsg_op<endpoint_type, Handler> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      boost_asio_handler_alloc_helpers::allocate(
+        sizeof(op), handler), 0 };
+    p.p = new (p.v) op(impl.socket_, buffers,
+        sender_endpoints, sizes, count, flags, handler);
+
+    BOOST_ASIO_HANDLER_CREATION((p.p, "socket",
+          &impl, "async_receive_batch"));
+
+    start_op(impl,
+        (flags & socket_base::message_out_of_band)
+          ? reactor::except_op : reactor::read_op,
+        p.p, is_continuation, true, count == 0);
+    p.v = p.p = 0;
+  }
+
   // Accept a new connection.
   template <typename Socket>
   boost::system::error_code accept(implementation_type& impl,
@@ -377,9 +471,10 @@ public:
     }
 
     std::size_t addr_len = peer_endpoint ? peer_endpoint->capacity() : 0;
+    socket_ops::state_type new_state = socket_ops::internal_non_blocking;
     socket_holder new_socket(socket_ops::sync_accept(impl.socket_,
           impl.state_, peer_endpoint ? peer_endpoint->data() : 0,
-          peer_endpoint ? &addr_len : 0, ec));
+          peer_endpoint ? &addr_len : 0, new_state, ec));
 
     // On success, assign new connection to peer socket object.
     if (new_socket.get() != invalid_socket)
@@ -387,7 +482,10 @@ public:
       if (peer_endpoint)
         peer_endpoint->resize(addr_len);
       if (!peer.assign(impl.protocol_, new_socket.get(), ec))
+      {
         new_socket.release();
+        set_accepted_state(peer, new_state);
+      }
     }
 
     return ec;
@@ -29,6 +29,7 @@
 #include <boost/asio/detail/reactive_socket_recv_op.hpp>
 #include <boost/asio/detail/reactive_socket_recvmsg_op.hpp>
 #include <boost/asio/detail/reactive_socket_send_op.hpp>
+#include <boost/asio/detail/reactive_socket_send_zero_copy_op.hpp>
 #include <boost/asio/detail/reactor.hpp>
 #include <boost/asio/detail/reactor_op.hpp>
 #include <boost/asio/detail/socket_holder.hpp>
@@ -58,6 +59,13 @@ public:
 
     // Per-descriptor data used by the reactor.
     reactor::per_descriptor_data reactor_data_;
+
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+    // The ids of the socket's zero-copy sends. They are allocated when first
+    // needed, and are kept apart from the implementation so that they stay
+    // valid for pending operations if the socket is moved.
+    zero_copy_ids* zero_copy_ids_;
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
   };
 
   // Constructor.
@@ -70,6 +78,21 @@ public:
   // Construct a new socket implementation.
   BOOST_ASIO_DECL void construct(base_implementation_type& impl);
 
+  // Record the state of a newly accepted socket in the peer socket object. If
+  // the peer's implementation cannot hold it, put the socket back into
+  // blocking mode instead.
+  template <typename Socket>
+  static void set_accepted_state(Socket& peer, socket_ops::state_type state)
+  {
+    if ((state & socket_ops::internal_non_blocking)
+        && !add_state(&peer.get_implementation(), state))
+    {
+      boost::system::error_code ignored_ec;
+      socket_ops::set_internal_non_blocking(
+          peer.native_handle(), state, false, ignored_ec);
+    }
+  }
+
   // Move-construct a new socket implementation.
   BOOST_ASIO_DECL void base_move_construct(base_implementation_type& impl,
       base_implementation_type& other_impl);
@@ -180,7 +203,8 @@ public:
         ConstBufferSequence> bufs(buffers);
 
     return socket_ops::sync_send(impl.socket_, impl.state_,
-        bufs.buffers(), bufs.count(), flags, bufs.all_empty(), ec);
+        bufs.buffers(), bufs.count(), without_zero_copy(flags),
+        bufs.all_empty(), ec);
   }
 
   // Wait until data can be sent without blocking.
@@ -200,6 +224,24 @@ public:
       const ConstBufferSequence& buffers,
       socket_base::message_flags flags, Handler handler)
   {
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+    if ((flags & socket_base::message_zero_copy) != 0)
+    {
+      if (!buffer_sequence_adapter<boost::asio::const_buffer,
+            ConstBufferSequence>::all_empty(buffers)
+          && (impl.state_ & socket_ops::user_set_zero_copy) != 0)
+      {
+        async_send_zero_copy(impl, buffers, flags, handler);
+        return;
+      }
+
+      // An empty send leaves nothing for the kernel to release. Without the
+      // zero_copy option the kernel copies the data and never posts the
+      // notification that a zero-copy send waits for.
+      flags &= ~socket_base::message_zero_copy;
+    }
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
     bool is_continuation =
       boost_asio_handler_cont_helpers::is_continuation(handler);
 
@@ -219,6 +261,39 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+  // Start an asynchronous zero-copy send. The handler is invoked once the
+  // kernel has released the buffers.
+  template <typename ConstBufferSequence, typename Handler>
+  void async_send_zero_copy(base_implementation_type& impl,
+      const ConstBufferSequence& buffers,
+      socket_base::message_flags flags, Handler& handler)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    if (!impl.zero_copy_ids_)
+    {
+      zero_copy_ids ids = { 0, 0 };
+      impl.zero_copy_ids_ = new zero_copy_ids(ids);
+    }
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_send_zero_copy_op<ConstBufferSequence, Handler> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      boost_asio_handler_alloc_helpers::allocate(
+        sizeof(op), handler), 0 };
+    p.p = new (p.v) op(impl.socket_, impl.zero_copy_ids_,
+        buffers, flags, handler);
+
+    BOOST_ASIO_HANDLER_CREATION((p.p, "socket",
+          &impl, "async_send(zero_copy)"));
+
+    start_op(impl, reactor::write_op, p.p, is_continuation, true, false);
+    p.v = p.p = 0;
+  }
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
   // Start an asynchronous wait until data can be sent without blocking.
   template <typename Handler>
   void async_send(base_implementation_type& impl, const null_buffers&,
@@ -408,6 +483,33 @@ public:
   }
 
 protected:
+  // Add to the state of an implementation that belongs to this service.
+  static bool add_state(base_implementation_type* impl,
+      socket_ops::state_type state)
+  {
+    impl->state_ |= state;
+    return true;
+  }
+
+  // Implementations that belong to other services have no state to add to.
+  static bool add_state(void*, socket_ops::state_type)
+  {
+    return false;
+  }
+
+  // Clear the zero-copy flag for a send that does not wait for the zero-copy
+  // notifications. Only async_send waits for them, so the other sends copy
+  // the data rather than use up an id that the socket does not track.
+  static socket_base::message_flags without_zero_copy(
+      socket_base::message_flags flags)
+  {
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+    return flags & ~socket_base::message_zero_copy;
+#else // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+    return flags;
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+  }
+
   // Open a new socket implementation.
   BOOST_ASIO_DECL boost::system::error_code do_open(
       base_implementation_type& impl, int af,
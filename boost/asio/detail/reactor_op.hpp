@@ -34,6 +34,14 @@ public:
   // The number of bytes transferred, to be passed to the completion handler.
   std::size_t bytes_transferred_;
 
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+  // Set by an operation that returns false from perform() because it is now
+  // waiting for a notification on the socket's error queue. The reactor moves
+  // the operation to the exception queue, so that it does not hold up the
+  // operations queued behind it.
+  bool wait_for_error_queue_;
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
   // Perform the operation. Returns true if it is finished.
   bool perform()
   {
@@ -46,6 +54,9 @@ protected:
   reactor_op(perform_func_type perform_func, func_type complete_func)
     : operation(complete_func),
       bytes_transferred_(0),
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+      wait_for_error_queue_(false),
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
       perform_func_(perform_func)
   {
   }
@@ -54,7 +54,10 @@ enum
   datagram_oriented = 32,
 
   // The socket may have been dup()-ed.
-  possible_dup = 64
+  possible_dup = 64,
+
+  // The user enabled the zero_copy option.
+  user_set_zero_copy = 128
 };
 
 typedef unsigned char state_type;
@@ -66,9 +69,15 @@ typedef weak_ptr<void> weak_cancel_token_type;
 BOOST_ASIO_DECL socket_type accept(socket_type s, socket_addr_type* addr,
     std::size_t* addrlen, boost::system::error_code& ec);
 
+// Accept a connection, creating the new socket in non-blocking mode if
+// new_state includes internal_non_blocking and the platform allows it. On
+// return, new_state holds the state of the new socket.
+BOOST_ASIO_DECL socket_type accept(socket_type s, socket_addr_type* addr,
+    std::size_t* addrlen, state_type& new_state, boost::system::error_code& ec);
+
 BOOST_ASIO_DECL socket_type sync_accept(socket_type s,
-    state_type state, socket_addr_type* addr,
-    std::size_t* addrlen, boost::system::error_code& ec);
+    state_type state, socket_addr_type* addr, std::size_t* addrlen,
+    state_type& new_state, boost::system::error_code& ec);
 
 #if defined(BOOST_ASIO_HAS_IOCP)
 
@@ -81,7 +90,8 @@ BOOST_ASIO_DECL void complete_iocp_accept(socket_type s,
 
 BOOST_ASIO_DECL bool non_blocking_accept(socket_type s,
     state_type state, socket_addr_type* addr, std::size_t* addrlen,
-    boost::system::error_code& ec, socket_type& new_socket);
+    boost::system::error_code& ec, socket_type& new_socket,
+    state_type& new_state);
 
 #endif // defined(BOOST_ASIO_HAS_IOCP)
 
@@ -214,6 +224,17 @@ BOOST_ASIO_DECL bool non_blocking_send(socket_type s,
     const buf* bufs, size_t count, int flags,
     boost::system::error_code& ec, size_t& bytes_transferred);
 
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+// Read zero-copy completion notifications from the socket's error queue.
+// Returns true when the send with the given id has been released by the
+// kernel or an error occurs. The id before which all sends have been released
+// is advanced as the notifications are read.
+BOOST_ASIO_DECL bool non_blocking_zero_copy_wait(socket_type s,
+    uint32_t id, uint32_t& released, boost::system::error_code& ec);
+
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
 #endif // defined(BOOST_ASIO_HAS_IOCP)
 
 BOOST_ASIO_DECL signed_size_type sendto(socket_type s, const buf* bufs,
@@ -231,6 +252,39 @@ BOOST_ASIO_DECL bool non_blocking_sendto(socket_type s,
     const socket_addr_type* addr, std::size_t addrlen,
     boost::system::error_code& ec, size_t& bytes_transferred);
 
+// Receive up to count datagrams, one into each buffer. On return, sizes holds
+// the length of each datagram and addrlens the length of each sender address.
+// Returns the number of datagrams received.
+BOOST_ASIO_DECL signed_size_type recvmmsg(socket_type s, buf* bufs,
+    socket_addr_type** addrs, std::size_t* addrlens, std::size_t* sizes,
+    size_t count, int flags, boost::system::error_code& ec);
+
+BOOST_ASIO_DECL size_t sync_recvmmsg(socket_type s, state_type state,
+    buf* bufs, socket_addr_type** addrs, std::size_t* addrlens,
+    std::size_t* sizes, size_t count, int flags,
+    boost::system::error_code& ec);
+
+BOOST_ASIO_DECL bool non_blocking_recvmmsg(socket_type s,
+    buf* bufs, socket_addr_type** addrs, std::size_t* addrlens,
+    std::size_t* sizes, size_t count, int flags,
+    boost::system::error_code& ec, size_t& messages_transferred);
+
+// Send up to count datagrams, one from each buffer. Returns the number of
+// datagrams sent.
+BOOST_ASIO_DECL signed_size_type sendmmsg(socket_type s, const buf* bufs,
+    const socket_addr_type** addrs, const std::size_t* addrlens,
+    size_t count, int flags, boost::system::error_code& ec);
+
+BOOST_ASIO_DECL size_t sync_sendmmsg(socket_type s, state_type state,
+    const buf* bufs, const socket_addr_type** addrs,
+    const std::size_t* addrlens, size_t count, int flags,
+    boost::system::error_code& ec);
+
+BOOST_ASIO_DECL bool non_blocking_sendmmsg(socket_type s,
+    const buf* bufs, const socket_addr_type** addrs,
+    const std::size_t* addrlens, size_t count, int flags,
+    boost::system::error_code& ec, size_t& messages_transferred);
+
 #endif // !defined(BOOST_ASIO_HAS_IOCP)
 
 BOOST_ASIO_DECL socket_type socket(int af, int type, int protocol,
@@ -73,6 +73,12 @@
 #  include <sys/filio.h>
 #  include <sys/sockio.h>
 # endif
+# if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+#  include <linux/errqueue.h>
+# endif
+# if defined(BOOST_ASIO_HAS_UDP_SEGMENT)
+#  include <netinet/udp.h>
+# endif
 #endif
 
 #include <boost/asio/detail/push_options.hpp>
@@ -164,6 +170,32 @@ const int message_peek = MSG_PEEK;
 const int message_out_of_band = MSG_OOB;
 const int message_do_not_route = MSG_DONTROUTE;
 const int message_end_of_record = MSG_EOR;
+# if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+#  if defined(MSG_ZEROCOPY)
+const int message_zero_copy = MSG_ZEROCOPY;
+#  else
+const int message_zero_copy = 0x4000000;
+#  endif
+#  if defined(SO_ZEROCOPY)
+const int zero_copy_option = SO_ZEROCOPY;
+#  else
+const int zero_copy_option = 60;
+#  endif
+# endif
+# if defined(BOOST_ASIO_HAS_UDP_SEGMENT)
+#  if defined(UDP_SEGMENT)
+const int udp_segment_option = UDP_SEGMENT;
+#  else
+const int udp_segment_option = 103;
+#  endif
+# endif
+# if defined(BOOST_ASIO_HAS_SO_REUSEPORT)
+#  if defined(SO_REUSEPORT)
+const int reuse_port_option = SO_REUSEPORT;
+#  else
+const int reuse_port_option = 15;
+#  endif
+# endif
 # if defined(IOV_MAX)
 const int max_iov_len = IOV_MAX;
 # else
@@ -171,6 +203,8 @@ const int max_iov_len = IOV_MAX;
 const int max_iov_len = 16;
 # endif
 #endif
+// The maximum number of datagrams transferred by one batch operation.
+const int max_batch_len = 64;
 const int custom_socket_option_level = 0xA5100000;
 const int enable_connection_aborted_option = 1;
 const int always_fail_option = 2;
@@ -16,12 +16,18 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/asio/detail/config.hpp>
+#include <cstddef>
 #include <boost/asio/io_service.hpp>
+#include <boost/asio/detail/atomic_count.hpp>
 #include <boost/asio/detail/mutex.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/operation.hpp>
 #include <boost/asio/detail/scoped_ptr.hpp>
 
+#if defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+# include <atomic>
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+
 #include <boost/asio/detail/push_options.hpp>
 
 namespace boost {
@@ -39,6 +45,27 @@ private:
   // Helper class to re-post the strand on exit.
   struct on_dispatch_exit;
 
+#if defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+  // Helper class to re-post an unshared strand on exit.
+  struct on_unshared_complete_exit;
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+
+  // Operation used to destroy an unshared implementation once the handlers
+  // queued before it have run.
+  class destroy_op
+    : public operation
+  {
+  public:
+    explicit destroy_op(operation* impl)
+      : operation(&strand_service::do_destroy),
+        impl_(impl)
+    {
+    }
+
+    // The strand implementation to be destroyed.
+    operation* impl_;
+  };
+
 public:
 
   // The underlying implementation of a strand.
@@ -53,6 +80,9 @@ public:
     friend class strand_service;
     friend struct on_do_complete_exit;
     friend struct on_dispatch_exit;
+#if defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+    friend struct on_unshared_complete_exit;
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
 
     // Mutex to protect access to internal data.
     boost::asio::detail::mutex mutex_;
@@ -71,6 +101,36 @@ public:
     // handlers that hold the strand's lock. The ready queue is only modified
     // from within the strand and so may be accessed without locking the mutex.
     op_queue<operation> ready_queue_;
+
+    // The service that owns the implementation if it belongs to a single
+    // strand and its copies, or 0 if it is shared through the pool.
+    strand_service* service_;
+
+    // The number of strand objects using an unshared implementation.
+    atomic_count ref_count_;
+
+    // The operation queued when the last strand object using an unshared
+    // implementation is destroyed.
+    destroy_op destroy_op_;
+
+    // Set when the destroy operation has run and the implementation must be
+    // freed once the current handlers have finished.
+    bool destroyed_;
+
+    // Pointers to adjacent unshared implementations owned by the service.
+    strand_impl* next_impl_;
+    strand_impl* prev_impl_;
+
+#if defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+    // Handlers added to an unshared strand, most recent first. Producers push
+    // without locking and the strand takes the whole list at once.
+    std::atomic<operation*> incoming_;
+
+    // The number of handlers queued on an unshared strand, plus one while a
+    // handler is being dispatched directly. The strand is "locked" while the
+    // count is non-zero.
+    std::atomic<std::size_t> pending_;
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
   };
 
   typedef strand_impl* implementation_type;
@@ -78,12 +138,28 @@ public:
   // Construct a new strand service for the specified io_service.
   BOOST_ASIO_DECL explicit strand_service(boost::asio::io_service& io_service);
 
+  // Destructor.
+  BOOST_ASIO_DECL ~strand_service();
+
   // Destroy all user-defined handler objects owned by the service.
   BOOST_ASIO_DECL void shutdown_service();
 
+  // Set the number of implementations shared between strand objects that are
+  // constructed from now on. The value is limited to the size of the pool. A
+  // value of 0 gives each new strand an implementation of its own.
+  BOOST_ASIO_DECL void set_pool_size(std::size_t n);
+
   // Construct a new strand implementation.
   BOOST_ASIO_DECL void construct(implementation_type& impl);
 
+  // Construct a strand implementation that refers to the same strand as
+  // another.
+  BOOST_ASIO_DECL void copy_construct(implementation_type& impl,
+      const implementation_type& other_impl);
+
+  // Destroy a strand implementation.
+  BOOST_ASIO_DECL void destroy(implementation_type& impl);
+
   // Request the io_service to invoke the given handler.
   template <typename Handler>
   void dispatch(implementation_type& impl, Handler& handler);
@@ -109,6 +185,26 @@ private:
       operation* base, const boost::system::error_code& ec,
       std::size_t bytes_transferred);
 
+  BOOST_ASIO_DECL static void do_destroy(io_service_impl* owner,
+      operation* base, const boost::system::error_code& ec,
+      std::size_t bytes_transferred);
+
+  // Free an unshared implementation that is no longer in use.
+  BOOST_ASIO_DECL void free_impl(strand_impl* impl);
+
+#if defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+  // Add a handler to an unshared strand. Returns true if the caller acquired
+  // the strand and is responsible for scheduling it.
+  BOOST_ASIO_DECL static bool push_unshared(strand_impl* impl, operation* op);
+
+  // Move all handlers added to an unshared strand into its ready queue.
+  BOOST_ASIO_DECL static void take_unshared(strand_impl* impl);
+
+  // Run the ready handlers of an unshared strand.
+  BOOST_ASIO_DECL static void do_complete_unshared(io_service_impl* owner,
+      strand_impl* impl, const boost::system::error_code& ec);
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_STRANDS)
+
   // The io_service implementation used to post completions.
   io_service_impl& io_service_;
 
@@ -125,6 +221,15 @@ private:
   // Pool of implementations.
   scoped_ptr<strand_impl> implementations_[num_implementations];
 
+  // The number of pool entries used for new strands.
+  std::size_t pool_size_;
+
+  // The unshared implementations.
+  strand_impl* unshared_impls_;
+
+  // Whether the service has been shut down.
+  bool shutdown_;
+
   // Extra value used when hashing to prevent recycled memory locations from
   // getting the same strand implementation.
   std::size_t salt_;
@@ -29,6 +29,12 @@
 #include <boost/asio/detail/task_io_service_fwd.hpp>
 #include <boost/asio/detail/task_io_service_operation.hpp>
 
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+# include <vector>
+# include <boost/atomic.hpp>
+# include <boost/asio/detail/lockfree_op_queue.hpp>
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+
 #include <boost/asio/detail/push_options.hpp>
 
 namespace boost {
@@ -46,6 +52,11 @@ public:
   BOOST_ASIO_DECL task_io_service(boost::asio::io_service& io_service,
       std::size_t concurrency_hint = 0);
 
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+  // Destructor.
+  BOOST_ASIO_DECL ~task_io_service();
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+
   // Destroy all user-defined handler objects owned by the service.
   BOOST_ASIO_DECL void shutdown_service();
 
@@ -146,6 +157,36 @@ private:
   BOOST_ASIO_DECL void wake_one_thread_and_unlock(
       mutex::scoped_lock& lock);
 
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+  // Give the calling thread a per-thread queue, if one is free.
+  BOOST_ASIO_DECL void claim_local_queue(thread_info& this_thread);
+
+  // Move any operations left on the calling thread's queue to the main queue
+  // and make the per-thread queue available to other threads.
+  BOOST_ASIO_DECL void release_local_queue(mutex::scoped_lock& lock,
+      thread_info& this_thread);
+
+  // Add an operation to the calling thread's queue without locking. Returns
+  // false if the thread has no queue or the queue is full.
+  BOOST_ASIO_DECL bool push_local(operation* op);
+
+  // Take an operation from the calling thread's queue, or steal one from
+  // another thread's queue.
+  BOOST_ASIO_DECL operation* pop_local(thread_info& this_thread);
+
+  // Determine whether all per-thread queues are empty.
+  BOOST_ASIO_DECL bool local_queues_empty();
+
+  // Run operations from the calling thread's queue without locking, until the
+  // queue is empty or the batch limit is reached.
+  BOOST_ASIO_DECL std::size_t do_run_local(mutex::scoped_lock& lock,
+      thread_info& this_thread, const boost::system::error_code& ec);
+
+  // Helper class to release the per-thread queue on block exit.
+  struct local_queue_cleanup;
+  friend struct local_queue_cleanup;
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+
   // Helper class to perform task-related operations on block exit.
   struct task_cleanup;
   friend struct task_cleanup;
@@ -189,6 +230,46 @@ private:
 
   // The threads that are currently idle.
   thread_info* first_idle_thread_;
+
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+  // The maximum number of per-thread queues.
+#if defined(BOOST_ASIO_LOCKFREE_QUEUE_COUNT)
+  enum { max_local_queues = BOOST_ASIO_LOCKFREE_QUEUE_COUNT };
+#else // defined(BOOST_ASIO_LOCKFREE_QUEUE_COUNT)
+  enum { max_local_queues = 8 };
+#endif // defined(BOOST_ASIO_LOCKFREE_QUEUE_COUNT)
+
+  // The number of operations each per-thread queue can hold. Operations that
+  // do not fit are added to the main queue.
+#if defined(BOOST_ASIO_LOCKFREE_QUEUE_CAPACITY)
+  enum { local_queue_capacity = BOOST_ASIO_LOCKFREE_QUEUE_CAPACITY };
+#else // defined(BOOST_ASIO_LOCKFREE_QUEUE_CAPACITY)
+  enum { local_queue_capacity = 1024 };
+#endif // defined(BOOST_ASIO_LOCKFREE_QUEUE_CAPACITY)
+
+  // The maximum number of operations a thread runs from its own queue before
+  // returning to the main queue, so that the task and other queued handlers
+  // are not starved.
+  enum { local_batch_size = 64 };
+
+  // The per-thread queues. The set of queues is fixed at construction so that
+  // it may be read without locking.
+  std::vector<lockfree_op_queue<operation>*> local_queues_;
+
+  // The number of threads in the idle list, readable without locking.
+  atomic_count idle_thread_count_;
+
+  // A copy of the stopped_ flag that is readable without locking.
+  boost::atomic<bool> stopped_hint_;
+
+  // Whether a thread may be blocked in the task, readable without locking.
+  boost::atomic<bool> task_blocked_hint_;
+
+  // Whether the task was passed over for a handler on a per-thread queue the
+  // last time it reached the front of the queue. The task and the per-thread
+  // queues take turns, so that neither starves the other.
+  bool task_deferred_;
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
 };
 
 } // namespace detail
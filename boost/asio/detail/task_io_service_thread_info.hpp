@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/asio/detail/event.hpp>
+#include <boost/asio/detail/lockfree_op_queue.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/task_io_service_fwd.hpp>
 #include <boost/asio/detail/thread_info_base.hpp>
@@ -31,6 +32,9 @@ struct task_io_service_thread_info : public thread_info_base
   event* wakeup_event;
   op_queue<task_io_service_operation> private_op_queue;
   long private_outstanding_work;
+#if defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
+  lockfree_op_queue<task_io_service_operation>* local_op_queue;
+#endif // defined(BOOST_ASIO_HAS_LOCKFREE_QUEUES)
   task_io_service_thread_info* next;
 };
 
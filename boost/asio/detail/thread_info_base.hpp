@@ -15,9 +15,10 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
-#include <climits>
+#include <boost/asio/detail/config.hpp>
 #include <cstddef>
 #include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/static_mutex.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
 
@@ -25,54 +26,88 @@ namespace boost {
 namespace asio {
 namespace detail {
 
+// Per-thread cache of memory blocks for handler allocation. Requested sizes
+// are rounded up to a multiple of chunk_size, and each resulting size class
+// keeps a short list of blocks released by the thread, so that successive
+// operations on the same thread reuse memory rather than calling new. Since
+// deallocation is given the same size as allocation, a block can be returned
+// to the cache of any thread.
 class thread_info_base
   : private noncopyable
 {
 public:
+  // Counts of allocations made through the cache.
+  struct stats
+  {
+    std::size_t hits;
+    std::size_t misses;
+  };
+
   thread_info_base()
-    : reusable_memory_(0)
   {
+    for (std::size_t i = 0; i < num_size_classes; ++i)
+    {
+      free_list_[i] = 0;
+      free_count_[i] = 0;
+    }
+    stats_.hits = 0;
+    stats_.misses = 0;
   }
 
   ~thread_info_base()
   {
-    if (reusable_memory_)
-      ::operator delete(reusable_memory_);
+    for (std::size_t i = 0; i < num_size_classes; ++i)
+    {
+      while (free_list_[i])
+      {
+        block* b = free_list_[i];
+        free_list_[i] = b->next_;
+        ::operator delete(b);
+      }
+    }
+
+    add_to_totals(stats_);
   }
 
   static void* allocate(thread_info_base* this_thread, std::size_t size)
   {
-    if (this_thread && this_thread->reusable_memory_)
+    if (size <= max_size)
     {
-      void* const pointer = this_thread->reusable_memory_;
-      this_thread->reusable_memory_ = 0;
-
-      unsigned char* const mem = static_cast<unsigned char*>(pointer);
-      if (static_cast<std::size_t>(mem[0]) >= size)
+      std::size_t size_class = size_class_of(size);
+      if (this_thread)
       {
-        mem[size] = mem[0];
-        return pointer;
+        if (block* b = this_thread->free_list_[size_class])
+        {
+          this_thread->free_list_[size_class] = b->next_;
+          --this_thread->free_count_[size_class];
+          ++this_thread->stats_.hits;
+          return b;
+        }
+        ++this_thread->stats_.misses;
       }
 
-      ::operator delete(pointer);
+      // Blocks are always the full size of their class, even when allocated
+      // outside run(), as they may be freed into a thread's cache.
+      return ::operator new((size_class + 1) * chunk_size);
     }
 
-    void* const pointer = ::operator new(size + 1);
-    unsigned char* const mem = static_cast<unsigned char*>(pointer);
-    mem[size] = (size <= UCHAR_MAX) ? static_cast<unsigned char>(size) : 0;
-    return pointer;
+    if (this_thread)
+      ++this_thread->stats_.misses;
+    return ::operator new(size);
   }
 
   static void deallocate(thread_info_base* this_thread,
       void* pointer, std::size_t size)
   {
-    if (size <= UCHAR_MAX)
+    if (this_thread && size <= max_size)
     {
-      if (this_thread && this_thread->reusable_memory_ == 0)
+      std::size_t size_class = size_class_of(size);
+      if (this_thread->free_count_[size_class] < cache_depth)
       {
-        unsigned char* const mem = static_cast<unsigned char*>(pointer);
-        mem[0] = mem[size];
-        this_thread->reusable_memory_ = pointer;
+        block* b = static_cast<block*>(pointer);
+        b->next_ = this_thread->free_list_[size_class];
+        this_thread->free_list_[size_class] = b;
+        ++this_thread->free_count_[size_class];
         return;
       }
     }
@@ -80,8 +115,78 @@ public:
     ::operator delete(pointer);
   }
 
+  // Get the counts for the calling thread.
+  const stats& thread_stats() const
+  {
+    return stats_;
+  }
+
+  // Get the counts accumulated by all thread_info objects destroyed so far.
+  static stats total_stats()
+  {
+    totals_state* state = get_totals();
+    state->mutex_.init();
+    static_mutex::scoped_lock lock(state->mutex_);
+    return state->stats_;
+  }
+
 private:
-  void* reusable_memory_;
+  struct block
+  {
+    block* next_;
+  };
+
+  // The granularity of the size classes.
+  enum { chunk_size = sizeof(block) > 16 ? sizeof(block) : 16 };
+
+  // Allocations larger than this go directly to new.
+#if defined(BOOST_ASIO_RECYCLING_ALLOCATOR_MAX_SIZE)
+  enum { max_size = BOOST_ASIO_RECYCLING_ALLOCATOR_MAX_SIZE };
+#else // defined(BOOST_ASIO_RECYCLING_ALLOCATOR_MAX_SIZE)
+  enum { max_size = 512 };
+#endif // defined(BOOST_ASIO_RECYCLING_ALLOCATOR_MAX_SIZE)
+
+  // The number of blocks of each size class kept by a thread.
+#if defined(BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_DEPTH)
+  enum { cache_depth = BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_DEPTH };
+#else // defined(BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_DEPTH)
+  enum { cache_depth = 4 };
+#endif // defined(BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_DEPTH)
+
+  enum { num_size_classes = (max_size + chunk_size - 1) / chunk_size };
+
+  static std::size_t size_class_of(std::size_t size)
+  {
+    return size == 0 ? 0 : (size - 1) / chunk_size;
+  }
+
+  struct totals_state
+  {
+    static_mutex mutex_;
+    stats stats_;
+  };
+
+  static totals_state* get_totals()
+  {
+    static totals_state state = { BOOST_ASIO_STATIC_MUTEX_INIT, { 0, 0 } };
+    return &state;
+  }
+
+  static void add_to_totals(const stats& s)
+  {
+    if (s.hits == 0 && s.misses == 0)
+      return;
+
+    totals_state* state = get_totals();
+    state->mutex_.init();
+    static_mutex::scoped_lock lock(state->mutex_);
+    state->stats_.hits += s.hits;
+    state->stats_.misses += s.misses;
+  }
+
+  block* free_list_[num_size_classes];
+  std::size_t free_count_[num_size_classes];
+  stats stats_;
 };
 
 } // namespace detail
@@ -0,0 +1,553 @@
+//
+// detail/timer_queue_wheel.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_TIMER_QUEUE_WHEEL_HPP
+#define BOOST_ASIO_DETAIL_TIMER_QUEUE_WHEEL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <vector>
+#include <boost/asio/detail/cstdint.hpp>
+#include <boost/asio/detail/date_time_fwd.hpp>
+#include <boost/asio/detail/limits.hpp>
+#include <boost/asio/detail/op_queue.hpp>
+#include <boost/asio/detail/timer_queue.hpp>
+#include <boost/asio/detail/timer_queue_base.hpp>
+#include <boost/asio/detail/wait_op.hpp>
+#include <boost/asio/error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Time traits that select the timing wheel implementation of timer_queue.
+template <typename Time_Traits>
+struct timer_wheel_traits : Time_Traits {};
+
+// Timer queue implemented as a hierarchical timing wheel. Arming and
+// cancelling a timer is O(1). Timers are kept in coarse slots until the tick
+// containing their expiry time is reached, at which point they are moved to a
+// heap so that they still fire in order and no earlier than requested.
+template <typename Time_Traits>
+class timer_queue<timer_wheel_traits<Time_Traits> >
+  : public timer_queue_base
+{
+public:
+  // The time type.
+  typedef typename Time_Traits::time_type time_type;
+
+  // The duration type.
+  typedef typename Time_Traits::duration_type duration_type;
+
+  // Per-timer data.
+  class per_timer_data
+  {
+  public:
+    per_timer_data() : location_(unscheduled), next_(0), prev_(0) {}
+
+  private:
+    friend class timer_queue;
+
+    // The operations waiting on the timer.
+    op_queue<wait_op> op_queue_;
+
+    // The time when the timer should fire.
+    time_type time_;
+
+    // The tick containing the time when the timer should fire.
+    uint64_t tick_;
+
+    // Where the timer is currently stored.
+    enum { unscheduled, in_wheel, in_heap, never_expires } location_;
+
+    // The index of the timer in the heap, if stored there.
+    std::size_t heap_index_;
+
+    // The head of the list containing the timer, if stored in a list, and
+    // pointers to adjacent timers in that list.
+    per_timer_data** list_;
+    per_timer_data* next_;
+    per_timer_data* prev_;
+  };
+
+  // Constructor.
+  timer_queue()
+    : origin_(Time_Traits::now()),
+      current_tick_(0),
+      next_tick_(no_tick()),
+      num_timers_(0),
+      never_expires_(0),
+      heap_()
+  {
+    for (int level = 0; level < num_levels; ++level)
+      for (int slot = 0; slot < num_slots; ++slot)
+        wheel_[level][slot] = 0;
+  }
+
+  // Add a new timer to the queue. Returns true if this is the timer that is
+  // earliest in the queue, in which case the reactor's event demultiplexing
+  // function call may need to be interrupted and restarted.
+  bool enqueue_timer(const time_type& time, per_timer_data& timer, wait_op* op)
+  {
+    bool earliest = false;
+
+    // Enqueue the timer object.
+    if (timer.location_ == per_timer_data::unscheduled)
+    {
+      timer.time_ = time;
+      if (this->is_positive_infinity(time))
+      {
+        // No wheel or heap entry is required for timers that never expire.
+        timer.location_ = per_timer_data::never_expires;
+        link(never_expires_, timer);
+      }
+      else
+      {
+        // Bring the wheel up to date so that the timer is placed relative to
+        // the current time.
+        advance(to_tick(Time_Traits::now()));
+        timer.tick_ = to_tick(time);
+        earliest = schedule(timer);
+      }
+      ++num_timers_;
+    }
+
+    // Enqueue the individual timer operation.
+    timer.op_queue_.push(op);
+
+    // Interrupt reactor only if newly added timer is first to expire.
+    return earliest && timer.op_queue_.front() == op;
+  }
+
+  // Whether there are no timers in the queue.
+  virtual bool empty() const
+  {
+    return num_timers_ == 0;
+  }
+
+  // Get the time for the timer that is earliest in the queue.
+  virtual long wait_duration_msec(long max_duration) const
+  {
+    int64_t usec = wait_duration(max_duration * 1000LL);
+    return static_cast<long>((usec + 999) / 1000);
+  }
+
+  // Get the time for the timer that is earliest in the queue.
+  virtual long wait_duration_usec(long max_duration) const
+  {
+    return static_cast<long>(wait_duration(max_duration));
+  }
+
+  // Dequeue all timers not later than the current time.
+  virtual void get_ready_timers(op_queue<operation>& ops)
+  {
+    if (num_timers_ != 0)
+    {
+      const time_type now = Time_Traits::now();
+      advance(to_tick(now));
+      while (!heap_.empty() && !Time_Traits::less_than(now, heap_[0].time_))
+      {
+        per_timer_data* timer = heap_[0].timer_;
+        ops.push(timer->op_queue_);
+        remove_timer(*timer);
+      }
+    }
+  }
+
+  // Dequeue all timers.
+  virtual void get_all_timers(op_queue<operation>& ops)
+  {
+    for (int level = 0; level < num_levels; ++level)
+      for (int slot = 0; slot < num_slots; ++slot)
+        release_list(wheel_[level][slot], ops);
+    release_list(never_expires_, ops);
+
+    for (std::size_t i = 0; i < heap_.size(); ++i)
+    {
+      per_timer_data* timer = heap_[i].timer_;
+      ops.push(timer->op_queue_);
+      timer->location_ = per_timer_data::unscheduled;
+    }
+
+    heap_.clear();
+    next_tick_ = no_tick();
+    num_timers_ = 0;
+  }
+
+  // Cancel and dequeue operations for the given timer.
+  std::size_t cancel_timer(per_timer_data& timer, op_queue<operation>& ops,
+      std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)())
+  {
+    std::size_t num_cancelled = 0;
+    if (timer.location_ != per_timer_data::unscheduled)
+    {
+      while (wait_op* op = (num_cancelled != max_cancelled)
+          ? timer.op_queue_.front() : 0)
+      {
+        op->ec_ = boost::asio::error::operation_aborted;
+        timer.op_queue_.pop();
+        ops.push(op);
+        ++num_cancelled;
+      }
+      if (timer.op_queue_.empty())
+        remove_timer(timer);
+    }
+    return num_cancelled;
+  }
+
+private:
+  // The width of each tick, in microseconds.
+#if defined(BOOST_ASIO_TIMER_WHEEL_RESOLUTION)
+  enum { resolution = BOOST_ASIO_TIMER_WHEEL_RESOLUTION };
+#else // defined(BOOST_ASIO_TIMER_WHEEL_RESOLUTION)
+  enum { resolution = 1000 };
+#endif // defined(BOOST_ASIO_TIMER_WHEEL_RESOLUTION)
+
+  // The shape of the wheel. Each level covers num_slots times the range of the
+  // level below it, so the wheel spans 2^32 ticks. Timers further in the
+  // future are parked in the last slot that can hold them and placed again
+  // when that slot is reached.
+  enum { slot_bits = 8, num_slots = 1 << slot_bits, num_levels = 4 };
+
+  // Marker for the absence of a tick.
+  static uint64_t no_tick()
+  {
+    return ~static_cast<uint64_t>(0);
+  }
+
+  // Convert an absolute time into a tick.
+  uint64_t to_tick(const time_type& time) const
+  {
+    int64_t usec = elapsed_usec(time);
+    return usec <= 0 ? 0 : static_cast<uint64_t>(usec) / resolution;
+  }
+
+  // Get the number of microseconds from the origin to the given time.
+  int64_t elapsed_usec(const time_type& time) const
+  {
+    return to_usec(Time_Traits::to_posix_duration(
+          Time_Traits::subtract(time, origin_)));
+  }
+
+  // Convert a duration to microseconds, treating negative values as zero.
+  template <typename Duration>
+  static int64_t to_usec(const Duration& d)
+  {
+    return d.ticks() <= 0 ? 0 : static_cast<int64_t>(d.total_microseconds());
+  }
+
+  // Get the number of microseconds until the earliest timer, bounded by the
+  // given maximum.
+  int64_t wait_duration(int64_t max_duration) const
+  {
+    int64_t usec = max_duration;
+    if (num_timers_ == 0)
+      return max_duration;
+    if (!heap_.empty())
+    {
+      usec = to_usec(Time_Traits::to_posix_duration(
+            Time_Traits::subtract(heap_[0].time_, Time_Traits::now())));
+    }
+    else if (next_tick_ != no_tick())
+    {
+      // Wake at the start of the next tick that has timers to process.
+      usec = static_cast<int64_t>(next_tick_) * resolution
+        - elapsed_usec(Time_Traits::now());
+      if (usec < 0)
+        usec = 0;
+    }
+    return usec < max_duration ? usec : max_duration;
+  }
+
+  // Put a timer in the heap if its tick has been reached, or in the wheel
+  // otherwise. Returns true if the timer is now the earliest in the queue.
+  bool schedule(per_timer_data& timer)
+  {
+    if (timer.tick_ <= current_tick_)
+    {
+      // Put the new timer at the correct position in the heap. This is done
+      // first since push_back() can throw due to allocation failure.
+      timer.heap_index_ = heap_.size();
+      heap_entry entry = { timer.time_, &timer };
+      heap_.push_back(entry);
+      timer.location_ = per_timer_data::in_heap;
+      up_heap(heap_.size() - 1);
+      return timer.heap_index_ == 0;
+    }
+
+    // Choose the lowest level whose range covers the timer.
+    uint64_t delta = timer.tick_ - current_tick_;
+    uint64_t tick = timer.tick_;
+    int level = 0;
+    while (level < num_levels - 1
+        && (delta >> (slot_bits * (level + 1))) != 0)
+      ++level;
+    if ((delta >> (slot_bits * (level + 1))) != 0)
+      tick = current_tick_ + (uint64_t(1) << (slot_bits * num_levels)) - 1;
+
+    // The slot is processed at the start of the block of ticks it covers.
+    int shift = slot_bits * level;
+    timer.location_ = per_timer_data::in_wheel;
+    link(wheel_[level][(tick >> shift) & (num_slots - 1)], timer);
+
+    uint64_t slot_tick = (tick >> shift) << shift;
+    if (slot_tick < next_tick_)
+    {
+      next_tick_ = slot_tick;
+      return heap_.empty();
+    }
+    return false;
+  }
+
+  // Process all ticks up to and including the given tick.
+  void advance(uint64_t tick)
+  {
+    while (current_tick_ < tick)
+    {
+      // Skip over ticks that have nothing to process.
+      if (next_tick_ > tick)
+      {
+        current_tick_ = tick;
+        return;
+      }
+      current_tick_ = next_tick_;
+
+      // Redistribute the timers from higher levels whose block starts now.
+      for (int level = num_levels - 1; level > 0; --level)
+      {
+        int shift = slot_bits * level;
+        if ((current_tick_ & ((uint64_t(1) << shift) - 1)) == 0)
+        {
+          per_timer_data* timers = wheel_[level][
+            (current_tick_ >> shift) & (num_slots - 1)];
+          wheel_[level][(current_tick_ >> shift) & (num_slots - 1)] = 0;
+          reschedule(timers);
+        }
+      }
+
+      // Move the timers for the current tick into the heap.
+      per_timer_data* timers = wheel_[0][current_tick_ & (num_slots - 1)];
+      wheel_[0][current_tick_ & (num_slots - 1)] = 0;
+      reschedule(timers);
+
+      next_tick_ = find_next_tick();
+    }
+  }
+
+  // Schedule every timer in a list that has been detached from its slot.
+  void reschedule(per_timer_data* timers)
+  {
+    while (timers)
+    {
+      per_timer_data* timer = timers;
+      timers = timers->next_;
+      timer->next_ = 0;
+      timer->prev_ = 0;
+      timer->list_ = 0;
+      schedule(*timer);
+    }
+  }
+
+  // Find the first tick after the current one at which a slot must be
+  // processed.
+  uint64_t find_next_tick() const
+  {
+    uint64_t next = no_tick();
+    for (int level = 0; level < num_levels; ++level)
+    {
+      int shift = slot_bits * level;
+      uint64_t base = current_tick_ >> shift;
+      for (uint64_t i = 1; i <= num_slots; ++i)
+      {
+        if (wheel_[level][(base + i) & (num_slots - 1)])
+        {
+          uint64_t tick = (base + i) << shift;
+          if (tick < next)
+            next = tick;
+          break;
+        }
+      }
+    }
+    return next;
+  }
+
+  // Add a timer to the front of a list.
+  static void link(per_timer_data*& list, per_timer_data& timer)
+  {
+    timer.list_ = &list;
+    timer.next_ = list;
+    timer.prev_ = 0;
+    if (list)
+      list->prev_ = &timer;
+    list = &timer;
+  }
+
+  // Remove a timer from the list containing it.
+  static void unlink(per_timer_data& timer)
+  {
+    if (*timer.list_ == &timer)
+      *timer.list_ = timer.next_;
+    if (timer.prev_)
+      timer.prev_->next_ = timer.next_;
+    if (timer.next_)
+      timer.next_->prev_ = timer.prev_;
+    timer.list_ = 0;
+    timer.next_ = 0;
+    timer.prev_ = 0;
+  }
+
+  // Dequeue the operations of all timers in a list and empty the list.
+  static void release_list(per_timer_data*& list, op_queue<operation>& ops)
+  {
+    while (list)
+    {
+      per_timer_data* timer = list;
+      list = list->next_;
+      ops.push(timer->op_queue_);
+      timer->location_ = per_timer_data::unscheduled;
+      timer->list_ = 0;
+      timer->next_ = 0;
+      timer->prev_ = 0;
+    }
+  }
+
+  // Move the item at the given index up the heap to its correct position.
+  void up_heap(std::size_t index)
+  {
+    std::size_t parent = (index - 1) / 2;
+    while (index > 0
+        && Time_Traits::less_than(heap_[index].time_, heap_[parent].time_))
+    {
+      swap_heap(index, parent);
+      index = parent;
+      parent = (index - 1) / 2;
+    }
+  }
+
+  // Move the item at the given index down the heap to its correct position.
+  void down_heap(std::size_t index)
+  {
+    std::size_t child = index * 2 + 1;
+    while (child < heap_.size())
+    {
+      std::size_t min_child = (child + 1 == heap_.size()
+          || Time_Traits::less_than(
+            heap_[child].time_, heap_[child + 1].time_))
+        ? child : child + 1;
+      if (Time_Traits::less_than(heap_[index].time_, heap_[min_child].time_))
+        break;
+      swap_heap(index, min_child);
+      index = min_child;
+      child = index * 2 + 1;
+    }
+  }
+
+  // Swap two entries in the heap.
+  void swap_heap(std::size_t index1, std::size_t index2)
+  {
+    heap_entry tmp = heap_[index1];
+    heap_[index1] = heap_[index2];
+    heap_[index2] = tmp;
+    heap_[index1].timer_->heap_index_ = index1;
+    heap_[index2].timer_->heap_index_ = index2;
+  }
+
+  // Remove a timer from the wheel, heap or list of timers that never expire.
+  void remove_timer(per_timer_data& timer)
+  {
+    if (timer.location_ == per_timer_data::in_heap)
+    {
+      std::size_t index = timer.heap_index_;
+      if (index == heap_.size() - 1)
+      {
+        heap_.pop_back();
+      }
+      else
+      {
+        swap_heap(index, heap_.size() - 1);
+        heap_.pop_back();
+        std::size_t parent = (index - 1) / 2;
+        if (index > 0 && Time_Traits::less_than(
+              heap_[index].time_, heap_[parent].time_))
+          up_heap(index);
+        else
+          down_heap(index);
+      }
+    }
+    else
+    {
+      // An emptied slot is skipped when the wheel next advances.
+      unlink(timer);
+    }
+
+    timer.location_ = per_timer_data::unscheduled;
+    --num_timers_;
+  }
+
+  // Determine if the specified absolute time is positive infinity.
+  template <typename Time_Type>
+  static bool is_positive_infinity(const Time_Type&)
+  {
+    return false;
+  }
+
+  // Determine if the specified absolute time is positive infinity.
+  template <typename T, typename TimeSystem>
+  static bool is_positive_infinity(
+      const boost::date_time::base_time<T, TimeSystem>& time)
+  {
+    return time.is_pos_infinity();
+  }
+
+  // The time corresponding to tick zero.
+  time_type origin_;
+
+  // All ticks up to and including this one have been processed.
+  uint64_t current_tick_;
+
+  // The first tick after current_tick_ at which a slot may have timers.
+  uint64_t next_tick_;
+
+  // The number of timers in the queue.
+  std::size_t num_timers_;
+
+  // The slots of the wheel, each holding a list of timers.
+  per_timer_data* wheel_[num_levels][num_slots];
+
+  // The list of timers that never expire.
+  per_timer_data* never_expires_;
+
+  struct heap_entry
+  {
+    // The time when the timer should fire.
+    time_type time_;
+
+    // The associated timer with enqueued operations.
+    per_timer_data* timer_;
+  };
+
+  // The heap of timers whose tick has been reached, with the earliest timer at
+  // the front.
+  std::vector<heap_entry> heap_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_TIMER_QUEUE_WHEEL_HPP
@@ -428,9 +428,10 @@ public:
     }
 
     std::size_t addr_len = peer_endpoint ? peer_endpoint->capacity() : 0;
+    socket_ops::state_type new_state = 0;
     socket_holder new_socket(socket_ops::sync_accept(impl.socket_,
           impl.state_, peer_endpoint ? peer_endpoint->data() : 0,
-          peer_endpoint ? &addr_len : 0, ec));
+          peer_endpoint ? &addr_len : 0, new_state, ec));
 
     // On success, assign new connection to peer socket object.
     if (new_socket.get() >= 0)
@@ -33,7 +33,14 @@ namespace asio {
  * handlers to provide custom allocation for these temporary objects.
  *
  * The default implementation of these allocation hooks uses <tt>::operator
- * new</tt> and <tt>::operator delete</tt>.
+ * new</tt> and <tt>::operator delete</tt>. When called from a thread that is
+ * running an io_service, small memory blocks are recycled through a per-thread
+ * cache that is organised by size class. The largest recycled size (512 bytes
+ * by default) may be changed by defining
+ * <tt>BOOST_ASIO_RECYCLING_ALLOCATOR_MAX_SIZE</tt>, the number of blocks kept
+ * for each size class (4 by default) by defining
+ * <tt>BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_DEPTH</tt>, and the cache disabled
+ * by defining <tt>BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING</tt>.
  *
  * @note All temporary objects associated with a handler will be deallocated
  * before the upcall to the handler is performed. This allows the same memory to
@@ -71,6 +78,28 @@ BOOST_ASIO_DECL void* asio_handler_allocate(
 BOOST_ASIO_DECL void asio_handler_deallocate(
     void* pointer, std::size_t size, ...);
 
+/// Counts of allocations made by the default handler allocation function.
+struct handler_alloc_stats
+{
+  /// The number of allocations satisfied from a per-thread cache of recycled
+  /// memory blocks.
+  std::size_t hits;
+
+  /// The number of allocations that were passed to <tt>::operator new</tt>
+  /// by a thread that was running an io_service.
+  std::size_t misses;
+};
+
+/// Get the counts of allocations made by the default allocation function.
+/**
+ * The counts include all threads that have returned from a call to an
+ * io_service's run(), run_one(), poll() or poll_one() function, and the
+ * calling thread if it is currently running an io_service. Allocations made
+ * by other threads, and allocations made when small block recycling is
+ * disabled, are not counted.
+ */
+BOOST_ASIO_DECL handler_alloc_stats get_handler_alloc_stats();
+
 } // namespace asio
 } // namespace boost
 
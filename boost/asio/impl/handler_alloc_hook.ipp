@@ -68,6 +68,30 @@ void asio_handler_deallocate(void* pointer, std::size_t size, ...)
 #endif // !defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
 }
 
+handler_alloc_stats get_handler_alloc_stats()
+{
+  handler_alloc_stats result = { 0, 0 };
+#if !defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+# if defined(BOOST_ASIO_HAS_IOCP)
+  typedef detail::win_iocp_io_service io_service_impl;
+  typedef detail::win_iocp_thread_info thread_info;
+# else // defined(BOOST_ASIO_HAS_IOCP)
+  typedef detail::task_io_service io_service_impl;
+  typedef detail::task_io_service_thread_info thread_info;
+# endif // defined(BOOST_ASIO_HAS_IOCP)
+  typedef detail::call_stack<io_service_impl, thread_info> call_stack;
+  thread_info::stats totals = thread_info::total_stats();
+  result.hits = totals.hits;
+  result.misses = totals.misses;
+  if (thread_info* this_thread = call_stack::top())
+  {
+    result.hits += this_thread->thread_stats().hits;
+    result.misses += this_thread->thread_stats().misses;
+  }
+#endif // !defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+  return result;
+}
+
 } // namespace asio
 } // namespace boost
 
@@ -0,0 +1,61 @@
+//
+// impl/io_service_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IMPL_IO_SERVICE_POOL_HPP
+#define BOOST_ASIO_IMPL_IO_SERVICE_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/addressof.hpp>
+#include <boost/asio/detail/completion_handler.hpp>
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
+#include <boost/asio/detail/handler_type_requirements.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+template <typename CompletionHandler>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionHandler, void ())
+io_service_pool::post(BOOST_ASIO_MOVE_ARG(CompletionHandler) handler)
+{
+  // If you get an error on the following line it means that your handler does
+  // not meet the documented type requirements for a CompletionHandler.
+  BOOST_ASIO_COMPLETION_HANDLER_CHECK(CompletionHandler, handler) type_check;
+
+  detail::async_result_init<
+    CompletionHandler, void ()> init(
+      BOOST_ASIO_MOVE_CAST(CompletionHandler)(handler));
+
+  // Allocate and construct an operation to wrap the handler.
+  typedef detail::completion_handler<
+    BOOST_ASIO_HANDLER_TYPE(CompletionHandler, void ())> op;
+  typename op::ptr p = { boost::asio::detail::addressof(init.handler),
+    boost_asio_handler_alloc_helpers::allocate(
+      sizeof(op), init.handler), 0 };
+  p.p = new (p.v) op(init.handler);
+
+  BOOST_ASIO_HANDLER_CREATION((p.p, "io_service_pool", this, "post"));
+
+  enqueue(p.p);
+  p.v = p.p = 0;
+
+  return init.result.get();
+}
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_IMPL_IO_SERVICE_POOL_HPP
@@ -0,0 +1,279 @@
+//
+// impl/io_service_pool.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IMPL_IO_SERVICE_POOL_IPP
+#define BOOST_ASIO_IMPL_IO_SERVICE_POOL_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <stdexcept>
+#include <boost/asio/io_service_pool.hpp>
+#include <boost/asio/detail/assert.hpp>
+#include <boost/asio/detail/op_queue.hpp>
+#include <boost/asio/detail/thread.hpp>
+#include <boost/asio/detail/throw_exception.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+struct io_service_pool::shard
+{
+  shard()
+    : io_service_(1),
+      work_(io_service_),
+      ready_count_(0),
+      idle_(0)
+  {
+  }
+
+  // The io_service, and so the reactor and timer queues, owned by the shard.
+  boost::asio::io_service io_service_;
+
+  // Keeps the shard's io_service running until the pool is stopped.
+  boost::asio::io_service::work work_;
+
+  // Mutex to protect access to the ready queue.
+  detail::mutex mutex_;
+
+  // Handlers submitted through the pool that are waiting to be run.
+  detail::op_queue<operation> ready_;
+
+  // The number of handlers in the ready queue. Lets other shards check for
+  // work to steal without taking the mutex.
+  detail::atomic_count ready_count_;
+
+  // Non-zero while the shard's thread is blocked waiting for local work.
+  detail::atomic_count idle_;
+};
+
+struct io_service_pool::run_ready_handler
+{
+  void operator()()
+  {
+    pool_->run_ready(index_, index_);
+  }
+
+  io_service_pool* pool_;
+  std::size_t index_;
+};
+
+struct io_service_pool::thread_function
+{
+  void operator()()
+  {
+    pool_->run_shard(index_);
+  }
+
+  io_service_pool* pool_;
+  std::size_t index_;
+};
+
+io_service_pool::io_service_pool(std::size_t pool_size)
+  : next_shard_(0),
+    stopped_(0)
+{
+  if (pool_size == 0)
+  {
+    std::invalid_argument ex("io_service_pool size is 0");
+    boost::asio::detail::throw_exception(ex);
+  }
+
+  shards_.reserve(pool_size);
+  for (std::size_t i = 0; i < pool_size; ++i)
+    shards_.push_back(detail::shared_ptr<shard>(new shard));
+}
+
+io_service_pool::~io_service_pool()
+{
+  stop();
+
+  // Wait for any in-progress call to run() to finish before the shards, and
+  // any handlers still waiting in their ready queues, are destroyed.
+  detail::mutex::scoped_lock lock(run_mutex_);
+}
+
+boost::asio::io_service& io_service_pool::get_io_service()
+{
+  std::size_t index = static_cast<std::size_t>(++next_shard_);
+  return shards_[index % shards_.size()]->io_service_;
+}
+
+boost::asio::io_service& io_service_pool::get_io_service(std::size_t index)
+{
+  BOOST_ASIO_ASSERT(index < shards_.size());
+  return shards_[index]->io_service_;
+}
+
+void io_service_pool::run()
+{
+  detail::mutex::scoped_lock lock(run_mutex_);
+
+  // Helper class to stop the pool and join all started threads on block exit.
+  struct thread_list
+  {
+    ~thread_list()
+    {
+      if (threads_.size() != pool_->shards_.size())
+        pool_->stop();
+
+      for (std::size_t i = 0; i < threads_.size(); ++i)
+      {
+        threads_[i]->join();
+        delete threads_[i];
+      }
+    }
+
+    io_service_pool* pool_;
+    std::vector<detail::thread*> threads_;
+  } threads = { this, std::vector<detail::thread*>() };
+
+  threads.threads_.reserve(shards_.size());
+  for (std::size_t i = 0; i < shards_.size(); ++i)
+  {
+    thread_function f = { this, i };
+    threads.threads_.push_back(0);
+    threads.threads_.back() = new detail::thread(f);
+  }
+}
+
+void io_service_pool::stop()
+{
+  if (++stopped_ == 1)
+  {
+    for (std::size_t i = 0; i < shards_.size(); ++i)
+      shards_[i]->io_service_.stop();
+  }
+}
+
+bool io_service_pool::stopped() const
+{
+  return stopped_ != 0;
+}
+
+void io_service_pool::enqueue(operation* op)
+{
+  // Prefer a shard whose thread is blocked waiting for work, starting the
+  // search from the next shard in round-robin order.
+  std::size_t n = shards_.size();
+  std::size_t start = static_cast<std::size_t>(++next_shard_) % n;
+  std::size_t target = start;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    std::size_t candidate = (start + i) % n;
+    if (shards_[candidate]->idle_ != 0)
+    {
+      target = candidate;
+      break;
+    }
+  }
+
+  shard& s = *shards_[target];
+  detail::mutex::scoped_lock lock(s.mutex_);
+  s.ready_.push(op);
+  ++s.ready_count_;
+  lock.unlock();
+
+  // Wake the target shard. If another shard steals the handler first, this
+  // will simply find the ready queue empty.
+  run_ready_handler handler = { this, target };
+  s.io_service_.post(handler);
+}
+
+void io_service_pool::run_shard(std::size_t index)
+{
+  shard& s = *shards_[index];
+  boost::system::error_code ec;
+
+  // Helper class to clear the shard's idle marker on block exit.
+  struct idle_marker
+  {
+    ~idle_marker()
+    {
+      --shard_->idle_;
+    }
+
+    shard* shard_;
+  };
+
+  while (stopped_ == 0)
+  {
+    try
+    {
+      // Run all local handlers that are ready, without blocking.
+      if (s.io_service_.poll(ec) > 0)
+        continue;
+
+      // Out of local work, so look for work queued on another shard.
+      if (steal(index))
+        continue;
+
+      // Nothing to do anywhere. Block in the reactor until there is. The work
+      // object means that run_one() only returns 0 once the io_service has
+      // been stopped, which happens when the pool is stopped or when the user
+      // stops the shard directly. In the latter case the shard cannot make
+      // progress, so the whole pool is stopped rather than leave this thread
+      // spinning.
+      ++s.idle_;
+      idle_marker marker = { &s };
+      if (s.io_service_.run_one(ec) == 0)
+        break;
+    }
+    catch (...)
+    {
+      // There is no caller to pass an exception thrown by a handler to, so it
+      // is discarded and the shard carries on running.
+    }
+  }
+
+  stop();
+}
+
+bool io_service_pool::run_ready(std::size_t victim, std::size_t index)
+{
+  shard& v = *shards_[victim];
+  if (v.ready_count_ == 0)
+    return false;
+
+  detail::mutex::scoped_lock lock(v.mutex_);
+  operation* o = v.ready_.front();
+  if (o == 0)
+    return false;
+  v.ready_.pop();
+  --v.ready_count_;
+  lock.unlock();
+
+  // Complete the operation. May throw an exception. Deletes the object.
+  boost::system::error_code ec;
+  o->complete(use_service<detail::io_service_impl>(
+        shards_[index]->io_service_), ec, 0);
+
+  return true;
+}
+
+bool io_service_pool::steal(std::size_t index)
+{
+  std::size_t n = shards_.size();
+  for (std::size_t i = 1; i < n; ++i)
+    if (run_ready((index + i) % n, index))
+      return true;
+  return false;
+}
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_IMPL_IO_SERVICE_POOL_IPP
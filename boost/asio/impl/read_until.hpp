@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <algorithm>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <utility>
@@ -44,50 +45,118 @@ inline std::size_t read_until(SyncReadStream& s,
   return bytes_transferred;
 }
 
-template <typename SyncReadStream, typename Allocator>
-std::size_t read_until(SyncReadStream& s,
-    boost::asio::basic_streambuf<Allocator>& b, char delim,
-    boost::system::error_code& ec)
+namespace detail
 {
-  std::size_t search_position = 0;
-  for (;;)
+  // Find the first occurrence of a character in a buffer sequence, starting
+  // at the given offset. Each buffer is searched with memchr. Returns the
+  // offset of the character, or the total size of the buffers if there is no
+  // match.
+  template <typename ConstBufferSequence>
+  std::size_t buffers_find(const ConstBufferSequence& buffers,
+      std::size_t start, char c)
   {
-    // Determine the range of the data to be searched.
-    typedef typename boost::asio::basic_streambuf<
-      Allocator>::const_buffers_type const_buffers_type;
-    typedef boost::asio::buffers_iterator<const_buffers_type> iterator;
-    const_buffers_type buffers = b.data();
+    typename ConstBufferSequence::const_iterator iter = buffers.begin();
+    typename ConstBufferSequence::const_iterator end = buffers.end();
+    std::size_t offset = 0;
+    for (; iter != end; ++iter)
+    {
+      boost::asio::const_buffer buffer(*iter);
+      std::size_t size = boost::asio::buffer_size(buffer);
+      if (start < offset + size)
+      {
+        const char* data = boost::asio::buffer_cast<const char*>(buffer);
+        std::size_t skip = start > offset ? start - offset : 0;
+        if (const void* p = std::memchr(data + skip, c, size - skip))
+          return offset + (static_cast<const char*>(p) - data);
+      }
+      offset += size;
+    }
+    return offset;
+  }
+
+  // Find the first occurrence of a string in a buffer sequence, starting at
+  // the given offset. Candidate positions are located with memchr. Returns
+  // (offset,true) if a full match was found. Returns (offset,false) if a
+  // partial match was found at the end of the data, in which case the offset
+  // is the beginning of the partial match. Returns (size,false) if no full or
+  // partial match was found.
+  template <typename ConstBufferSequence>
+  std::pair<std::size_t, bool> buffers_find(
+      const ConstBufferSequence& buffers, std::size_t start,
+      const std::string& delim)
+  {
+    typedef boost::asio::buffers_iterator<ConstBufferSequence> iterator;
     iterator begin = iterator::begin(buffers);
-    iterator start_pos = begin + search_position;
     iterator end = iterator::end(buffers);
+    std::size_t size = end - begin;
 
-    // Look for a match.
-    iterator iter = std::find(start_pos, end, delim);
-    if (iter != end)
-    {
-      // Found a match. We're done.
-      ec = boost::system::error_code();
-      return iter - begin + 1;
-    }
-    else
+    if (delim.empty())
+      return std::make_pair(start, start < size);
+
+    for (std::size_t pos = start; ; ++pos)
     {
-      // No match. Next search can start with the new data.
-      search_position = end - begin;
+      pos = buffers_find(buffers, pos, delim[0]);
+      if (pos == size)
+        return std::make_pair(size, false);
+
+      iterator iter = begin + pos;
+      std::string::const_iterator delim_iter = delim.begin();
+      for (;;)
+      {
+        if (++delim_iter == delim.end())
+          return std::make_pair(pos, true);
+        if (++iter == end)
+          return std::make_pair(pos, false);
+        if (*iter != *delim_iter)
+          break;
+      }
     }
+  }
 
-    // Check if buffer is full.
-    if (b.size() == b.max_size())
+  template <typename SyncReadStream, typename DynamicBuffer>
+  std::size_t read_until_delim(SyncReadStream& s,
+      DynamicBuffer& b, char delim, boost::system::error_code& ec)
+  {
+    std::size_t search_position = 0;
+    for (;;)
     {
-      ec = error::not_found;
-      return 0;
-    }
+      // Look for a match, starting where the previous search stopped.
+      std::size_t match = detail::buffers_find(
+          b.data(), search_position, delim);
+      if (match != b.size())
+      {
+        // Found a match. We're done.
+        ec = boost::system::error_code();
+        return match + 1;
+      }
+      else
+      {
+        // No match. Next search can start with the new data.
+        search_position = match;
+      }
 
-    // Need more data.
-    std::size_t bytes_to_read = read_size_helper(b, 65536);
-    b.commit(s.read_some(b.prepare(bytes_to_read), ec));
-    if (ec)
-      return 0;
+      // Check if buffer is full.
+      if (b.size() == b.max_size())
+      {
+        ec = error::not_found;
+        return 0;
+      }
+
+      // Need more data.
+      std::size_t bytes_to_read = read_size_helper(b, 65536);
+      b.commit(s.read_some(b.prepare(bytes_to_read), ec));
+      if (ec)
+        return 0;
+    }
   }
+} // namespace detail
+
+template <typename SyncReadStream, typename Allocator>
+inline std::size_t read_until(SyncReadStream& s,
+    boost::asio::basic_streambuf<Allocator>& b, char delim,
+    boost::system::error_code& ec)
+{
+  return detail::read_until_delim(s, b, delim, ec);
 }
 
 template <typename SyncReadStream, typename Allocator>
@@ -135,59 +204,90 @@ namespace detail
   }
 } // namespace detail
 
-template <typename SyncReadStream, typename Allocator>
-std::size_t read_until(SyncReadStream& s,
-    boost::asio::basic_streambuf<Allocator>& b, const std::string& delim,
-    boost::system::error_code& ec)
+namespace detail
 {
-  std::size_t search_position = 0;
-  for (;;)
+  template <typename SyncReadStream, typename DynamicBuffer>
+  std::size_t read_until_delim_string(SyncReadStream& s,
+      DynamicBuffer& b, const std::string& delim,
+      boost::system::error_code& ec)
   {
-    // Determine the range of the data to be searched.
-    typedef typename boost::asio::basic_streambuf<
-      Allocator>::const_buffers_type const_buffers_type;
-    typedef boost::asio::buffers_iterator<const_buffers_type> iterator;
-    const_buffers_type buffers = b.data();
-    iterator begin = iterator::begin(buffers);
-    iterator start_pos = begin + search_position;
-    iterator end = iterator::end(buffers);
-
-    // Look for a match.
-    std::pair<iterator, bool> result = detail::partial_search(
-        start_pos, end, delim.begin(), delim.end());
-    if (result.first != end)
+    std::size_t search_position = 0;
+    for (;;)
     {
+      // Look for a match, starting where the previous search stopped.
+      std::pair<std::size_t, bool> result = detail::buffers_find(
+          b.data(), search_position, delim);
       if (result.second)
       {
         // Full match. We're done.
         ec = boost::system::error_code();
-        return result.first - begin + delim.length();
+        return result.first + delim.length();
       }
       else
       {
-        // Partial match. Next search needs to start from beginning of match.
-        search_position = result.first - begin;
+        // Partial match, or no match. Next search needs to start from the
+        // beginning of the partial match or with the new data.
+        search_position = result.first;
       }
-    }
-    else
-    {
-      // No match. Next search can start with the new data.
-      search_position = end - begin;
-    }
 
-    // Check if buffer is full.
-    if (b.size() == b.max_size())
-    {
-      ec = error::not_found;
-      return 0;
-    }
+      // Check if buffer is full.
+      if (b.size() == b.max_size())
+      {
+        ec = error::not_found;
+        return 0;
+      }
 
-    // Need more data.
-    std::size_t bytes_to_read = read_size_helper(b, 65536);
-    b.commit(s.read_some(b.prepare(bytes_to_read), ec));
-    if (ec)
-      return 0;
+      // Need more data.
+      std::size_t bytes_to_read = read_size_helper(b, 65536);
+      b.commit(s.read_some(b.prepare(bytes_to_read), ec));
+      if (ec)
+        return 0;
+    }
   }
+} // namespace detail
+
+template <typename SyncReadStream, typename Allocator>
+inline std::size_t read_until(SyncReadStream& s,
+    boost::asio::basic_streambuf<Allocator>& b, const std::string& delim,
+    boost::system::error_code& ec)
+{
+  return detail::read_until_delim_string(s, b, delim, ec);
+}
+
+template <typename SyncReadStream, typename Allocator>
+inline std::size_t read_until(SyncReadStream& s,
+    boost::asio::basic_ring_buffer<Allocator>& b, char delim)
+{
+  boost::system::error_code ec;
+  std::size_t bytes_transferred = read_until(s, b, delim, ec);
+  boost::asio::detail::throw_error(ec, "read_until");
+  return bytes_transferred;
+}
+
+template <typename SyncReadStream, typename Allocator>
+inline std::size_t read_until(SyncReadStream& s,
+    boost::asio::basic_ring_buffer<Allocator>& b, char delim,
+    boost::system::error_code& ec)
+{
+  return detail::read_until_delim(s, b, delim, ec);
+}
+
+template <typename SyncReadStream, typename Allocator>
+inline std::size_t read_until(SyncReadStream& s,
+    boost::asio::basic_ring_buffer<Allocator>& b, const std::string& delim)
+{
+  boost::system::error_code ec;
+  std::size_t bytes_transferred = read_until(s, b, delim, ec);
+  boost::asio::detail::throw_error(ec, "read_until");
+  return bytes_transferred;
+}
+
+template <typename SyncReadStream, typename Allocator>
+inline std::size_t read_until(SyncReadStream& s,
+    boost::asio::basic_ring_buffer<Allocator>& b, const std::string& delim,
+    boost::system::error_code& ec)
+{
+  return detail::read_until_delim_string(s, b, delim, ec);
 }
 
 #if defined(BOOST_ASIO_HAS_BOOST_REGEX)
@@ -326,12 +426,13 @@ inline std::size_t read_until(SyncReadStream& s,
 
 namespace detail
 {
-  template <typename AsyncReadStream, typename Allocator, typename ReadHandler>
+  template <typename AsyncReadStream,
+      typename DynamicBuffer, typename ReadHandler>
   class read_until_delim_op
   {
   public:
     read_until_delim_op(AsyncReadStream& stream,
-        boost::asio::basic_streambuf<Allocator>& streambuf,
+        DynamicBuffer& streambuf,
         char delim, ReadHandler& handler)
       : stream_(stream),
         streambuf_(streambuf),
@@ -375,21 +476,13 @@ namespace detail
         for (;;)
         {
           {
-            // Determine the range of the data to be searched.
-            typedef typename boost::asio::basic_streambuf<
-              Allocator>::const_buffers_type const_buffers_type;
-            typedef boost::asio::buffers_iterator<const_buffers_type> iterator;
-            const_buffers_type buffers = streambuf_.data();
-            iterator begin = iterator::begin(buffers);
-            iterator start_pos = begin + search_position_;
-            iterator end = iterator::end(buffers);
-
-            // Look for a match.
-            iterator iter = std::find(start_pos, end, delim_);
-            if (iter != end)
+            // Look for a match, starting where the previous search stopped.
+            std::size_t match = detail::buffers_find(
+                streambuf_.data(), search_position_, delim_);
+            if (match != streambuf_.size())
             {
               // Found a match. We're done.
-              search_position_ = iter - begin + 1;
+              search_position_ = match + 1;
               bytes_to_read = 0;
             }
 
@@ -404,7 +497,7 @@ namespace detail
             else
             {
               // Next search can start with the new data.
-              search_position_ = end - begin;
+              search_position_ = match;
               bytes_to_read = read_size_helper(streambuf_, 65536);
             }
           }
@@ -436,56 +529,59 @@ namespace detail
 
   //private:
     AsyncReadStream& stream_;
-    boost::asio::basic_streambuf<Allocator>& streambuf_;
+    DynamicBuffer& streambuf_;
     char delim_;
     int start_;
     std::size_t search_position_;
     ReadHandler handler_;
   };
 
-  template <typename AsyncReadStream, typename Allocator, typename ReadHandler>
+  template <typename AsyncReadStream,
+      typename DynamicBuffer, typename ReadHandler>
   inline void* asio_handler_allocate(std::size_t size,
       read_until_delim_op<AsyncReadStream,
-        Allocator, ReadHandler>* this_handler)
+        DynamicBuffer, ReadHandler>* this_handler)
   {
     return boost_asio_handler_alloc_helpers::allocate(
         size, this_handler->handler_);
   }
 
-  template <typename AsyncReadStream, typename Allocator, typename ReadHandler>
+  template <typename AsyncReadStream,
+      typename DynamicBuffer, typename ReadHandler>
   inline void asio_handler_deallocate(void* pointer, std::size_t size,
       read_until_delim_op<AsyncReadStream,
-        Allocator, ReadHandler>* this_handler)
+        DynamicBuffer, ReadHandler>* this_handler)
   {
     boost_asio_handler_alloc_helpers::deallocate(
         pointer, size, this_handler->handler_);
   }
 
-  template <typename AsyncReadStream, typename Allocator, typename ReadHandler>
+  template <typename AsyncReadStream,
+      typename DynamicBuffer, typename ReadHandler>
   inline bool asio_handler_is_continuation(
       read_until_delim_op<AsyncReadStream,
-        Allocator, ReadHandler>* this_handler)
+        DynamicBuffer, ReadHandler>* this_handler)
   {
     return this_handler->start_ == 0 ? true
       : boost_asio_handler_cont_helpers::is_continuation(
           this_handler->handler_);
   }
 
-  template <typename Function, typename AsyncReadStream, typename Allocator,
+  template <typename Function, typename AsyncReadStream, typename DynamicBuffer,
       typename ReadHandler>
   inline void asio_handler_invoke(Function& function,
       read_until_delim_op<AsyncReadStream,
-        Allocator, ReadHandler>* this_handler)
+        DynamicBuffer, ReadHandler>* this_handler)
   {
     boost_asio_handler_invoke_helpers::invoke(
         function, this_handler->handler_);
   }
 
-  template <typename Function, typename AsyncReadStream, typename Allocator,
+  template <typename Function, typename AsyncReadStream, typename DynamicBuffer,
       typename ReadHandler>
   inline void asio_handler_invoke(const Function& function,
       read_until_delim_op<AsyncReadStream,
-        Allocator, ReadHandler>* this_handler)
+        DynamicBuffer, ReadHandler>* this_handler)
   {
     boost_asio_handler_invoke_helpers::invoke(
         function, this_handler->handler_);
@@ -508,7 +604,31 @@ async_read_until(AsyncReadStream& s,
       BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
 
   detail::read_until_delim_op<AsyncReadStream,
-    Allocator, BOOST_ASIO_HANDLER_TYPE(ReadHandler,
+    basic_streambuf<Allocator>, BOOST_ASIO_HANDLER_TYPE(ReadHandler,
+      void (boost::system::error_code, std::size_t))>(
+        s, b, delim, init.handler)(
+          boost::system::error_code(), 0, 1);
+
+  return init.result.get();
+}
+
+template <typename AsyncReadStream, typename Allocator, typename ReadHandler>
+BOOST_ASIO_INITFN_RESULT_TYPE(ReadHandler,
+    void (boost::system::error_code, std::size_t))
+async_read_until(AsyncReadStream& s,
+    boost::asio::basic_ring_buffer<Allocator>& b, char delim,
+    BOOST_ASIO_MOVE_ARG(ReadHandler) handler)
+{
+  // If you get an error on the following line it means that your handler does
+  // not meet the documented type requirements for a ReadHandler.
+  BOOST_ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+  detail::async_result_init<
+    ReadHandler, void (boost::system::error_code, std::size_t)> init(
+      BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
+
+  detail::read_until_delim_op<AsyncReadStream,
+    basic_ring_buffer<Allocator>, BOOST_ASIO_HANDLER_TYPE(ReadHandler,
       void (boost::system::error_code, std::size_t))>(
         s, b, delim, init.handler)(
           boost::system::error_code(), 0, 1);
@@ -518,12 +638,13 @@ async_read_until(AsyncReadStream& s,
 
 namespace detail
 {
-  template <typename AsyncReadStream, typename Allocator, typename ReadHandler>
+  template <typename AsyncReadStream,
+      typename DynamicBuffer, typename ReadHandler>
   class read_until_delim_string_op
   {
   public:
     read_until_delim_string_op(AsyncReadStream& stream,
-        boost::asio::basic_streambuf<Allocator>& streambuf,
+        DynamicBuffer& streambuf,
         const std::string& delim, ReadHandler& handler)
       : stream_(stream),
         streambuf_(streambuf),
@@ -567,22 +688,13 @@ namespace detail
         for (;;)
         {
           {
-            // Determine the range of the data to be searched.
-            typedef typename boost::asio::basic_streambuf<
-              Allocator>::const_buffers_type const_buffers_type;
-            typedef boost::asio::buffers_iterator<const_buffers_type> iterator;
-            const_buffers_type buffers = streambuf_.data();
-            iterator begin = iterator::begin(buffers);
-            iterator start_pos = begin + search_position_;
-            iterator end = iterator::end(buffers);
-
-            // Look for a match.
-            std::pair<iterator, bool> result = detail::partial_search(
-                start_pos, end, delim_.begin(), delim_.end());
-            if (result.first != end && result.second)
+            // Look for a match, starting where the previous search stopped.
+            std::pair<std::size_t, bool> result = detail::buffers_find(
+                streambuf_.data(), search_position_, delim_);
+            if (result.second)
             {
               // Full match. We're done.
-              search_position_ = result.first - begin + delim_.length();
+              search_position_ = result.first + delim_.length();
               bytes_to_read = 0;
             }
 
@@ -596,18 +708,9 @@ namespace detail
             // Need to read some more data.
             else
             {
-              if (result.first != end)
-              {
-                // Partial match. Next search needs to start from beginning of
-                // match.
-                search_position_ = result.first - begin;
-              }
-              else
-              {
-                // Next search can start with the new data.
-                search_position_ = end - begin;
-              }
-
+              // Partial match, or no match. Next search needs to start from
+              // the beginning of the partial match or with the new data.
+              search_position_ = result.first;
               bytes_to_read = read_size_helper(streambuf_, 65536);
             }
           }
@@ -639,35 +742,38 @@ namespace detail
 
   //private:
     AsyncReadStream& stream_;
-    boost::asio::basic_streambuf<Allocator>& streambuf_;
+    DynamicBuffer& streambuf_;
     std::string delim_;
     int start_;
     std::size_t search_position_;
     ReadHandler handler_;
   };
 
-  template <typename AsyncReadStream, typename Allocator, typename ReadHandler>
+  template <typename AsyncReadStream,
+      typename DynamicBuffer, typename ReadHandler>
   inline void* asio_handler_allocate(std::size_t size,
       read_until_delim_string_op<AsyncReadStream,
-        Allocator, ReadHandler>* this_handler)
+        DynamicBuffer, ReadHandler>* this_handler)
   {
     return boost_asio_handler_alloc_helpers::allocate(
         size, this_handler->handler_);
   }
 
-  template <typename AsyncReadStream, typename Allocator, typename ReadHandler>
+  template <typename AsyncReadStream,
+      typename DynamicBuffer, typename ReadHandler>
   inline void asio_handler_deallocate(void* pointer, std::size_t size,
       read_until_delim_string_op<AsyncReadStream,
-        Allocator, ReadHandler>* this_handler)
+        DynamicBuffer, ReadHandler>* this_handler)
   {
     boost_asio_handler_alloc_helpers::deallocate(
         pointer, size, this_handler->handler_);
   }
 
-  template <typename AsyncReadStream, typename Allocator, typename ReadHandler>
+  template <typename AsyncReadStream,
+      typename DynamicBuffer, typename ReadHandler>
   inline bool asio_handler_is_continuation(
       read_until_delim_string_op<AsyncReadStream,
-        Allocator, ReadHandler>* this_handler)
+        DynamicBuffer, ReadHandler>* this_handler)
   {
     return this_handler->start_ == 0 ? true
       : boost_asio_handler_cont_helpers::is_continuation(
@@ -675,20 +781,20 @@ namespace detail
   }
 
   template <typename Function, typename AsyncReadStream,
-      typename Allocator, typename ReadHandler>
+      typename DynamicBuffer, typename ReadHandler>
   inline void asio_handler_invoke(Function& function,
       read_until_delim_string_op<AsyncReadStream,
-        Allocator, ReadHandler>* this_handler)
+        DynamicBuffer, ReadHandler>* this_handler)
   {
     boost_asio_handler_invoke_helpers::invoke(
         function, this_handler->handler_);
   }
 
   template <typename Function, typename AsyncReadStream,
-      typename Allocator, typename ReadHandler>
+      typename DynamicBuffer, typename ReadHandler>
   inline void asio_handler_invoke(const Function& function,
       read_until_delim_string_op<AsyncReadStream,
-        Allocator, ReadHandler>* this_handler)
+        DynamicBuffer, ReadHandler>* this_handler)
   {
     boost_asio_handler_invoke_helpers::invoke(
         function, this_handler->handler_);
@@ -711,7 +817,31 @@ async_read_until(AsyncReadStream& s,
       BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
 
   detail::read_until_delim_string_op<AsyncReadStream,
-    Allocator, BOOST_ASIO_HANDLER_TYPE(ReadHandler,
+    basic_streambuf<Allocator>, BOOST_ASIO_HANDLER_TYPE(ReadHandler,
+      void (boost::system::error_code, std::size_t))>(
+        s, b, delim, init.handler)(
+          boost::system::error_code(), 0, 1);
+
+  return init.result.get();
+}
+
+template <typename AsyncReadStream, typename Allocator, typename ReadHandler>
+BOOST_ASIO_INITFN_RESULT_TYPE(ReadHandler,
+    void (boost::system::error_code, std::size_t))
+async_read_until(AsyncReadStream& s,
+    boost::asio::basic_ring_buffer<Allocator>& b, const std::string& delim,
+    BOOST_ASIO_MOVE_ARG(ReadHandler) handler)
+{
+  // If you get an error on the following line it means that your handler does
+  // not meet the documented type requirements for a ReadHandler.
+  BOOST_ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+  detail::async_result_init<
+    ReadHandler, void (boost::system::error_code, std::size_t)> init(
+      BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
+
+  detail::read_until_delim_string_op<AsyncReadStream,
+    basic_ring_buffer<Allocator>, BOOST_ASIO_HANDLER_TYPE(ReadHandler,
       void (boost::system::error_code, std::size_t))>(
         s, b, delim, init.handler)(
           boost::system::error_code(), 0, 1);
@@ -0,0 +1,195 @@
+//
+// io_service_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IO_SERVICE_POOL_HPP
+#define BOOST_ASIO_IO_SERVICE_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <vector>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/detail/atomic_count.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/operation.hpp>
+#include <boost/asio/detail/shared_ptr.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Provides a sharded set of io_service objects, one per thread.
+/**
+ * The io_service_pool class owns a fixed number of io_service objects, called
+ * shards. Each shard has its own reactor, timer queues and completion queue,
+ * and is run by exactly one thread. Because a shard is only ever run from a
+ * single thread, each shard's io_service is created with a concurrency hint of
+ * 1, which allows it to deliver completions through its thread-private queue
+ * rather than through the shared, mutex-protected one.
+ *
+ * I/O objects are bound to a shard when they are constructed, by passing the
+ * result of get_io_service() to their constructor. All asynchronous
+ * operations on such an object complete on the owning shard's thread.
+ *
+ * Handlers that are not tied to an I/O object may be submitted using the
+ * pool's post() function. These handlers are placed on a per-shard ready
+ * queue, preferring a shard whose thread is currently idle. A shard that runs
+ * out of local work will steal ready handlers from the other shards before
+ * blocking in its reactor.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ *
+ * @par Example
+ * @code boost::asio::io_service_pool pool(4);
+ * boost::asio::ip::tcp::acceptor acceptor(pool.get_io_service(), endpoint);
+ * ...
+ * boost::asio::ip::tcp::socket socket(pool.get_io_service());
+ * acceptor.async_accept(socket, handler);
+ * ...
+ * pool.run(); // Blocks until pool.stop() is called. @endcode
+ */
+class io_service_pool
+  : private noncopyable
+{
+public:
+  /// Construct a pool with the specified number of shards.
+  /**
+   * @param pool_size The number of io_service objects, and therefore threads,
+   * in the pool.
+   *
+   * @throws std::invalid_argument Thrown if @c pool_size is 0.
+   */
+  BOOST_ASIO_DECL explicit io_service_pool(std::size_t pool_size);
+
+  /// Destructor.
+  /**
+   * Stops the pool, waits for any threads started by run() to exit, and
+   * destroys all handlers that have not yet been invoked.
+   */
+  BOOST_ASIO_DECL ~io_service_pool();
+
+  /// Get the number of shards in the pool.
+  std::size_t size() const
+  {
+    return shards_.size();
+  }
+
+  /// Get an io_service to which a new I/O object should be bound.
+  /**
+   * Shards are selected using a round-robin scheme.
+   */
+  BOOST_ASIO_DECL boost::asio::io_service& get_io_service();
+
+  /// Get the io_service for a specific shard.
+  /**
+   * @param index The index of the shard. Must be less than size().
+   */
+  BOOST_ASIO_DECL boost::asio::io_service& get_io_service(std::size_t index);
+
+  /// Run all shards, one thread per shard.
+  /**
+   * This function starts one thread for each shard and blocks until all of
+   * them have exited. The threads exit only when stop() is called. Calling
+   * @c stop() directly on a shard's io_service has the same effect as calling
+   * stop() on the pool.
+   *
+   * If a handler run by one of the threads throws an exception, the exception
+   * is caught and discarded, and the thread continues to run its shard.
+   * Handlers that need to report errors must do so themselves.
+   */
+  BOOST_ASIO_DECL void run();
+
+  /// Stop all shards.
+  /**
+   * This function does not block, but instead simply signals every shard to
+   * stop. Subsequent calls to run() return immediately.
+   */
+  BOOST_ASIO_DECL void stop();
+
+  /// Determine whether the pool has been stopped.
+  BOOST_ASIO_DECL bool stopped() const;
+
+  /// Request the pool to invoke the given handler on any shard.
+  /**
+   * This function is used to ask the pool to execute the given handler on
+   * whichever shard becomes available first. The handler is initially queued
+   * on an idle shard, if there is one, and may be stolen by any other shard
+   * that runs out of work before it is invoked.
+   *
+   * The pool guarantees that the handler will only be called from a thread
+   * started by run(). It will never be called from inside this function.
+   *
+   * @param handler The handler to be called. The pool will make a copy of the
+   * handler object as required. The function signature of the handler must be:
+   * @code void handler(); @endcode
+   */
+  template <typename CompletionHandler>
+  BOOST_ASIO_INITFN_RESULT_TYPE(CompletionHandler, void ())
+  post(BOOST_ASIO_MOVE_ARG(CompletionHandler) handler);
+
+private:
+  typedef detail::operation operation;
+
+  // The state associated with each shard.
+  struct shard;
+
+  // Handler posted to a shard's io_service to run one of its ready handlers.
+  struct run_ready_handler;
+  friend struct run_ready_handler;
+
+  // Helper class to start a shard's thread.
+  struct thread_function;
+  friend struct thread_function;
+
+  // Queue an operation on the most suitable shard.
+  BOOST_ASIO_DECL void enqueue(operation* op);
+
+  // Run the event loop for a single shard until the pool is stopped.
+  BOOST_ASIO_DECL void run_shard(std::size_t index);
+
+  // Dequeue and invoke one ready handler from the victim shard, completing it
+  // on the given shard. Returns true if a handler was run.
+  BOOST_ASIO_DECL bool run_ready(std::size_t victim, std::size_t index);
+
+  // Attempt to steal a ready handler from any shard other than the given one.
+  BOOST_ASIO_DECL bool steal(std::size_t index);
+
+  // The shards in the pool.
+  std::vector<detail::shared_ptr<shard> > shards_;
+
+  // The next shard to hand out from get_io_service() or to receive a post.
+  detail::atomic_count next_shard_;
+
+  // Whether the pool has been stopped.
+  detail::atomic_count stopped_;
+
+  // Mutex to serialise calls to run().
+  detail::mutex run_mutex_;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#include <boost/asio/impl/io_service_pool.hpp>
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/impl/io_service_pool.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // BOOST_ASIO_IO_SERVICE_POOL_HPP
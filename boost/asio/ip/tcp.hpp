@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/asio/detail/config.hpp>
+#include <boost/asio/basic_acceptor_pool.hpp>
 #include <boost/asio/basic_socket_acceptor.hpp>
 #include <boost/asio/basic_socket_iostream.hpp>
 #include <boost/asio/basic_stream_socket.hpp>
@@ -85,6 +86,13 @@ public:
   /// The TCP acceptor type.
   typedef basic_socket_acceptor<tcp> acceptor;
 
+#if defined(BOOST_ASIO_HAS_SO_REUSEPORT) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// The TCP acceptor pool type.
+  typedef basic_acceptor_pool<tcp> acceptor_pool;
+#endif // defined(BOOST_ASIO_HAS_SO_REUSEPORT)
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// The TCP resolver type.
   typedef basic_resolver<tcp> resolver;
 
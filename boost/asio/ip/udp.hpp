@@ -17,6 +17,7 @@
 
 #include <boost/asio/detail/config.hpp>
 #include <boost/asio/basic_datagram_socket.hpp>
+#include <boost/asio/detail/socket_option.hpp>
 #include <boost/asio/detail/socket_types.hpp>
 #include <boost/asio/ip/basic_endpoint.hpp>
 #include <boost/asio/ip/basic_resolver.hpp>
@@ -82,6 +83,37 @@ public:
   /// The UDP resolver type.
   typedef basic_resolver<udp> resolver;
 
+#if defined(BOOST_ASIO_HAS_UDP_SEGMENT) || defined(GENERATING_DOCUMENTATION)
+  /// Socket option for UDP generic segmentation offload.
+  /**
+   * Implements the IPPROTO_UDP/UDP_SEGMENT socket option. When set to a
+   * non-zero value, each buffer passed to a send operation may hold several
+   * datagrams of the given size, which the kernel or the network device
+   * splits before transmission. Combined with send_batch, this allows a large
+   * number of datagrams to be sent with very few system calls.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * boost::asio::ip::udp::socket socket(io_service);
+   * ...
+   * boost::asio::ip::udp::segment_size option(1200);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   *
+   * @note Only available on Linux 4.18 or later.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined segment_size;
+#else
+  typedef boost::asio::detail::socket_option::integer<
+    IPPROTO_UDP, boost::asio::detail::udp_segment_option> segment_size;
+#endif
+#endif // defined(BOOST_ASIO_HAS_UDP_SEGMENT)
+
   /// Compare two protocols for equality.
   friend bool operator==(const udp& p1, const udp& p2)
   {
@@ -22,6 +22,7 @@
 #include <cstddef>
 #include <string>
 #include <boost/asio/async_result.hpp>
+#include <boost/asio/basic_ring_buffer.hpp>
 #include <boost/asio/basic_streambuf.hpp>
 #include <boost/asio/detail/regex_fwd.hpp>
 #include <boost/asio/detail/type_traits.hpp>
@@ -246,6 +247,116 @@ std::size_t read_until(SyncReadStream& s,
     boost::asio::basic_streambuf<Allocator>& b, const std::string& delim,
     boost::system::error_code& ec);
 
+/// Read data into a ring buffer until it contains a specified delimiter.
+/**
+ * This function is used to read data into the specified ring buffer until the
+ * ring buffer's input sequence contains the specified delimiter. The call will
+ * block until one of the following conditions is true:
+ *
+ * @li The input sequence of the ring buffer contains the specified delimiter.
+ *
+ * @li An error occurred.
+ *
+ * This operation is implemented in terms of zero or more calls to the stream's
+ * read_some function. The search for the delimiter resumes from where the
+ * previous search stopped, so each byte is examined only once.
+ *
+ * @param s The stream from which the data is to be read. The type must support
+ * the SyncReadStream concept.
+ *
+ * @param b A ring buffer object into which the data will be read.
+ *
+ * @param delim The delimiter character.
+ *
+ * @returns The number of bytes in the ring buffer's input sequence up to and
+ * including the delimiter.
+ *
+ * @throws boost::system::system_error Thrown on failure.
+ */
+template <typename SyncReadStream, typename Allocator>
+std::size_t read_until(SyncReadStream& s,
+    boost::asio::basic_ring_buffer<Allocator>& b, char delim);
+
+/// Read data into a ring buffer until it contains a specified delimiter.
+/**
+ * This function is used to read data into the specified ring buffer until the
+ * ring buffer's input sequence contains the specified delimiter. The call will
+ * block until one of the following conditions is true:
+ *
+ * @li The input sequence of the ring buffer contains the specified delimiter.
+ *
+ * @li An error occurred.
+ *
+ * @param s The stream from which the data is to be read. The type must support
+ * the SyncReadStream concept.
+ *
+ * @param b A ring buffer object into which the data will be read.
+ *
+ * @param delim The delimiter character.
+ *
+ * @param ec Set to indicate what error occurred, if any.
+ *
+ * @returns The number of bytes in the ring buffer's input sequence up to and
+ * including the delimiter. Returns 0 if an error occurred.
+ */
+template <typename SyncReadStream, typename Allocator>
+std::size_t read_until(SyncReadStream& s,
+    boost::asio::basic_ring_buffer<Allocator>& b, char delim,
+    boost::system::error_code& ec);
+
+/// Read data into a ring buffer until it contains a specified delimiter.
+/**
+ * This function is used to read data into the specified ring buffer until the
+ * ring buffer's input sequence contains the specified delimiter. The call will
+ * block until one of the following conditions is true:
+ *
+ * @li The input sequence of the ring buffer contains the specified delimiter.
+ *
+ * @li An error occurred.
+ *
+ * @param s The stream from which the data is to be read. The type must support
+ * the SyncReadStream concept.
+ *
+ * @param b A ring buffer object into which the data will be read.
+ *
+ * @param delim The delimiter string.
+ *
+ * @returns The number of bytes in the ring buffer's input sequence up to and
+ * including the delimiter.
+ *
+ * @throws boost::system::system_error Thrown on failure.
+ */
+template <typename SyncReadStream, typename Allocator>
+std::size_t read_until(SyncReadStream& s,
+    boost::asio::basic_ring_buffer<Allocator>& b, const std::string& delim);
+
+/// Read data into a ring buffer until it contains a specified delimiter.
+/**
+ * This function is used to read data into the specified ring buffer until the
+ * ring buffer's input sequence contains the specified delimiter. The call will
+ * block until one of the following conditions is true:
+ *
+ * @li The input sequence of the ring buffer contains the specified delimiter.
+ *
+ * @li An error occurred.
+ *
+ * @param s The stream from which the data is to be read. The type must support
+ * the SyncReadStream concept.
+ *
+ * @param b A ring buffer object into which the data will be read.
+ *
+ * @param delim The delimiter string.
+ *
+ * @param ec Set to indicate what error occurred, if any.
+ *
+ * @returns The number of bytes in the ring buffer's input sequence up to and
+ * including the delimiter. Returns 0 if an error occurred.
+ */
+template <typename SyncReadStream, typename Allocator>
+std::size_t read_until(SyncReadStream& s,
+    boost::asio::basic_ring_buffer<Allocator>& b, const std::string& delim,
+    boost::system::error_code& ec);
+
 #if defined(BOOST_ASIO_HAS_BOOST_REGEX) \
   || defined(GENERATING_DOCUMENTATION)
 
@@ -684,6 +795,103 @@ async_read_until(AsyncReadStream& s,
     boost::asio::basic_streambuf<Allocator>& b, const std::string& delim,
     BOOST_ASIO_MOVE_ARG(ReadHandler) handler);
 
+/// Start an asynchronous operation to read data into a ring buffer until it
+/// contains a specified delimiter.
+/**
+ * This function is used to asynchronously read data into the specified ring
+ * buffer until the ring buffer's input sequence contains the specified
+ * delimiter. The function call always returns immediately. The asynchronous
+ * operation will continue until one of the following conditions is true:
+ *
+ * @li The input sequence of the ring buffer contains the specified delimiter.
+ *
+ * @li An error occurred.
+ *
+ * This operation is implemented in terms of zero or more calls to the stream's
+ * async_read_some function, and is known as a <em>composed operation</em>.
+ * Each read fills the free space of the ring buffer without moving the data
+ * that it already contains, and the search for the delimiter resumes from
+ * where the previous search stopped. The program must ensure that the stream
+ * performs no other read operations until this operation completes.
+ *
+ * @param s The stream from which the data is to be read. The type must support
+ * the AsyncReadStream concept.
+ *
+ * @param b A ring buffer object into which the data will be read. Ownership of
+ * the ring buffer is retained by the caller, which must guarantee that it
+ * remains valid until the handler is called.
+ *
+ * @param delim The delimiter character.
+ *
+ * @param handler The handler to be called when the read operation completes.
+ * Copies will be made of the handler as required. The function signature of the
+ * handler must be:
+ * @code void handler(
+ *   // Result of operation.
+ *   const boost::system::error_code& error,
+ *
+ *   // The number of bytes in the ring buffer's input
+ *   // sequence up to and including the delimiter.
+ *   // 0 if an error occurred.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. Invocation of
+ * the handler will be performed in a manner equivalent to using
+ * boost::asio::io_service::post().
+ */
+template <typename AsyncReadStream, typename Allocator, typename ReadHandler>
+BOOST_ASIO_INITFN_RESULT_TYPE(ReadHandler,
+    void (boost::system::error_code, std::size_t))
+async_read_until(AsyncReadStream& s,
+    boost::asio::basic_ring_buffer<Allocator>& b,
+    char delim, BOOST_ASIO_MOVE_ARG(ReadHandler) handler);
+
+/// Start an asynchronous operation to read data into a ring buffer until it
+/// contains a specified delimiter.
+/**
+ * This function is used to asynchronously read data into the specified ring
+ * buffer until the ring buffer's input sequence contains the specified
+ * delimiter. The function call always returns immediately. The asynchronous
+ * operation will continue until one of the following conditions is true:
+ *
+ * @li The input sequence of the ring buffer contains the specified delimiter.
+ *
+ * @li An error occurred.
+ *
+ * @param s The stream from which the data is to be read. The type must support
+ * the AsyncReadStream concept.
+ *
+ * @param b A ring buffer object into which the data will be read. Ownership of
+ * the ring buffer is retained by the caller, which must guarantee that it
+ * remains valid until the handler is called.
+ *
+ * @param delim The delimiter string.
+ *
+ * @param handler The handler to be called when the read operation completes.
+ * Copies will be made of the handler as required. The function signature of the
+ * handler must be:
+ * @code void handler(
+ *   // Result of operation.
+ *   const boost::system::error_code& error,
+ *
+ *   // The number of bytes in the ring buffer's input
+ *   // sequence up to and including the delimiter.
+ *   // 0 if an error occurred.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. Invocation of
+ * the handler will be performed in a manner equivalent to using
+ * boost::asio::io_service::post().
+ */
+template <typename AsyncReadStream, typename Allocator, typename ReadHandler>
+BOOST_ASIO_INITFN_RESULT_TYPE(ReadHandler,
+    void (boost::system::error_code, std::size_t))
+async_read_until(AsyncReadStream& s,
+    boost::asio::basic_ring_buffer<Allocator>& b, const std::string& delim,
+    BOOST_ASIO_MOVE_ARG(ReadHandler) handler);
+
 #if defined(BOOST_ASIO_HAS_BOOST_REGEX) \
   || defined(GENERATING_DOCUMENTATION)
 
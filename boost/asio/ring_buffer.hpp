@@ -0,0 +1,30 @@
+//
+// ring_buffer.hpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_RING_BUFFER_HPP
+#define BOOST_ASIO_RING_BUFFER_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/basic_ring_buffer.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Typedef for the typical usage of basic_ring_buffer.
+typedef basic_ring_buffer<> ring_buffer;
+
+} // namespace asio
+} // namespace boost
+
+#endif // BOOST_ASIO_RING_BUFFER_HPP
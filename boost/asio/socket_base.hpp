@@ -76,6 +76,20 @@ public:
       message_end_of_record = boost::asio::detail::message_end_of_record);
 #endif
 
+#if defined(GENERATING_DOCUMENTATION)
+  /// Send the data without copying it into the kernel. Used with
+  /// @c async_send, the handler is not invoked until the kernel has released
+  /// the buffers, so they may then be reused. Later sends on the socket may
+  /// start before then. If the socket does not have the zero_copy option
+  /// enabled, or the flag is passed to any other send operation, the flag is
+  /// ignored and the data is copied as for a normal send. Only supported on
+  /// Linux.
+  static const int message_zero_copy = implementation_defined;
+#elif defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+  BOOST_ASIO_STATIC_CONSTANT(int,
+      message_zero_copy = boost::asio::detail::message_zero_copy);
+#endif
+
   /// Socket option to permit sending of broadcast messages.
   /**
    * Implements the SOL_SOCKET/SO_BROADCAST socket option.
@@ -446,6 +460,86 @@ public:
     enable_connection_aborted;
 #endif
 
+#if defined(GENERATING_DOCUMENTATION) || defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+  /// Socket option to allow data to be sent without copying.
+  /**
+   * Implements the SOL_SOCKET/SO_ZEROCOPY socket option. The option must be
+   * set on the socket object, using @c set_option, before the
+   * message_zero_copy flag is passed to @c async_send.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * boost::asio::ip::tcp::socket socket(io_service); 
+   * ...
+   * boost::asio::socket_base::zero_copy option(true);
+   * socket.set_option(option);
+   * socket.async_send(boost::asio::buffer(data, size),
+   *     boost::asio::socket_base::message_zero_copy, handler);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * boost::asio::ip::tcp::socket socket(io_service); 
+   * ...
+   * boost::asio::socket_base::zero_copy option;
+   * socket.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined zero_copy;
+#else
+  typedef boost::asio::detail::socket_option::boolean<
+    SOL_SOCKET, boost::asio::detail::zero_copy_option> zero_copy;
+#endif
+#endif // defined(GENERATING_DOCUMENTATION)
+       //   || defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+#if defined(GENERATING_DOCUMENTATION) || defined(BOOST_ASIO_HAS_SO_REUSEPORT)
+  /// Socket option to allow several sockets to be bound to the same address
+  /// and port.
+  /**
+   * Implements the SOL_SOCKET/SO_REUSEPORT socket option. When every acceptor
+   * bound to an endpoint sets this option before binding, incoming
+   * connections are distributed between them by the kernel. Only supported
+   * on Linux.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * boost::asio::ip::tcp::acceptor acceptor(io_service); 
+   * ...
+   * boost::asio::socket_base::reuse_port option(true);
+   * acceptor.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * boost::asio::ip::tcp::acceptor acceptor(io_service); 
+   * ...
+   * boost::asio::socket_base::reuse_port option;
+   * acceptor.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined reuse_port;
+#else
+  typedef boost::asio::detail::socket_option::boolean<
+    SOL_SOCKET, boost::asio::detail::reuse_port_option> reuse_port;
+#endif
+#endif // defined(GENERATING_DOCUMENTATION)
+       //   || defined(BOOST_ASIO_HAS_SO_REUSEPORT)
+
   /// (Deprecated: Use non_blocking().) IO control command to
   /// set the blocking mode of the socket.
   /**
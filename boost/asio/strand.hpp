@@ -97,6 +97,20 @@ public:
     service_.construct(impl_);
   }
 
+  /// Copy constructor.
+  /**
+   * Constructs a strand that refers to the same underlying strand as
+   * @c other. Handlers submitted through either object are not executed
+   * concurrently with each other.
+   *
+   * @param other The strand to be copied.
+   */
+  strand(const strand& other)
+    : service_(other.service_)
+  {
+    service_.copy_construct(impl_, other.impl_);
+  }
+
   /// Destructor.
   /**
    * Destroys a strand.
@@ -106,6 +120,29 @@ public:
    */
   ~strand()
   {
+    service_.destroy(impl_);
+  }
+
+  /// Set the number of strand implementations shared within an io_service.
+  /**
+   * By default, strands are hashed into a fixed pool of implementations, so
+   * two unrelated strands may serialise against each other. This function
+   * changes the number of pool entries that are used for strands constructed
+   * after the call. The value is limited to the size of the pool, which is
+   * set by the @c BOOST_ASIO_STRAND_IMPLEMENTATIONS macro.
+   *
+   * A value of 0 disables the pool, so that each new strand and its copies
+   * own an implementation of their own. The pool may also be disabled by
+   * defining @c BOOST_ASIO_DISABLE_STRAND_POOL.
+   *
+   * @param io_service The io_service object whose strands are affected.
+   *
+   * @param n The number of pool entries to use.
+   */
+  static void set_pool_size(boost::asio::io_service& io_service, std::size_t n)
+  {
+    boost::asio::use_service<
+      boost::asio::detail::strand_service>(io_service).set_pool_size(n);
   }
 
   /// Get the io_service associated with the strand.
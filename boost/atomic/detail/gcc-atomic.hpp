@@ -832,207 +832,101 @@ private:
 
 #if defined(BOOST_ATOMIC_INT128_LOCK_FREE) && BOOST_ATOMIC_INT128_LOCK_FREE > 0
 
-template<typename T, bool Sign>
-class base_atomic<T, int, 16, Sign>
+// 16-byte __atomic builtins are not expanded inline by all compilers, even when cmpxchg16b is available.
+// Recent gcc versions emit calls to libatomic instead, which means that the program has to be linked with -latomic
+// and __atomic_is_lock_free reports false. To get a native implementation everywhere, the 128-bit atomics are built
+// on top of cmpxchg16b directly. The instruction is always locked and thus acts as a full barrier, so the fences
+// only have to prevent compiler reordering.
+
+BOOST_FORCEINLINE void
+platform_fence_before(memory_order order) BOOST_NOEXCEPT
 {
-private:
-    typedef base_atomic this_type;
-    typedef T value_type;
-    typedef T difference_type;
-
-protected:
-    typedef value_type value_arg_type;
-
-public:
-    BOOST_DEFAULTED_FUNCTION(base_atomic(void), {})
-    BOOST_CONSTEXPR explicit base_atomic(value_type v) BOOST_NOEXCEPT : v_(v) {}
-
-    void store(value_type v, memory_order order = memory_order_seq_cst) volatile BOOST_NOEXCEPT
-    {
-        __atomic_store_n(&v_, v, atomics::detail::convert_memory_order_to_gcc(order));
-    }
-
-    value_type load(memory_order order = memory_order_seq_cst) const volatile BOOST_NOEXCEPT
-    {
-        return __atomic_load_n(&v_, atomics::detail::convert_memory_order_to_gcc(order));
-    }
-
-    value_type fetch_add(difference_type v, memory_order order = memory_order_seq_cst) volatile BOOST_NOEXCEPT
-    {
-        return __atomic_fetch_add(&v_, v, atomics::detail::convert_memory_order_to_gcc(order));
-    }
-
-    value_type fetch_sub(difference_type v, memory_order order = memory_order_seq_cst) volatile BOOST_NOEXCEPT
-    {
-        return __atomic_fetch_sub(&v_, v, atomics::detail::convert_memory_order_to_gcc(order));
-    }
-
-    value_type exchange(value_type v, memory_order order = memory_order_seq_cst) volatile BOOST_NOEXCEPT
-    {
-        return __atomic_exchange_n(&v_, v, atomics::detail::convert_memory_order_to_gcc(order));
-    }
-
-    bool compare_exchange_strong(
-        value_type& expected,
-        value_type desired,
-        memory_order success_order,
-        memory_order failure_order) volatile BOOST_NOEXCEPT
-    {
-        return __atomic_compare_exchange_n(&v_, &expected, desired, false,
-            atomics::detail::convert_memory_order_to_gcc(success_order),
-            atomics::detail::convert_memory_order_to_gcc(failure_order));
-    }
-
-    bool compare_exchange_weak(
-        value_type& expected,
-        value_type desired,
-        memory_order success_order,
-        memory_order failure_order) volatile BOOST_NOEXCEPT
-    {
-        return __atomic_compare_exchange_n(&v_, &expected, desired, true,
-            atomics::detail::convert_memory_order_to_gcc(success_order),
-            atomics::detail::convert_memory_order_to_gcc(failure_order));
-    }
-
-    value_type fetch_and(value_type v, memory_order order = memory_order_seq_cst) volatile BOOST_NOEXCEPT
-    {
-        return __atomic_fetch_and(&v_, v, atomics::detail::convert_memory_order_to_gcc(order));
-    }
-
-    value_type fetch_or(value_type v, memory_order order = memory_order_seq_cst) volatile BOOST_NOEXCEPT
-    {
-        return __atomic_fetch_or(&v_, v, atomics::detail::convert_memory_order_to_gcc(order));
-    }
-
-    value_type fetch_xor(value_type v, memory_order order = memory_order_seq_cst) volatile BOOST_NOEXCEPT
-    {
-        return __atomic_fetch_xor(&v_, v, atomics::detail::convert_memory_order_to_gcc(order));
-    }
-
-    bool is_lock_free(void) const volatile BOOST_NOEXCEPT
-    {
-        return __atomic_is_lock_free(sizeof(v_), &v_);
-    }
-
-    BOOST_ATOMIC_DECLARE_INTEGRAL_OPERATORS
-
-    BOOST_DELETED_FUNCTION(base_atomic(base_atomic const&))
-    BOOST_DELETED_FUNCTION(base_atomic& operator=(base_atomic const&))
-
-private:
-    value_type v_;
-};
-
-#if defined(BOOST_HAS_INT128)
-
-typedef boost::uint128_type storage128_type;
-
-#else // defined(BOOST_HAS_INT128)
+    if (order != memory_order_relaxed)
+        __atomic_signal_fence(__ATOMIC_SEQ_CST);
+}
 
-struct BOOST_ALIGNMENT(16) storage128_type
+BOOST_FORCEINLINE void
+platform_fence_after(memory_order order) BOOST_NOEXCEPT
 {
-    uint64_t data[2];
-};
+    if (order != memory_order_relaxed)
+        __atomic_signal_fence(__ATOMIC_SEQ_CST);
+}
 
-inline bool operator== (storage128_type const& left, storage128_type const& right)
+BOOST_FORCEINLINE void
+platform_fence_before_store(memory_order order) BOOST_NOEXCEPT
 {
-    return left.data[0] == right.data[0] && left.data[1] == right.data[1];
+    platform_fence_before(order);
 }
-inline bool operator!= (storage128_type const& left, storage128_type const& right)
+
+BOOST_FORCEINLINE void
+platform_fence_after_store(memory_order order) BOOST_NOEXCEPT
 {
-    return !(left == right);
+    platform_fence_after(order);
 }
 
-#endif // defined(BOOST_HAS_INT128)
-
-template<typename T, bool Sign>
-class base_atomic<T, void, 16, Sign>
+BOOST_FORCEINLINE void
+platform_fence_after_load(memory_order order) BOOST_NOEXCEPT
 {
-private:
-    typedef base_atomic this_type;
-    typedef T value_type;
-    typedef storage128_type storage_type;
-
-protected:
-    typedef value_type const& value_arg_type;
-
-public:
-    BOOST_DEFAULTED_FUNCTION(base_atomic(void), {})
-    explicit base_atomic(value_type const& v) BOOST_NOEXCEPT : v_(0)
-    {
-        memcpy(&v_, &v, sizeof(value_type));
-    }
-
-    void store(value_type const& v, memory_order order = memory_order_seq_cst) volatile BOOST_NOEXCEPT
-    {
-        storage_type tmp = 0;
-        memcpy(&tmp, &v, sizeof(value_type));
-        __atomic_store_n(&v_, tmp, atomics::detail::convert_memory_order_to_gcc(order));
-    }
-
-    value_type load(memory_order order = memory_order_seq_cst) const volatile BOOST_NOEXCEPT
-    {
-        storage_type tmp = __atomic_load_n(&v_, atomics::detail::convert_memory_order_to_gcc(order));
-        value_type v;
-        memcpy(&v, &tmp, sizeof(value_type));
-        return v;
-    }
-
-    value_type exchange(value_type const& v, memory_order order = memory_order_seq_cst) volatile BOOST_NOEXCEPT
-    {
-        storage_type tmp = 0;
-        memcpy(&tmp, &v, sizeof(value_type));
-        tmp = __atomic_exchange_n(&v_, tmp, atomics::detail::convert_memory_order_to_gcc(order));
-        value_type res;
-        memcpy(&res, &tmp, sizeof(value_type));
-        return res;
-    }
-
-    bool compare_exchange_strong(
-        value_type& expected,
-        value_type const& desired,
-        memory_order success_order,
-        memory_order failure_order) volatile BOOST_NOEXCEPT
-    {
-        storage_type expected_s = 0, desired_s = 0;
-        memcpy(&expected_s, &expected, sizeof(value_type));
-        memcpy(&desired_s, &desired, sizeof(value_type));
-        const bool success = __atomic_compare_exchange_n(&v_, &expected_s, desired_s, false,
-            atomics::detail::convert_memory_order_to_gcc(success_order),
-            atomics::detail::convert_memory_order_to_gcc(failure_order));
-        memcpy(&expected, &expected_s, sizeof(value_type));
-        return success;
-    }
-
-    bool compare_exchange_weak(
-        value_type& expected,
-        value_type const& desired,
-        memory_order success_order,
-        memory_order failure_order) volatile BOOST_NOEXCEPT
-    {
-        storage_type expected_s = 0, desired_s = 0;
-        memcpy(&expected_s, &expected, sizeof(value_type));
-        memcpy(&desired_s, &desired, sizeof(value_type));
-        const bool success = __atomic_compare_exchange_n(&v_, &expected_s, desired_s, true,
-            atomics::detail::convert_memory_order_to_gcc(success_order),
-            atomics::detail::convert_memory_order_to_gcc(failure_order));
-        memcpy(&expected, &expected_s, sizeof(value_type));
-        return success;
-    }
-
-    bool is_lock_free(void) const volatile BOOST_NOEXCEPT
-    {
-        return __atomic_is_lock_free(sizeof(v_), &v_);
-    }
+    platform_fence_after(order);
+}
 
-    BOOST_ATOMIC_DECLARE_BASE_OPERATORS
+template<typename T>
+inline bool
+platform_cmpxchg128_strong(T& expected, T desired, volatile T* ptr) BOOST_NOEXCEPT
+{
+    uint64_t expected_s[2], desired_s[2];
+    memcpy(expected_s, &expected, sizeof(expected_s));
+    memcpy(desired_s, &desired, sizeof(desired_s));
+    bool success;
+    __asm__ __volatile__
+    (
+        "lock; cmpxchg16b %[dest]\n\t"
+        "sete %[success]"
+        : "+a" (expected_s[0]), "+d" (expected_s[1]), [dest] "+m" (*ptr), [success] "=q" (success)
+        : "b" (desired_s[0]), "c" (desired_s[1])
+        : "memory", "cc"
+    );
+    memcpy(&expected, expected_s, sizeof(expected_s));
+    return success;
+}
 
-    BOOST_DELETED_FUNCTION(base_atomic(base_atomic const&))
-    BOOST_DELETED_FUNCTION(base_atomic& operator=(base_atomic const&))
+template<typename T>
+inline void
+platform_store128(T value, volatile T* ptr) BOOST_NOEXCEPT
+{
+    uint64_t value_s[2];
+    memcpy(value_s, &value, sizeof(value_s));
+    // The initial guess of the current value does not matter, a failed cmpxchg16b loads the actual one.
+    uint64_t lo = 0, hi = 0;
+    __asm__ __volatile__
+    (
+        ".align 16\n\t"
+        "1: lock; cmpxchg16b %[dest]\n\t"
+        "jne 1b"
+        : "+a" (lo), "+d" (hi), [dest] "+m" (*ptr)
+        : "b" (value_s[0]), "c" (value_s[1])
+        : "memory", "cc"
+    );
+}
 
-private:
-    storage_type v_;
-};
+template<typename T>
+inline T
+platform_load128(const volatile T* ptr) BOOST_NOEXCEPT
+{
+    // If the value is zero, cmpxchg16b writes it back unchanged, otherwise it loads the value into rdx:rax.
+    // In both cases the result is the current value. Note that the memory must be writable.
+    uint64_t value_s[2] = { 0, 0 };
+    __asm__ __volatile__
+    (
+        "lock; cmpxchg16b %[dest]"
+        : "+a" (value_s[0]), "+d" (value_s[1]), [dest] "+m" (*const_cast< volatile T* >(ptr))
+        : "b" (static_cast< uint64_t >(0u)), "c" (static_cast< uint64_t >(0u))
+        : "memory", "cc"
+    );
+    T value;
+    memcpy(&value, value_s, sizeof(value_s));
+    return value;
+}
 
 #endif // defined(BOOST_ATOMIC_INT128_LOCK_FREE) && BOOST_ATOMIC_INT128_LOCK_FREE > 0
 
@@ -1199,6 +1093,11 @@ private:
 } // namespace atomics
 } // namespace boost
 
+/* pull in 128-bit atomic type using cmpxchg16b above */
+#if defined(BOOST_ATOMIC_INT128_LOCK_FREE) && BOOST_ATOMIC_INT128_LOCK_FREE > 0
+#include <boost/atomic/detail/cas128strong.hpp>
+#endif
+
 #endif // !defined(BOOST_ATOMIC_FORCE_FALLBACK)
 
 #endif // BOOST_ATOMIC_DETAIL_GCC_ATOMIC_HPP
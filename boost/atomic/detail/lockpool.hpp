@@ -49,28 +49,20 @@ private:
 class lockpool
 {
 public:
-    typedef atomic_flag lock_type;
-
     class scoped_lock
     {
     private:
-        atomic_flag& flag_;
+        void* lock_;
 
     public:
         explicit
-        scoped_lock(const volatile void * addr) : flag_(get_lock_for(addr))
+        scoped_lock(const volatile void * addr) : lock_(lock_for(addr))
         {
-            for (; flag_.test_and_set(memory_order_acquire);)
-            {
-#if defined(BOOST_ATOMIC_X86_PAUSE)
-                BOOST_ATOMIC_X86_PAUSE();
-#endif
-            }
         }
 
         ~scoped_lock(void)
         {
-            flag_.clear(memory_order_release);
+            unlock(lock_);
         }
 
         BOOST_DELETED_FUNCTION(scoped_lock(const scoped_lock &))
@@ -78,7 +70,10 @@ public:
     };
 
 private:
-    static BOOST_ATOMIC_DECL lock_type& get_lock_for(const volatile void * addr);
+    // Acquires the lock that guards the object at addr and returns an opaque handle to it.
+    // Contended locks are retried with exponential backoff before the thread blocks.
+    static BOOST_ATOMIC_DECL void* lock_for(const volatile void * addr);
+    static BOOST_ATOMIC_DECL void unlock(void* lock);
 };
 
 #endif
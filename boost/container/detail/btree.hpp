@@ -0,0 +1,1465 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2013. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_CONTAINER_BTREE_HPP
+#define BOOST_CONTAINER_BTREE_HPP
+
+#if (defined _MSC_VER) && (_MSC_VER >= 1200)
+#  pragma once
+#endif
+
+#include "config_begin.hpp"
+#include <boost/container/detail/workaround.hpp>
+
+#include <boost/container/container_fwd.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+#include <boost/move/utility.hpp>
+#include <boost/move/algorithm.hpp>
+#include <boost/intrusive/pointer_traits.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/aligned_storage.hpp>
+#include <boost/detail/no_exceptions_support.hpp>
+
+#include <boost/container/detail/utilities.hpp>
+#include <boost/container/detail/pair.hpp>
+#include <boost/container/detail/mpl.hpp>
+#include <boost/container/detail/destroyers.hpp>
+#include <boost/container/allocator_traits.hpp>
+
+#ifndef BOOST_CONTAINER_PERFECT_FORWARDING
+#include <boost/container/detail/preprocessor.hpp>
+#endif
+
+namespace boost {
+
+namespace container {
+
+namespace container_detail {
+
+template<class Compare, class Value, class KeyOfValue>
+class btree_value_compare
+   : private Compare
+{
+   typedef Value              first_argument_type;
+   typedef Value              second_argument_type;
+   typedef bool               return_type;
+   public:
+   btree_value_compare()
+      : Compare()
+   {}
+
+   btree_value_compare(const Compare &pred)
+      : Compare(pred)
+   {}
+
+   bool operator()(const Value& lhs, const Value& rhs) const
+   {
+      KeyOfValue key_extract;
+      return Compare::operator()(key_extract(lhs), key_extract(rhs));
+   }
+
+   const Compare &get_comp() const
+      {  return *this;  }
+
+   Compare &get_comp()
+      {  return *this;  }
+};
+
+template<class Value, class VoidPointer>
+struct btree_internal_node;
+
+//!A node of the btree. Values are stored in all nodes, and nodes with children
+//!(btree_internal_node) store max_values + 1 child pointers after the values.
+//!The values of a node are sized to a few cache lines, so that lookups only
+//!touch a few lines per level and the tree has a high fan-out.
+template<class Value, class VoidPointer>
+struct btree_node
+{
+   typedef typename boost::intrusive::pointer_traits<VoidPointer>::template
+      rebind_pointer<btree_node>::type                      node_ptr;
+   typedef btree_internal_node<Value, VoidPointer>          internal_node_type;
+
+   //Bytes used by a node without children: four 64 byte cache lines
+   static const std::size_t node_size = 256;
+   static const std::size_t header_size = sizeof(node_ptr) + 3*sizeof(unsigned short);
+   static const std::size_t fitting_values = (node_size - header_size)/sizeof(Value);
+   //Splitting and merging need at least three values per node
+   static const std::size_t max_values = fitting_values < 3u ? 3u : fitting_values;
+   static const std::size_t min_values = max_values/2;
+
+   node_ptr       m_parent;
+   //Index of this node in the children of m_parent
+   unsigned short m_position;
+   unsigned short m_count;
+   unsigned short m_leaf;
+   typename boost::aligned_storage
+      <sizeof(Value)*max_values, boost::alignment_of<Value>::value>::type m_values;
+
+   Value *values()
+   {  return static_cast<Value*>(static_cast<void*>(&m_values));  }
+
+   Value &value(std::size_t i)
+   {  return this->values()[i];  }
+
+   node_ptr &child(std::size_t i)
+   {  return static_cast<internal_node_type&>(*this).m_children[i];  }
+
+   //Advances (n, pos) to the next value in the tree
+   static void next(node_ptr &n, std::size_t &pos)
+   {
+      if(n->m_leaf){
+         if(++pos == n->m_count){
+            btree_node::ascend_to_next(n, pos);
+         }
+      }
+      else{
+         n = n->child(pos + 1);
+         while(!n->m_leaf){
+            n = n->child(0);
+         }
+         pos = 0;
+      }
+   }
+
+   //Moves (n, pos) to the previous value in the tree
+   static void prev(node_ptr &n, std::size_t &pos)
+   {
+      if(n->m_leaf){
+         if(pos){
+            --pos;
+            return;
+         }
+         node_ptr p = n;
+         std::size_t i = 0;
+         while(!i && p->m_parent){
+            i = p->m_position;
+            p = p->m_parent;
+         }
+         if(i){
+            n = p;
+            pos = i - 1;
+         }
+      }
+      else{
+         n = n->child(pos);
+         while(!n->m_leaf){
+            n = n->child(n->m_count);
+         }
+         pos = n->m_count - 1;
+      }
+   }
+
+   //pre: n is a leaf and pos == n->m_count.
+   //Moves (n, pos) to the first ancestor value that follows the leaf. If
+   //there is none n is the rightmost leaf, and (n, pos) is the end position.
+   static void ascend_to_next(node_ptr &n, std::size_t &pos)
+   {
+      node_ptr p = n;
+      std::size_t i = pos;
+      while(i == p->m_count && p->m_parent){
+         i = p->m_position;
+         p = p->m_parent;
+      }
+      if(i != p->m_count){
+         n = p;
+         pos = i;
+      }
+   }
+};
+
+template<class Value, class VoidPointer>
+const std::size_t btree_node<Value, VoidPointer>::max_values;
+
+template<class Value, class VoidPointer>
+const std::size_t btree_node<Value, VoidPointer>::min_values;
+
+template<class Value, class VoidPointer>
+struct btree_internal_node
+   : public btree_node<Value, VoidPointer>
+{
+   typedef btree_node<Value, VoidPointer>    base_t;
+   typename base_t::node_ptr m_children[base_t::max_values + 1];
+};
+
+//!Iterates the values of a btree in order. Value is the type seen by users, that
+//!has the same layout as the value stored in the nodes.
+template<class NodePtr, class Value, bool IsConst>
+class btree_iterator
+{
+   typedef typename boost::intrusive::pointer_traits<NodePtr>::element_type  node_type;
+
+   public:
+   typedef std::bidirectional_iterator_tag                                    iterator_category;
+   typedef Value                                                              value_type;
+   typedef typename boost::intrusive::pointer_traits<NodePtr>::difference_type difference_type;
+   typedef typename if_c
+      < IsConst
+      , typename boost::intrusive::pointer_traits<NodePtr>::template
+                                 rebind_pointer<const value_type>::type
+      , typename boost::intrusive::pointer_traits<NodePtr>::template
+                                 rebind_pointer<value_type>::type
+      >::type                                                                 pointer;
+   typedef typename if_c
+      < IsConst
+      , const value_type&
+      , value_type&
+      >::type                                                                 reference;
+
+   /// @cond
+   private:
+   NodePtr     m_node;
+   std::size_t m_pos;
+
+   public:
+   btree_iterator(const NodePtr &node, std::size_t pos) BOOST_CONTAINER_NOEXCEPT
+      : m_node(node), m_pos(pos)
+   {}
+
+   const NodePtr &get_node() const BOOST_CONTAINER_NOEXCEPT
+   {  return m_node;  }
+
+   std::size_t get_pos() const BOOST_CONTAINER_NOEXCEPT
+   {  return m_pos;  }
+   /// @endcond
+
+   public:
+
+   //Constructors
+   btree_iterator() BOOST_CONTAINER_NOEXCEPT
+      : m_node(), m_pos()
+   {}
+
+   //A template is never a copy constructor, so both iterators keep their
+   //implicit copy constructor and assignment
+   template<bool OtherIsConst>
+   btree_iterator(btree_iterator<NodePtr, Value, OtherIsConst> const& other
+                 ,typename enable_if_c<IsConst && !OtherIsConst>::type* = 0) BOOST_CONTAINER_NOEXCEPT
+      :  m_node(other.get_node()), m_pos(other.get_pos())
+   {}
+
+   //Pointer like operators
+   reference operator*()   const BOOST_CONTAINER_NOEXCEPT
+   {
+      return static_cast<value_type*>(static_cast<void*>
+         (container_detail::to_raw_pointer(m_node)->values()))[m_pos];
+   }
+
+   pointer operator->()  const BOOST_CONTAINER_NOEXCEPT
+   {  return ::boost::intrusive::pointer_traits<pointer>::pointer_to(this->operator*());  }
+
+   //Increment / Decrement
+   btree_iterator& operator++() BOOST_CONTAINER_NOEXCEPT
+   {  node_type::next(m_node, m_pos);  return *this; }
+
+   btree_iterator operator++(int) BOOST_CONTAINER_NOEXCEPT
+   {  btree_iterator tmp(*this);  ++*this;  return tmp;  }
+
+   btree_iterator& operator--() BOOST_CONTAINER_NOEXCEPT
+   {  node_type::prev(m_node, m_pos);  return *this; }
+
+   btree_iterator operator--(int) BOOST_CONTAINER_NOEXCEPT
+   {  btree_iterator tmp(*this);  --*this;  return tmp;  }
+
+   //Comparison operators
+   friend bool operator==(const btree_iterator& l, const btree_iterator& r) BOOST_CONTAINER_NOEXCEPT
+   {  return l.m_node == r.m_node && l.m_pos == r.m_pos;  }
+
+   friend bool operator!=(const btree_iterator& l, const btree_iterator& r) BOOST_CONTAINER_NOEXCEPT
+   {  return !(l == r);  }
+};
+
+template <class Key, class Value, class KeyOfValue,
+          class Compare, class A>
+class btree
+{
+   typedef boost::container::allocator_traits<A>                  allocator_traits_type;
+   typedef typename allocator_traits_type::void_pointer           void_pointer;
+   typedef btree_node<Value, void_pointer>                        node_type;
+   typedef btree_internal_node<Value, void_pointer>               internal_node_type;
+   typedef typename allocator_traits_type::template
+      portable_rebind_alloc<node_type>::type                      leaf_allocator_type;
+   typedef typename allocator_traits_type::template
+      portable_rebind_alloc<internal_node_type>::type             internal_allocator_type;
+   typedef boost::container::allocator_traits
+      <leaf_allocator_type>                                       leaf_allocator_traits;
+   typedef boost::container::allocator_traits
+      <internal_allocator_type>                                   internal_allocator_traits;
+
+   public:
+   typedef btree_value_compare<Compare, Value, KeyOfValue>        value_compare;
+   //Obtained without instantiating node_type, so that Value can be incomplete
+   typedef typename boost::intrusive::pointer_traits<void_pointer>::template
+      rebind_pointer<node_type>::type                             node_ptr;
+
+   private:
+   struct Data
+      //Inherit from value_compare and A to do EBO
+      : public value_compare, public A
+   {
+      Data()
+         : value_compare(), A(), m_root(), m_leftmost(), m_rightmost(), m_size()
+      {}
+
+      explicit Data(const Compare &comp)
+         : value_compare(comp), A(), m_root(), m_leftmost(), m_rightmost(), m_size()
+      {}
+
+      Data(const Compare &comp, const A &alloc)
+         : value_compare(comp), A(alloc), m_root(), m_leftmost(), m_rightmost(), m_size()
+      {}
+
+      explicit Data(const A &alloc)
+         : value_compare(), A(alloc), m_root(), m_leftmost(), m_rightmost(), m_size()
+      {}
+
+      Data(const Compare &comp, BOOST_RV_REF(A) alloc)
+         : value_compare(comp), A(boost::move(alloc)), m_root(), m_leftmost(), m_rightmost(), m_size()
+      {}
+
+      void swap_nodes(Data &d)
+      {
+         boost::container::swap_dispatch(m_root, d.m_root);
+         boost::container::swap_dispatch(m_leftmost, d.m_leftmost);
+         boost::container::swap_dispatch(m_rightmost, d.m_rightmost);
+         boost::container::swap_dispatch(m_size, d.m_size);
+      }
+
+      node_ptr                                        m_root;
+      //The first and last leaves, for begin() and end()
+      node_ptr                                        m_leftmost;
+      node_ptr                                        m_rightmost;
+      typename allocator_traits_type::size_type       m_size;
+   };
+
+   Data m_data;
+   BOOST_COPYABLE_AND_MOVABLE(btree)
+
+   public:
+
+   typedef Value                                                  value_type;
+   typedef typename allocator_traits_type::pointer                pointer;
+   typedef typename allocator_traits_type::const_pointer          const_pointer;
+   typedef typename allocator_traits_type::reference              reference;
+   typedef typename allocator_traits_type::const_reference        const_reference;
+   typedef Key                                                    key_type;
+   typedef Compare                                                key_compare;
+   typedef A                                                      allocator_type;
+   typedef typename allocator_traits_type::size_type              size_type;
+   typedef typename allocator_traits_type::difference_type        difference_type;
+   typedef btree_iterator<node_ptr, Value, false>                 iterator;
+   typedef btree_iterator<node_ptr, Value, true>                  const_iterator;
+   typedef std::reverse_iterator<iterator>                        reverse_iterator;
+   typedef std::reverse_iterator<const_iterator>                  const_reverse_iterator;
+
+   //!Standard extension
+   typedef allocator_type                                         stored_allocator_type;
+
+   private:
+   typedef allocator_traits<stored_allocator_type> stored_allocator_traits;
+
+   public:
+   btree()
+      : m_data()
+   { }
+
+   explicit btree(const Compare& comp)
+      : m_data(comp)
+   { }
+
+   btree(const Compare& comp, const allocator_type& a)
+      : m_data(comp, a)
+   { }
+
+   explicit btree(const allocator_type& a)
+      : m_data(a)
+   { }
+
+   btree(const btree& x)
+      :  m_data( x.m_data.get_comp()
+               , allocator_traits_type::select_on_container_copy_construction(x.get_stored_allocator()))
+   {  this->priv_copy_from(x);  }
+
+   btree(BOOST_RV_REF(btree) x)
+      :  m_data(x.m_data.get_comp(), boost::move(x.get_stored_allocator()))
+   {  this->m_data.swap_nodes(x.m_data);  }
+
+   btree(const btree& x, const allocator_type &a)
+      :  m_data(x.m_data.get_comp(), a)
+   {  this->priv_copy_from(x);  }
+
+   btree(BOOST_RV_REF(btree) x, const allocator_type &a)
+      :  m_data(x.m_data.get_comp(), a)
+   {
+      if(this->get_stored_allocator() == x.get_stored_allocator()){
+         this->m_data.swap_nodes(x.m_data);
+      }
+      else{
+         this->priv_move_from(x);
+      }
+   }
+
+   template <class InputIterator>
+   btree( ordered_range_t, InputIterator first, InputIterator last
+        , const Compare& comp     = Compare()
+        , const allocator_type& a = allocator_type())
+      : m_data(comp, a)
+   {
+      BOOST_TRY{
+         this->insert_equal(ordered_range, first, last);
+      }
+      BOOST_CATCH(...){
+         this->clear();
+         BOOST_RETHROW
+      }
+      BOOST_CATCH_END
+   }
+
+   template <class InputIterator>
+   btree( bool unique_insertion
+        , InputIterator first, InputIterator last
+        , const Compare& comp     = Compare()
+        , const allocator_type& a = allocator_type())
+      : m_data(comp, a)
+   {
+      BOOST_TRY{
+         if(unique_insertion){
+            this->insert_unique(first, last);
+         }
+         else{
+            this->insert_equal(first, last);
+         }
+      }
+      BOOST_CATCH(...){
+         this->clear();
+         BOOST_RETHROW
+      }
+      BOOST_CATCH_END
+   }
+
+   ~btree()
+   {  this->clear();  }
+
+   btree&  operator=(BOOST_COPY_ASSIGN_REF(btree) x)
+   {
+      if (&x != this){
+         this->clear();
+         container_detail::bool_<allocator_traits_type::
+            propagate_on_container_copy_assignment::value> flag;
+         container_detail::assign_alloc(this->get_stored_allocator(), x.get_stored_allocator(), flag);
+         this->m_data.get_comp() = x.m_data.get_comp();
+         this->priv_copy_from(x);
+      }
+      return *this;
+   }
+
+   btree&  operator=(BOOST_RV_REF(btree) x)
+   {
+      if (&x != this){
+         this->clear();
+         this->m_data.get_comp() = boost::move(x.m_data.get_comp());
+         //If allocators are equal we can just swap pointers
+         if(this->get_stored_allocator() == x.get_stored_allocator()){
+            this->m_data.swap_nodes(x.m_data);
+            container_detail::bool_<allocator_traits_type::
+               propagate_on_container_move_assignment::value> flag;
+            container_detail::move_alloc(this->get_stored_allocator(), x.get_stored_allocator(), flag);
+         }
+         //If unequal allocators, then do a one by one move
+         else{
+            this->priv_move_from(x);
+         }
+      }
+      return *this;
+   }
+
+   public:
+   // accessors:
+   Compare key_comp() const
+   { return this->m_data.get_comp(); }
+
+   allocator_type get_allocator() const
+   { return this->m_data; }
+
+   const stored_allocator_type &get_stored_allocator() const
+   {  return this->m_data; }
+
+   stored_allocator_type &get_stored_allocator()
+   {  return this->m_data; }
+
+   iterator begin()
+   { return iterator(this->m_data.m_leftmost, 0); }
+
+   const_iterator begin() const
+   { return this->cbegin(); }
+
+   const_iterator cbegin() const
+   { return const_iterator(this->m_data.m_leftmost, 0); }
+
+   iterator end()
+   { return iterator(this->m_data.m_rightmost, this->priv_rightmost_count()); }
+
+   const_iterator end() const
+   { return this->cend(); }
+
+   const_iterator cend() const
+   { return const_iterator(this->m_data.m_rightmost, this->priv_rightmost_count()); }
+
+   reverse_iterator rbegin()
+   { return reverse_iterator(this->end()); }
+
+   const_reverse_iterator rbegin() const
+   {  return this->crbegin();  }
+
+   const_reverse_iterator crbegin() const
+   {  return const_reverse_iterator(this->cend());  }
+
+   reverse_iterator rend()
+   { return reverse_iterator(this->begin()); }
+
+   const_reverse_iterator rend() const
+   { return this->crend(); }
+
+   const_reverse_iterator crend() const
+   { return const_reverse_iterator(this->cbegin()); }
+
+   bool empty() const
+   { return !this->m_data.m_size; }
+
+   size_type size() const
+   { return this->m_data.m_size; }
+
+   size_type max_size() const
+   { return stored_allocator_traits::max_size(this->m_data); }
+
+   void swap(btree& x)
+   {
+      value_compare& mycomp = this->m_data, & othercomp = x.m_data;
+      boost::container::swap_dispatch(mycomp, othercomp);
+      this->m_data.swap_nodes(x.m_data);
+      container_detail::bool_<allocator_traits_type::
+         propagate_on_container_swap::value> flag;
+      container_detail::swap_alloc(this->get_stored_allocator(), x.get_stored_allocator(), flag);
+   }
+
+   public:
+   // insert/erase
+   std::pair<iterator,bool> insert_unique(const value_type& val)
+   {  return this->priv_insert_unique(val);  }
+
+   std::pair<iterator,bool> insert_unique(BOOST_RV_REF(value_type) val)
+   {  return this->priv_insert_unique(boost::move(val));  }
+
+   iterator insert_equal(const value_type& val)
+   {  return this->priv_insert_equal(val);  }
+
+   iterator insert_equal(BOOST_RV_REF(value_type) mval)
+   {  return this->priv_insert_equal(boost::move(mval));  }
+
+   iterator insert_unique(const_iterator pos, const value_type& val)
+   {  return this->priv_insert_unique(pos, val);  }
+
+   iterator insert_unique(const_iterator pos, BOOST_RV_REF(value_type) val)
+   {  return this->priv_insert_unique(pos, boost::move(val));  }
+
+   iterator insert_equal(const_iterator pos, const value_type& val)
+   {  return this->priv_insert_equal(pos, val);  }
+
+   iterator insert_equal(const_iterator pos, BOOST_RV_REF(value_type) mval)
+   {  return this->priv_insert_equal(pos, boost::move(mval));  }
+
+   //Values are inserted with end() as hint, so sorted ranges
+   //only need a comparison with the last value to be appended
+   template <class InIt>
+   void insert_unique(InIt first, InIt last)
+   {
+      for ( ; first != last; ++first){
+         this->insert_unique(this->cend(), *first);
+      }
+   }
+
+   template <class InIt>
+   void insert_equal(InIt first, InIt last)
+   {
+      for ( ; first != last; ++first){
+         this->insert_equal(this->cend(), *first);
+      }
+   }
+
+   //Ordered
+   template <class InIt>
+   void insert_equal(ordered_range_t, InIt first, InIt last)
+   {  this->insert_equal(first, last);  }
+
+   template <class InIt>
+   void insert_unique(ordered_unique_range_t, InIt first, InIt last)
+   {  this->insert_unique(first, last);  }
+
+   #ifdef BOOST_CONTAINER_PERFECT_FORWARDING
+
+   template <class... Args>
+   std::pair<iterator, bool> emplace_unique(Args&&... args)
+   {
+      aligned_storage<sizeof(value_type), alignment_of<value_type>::value> v;
+      value_type &val = *static_cast<value_type *>(static_cast<void *>(&v));
+      stored_allocator_type &a = this->get_stored_allocator();
+      stored_allocator_traits::construct(a, &val, ::boost::forward<Args>(args)... );
+      value_destructor<stored_allocator_type> d(a, val);
+      return this->insert_unique(::boost::move(val));
+   }
+
+   template <class... Args>
+   iterator emplace_hint_unique(const_iterator hint, Args&&... args)
+   {
+      aligned_storage<sizeof(value_type), alignment_of<value_type>::value> v;
+      value_type &val = *static_cast<value_type *>(static_cast<void *>(&v));
+      stored_allocator_type &a = this->get_stored_allocator();
+      stored_allocator_traits::construct(a, &val, ::boost::forward<Args>(args)... );
+      value_destructor<stored_allocator_type> d(a, val);
+      return this->insert_unique(hint, ::boost::move(val));
+   }
+
+   template <class... Args>
+   iterator emplace_equal(Args&&... args)
+   {
+      aligned_storage<sizeof(value_type), alignment_of<value_type>::value> v;
+      value_type &val = *static_cast<value_type *>(static_cast<void *>(&v));
+      stored_allocator_type &a = this->get_stored_allocator();
+      stored_allocator_traits::construct(a, &val, ::boost::forward<Args>(args)... );
+      value_destructor<stored_allocator_type> d(a, val);
+      return this->insert_equal(::boost::move(val));
+   }
+
+   template <class... Args>
+   iterator emplace_hint_equal(const_iterator hint, Args&&... args)
+   {
+      aligned_storage<sizeof(value_type), alignment_of<value_type>::value> v;
+      value_type &val = *static_cast<value_type *>(static_cast<void *>(&v));
+      stored_allocator_type &a = this->get_stored_allocator();
+      stored_allocator_traits::construct(a, &val, ::boost::forward<Args>(args)... );
+      value_destructor<stored_allocator_type> d(a, val);
+      return this->insert_equal(hint, ::boost::move(val));
+   }
+
+   #else //#ifdef BOOST_CONTAINER_PERFECT_FORWARDING
+
+   #define BOOST_PP_LOCAL_MACRO(n)                                                        \
+   BOOST_PP_EXPR_IF(n, template<) BOOST_PP_ENUM_PARAMS(n, class P) BOOST_PP_EXPR_IF(n, >) \
+   std::pair<iterator, bool>                                                              \
+      emplace_unique(BOOST_PP_ENUM(n, BOOST_CONTAINER_PP_PARAM_LIST, _))                  \
+   {                                                                                      \
+      aligned_storage<sizeof(value_type), alignment_of<value_type>::value> v;             \
+      value_type &val = *static_cast<value_type *>(static_cast<void *>(&v));              \
+      stored_allocator_type &a = this->get_stored_allocator();                            \
+      stored_allocator_traits::construct(a, &val                                          \
+         BOOST_PP_ENUM_TRAILING(n, BOOST_CONTAINER_PP_PARAM_FORWARD, _) );                \
+      value_destructor<stored_allocator_type> d(a, val);                                  \
+      return this->insert_unique(::boost::move(val));                                     \
+   }                                                                                      \
+                                                                                          \
+   BOOST_PP_EXPR_IF(n, template<) BOOST_PP_ENUM_PARAMS(n, class P) BOOST_PP_EXPR_IF(n, >) \
+   iterator emplace_hint_unique(const_iterator hint                                       \
+                        BOOST_PP_ENUM_TRAILING(n, BOOST_CONTAINER_PP_PARAM_LIST, _))      \
+   {                                                                                      \
+      aligned_storage<sizeof(value_type), alignment_of<value_type>::value> v;             \
+      value_type &val = *static_cast<value_type *>(static_cast<void *>(&v));              \
+      stored_allocator_type &a = this->get_stored_allocator();                            \
+      stored_allocator_traits::construct(a, &val                                          \
+         BOOST_PP_ENUM_TRAILING(n, BOOST_CONTAINER_PP_PARAM_FORWARD, _) );                \
+      value_destructor<stored_allocator_type> d(a, val);                                  \
+      return this->insert_unique(hint, ::boost::move(val));                               \
+   }                                                                                      \
+                                                                                          \
+   BOOST_PP_EXPR_IF(n, template<) BOOST_PP_ENUM_PARAMS(n, class P) BOOST_PP_EXPR_IF(n, >) \
+   iterator emplace_equal(BOOST_PP_ENUM(n, BOOST_CONTAINER_PP_PARAM_LIST, _))             \
+   {                                                                                      \
+      aligned_storage<sizeof(value_type), alignment_of<value_type>::value> v;             \
+      value_type &val = *static_cast<value_type *>(static_cast<void *>(&v));              \
+      stored_allocator_type &a = this->get_stored_allocator();                            \
+      stored_allocator_traits::construct(a, &val                                          \
+         BOOST_PP_ENUM_TRAILING(n, BOOST_CONTAINER_PP_PARAM_FORWARD, _) );                \
+      value_destructor<stored_allocator_type> d(a,  val);                                 \
+      return this->insert_equal(::boost::move(val));                                      \
+   }                                                                                      \
+                                                                                          \
+   BOOST_PP_EXPR_IF(n, template<) BOOST_PP_ENUM_PARAMS(n, class P) BOOST_PP_EXPR_IF(n, >) \
+   iterator emplace_hint_equal(const_iterator hint                                        \
+                      BOOST_PP_ENUM_TRAILING(n, BOOST_CONTAINER_PP_PARAM_LIST, _))        \
+   {                                                                                      \
+      aligned_storage<sizeof(value_type), alignment_of<value_type>::value> v;             \
+      value_type &val = *static_cast<value_type *>(static_cast<void *>(&v));              \
+      stored_allocator_type &a = this->get_stored_allocator();                            \
+      stored_allocator_traits::construct(a, &val                                          \
+         BOOST_PP_ENUM_TRAILING(n, BOOST_CONTAINER_PP_PARAM_FORWARD, _) );                \
+      value_destructor<stored_allocator_type> d(a,  val);                                 \
+      return this->insert_equal(hint, ::boost::move(val));                                \
+   }                                                                                      \
+   //!
+   #define BOOST_PP_LOCAL_LIMITS (0, BOOST_CONTAINER_MAX_CONSTRUCTOR_PARAMETERS)
+   #include BOOST_PP_LOCAL_ITERATE()
+
+   #endif   //#ifdef BOOST_CONTAINER_PERFECT_FORWARDING
+
+   iterator erase(const_iterator position)
+   {
+      node_ptr n(position.get_node());
+      std::size_t pos = position.get_pos();
+      const bool internal_erase = !n->m_leaf;
+      if(internal_erase){
+         //Replace the value with the previous one, which is the last
+         //value of a leaf, and erase that value from the leaf
+         const_iterator prev(position);
+         --prev;
+         n->value(pos) = boost::move(prev.get_node()->value(prev.get_pos()));
+         n   = prev.get_node();
+         pos = prev.get_pos();
+      }
+      this->priv_erase_value(n, pos);
+      --this->m_data.m_size;
+      //(n, pos) is now the position that follows the erased value in the leaf,
+      //which is after the moved value if the erased value was in an internal node
+      iterator ret(this->priv_rebalance_after_erase(n, pos));
+      if(internal_erase){
+         ++ret;
+      }
+      return ret;
+   }
+
+   size_type erase(const key_type& k)
+   {
+      std::pair<iterator,iterator > itp = this->equal_range(k);
+      const size_type ret = static_cast<size_type>(std::distance(itp.first, itp.second));
+      this->priv_erase_n(itp.first, ret);
+      return ret;
+   }
+
+   iterator erase(const_iterator first, const_iterator last)
+   {
+      if(first == this->cbegin() && last == this->cend()){
+         this->clear();
+         return this->end();
+      }
+      //Erasing moves values between nodes, so "last" is not valid after the first erasure
+      return this->priv_erase_n(first, static_cast<size_type>(std::distance(first, last)));
+   }
+
+   void clear()
+   {
+      if(this->m_data.m_root){
+         this->priv_destroy_subtree(this->m_data.m_root);
+         this->m_data.m_root = this->m_data.m_leftmost = this->m_data.m_rightmost = node_ptr();
+         this->m_data.m_size = 0;
+      }
+   }
+
+   // set operations:
+   iterator find(const key_type& k)
+   {
+      const Compare &key_cmp = this->m_data.get_comp();
+      iterator i = this->lower_bound(k);
+
+      if (i != this->end() && key_cmp(k, KeyOfValue()(*i))){
+         i = this->end();
+      }
+      return i;
+   }
+
+   const_iterator find(const key_type& k) const
+   {
+      const Compare &key_cmp = this->m_data.get_comp();
+      const_iterator i = this->lower_bound(k);
+
+      if (i != this->end() && key_cmp(k, KeyOfValue()(*i))){
+         i = this->end();
+      }
+      return i;
+   }
+
+   size_type count(const key_type& k) const
+   {
+      std::pair<const_iterator, const_iterator> p = this->equal_range(k);
+      return static_cast<size_type>(std::distance(p.first, p.second));
+   }
+
+   iterator lower_bound(const key_type& k)
+   {  return this->priv_bound<iterator, false>(k);  }
+
+   const_iterator lower_bound(const key_type& k) const
+   {  return this->priv_bound<const_iterator, false>(k);  }
+
+   iterator upper_bound(const key_type& k)
+   {  return this->priv_bound<iterator, true>(k);  }
+
+   const_iterator upper_bound(const key_type& k) const
+   {  return this->priv_bound<const_iterator, true>(k);  }
+
+   std::pair<iterator,iterator> equal_range(const key_type& k)
+   {  return std::pair<iterator,iterator>(this->lower_bound(k), this->upper_bound(k));  }
+
+   std::pair<const_iterator, const_iterator> equal_range(const key_type& k) const
+   {  return std::pair<const_iterator,const_iterator>(this->lower_bound(k), this->upper_bound(k));  }
+
+   private:
+
+   std::size_t priv_rightmost_count() const
+   {  return this->m_data.m_rightmost ? this->m_data.m_rightmost->m_count : 0u;  }
+
+   const key_type &priv_key(const node_ptr &n, std::size_t pos) const
+   {  return KeyOfValue()(n->value(pos));  }
+
+   //Binary search of the first value of the node not less than k (Upper == false)
+   //or greater than k (Upper == true)
+   template<bool Upper>
+   std::size_t priv_node_bound(const node_ptr &n, const key_type &k) const
+   {
+      const Compare &key_cmp = this->m_data.get_comp();
+      std::size_t first = 0;
+      std::size_t len   = n->m_count;
+      while(len){
+         const std::size_t half = len/2;
+         const std::size_t middle = first + half;
+         if(Upper ? !key_cmp(k, this->priv_key(n, middle)) : key_cmp(this->priv_key(n, middle), k)){
+            first = middle + 1;
+            len  -= half + 1;
+         }
+         else{
+            len = half;
+         }
+      }
+      return first;
+   }
+
+   template<class Iterator, bool Upper>
+   Iterator priv_bound(const key_type &k) const
+   {
+      node_ptr n(this->m_data.m_root);
+      if(!n){
+         return Iterator();
+      }
+      std::size_t pos;
+      for(;;){
+         pos = this->priv_node_bound<Upper>(n, k);
+         if(n->m_leaf)
+            break;
+         n = n->child(pos);
+      }
+      if(pos == n->m_count){
+         node_type::ascend_to_next(n, pos);
+      }
+      return Iterator(n, pos);
+   }
+
+   //Finds the leaf position where a value with key k would be inserted. Returns false
+   //and the position of the value if there is a value with an equivalent key.
+   bool priv_insert_unique_position(const key_type &k, node_ptr &n, std::size_t &pos) const
+   {
+      const Compare &key_cmp = this->m_data.get_comp();
+      n = this->m_data.m_root;
+      pos = 0;
+      if(!n){
+         return true;
+      }
+      for(;;){
+         pos = this->priv_node_bound<false>(n, k);
+         if(pos < n->m_count && !key_cmp(k, this->priv_key(n, pos))){
+            return false;
+         }
+         if(n->m_leaf){
+            return true;
+         }
+         n = n->child(pos);
+      }
+   }
+
+   //Finds the leaf position where a value with key k is inserted, after equivalent values
+   void priv_insert_equal_position(const key_type &k, node_ptr &n, std::size_t &pos) const
+   {
+      n = this->m_data.m_root;
+      pos = 0;
+      if(n){
+         for(;;){
+            pos = this->priv_node_bound<true>(n, k);
+            if(n->m_leaf)
+               break;
+            n = n->child(pos);
+         }
+      }
+   }
+
+   //The leaf position that inserts a value right before hint
+   void priv_position_before(const_iterator hint, node_ptr &n, std::size_t &pos) const
+   {
+      n = hint.get_node();
+      pos = hint.get_pos();
+      if(n && !n->m_leaf){
+         //The previous value is the last one of a leaf
+         node_type::prev(n, pos);
+         ++pos;
+      }
+   }
+
+   template<class Convertible>
+   std::pair<iterator,bool> priv_insert_unique(BOOST_FWD_REF(Convertible) convertible)
+   {
+      const value_type &val = convertible;
+      node_ptr n;
+      std::size_t pos;
+      if(!this->priv_insert_unique_position(KeyOfValue()(val), n, pos)){
+         return std::pair<iterator,bool>(iterator(n, pos), false);
+      }
+      return std::pair<iterator,bool>
+         (this->priv_insert_at(n, pos, ::boost::forward<Convertible>(convertible)), true);
+   }
+
+   template<class Convertible>
+   iterator priv_insert_unique(const_iterator hint, BOOST_FWD_REF(Convertible) convertible)
+   {
+      const value_type &val = convertible;
+      const Compare &key_cmp = this->m_data.get_comp();
+      const key_type &k = KeyOfValue()(val);
+      //The value goes right before hint if it's between hint and the previous value
+      if(hint == this->cend() || key_cmp(k, KeyOfValue()(*hint))){
+         bool before_hint = hint == this->cbegin();
+         if(!before_hint){
+            const_iterator prev(hint);
+            --prev;
+            before_hint = key_cmp(KeyOfValue()(*prev), k);
+         }
+         if(before_hint){
+            node_ptr n;
+            std::size_t pos;
+            this->priv_position_before(hint, n, pos);
+            return this->priv_insert_at(n, pos, ::boost::forward<Convertible>(convertible));
+         }
+      }
+      return this->priv_insert_unique(::boost::forward<Convertible>(convertible)).first;
+   }
+
+   template<class Convertible>
+   iterator priv_insert_equal(BOOST_FWD_REF(Convertible) convertible)
+   {
+      const value_type &val = convertible;
+      node_ptr n;
+      std::size_t pos;
+      this->priv_insert_equal_position(KeyOfValue()(val), n, pos);
+      return this->priv_insert_at(n, pos, ::boost::forward<Convertible>(convertible));
+   }
+
+   template<class Convertible>
+   iterator priv_insert_equal(const_iterator hint, BOOST_FWD_REF(Convertible) convertible)
+   {
+      // N1780
+      //   To insert val at hint:
+      //   if hint == end || val <= *hint
+      //      if hint == begin || val >= *(hint-1)
+      //         insert val before hint
+      //      else
+      //         insert val before upper_bound(val)
+      //   else
+      //      insert val before lower_bound(val)
+      const value_type &val = convertible;
+      const Compare &key_cmp = this->m_data.get_comp();
+      const key_type &k = KeyOfValue()(val);
+      if(hint == this->cend() || !key_cmp(KeyOfValue()(*hint), k)){
+         bool before_hint = hint == this->cbegin();
+         if(!before_hint){
+            const_iterator prev(hint);
+            --prev;
+            before_hint = !key_cmp(k, KeyOfValue()(*prev));
+         }
+         if(before_hint){
+            node_ptr n;
+            std::size_t pos;
+            this->priv_position_before(hint, n, pos);
+            return this->priv_insert_at(n, pos, ::boost::forward<Convertible>(convertible));
+         }
+         return this->priv_insert_equal(::boost::forward<Convertible>(convertible));
+      }
+      node_ptr n;
+      std::size_t pos;
+      const_iterator lb(this->lower_bound(k));
+      this->priv_position_before(lb, n, pos);
+      return this->priv_insert_at(n, pos, ::boost::forward<Convertible>(convertible));
+   }
+
+   //Inserts a value at the position pos of the leaf n, or in a new
+   //root if the tree is empty
+   template<class Convertible>
+   iterator priv_insert_at(node_ptr n, std::size_t pos, BOOST_FWD_REF(Convertible) convertible)
+   {
+      if(!n){
+         n = this->priv_allocate_node(true);
+         BOOST_TRY{
+            this->priv_insert_value(n, 0, ::boost::forward<Convertible>(convertible));
+         }
+         BOOST_CATCH(...){
+            this->priv_deallocate_node(n);
+            BOOST_RETHROW
+         }
+         BOOST_CATCH_END
+         this->m_data.m_root = this->m_data.m_leftmost = this->m_data.m_rightmost = n;
+      }
+      else{
+         if(n->m_count == node_type::max_values){
+            n = this->priv_split(n, pos);
+         }
+         this->priv_insert_value(n, pos, ::boost::forward<Convertible>(convertible));
+      }
+      ++this->m_data.m_size;
+      return iterator(n, pos);
+   }
+
+   //pre: n is not full
+   template<class Convertible>
+   void priv_insert_value(const node_ptr &n, std::size_t pos, BOOST_FWD_REF(Convertible) convertible)
+   {
+      A &a = this->get_stored_allocator();
+      value_type *const vals = n->values();
+      const std::size_t cnt = n->m_count;
+      if(pos == cnt){
+         allocator_traits_type::construct(a, vals + cnt, ::boost::forward<Convertible>(convertible));
+         ++n->m_count;
+      }
+      else{
+         allocator_traits_type::construct(a, vals + cnt, ::boost::move(vals[cnt - 1]));
+         ++n->m_count;
+         ::boost::move_backward(vals + pos, vals + cnt - 1, vals + cnt);
+         vals[pos] = ::boost::forward<Convertible>(convertible);
+      }
+   }
+
+   //pre: n is an internal node that is not full. Inserts a value at pos with
+   //child as the right child of the value
+   template<class Convertible>
+   void priv_insert_value(const node_ptr &n, std::size_t pos, BOOST_FWD_REF(Convertible) convertible, const node_ptr &child)
+   {
+      this->priv_insert_value(n, pos, ::boost::forward<Convertible>(convertible));
+      for(std::size_t i = n->m_count; i > pos + 1; --i){
+         this->priv_set_child(n, i, n->child(i - 1));
+      }
+      this->priv_set_child(n, pos + 1, child);
+   }
+
+   void priv_erase_value(const node_ptr &n, std::size_t pos)
+   {
+      value_type *const vals = n->values();
+      const std::size_t cnt = n->m_count;
+      ::boost::move(vals + pos + 1, vals + cnt, vals + pos);
+      allocator_traits_type::destroy(this->get_stored_allocator(), vals + cnt - 1);
+      --n->m_count;
+   }
+
+   static void priv_set_child(const node_ptr &n, std::size_t i, const node_ptr &child)
+   {
+      n->child(i) = child;
+      child->m_parent = n;
+      child->m_position = static_cast<unsigned short>(i);
+   }
+
+   //pre: n is full. Splits n in two nodes, so that there is room to insert
+   //a value at pos. Returns the node where the value must be inserted and
+   //updates pos.
+   node_ptr priv_split(node_ptr n, std::size_t &pos)
+   {
+      const std::size_t max = node_type::max_values;
+      node_ptr sibling(this->priv_allocate_node(n->m_leaf != 0));
+      BOOST_TRY{
+         //Make room for the middle value in the parent
+         if(!n->m_parent){
+            node_ptr root(this->priv_allocate_node(false));
+            this->priv_set_child(root, 0, n);
+            this->m_data.m_root = root;
+         }
+         else if(n->m_parent->m_count == max){
+            std::size_t parent_pos = n->m_position;
+            this->priv_split(n->m_parent, parent_pos);
+         }
+      }
+      BOOST_CATCH(...){
+         this->priv_deallocate_node(sibling);
+         BOOST_RETHROW
+      }
+      BOOST_CATCH_END
+
+      //Inserting at the end of a node leaves it full, which fills nodes when
+      //values are inserted in order. Otherwise both nodes are half full.
+      const std::size_t split = (pos == max) ? max - 1 : max/2;
+      const std::size_t moved = max - split - 1;
+      A &a = this->get_stored_allocator();
+      value_type *const vals = n->values();
+      ::boost::container::uninitialized_move_alloc_n(a, vals + split + 1, moved, sibling->values());
+      sibling->m_count = static_cast<unsigned short>(moved);
+      ::boost::container::destroy_alloc_n(a, vals + split + 1, moved);
+      n->m_count = static_cast<unsigned short>(split + 1);
+      if(!n->m_leaf){
+         for(std::size_t i = 0; i <= moved; ++i){
+            this->priv_set_child(sibling, i, n->child(split + 1 + i));
+         }
+      }
+      this->priv_insert_value(n->m_parent, n->m_position, ::boost::move(vals[split]), sibling);
+      allocator_traits_type::destroy(a, vals + split);
+      n->m_count = static_cast<unsigned short>(split);
+      if(n == this->m_data.m_rightmost){
+         this->m_data.m_rightmost = sibling;
+      }
+      if(pos > split){
+         pos -= split + 1;
+         return sibling;
+      }
+      return n;
+   }
+
+   //Merges nodes after an erasure that leaves a node with less than min_values
+   //values. (n, pos) is a position in a leaf that is updated if values move.
+   iterator priv_rebalance_after_erase(node_ptr n, std::size_t pos)
+   {
+      node_ptr res_node(n);
+      std::size_t res_pos = pos;
+      for(bool first = true; ; first = false){
+         if(n == this->m_data.m_root){
+            this->priv_try_shrink();
+            if(!this->m_data.m_root){
+               return this->end();
+            }
+            break;
+         }
+         if(n->m_count >= node_type::min_values){
+            break;
+         }
+         const bool merged = this->priv_merge_or_rebalance(n, pos);
+         if(first){
+            res_node = n;
+            res_pos  = pos;
+         }
+         if(!merged){
+            break;
+         }
+         pos = n->m_position;
+         n   = n->m_parent;
+      }
+      if(res_pos == res_node->m_count){
+         node_type::ascend_to_next(res_node, res_pos);
+      }
+      return iterator(res_node, res_pos);
+   }
+
+   //Merges n with a sibling, or moves values from a sibling to n. Returns true
+   //if the nodes were merged, as the parent lost a value.
+   bool priv_merge_or_rebalance(node_ptr &n, std::size_t &pos)
+   {
+      const std::size_t max = node_type::max_values;
+      const std::size_t min = node_type::min_values;
+      const node_ptr parent(n->m_parent);
+      if(n->m_position > 0){
+         node_ptr left(parent->child(n->m_position - 1u));
+         if(1u + left->m_count + n->m_count <= max){
+            pos += 1u + left->m_count;
+            this->priv_merge(left, n);
+            n = left;
+            return true;
+         }
+      }
+      if(n->m_position < parent->m_count){
+         node_ptr right(parent->child(n->m_position + 1u));
+         if(1u + n->m_count + right->m_count <= max){
+            this->priv_merge(n, right);
+            return true;
+         }
+         if(right->m_count > min){
+            std::size_t to_move = (right->m_count - n->m_count)/2;
+            to_move = to_move < right->m_count - 1u ? to_move : right->m_count - 1u;
+            this->priv_move_from_right(n, right, to_move);
+            return false;
+         }
+      }
+      if(n->m_position > 0){
+         node_ptr left(parent->child(n->m_position - 1u));
+         if(left->m_count > min){
+            std::size_t to_move = (left->m_count - n->m_count)/2;
+            to_move = to_move < left->m_count - 1u ? to_move : left->m_count - 1u;
+            this->priv_move_from_left(left, n, to_move);
+            pos += to_move;
+            return false;
+         }
+      }
+      return false;
+   }
+
+   //Moves the separator of left and right in the parent and all the values of
+   //right to left, and deallocates right
+   void priv_merge(const node_ptr &left, const node_ptr &right)
+   {
+      A &a = this->get_stored_allocator();
+      const node_ptr parent(left->m_parent);
+      const std::size_t sep = left->m_position;
+      const std::size_t lcnt = left->m_count;
+      const std::size_t rcnt = right->m_count;
+      value_type *const lvals = left->values();
+      allocator_traits_type::construct(a, lvals + lcnt, ::boost::move(parent->value(sep)));
+      ++left->m_count;
+      ::boost::container::uninitialized_move_alloc_n(a, right->values(), rcnt, lvals + lcnt + 1);
+      left->m_count = static_cast<unsigned short>(lcnt + 1 + rcnt);
+      ::boost::container::destroy_alloc_n(a, right->values(), rcnt);
+      right->m_count = 0;
+      if(!left->m_leaf){
+         for(std::size_t i = 0; i <= rcnt; ++i){
+            this->priv_set_child(left, lcnt + 1 + i, right->child(i));
+         }
+      }
+      this->priv_erase_value(parent, sep);
+      for(std::size_t i = sep + 1; i <= parent->m_count; ++i){
+         this->priv_set_child(parent, i, parent->child(i + 1));
+      }
+      if(right == this->m_data.m_rightmost){
+         this->m_data.m_rightmost = left;
+      }
+      this->priv_deallocate_node(right);
+   }
+
+   //Moves "count" values from right to its left sibling n through the parent
+   void priv_move_from_right(const node_ptr &n, const node_ptr &right, std::size_t count)
+   {
+      A &a = this->get_stored_allocator();
+      const node_ptr parent(n->m_parent);
+      const std::size_t sep = n->m_position;
+      const std::size_t ncnt = n->m_count;
+      const std::size_t rcnt = right->m_count;
+      value_type *const nvals = n->values();
+      value_type *const rvals = right->values();
+      allocator_traits_type::construct(a, nvals + ncnt, ::boost::move(parent->value(sep)));
+      ++n->m_count;
+      ::boost::container::uninitialized_move_alloc_n(a, rvals, count - 1, nvals + ncnt + 1);
+      n->m_count = static_cast<unsigned short>(ncnt + count);
+      parent->value(sep) = ::boost::move(rvals[count - 1]);
+      ::boost::move(rvals + count, rvals + rcnt, rvals);
+      ::boost::container::destroy_alloc_n(a, rvals + rcnt - count, count);
+      right->m_count = static_cast<unsigned short>(rcnt - count);
+      if(!n->m_leaf){
+         for(std::size_t i = 0; i < count; ++i){
+            this->priv_set_child(n, ncnt + 1 + i, right->child(i));
+         }
+         for(std::size_t i = 0; i <= rcnt - count; ++i){
+            this->priv_set_child(right, i, right->child(i + count));
+         }
+      }
+   }
+
+   //Moves "count" values from left to its right sibling n through the parent
+   void priv_move_from_left(const node_ptr &left, const node_ptr &n, std::size_t count)
+   {
+      A &a = this->get_stored_allocator();
+      const node_ptr parent(left->m_parent);
+      const std::size_t sep = left->m_position;
+      const std::size_t lcnt = left->m_count;
+      const std::size_t ncnt = n->m_count;
+      value_type *const lvals = left->values();
+      value_type *const nvals = n->values();
+      //Make room for "count" values at the beginning of n
+      if(count >= ncnt){
+         ::boost::container::uninitialized_move_alloc_n(a, nvals, ncnt, nvals + count);
+         ::boost::container::destroy_alloc_n(a, nvals, ncnt);
+      }
+      else{
+         ::boost::container::uninitialized_move_alloc_n(a, nvals + ncnt - count, count, nvals + ncnt);
+         ::boost::move_backward(nvals, nvals + ncnt - count, nvals + ncnt);
+         ::boost::container::destroy_alloc_n(a, nvals, count);
+      }
+      allocator_traits_type::construct(a, nvals + count - 1, ::boost::move(parent->value(sep)));
+      ::boost::container::uninitialized_move_alloc_n(a, lvals + lcnt - count + 1, count - 1, nvals);
+      n->m_count = static_cast<unsigned short>(ncnt + count);
+      parent->value(sep) = ::boost::move(lvals[lcnt - count]);
+      ::boost::container::destroy_alloc_n(a, lvals + lcnt - count, count);
+      left->m_count = static_cast<unsigned short>(lcnt - count);
+      if(!n->m_leaf){
+         for(std::size_t i = ncnt + 1; i > 0; --i){
+            this->priv_set_child(n, i - 1 + count, n->child(i - 1));
+         }
+         for(std::size_t i = 0; i < count; ++i){
+            this->priv_set_child(n, i, left->child(lcnt - count + 1 + i));
+         }
+      }
+   }
+
+   //Removes an empty root
+   void priv_try_shrink()
+   {
+      const node_ptr root(this->m_data.m_root);
+      if(root->m_count){
+         return;
+      }
+      if(root->m_leaf){
+         this->m_data.m_root = this->m_data.m_leftmost = this->m_data.m_rightmost = node_ptr();
+      }
+      else{
+         const node_ptr child(root->child(0));
+         child->m_parent = node_ptr();
+         child->m_position = 0;
+         this->m_data.m_root = child;
+      }
+      this->priv_deallocate_node(root);
+   }
+
+   iterator priv_erase_n(const_iterator first, size_type n)
+   {
+      iterator it(first.get_node(), first.get_pos());
+      for(; n; --n){
+         it = this->erase(it);
+      }
+      return it;
+   }
+
+   void priv_destroy_subtree(const node_ptr &n)
+   {
+      if(!n->m_leaf){
+         for(std::size_t i = 0; i <= n->m_count; ++i){
+            this->priv_destroy_subtree(n->child(i));
+         }
+      }
+      ::boost::container::destroy_alloc_n(this->get_stored_allocator(), n->values(), n->m_count);
+      this->priv_deallocate_node(n);
+   }
+
+   node_ptr priv_allocate_node(bool leaf)
+   {
+      node_type *n;
+      if(leaf){
+         leaf_allocator_type a(this->get_stored_allocator());
+         n = container_detail::to_raw_pointer(leaf_allocator_traits::allocate(a, 1));
+         ::new(static_cast<void*>(n)) node_type;
+      }
+      else{
+         internal_allocator_type a(this->get_stored_allocator());
+         internal_node_type *const in = container_detail::to_raw_pointer(internal_allocator_traits::allocate(a, 1));
+         ::new(static_cast<void*>(in)) internal_node_type;
+         n = in;
+      }
+      n->m_parent   = node_ptr();
+      n->m_position = 0;
+      n->m_count    = 0;
+      n->m_leaf     = leaf;
+      return boost::intrusive::pointer_traits<node_ptr>::pointer_to(*n);
+   }
+
+   void priv_deallocate_node(const node_ptr &n)
+   {
+      node_type *const raw = container_detail::to_raw_pointer(n);
+      if(raw->m_leaf){
+         leaf_allocator_type a(this->get_stored_allocator());
+         raw->~node_type();
+         leaf_allocator_traits::deallocate
+            (a, boost::intrusive::pointer_traits<typename leaf_allocator_traits::pointer>::pointer_to(*raw), 1);
+      }
+      else{
+         internal_allocator_type a(this->get_stored_allocator());
+         internal_node_type *const in = static_cast<internal_node_type*>(raw);
+         in->~internal_node_type();
+         internal_allocator_traits::deallocate
+            (a, boost::intrusive::pointer_traits<typename internal_allocator_traits::pointer>::pointer_to(*in), 1);
+      }
+   }
+
+   //Appends the values of x in order, which leaves the nodes full
+   void priv_copy_from(const btree &x)
+   {
+      BOOST_TRY{
+         for(const_iterator it = x.cbegin(), itend = x.cend(); it != itend; ++it){
+            this->priv_insert_at(this->m_data.m_rightmost, this->priv_rightmost_count(), *it);
+         }
+      }
+      BOOST_CATCH(...){
+         this->clear();
+         BOOST_RETHROW
+      }
+      BOOST_CATCH_END
+   }
+
+   void priv_move_from(btree &x)
+   {
+      BOOST_TRY{
+         for(iterator it = x.begin(), itend = x.end(); it != itend; ++it){
+            this->priv_insert_at(this->m_data.m_rightmost, this->priv_rightmost_count(), ::boost::move(*it));
+         }
+      }
+      BOOST_CATCH(...){
+         this->clear();
+         BOOST_RETHROW
+      }
+      BOOST_CATCH_END
+   }
+};
+
+template <class Key, class Value, class KeyOfValue,
+          class Compare, class A>
+inline bool
+operator==(const btree<Key,Value,KeyOfValue,Compare,A>& x,
+           const btree<Key,Value,KeyOfValue,Compare,A>& y)
+{
+  return x.size() == y.size() &&
+         std::equal(x.begin(), x.end(), y.begin());
+}
+
+template <class Key, class Value, class KeyOfValue,
+          class Compare, class A>
+inline bool
+operator<(const btree<Key,Value,KeyOfValue,Compare,A>& x,
+          const btree<Key,Value,KeyOfValue,Compare,A>& y)
+{
+  return std::lexicographical_compare(x.begin(), x.end(),
+                                      y.begin(), y.end());
+}
+
+template <class Key, class Value, class KeyOfValue,
+          class Compare, class A>
+inline bool
+operator!=(const btree<Key,Value,KeyOfValue,Compare,A>& x,
+           const btree<Key,Value,KeyOfValue,Compare,A>& y)
+   {  return !(x == y); }
+
+template <class Key, class Value, class KeyOfValue,
+          class Compare, class A>
+inline bool
+operator>(const btree<Key,Value,KeyOfValue,Compare,A>& x,
+          const btree<Key,Value,KeyOfValue,Compare,A>& y)
+   {  return y < x;  }
+
+template <class Key, class Value, class KeyOfValue,
+          class Compare, class A>
+inline bool
+operator<=(const btree<Key,Value,KeyOfValue,Compare,A>& x,
+           const btree<Key,Value,KeyOfValue,Compare,A>& y)
+   {  return !(y < x);  }
+
+template <class Key, class Value, class KeyOfValue,
+          class Compare, class A>
+inline bool
+operator>=(const btree<Key,Value,KeyOfValue,Compare,A>& x,
+           const btree<Key,Value,KeyOfValue,Compare,A>& y)
+   {  return !(x < y);  }
+
+
+template <class Key, class Value, class KeyOfValue,
+          class Compare, class A>
+inline void
+swap(btree<Key,Value,KeyOfValue,Compare,A>& x,
+     btree<Key,Value,KeyOfValue,Compare,A>& y)
+   {  x.swap(y);  }
+
+}  //namespace container_detail {
+
+}  //namespace container {
+}  //namespace boost {
+
+#include <boost/container/detail/config_end.hpp>
+
+#endif // BOOST_CONTAINER_BTREE_HPP
@@ -166,6 +166,19 @@ template<class AllocatorType>
 inline void move_alloc(AllocatorType &l, AllocatorType &r, container_detail::true_type)
 {  l = ::boost::move(r);   }
 
+//Reinterprets a value as a layout-compatible type, used by containers that
+//store container_detail::pair but expose std::pair
+template<class D, class S>
+static D &force(const S &s)
+{  return *const_cast<D*>((reinterpret_cast<const D*>(&s))); }
+
+template<class D, class S>
+static D force_copy(S s)
+{
+   D *vp = reinterpret_cast<D *>(&s);
+   return D(*vp);
+}
+
 //Rounds "orig_size" by excess to round_to bytes
 template<class SizeType>
 inline SizeType get_rounded_size(SizeType orig_size, SizeType round_to)
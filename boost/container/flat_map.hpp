@@ -47,22 +47,6 @@ template <class Key, class T, class Compare, class Allocator>
 inline bool operator<(const flat_map<Key,T,Compare,Allocator>& x,
                       const flat_map<Key,T,Compare,Allocator>& y);
 
-namespace container_detail{
-
-template<class D, class S>
-static D &force(const S &s)
-{  return *const_cast<D*>((reinterpret_cast<const D*>(&s))); }
-
-template<class D, class S>
-static D force_copy(S s)
-{
-   D *vp = reinterpret_cast<D *>(&s);
-   return D(*vp);
-}
-
-}  //namespace container_detail{
-
-
 /// @endcond
 
 //! A flat_map is a kind of associative container that supports unique keys (contains at
@@ -0,0 +1,574 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2013. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOST_CONTAINER_SMALL_VECTOR_HPP
+#define BOOST_CONTAINER_SMALL_VECTOR_HPP
+
+#if (defined _MSC_VER) && (_MSC_VER >= 1200)
+#  pragma once
+#endif
+
+#include <boost/container/detail/config_begin.hpp>
+
+#include <boost/container/vector.hpp>
+#include <boost/aligned_storage.hpp>
+#include <boost/intrusive/pointer_traits.hpp>
+#include <boost/move/utility.hpp>
+#include <boost/move/iterator.hpp>
+
+namespace boost { namespace container {
+
+/// @cond
+
+namespace container_detail {
+
+//!An allocator that owns storage for N elements of T, and that takes
+//!any additional memory from Allocator. The internal storage is only handed
+//!to the container by vector_alloc_holder, so allocate always uses
+//!Allocator while deallocate ignores the internal storage.
+template<class T, std::size_t N, class Allocator>
+class small_vector_allocator
+   : public Allocator
+{
+   typedef boost::container::allocator_traits<Allocator> allocator_traits_type;
+
+   public:
+   typedef T                                                   value_type;
+   typedef typename allocator_traits_type::pointer             pointer;
+   typedef typename allocator_traits_type::size_type           size_type;
+
+   typedef boost::container::container_detail::version_type<small_vector_allocator, 1>   version;
+
+   //The internal storage belongs to the container, so it is never propagated
+   typedef container_detail::false_type   propagate_on_container_copy_assignment;
+   typedef container_detail::false_type   propagate_on_container_move_assignment;
+   typedef container_detail::false_type   propagate_on_container_swap;
+
+   template<class U>
+   struct rebind
+   {
+      typedef small_vector_allocator
+         < U, N, typename allocator_traits_type::template portable_rebind_alloc<U>::type> other;
+   };
+
+   static const std::size_t internal_capacity = N;
+
+   small_vector_allocator()
+      BOOST_CONTAINER_NOEXCEPT_IF(::boost::has_nothrow_default_constructor<Allocator>::value)
+      : Allocator()
+   {}
+
+   //The internal storage is not copied
+   small_vector_allocator(const small_vector_allocator &other) BOOST_CONTAINER_NOEXCEPT
+      : Allocator(static_cast<const Allocator&>(other))
+   {}
+
+   explicit small_vector_allocator(const Allocator &a) BOOST_CONTAINER_NOEXCEPT
+      : Allocator(a)
+   {}
+
+   small_vector_allocator & operator=(const small_vector_allocator &other) BOOST_CONTAINER_NOEXCEPT
+   {
+      Allocator::operator=(static_cast<const Allocator&>(other));
+      return *this;
+   }
+
+   small_vector_allocator select_on_container_copy_construction() const
+   {
+      return small_vector_allocator
+         (allocator_traits_type::select_on_container_copy_construction(this->as_base()));
+   }
+
+   void deallocate(const pointer &p, size_type n) BOOST_CONTAINER_NOEXCEPT
+   {
+      if(p != this->internal_storage()){
+         this->as_base().deallocate(p, n);
+      }
+   }
+
+   pointer internal_storage() const BOOST_CONTAINER_NOEXCEPT
+   {
+      return boost::intrusive::pointer_traits<pointer>::pointer_to
+         (*const_cast<T*>(static_cast<const T*>(static_cast<const void*>(&storage))));
+   }
+
+   Allocator &as_base() BOOST_CONTAINER_NOEXCEPT
+   {  return *this;  }
+
+   const Allocator &as_base() const BOOST_CONTAINER_NOEXCEPT
+   {  return *this;  }
+
+   friend bool operator==(const small_vector_allocator &x, const small_vector_allocator &y) BOOST_CONTAINER_NOEXCEPT
+   {  return x.as_base() == y.as_base();  }
+
+   friend bool operator!=(const small_vector_allocator &x, const small_vector_allocator &y) BOOST_CONTAINER_NOEXCEPT
+   {  return !(x == y);  }
+
+   private:
+   typename boost::aligned_storage
+      <sizeof(T)*N, boost::alignment_of<T>::value>::type storage;
+};
+
+//small_vector_allocator constructs elements with Allocator's construct
+template<class T, std::size_t N, class Allocator>
+struct is_std_allocator< small_vector_allocator<T, N, Allocator> >
+{  static const bool value = is_std_allocator<Allocator>::value; };
+
+//!Holds the buffer of a small_vector: it starts with the internal storage of
+//!the allocator and only steals the buffer of another holder when that
+//!buffer was allocated. Elements in the internal storage are moved one by one.
+template<class T, std::size_t N, class Allocator>
+struct vector_alloc_holder
+   < small_vector_allocator<T, N, Allocator>, container_detail::integral_constant<unsigned, 1> >
+   : public small_vector_allocator<T, N, Allocator>
+{
+   private:
+   BOOST_MOVABLE_BUT_NOT_COPYABLE(vector_alloc_holder)
+
+   typedef small_vector_allocator<T, N, Allocator>             small_allocator_type;
+
+   public:
+   typedef boost::container::allocator_traits<small_allocator_type> allocator_traits_type;
+   typedef typename allocator_traits_type::pointer       pointer;
+   typedef typename allocator_traits_type::size_type     size_type;
+   typedef typename allocator_traits_type::value_type    value_type;
+
+   //Constructor, does not throw
+   vector_alloc_holder()
+      BOOST_CONTAINER_NOEXCEPT_IF(::boost::has_nothrow_default_constructor<Allocator>::value)
+      : small_allocator_type(), m_start(this->internal_storage()), m_size(), m_capacity(N)
+   {}
+
+   //Constructor, does not throw
+   template<class AllocConvertible>
+   explicit vector_alloc_holder(BOOST_FWD_REF(AllocConvertible) a) BOOST_CONTAINER_NOEXCEPT
+      : small_allocator_type(boost::forward<AllocConvertible>(a))
+      , m_start(this->internal_storage()), m_size(), m_capacity(N)
+   {}
+
+   //Constructor, does not throw
+   template<class AllocConvertible>
+   explicit vector_alloc_holder(BOOST_FWD_REF(AllocConvertible) a, size_type initial_size)
+      : small_allocator_type(boost::forward<AllocConvertible>(a))
+      , m_start(this->internal_storage())
+      , m_size(initial_size)  //Size is initialized here so vector should only call uninitialized_xxx after this
+      , m_capacity(N)
+   {
+      this->first_allocation(initial_size);
+   }
+
+   //Constructor, does not throw
+   explicit vector_alloc_holder(size_type initial_size)
+      : small_allocator_type()
+      , m_start(this->internal_storage())
+      , m_size(initial_size)  //Size is initialized here so vector should only call uninitialized_xxx after this
+      , m_capacity(N)
+   {
+      this->first_allocation(initial_size);
+   }
+
+   vector_alloc_holder(BOOST_RV_REF(vector_alloc_holder) holder)
+      : small_allocator_type(boost::move(static_cast<small_allocator_type&>(holder)))
+      , m_start(this->internal_storage()), m_size(), m_capacity(N)
+   {
+      this->move_from_empty(holder);
+   }
+
+   void first_allocation(size_type cap)
+   {
+      if(cap > N){
+         m_start = this->allocation_command
+               (allocate_new, cap, cap, m_capacity, m_start).first;
+      }
+   }
+
+   void first_allocation_same_allocator_type(size_type cap)
+   {  this->first_allocation(cap);  }
+
+   ~vector_alloc_holder() BOOST_CONTAINER_NOEXCEPT
+   {
+      if(this->m_capacity){
+         this->alloc().deallocate(this->m_start, this->m_capacity);
+      }
+   }
+
+   std::pair<pointer, bool>
+      allocation_command(allocation_type command,
+                         size_type limit_size,
+                         size_type preferred_size,
+                         size_type &received_size, const pointer &reuse = pointer())
+   {
+      return allocator_version_traits<small_allocator_type>::allocation_command
+         (this->alloc(), command, limit_size, preferred_size, received_size, reuse);
+   }
+
+   size_type next_capacity(size_type additional_objects) const
+   {
+      std::size_t num_objects   = this->m_size + additional_objects;
+      std::size_t next_cap = this->m_capacity + this->m_capacity/2;
+      return num_objects > next_cap ? num_objects : next_cap;
+   }
+
+   pointer     m_start;
+   size_type   m_size;
+   size_type   m_capacity;
+
+   bool is_internal_storage() const BOOST_CONTAINER_NOEXCEPT
+   {  return this->m_start == this->internal_storage();  }
+
+   void swap(vector_alloc_holder &x)
+   {
+      const bool this_internal = this->is_internal_storage();
+      const bool x_internal    = x.is_internal_storage();
+      if(!this_internal && !x_internal){
+         boost::container::swap_dispatch(this->m_start, x.m_start);
+         boost::container::swap_dispatch(this->m_size, x.m_size);
+         boost::container::swap_dispatch(this->m_capacity, x.m_capacity);
+      }
+      else if(this_internal && x_internal){
+         const std::size_t MaxTmpStorage = sizeof(value_type)*N;
+         value_type *const first_this = container_detail::to_raw_pointer(this->m_start);
+         value_type *const first_x = container_detail::to_raw_pointer(x.m_start);
+         if(this->m_size < x.m_size){
+            boost::container::deep_swap_alloc_n<MaxTmpStorage>(this->alloc(), first_this, this->m_size, first_x, x.m_size);
+         }
+         else{
+            boost::container::deep_swap_alloc_n<MaxTmpStorage>(this->alloc(), first_x, x.m_size, first_this, this->m_size);
+         }
+         boost::container::swap_dispatch(this->m_size, x.m_size);
+      }
+      else if(this_internal){
+         this->priv_swap_internal_with_allocated(x);
+      }
+      else{
+         x.priv_swap_internal_with_allocated(*this);
+      }
+   }
+
+   //pre: this is empty and uses the internal storage
+   void move_from_empty(vector_alloc_holder &x)
+   {
+      BOOST_ASSERT(!this->m_size && this->is_internal_storage());
+      if(x.is_internal_storage()){
+         value_type *const first_x = container_detail::to_raw_pointer(x.m_start);
+         ::boost::container::uninitialized_move_alloc_n
+            (this->alloc(), first_x, x.m_size, container_detail::to_raw_pointer(this->m_start));
+         boost::container::destroy_alloc_n(x.alloc(), first_x, x.m_size);
+         this->m_size = x.m_size;
+         x.m_size = 0;
+      }
+      else{
+         this->m_start     = x.m_start;
+         this->m_size      = x.m_size;
+         this->m_capacity  = x.m_capacity;
+         x.m_start = x.internal_storage();
+         x.m_size = 0;
+         x.m_capacity = N;
+      }
+   }
+
+   small_allocator_type &alloc() BOOST_CONTAINER_NOEXCEPT
+   {  return *this;  }
+
+   const small_allocator_type &alloc() const BOOST_CONTAINER_NOEXCEPT
+   {  return *this;  }
+
+   const pointer   &start() const     BOOST_CONTAINER_NOEXCEPT {  return m_start;  }
+   const size_type &capacity() const  BOOST_CONTAINER_NOEXCEPT {  return m_capacity;  }
+   void start(const pointer &p)       BOOST_CONTAINER_NOEXCEPT {  m_start = p;  }
+   void capacity(const size_type &c)  BOOST_CONTAINER_NOEXCEPT {  m_capacity = c;  }
+
+   private:
+
+   //pre: this uses the internal storage and x doesn't. Moves this's elements
+   //to x's internal storage and takes x's buffer.
+   void priv_swap_internal_with_allocated(vector_alloc_holder &x)
+   {
+      value_type *const first_this = container_detail::to_raw_pointer(this->m_start);
+      ::boost::container::uninitialized_move_alloc_n
+         (x.alloc(), first_this, this->m_size, container_detail::to_raw_pointer(x.internal_storage()));
+      boost::container::destroy_alloc_n(this->alloc(), first_this, this->m_size);
+      this->m_start = x.m_start;
+      this->m_capacity = x.m_capacity;
+      x.m_start = x.internal_storage();
+      x.m_capacity = N;
+      boost::container::swap_dispatch(this->m_size, x.m_size);
+   }
+};
+
+}  //namespace container_detail {
+
+/// @endcond
+
+//! small_vector is a vector-like container that stores up to N elements in
+//! the object itself, and only allocates memory from Allocator when it grows
+//! beyond that. Containers that almost always hold a few elements don't
+//! allocate at all, while larger ones behave like boost::container::vector.
+//!
+//! small_vector derives from boost::container::vector and has the same
+//! interface, insertion algorithms and exception guarantees. The differences are:
+//!
+//! - capacity() is N until the elements move to allocated memory.
+//! - Moving or swapping containers whose elements are in the internal
+//!   storage moves the elements one by one, so it's linear and can throw.
+//!   Containers with allocated memory are moved and swapped in constant time.
+//! - shrink_to_fit() moves the elements back to the internal storage when
+//!   they fit.
+//!
+//! \tparam T The type of object that is stored in the small_vector
+//! \tparam N The number of elements that can be stored without allocating memory
+//! \tparam Allocator The allocator used for memory beyond the internal storage
+#ifdef BOOST_CONTAINER_DOXYGEN_INVOKED
+template <class T, std::size_t N, class Allocator = std::allocator<T> >
+#else
+template <class T, std::size_t N, class Allocator>
+#endif
+class small_vector
+   : public vector<T, container_detail::small_vector_allocator<T, N, Allocator> >
+{
+   /// @cond
+   typedef vector<T, container_detail::small_vector_allocator<T, N, Allocator> > base_t;
+
+   BOOST_COPYABLE_AND_MOVABLE(small_vector)
+   /// @endcond
+
+   public:
+   typedef typename base_t::value_type                value_type;
+   typedef typename base_t::size_type                 size_type;
+   typedef typename base_t::difference_type           difference_type;
+   typedef typename base_t::pointer                   pointer;
+   typedef typename base_t::const_pointer             const_pointer;
+   typedef typename base_t::reference                 reference;
+   typedef typename base_t::const_reference           const_reference;
+   typedef typename base_t::iterator                  iterator;
+   typedef typename base_t::const_iterator            const_iterator;
+   typedef typename base_t::reverse_iterator          reverse_iterator;
+   typedef typename base_t::const_reverse_iterator    const_reverse_iterator;
+   typedef typename base_t::allocator_type            allocator_type;
+
+   //! The number of elements stored without allocating memory.
+   static const size_type static_capacity = N;
+
+   //! <b>Effects</b>: Constructs an empty small_vector.
+   //!
+   //! <b>Throws</b>: If Allocator's default constructor throws.
+   //!
+   //! <b>Complexity</b>: Constant.
+   small_vector()
+      : base_t()
+   {}
+
+   //! <b>Effects</b>: Constructs an empty small_vector that allocates
+   //!   memory beyond the internal storage with a copy of a.
+   //!
+   //! <b>Throws</b>: Nothing.
+   //!
+   //! <b>Complexity</b>: Constant.
+   explicit small_vector(const Allocator &a)
+      : base_t(allocator_type(a))
+   {}
+
+   //! <b>Effects</b>: Constructs a small_vector with n value initialized elements.
+   //!
+   //! <b>Throws</b>: If memory allocation throws or T's value initialization throws.
+   //!
+   //! <b>Complexity</b>: Linear to n.
+   explicit small_vector(size_type n)
+      : base_t(n)
+   {}
+
+   //! <b>Effects</b>: Constructs a small_vector with n copies of value.
+   //!
+   //! <b>Throws</b>: If memory allocation throws or T's copy constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to n.
+   small_vector(size_type n, const T &value)
+      : base_t(n, value)
+   {}
+
+   //! <b>Effects</b>: Constructs a small_vector with a copy of the range [first, last).
+   //!
+   //! <b>Throws</b>: If memory allocation throws or T's constructor taking a
+   //!   dereferenced InIt throws.
+   //!
+   //! <b>Complexity</b>: Linear to the range [first, last).
+   template <class InIt>
+   small_vector(InIt first, InIt last)
+      : base_t(first, last)
+   {}
+
+   //! <b>Effects</b>: Constructs a small_vector that allocates memory beyond
+   //!   the internal storage with a copy of a, and inserts a copy of the
+   //!   range [first, last).
+   //!
+   //! <b>Throws</b>: If memory allocation throws or T's constructor taking a
+   //!   dereferenced InIt throws.
+   //!
+   //! <b>Complexity</b>: Linear to the range [first, last).
+   template <class InIt>
+   small_vector(InIt first, InIt last, const Allocator &a)
+      : base_t(first, last, allocator_type(a))
+   {}
+
+   //! <b>Effects</b>: Copy constructs a small_vector.
+   //!
+   //! <b>Throws</b>: If memory allocation throws or T's copy constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to the elements x contains.
+   small_vector(const small_vector &x)
+      : base_t(x)
+   {}
+
+   //! <b>Effects</b>: Move constructor. Takes x's memory if it was allocated,
+   //!   otherwise moves x's elements one by one. x is left empty.
+   //!
+   //! <b>Throws</b>: If T's move constructor throws.
+   //!
+   //! <b>Complexity</b>: Constant if x's elements are in allocated memory,
+   //!   linear otherwise.
+   small_vector(BOOST_RV_REF(small_vector) x)
+      : base_t(x.get_stored_allocator())
+   {  this->priv_move_from_empty(x);  }
+
+   //! <b>Effects</b>: Makes *this contain the same elements as x.
+   //!
+   //! <b>Throws</b>: If memory allocation throws or T's copy constructor/assignment throws.
+   //!
+   //! <b>Complexity</b>: Linear to the number of elements in x.
+   small_vector& operator=(BOOST_COPY_ASSIGN_REF(small_vector) x)
+   {
+      base_t::operator=(static_cast<const base_t &>(x));
+      return *this;
+   }
+
+   //! <b>Effects</b>: Move assignment. All x's values are transferred to *this.
+   //!
+   //! <b>Throws</b>: If T's move constructor/assignment or memory allocation throws.
+   //!
+   //! <b>Complexity</b>: Constant if x's elements are in allocated memory,
+   //!   linear otherwise.
+   small_vector& operator=(BOOST_RV_REF(small_vector) x)
+   {
+      if(&x != this){
+         this->clear();
+         if(this->get_stored_allocator() == x.get_stored_allocator()){
+            this->priv_move_from_empty(x);
+         }
+         else{
+            this->priv_move_elements_from(x);
+         }
+      }
+      return *this;
+   }
+
+   //! <b>Effects</b>: Swaps the contents of *this and x.
+   //!
+   //! <b>Throws</b>: If T's move constructor/assignment throws.
+   //!
+   //! <b>Complexity</b>: Constant if both containers' elements are in allocated
+   //!   memory, linear otherwise.
+   void swap(small_vector &x)
+   {
+      if(&x == this){
+         return;
+      }
+      const bool this_internal = this->priv_is_internal_storage();
+      const bool x_internal    = x.priv_is_internal_storage();
+      if(!this_internal && !x_internal){
+         //Only the buffers are exchanged
+         base_t::swap(x);
+      }
+      else if(this_internal && x_internal){
+         small_vector &shorter = this->size() < x.size() ? *this : x;
+         small_vector &longer  = this->size() < x.size() ? x : *this;
+         const size_type common = shorter.size();
+         for(size_type i = 0; i != common; ++i){
+            boost::container::swap_dispatch(shorter[i], longer[i]);
+         }
+         const iterator tail = longer.begin() + common;
+         shorter.insert( shorter.end()
+                       , boost::make_move_iterator(tail)
+                       , boost::make_move_iterator(longer.end()));
+         longer.erase(tail, longer.end());
+      }
+      else{
+         //Take the allocated buffer first so that only the elements
+         //in the internal storage are moved one by one
+         small_vector &allocated = this_internal ? x : *this;
+         small_vector &internal  = this_internal ? *this : x;
+         small_vector tmp(boost::move(allocated));
+         allocated = boost::move(internal);
+         internal = boost::move(tmp);
+      }
+   }
+
+   //! <b>Effects</b>: Tries to deallocate the excess of memory created
+   //!   with previous allocations. If the elements fit in the internal
+   //!   storage, they are moved back there and the memory is deallocated.
+   //!
+   //! <b>Throws</b>: If memory allocation throws, or T's move constructor throws.
+   //!
+   //! <b>Complexity</b>: Linear to size().
+   void shrink_to_fit()
+   {
+      if(this->capacity() > N){
+         if(this->size() <= N){
+            //tmp takes the allocated buffer and frees it once the
+            //elements are moved back to the internal storage
+            small_vector tmp(boost::move(*this));
+            this->priv_move_elements_from(tmp);
+         }
+         else{
+            base_t::shrink_to_fit();
+         }
+      }
+   }
+
+   /// @cond
+   friend void swap(small_vector &x, small_vector &y)
+   {  x.swap(y);  }
+
+   private:
+   //vector's move constructor, move assignment and swap are declared not to
+   //throw, so they are only used when no element has to be moved
+
+   bool priv_is_internal_storage() const BOOST_CONTAINER_NOEXCEPT
+   {
+      return this->data() == container_detail::to_raw_pointer
+         (this->get_stored_allocator().internal_storage());
+   }
+
+   //pre: this is empty and its allocator is equal to x's
+   void priv_move_from_empty(small_vector &x)
+   {
+      if(x.priv_is_internal_storage()){
+         this->priv_move_elements_from(x);
+      }
+      else{
+         //Taking x's buffer moves no element
+         base_t::swap(x);
+      }
+   }
+
+   //pre: this is empty
+   void priv_move_elements_from(small_vector &x)
+   {
+      this->assign( boost::make_move_iterator(x.begin())
+                  , boost::make_move_iterator(x.end()));
+      x.clear();
+   }
+   /// @endcond
+};
+
+}} // namespace boost::container
+
+#include <boost/container/detail/config_end.hpp>
+
+#endif // BOOST_CONTAINER_SMALL_VECTOR_HPP
@@ -1635,6 +1635,10 @@ class vector
       ::boost::container::uninitialized_move_alloc_n_source
          ( this->m_holder.alloc(), raw_beg, sz, container_detail::to_raw_pointer(p) );
       boost::container::destroy_alloc_n(this->m_holder.alloc(), raw_beg, sz);
+      //Free the old buffer, if any
+      if(this->m_holder.capacity()){
+         this->m_holder.alloc().deallocate(this->m_holder.start(), this->m_holder.capacity());
+      }
       this->m_holder.start(p);
       this->m_holder.capacity(new_cap);
    }
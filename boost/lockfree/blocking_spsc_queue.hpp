@@ -0,0 +1,286 @@
+//  single-producer/single-consumer ringbuffer with blocking push and pop
+//
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_BLOCKING_SPSC_QUEUE_HPP_INCLUDED
+#define BOOST_LOCKFREE_BLOCKING_SPSC_QUEUE_HPP_INCLUDED
+
+#include <boost/assert.hpp>
+#ifdef BOOST_NO_CXX11_DELETED_FUNCTIONS
+#include <boost/noncopyable.hpp>
+#endif
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/futex.hpp>
+#include <boost/lockfree/spsc_queue.hpp>
+
+namespace boost    {
+namespace lockfree {
+namespace detail   {
+
+/* wakes a thread that is waiting for the ringbuffer to change. a waiting thread announces itself, before it checks
+ * the ringbuffer for the last time, and the notifying thread checks for waiters after it changed the ringbuffer.
+ * the seq_cst fences guarantee that at least one of them sees the other's write, so no wakeup is lost, and the
+ * kernel is only entered if a thread is actually waiting */
+class spsc_event
+{
+public:
+    spsc_event(void):
+        epoch_(0), waiting_(0)
+    {}
+
+    int prepare_wait(void)
+    {
+        const int epoch = epoch_.load(memory_order_acquire);
+        waiting_.store(1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        return epoch;
+    }
+
+    void wait(int epoch)
+    {
+        futex_wait(&epoch_, epoch);
+    }
+
+    void cancel_wait(void)
+    {
+        waiting_.store(0, memory_order_relaxed);
+    }
+
+    void notify(void)
+    {
+        atomic_thread_fence(memory_order_seq_cst);
+        if (waiting_.load(memory_order_relaxed)) {
+            epoch_.fetch_add(1, memory_order_release);
+            futex_wake(&epoch_, 1);
+        }
+    }
+
+private:
+    atomic<int> epoch_;
+    atomic<int> waiting_;
+};
+
+} /* namespace detail */
+
+
+/** The blocking_spsc_queue class wraps a \ref boost::lockfree::spsc_queue and adds operations that block, while the
+ *  queue is full or empty.
+ *
+ *  The push and pop operations never enter the kernel themselves. They only wake the other thread, if it is
+ *  actually blocked, so as long as the queue is neither full nor empty, the only overhead compared to spsc_queue is
+ *  a memory fence per operation. On Linux, blocked threads sleep on a futex. On other platforms, they repeatedly
+ *  yield the processor.
+ *
+ *  \b Policies:
+ *  The same as \ref boost::lockfree::spsc_queue.
+ *
+ *  \b Requirements:
+ *  - T must have a default constructor
+ *  - T must be copyable
+ * */
+#ifndef BOOST_DOXYGEN_INVOKED
+template <typename T,
+          class A0 = boost::parameter::void_,
+          class A1 = boost::parameter::void_>
+#else
+template <typename T, ...Options>
+#endif
+class blocking_spsc_queue
+#ifdef BOOST_NO_CXX11_DELETED_FUNCTIONS
+    : boost::noncopyable
+#endif
+{
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef spsc_queue<T, A0, A1> queue_type;
+
+#ifndef BOOST_NO_CXX11_DELETED_FUNCTIONS
+    blocking_spsc_queue(blocking_spsc_queue const &) = delete;
+    blocking_spsc_queue(blocking_spsc_queue &&)      = delete;
+    const blocking_spsc_queue& operator=( const blocking_spsc_queue& ) = delete;
+#endif
+#endif
+
+public:
+    typedef T value_type;
+    typedef typename queue_type::allocator allocator;
+    typedef typename queue_type::size_type size_type;
+
+    /** Constructs a blocking_spsc_queue
+     *
+     *  \pre blocking_spsc_queue must be configured to be sized at compile-time
+     */
+    blocking_spsc_queue(void)
+    {}
+
+    /** Constructs a blocking_spsc_queue for element_count elements
+     *
+     *  \pre blocking_spsc_queue must be configured to be sized at run-time
+     */
+    explicit blocking_spsc_queue(size_type element_count):
+        queue_(element_count)
+    {}
+
+    /** Pushes object t to the ringbuffer.
+     *
+     * \pre only one thread is allowed to push data to the blocking_spsc_queue
+     * \post object will be pushed to the blocking_spsc_queue, unless it is full.
+     * \return true, if the push operation is successful.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool push(T const & t)
+    {
+        if (!queue_.push(t))
+            return false;
+
+        not_empty_.notify();
+        return true;
+    }
+
+    /** Pushes as many objects from the array t as there is space.
+     *
+     * \pre only one thread is allowed to push data to the blocking_spsc_queue
+     * \return number of pushed items
+     *
+     * \note Thread-safe and non-blocking
+     */
+    size_type push(T const * t, size_type size)
+    {
+        const size_type pushed = queue_.push(t, size);
+        if (pushed)
+            not_empty_.notify();
+        return pushed;
+    }
+
+    /** Pushes object t to the ringbuffer, waiting while it is full.
+     *
+     * \pre only one thread is allowed to push data to the blocking_spsc_queue
+     * \post object will be pushed to the blocking_spsc_queue.
+     *
+     * \note Thread-safe. Blocks, if the ringbuffer is full.
+     * */
+    void blocking_push(T const & t)
+    {
+        while (!push(t)) {
+            const int epoch = not_full_.prepare_wait();
+            if (push(t)) {
+                not_full_.cancel_wait();
+                return;
+            }
+            not_full_.wait(epoch);
+            not_full_.cancel_wait();
+        }
+    }
+
+    /** Pops one object from ringbuffer.
+     *
+     * \pre only one thread is allowed to pop data to the blocking_spsc_queue
+     * \post if ringbuffer is not empty, object will be copied to ret.
+     * \return true, if the pop operation is successful, false if ringbuffer was empty.
+     *
+     * \note Thread-safe and non-blocking
+     */
+    bool pop(T & ret)
+    {
+        if (!queue_.pop(ret))
+            return false;
+
+        not_full_.notify();
+        return true;
+    }
+
+    /** Pops a maximum of size objects from ringbuffer.
+     *
+     * \pre only one thread is allowed to pop data to the blocking_spsc_queue
+     * \return number of popped items
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    size_type pop(T * ret, size_type size)
+    {
+        const size_type popped = queue_.pop(ret, size);
+        if (popped)
+            not_full_.notify();
+        return popped;
+    }
+
+    /** Pops one object from ringbuffer, waiting while it is empty.
+     *
+     * \pre only one thread is allowed to pop data to the blocking_spsc_queue
+     * \post object will be copied to ret.
+     *
+     * \note Thread-safe. Blocks, if the ringbuffer is empty.
+     * */
+    void blocking_pop(T & ret)
+    {
+        while (!pop(ret)) {
+            const int epoch = not_empty_.prepare_wait();
+            if (pop(ret)) {
+                not_empty_.cancel_wait();
+                return;
+            }
+            not_empty_.wait(epoch);
+            not_empty_.cancel_wait();
+        }
+    }
+
+    /** consumes all elements in place via a functor
+     *
+     * \copydetails boost::lockfree::spsc_queue::consume_all_spans(Functor & rhs)
+     * */
+    template <typename Functor>
+    size_type consume_all_spans(Functor & f)
+    {
+        const size_type consumed = queue_.consume_all_spans(f);
+        if (consumed)
+            not_full_.notify();
+        return consumed;
+    }
+
+    /// \copydoc boost::lockfree::blocking_spsc_queue::consume_all_spans(Functor & rhs)
+    template <typename Functor>
+    size_type consume_all_spans(Functor const & f)
+    {
+        const size_type consumed = queue_.consume_all_spans(f);
+        if (consumed)
+            not_full_.notify();
+        return consumed;
+    }
+
+    /** Check if the ringbuffer is empty
+     *
+     * \return true, if the ringbuffer is empty, false otherwise
+     * \note Due to the concurrent nature of the ringbuffer the result may be inaccurate.
+     * */
+    bool empty(void)
+    {
+        return queue_.empty();
+    }
+
+    /**
+     * \return true, if implementation is lock-free.
+     *
+     * */
+    bool is_lock_free(void) const
+    {
+        return queue_.is_lock_free();
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    queue_type queue_;
+    detail::spsc_event not_empty_; /* waited on by the pop thread */
+    detail::spsc_event not_full_;  /* waited on by the push thread */
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_BLOCKING_SPSC_QUEUE_HPP_INCLUDED */
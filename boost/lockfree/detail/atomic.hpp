@@ -47,16 +47,20 @@ namespace detail {
 
 #if defined(BOOST_LOCKFREE_NO_HDR_ATOMIC)
 using boost::atomic;
+using boost::atomic_thread_fence;
 using boost::memory_order_acquire;
 using boost::memory_order_consume;
 using boost::memory_order_relaxed;
 using boost::memory_order_release;
+using boost::memory_order_seq_cst;
 #else
 using std::atomic;
+using std::atomic_thread_fence;
 using std::memory_order_acquire;
 using std::memory_order_consume;
 using std::memory_order_relaxed;
 using std::memory_order_release;
+using std::memory_order_seq_cst;
 #endif
 
 }
@@ -65,6 +69,7 @@ using detail::memory_order_acquire;
 using detail::memory_order_consume;
 using detail::memory_order_relaxed;
 using detail::memory_order_release;
+using detail::memory_order_seq_cst;
 
 }}
 
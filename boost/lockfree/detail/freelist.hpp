@@ -17,9 +17,11 @@
 #include <boost/cstdint.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
 
 #include <boost/lockfree/detail/atomic.hpp>
 #include <boost/lockfree/detail/parameter.hpp>
+#include <boost/lockfree/detail/reclamation.hpp>
 #include <boost/lockfree/detail/tagged_ptr.hpp>
 
 namespace boost    {
@@ -41,6 +43,7 @@ class freelist_stack:
 
 public:
     typedef tagged_ptr<T> tagged_node_handle;
+    typedef freelist_guard<freelist_stack> guard;
 
     template <typename Allocator>
     freelist_stack (Allocator const & alloc, std::size_t n = 0):
@@ -404,6 +407,7 @@ class fixed_size_freelist:
 
 public:
     typedef tagged_index tagged_node_handle;
+    typedef freelist_guard<fixed_size_freelist> guard;
 
     template <typename Allocator>
     fixed_size_freelist (Allocator const & alloc, std::size_t count):
@@ -600,7 +604,8 @@ template <typename T,
           typename Alloc,
           bool IsCompileTimeSized,
           bool IsFixedSize,
-          std::size_t Capacity
+          std::size_t Capacity,
+          typename Reclamation = mpl::void_
           >
 struct select_freelist
 {
@@ -612,7 +617,15 @@ struct select_freelist
     typedef typename mpl::if_c<IsCompileTimeSized || IsFixedSize,
                                fixed_size_freelist<T, fixed_sized_storage_type>,
                                freelist_stack<T, Alloc>
-                              >::type type;
+                              >::type freelist_type;
+
+    typedef typename mpl::if_<is_same<Reclamation, epoch_based>,
+                              epoch_pool<T, Alloc>,
+                              typename mpl::if_<is_same<Reclamation, hazard_pointers>,
+                                                hazard_pointer_pool<T, Alloc>,
+                                                freelist_type
+                                               >::type
+                             >::type type;
 };
 
 template <typename T, bool IsNodeBased>
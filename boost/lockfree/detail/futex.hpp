@@ -0,0 +1,60 @@
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_DETAIL_FUTEX_HPP_INCLUDED
+#define BOOST_LOCKFREE_DETAIL_FUTEX_HPP_INCLUDED
+
+/* this file defines the following macro:
+   BOOST_LOCKFREE_HAS_FUTEX: waiting threads are put to sleep in the kernel with the futex system call. on other
+                             platforms, futex_wait yields the processor and futex_wake does nothing.
+                             define BOOST_LOCKFREE_NO_FUTEX to disable the use of futexes.
+*/
+
+#include <boost/static_assert.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+
+#if defined(__linux__) && !defined(BOOST_LOCKFREE_NO_FUTEX)
+#define BOOST_LOCKFREE_HAS_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <boost/smart_ptr/detail/yield_k.hpp>
+#endif
+
+namespace boost    {
+namespace lockfree {
+namespace detail   {
+
+/* blocks the calling thread, while *addr equals expected. may return spuriously */
+inline void futex_wait(atomic<int> * addr, int expected)
+{
+#ifdef BOOST_LOCKFREE_HAS_FUTEX
+    BOOST_STATIC_ASSERT(sizeof(atomic<int>) == sizeof(int));
+    ::syscall(SYS_futex, reinterpret_cast<int*>(addr), FUTEX_WAIT_PRIVATE, expected, 0, 0, 0);
+#else
+    if (addr->load(memory_order_acquire) == expected)
+        boost::detail::yield(32); /* sleeps for a short time */
+#endif
+}
+
+/* wakes up to count threads, which are blocked in futex_wait on addr */
+inline void futex_wake(atomic<int> * addr, int count)
+{
+#ifdef BOOST_LOCKFREE_HAS_FUTEX
+    ::syscall(SYS_futex, reinterpret_cast<int*>(addr), FUTEX_WAKE_PRIVATE, count, 0, 0, 0);
+#else
+    (void)addr;
+    (void)count;
+#endif
+}
+
+} /* namespace detail */
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_DETAIL_FUTEX_HPP_INCLUDED */
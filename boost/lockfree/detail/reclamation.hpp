@@ -0,0 +1,567 @@
+//  memory reclamation for node-based data structures
+//
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_RECLAMATION_HPP_INCLUDED
+#define BOOST_LOCKFREE_RECLAMATION_HPP_INCLUDED
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/tagged_ptr.hpp>
+
+namespace boost    {
+namespace lockfree {
+namespace detail   {
+
+/* the guard of a pool, which never frees nodes while the data structure is alive. the nodes can always be accessed
+ * and are pushed back to the freelist immediately */
+template <typename Pool>
+class freelist_guard
+{
+public:
+    explicit freelist_guard(Pool & pool):
+        pool_(pool)
+    {}
+
+    template <typename Handle>
+    bool protect(std::size_t /* index */, void const * /* pointer */, atomic<Handle> const & /* source */,
+                 Handle & /* expected */) const
+    {
+        return true;
+    }
+
+    void retire(typename Pool::tagged_node_handle const & handle)
+    {
+        pool_.template destruct<true>(handle);
+    }
+
+private:
+    Pool & pool_;
+};
+
+
+/* list of per-thread records of a reclaiming pool.
+ *
+ * records are only freed, when the list is destroyed, so the list can be traversed without any protection. a guard
+ * owns a record from the time it acquires it until it releases it, so the owner can access the non-atomic members of
+ * the record without synchronization. new records are only allocated, if more threads use the pool concurrently
+ * than ever before. */
+template <typename Record, typename Alloc>
+class reclamation_record_list:
+    boost::noncopyable
+{
+    typedef typename Alloc::template rebind<Record>::other record_allocator;
+
+public:
+    explicit reclamation_record_list(Alloc const & alloc):
+        alloc_(alloc), head_(NULL), size_(0)
+    {}
+
+    ~reclamation_record_list(void)
+    {
+        Record * current = head_.load(memory_order_relaxed);
+        while (current) {
+            Record * next = current->next;
+            current->~Record();
+            alloc_.deallocate(current, 1);
+            current = next;
+        }
+    }
+
+    Record * acquire(Alloc const & alloc)
+    {
+        for (Record * current = first(); current; current = current->next) {
+            if (!current->in_use.load(memory_order_relaxed) && !current->in_use.exchange(true, memory_order_acquire))
+                return current;
+        }
+
+        Record * record = alloc_.allocate(1);
+        new(record) Record(alloc);
+
+        Record * old_head = head_.load(memory_order_relaxed);
+        for (;;) {
+            record->next = old_head;
+            if (head_.compare_exchange_weak(old_head, record, memory_order_release, memory_order_relaxed))
+                break;
+        }
+        size_.fetch_add(1, memory_order_relaxed);
+        return record;
+    }
+
+    void release(Record * record)
+    {
+        record->in_use.store(false, memory_order_release);
+    }
+
+    Record * first(void) const
+    {
+        return head_.load(memory_order_acquire);
+    }
+
+    std::size_t size(void) const
+    {
+        return size_.load(memory_order_relaxed);
+    }
+
+private:
+    record_allocator alloc_;
+    atomic<Record*> head_;
+    atomic<std::size_t> size_;
+};
+
+
+/* common part of the reclaiming pools: nodes are allocated from and freed to the allocator.
+ *
+ * the number of nodes, which have been reserved via the constructor or reserve(), bounds the number of live nodes for
+ * bounded allocations. nodes, which have been removed from the data structure, have to be passed to the retire()
+ * function of a guard. destruct() frees a node immediately, so it may only be used for nodes, which have never been
+ * visible to other threads, or if no other thread accesses the data structure. */
+template <typename T,
+          typename Alloc = std::allocator<T>
+         >
+class reclaiming_pool:
+    Alloc
+{
+public:
+    typedef tagged_ptr<T> tagged_node_handle;
+
+    template <typename Allocator>
+    reclaiming_pool (Allocator const & alloc, std::size_t n = 0):
+        Alloc(alloc), node_count_(0), node_limit_(n)
+    {}
+
+    template <bool ThreadSafe>
+    void reserve (std::size_t count)
+    {
+        node_limit_.fetch_add(count, memory_order_relaxed);
+    }
+
+    template <bool ThreadSafe, bool Bounded>
+    T * construct (void)
+    {
+        T * node = allocate<Bounded>();
+        if (node)
+            new(node) T();
+        return node;
+    }
+
+    template <bool ThreadSafe, bool Bounded, typename ArgumentType>
+    T * construct (ArgumentType const & arg)
+    {
+        T * node = allocate<Bounded>();
+        if (node)
+            new(node) T(arg);
+        return node;
+    }
+
+    template <bool ThreadSafe, bool Bounded, typename ArgumentType1, typename ArgumentType2>
+    T * construct (ArgumentType1 const & arg1, ArgumentType2 const & arg2)
+    {
+        T * node = allocate<Bounded>();
+        if (node)
+            new(node) T(arg1, arg2);
+        return node;
+    }
+
+    template <bool ThreadSafe>
+    void destruct (tagged_node_handle tagged_ptr)
+    {
+        free_node(tagged_ptr.get_ptr());
+    }
+
+    template <bool ThreadSafe>
+    void destruct (T * n)
+    {
+        free_node(n);
+    }
+
+    bool is_lock_free(void) const
+    {
+        return node_count_.is_lock_free();
+    }
+
+    T * get_handle(T * pointer) const
+    {
+        return pointer;
+    }
+
+    T * get_handle(tagged_node_handle const & handle) const
+    {
+        return get_pointer(handle);
+    }
+
+    T * get_pointer(tagged_node_handle const & tptr) const
+    {
+        return tptr.get_ptr();
+    }
+
+    T * get_pointer(T * pointer) const
+    {
+        return pointer;
+    }
+
+    T * null_handle(void) const
+    {
+        return NULL;
+    }
+
+protected:
+    template <bool Bounded>
+    T * allocate (void)
+    {
+        std::size_t count = node_count_.fetch_add(1, memory_order_relaxed);
+        if (Bounded && count >= node_limit_.load(memory_order_relaxed)) {
+            node_count_.fetch_sub(1, memory_order_relaxed);
+            return 0;
+        }
+
+        try {
+            return Alloc::allocate(1);
+        } catch (...) {
+            node_count_.fetch_sub(1, memory_order_relaxed);
+            throw;
+        }
+    }
+
+    void free_node (T * n)
+    {
+        n->~T();
+        Alloc::deallocate(n, 1);
+        node_count_.fetch_sub(1, memory_order_relaxed);
+    }
+
+    Alloc const & get_allocator(void) const
+    {
+        return *this;
+    }
+
+private:
+    atomic<std::size_t> node_count_;
+    atomic<std::size_t> node_limit_;
+};
+
+
+/* epoch-based reclamation, as described by Keir Fraser, "Practical lock-freedom".
+ *
+ * a guard announces the global epoch in its record. the global epoch is only advanced, if all records inside a guard
+ * have announced it. a node, which is retired while the global epoch is e, has been removed before, so only guards
+ * that have announced e or e - 1 can access it. once the global epoch reached e + 2, all of these guards have been
+ * destroyed and the node can be freed.
+ *
+ * retired nodes are kept in three lists per record, one for each epoch modulo 3, and are freed by the owner of the
+ * record, when it acquires it or when it reuses the list for a later epoch. */
+template <typename T,
+          typename Alloc = std::allocator<T>
+         >
+class epoch_pool:
+    public reclaiming_pool<T, Alloc>
+{
+    typedef reclaiming_pool<T, Alloc> base_type;
+    typedef std::vector<T*, typename Alloc::template rebind<T*>::other> node_list;
+
+    struct limbo_list
+    {
+        explicit limbo_list(Alloc const & alloc):
+            nodes(alloc), epoch(0)
+        {}
+
+        node_list nodes;
+        std::size_t epoch;
+    };
+
+    struct record
+    {
+        explicit record(Alloc const & alloc):
+            state(0), in_use(true), next(NULL), retire_count(0),
+            limbo0(alloc), limbo1(alloc), limbo2(alloc)
+        {}
+
+        limbo_list & limbo(std::size_t epoch)
+        {
+            switch (epoch % 3) {
+            case 0:  return limbo0;
+            case 1:  return limbo1;
+            default: return limbo2;
+            }
+        }
+
+        atomic<std::size_t> state; /* (epoch << 1) | 1 while a guard owns the record */
+        atomic<bool> in_use;
+        record * next;
+
+        std::size_t retire_count;
+        limbo_list limbo0, limbo1, limbo2;
+    };
+
+    typedef reclamation_record_list<record, Alloc> record_list;
+
+    /* try to advance the global epoch after this number of nodes has been retired via a record */
+    static const std::size_t advance_interval = 64;
+
+public:
+    typedef typename base_type::tagged_node_handle tagged_node_handle;
+
+    class guard:
+        boost::noncopyable
+    {
+    public:
+        explicit guard(epoch_pool & pool):
+            pool_(pool), record_(pool.enter())
+        {}
+
+        ~guard(void)
+        {
+            pool_.leave(record_);
+        }
+
+        template <typename Handle>
+        bool protect(std::size_t /* index */, void const * /* pointer */, atomic<Handle> const & /* source */,
+                     Handle & /* expected */) const
+        {
+            return true;
+        }
+
+        void retire(tagged_node_handle const & handle)
+        {
+            pool_.retire(record_, handle.get_ptr());
+        }
+
+    private:
+        epoch_pool & pool_;
+        record * record_;
+    };
+
+    template <typename Allocator>
+    epoch_pool (Allocator const & alloc, std::size_t n = 0):
+        base_type(alloc, n), records_(base_type::get_allocator()), global_epoch_(0)
+    {}
+
+    ~epoch_pool(void)
+    {
+        for (record * current = records_.first(); current; current = current->next) {
+            free_nodes(current->limbo0);
+            free_nodes(current->limbo1);
+            free_nodes(current->limbo2);
+        }
+    }
+
+private:
+    record * enter(void)
+    {
+        record * r = records_.acquire(base_type::get_allocator());
+
+        std::size_t epoch = global_epoch_.load(memory_order_relaxed);
+        r->state.store((epoch << 1) | 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+
+        for (std::size_t i = 0; i != 3; ++i) {
+            limbo_list & limbo = r->limbo(i);
+            if (!limbo.nodes.empty() && limbo.epoch + 2 <= epoch)
+                free_nodes(limbo);
+        }
+        return r;
+    }
+
+    void leave(record * r)
+    {
+        r->state.store(0, memory_order_release);
+        records_.release(r);
+    }
+
+    void retire(record * r, T * node)
+    {
+        std::size_t epoch = global_epoch_.load(memory_order_seq_cst);
+
+        limbo_list & limbo = r->limbo(epoch);
+        if (limbo.epoch != epoch) {
+            /* the list still holds nodes from epoch - 3 or earlier */
+            free_nodes(limbo);
+            limbo.epoch = epoch;
+        }
+        limbo.nodes.push_back(node);
+
+        if (++r->retire_count % advance_interval == 0)
+            try_advance();
+    }
+
+    void try_advance(void)
+    {
+        std::size_t epoch = global_epoch_.load(memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+
+        for (record * current = records_.first(); current; current = current->next) {
+            std::size_t state = current->state.load(memory_order_relaxed);
+            if ((state & 1) && (state >> 1) != epoch)
+                return;
+        }
+
+        global_epoch_.compare_exchange_strong(epoch, epoch + 1);
+    }
+
+    void free_nodes(limbo_list & limbo)
+    {
+        for (typename node_list::iterator it = limbo.nodes.begin(); it != limbo.nodes.end(); ++it)
+            base_type::free_node(*it);
+        limbo.nodes.clear();
+    }
+
+    record_list records_;
+    atomic<std::size_t> global_epoch_;
+};
+
+
+/* hazard pointer reclamation, as described by Maged Michael, "Hazard Pointers: Safe Memory Reclamation for Lock-Free
+ * Objects".
+ *
+ * before accessing a node, a guard publishes it in one of the hazard pointers of its record and validates, that the
+ * node is still reachable. retired nodes are kept in the record and once there are enough of them, all nodes, which
+ * are not published by any record, are freed. */
+template <typename T,
+          typename Alloc = std::allocator<T>
+         >
+class hazard_pointer_pool:
+    public reclaiming_pool<T, Alloc>
+{
+    typedef reclaiming_pool<T, Alloc> base_type;
+    typedef std::vector<T*, typename Alloc::template rebind<T*>::other> node_list;
+    typedef std::vector<void const*, typename Alloc::template rebind<void const*>::other> pointer_list;
+
+    static const std::size_t hazard_count = 2;
+
+    struct record
+    {
+        explicit record(Alloc const & alloc):
+            in_use(true), next(NULL), retired(alloc), hazard_snapshot(alloc)
+        {
+            for (std::size_t i = 0; i != hazard_count; ++i)
+                hazards[i].store(NULL, memory_order_relaxed);
+        }
+
+        atomic<void const*> hazards[hazard_count];
+        atomic<bool> in_use;
+        record * next;
+
+        node_list retired;
+        pointer_list hazard_snapshot;
+    };
+
+    typedef reclamation_record_list<record, Alloc> record_list;
+
+public:
+    typedef typename base_type::tagged_node_handle tagged_node_handle;
+
+    class guard:
+        boost::noncopyable
+    {
+    public:
+        explicit guard(hazard_pointer_pool & pool):
+            pool_(pool), record_(pool.records_.acquire(pool.get_allocator()))
+        {}
+
+        ~guard(void)
+        {
+            clear();
+            pool_.records_.release(record_);
+        }
+
+        /* publishes pointer in the hazard pointer index and checks, that source still holds the expected value.
+         * otherwise expected is updated and the pointer must not be accessed */
+        template <typename Handle>
+        bool protect(std::size_t index, void const * pointer, atomic<Handle> const & source, Handle & expected)
+        {
+            record_->hazards[index].store(pointer, memory_order_relaxed);
+            atomic_thread_fence(memory_order_seq_cst);
+
+            Handle current = source.load(memory_order_acquire);
+            if (current == expected)
+                return true;
+
+            expected = current;
+            return false;
+        }
+
+        /* the hazard pointers of the guard are released, so no protected node may be accessed afterwards */
+        void retire(tagged_node_handle const & handle)
+        {
+            clear();
+            pool_.retire(record_, handle.get_ptr());
+        }
+
+    private:
+        void clear(void)
+        {
+            for (std::size_t i = 0; i != hazard_count; ++i)
+                record_->hazards[i].store(NULL, memory_order_release);
+        }
+
+        hazard_pointer_pool & pool_;
+        record * record_;
+    };
+
+    template <typename Allocator>
+    hazard_pointer_pool (Allocator const & alloc, std::size_t n = 0):
+        base_type(alloc, n), records_(base_type::get_allocator())
+    {}
+
+    ~hazard_pointer_pool(void)
+    {
+        for (record * current = records_.first(); current; current = current->next) {
+            for (typename node_list::iterator it = current->retired.begin(); it != current->retired.end(); ++it)
+                base_type::free_node(*it);
+        }
+    }
+
+private:
+    void retire(record * r, T * node)
+    {
+        r->retired.push_back(node);
+
+        /* scanning is linear in the number of hazard pointers, so it is amortized over at least as many nodes */
+        if (r->retired.size() >= 64 + 2 * hazard_count * records_.size())
+            scan(r);
+    }
+
+    void scan(record * r)
+    {
+        atomic_thread_fence(memory_order_seq_cst);
+
+        pointer_list & hazards = r->hazard_snapshot;
+        hazards.clear();
+        for (record * current = records_.first(); current; current = current->next) {
+            for (std::size_t i = 0; i != hazard_count; ++i) {
+                void const * hazard = current->hazards[i].load(memory_order_relaxed);
+                if (hazard)
+                    hazards.push_back(hazard);
+            }
+        }
+        std::sort(hazards.begin(), hazards.end());
+
+        typename node_list::iterator kept = r->retired.begin();
+        for (typename node_list::iterator it = r->retired.begin(); it != r->retired.end(); ++it) {
+            if (std::binary_search(hazards.begin(), hazards.end(), static_cast<void const*>(*it)))
+                *kept++ = *it;
+            else
+                base_type::free_node(*it);
+        }
+        r->retired.erase(kept, r->retired.end());
+    }
+
+    record_list records_;
+};
+
+
+} /* namespace detail */
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_RECLAMATION_HPP_INCLUDED */
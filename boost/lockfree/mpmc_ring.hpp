@@ -0,0 +1,495 @@
+//  lock-free bounded multi-producer/multi-consumer ringbuffer
+//  based on the bounded mpmc queue by Dmitry Vyukov
+//
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_MPMC_RING_HPP_INCLUDED
+#define BOOST_LOCKFREE_MPMC_RING_HPP_INCLUDED
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+
+#include <boost/aligned_storage.hpp>
+#include <boost/assert.hpp>
+#ifdef BOOST_NO_CXX11_DELETED_FUNCTIONS
+#include <boost/noncopyable.hpp>
+#endif
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/branch_hints.hpp>
+#include <boost/lockfree/detail/parameter.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+namespace boost    {
+namespace lockfree {
+namespace detail   {
+
+typedef parameter::parameters<boost::parameter::optional<tag::capacity>,
+                              boost::parameter::optional<tag::allocator>
+                             > mpmc_ring_signature;
+
+} /* namespace detail */
+
+
+/** The mpmc_ring class provides a bounded multi-writer/multi-reader fifo queue, pushing and popping is lock-free,
+ *  construction/destruction has to be synchronized.
+ *
+ *  The elements are stored in a ringbuffer of cells. Each cell carries a sequence number, which tells producers and
+ *  consumers whether the cell may be written or read in the current pass over the ringbuffer. A push or pop therefore
+ *  only needs a single compare-and-exchange on the write or read position, and producers and consumers only contend
+ *  with each other when the queue is nearly full or nearly empty. The read and write positions are stored on separate
+ *  cache lines. Unlike boost::lockfree::queue, no nodes are allocated after construction.
+ *
+ *  \b Policies:
+ *  - \c boost::lockfree::capacity<>, optional <br>
+ *    If this template argument is passed to the options, the capacity of the ringbuffer is set at compile-time.
+ *
+ *  - \c boost::lockfree::allocator<>, defaults to \c boost::lockfree::allocator<std::allocator<T>> <br>
+ *    Specifies the allocator that is used to allocate the ringbuffer.
+ *
+ *  The capacity is rounded up to the next power of two.
+ *
+ *  \b Requirements:
+ *  - T must be copy-constructible and assignable
+ *  - The copy constructor of T must not throw
+ * */
+#ifndef BOOST_DOXYGEN_INVOKED
+template <typename T,
+          class A0 = boost::parameter::void_,
+          class A1 = boost::parameter::void_>
+#else
+template <typename T, ...Options>
+#endif
+class mpmc_ring
+#ifdef BOOST_NO_CXX11_DELETED_FUNCTIONS
+    : boost::noncopyable
+#endif
+{
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef typename detail::mpmc_ring_signature::bind<A0, A1>::type bound_args;
+
+    static const bool runtime_sized = !detail::extract_capacity<bound_args>::has_capacity;
+    static const std::size_t compile_time_capacity = detail::extract_capacity<bound_args>::capacity;
+
+    struct cell
+    {
+        atomic<std::size_t> sequence;
+        typename boost::aligned_storage<sizeof(T), boost::alignment_of<T>::value>::type storage;
+
+        T * data(void)
+        {
+            return static_cast<T*>(storage.address());
+        }
+    };
+
+    typedef typename detail::extract_allocator<bound_args, cell>::type cell_allocator;
+
+    struct implementation_defined
+    {
+        typedef cell_allocator allocator;
+        typedef std::size_t size_type;
+    };
+
+#ifndef BOOST_NO_CXX11_DELETED_FUNCTIONS
+    mpmc_ring(mpmc_ring const &) = delete;
+    mpmc_ring(mpmc_ring &&)      = delete;
+    const mpmc_ring& operator=( const mpmc_ring& ) = delete;
+#endif
+
+#endif
+
+public:
+    typedef T value_type;
+    typedef typename implementation_defined::allocator allocator;
+    typedef typename implementation_defined::size_type size_type;
+
+    /** Constructs a mpmc_ring
+     *
+     *  \pre mpmc_ring must be configured to be sized at compile-time
+     */
+    mpmc_ring(void)
+    {
+        BOOST_ASSERT(!runtime_sized);
+        initialize(compile_time_capacity);
+    }
+
+    /** Constructs a mpmc_ring for at least element_count elements
+     *
+     *  \pre mpmc_ring must be configured to be sized at run-time
+     */
+    // @{
+    explicit mpmc_ring(size_type element_count)
+    {
+        BOOST_ASSERT(runtime_sized);
+        initialize(element_count);
+    }
+
+    mpmc_ring(size_type element_count, allocator const & alloc):
+        alloc_(alloc)
+    {
+        BOOST_ASSERT(runtime_sized);
+        initialize(element_count);
+    }
+    // @}
+
+    /** Destroys mpmc_ring, destroying all remaining elements.
+     *
+     * \note Not thread-safe
+     * */
+    ~mpmc_ring(void)
+    {
+        const size_type write_pos = enqueue_pos_.load(memory_order_relaxed);
+        for (size_type pos = dequeue_pos_.load(memory_order_relaxed); pos != write_pos; ++pos)
+            buffer_[pos & mask_].data()->~T();
+
+        for (size_type i = 0; i != mask_ + 1; ++i)
+            buffer_[i].~cell();
+        alloc_.deallocate(buffer_, mask_ + 1);
+    }
+
+    /** \return the number of elements the mpmc_ring can hold
+     * */
+    size_type capacity(void) const
+    {
+        return mask_ + 1;
+    }
+
+    /** Check if the mpmc_ring is empty
+     *
+     * \return true, if the mpmc_ring is empty, false otherwise
+     * \note Due to the concurrent nature of the mpmc_ring the result may be inaccurate.
+     * */
+    bool empty(void) const
+    {
+        return enqueue_pos_.load(memory_order_relaxed) == dequeue_pos_.load(memory_order_relaxed);
+    }
+
+    /**
+     * \return true, if implementation is lock-free.
+     *
+     * */
+    bool is_lock_free(void) const
+    {
+        return enqueue_pos_.is_lock_free() && dequeue_pos_.is_lock_free();
+    }
+
+    /** Pushes object t to the mpmc_ring.
+     *
+     * \post object will be pushed to the mpmc_ring, unless it is full.
+     * \return true, if the push operation is successful.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool push(T const & t)
+    {
+        size_type pos;
+        if (claim_write(1, pos) == 0)
+            return false;
+
+        publish(pos, t);
+        return true;
+    }
+
+    /** Pushes object t to the mpmc_ring.
+     *
+     * Provided for compatibility with boost::lockfree::queue. The mpmc_ring never allocates memory after it has been
+     * constructed, so this is equivalent to push.
+     *
+     * \post object will be pushed to the mpmc_ring, unless it is full.
+     * \return true, if the push operation is successful.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool bounded_push(T const & t)
+    {
+        return push(t);
+    }
+
+    /** Pushes as many objects from the array t as there is space.
+     *
+     * The objects that are pushed occupy consecutive positions in the queue, without objects from other producers
+     * between them.
+     *
+     * \return number of pushed items
+     *
+     * \note Thread-safe and non-blocking
+     */
+    size_type push(T const * t, size_type size)
+    {
+        return push(t, t + size) - t;
+    }
+
+    /** Pushes as many objects from the array t as there is space available.
+     *
+     * \return number of pushed items
+     *
+     * \note Thread-safe and non-blocking
+     */
+    template <size_type size>
+    size_type push(T const (&t)[size])
+    {
+        return push(t, size);
+    }
+
+    /** Pushes as many objects from the range [begin, end) as there is space.
+     *
+     * The objects that are pushed occupy consecutive positions in the queue, and they are claimed with a single
+     * compare-and-exchange.
+     *
+     * \return iterator to the first element, which has not been pushed
+     *
+     * \note Thread-safe and non-blocking
+     */
+    template <typename ConstIterator>
+    ConstIterator push(ConstIterator begin, ConstIterator end)
+    {
+        const size_type input_count = std::distance(begin, end);
+        if (input_count == 0)
+            return begin;
+
+        size_type pos;
+        const size_type count = claim_write(input_count, pos);
+
+        for (size_type i = 0; i != count; ++i, ++begin)
+            publish(pos + i, *begin);
+
+        return begin;
+    }
+
+    /** Pops one object from mpmc_ring.
+     *
+     * \post if mpmc_ring is not empty, object will be copied to ret.
+     * \return true, if the pop operation is successful, false if mpmc_ring was empty.
+     *
+     * \note Thread-safe and non-blocking
+     */
+    bool pop(T & ret)
+    {
+        size_type pos;
+        if (claim_read(1, pos) == 0)
+            return false;
+
+        cell & c = buffer_[pos & mask_];
+        ret = *c.data();
+        release(pos);
+        return true;
+    }
+
+    /** Pops a maximum of size objects from mpmc_ring.
+     *
+     * \return number of popped items
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    size_type pop(T * ret, size_type size)
+    {
+        return pop<T*>(ret, size);
+    }
+
+    /** Pops a maximum of size objects from mpmc_ring.
+     *
+     * \return number of popped items
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    template <size_type size>
+    size_type pop(T (&ret)[size])
+    {
+        return pop(ret, size);
+    }
+
+    /** Pops a maximum of size objects to the output iterator it.
+     *
+     * The popped objects occupied consecutive positions in the queue, and they are claimed with a single
+     * compare-and-exchange.
+     *
+     * \return number of popped items
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    template <typename OutputIterator>
+    size_type pop(OutputIterator it, size_type size)
+    {
+        if (size == 0)
+            return 0;
+
+        size_type pos;
+        const size_type count = claim_read(size, pos);
+
+        for (size_type i = 0; i != count; ++i, ++it) {
+            *it = *buffer_[(pos + i) & mask_].data();
+            release(pos + i);
+        }
+        return count;
+    }
+
+    /** consumes one element via a functor
+     *
+     *  pops one element from the queue and applies the functor on this object
+     *
+     * \returns true, if one element was consumed
+     *
+     * \note Thread-safe and non-blocking, if functor is thread-safe and non-blocking
+     * */
+    template <typename Functor>
+    bool consume_one(Functor & f)
+    {
+        size_type pos;
+        if (claim_read(1, pos) == 0)
+            return false;
+
+        f(*buffer_[pos & mask_].data());
+        release(pos);
+        return true;
+    }
+
+    /// \copydoc boost::lockfree::mpmc_ring::consume_one(Functor & rhs)
+    template <typename Functor>
+    bool consume_one(Functor const & f)
+    {
+        size_type pos;
+        if (claim_read(1, pos) == 0)
+            return false;
+
+        f(*buffer_[pos & mask_].data());
+        release(pos);
+        return true;
+    }
+
+    /** consumes all elements via a functor
+     *
+     * sequentially pops all elements from the queue and applies the functor on each object
+     *
+     * \returns number of elements that are consumed
+     *
+     * \note Thread-safe and non-blocking, if functor is thread-safe and non-blocking
+     * */
+    template <typename Functor>
+    size_type consume_all(Functor & f)
+    {
+        size_type element_count = 0;
+        while (consume_one(f))
+            element_count += 1;
+
+        return element_count;
+    }
+
+    /// \copydoc boost::lockfree::mpmc_ring::consume_all(Functor & rhs)
+    template <typename Functor>
+    size_type consume_all(Functor const & f)
+    {
+        size_type element_count = 0;
+        while (consume_one(f))
+            element_count += 1;
+
+        return element_count;
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    void initialize(size_type element_count)
+    {
+        size_type size = 2;
+        while (size < element_count)
+            size *= 2;
+
+        buffer_ = alloc_.allocate(size);
+        for (size_type i = 0; i != size; ++i) {
+            new (&buffer_[i]) cell();
+            buffer_[i].sequence.store(i, memory_order_relaxed);
+        }
+        mask_ = size - 1;
+
+        enqueue_pos_.store(0, memory_order_relaxed);
+        dequeue_pos_.store(0, memory_order_release);
+    }
+
+    /* claims up to n consecutive cells for writing, starting at pos. a cell at position p may be written, when its
+     * sequence number equals p. returns the number of claimed cells, or 0 if the queue is full */
+    size_type claim_write(size_type n, size_type & pos)
+    {
+        pos = enqueue_pos_.load(memory_order_relaxed);
+        for (;;) {
+            const size_type seq = buffer_[pos & mask_].sequence.load(memory_order_acquire);
+            const std::ptrdiff_t dif = static_cast<std::ptrdiff_t>(seq - pos);
+
+            if (dif == 0) {
+                size_type count = 1;
+                while (count != n
+                       && buffer_[(pos + count) & mask_].sequence.load(memory_order_acquire) == pos + count)
+                    ++count;
+
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + count, memory_order_relaxed))
+                    return count;
+            } else if (detail::unlikely(dif < 0))
+                return 0; /* ringbuffer is full */
+            else
+                pos = enqueue_pos_.load(memory_order_relaxed);
+        }
+    }
+
+    /* claims up to n consecutive cells for reading, starting at pos. a cell at position p may be read, when its
+     * sequence number equals p + 1. returns the number of claimed cells, or 0 if the queue is empty */
+    size_type claim_read(size_type n, size_type & pos)
+    {
+        pos = dequeue_pos_.load(memory_order_relaxed);
+        for (;;) {
+            const size_type seq = buffer_[pos & mask_].sequence.load(memory_order_acquire);
+            const std::ptrdiff_t dif = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+
+            if (dif == 0) {
+                size_type count = 1;
+                while (count != n
+                       && buffer_[(pos + count) & mask_].sequence.load(memory_order_acquire) == pos + count + 1)
+                    ++count;
+
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + count, memory_order_relaxed))
+                    return count;
+            } else if (detail::unlikely(dif < 0))
+                return 0; /* ringbuffer is empty */
+            else
+                pos = dequeue_pos_.load(memory_order_relaxed);
+        }
+    }
+
+    /* constructs the element at a claimed position and hands the cell to the consumers */
+    void publish(size_type pos, T const & t)
+    {
+        cell & c = buffer_[pos & mask_];
+        new (c.data()) T(t);
+        c.sequence.store(pos + 1, memory_order_release);
+    }
+
+    /* destroys the element at a claimed position and hands the cell to the producers of the next pass */
+    void release(size_type pos)
+    {
+        cell & c = buffer_[pos & mask_];
+        c.data()->~T();
+        c.sequence.store(pos + mask_ + 1, memory_order_release);
+    }
+
+    static const int padding_size = BOOST_LOCKFREE_CACHELINE_BYTES;
+
+    cell_allocator alloc_;
+    cell * buffer_;
+    size_type mask_;
+    char padding0_[padding_size]; /* keep the read-only members off the cache lines of the positions */
+    atomic<size_type> enqueue_pos_;
+    char padding1_[padding_size]; /* force enqueue_pos_ and dequeue_pos_ to different cache lines */
+    atomic<size_type> dequeue_pos_;
+    char padding2_[padding_size];
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_MPMC_RING_HPP_INCLUDED */
@@ -21,6 +21,7 @@ namespace lockfree {
 namespace tag { struct allocator ; }
 namespace tag { struct fixed_sized; }
 namespace tag { struct capacity; }
+namespace tag { struct reclamation; }
 
 #endif
 
@@ -52,6 +53,38 @@ struct allocator:
     boost::parameter::template_keyword<tag::allocator, Alloc>
 {};
 
+/** Selects the \b reclamation scheme of a node-based data structure.
+ *
+ *  By default, nodes are kept in a freelist and only returned to the allocator, when the data structure is destroyed.
+ *  With a reclamation scheme, nodes that have been removed are freed as soon as no other thread can access them any
+ *  more, so the memory usage follows the number of elements. Every push allocates its node from the allocator.
+ *  This cannot be combined with \ref boost::lockfree::fixed_sized or \ref boost::lockfree::capacity.
+ *
+ *  The argument is either \ref boost::lockfree::epoch_based or \ref boost::lockfree::hazard_pointers.
+ * */
+template <class Scheme>
+struct reclamation:
+    boost::parameter::template_keyword<tag::reclamation, Scheme>
+{};
+
+/** Epoch-based reclamation.
+ *
+ *  Each operation announces the global epoch, which is only advanced once every thread inside an operation has
+ *  announced it. A removed node is freed two epochs later. This is cheap for the operations, but a thread that is
+ *  preempted inside an operation delays the reclamation of all nodes.
+ * */
+struct epoch_based
+{};
+
+/** Hazard pointer reclamation.
+ *
+ *  Each operation publishes the nodes it is going to access and a removed node is only freed, if no thread has
+ *  published it. This bounds the number of nodes that have not been freed, independent of preempted threads, at the
+ *  cost of an additional memory fence for every node that is accessed.
+ * */
+struct hazard_pointers
+{};
+
 }
 }
 
@@ -30,7 +30,8 @@ namespace lockfree {
 namespace detail   {
 
 typedef parameter::parameters<boost::parameter::optional<tag::allocator>,
-                              boost::parameter::optional<tag::capacity>
+                              boost::parameter::optional<tag::capacity>,
+                              boost::parameter::optional<tag::reclamation>
                              > queue_signature;
 
 } /* namespace detail */
@@ -38,7 +39,8 @@ typedef parameter::parameters<boost::parameter::optional<tag::allocator>,
 
 /** The queue class provides a multi-writer/multi-reader queue, pushing and popping is lock-free,
  *  construction/destruction has to be synchronized. It uses a freelist for memory management,
- *  freed nodes are pushed to the freelist and not returned to the OS before the queue is destroyed.
+ *  freed nodes are pushed to the freelist and not returned to the OS before the queue is destroyed,
+ *  unless a reclamation policy is given.
  *
  *  \b Policies:
  *  - \ref boost::lockfree::fixed_sized, defaults to \c boost::lockfree::fixed_sized<false> \n
@@ -55,6 +57,12 @@ typedef parameter::parameters<boost::parameter::optional<tag::allocator>,
  *  - \ref boost::lockfree::allocator, defaults to \c boost::lockfree::allocator<std::allocator<void>> \n
  *    Specifies the allocator that is used for the internal freelist
  *
+ *  - \ref boost::lockfree::reclamation, optional \n
+ *    If \c boost::lockfree::reclamation<boost::lockfree::epoch_based> or \c boost::lockfree::reclamation<boost::lockfree::hazard_pointers>
+ *    is passed to the options, popped nodes are returned to the allocator, as soon as no other thread can access them.
+ *    Every push allocates a node, so it is only lock-free, if the allocator is. bounded_push fails, if more nodes are in use
+ *    than have been reserved. This option cannot be combined with \c fixed_sized<true> or \c capacity<>.
+ *
  *  \b Requirements:
  *   - T must have a copy constructor
  *   - T must have a trivial assignment operator
@@ -92,6 +100,11 @@ private:
     static const bool fixed_sized = detail::extract_fixed_sized<bound_args>::value;
     static const bool node_based = !(has_capacity || fixed_sized);
     static const bool compile_time_sized = has_capacity;
+    static const bool has_reclamation = detail::extract_reclamation<bound_args>::has_reclamation;
+    typedef typename detail::extract_reclamation<bound_args>::type reclamation_t;
+
+    // nodes in an array cannot be returned to the allocator
+    BOOST_STATIC_ASSERT(!has_reclamation || node_based);
 
     struct BOOST_LOCKFREE_CACHELINE_ALIGNMENT node
     {
@@ -119,7 +132,8 @@ private:
     };
 
     typedef typename detail::extract_allocator<bound_args, node>::type node_allocator;
-    typedef typename detail::select_freelist<node, node_allocator, compile_time_sized, fixed_sized, capacity>::type pool_t;
+    typedef typename detail::select_freelist<node, node_allocator, compile_time_sized, fixed_sized, capacity,
+                                             reclamation_t>::type pool_t;
     typedef typename pool_t::tagged_node_handle tagged_node_handle;
     typedef typename detail::select_tagged_handle<node, node_based>::handle_type handle_type;
 
@@ -292,9 +306,13 @@ private:
         if (n == NULL)
             return false;
 
+        typename pool_t::guard guard(pool);
         for (;;) {
             tagged_node_handle tail = tail_.load(memory_order_acquire);
             node * tail_node = pool.get_pointer(tail);
+            if (!guard.protect(0, tail_node, tail_, tail))
+                continue;
+
             tagged_node_handle next = tail_node->next.load(memory_order_acquire);
             node * next_ptr = pool.get_pointer(next);
 
@@ -374,14 +392,21 @@ public:
     bool pop (U & ret)
     {
         using detail::likely;
+        typename pool_t::guard guard(pool);
         for (;;) {
             tagged_node_handle head = head_.load(memory_order_acquire);
             node * head_ptr = pool.get_pointer(head);
+            if (!guard.protect(0, head_ptr, head_, head))
+                continue;
 
             tagged_node_handle tail = tail_.load(memory_order_acquire);
             tagged_node_handle next = head_ptr->next.load(memory_order_acquire);
             node * next_ptr = pool.get_pointer(next);
 
+            /* next cannot be retired before head */
+            if (!guard.protect(1, next_ptr, head_, head))
+                continue;
+
             tagged_node_handle head2 = head_.load(memory_order_acquire);
             if (likely(head == head2)) {
                 if (pool.get_handle(head) == pool.get_handle(tail)) {
@@ -403,7 +428,7 @@ public:
 
                     tagged_node_handle new_head(pool.get_handle(next), head.get_next_tag());
                     if (head_.compare_exchange_weak(head, new_head)) {
-                        pool.template destruct<true>(head);
+                        guard.retire(head);
                         return true;
                     }
                 }
@@ -45,10 +45,12 @@ class ringbuffer_base
 {
 #ifndef BOOST_DOXYGEN_INVOKED
     typedef std::size_t size_t;
-    static const int padding_size = BOOST_LOCKFREE_CACHELINE_BYTES - sizeof(size_t);
+    static const int padding_size = BOOST_LOCKFREE_CACHELINE_BYTES - 2 * sizeof(size_t);
     atomic<size_t> write_index_;
+    size_t cached_read_index_;  /* last value of read_index_ seen by the push thread */
     char padding1[padding_size]; /* force read_index and write_index to different cache lines */
     atomic<size_t> read_index_;
+    size_t cached_write_index_; /* last value of write_index_ seen by the pop thread */
 
 #ifndef BOOST_NO_CXX11_DELETED_FUNCTIONS
     ringbuffer_base(ringbuffer_base const &) = delete;
@@ -58,9 +60,23 @@ class ringbuffer_base
 
 protected:
     ringbuffer_base(void):
-        write_index_(0), read_index_(0)
+        write_index_(0), cached_read_index_(0), read_index_(0), cached_write_index_(0)
     {}
 
+    /* the cached indices are only refreshed, if they indicate that the ringbuffer is full or empty. this avoids
+     * touching the other thread's cache line on every operation */
+    size_t load_read_index(void)
+    {
+        cached_read_index_ = read_index_.load(memory_order_acquire);
+        return cached_read_index_;
+    }
+
+    size_t load_write_index(void)
+    {
+        cached_write_index_ = write_index_.load(memory_order_acquire);
+        return cached_write_index_;
+    }
+
     static size_t next_index(size_t arg, size_t max_size)
     {
         size_t ret = arg + 1;
@@ -91,7 +107,7 @@ protected:
         const size_t write_index = write_index_.load(memory_order_relaxed);  // only written from push thread
         const size_t next = next_index(write_index, max_size);
 
-        if (next == read_index_.load(memory_order_acquire))
+        if (next == cached_read_index_ && next == load_read_index())
             return false; /* ringbuffer is full */
 
         new (buffer + write_index) T(t); // copy-construct
@@ -112,13 +128,14 @@ protected:
         // FIXME: avoid std::distance
 
         const size_t write_index = write_index_.load(memory_order_relaxed);  // only written from push thread
-        const size_t read_index  = read_index_.load(memory_order_acquire);
-        const size_t avail = write_available(write_index, read_index, max_size);
+        size_t input_count = std::distance(begin, end);
+        size_t avail = write_available(write_index, cached_read_index_, max_size);
+        if (avail < input_count)
+            avail = write_available(write_index, load_read_index(), max_size);
 
         if (avail == 0)
             return begin;
 
-        size_t input_count = std::distance(begin, end);
         input_count = (std::min)(input_count, avail);
 
         size_t new_write_index = write_index + input_count;
@@ -146,9 +163,8 @@ protected:
 
     bool pop (T & ret, T * buffer, size_t max_size)
     {
-        const size_t write_index = write_index_.load(memory_order_acquire);
         const size_t read_index  = read_index_.load(memory_order_relaxed); // only written from pop thread
-        if (empty(write_index, read_index))
+        if (empty(cached_write_index_, read_index) && empty(load_write_index(), read_index))
             return false;
 
         ret = buffer[read_index];
@@ -161,10 +177,11 @@ protected:
 
     size_t pop (T * output_buffer, size_t output_count, T * internal_buffer, size_t max_size)
     {
-        const size_t write_index = write_index_.load(memory_order_acquire);
         const size_t read_index = read_index_.load(memory_order_relaxed); // only written from pop thread
 
-        const size_t avail = read_available(write_index, read_index, max_size);
+        size_t avail = read_available(cached_write_index_, read_index, max_size);
+        if (avail < output_count)
+            avail = read_available(load_write_index(), read_index, max_size);
 
         if (avail == 0)
             return 0;
@@ -195,10 +212,9 @@ protected:
     template <typename OutputIterator>
     size_t pop (OutputIterator it, T * internal_buffer, size_t max_size)
     {
-        const size_t write_index = write_index_.load(memory_order_acquire);
         const size_t read_index = read_index_.load(memory_order_relaxed); // only written from pop thread
 
-        const size_t avail = read_available(write_index, read_index, max_size);
+        const size_t avail = read_available(load_write_index(), read_index, max_size);
         if (avail == 0)
             return 0;
 
@@ -222,6 +238,41 @@ protected:
         read_index_.store(new_read_index, memory_order_release);
         return avail;
     }
+
+    template <typename Functor>
+    size_t consume_spans (Functor & f, T * internal_buffer, size_t max_size)
+    {
+        const size_t read_index = read_index_.load(memory_order_relaxed); // only written from pop thread
+
+        const size_t avail = read_available(load_write_index(), read_index, max_size);
+        if (avail == 0)
+            return 0;
+
+        size_t new_read_index = read_index + avail;
+
+        if (read_index + avail > max_size) {
+            /* the elements wrap around the end of the buffer */
+            const size_t count0 = max_size - read_index;
+            const size_t count1 = avail - count0;
+
+            f(internal_buffer + read_index, count0);
+            f(internal_buffer, count1);
+
+            destroy(internal_buffer + read_index, internal_buffer + max_size);
+            destroy(internal_buffer, internal_buffer + count1);
+
+            new_read_index -= max_size;
+        } else {
+            f(internal_buffer + read_index, avail);
+
+            destroy(internal_buffer + read_index, internal_buffer + read_index + avail);
+            if (new_read_index == max_size)
+                new_read_index = 0;
+        }
+
+        read_index_.store(new_read_index, memory_order_release);
+        return avail;
+    }
 #endif
 
 
@@ -232,6 +283,8 @@ public:
      * */
     void reset(void)
     {
+        cached_read_index_ = 0;
+        cached_write_index_ = 0;
         write_index_.store(0, memory_order_relaxed);
         read_index_.store(0, memory_order_release);
     }
@@ -261,6 +314,13 @@ private:
         return write_index == read_index;
     }
 
+    static void destroy( T * first, T * last )
+    {
+        if (!boost::has_trivial_destructor<T>::value)
+            for (; first != last; ++first)
+                first->~T();
+    }
+
     template< class OutputIterator >
     OutputIterator copy_and_delete( T * first, T * last, OutputIterator out )
     {
@@ -338,6 +398,12 @@ public:
     {
         return ringbuffer_base<T>::pop(it, data(), max_size);
     }
+
+    template <typename Functor>
+    size_type consume_spans(Functor & f)
+    {
+        return ringbuffer_base<T>::consume_spans(f, data(), max_size);
+    }
 };
 
 template <typename T, typename Alloc>
@@ -422,6 +488,12 @@ public:
     {
         return ringbuffer_base<T>::pop(it, array_, max_elements_);
     }
+
+    template <typename Functor>
+    size_type consume_spans(Functor & f)
+    {
+        return ringbuffer_base<T>::consume_spans(f, &*array_, max_elements_);
+    }
 };
 
 template <typename T, typename A0, typename A1>
@@ -707,6 +779,30 @@ public:
 
         return element_count;
     }
+
+    /** consumes all elements in place via a functor
+     *
+     * calls the functor as f(T * first, size_type count) for each contiguous range of elements in the ringbuffer,
+     * at most twice, without copying the elements out of the ringbuffer. the elements are destroyed after the
+     * functor returns.
+     *
+     * \pre only one thread is allowed to pop data to the spsc_queue
+     * \returns number of elements that are consumed
+     *
+     * \note Thread-safe and wait-free, if functor is thread-safe and wait-free
+     * */
+    template <typename Functor>
+    size_type consume_all_spans(Functor & f)
+    {
+        return base_type::consume_spans(f);
+    }
+
+    /// \copydoc boost::lockfree::spsc_queue::consume_all_spans(Functor & rhs)
+    template <typename Functor>
+    size_type consume_all_spans(Functor const & f)
+    {
+        return base_type::consume_spans(f);
+    }
 };
 
 } /* namespace lockfree */
@@ -29,14 +29,16 @@ namespace lockfree {
 namespace detail   {
 
 typedef parameter::parameters<boost::parameter::optional<tag::allocator>,
-                              boost::parameter::optional<tag::capacity>
+                              boost::parameter::optional<tag::capacity>,
+                              boost::parameter::optional<tag::reclamation>
                              > stack_signature;
 
 }
 
 /** The stack class provides a multi-writer/multi-reader stack, pushing and popping is lock-free,
  *  construction/destruction has to be synchronized. It uses a freelist for memory management,
- *  freed nodes are pushed to the freelist and not returned to the OS before the stack is destroyed.
+ *  freed nodes are pushed to the freelist and not returned to the OS before the stack is destroyed,
+ *  unless a reclamation policy is given.
  *
  *  \b Policies:
  *
@@ -54,6 +56,12 @@ typedef parameter::parameters<boost::parameter::optional<tag::allocator>,
  *  - \c boost::lockfree::allocator<>, defaults to \c boost::lockfree::allocator<std::allocator<void>> <br>
  *    Specifies the allocator that is used for the internal freelist
  *
+ *  - \c boost::lockfree::reclamation<>, optional <br>
+ *    If \c boost::lockfree::reclamation<boost::lockfree::epoch_based> or \c boost::lockfree::reclamation<boost::lockfree::hazard_pointers>
+ *    is passed to the options, popped nodes are returned to the allocator, as soon as no other thread can access them.
+ *    Every push allocates a node, so it is only lock-free, if the allocator is. bounded_push fails, if more nodes are in use
+ *    than have been reserved. This option cannot be combined with \c fixed_sized<true> or \c capacity<>.
+ *
  *  \b Requirements:
  *  - T must have a copy constructor
  * */
@@ -82,6 +90,11 @@ private:
     static const bool fixed_sized = detail::extract_fixed_sized<bound_args>::value;
     static const bool node_based = !(has_capacity || fixed_sized);
     static const bool compile_time_sized = has_capacity;
+    static const bool has_reclamation = detail::extract_reclamation<bound_args>::has_reclamation;
+    typedef typename detail::extract_reclamation<bound_args>::type reclamation_t;
+
+    // nodes in an array cannot be returned to the allocator
+    BOOST_STATIC_ASSERT(!has_reclamation || node_based);
 
     struct node
     {
@@ -95,7 +108,8 @@ private:
     };
 
     typedef typename detail::extract_allocator<bound_args, node>::type node_allocator;
-    typedef typename detail::select_freelist<node, node_allocator, compile_time_sized, fixed_sized, capacity>::type pool_t;
+    typedef typename detail::select_freelist<node, node_allocator, compile_time_sized, fixed_sized, capacity,
+                                             reclamation_t>::type pool_t;
     typedef typename pool_t::tagged_node_handle tagged_node_handle;
 
     // check compile-time capacity
@@ -493,6 +507,7 @@ public:
     template <typename Functor>
     bool consume_one(Functor & f)
     {
+        typename pool_t::guard guard(pool);
         tagged_node_handle old_tos = tos.load(detail::memory_order_consume);
 
         for (;;) {
@@ -500,11 +515,14 @@ public:
             if (!old_tos_pointer)
                 return false;
 
+            if (!guard.protect(0, old_tos_pointer, tos, old_tos))
+                continue;
+
             tagged_node_handle new_tos(old_tos_pointer->next, old_tos.get_next_tag());
 
             if (tos.compare_exchange_weak(old_tos, new_tos)) {
                 f(old_tos_pointer->v);
-                pool.template destruct<true>(old_tos);
+                guard.retire(old_tos);
                 return true;
             }
         }
@@ -514,6 +532,7 @@ public:
     template <typename Functor>
     bool consume_one(Functor const & f)
     {
+        typename pool_t::guard guard(pool);
         tagged_node_handle old_tos = tos.load(detail::memory_order_consume);
 
         for (;;) {
@@ -521,11 +540,14 @@ public:
             if (!old_tos_pointer)
                 return false;
 
+            if (!guard.protect(0, old_tos_pointer, tos, old_tos))
+                continue;
+
             tagged_node_handle new_tos(old_tos_pointer->next, old_tos.get_next_tag());
 
             if (tos.compare_exchange_weak(old_tos, new_tos)) {
                 f(old_tos_pointer->v);
-                pool.template destruct<true>(old_tos);
+                guard.retire(old_tos);
                 return true;
             }
         }
@@ -0,0 +1,587 @@
+//  lock-free hash map, based on split-ordered lists from
+//  Shalev, O. and Shavit, N.,
+//  "Split-Ordered Lists: Lock-Free Extensible Hash Tables"
+//
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_UNORDERED_MAP_HPP_INCLUDED
+#define BOOST_LOCKFREE_UNORDERED_MAP_HPP_INCLUDED
+
+#include <climits>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+#include <boost/assert.hpp>
+#include <boost/functional/hash.hpp>
+#ifdef BOOST_NO_CXX11_DELETED_FUNCTIONS
+#include <boost/noncopyable.hpp>
+#endif
+#include <boost/static_assert.hpp>
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/detail/parameter.hpp>
+#include <boost/lockfree/detail/reclamation.hpp>
+#include <boost/lockfree/detail/tagged_ptr.hpp>
+
+namespace boost    {
+namespace lockfree {
+namespace detail   {
+
+typedef parameter::parameters<boost::parameter::optional<tag::allocator>
+                             > unordered_map_signature;
+
+inline std::size_t reverse_bits(std::size_t value)
+{
+    std::size_t shift = sizeof(std::size_t) * CHAR_BIT;
+    std::size_t mask = ~std::size_t(0);
+    while ((shift >>= 1) > 0) {
+        mask ^= mask << shift;
+        value = ((value >> shift) & mask) | ((value << shift) & ~mask);
+    }
+    return value;
+}
+
+/* index of the highest set bit */
+inline std::size_t log2_floor(std::size_t value)
+{
+    std::size_t ret = 0;
+    for (std::size_t shift = sizeof(std::size_t) * CHAR_BIT / 2; shift > 0; shift >>= 1) {
+        if (value >> shift) {
+            value >>= shift;
+            ret += shift;
+        }
+    }
+    return ret;
+}
+
+} /* namespace detail */
+
+/** The unordered_map class provides a multi-writer/multi-reader hash map. Finding, inserting and erasing elements is
+ *  lock-free, construction/destruction has to be synchronized.
+ *
+ *  All elements are kept in a single linked list, which is sorted by the bit-reversed hash values. Every bucket points
+ *  to a sentinel node inside this list, so when the number of buckets is doubled, the elements do not have to be moved:
+ *  the new buckets are initialized lazily by inserting a sentinel node into the list of their parent bucket.
+ *  Erased elements are marked in the tag of their \c next pointer and then unlinked. They are freed with epoch-based
+ *  reclamation, once no other thread can access them any more.
+ *
+ *  \b Policies:
+ *  - \ref boost::lockfree::allocator, defaults to \c boost::lockfree::allocator<std::allocator<void>> \n
+ *    Specifies the allocator that is used for the nodes and buckets
+ *
+ *  \b Requirements:
+ *   - Key and T must have a copy constructor
+ *   - T must be assignable
+ *   - Hash must be a function object returning std::size_t
+ *   - Pred must be an equivalence relation, which is compatible with Hash
+ * */
+#ifndef BOOST_DOXYGEN_INVOKED
+template <typename Key,
+          typename T,
+          class Hash = boost::hash<Key>,
+          class Pred = std::equal_to<Key>,
+          class A0 = boost::parameter::void_>
+#else
+template <typename Key, typename T, class Hash, class Pred, ...Options>
+#endif
+class unordered_map
+#ifdef BOOST_NO_CXX11_DELETED_FUNCTIONS
+    : boost::noncopyable
+#endif
+{
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    typedef typename detail::unordered_map_signature::bind<A0>::type bound_args;
+
+    struct node
+    {
+        typedef detail::tagged_ptr<node> tagged_node_ptr;
+
+        explicit node(std::size_t key):
+            so_key(key), next(tagged_node_ptr(NULL, 0))
+        {}
+
+        /* the tag of next is set, once the node has been erased */
+        const std::size_t so_key;
+        detail::atomic<tagged_node_ptr> next;
+    };
+
+    typedef typename node::tagged_node_ptr tagged_node_ptr;
+
+    struct value_node:
+        node
+    {
+        value_node(std::size_t key, std::pair<const Key, T> const & v):
+            node(key), value(v)
+        {}
+
+        std::pair<const Key, T> value;
+    };
+
+    typedef detail::atomic<node*> bucket;
+
+    typedef typename detail::extract_allocator<bound_args, value_node>::type value_node_allocator;
+    typedef typename value_node_allocator::template rebind<node>::other node_allocator;
+    typedef typename value_node_allocator::template rebind<bucket>::other bucket_allocator;
+    typedef detail::epoch_pool<value_node, value_node_allocator> pool_t;
+    typedef typename pool_t::guard guard;
+
+    /* the highest bit of the hash is always set for elements, so it is the lowest bit of their split-ordered key */
+    static const std::size_t segment_count = sizeof(std::size_t) * CHAR_BIT - 1;
+    static const std::size_t max_bucket_count = std::size_t(1) << segment_count;
+    static const std::size_t max_load_factor = 2;
+
+    struct position
+    {
+        detail::atomic<tagged_node_ptr> * prev;
+        node * cur;
+        node * next;
+    };
+
+    struct implementation_defined
+    {
+        typedef value_node_allocator allocator;
+        typedef std::size_t size_type;
+    };
+
+#endif
+
+#ifndef BOOST_NO_CXX11_DELETED_FUNCTIONS
+    unordered_map(unordered_map const &) = delete;
+    unordered_map(unordered_map &&)      = delete;
+    const unordered_map& operator=( const unordered_map& ) = delete;
+#endif
+
+public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef std::pair<const Key, T> value_type;
+    typedef Hash hasher;
+    typedef Pred key_equal;
+    typedef typename implementation_defined::allocator allocator;
+    typedef typename implementation_defined::size_type size_type;
+
+    /** Constructs an unordered_map with at least bucket_count buckets.
+     *
+     *  \note The number of buckets is rounded up to a power of two. It is doubled, whenever there are more than two
+     *        elements per bucket.
+     * */
+    explicit unordered_map(size_type bucket_count = 16,
+                           hasher const & hf = hasher(),
+                           key_equal const & eq = key_equal(),
+                           allocator const & alloc = allocator()):
+        hash_function_(hf), key_eq_(eq),
+        node_allocator_(alloc), bucket_allocator_(alloc),
+        pool_(alloc, 0), size_(0), bucket_count_(2)
+    {
+        initialize(bucket_count);
+    }
+
+    /** Destroys the unordered_map and frees all nodes.
+     *
+     *  \note not thread-safe
+     * */
+    ~unordered_map(void)
+    {
+        node * current = segments_[0].load(memory_order_relaxed)[0].load(memory_order_relaxed);
+        while (current) {
+            node * next = current->next.load(memory_order_relaxed).get_ptr();
+            if (is_element(current))
+                pool_.template destruct<false>(static_cast<value_node*>(current));
+            else {
+                current->~node();
+                node_allocator_.deallocate(current, 1);
+            }
+            current = next;
+        }
+
+        for (std::size_t i = 0; i != segment_count; ++i) {
+            bucket * segment = segments_[i].load(memory_order_relaxed);
+            if (segment)
+                free_segment(segment, segment_size(i));
+        }
+    }
+
+    /** Inserts a copy of value, unless the map already contains an element with an equivalent key.
+     *
+     * \returns true, if the element has been inserted.
+     *
+     * \note Thread-safe. The node is allocated from the allocator, so the operation is only lock-free, if the allocator is.
+     * \throws if memory allocator throws
+     * */
+    bool insert(value_type const & value)
+    {
+        const std::size_t hash = hash_function_(value.first);
+        const std::size_t so_key = element_key(hash);
+
+        value_node * n = pool_.template construct<true, false>(so_key, value);
+
+        guard g(pool_);
+        node * start = get_bucket(hash, g);
+
+        for (;;) {
+            position pos;
+            if (find_position(start, so_key, &value.first, pos, g)) {
+                pool_.template destruct<true>(n);
+                return false;
+            }
+
+            n->next.store(tagged_node_ptr(pos.cur, 0), memory_order_relaxed);
+            tagged_node_ptr expected(pos.cur, 0);
+            if (pos.prev->compare_exchange_strong(expected, tagged_node_ptr(n, 0)))
+                break;
+        }
+
+        const std::size_t size = size_.fetch_add(1, memory_order_relaxed) + 1;
+        std::size_t bucket_count = bucket_count_.load(memory_order_relaxed);
+        if (size > bucket_count * max_load_factor && bucket_count < max_bucket_count)
+            bucket_count_.compare_exchange_strong(bucket_count, bucket_count * 2, memory_order_relaxed);
+        return true;
+    }
+
+    /** Inserts the element (key, value), unless the map already contains an element with an equivalent key.
+     *
+     * \returns true, if the element has been inserted.
+     *
+     * \note Thread-safe. The node is allocated from the allocator, so the operation is only lock-free, if the allocator is.
+     * \throws if memory allocator throws
+     * */
+    bool insert(key_type const & key, mapped_type const & value)
+    {
+        return insert(value_type(key, value));
+    }
+
+    /** Erases the element with a key equivalent to key.
+     *
+     * \returns true, if an element has been erased.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool erase(key_type const & key)
+    {
+        const std::size_t hash = hash_function_(key);
+        const std::size_t so_key = element_key(hash);
+
+        guard g(pool_);
+        node * start = get_bucket(hash, g);
+
+        for (;;) {
+            position pos;
+            if (!find_position(start, so_key, &key, pos, g))
+                return false;
+
+            /* mark the node as erased, this fails if the node is erased concurrently or if a node is inserted after it */
+            tagged_node_ptr next(pos.next, 0);
+            if (!pos.cur->next.compare_exchange_strong(next, tagged_node_ptr(pos.next, 1)))
+                continue;
+
+            size_.fetch_sub(1, memory_order_relaxed);
+
+            tagged_node_ptr expected(pos.cur, 0);
+            if (pos.prev->compare_exchange_strong(expected, tagged_node_ptr(pos.next, 0)))
+                g.retire(typename pool_t::tagged_node_handle(static_cast<value_node*>(pos.cur)));
+            else
+                /* the predecessor has changed, find_position unlinks the node */
+                find_position(start, so_key, &key, pos, g);
+            return true;
+        }
+    }
+
+    /** Looks up the element with a key equivalent to key.
+     *
+     * \post if an element has been found, its mapped value is copied to value.
+     * \returns true, if an element has been found.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    bool find(key_type const & key, mapped_type & value) const
+    {
+        const std::size_t hash = hash_function_(key);
+        const std::size_t so_key = element_key(hash);
+
+        guard g(pool_);
+        node * start = get_bucket(hash, g);
+
+        position pos;
+        if (!find_position(start, so_key, &key, pos, g))
+            return false;
+
+        value = static_cast<value_node*>(pos.cur)->value.second;
+        return true;
+    }
+
+    /**
+     * \returns 1, if the map contains an element with a key equivalent to key, 0 otherwise.
+     *
+     * \note Thread-safe and non-blocking
+     * */
+    size_type count(key_type const & key) const
+    {
+        const std::size_t hash = hash_function_(key);
+        const std::size_t so_key = element_key(hash);
+
+        guard g(pool_);
+        node * start = get_bucket(hash, g);
+
+        position pos;
+        return find_position(start, so_key, &key, pos, g) ? 1 : 0;
+    }
+
+    /**
+     * \return number of elements
+     *
+     * \note The result is only accurate, if no other thread modifies the map.
+     * */
+    size_type size(void) const
+    {
+        return size_.load(memory_order_relaxed);
+    }
+
+    /**
+     * \return true, if the map is empty
+     *
+     * \note The result is only accurate, if no other thread modifies the map.
+     * */
+    bool empty(void) const
+    {
+        return size() == 0;
+    }
+
+    /**
+     * \return number of buckets
+     * */
+    size_type bucket_count(void) const
+    {
+        return bucket_count_.load(memory_order_relaxed);
+    }
+
+    /**
+     * \return true, if implementation is lock-free.
+     *
+     * \warning It only checks, if the node pointers and the bucket array can be modified in a lock-free manner.
+     * */
+    bool is_lock_free(void) const
+    {
+        return segments_[0].load(memory_order_relaxed)[0].is_lock_free() &&
+               segments_[0].load(memory_order_relaxed)[0].load(memory_order_relaxed)->next.is_lock_free() &&
+               pool_.is_lock_free();
+    }
+
+    hasher hash_function(void) const
+    {
+        return hash_function_;
+    }
+
+    key_equal key_eq(void) const
+    {
+        return key_eq_;
+    }
+
+private:
+#ifndef BOOST_DOXYGEN_INVOKED
+    void initialize(size_type bucket_count)
+    {
+        for (std::size_t i = 0; i != segment_count; ++i)
+            segments_[i].store(NULL, memory_order_relaxed);
+
+        bucket * segment = allocate_segment(segment_size(0));
+        segments_[0].store(segment, memory_order_relaxed);
+
+        node * head = node_allocator_.allocate(1);
+        new(head) node(0);
+        segment[0].store(head, memory_order_relaxed);
+
+        std::size_t count = 2;
+        while (count < bucket_count && count < max_bucket_count)
+            count *= 2;
+        bucket_count_.store(count, memory_order_release);
+    }
+
+    static bool is_element(node const * n)
+    {
+        return n->so_key & 1;
+    }
+
+    static std::size_t element_key(std::size_t hash)
+    {
+        return detail::reverse_bits(hash | max_bucket_count);
+    }
+
+    static std::size_t bucket_key(std::size_t index)
+    {
+        return detail::reverse_bits(index);
+    }
+
+    static std::size_t segment_size(std::size_t segment_index)
+    {
+        return segment_index == 0 ? 2 : std::size_t(1) << segment_index;
+    }
+
+    /* segment 0 holds the buckets 0 and 1, segment i > 0 holds the buckets [2^i, 2^(i+1)) */
+    bucket & bucket_slot(std::size_t index) const
+    {
+        const std::size_t segment_index = index < 2 ? 0 : detail::log2_floor(index);
+        const std::size_t offset = segment_index == 0 ? index : index - segment_size(segment_index);
+
+        bucket * segment = segments_[segment_index].load(memory_order_acquire);
+        if (!segment) {
+            bucket * new_segment = allocate_segment(segment_size(segment_index));
+            if (segments_[segment_index].compare_exchange_strong(segment, new_segment))
+                segment = new_segment;
+            else
+                free_segment(new_segment, segment_size(segment_index));
+        }
+        return segment[offset];
+    }
+
+    bucket * allocate_segment(std::size_t size) const
+    {
+        bucket * segment = bucket_allocator_.allocate(size);
+        for (std::size_t i = 0; i != size; ++i)
+            new(segment + i) bucket(NULL);
+        return segment;
+    }
+
+    void free_segment(bucket * segment, std::size_t size) const
+    {
+        for (std::size_t i = 0; i != size; ++i)
+            segment[i].~bucket();
+        bucket_allocator_.deallocate(segment, size);
+    }
+
+    node * get_bucket(std::size_t hash, guard & g) const
+    {
+        const std::size_t index = hash & (bucket_count_.load(memory_order_acquire) - 1);
+        node * sentinel = bucket_slot(index).load(memory_order_acquire);
+        if (sentinel)
+            return sentinel;
+        return initialize_bucket(index, g);
+    }
+
+    /* inserts the sentinel node of the bucket into the list of its parent bucket, which is initialized first, if
+     * necessary. when several threads initialize the same bucket, all of them use the node that has been inserted */
+    node * initialize_bucket(std::size_t index, guard & g) const
+    {
+        const std::size_t parent_index = index & ~(std::size_t(1) << detail::log2_floor(index));
+        node * parent = bucket_slot(parent_index).load(memory_order_acquire);
+        if (!parent)
+            parent = initialize_bucket(parent_index, g);
+
+        const std::size_t so_key = bucket_key(index);
+        node * sentinel = node_allocator_.allocate(1);
+        new(sentinel) node(so_key);
+
+        for (;;) {
+            position pos;
+            if (find_position(parent, so_key, NULL, pos, g)) {
+                sentinel->~node();
+                node_allocator_.deallocate(sentinel, 1);
+                sentinel = pos.cur;
+                break;
+            }
+
+            sentinel->next.store(tagged_node_ptr(pos.cur, 0), memory_order_relaxed);
+            tagged_node_ptr expected(pos.cur, 0);
+            if (pos.prev->compare_exchange_strong(expected, tagged_node_ptr(sentinel, 0)))
+                break;
+        }
+
+        bucket_slot(index).store(sentinel, memory_order_release);
+        return sentinel;
+    }
+
+    bool matches(node const * n, std::size_t so_key, key_type const * key) const
+    {
+        if (n->so_key != so_key)
+            return false;
+
+        /* sentinel keys are even and element keys are odd */
+        if (!key)
+            return true;
+        return key_eq_(static_cast<value_node const*>(n)->value.first, *key);
+    }
+
+    /* Michael's variant of Harris' list search: finds the first node in the list after start, which is not ordered
+     * before (so_key, key), and unlinks all erased nodes it encounters. the list is ordered by so_key only, so all nodes
+     * with an equal so_key have to be compared */
+    bool find_position(node * start, std::size_t so_key, key_type const * key, position & pos, guard & g) const
+    {
+        for (;;) {
+            int result = try_find_position(start, so_key, key, pos, g);
+            if (result != retry)
+                return result == found;
+        }
+    }
+
+    enum find_result
+    {
+        not_found,
+        found,
+        retry
+    };
+
+    int try_find_position(node * start, std::size_t so_key, key_type const * key, position & pos, guard & g) const
+    {
+        detail::atomic<tagged_node_ptr> * prev = &start->next;
+        node * cur = prev->load(memory_order_acquire).get_ptr();
+
+        for (;;) {
+            if (!cur) {
+                pos.prev = prev;
+                pos.cur = NULL;
+                pos.next = NULL;
+                return not_found;
+            }
+
+            tagged_node_ptr next = cur->next.load(memory_order_acquire);
+            if (prev->load(memory_order_acquire) != tagged_node_ptr(cur, 0))
+                return retry;
+
+            if (next.get_tag() == 0) {
+                if (cur->so_key > so_key) {
+                    pos.prev = prev;
+                    pos.cur = cur;
+                    pos.next = next.get_ptr();
+                    return not_found;
+                }
+
+                if (matches(cur, so_key, key)) {
+                    pos.prev = prev;
+                    pos.cur = cur;
+                    pos.next = next.get_ptr();
+                    return found;
+                }
+
+                prev = &cur->next;
+            } else {
+                /* only elements are erased */
+                tagged_node_ptr expected(cur, 0);
+                if (!prev->compare_exchange_strong(expected, tagged_node_ptr(next.get_ptr(), 0)))
+                    return retry;
+                g.retire(typename pool_t::tagged_node_handle(static_cast<value_node*>(cur)));
+            }
+            cur = next.get_ptr();
+        }
+    }
+
+    hasher hash_function_;
+    key_equal key_eq_;
+    mutable node_allocator node_allocator_;
+    mutable bucket_allocator bucket_allocator_;
+    mutable pool_t pool_;
+
+    detail::atomic<std::size_t> size_;
+    detail::atomic<std::size_t> bucket_count_;
+    mutable detail::atomic<bucket*> segments_[segment_count];
+#endif
+};
+
+} /* namespace lockfree */
+} /* namespace boost */
+
+#endif /* BOOST_LOCKFREE_UNORDERED_MAP_HPP_INCLUDED */
@@ -0,0 +1,47 @@
+#ifndef BOOST_THREAD_ADAPTIVE_MUTEX_HPP
+#define BOOST_THREAD_ADAPTIVE_MUTEX_HPP
+
+//  adaptive_mutex.hpp
+//
+//  (C) Copyright 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/thread/detail/platform.hpp>
+#if defined(BOOST_THREAD_PLATFORM_WIN32)
+#include <boost/thread/win32/mutex.hpp>
+namespace boost
+{
+  // the Windows timed_mutex already spins before it waits on an event
+  typedef timed_mutex adaptive_mutex;
+}
+#elif defined(BOOST_THREAD_PLATFORM_PTHREAD)
+#include <boost/thread/pthread/adaptive_mutex.hpp>
+#else
+#error "Boost threads unavailable on this platform"
+#endif
+
+#include <boost/thread/lockable_traits.hpp>
+
+namespace boost
+{
+  namespace sync
+  {
+#if defined BOOST_THREAD_NO_AUTO_DETECT_MUTEX_TYPES && defined BOOST_THREAD_PLATFORM_PTHREAD
+    template<>
+    struct is_basic_lockable<adaptive_mutex>
+    {
+      BOOST_STATIC_CONSTANT(bool, value = true);
+    };
+    template<>
+    struct is_lockable<adaptive_mutex>
+    {
+      BOOST_STATIC_CONSTANT(bool, value = true);
+    };
+#endif
+  }
+}
+
+#endif
@@ -546,6 +546,14 @@ namespace boost
         void detach();
 
         static unsigned hardware_concurrency() BOOST_NOEXCEPT;
+        // Topology of the machine, the functions return 0 if it is unknown.
+        // number of cores, without counting the hardware threads of a core twice
+        static unsigned physical_concurrency() BOOST_NOEXCEPT;
+        static unsigned numa_node_count() BOOST_NOEXCEPT;
+        // line size, size and number of logical CPUs sharing it, of the data or unified cache of the given level
+        static std::size_t cache_line_size() BOOST_NOEXCEPT;
+        static std::size_t cache_size(unsigned level) BOOST_NOEXCEPT;
+        static unsigned cache_sharing(unsigned level) BOOST_NOEXCEPT;
 
 #define BOOST_THREAD_DEFINES_THREAD_NATIVE_HANDLE
         typedef detail::thread_data_base::native_handle_type native_handle_type;
@@ -604,6 +612,12 @@ namespace boost
         bool BOOST_THREAD_DECL interruption_requested() BOOST_NOEXCEPT;
 #endif
 
+        // Restrict the calling thread to a CPU or to the CPUs of a NUMA node, and name it. They return false, if
+        // the platform does not support it. The name is truncated to 15 characters.
+        bool BOOST_THREAD_DECL set_affinity(unsigned cpu) BOOST_NOEXCEPT;
+        bool BOOST_THREAD_DECL set_numa_node(unsigned node) BOOST_NOEXCEPT;
+        bool BOOST_THREAD_DECL set_name(const char* name) BOOST_NOEXCEPT;
+
 #if defined BOOST_THREAD_USES_DATETIME
         inline BOOST_SYMBOL_VISIBLE void sleep(xtime const& abs_time)
         {
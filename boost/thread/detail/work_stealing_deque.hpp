@@ -0,0 +1,169 @@
+#ifndef BOOST_THREAD_DETAIL_WORK_STEALING_DEQUE_HPP
+#define BOOST_THREAD_DETAIL_WORK_STEALING_DEQUE_HPP
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Vicente J. Botet Escriba 2013. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/thread for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/detail/delete.hpp>
+#include <boost/atomic.hpp>
+#include <boost/assert.hpp>
+#include <cstddef>
+#include <vector>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+  namespace thread_detail
+  {
+
+    // Dynamic circular work-stealing deque, as described by D. Chase and Y. Lev, with the memory orders of
+    // N. M. Le, A. Pop, A. Cohen and F. Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak Memory Models".
+    //
+    // Only the owner thread may push and pop, at the bottom of the deque. Any thread may steal from the top.
+    // ValueType must be trivially copyable and is usually a pointer.
+    template <typename ValueType>
+    class work_stealing_deque
+    {
+    public:
+      typedef ValueType value_type;
+      typedef std::size_t size_type;
+
+      BOOST_THREAD_NO_COPYABLE(work_stealing_deque)
+
+      explicit work_stealing_deque(size_type capacity = 256) :
+        top_(0), bottom_(0), array_(new circular_array(capacity))
+      {
+        BOOST_ASSERT(capacity > 0 && (capacity & (capacity - 1)) == 0);
+      }
+
+      ~work_stealing_deque()
+      {
+        delete array_.load(memory_order_relaxed);
+        for (std::size_t i = 0; i < retired_.size(); ++i)
+          delete retired_[i];
+      }
+
+      /// Owner only. Pushes x at the bottom, growing the deque if it is full.
+      void push(value_type x)
+      {
+        const std::ptrdiff_t b = bottom_.load(memory_order_relaxed);
+        const std::ptrdiff_t t = top_.load(memory_order_acquire);
+        circular_array* a = array_.load(memory_order_relaxed);
+        if (b - t > static_cast<std::ptrdiff_t>(a->size()) - 1)
+          a = grow(a, t, b);
+        a->store(b, x);
+        bottom_.store(b + 1, memory_order_release);
+      }
+
+      /// Owner only. Pops the most recently pushed element.
+      bool pop(value_type& x)
+      {
+        const std::ptrdiff_t b = bottom_.load(memory_order_relaxed) - 1;
+        circular_array* a = array_.load(memory_order_relaxed);
+        bottom_.store(b, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        std::ptrdiff_t t = top_.load(memory_order_relaxed);
+        if (t > b)
+        {
+          bottom_.store(b + 1, memory_order_relaxed);
+          return false;
+        }
+        x = a->load(b);
+        if (t != b)
+          return true;
+        // the last element, race against the thieves
+        const bool won = top_.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed);
+        bottom_.store(b + 1, memory_order_relaxed);
+        return won;
+      }
+
+      /// Any thread. Steals the least recently pushed element. Fails, if the deque is empty or another thread
+      /// won the race for the element.
+      bool steal(value_type& x)
+      {
+        std::ptrdiff_t t = top_.load(memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        const std::ptrdiff_t b = bottom_.load(memory_order_acquire);
+        if (t >= b)
+          return false;
+        circular_array* a = array_.load(memory_order_acquire);
+        x = a->load(t);
+        return top_.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed);
+      }
+
+      /// The result is only a snapshot, if called by a thread other than the owner.
+      bool empty() const
+      {
+        const std::ptrdiff_t b = bottom_.load(memory_order_relaxed);
+        const std::ptrdiff_t t = top_.load(memory_order_relaxed);
+        return b <= t;
+      }
+
+    private:
+      class circular_array
+      {
+      public:
+        BOOST_THREAD_NO_COPYABLE(circular_array)
+
+        explicit circular_array(size_type size) :
+          mask_(size - 1), buffer_(new atomic<value_type>[size])
+        {
+        }
+        ~circular_array()
+        {
+          delete[] buffer_;
+        }
+
+        size_type size() const
+        {
+          return mask_ + 1;
+        }
+        value_type load(std::ptrdiff_t index) const
+        {
+          return buffer_[static_cast<size_type>(index) & mask_].load(memory_order_relaxed);
+        }
+        void store(std::ptrdiff_t index, value_type x)
+        {
+          buffer_[static_cast<size_type>(index) & mask_].store(x, memory_order_relaxed);
+        }
+
+      private:
+        size_type mask_;
+        atomic<value_type>* buffer_;
+      };
+
+      circular_array* grow(circular_array* a, std::ptrdiff_t t, std::ptrdiff_t b)
+      {
+        retired_.reserve(retired_.size() + 1);
+        circular_array* bigger = new circular_array(a->size() * 2);
+        for (std::ptrdiff_t i = t; i != b; ++i)
+          bigger->store(i, a->load(i));
+        array_.store(bigger, memory_order_release);
+        // thieves may still read from the old array, so it is only deleted together with the deque
+        retired_.push_back(a);
+        return bigger;
+      }
+
+      // top_ is written by the thieves, bottom_ by the owner, so keep them on separate cache lines
+      atomic<std::ptrdiff_t> top_;
+      char pad_[64 - sizeof(atomic<std::ptrdiff_t>)];
+      atomic<std::ptrdiff_t> bottom_;
+      atomic<circular_array*> array_;
+      std::vector<circular_array*> retired_;
+    };
+
+  }
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
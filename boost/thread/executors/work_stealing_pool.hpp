@@ -0,0 +1,350 @@
+#ifndef BOOST_THREAD_EXECUTORS_WORK_STEALING_POOL_HPP
+#define BOOST_THREAD_EXECUTORS_WORK_STEALING_POOL_HPP
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Vicente J. Botet Escriba 2013. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/thread for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/detail/delete.hpp>
+#include <boost/thread/detail/move.hpp>
+#include <boost/thread/detail/work_stealing_deque.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/future.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/lock_types.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/sync_bounded_queue.hpp>
+#include <boost/thread/thread_only.hpp>
+#include <boost/thread/tss.hpp>
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/container/deque.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/type_traits/decay.hpp>
+#include <boost/utility/result_of.hpp>
+#include <cstddef>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+namespace executors
+{
+  namespace detail
+  {
+    // type erased work item, owned by the pool until it has been run
+    class pool_task
+    {
+    public:
+      virtual ~pool_task() {}
+      virtual void run() = 0;
+    };
+
+    template <typename F>
+    class pool_task_impl : public pool_task
+    {
+    public:
+      explicit pool_task_impl(BOOST_THREAD_RV_REF(F) f) : f_(boost::move(f)) {}
+      void run()
+      {
+        f_();
+      }
+    private:
+      F f_;
+    };
+  }
+
+  // Thread pool where every worker owns a Chase-Lev deque. Tasks submitted by a worker are pushed to its own deque
+  // and run in LIFO order, which keeps fork-join computations cache friendly. Idle workers steal the oldest tasks of
+  // the other workers. Tasks submitted by other threads are queued at the inbox of one worker, chosen round robin or
+  // by an affinity hint, so that external submissions do not contend on a single queue either.
+  class work_stealing_pool
+  {
+  public:
+    typedef std::size_t size_type;
+
+    // Constructors/Assignment/Destructors
+    BOOST_THREAD_NO_COPYABLE(work_stealing_pool)
+
+    // Starts thread_count workers, or one worker per hardware thread.
+    explicit work_stealing_pool(size_type thread_count = 0);
+    // Closes the pool and joins the workers. Tasks that have been submitted before are run first.
+    ~work_stealing_pool();
+
+    // Observers
+    size_type size() const BOOST_NOEXCEPT
+    {
+      return size_;
+    }
+    bool closed() const BOOST_NOEXCEPT
+    {
+      return closed_.load(memory_order_acquire);
+    }
+    // The index of the calling worker, or size() if the calling thread is not a worker of this pool.
+    size_type this_worker_index() const
+    {
+      worker* const w = current_.get();
+      return w ? w->index : size_;
+    }
+
+    // Modifiers
+    // No more tasks can be submitted. Workers exit, once there is no work left.
+    void close();
+
+    // Schedules f to be run by the pool and returns a future for its result.
+    // Throws sync_queue_is_closed, if the pool is closed and the calling thread is not one of its workers.
+    template <typename F>
+    BOOST_THREAD_FUTURE<typename boost::result_of<typename decay<F>::type()>::type>
+    submit(BOOST_THREAD_FWD_REF(F) f)
+    {
+      return submit_to(size_, boost::forward<F>(f));
+    }
+
+    // Same as submit(f), but queues the task at the worker worker_hint % size(), e.g. to keep tasks operating on the
+    // same data on the same core. The task may still be stolen by an idle worker.
+    template <typename F>
+    BOOST_THREAD_FUTURE<typename boost::result_of<typename decay<F>::type()>::type>
+    submit_to(size_type worker_hint, BOOST_THREAD_FWD_REF(F) f)
+    {
+      typedef typename boost::result_of<typename decay<F>::type()>::type R;
+#if defined BOOST_THREAD_PROVIDES_SIGNATURE_PACKAGED_TASK
+      typedef packaged_task<R()> packaged_task_type;
+#else
+      typedef packaged_task<R> packaged_task_type;
+#endif
+      // tasks that are already running may still fork, while the pool is draining
+      if (closed() && !current_.get())
+        BOOST_THROW_EXCEPTION( sync_queue_is_closed() );
+
+      packaged_task_type pt( boost::forward<F>(f) );
+      BOOST_THREAD_FUTURE<R> ret = pt.get_future();
+      schedule(new detail::pool_task_impl<packaged_task_type>(boost::move(pt)), worker_hint);
+      return ::boost::move(ret);
+    }
+
+    // Runs one pending task in the calling thread, if there is any. Meant to be called while waiting for the result of
+    // a task, e.g. in fork-join computations, so that waiting workers do not starve the pool.
+    bool try_executing_one();
+
+  private:
+    struct worker
+    {
+      worker() : index(0), inbox_size(0) {}
+
+      size_type index;
+      thread_detail::work_stealing_deque<detail::pool_task*> deque;
+      mutex inbox_mtx;
+      boost::container::deque<detail::pool_task*> inbox;
+      atomic<size_type> inbox_size;
+      thread thr;
+    };
+
+    static void no_cleanup(worker*) {}
+
+    void schedule(detail::pool_task* t, size_type worker_hint);
+    void notify_idle_worker();
+    detail::pool_task* find_task(worker* w);
+    detail::pool_task* pull_inbox(worker& w);
+    bool has_work() const;
+    void worker_loop(worker* w);
+    static void run(detail::pool_task* t)
+    {
+      t->run();
+      delete t;
+    }
+
+    size_type size_;
+    scoped_array<worker> workers_;
+    thread_specific_ptr<worker> current_;
+    atomic<size_type> next_worker_;
+    atomic<bool> closed_;
+
+    // idle workers sleep on idle_cv_, notifications are skipped while no worker sleeps
+    atomic<size_type> idle_;
+    mutex idle_mtx_;
+    condition_variable idle_cv_;
+  };
+
+  inline work_stealing_pool::work_stealing_pool(size_type thread_count) :
+    size_(thread_count ? thread_count : (thread::hardware_concurrency() ? thread::hardware_concurrency() : 1)),
+    workers_(new worker[size_]),
+    current_(&work_stealing_pool::no_cleanup),
+    next_worker_(0), closed_(false), idle_(0)
+  {
+    try
+    {
+      for (size_type i = 0; i < size_; ++i)
+      {
+        workers_[i].index = i;
+        workers_[i].thr = thread(boost::bind(&work_stealing_pool::worker_loop, this, &workers_[i]));
+      }
+    }
+    catch (...)
+    {
+      close();
+      for (size_type i = 0; i < size_; ++i)
+        if (workers_[i].thr.joinable())
+          workers_[i].thr.join();
+      throw;
+    }
+  }
+
+  inline work_stealing_pool::~work_stealing_pool()
+  {
+    close();
+    for (size_type i = 0; i < size_; ++i)
+      workers_[i].thr.join();
+
+    // tasks that were submitted concurrently to close() are destroyed, which breaks their promises
+    for (size_type i = 0; i < size_; ++i)
+    {
+      detail::pool_task* t;
+      while (workers_[i].deque.pop(t))
+        delete t;
+      for (size_type j = 0; j < workers_[i].inbox.size(); ++j)
+        delete workers_[i].inbox[j];
+    }
+  }
+
+  inline void work_stealing_pool::close()
+  {
+    closed_.store(true, memory_order_release);
+    lock_guard<mutex> lk(idle_mtx_);
+    idle_cv_.notify_all();
+  }
+
+  inline void work_stealing_pool::schedule(detail::pool_task* t, size_type worker_hint)
+  {
+    worker* const w = current_.get();
+    if (w && worker_hint >= size_)
+    {
+      // forked by a worker, only the owner may push to its deque
+      w->deque.push(t);
+    }
+    else
+    {
+      if (worker_hint >= size_)
+        worker_hint = next_worker_.fetch_add(1, memory_order_relaxed);
+      worker& target = workers_[worker_hint % size_];
+      lock_guard<mutex> lk(target.inbox_mtx);
+      target.inbox.push_back(t);
+      target.inbox_size.store(target.inbox.size(), memory_order_relaxed);
+    }
+    notify_idle_worker();
+  }
+
+  inline void work_stealing_pool::notify_idle_worker()
+  {
+    // pairs with the fence in worker_loop: either the sleeping worker sees the new task, or we see the sleeper
+    atomic_thread_fence(memory_order_seq_cst);
+    if (idle_.load(memory_order_relaxed) == 0)
+      return;
+    lock_guard<mutex> lk(idle_mtx_);
+    idle_cv_.notify_one();
+  }
+
+  inline detail::pool_task* work_stealing_pool::pull_inbox(worker& w)
+  {
+    if (w.inbox_size.load(memory_order_relaxed) == 0)
+      return 0;
+    lock_guard<mutex> lk(w.inbox_mtx);
+    if (w.inbox.empty())
+      return 0;
+    detail::pool_task* t = w.inbox.front();
+    w.inbox.pop_front();
+    w.inbox_size.store(w.inbox.size(), memory_order_relaxed);
+    return t;
+  }
+
+  inline detail::pool_task* work_stealing_pool::find_task(worker* w)
+  {
+    detail::pool_task* t = 0;
+    size_type first = 0;
+    if (w)
+    {
+      if (w->deque.pop(t))
+        return t;
+      if ((t = pull_inbox(*w)) != 0)
+        return t;
+      first = w->index + 1;
+    }
+
+    // steal the oldest task of another worker, starting with the next one to spread the thieves
+    for (size_type i = 0; i < size_; ++i)
+    {
+      worker& victim = workers_[(first + i) % size_];
+      if (&victim == w)
+        continue;
+      if (victim.deque.steal(t))
+        return t;
+      if ((t = pull_inbox(victim)) != 0)
+        return t;
+    }
+    return 0;
+  }
+
+  inline bool work_stealing_pool::has_work() const
+  {
+    for (size_type i = 0; i < size_; ++i)
+    {
+      if (!workers_[i].deque.empty() || workers_[i].inbox_size.load(memory_order_relaxed) != 0)
+        return true;
+    }
+    return false;
+  }
+
+  inline bool work_stealing_pool::try_executing_one()
+  {
+    detail::pool_task* t = find_task(current_.get());
+    if (!t)
+      return false;
+    run(t);
+    return true;
+  }
+
+  inline void work_stealing_pool::worker_loop(worker* w)
+  {
+    current_.reset(w);
+    for (;;)
+    {
+      detail::pool_task* t = find_task(w);
+      if (t)
+      {
+        run(t);
+        continue;
+      }
+
+      // a steal may fail spuriously, so retry once, before going to sleep
+      this_thread::yield();
+      if ((t = find_task(w)) != 0)
+      {
+        run(t);
+        continue;
+      }
+
+      unique_lock<mutex> lk(idle_mtx_);
+      idle_.fetch_add(1, memory_order_relaxed);
+      atomic_thread_fence(memory_order_seq_cst);
+      while (!has_work() && !closed())
+        idle_cv_.wait(lk);
+      idle_.fetch_sub(1, memory_order_relaxed);
+      if (closed() && !has_work())
+        break;
+    }
+    current_.reset(0);
+  }
+
+} // executors
+} // boost
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
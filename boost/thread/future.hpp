@@ -27,6 +27,7 @@
 #include <boost/thread/lock_types.hpp>
 #include <boost/exception_ptr.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
 #include <boost/scoped_ptr.hpp>
 #include <boost/type_traits/is_fundamental.hpp>
 #include <boost/thread/detail/is_convertible.hpp>
@@ -56,6 +57,14 @@
 #include <boost/thread/detail/memory.hpp>
 #endif
 
+#if defined BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION
+#include <boost/thread/tss.hpp>
+#include <boost/container/vector.hpp>
+#include <deque>
+#include <iterator>
+#include <utility>
+#endif
+
 #include <boost/utility/result_of.hpp>
 #include <boost/thread/thread_only.hpp>
 
@@ -220,7 +229,9 @@ namespace boost
             // This declaration should be only included conditionally, but is included to maintain the same layout.
             bool thread_was_interrupted;
             // This declaration should be only included conditionally, but is included to maintain the same layout.
-            continuation_ptr_type continuation_ptr;
+            // A shared_future can have several continuations, and a future can be a parent of when_all/when_any.
+            typedef std::vector<continuation_ptr_type> continuations_type;
+            continuations_type continuations;
 
             // This declaration should be only included conditionally, but is included to maintain the same layout.
             virtual void launch_continuation(boost::unique_lock<boost::mutex>&)
@@ -233,7 +244,7 @@ namespace boost
                 policy_(launch::none),
                 is_constructed(false),
                 thread_was_interrupted(false),
-                continuation_ptr()
+                continuations()
             {}
             virtual ~shared_state_base()
             {}
@@ -265,11 +276,18 @@ namespace boost
 #if defined BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION
             void do_continuation(boost::unique_lock<boost::mutex>& lock)
             {
-                if (continuation_ptr) {
-                  continuation_ptr->launch_continuation(lock);
+                if (! continuations.empty()) {
+                  // the local copy keeps the continuations alive while they are launched without the lock
+                  continuations_type the_continuations;
+                  the_continuations.swap(continuations);
+                  for (continuations_type::iterator it = the_continuations.begin(); it != the_continuations.end(); ++it)
+                  {
+                    if (! lock.owns_lock())
+                      lock.lock();
+                    (*it)->launch_continuation(lock);
+                  }
                   if (! lock.owns_lock())
                     lock.lock();
-                  continuation_ptr.reset();
                 }
             }
 #else
@@ -280,7 +298,7 @@ namespace boost
 #if defined BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION
             void set_continuation_ptr(continuation_ptr_type continuation, boost::unique_lock<boost::mutex>& lock)
             {
-              continuation_ptr= continuation;
+              continuations.push_back(continuation);
               if (done) {
                 do_continuation(lock);
               }
@@ -818,12 +836,18 @@ namespace boost
 
           ~future_async_shared_state_base()
           {
-            if (thr_.joinable()) thr_.join();
+            if (thr_.joinable())
+            {
+              // the last reference can be released by a continuation that runs on the thread itself
+              if (thr_.get_id() == this_thread::get_id()) thr_.detach();
+              else thr_.join();
+            }
           }
 
           virtual void wait(bool rethrow)
           {
-              if (thr_.joinable()) thr_.join();
+              // a continuation that runs on the thread itself only waits for a ready state
+              if (thr_.joinable() && thr_.get_id() != this_thread::get_id()) thr_.join();
               this->base_type::wait(rethrow);
           }
         };
@@ -837,16 +861,25 @@ namespace boost
           typedef future_async_shared_state_base<Rp> base_type;
 
         public:
-          explicit future_async_shared_state(BOOST_THREAD_FWD_REF(Fp) f) :
-          base_type(thread(&future_async_shared_state::run, this, boost::forward<Fp>(f)))
+          future_async_shared_state()
+          {
+          }
+
+          // Starts the thread, once the state is owned by a shared_ptr.
+          void init(BOOST_THREAD_FWD_REF(Fp) f)
           {
+            this->thr_ = thread(&future_async_shared_state::run, this,
+                weak_ptr<shared_state_base>(this->shared_from_this()), boost::forward<Fp>(f));
           }
 
-          static void run(future_async_shared_state* that, BOOST_THREAD_FWD_REF(Fp) f)
+          static void run(future_async_shared_state* that, weak_ptr<shared_state_base> weak_that, BOOST_THREAD_FWD_REF(Fp) f)
           {
             try
             {
-              that->mark_finished_with_result(f());
+              Rp r = f();
+              // the continuations may release the last future, otherwise the future's destructor joins this thread
+              shared_ptr<shared_state_base> keep_alive(weak_that.lock());
+              that->mark_finished_with_result(boost::move(r));
             }
 #if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
             catch(thread_interrupted& )
@@ -867,16 +900,24 @@ namespace boost
           typedef future_async_shared_state_base<void> base_type;
 
         public:
-          explicit future_async_shared_state(BOOST_THREAD_FWD_REF(Fp) f) :
-          base_type(thread(&future_async_shared_state::run, this, boost::forward<Fp>(f)))
+          future_async_shared_state()
           {
           }
 
-          static void run(future_async_shared_state* that, BOOST_THREAD_FWD_REF(Fp) f)
+          // Starts the thread, once the state is owned by a shared_ptr.
+          void init(BOOST_THREAD_FWD_REF(Fp) f)
+          {
+            this->thr_ = thread(&future_async_shared_state::run, this,
+                weak_ptr<shared_state_base>(this->shared_from_this()), boost::forward<Fp>(f));
+          }
+
+          static void run(future_async_shared_state* that, weak_ptr<shared_state_base> weak_that, BOOST_THREAD_FWD_REF(Fp) f)
           {
             try
             {
               f();
+              // the continuations may release the last future, otherwise the future's destructor joins this thread
+              shared_ptr<shared_state_base> keep_alive(weak_that.lock());
               that->mark_finished_with_result();
             }
 #if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
@@ -898,16 +939,25 @@ namespace boost
           typedef future_async_shared_state_base<Rp&> base_type;
 
         public:
-          explicit future_async_shared_state(BOOST_THREAD_FWD_REF(Fp) f) :
-          base_type(thread(&future_async_shared_state::run, this, boost::forward<Fp>(f)))
+          future_async_shared_state()
           {
           }
 
-          static void run(future_async_shared_state* that, BOOST_THREAD_FWD_REF(Fp) f)
+          // Starts the thread, once the state is owned by a shared_ptr.
+          void init(BOOST_THREAD_FWD_REF(Fp) f)
+          {
+            this->thr_ = thread(&future_async_shared_state::run, this,
+                weak_ptr<shared_state_base>(this->shared_from_this()), boost::forward<Fp>(f));
+          }
+
+          static void run(future_async_shared_state* that, weak_ptr<shared_state_base> weak_that, BOOST_THREAD_FWD_REF(Fp) f)
           {
             try
             {
-              that->mark_finished_with_result(f());
+              Rp& r = f();
+              // the continuations may release the last future, otherwise the future's destructor joins this thread
+              shared_ptr<shared_state_base> keep_alive(weak_that.lock());
+              that->mark_finished_with_result(r);
             }
 #if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
             catch(thread_interrupted& )
@@ -1404,6 +1454,23 @@ namespace boost
         template <class F, class Rp, class Fp>
         BOOST_THREAD_FUTURE<Rp>
         make_future_deferred_continuation_shared_state(boost::unique_lock<boost::mutex> &lock, BOOST_THREAD_RV_REF(F) f, BOOST_THREAD_FWD_REF(Fp) c);
+
+        template<typename F, typename Rp, typename Fp>
+        struct future_inline_continuation_shared_state;
+        template<typename Ex, typename F, typename Rp, typename Fp>
+        struct future_executor_continuation_shared_state;
+
+        template <class F, class Rp, class Fp>
+        BOOST_THREAD_FUTURE<Rp>
+        make_future_inline_continuation_shared_state(boost::unique_lock<boost::mutex> &lock, BOOST_THREAD_RV_REF(F) f, BOOST_THREAD_FWD_REF(Fp) c);
+
+        template <class Ex, class F, class Rp, class Fp>
+        BOOST_THREAD_FUTURE<Rp>
+        make_future_executor_continuation_shared_state(boost::unique_lock<boost::mutex> &lock, Ex& ex, BOOST_THREAD_RV_REF(F) f, BOOST_THREAD_FWD_REF(Fp) c);
+
+        template <class S>
+        BOOST_THREAD_FUTURE<typename S::vector_type>
+        make_future_vector_continuation_shared_state(BOOST_THREAD_RV_REF(typename S::vector_type) v);
 #endif
 #if defined BOOST_THREAD_PROVIDES_FUTURE_UNWRAP
         template<typename F, typename Rp>
@@ -1436,6 +1503,23 @@ namespace boost
         template <class F, class Rp, class Fp>
         friend BOOST_THREAD_FUTURE<Rp>
         detail::make_future_deferred_continuation_shared_state(boost::unique_lock<boost::mutex> &lock, BOOST_THREAD_RV_REF(F) f, BOOST_THREAD_FWD_REF(Fp) c);
+
+        template <typename, typename, typename>
+        friend struct detail::future_inline_continuation_shared_state;
+        template <typename, typename, typename, typename>
+        friend struct detail::future_executor_continuation_shared_state;
+
+        template <class F, class Rp, class Fp>
+        friend BOOST_THREAD_FUTURE<Rp>
+        detail::make_future_inline_continuation_shared_state(boost::unique_lock<boost::mutex> &lock, BOOST_THREAD_RV_REF(F) f, BOOST_THREAD_FWD_REF(Fp) c);
+
+        template <class Ex, class F, class Rp, class Fp>
+        friend BOOST_THREAD_FUTURE<Rp>
+        detail::make_future_executor_continuation_shared_state(boost::unique_lock<boost::mutex> &lock, Ex& ex, BOOST_THREAD_RV_REF(F) f, BOOST_THREAD_FWD_REF(Fp) c);
+
+        template <class S>
+        friend BOOST_THREAD_FUTURE<typename S::vector_type>
+        detail::make_future_vector_continuation_shared_state(BOOST_THREAD_RV_REF(typename S::vector_type) v);
 #endif
 #if defined BOOST_THREAD_PROVIDES_FUTURE_UNWRAP
         template<typename F, typename Rp>
@@ -1583,6 +1667,9 @@ namespace boost
         template<typename F>
         inline BOOST_THREAD_FUTURE<typename boost::result_of<F(BOOST_THREAD_FUTURE)>::type>
         then(launch policy, BOOST_THREAD_FWD_REF(F) func);  // EXTENSION
+        template<typename Ex, typename F>
+        inline BOOST_THREAD_FUTURE<typename boost::result_of<F(BOOST_THREAD_FUTURE)>::type>
+        then(Ex& ex, BOOST_THREAD_FWD_REF(F) func);  // EXTENSION
 
         template <typename R2>
         inline typename disable_if< is_void<R2>, BOOST_THREAD_FUTURE<R> >::type
@@ -1631,6 +1718,19 @@ namespace boost
             template <class F, class Rp, class Fp>
             friend BOOST_THREAD_FUTURE<Rp>
             detail::make_future_deferred_continuation_shared_state(boost::unique_lock<boost::mutex> &lock, BOOST_THREAD_RV_REF(F) f, BOOST_THREAD_FWD_REF(Fp) c);
+
+            template <typename, typename, typename>
+            friend struct detail::future_inline_continuation_shared_state;
+            template <typename, typename, typename, typename>
+            friend struct detail::future_executor_continuation_shared_state;
+
+            template <class F, class Rp, class Fp>
+            friend BOOST_THREAD_FUTURE<Rp>
+            detail::make_future_inline_continuation_shared_state(boost::unique_lock<boost::mutex> &lock, BOOST_THREAD_RV_REF(F) f, BOOST_THREAD_FWD_REF(Fp) c);
+
+            template <class Ex, class F, class Rp, class Fp>
+            friend BOOST_THREAD_FUTURE<Rp>
+            detail::make_future_executor_continuation_shared_state(boost::unique_lock<boost::mutex> &lock, Ex& ex, BOOST_THREAD_RV_REF(F) f, BOOST_THREAD_FWD_REF(Fp) c);
     #endif
 #if defined BOOST_THREAD_PROVIDES_FUTURE_UNWRAP
             template<typename F, typename Rp>
@@ -1797,6 +1897,19 @@ namespace boost
         template <class F, class Rp, class Fp>
         friend BOOST_THREAD_FUTURE<Rp>
         detail::make_future_deferred_continuation_shared_state(boost::unique_lock<boost::mutex> &lock, BOOST_THREAD_RV_REF(F) f, BOOST_THREAD_FWD_REF(Fp) c);
+
+        template <typename, typename, typename>
+        friend struct detail::future_inline_continuation_shared_state;
+        template <typename, typename, typename, typename>
+        friend struct detail::future_executor_continuation_shared_state;
+
+        template <class F, class Rp, class Fp>
+        friend BOOST_THREAD_FUTURE<Rp>
+        detail::make_future_inline_continuation_shared_state(boost::unique_lock<boost::mutex> &lock, BOOST_THREAD_RV_REF(F) f, BOOST_THREAD_FWD_REF(Fp) c);
+
+        template <class Ex, class F, class Rp, class Fp>
+        friend BOOST_THREAD_FUTURE<Rp>
+        detail::make_future_executor_continuation_shared_state(boost::unique_lock<boost::mutex> &lock, Ex& ex, BOOST_THREAD_RV_REF(F) f, BOOST_THREAD_FWD_REF(Fp) c);
 #endif
 #if defined BOOST_THREAD_PROVIDES_SIGNATURE_PACKAGED_TASK
         template <class> friend class packaged_task;// todo check if this works in windows
@@ -1898,6 +2011,9 @@ namespace boost
         template<typename F>
         inline BOOST_THREAD_FUTURE<typename boost::result_of<F(shared_future)>::type>
         then(launch policy, BOOST_THREAD_FWD_REF(F) func); // EXTENSION
+        template<typename Ex, typename F>
+        inline BOOST_THREAD_FUTURE<typename boost::result_of<F(shared_future)>::type>
+        then(Ex& ex, BOOST_THREAD_FWD_REF(F) func); // EXTENSION
 #endif
 //#if defined BOOST_THREAD_PROVIDES_FUTURE_UNWRAP
 //        inline
@@ -3368,7 +3484,8 @@ namespace boost
     make_future_async_shared_state(BOOST_THREAD_FWD_REF(Fp) f)
     {
       shared_ptr<future_async_shared_state<Rp, Fp> >
-          h(new future_async_shared_state<Rp, Fp>(boost::forward<Fp>(f)));
+          h(new future_async_shared_state<Rp, Fp>());
+      h->init(boost::forward<Fp>(f));
       return BOOST_THREAD_FUTURE<Rp>(h);
     }
 
@@ -3724,10 +3841,12 @@ namespace boost
       void launch_continuation(boost::unique_lock<boost::mutex>& lock)
       {
         lock.unlock();
-        this->thr_ = thread(&future_async_continuation_shared_state::run, this);
+        // the thread keeps the state alive, as its own continuations may release the last future
+        this->thr_ = thread(&future_async_continuation_shared_state::run,
+            static_pointer_cast<future_async_continuation_shared_state>(this->shared_from_this()));
       }
 
-      static void run(future_async_continuation_shared_state* that)
+      static void run(shared_ptr<future_async_continuation_shared_state> that)
       {
         try
         {
@@ -3764,10 +3883,12 @@ namespace boost
       void launch_continuation(boost::unique_lock<boost::mutex>& lk)
       {
         lk.unlock();
-        this->thr_ = thread(&future_async_continuation_shared_state::run, this);
+        // the thread keeps the state alive, as its own continuations may release the last future
+        this->thr_ = thread(&future_async_continuation_shared_state::run,
+            static_pointer_cast<future_async_continuation_shared_state>(this->shared_from_this()));
       }
 
-      static void run(future_async_continuation_shared_state* that)
+      static void run(shared_ptr<future_async_continuation_shared_state> that)
       {
         try
         {
@@ -3857,6 +3978,250 @@ namespace boost
       }
     };
 
+    //////////////////////////
+    /// inline_continuations
+    //////////////////////////
+    // Runs the continuations that are launched inline, on the thread that makes their parent ready. A continuation
+    // that becomes ready, while the continuations on this thread are already nested too deeply, is queued and run by
+    // the outermost one, so that long chains of continuations do not overflow the stack.
+    template <typename Dummy = void>
+    class inline_continuations
+    {
+    public:
+      typedef void (*run_function)(shared_state_base*);
+
+      static void run(shared_ptr<shared_state_base> const& state, run_function fct)
+      {
+        inline_continuations* current = current_.get();
+        if (current == 0)
+        {
+          current = new inline_continuations();
+          current_.reset(current);
+        }
+        if (current->depth_ >= max_depth)
+        {
+          current->pending_.push_back(std::make_pair(state, fct));
+          return;
+        }
+        depth_guard guard(current->depth_);
+        fct(state.get());
+        if (current->depth_ == 1)
+        {
+          while (! current->pending_.empty())
+          {
+            typename pending_type::value_type next = current->pending_.front();
+            current->pending_.pop_front();
+            next.second(next.first.get());
+          }
+        }
+      }
+
+    private:
+      BOOST_STATIC_CONSTANT(unsigned, max_depth = 16);
+      typedef std::deque<std::pair<shared_ptr<shared_state_base>, run_function> > pending_type;
+
+      struct depth_guard
+      {
+        unsigned& depth_;
+        explicit depth_guard(unsigned& depth) : depth_(depth) { ++depth_; }
+        ~depth_guard() { --depth_; }
+      };
+
+      inline_continuations() : depth_(0) {}
+
+      unsigned depth_;
+      pending_type pending_;
+      static thread_specific_ptr<inline_continuations> current_;
+    };
+
+    template <typename Dummy>
+    thread_specific_ptr<inline_continuations<Dummy> > inline_continuations<Dummy>::current_;
+
+    /////////////////////////
+    /// future_inline_continuation_shared_state
+    /////////////////////////
+    template<typename F, typename Rp, typename Fp>
+    struct future_inline_continuation_shared_state: shared_state<Rp>
+    {
+      F parent;
+      Fp continuation;
+
+    public:
+      future_inline_continuation_shared_state(
+          BOOST_THREAD_RV_REF(F) f, BOOST_THREAD_FWD_REF(Fp) c
+          ) :
+      parent(boost::move(f)),
+      continuation(boost::move(c))
+      {
+      }
+
+      virtual void launch_continuation(boost::unique_lock<boost::mutex>& lk)
+      {
+        lk.unlock();
+        inline_continuations<>::run(this->shared_from_this(), &future_inline_continuation_shared_state::run);
+      }
+
+      static void run(shared_state_base* base)
+      {
+        future_inline_continuation_shared_state* that = static_cast<future_inline_continuation_shared_state*>(base);
+        try
+        {
+          that->mark_finished_with_result(that->continuation(boost::move(that->parent)));
+        }
+#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
+        catch(thread_interrupted& )
+        {
+          that->mark_interrupted_finish();
+        }
+#endif
+        catch(...)
+        {
+          that->mark_exceptional_finish();
+        }
+      }
+    };
+
+    template<typename F, typename Fp>
+    struct future_inline_continuation_shared_state<F, void, Fp>: shared_state<void>
+    {
+      F parent;
+      Fp continuation;
+
+    public:
+      future_inline_continuation_shared_state(
+          BOOST_THREAD_RV_REF(F) f, BOOST_THREAD_FWD_REF(Fp) c
+          ) :
+      parent(boost::move(f)),
+      continuation(boost::move(c))
+      {
+      }
+
+      virtual void launch_continuation(boost::unique_lock<boost::mutex>& lk)
+      {
+        lk.unlock();
+        inline_continuations<>::run(this->shared_from_this(), &future_inline_continuation_shared_state::run);
+      }
+
+      static void run(shared_state_base* base)
+      {
+        future_inline_continuation_shared_state* that = static_cast<future_inline_continuation_shared_state*>(base);
+        try
+        {
+          that->continuation(boost::move(that->parent));
+          that->mark_finished_with_result();
+        }
+#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
+        catch(thread_interrupted& )
+        {
+          that->mark_interrupted_finish();
+        }
+#endif
+        catch(...)
+        {
+          that->mark_exceptional_finish();
+        }
+      }
+    };
+
+    /////////////////////////
+    /// future_executor_continuation_shared_state
+    /////////////////////////
+    // The continuation is submitted to an executor, i.e. any object with a submit(f) member function that schedules
+    // the nullary function f, like executors::work_stealing_pool.
+    template<typename Ex, typename F, typename Rp, typename Fp>
+    struct future_executor_continuation_shared_state: future_inline_continuation_shared_state<F, Rp, Fp>
+    {
+      typedef future_inline_continuation_shared_state<F, Rp, Fp> base_type;
+      Ex& ex_;
+
+    public:
+      future_executor_continuation_shared_state(
+          Ex& ex, BOOST_THREAD_RV_REF(F) f, BOOST_THREAD_FWD_REF(Fp) c
+          ) :
+      base_type(boost::move(f), boost::forward<Fp>(c)),
+      ex_(ex)
+      {
+      }
+
+      struct run_continuation
+      {
+        typedef void result_type;
+        shared_ptr<shared_state_base> that_;
+
+        explicit run_continuation(shared_ptr<shared_state_base> const& that) : that_(that) {}
+        void operator()() const
+        {
+          base_type::run(that_.get());
+        }
+      };
+
+      virtual void launch_continuation(boost::unique_lock<boost::mutex>& lk)
+      {
+        lk.unlock();
+        try
+        {
+          ex_.submit(run_continuation(this->shared_from_this()));
+        }
+        catch(...)
+        {
+          // e.g. the executor has been closed
+          this->mark_exceptional_finish();
+        }
+      }
+    };
+
+    //////////////////////////
+    /// future_when_all_vector_shared_state
+    //////////////////////////
+    // The state is a continuation of every future of the vector and becomes ready, when the last of them is ready.
+    template<typename F>
+    struct future_when_all_vector_shared_state: shared_state<container::vector<F> >
+    {
+      typedef container::vector<F> vector_type;
+      vector_type vec_;
+      std::size_t pending_;
+
+    public:
+      explicit future_when_all_vector_shared_state(BOOST_THREAD_RV_REF(vector_type) v) :
+      vec_(boost::move(v)),
+      pending_(vec_.size())
+      {
+      }
+
+      virtual void launch_continuation(boost::unique_lock<boost::mutex>& parent_lock)
+      {
+        parent_lock.unlock();
+        boost::unique_lock<boost::mutex> lk(this->mutex);
+        if (--pending_ == 0)
+          this->mark_finished_with_result_internal(boost::move(vec_), lk);
+      }
+    };
+
+    //////////////////////////
+    /// future_when_any_vector_shared_state
+    //////////////////////////
+    // The state is a continuation of every future of the vector and becomes ready together with the first of them.
+    template<typename F>
+    struct future_when_any_vector_shared_state: shared_state<container::vector<F> >
+    {
+      typedef container::vector<F> vector_type;
+      vector_type vec_;
+
+    public:
+      explicit future_when_any_vector_shared_state(BOOST_THREAD_RV_REF(vector_type) v) :
+      vec_(boost::move(v))
+      {
+      }
+
+      virtual void launch_continuation(boost::unique_lock<boost::mutex>& parent_lock)
+      {
+        parent_lock.unlock();
+        boost::unique_lock<boost::mutex> lk(this->mutex);
+        if (! this->done)
+          this->mark_finished_with_result_internal(boost::move(vec_), lk);
+      }
+    };
+
     ////////////////////////////////
     // make_future_deferred_continuation_shared_state
     ////////////////////////////////
@@ -3889,6 +4254,117 @@ namespace boost
       return BOOST_THREAD_FUTURE<Rp>(h);
     }
 
+
+    ////////////////////////////////
+    // make_future_inline_continuation_shared_state
+    ////////////////////////////////
+    template<typename F, typename Rp, typename Fp>
+    BOOST_THREAD_FUTURE<Rp>
+    make_future_inline_continuation_shared_state(
+        boost::unique_lock<boost::mutex> &lock, BOOST_THREAD_RV_REF(F) f, BOOST_THREAD_FWD_REF(Fp) c
+        )
+    {
+      shared_ptr<future_inline_continuation_shared_state<F,Rp, Fp> >
+          h(new future_inline_continuation_shared_state<F,Rp, Fp>(boost::move(f), boost::forward<Fp>(c)));
+      h->parent.future_->set_continuation_ptr(h, lock);
+
+      return BOOST_THREAD_FUTURE<Rp>(h);
+    }
+
+    ////////////////////////////////
+    // make_future_executor_continuation_shared_state
+    ////////////////////////////////
+    template<typename Ex, typename F, typename Rp, typename Fp>
+    BOOST_THREAD_FUTURE<Rp>
+    make_future_executor_continuation_shared_state(
+        boost::unique_lock<boost::mutex> &lock, Ex& ex, BOOST_THREAD_RV_REF(F) f, BOOST_THREAD_FWD_REF(Fp) c
+        )
+    {
+      shared_ptr<future_executor_continuation_shared_state<Ex, F,Rp, Fp> >
+          h(new future_executor_continuation_shared_state<Ex, F,Rp, Fp>(ex, boost::move(f), boost::forward<Fp>(c)));
+      h->parent.future_->set_continuation_ptr(h, lock);
+
+      return BOOST_THREAD_FUTURE<Rp>(h);
+    }
+
+    ////////////////////////////////
+    // make_future_when_all_vector_shared_state
+    // make_future_when_any_vector_shared_state
+    ////////////////////////////////
+    template<typename S>
+    BOOST_THREAD_FUTURE<typename S::vector_type>
+    make_future_vector_continuation_shared_state(BOOST_THREAD_RV_REF(typename S::vector_type) v)
+    {
+      typedef typename S::vector_type vector_type;
+      // the futures are moved into the state and may even leave it while it is registered as their continuation
+      std::vector<shared_ptr<shared_state_base> > parents;
+      parents.reserve(v.size());
+      for (typename vector_type::iterator it = v.begin(); it != v.end(); ++it)
+      {
+        BOOST_THREAD_ASSERT_PRECONDITION(it->future_!=0, future_uninitialized());
+        parents.push_back(it->future_);
+      }
+
+      shared_ptr<S> h(new S(boost::move(v)));
+      if (parents.empty())
+      {
+        boost::unique_lock<boost::mutex> lk(h->mutex);
+        h->mark_finished_with_result_internal(boost::move(h->vec_), lk);
+      }
+      for (std::size_t i = 0; i < parents.size(); ++i)
+      {
+        boost::unique_lock<boost::mutex> lock(parents[i]->mutex);
+        parents[i]->set_continuation_ptr(h, lock);
+      }
+      return BOOST_THREAD_FUTURE<vector_type>(h);
+    }
+
+    template<typename R>
+    void push_back_future(container::vector<BOOST_THREAD_FUTURE<R> >& v, BOOST_THREAD_FUTURE<R>& f)
+    {
+      v.push_back(boost::move(f));
+    }
+    template<typename R>
+    void push_back_future(container::vector<shared_future<R> >& v, shared_future<R> const& f)
+    {
+      v.push_back(f);
+    }
+
+  }
+
+  ////////////////////////////////
+  // template <class InputIterator>
+  // future<vector<typename InputIterator::value_type>> when_all(InputIterator first, InputIterator last);
+  ////////////////////////////////
+  // The futures are moved and the shared_futures are copied into the vector of the resulting future, which becomes
+  // ready, when all of them are ready. No thread is blocked meanwhile.
+  template <typename InputIterator>
+  BOOST_THREAD_FUTURE<container::vector<typename std::iterator_traits<InputIterator>::value_type> >
+  when_all(InputIterator first, InputIterator last)
+  {
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef detail::future_when_all_vector_shared_state<value_type> state_type;
+    typename state_type::vector_type v;
+    for (; first != last; ++first)
+      detail::push_back_future(v, *first);
+    return detail::make_future_vector_continuation_shared_state<state_type>(boost::move(v));
+  }
+
+  ////////////////////////////////
+  // template <class InputIterator>
+  // future<vector<typename InputIterator::value_type>> when_any(InputIterator first, InputIterator last);
+  ////////////////////////////////
+  // Same as when_all, but the resulting future becomes ready together with the first of the futures.
+  template <typename InputIterator>
+  BOOST_THREAD_FUTURE<container::vector<typename std::iterator_traits<InputIterator>::value_type> >
+  when_any(InputIterator first, InputIterator last)
+  {
+    typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+    typedef detail::future_when_any_vector_shared_state<value_type> state_type;
+    typename state_type::vector_type v;
+    for (; first != last; ++first)
+      detail::push_back_future(v, *first);
+    return detail::make_future_vector_continuation_shared_state<state_type>(boost::move(v));
   }
 
   ////////////////////////////////
@@ -3905,14 +4381,16 @@ namespace boost
     typedef typename boost::result_of<F(BOOST_THREAD_FUTURE<R>)>::type future_type;
     BOOST_THREAD_ASSERT_PRECONDITION(this->future_!=0, future_uninitialized());
 
+    // the continuation is run at once, if this future is ready, and can release the last reference to the state
+    shared_ptr<detail::shared_state_base> parent_state(this->future_);
     boost::unique_lock<boost::mutex> lock(this->future_->mutex);
-    if (int(policy) & int(launch::async))
+    if (int(policy) == int(launch::async))
     {
       return BOOST_THREAD_MAKE_RV_REF((boost::detail::make_future_async_continuation_shared_state<BOOST_THREAD_FUTURE<R>, future_type, F>(
                   lock, boost::move(*this), boost::forward<F>(func)
               )));
     }
-    else if (int(policy) & int(launch::deferred))
+    else if (int(policy) == int(launch::deferred))
     {
       return BOOST_THREAD_MAKE_RV_REF((boost::detail::make_future_deferred_continuation_shared_state<BOOST_THREAD_FUTURE<R>, future_type, F>(
                   lock, boost::move(*this), boost::forward<F>(func)
@@ -3920,11 +4398,10 @@ namespace boost
     }
     else
     {
-      //BOOST_THREAD_ASSERT_PRECONDITION(false && "invalid launch parameter", std::logic_error("invalid launch parameter"));
-      return BOOST_THREAD_MAKE_RV_REF((boost::detail::make_future_async_continuation_shared_state<BOOST_THREAD_FUTURE<R>, future_type, F>(
+      // launch::any or launch::none, the continuation is run by the thread that makes this future ready
+      return BOOST_THREAD_MAKE_RV_REF((boost::detail::make_future_inline_continuation_shared_state<BOOST_THREAD_FUTURE<R>, future_type, F>(
                   lock, boost::move(*this), boost::forward<F>(func)
               )));
-
     }
 
   }
@@ -3937,14 +4414,10 @@ namespace boost
     typedef typename boost::result_of<F(BOOST_THREAD_FUTURE<R>)>::type future_type;
     BOOST_THREAD_ASSERT_PRECONDITION(this->future_!=0, future_uninitialized());
 
+    // the continuation is run at once, if this future is ready, and can release the last reference to the state
+    shared_ptr<detail::shared_state_base> parent_state(this->future_);
     boost::unique_lock<boost::mutex> lock(this->future_->mutex);
-    if (int(this->launch_policy()) & int(launch::async))
-    {
-      return boost::detail::make_future_async_continuation_shared_state<BOOST_THREAD_FUTURE<R>, future_type, F>(
-          lock, boost::move(*this), boost::forward<F>(func)
-      );
-    }
-    else if (int(this->launch_policy()) & int(launch::deferred))
+    if (int(this->launch_policy()) & int(launch::deferred))
     {
       this->future_->wait_internal(lock);
       return boost::detail::make_future_deferred_continuation_shared_state<BOOST_THREAD_FUTURE<R>, future_type, F>(
@@ -3953,12 +4426,29 @@ namespace boost
     }
     else
     {
-      //BOOST_THREAD_ASSERT_PRECONDITION(false && "invalid launch parameter", std::logic_error("invalid launch parameter"));
-      return boost::detail::make_future_async_continuation_shared_state<BOOST_THREAD_FUTURE<R>, future_type, F>(
+      // no thread is created, the continuation is run by the thread that makes this future ready
+      return boost::detail::make_future_inline_continuation_shared_state<BOOST_THREAD_FUTURE<R>, future_type, F>(
           lock, boost::move(*this), boost::forward<F>(func)
       );
     }
   }
+  template <typename R>
+  template <typename Ex, typename F>
+  inline BOOST_THREAD_FUTURE<typename boost::result_of<F(BOOST_THREAD_FUTURE<R>)>::type>
+  BOOST_THREAD_FUTURE<R>::then(Ex& ex, BOOST_THREAD_FWD_REF(F) func)
+  {
+
+    typedef typename boost::result_of<F(BOOST_THREAD_FUTURE<R>)>::type future_type;
+    BOOST_THREAD_ASSERT_PRECONDITION(this->future_!=0, future_uninitialized());
+
+    // the continuation is run at once, if this future is ready, and can release the last reference to the state
+    shared_ptr<detail::shared_state_base> parent_state(this->future_);
+    boost::unique_lock<boost::mutex> lock(this->future_->mutex);
+    return boost::detail::make_future_executor_continuation_shared_state<Ex, BOOST_THREAD_FUTURE<R>, future_type, F>(
+        lock, ex, boost::move(*this), boost::forward<F>(func)
+    );
+  }
+
 
 
 //#if 0 && defined(BOOST_THREAD_RVALUE_REFERENCES_DONT_MATCH_FUNTION_PTR)
@@ -4023,24 +4513,28 @@ namespace boost
     typedef typename boost::result_of<F(shared_future<R>)>::type future_type;
     BOOST_THREAD_ASSERT_PRECONDITION(this->future_!=0, future_uninitialized());
 
+    // the continuation is run at once, if this future is ready, and can release the last reference to the state
+    shared_ptr<detail::shared_state_base> parent_state(this->future_);
     boost::unique_lock<boost::mutex> lock(this->future_->mutex);
-    if (int(policy) & int(launch::async))
+    // the continuation gets a copy, this shared_future stays valid
+    shared_future<R> self(*this);
+    if (int(policy) == int(launch::async))
     {
       return BOOST_THREAD_MAKE_RV_REF((boost::detail::make_future_async_continuation_shared_state<shared_future<R>, future_type, F>(
-                  lock, boost::move(*this), boost::forward<F>(func)
+                  lock, boost::move(self), boost::forward<F>(func)
               )));
     }
-    else if (int(policy) & int(launch::deferred))
+    else if (int(policy) == int(launch::deferred))
     {
       return BOOST_THREAD_MAKE_RV_REF((boost::detail::make_future_deferred_continuation_shared_state<shared_future<R>, future_type, F>(
-                  lock, boost::move(*this), boost::forward<F>(func)
+                  lock, boost::move(self), boost::forward<F>(func)
               )));
     }
     else
     {
-      //BOOST_THREAD_ASSERT_PRECONDITION(false && "invalid launch parameter", std::logic_error("invalid launch parameter"));
-      return BOOST_THREAD_MAKE_RV_REF((boost::detail::make_future_async_continuation_shared_state<shared_future<R>, future_type, F>(
-                  lock, boost::move(*this), boost::forward<F>(func)
+      // launch::any or launch::none, the continuation is run by the thread that makes this future ready
+      return BOOST_THREAD_MAKE_RV_REF((boost::detail::make_future_inline_continuation_shared_state<shared_future<R>, future_type, F>(
+                  lock, boost::move(self), boost::forward<F>(func)
               )));
     }
 
@@ -4052,31 +4546,47 @@ namespace boost
   {
 
     typedef typename boost::result_of<F(shared_future<R>)>::type future_type;
-
     BOOST_THREAD_ASSERT_PRECONDITION(this->future_!=0, future_uninitialized());
 
+    // the continuation is run at once, if this future is ready, and can release the last reference to the state
+    shared_ptr<detail::shared_state_base> parent_state(this->future_);
     boost::unique_lock<boost::mutex> lock(this->future_->mutex);
-    if (int(this->launch_policy()) & int(launch::async))
-    {
-      return boost::detail::make_future_async_continuation_shared_state<shared_future<R>, future_type, F>(
-          lock, boost::move(*this), boost::forward<F>(func)
-      );
-    }
-    else if (int(this->launch_policy()) & int(launch::deferred))
+    // the continuation gets a copy, this shared_future stays valid
+    shared_future<R> self(*this);
+    if (int(this->launch_policy()) & int(launch::deferred))
     {
       this->future_->wait_internal(lock);
       return boost::detail::make_future_deferred_continuation_shared_state<shared_future<R>, future_type, F>(
-          lock, boost::move(*this), boost::forward<F>(func)
+          lock, boost::move(self), boost::forward<F>(func)
       );
     }
     else
     {
-      //BOOST_THREAD_ASSERT_PRECONDITION(false && "invalid launch parameter", std::logic_error("invalid launch parameter"));
-      return boost::detail::make_future_async_continuation_shared_state<shared_future<R>, future_type, F>(
-          lock, boost::move(*this), boost::forward<F>(func)
+      // no thread is created, the continuation is run by the thread that makes this future ready
+      return boost::detail::make_future_inline_continuation_shared_state<shared_future<R>, future_type, F>(
+          lock, boost::move(self), boost::forward<F>(func)
       );
     }
   }
+  template <typename R>
+  template <typename Ex, typename F>
+  inline BOOST_THREAD_FUTURE<typename boost::result_of<F(shared_future<R>)>::type>
+  shared_future<R>::then(Ex& ex, BOOST_THREAD_FWD_REF(F) func)
+  {
+
+    typedef typename boost::result_of<F(shared_future<R>)>::type future_type;
+    BOOST_THREAD_ASSERT_PRECONDITION(this->future_!=0, future_uninitialized());
+
+    // the continuation is run at once, if this future is ready, and can release the last reference to the state
+    shared_ptr<detail::shared_state_base> parent_state(this->future_);
+    boost::unique_lock<boost::mutex> lock(this->future_->mutex);
+    // the continuation gets a copy, this shared_future stays valid
+    shared_future<R> self(*this);
+    return boost::detail::make_future_executor_continuation_shared_state<Ex, shared_future<R>, future_type, F>(
+        lock, ex, boost::move(self), boost::forward<F>(func)
+    );
+  }
+
   namespace detail
   {
     template <typename T>
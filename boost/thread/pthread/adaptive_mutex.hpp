@@ -0,0 +1,142 @@
+#ifndef BOOST_THREAD_PTHREAD_ADAPTIVE_MUTEX_HPP
+#define BOOST_THREAD_PTHREAD_ADAPTIVE_MUTEX_HPP
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Vicente J. Botet Escriba 2013. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/thread for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/detail/delete.hpp>
+#include <boost/thread/pthread/futex.hpp>
+#if defined BOOST_THREAD_PROVIDES_NESTED_LOCKS
+#include <boost/thread/lock_types.hpp>
+#endif
+#include <boost/thread/thread_time.hpp>
+#include <boost/atomic.hpp>
+#include <boost/assert.hpp>
+#ifdef BOOST_THREAD_USES_CHRONO
+#include <boost/chrono/system_clocks.hpp>
+#endif
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+  class big_reader_shared_mutex;
+
+  // Timed mutex that spins for a while before it sleeps on a futex. The time a contended lock is spinning adapts
+  // to how long it took to get the lock the last times, as PTHREAD_MUTEX_ADAPTIVE_NP of glibc does. Uncontended
+  // lock and unlock are a single atomic instruction each and do not enter the kernel.
+  class adaptive_mutex
+  {
+  public:
+    BOOST_THREAD_NO_COPYABLE(adaptive_mutex)
+
+    adaptive_mutex() : state_(unlocked), spins_(0)
+    {
+    }
+    ~adaptive_mutex()
+    {
+      BOOST_ASSERT(state_.load(memory_order_relaxed) == unlocked);
+    }
+
+    void lock()
+    {
+      if (!try_lock())
+        lock_slow(thread_detail::no_deadline());
+    }
+
+    bool try_lock()
+    {
+      int expected = unlocked;
+      return state_.compare_exchange_strong(expected, locked, memory_order_acquire, memory_order_relaxed);
+    }
+
+    void unlock()
+    {
+      BOOST_ASSERT(state_.load(memory_order_relaxed) != unlocked);
+      if (state_.exchange(unlocked, memory_order_release) == contended)
+        thread_detail::futex_wake(state_, 1);
+    }
+
+#if defined BOOST_THREAD_USES_DATETIME
+    bool timed_lock(system_time const& abs_time)
+    {
+      return try_lock() || lock_slow(thread_detail::system_time_deadline(abs_time));
+    }
+    template<typename TimeDuration>
+    bool timed_lock(TimeDuration const & relative_time)
+    {
+      return timed_lock(get_system_time()+relative_time);
+    }
+#endif
+#ifdef BOOST_THREAD_USES_CHRONO
+    template <class Rep, class Period>
+    bool try_lock_for(const chrono::duration<Rep, Period>& rel_time)
+    {
+      return try_lock_until(chrono::steady_clock::now() + rel_time);
+    }
+    template <class Clock, class Duration>
+    bool try_lock_until(const chrono::time_point<Clock, Duration>& abs_time)
+    {
+      return try_lock() || lock_slow(thread_detail::chrono_deadline<Clock, Duration>(abs_time));
+    }
+#endif
+
+#if defined BOOST_THREAD_PROVIDES_NESTED_LOCKS
+    typedef unique_lock<adaptive_mutex> scoped_timed_lock;
+    typedef detail::try_lock_wrapper<adaptive_mutex> scoped_try_lock;
+    typedef scoped_timed_lock scoped_lock;
+#endif
+
+  private:
+    friend class big_reader_shared_mutex;
+
+    // the lock word, sleepers wait for it to change from contended
+    enum { unlocked = 0, locked = 1, contended = 2 };
+    // upper bound of the number of pause instructions a contended lock spins
+    enum { max_spin_count = 100 };
+
+    template <class Deadline>
+    bool lock_slow(Deadline const& deadline)
+    {
+      // spin up to twice as long as the last lock operations needed on average
+      const int spins = spins_.load(memory_order_relaxed);
+      const int max_spins = spins * 2 + 10 < max_spin_count ? spins * 2 + 10 : max_spin_count;
+      int count = 0;
+      while (count < max_spins)
+      {
+        ++count;
+        thread_detail::cpu_relax();
+        if (state_.load(memory_order_relaxed) == unlocked && try_lock())
+        {
+          spins_.store(spins + (count - spins) / 8, memory_order_relaxed);
+          return true;
+        }
+      }
+      spins_.store(spins + (count - spins) / 8, memory_order_relaxed);
+
+      // the owner holds the lock for long or is preempted, sleep in the kernel. The lock is taken in the contended
+      // state, as we cannot know whether other threads are still sleeping.
+      while (state_.exchange(contended, memory_order_acquire) != unlocked)
+      {
+        if (!thread_detail::futex_wait_until(state_, contended, deadline))
+          return false;
+      }
+      return true;
+    }
+
+    atomic<int> state_;
+    atomic<int> spins_;
+  };
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
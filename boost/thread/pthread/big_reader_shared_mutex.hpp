@@ -0,0 +1,465 @@
+#ifndef BOOST_THREAD_PTHREAD_BIG_READER_SHARED_MUTEX_HPP
+#define BOOST_THREAD_PTHREAD_BIG_READER_SHARED_MUTEX_HPP
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Vicente J. Botet Escriba 2013. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/thread for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/detail/delete.hpp>
+#include <boost/thread/pthread/adaptive_mutex.hpp>
+#include <boost/thread/pthread/futex.hpp>
+#include <boost/thread/thread_time.hpp>
+#include <boost/atomic.hpp>
+#include <boost/assert.hpp>
+#include <boost/scoped_array.hpp>
+#ifdef BOOST_THREAD_USES_CHRONO
+#include <boost/chrono/system_clocks.hpp>
+#endif
+#include <cstddef>
+#include <cstring>
+#include <pthread.h>
+#include <unistd.h>
+
+#if defined(__linux__) && defined(__GLIBC__) && defined(_GNU_SOURCE)
+#define BOOST_THREAD_HAS_SCHED_GETCPU
+#include <sched.h>
+#endif
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+  // Multiple-reader / single-writer mutex for read mostly data, also known as "big reader" lock. Every CPU has its
+  // own reader counter on its own cache line, so readers on different CPUs do not write to shared memory. The price
+  // is paid by the writers, that have to wait until the counters of all CPUs add up to zero, and by the size of
+  // the mutex.
+  //
+  // Writers are preferred: once a writer waits for the lock, new readers wait until it has released the lock.
+  // Writers and upgraders are serialized by an adaptive_mutex.
+  class big_reader_shared_mutex
+  {
+  public:
+    BOOST_THREAD_NO_COPYABLE(big_reader_shared_mutex)
+
+    big_reader_shared_mutex() :
+      slot_mask_(slot_count() - 1), counters_(new padded_counter[slot_mask_ + 1]), writer_(no_writer), drained_(0)
+    {
+    }
+    ~big_reader_shared_mutex()
+    {
+      BOOST_ASSERT(!readers_active());
+      BOOST_ASSERT(writer_.load(memory_order_relaxed) == no_writer);
+    }
+
+    // Shared ownership
+
+    void lock_shared()
+    {
+      do_lock_shared(thread_detail::no_deadline());
+    }
+    bool try_lock_shared()
+    {
+      atomic<int>& counter = reader_counter();
+      counter.fetch_add(1, memory_order_seq_cst);
+      if (writer_.load(memory_order_seq_cst) == no_writer)
+        return true;
+      leave(counter);
+      return false;
+    }
+#if defined BOOST_THREAD_USES_DATETIME
+    bool timed_lock_shared(system_time const& timeout)
+    {
+      return do_lock_shared(thread_detail::system_time_deadline(timeout));
+    }
+    template<typename TimeDuration>
+    bool timed_lock_shared(TimeDuration const & relative_time)
+    {
+      return timed_lock_shared(get_system_time()+relative_time);
+    }
+#endif
+#ifdef BOOST_THREAD_USES_CHRONO
+    template <class Rep, class Period>
+    bool try_lock_shared_for(const chrono::duration<Rep, Period>& rel_time)
+    {
+      return try_lock_shared_until(chrono::steady_clock::now() + rel_time);
+    }
+    template <class Clock, class Duration>
+    bool try_lock_shared_until(const chrono::time_point<Clock, Duration>& abs_time)
+    {
+      return do_lock_shared(thread_detail::chrono_deadline<Clock, Duration>(abs_time));
+    }
+#endif
+    void unlock_shared()
+    {
+      // the counter of the current CPU may be another one than the one incremented by lock_shared(), only the sum
+      // of all counters is meaningful
+      leave(reader_counter());
+    }
+
+    // Exclusive ownership
+
+    void lock()
+    {
+      writers_.lock();
+      block_readers();
+      wait_for_readers(thread_detail::no_deadline());
+    }
+    bool try_lock()
+    {
+      if (!writers_.try_lock())
+        return false;
+      block_readers();
+      if (readers_active())
+      {
+        release_readers();
+        writers_.unlock();
+        return false;
+      }
+      return true;
+    }
+#if defined BOOST_THREAD_USES_DATETIME
+    bool timed_lock(system_time const& timeout)
+    {
+      return do_lock(thread_detail::system_time_deadline(timeout));
+    }
+    template<typename TimeDuration>
+    bool timed_lock(TimeDuration const & relative_time)
+    {
+      return timed_lock(get_system_time()+relative_time);
+    }
+#endif
+#ifdef BOOST_THREAD_USES_CHRONO
+    template <class Rep, class Period>
+    bool try_lock_for(const chrono::duration<Rep, Period>& rel_time)
+    {
+      return try_lock_until(chrono::steady_clock::now() + rel_time);
+    }
+    template <class Clock, class Duration>
+    bool try_lock_until(const chrono::time_point<Clock, Duration>& abs_time)
+    {
+      return do_lock(thread_detail::chrono_deadline<Clock, Duration>(abs_time));
+    }
+#endif
+    void unlock()
+    {
+      release_readers();
+      writers_.unlock();
+    }
+
+    // Upgrade ownership: shared ownership, that excludes other upgraders and writers.
+
+    void lock_upgrade()
+    {
+      writers_.lock();
+      reader_counter().fetch_add(1, memory_order_relaxed);
+    }
+    bool try_lock_upgrade()
+    {
+      if (!writers_.try_lock())
+        return false;
+      reader_counter().fetch_add(1, memory_order_relaxed);
+      return true;
+    }
+#if defined BOOST_THREAD_USES_DATETIME
+    bool timed_lock_upgrade(system_time const& timeout)
+    {
+      if (!writers_.timed_lock(timeout))
+        return false;
+      reader_counter().fetch_add(1, memory_order_relaxed);
+      return true;
+    }
+    template<typename TimeDuration>
+    bool timed_lock_upgrade(TimeDuration const & relative_time)
+    {
+      return timed_lock_upgrade(get_system_time()+relative_time);
+    }
+#endif
+#ifdef BOOST_THREAD_USES_CHRONO
+    template <class Rep, class Period>
+    bool try_lock_upgrade_for(const chrono::duration<Rep, Period>& rel_time)
+    {
+      return try_lock_upgrade_until(chrono::steady_clock::now() + rel_time);
+    }
+    template <class Clock, class Duration>
+    bool try_lock_upgrade_until(const chrono::time_point<Clock, Duration>& abs_time)
+    {
+      if (!writers_.try_lock_until(abs_time))
+        return false;
+      reader_counter().fetch_add(1, memory_order_relaxed);
+      return true;
+    }
+#endif
+    void unlock_upgrade()
+    {
+      reader_counter().fetch_sub(1, memory_order_release);
+      writers_.unlock();
+    }
+
+    // Upgrade <-> Exclusive
+    void unlock_upgrade_and_lock()
+    {
+      block_readers();
+      leave(reader_counter());
+      wait_for_readers(thread_detail::no_deadline());
+    }
+    void unlock_and_lock_upgrade()
+    {
+      reader_counter().fetch_add(1, memory_order_relaxed);
+      release_readers();
+    }
+    bool try_unlock_upgrade_and_lock()
+    {
+      block_readers();
+      atomic<int>& counter = reader_counter();
+      counter.fetch_sub(1, memory_order_seq_cst);
+      if (readers_active())
+      {
+        counter.fetch_add(1, memory_order_relaxed);
+        release_readers();
+        return false;
+      }
+      return true;
+    }
+#ifdef BOOST_THREAD_USES_CHRONO
+    template <class Rep, class Period>
+    bool try_unlock_upgrade_and_lock_for(const chrono::duration<Rep, Period>& rel_time)
+    {
+      return try_unlock_upgrade_and_lock_until(chrono::steady_clock::now() + rel_time);
+    }
+    template <class Clock, class Duration>
+    bool try_unlock_upgrade_and_lock_until(const chrono::time_point<Clock, Duration>& abs_time)
+    {
+      block_readers();
+      leave(reader_counter());
+      if (wait_for_readers(thread_detail::chrono_deadline<Clock, Duration>(abs_time)))
+        return true;
+      reader_counter().fetch_add(1, memory_order_relaxed);
+      release_readers();
+      return false;
+    }
+#endif
+
+    // Shared <-> Exclusive
+    void unlock_and_lock_shared()
+    {
+      reader_counter().fetch_add(1, memory_order_relaxed);
+      release_readers();
+      writers_.unlock();
+    }
+#ifdef BOOST_THREAD_PROVIDES_SHARED_MUTEX_UPWARDS_CONVERSIONS
+    bool try_unlock_shared_and_lock()
+    {
+      if (!writers_.try_lock())
+        return false;
+      if (try_unlock_upgrade_and_lock())
+        return true;
+      writers_.unlock();
+      return false;
+    }
+#ifdef BOOST_THREAD_USES_CHRONO
+    template <class Rep, class Period>
+    bool try_unlock_shared_and_lock_for(const chrono::duration<Rep, Period>& rel_time)
+    {
+      return try_unlock_shared_and_lock_until(chrono::steady_clock::now() + rel_time);
+    }
+    template <class Clock, class Duration>
+    bool try_unlock_shared_and_lock_until(const chrono::time_point<Clock, Duration>& abs_time)
+    {
+      if (!writers_.try_lock_until(abs_time))
+        return false;
+      if (try_unlock_upgrade_and_lock_until(abs_time))
+        return true;
+      writers_.unlock();
+      return false;
+    }
+#endif
+#endif
+
+    // Shared <-> Upgrade
+    void unlock_upgrade_and_lock_shared()
+    {
+      writers_.unlock();
+    }
+#ifdef BOOST_THREAD_PROVIDES_SHARED_MUTEX_UPWARDS_CONVERSIONS
+    bool try_unlock_shared_and_lock_upgrade()
+    {
+      return writers_.try_lock();
+    }
+#ifdef BOOST_THREAD_USES_CHRONO
+    template <class Rep, class Period>
+    bool try_unlock_shared_and_lock_upgrade_for(const chrono::duration<Rep, Period>& rel_time)
+    {
+      return try_unlock_shared_and_lock_upgrade_until(chrono::steady_clock::now() + rel_time);
+    }
+    template <class Clock, class Duration>
+    bool try_unlock_shared_and_lock_upgrade_until(const chrono::time_point<Clock, Duration>& abs_time)
+    {
+      return writers_.try_lock_until(abs_time);
+    }
+#endif
+#endif
+
+  private:
+    // states of writer_, readers sleep on it while it is readers_waiting
+    enum { no_writer = 0, writer = 1, readers_waiting = 2 };
+    // number of pause instructions readers and writers spin, before they sleep
+    enum { max_spin_count = 100 };
+
+    struct padded_counter
+    {
+      padded_counter() : count(0) {}
+      atomic<int> count;
+      char pad[64 - sizeof(atomic<int>)];
+    };
+
+    static std::size_t slot_count()
+    {
+      long const cpus = ::sysconf(_SC_NPROCESSORS_CONF);
+      std::size_t n = 1;
+      while (n < static_cast<std::size_t>(cpus) && n < 256)
+        n *= 2;
+      return n;
+    }
+
+    atomic<int>& reader_counter()
+    {
+      std::size_t slot;
+#if defined BOOST_THREAD_HAS_SCHED_GETCPU
+      int const cpu = ::sched_getcpu();
+      if (cpu >= 0)
+        slot = static_cast<std::size_t>(cpu);
+      else
+#endif
+      {
+        // no per CPU counters, spread the threads instead
+        pthread_t const self = ::pthread_self();
+        std::size_t h = 0;
+        std::memcpy(&h, &self, sizeof(h) < sizeof(self) ? sizeof(h) : sizeof(self));
+        slot = h ^ (h >> 7) ^ (h >> 17);
+      }
+      return counters_[slot & slot_mask_].count;
+    }
+
+    bool readers_active() const
+    {
+      int sum = 0;
+      for (std::size_t i = 0; i <= slot_mask_; ++i)
+        sum += counters_[i].count.load(memory_order_seq_cst);
+      return sum != 0;
+    }
+
+    // Decrements counter and wakes the writer that may be waiting for the last reader.
+    void leave(atomic<int>& counter)
+    {
+      counter.fetch_sub(1, memory_order_seq_cst);
+      if (writer_.load(memory_order_seq_cst) != no_writer)
+      {
+        drained_.fetch_add(1, memory_order_release);
+        thread_detail::futex_wake(drained_, 1);
+      }
+    }
+
+    template <class Deadline>
+    bool do_lock_shared(Deadline const& deadline)
+    {
+      atomic<int>& counter = reader_counter();
+      for (;;)
+      {
+        counter.fetch_add(1, memory_order_seq_cst);
+        if (writer_.load(memory_order_seq_cst) == no_writer)
+          return true;
+        // a writer owns or waits for the lock, back off
+        leave(counter);
+        if (!wait_for_writer(deadline))
+          return false;
+      }
+    }
+
+    template <class Deadline>
+    bool wait_for_writer(Deadline const& deadline)
+    {
+      for (int count = 0; count < max_spin_count; ++count)
+      {
+        if (writer_.load(memory_order_relaxed) == no_writer)
+          return true;
+        thread_detail::cpu_relax();
+      }
+      int state = writer_.load(memory_order_relaxed);
+      while (state != no_writer)
+      {
+        if (state == readers_waiting || writer_.compare_exchange_weak(state, readers_waiting, memory_order_relaxed))
+        {
+          if (!thread_detail::futex_wait_until(writer_, readers_waiting, deadline))
+            return false;
+          state = writer_.load(memory_order_relaxed);
+        }
+      }
+      return true;
+    }
+
+    // Called by the owner of writers_. New readers back off from now on.
+    void block_readers()
+    {
+      writer_.store(writer, memory_order_seq_cst);
+    }
+
+    void release_readers()
+    {
+      if (writer_.exchange(no_writer, memory_order_release) == readers_waiting)
+        thread_detail::futex_wake_all(writer_);
+    }
+
+    template <class Deadline>
+    bool wait_for_readers(Deadline const& deadline)
+    {
+      int count = 0;
+      for (;;)
+      {
+        int const drained = drained_.load(memory_order_acquire);
+        if (!readers_active())
+          return true;
+        if (count < max_spin_count)
+        {
+          ++count;
+          thread_detail::cpu_relax();
+        }
+        else if (!thread_detail::futex_wait_until(drained_, drained, deadline))
+        {
+          return false;
+        }
+      }
+    }
+
+    template <class Deadline>
+    bool do_lock(Deadline const& deadline)
+    {
+      if (!writers_.try_lock() && !writers_.lock_slow(deadline))
+        return false;
+      block_readers();
+      if (wait_for_readers(deadline))
+        return true;
+      release_readers();
+      writers_.unlock();
+      return false;
+    }
+
+    std::size_t const slot_mask_;
+    scoped_array<padded_counter> counters_;
+    // the lock word of the writers, separated from the counters of the readers
+    atomic<int> writer_;
+    // incremented by the readers that leave while a writer waits, the writer sleeps on it
+    atomic<int> drained_;
+    adaptive_mutex writers_;
+  };
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
@@ -0,0 +1,163 @@
+#ifndef BOOST_THREAD_PTHREAD_FUTEX_HPP
+#define BOOST_THREAD_PTHREAD_FUTEX_HPP
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Vicente J. Botet Escriba 2013. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/thread for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/pthread/timespec.hpp>
+#include <boost/thread/thread_time.hpp>
+#include <boost/atomic.hpp>
+#include <boost/static_assert.hpp>
+#ifdef BOOST_THREAD_USES_CHRONO
+#include <boost/chrono/ceil.hpp>
+#include <boost/chrono/duration.hpp>
+#include <boost/chrono/time_point.hpp>
+#endif
+#include <time.h>
+
+#if defined(__linux__) && !defined(BOOST_THREAD_NO_FUTEX)
+#define BOOST_THREAD_HAS_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <climits>
+#endif
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+  namespace thread_detail
+  {
+    BOOST_STATIC_ASSERT(sizeof(atomic<int>) == sizeof(int));
+
+    // Busy waiting hint, lets the sibling hyper-thread run while we spin.
+    inline void cpu_relax()
+    {
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+      __asm__ __volatile__ ("pause" ::: "memory");
+#else
+      atomic_signal_fence(memory_order_seq_cst);
+#endif
+    }
+
+#if defined BOOST_THREAD_HAS_FUTEX
+
+    // Blocks while word == expected, until woken, the relative timeout rel_time has elapsed or a signal arrives.
+    // Spurious wake ups are possible, the caller has to check its condition again.
+    inline void futex_wait(atomic<int>& word, int expected, struct timespec const* rel_time = 0)
+    {
+      ::syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAIT_PRIVATE, expected, rel_time, 0, 0);
+    }
+
+    inline void futex_wake(atomic<int>& word, int count)
+    {
+      ::syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAKE_PRIVATE, count, 0, 0, 0);
+    }
+
+    inline void futex_wake_all(atomic<int>& word)
+    {
+      futex_wake(word, INT_MAX);
+    }
+
+#else
+
+    // Without futexes the waiters poll the word, sleeping for a short while between two polls.
+    inline void futex_wait(atomic<int>& word, int expected, struct timespec const* rel_time = 0)
+    {
+      if (word.load(memory_order_relaxed) != expected)
+        return;
+      struct timespec ts = { 0, 100000 };
+      if (rel_time && rel_time->tv_sec == 0 && rel_time->tv_nsec < ts.tv_nsec)
+        ts = *rel_time;
+      ::nanosleep(&ts, 0);
+    }
+
+    inline void futex_wake(atomic<int>&, int)
+    {
+    }
+
+    inline void futex_wake_all(atomic<int>&)
+    {
+    }
+
+#endif
+
+    // Deadlines of the timed lock functions. time_left() stores the time left in rel_time and returns false, once
+    // the deadline has been reached.
+
+    struct no_deadline
+    {
+      bool time_left(struct timespec&) const
+      {
+        return true;
+      }
+    };
+
+#if defined BOOST_THREAD_USES_DATETIME
+    class system_time_deadline
+    {
+    public:
+      explicit system_time_deadline(system_time const& abs_time) : abs_time_(abs_time) {}
+      bool time_left(struct timespec& rel_time) const
+      {
+        posix_time::time_duration const d = abs_time_ - get_system_time();
+        if (d.is_negative() || d.ticks() == 0)
+          return false;
+        rel_time = boost::detail::to_timespec(static_cast<boost::intmax_t>(d.total_microseconds()) * 1000);
+        return true;
+      }
+    private:
+      system_time abs_time_;
+    };
+#endif
+
+#ifdef BOOST_THREAD_USES_CHRONO
+    template <class Clock, class Duration>
+    class chrono_deadline
+    {
+    public:
+      explicit chrono_deadline(chrono::time_point<Clock, Duration> const& abs_time) : abs_time_(abs_time) {}
+      bool time_left(struct timespec& rel_time) const
+      {
+        chrono::nanoseconds const d = chrono::ceil<chrono::nanoseconds>(abs_time_ - Clock::now());
+        if (d <= chrono::nanoseconds::zero())
+          return false;
+        rel_time = boost::detail::to_timespec(d);
+        return true;
+      }
+    private:
+      chrono::time_point<Clock, Duration> abs_time_;
+    };
+#endif
+
+    // Waits on word as futex_wait, unless the deadline has already been reached, in which case it returns false.
+    template <class Deadline>
+    bool futex_wait_until(atomic<int>& word, int expected, Deadline const& deadline)
+    {
+      struct timespec rel_time;
+      if (!deadline.time_left(rel_time))
+        return false;
+      futex_wait(word, expected, &rel_time);
+      return true;
+    }
+
+    inline bool futex_wait_until(atomic<int>& word, int expected, no_deadline const&)
+    {
+      futex_wait(word, expected);
+      return true;
+    }
+  }
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
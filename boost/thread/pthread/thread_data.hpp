@@ -31,16 +31,44 @@
 
 #include <pthread.h>
 #include <unistd.h>
+#include <sched.h>
+#include <cstring>
+
+#if defined(__linux__) && defined(__GLIBC__) && defined(CPU_SET)
+#define BOOST_THREAD_HAS_AFFINITY
+#endif
 
 #include <boost/config/abi_prefix.hpp>
 
 namespace boost
 {
+#if defined BOOST_THREAD_HAS_AFFINITY
+    namespace detail
+    {
+        // Fills cpus with the CPUs of [first, last). Returns false, if one of them does not fit in a cpu_set_t.
+        template <typename InputIterator>
+        bool make_cpu_set(InputIterator first, InputIterator last, cpu_set_t& cpus) BOOST_NOEXCEPT
+        {
+            CPU_ZERO(&cpus);
+            for (; first != last; ++first)
+            {
+                unsigned const cpu = *first;
+                if (cpu >= CPU_SETSIZE) return false;
+                CPU_SET(cpu, &cpus);
+            }
+            return CPU_COUNT(&cpus) != 0;
+        }
+        // Fills cpus with the CPUs of a NUMA node. Returns false, if the node does not exist.
+        BOOST_THREAD_DECL bool make_numa_node_cpu_set(unsigned node, cpu_set_t& cpus) BOOST_NOEXCEPT;
+    }
+#endif
+
     class thread_attributes {
     public:
         thread_attributes() BOOST_NOEXCEPT {
             int res = pthread_attr_init(&val_);
             BOOST_VERIFY(!res && "pthread_attr_init failed");
+            name_[0] = '\0';
         }
         ~thread_attributes() {
           int res = pthread_attr_destroy(&val_);
@@ -74,8 +102,55 @@ namespace boost
           return &val_;
         }
 
+        // affinity
+        // Restricts the new thread to the CPUs of [first, last). Returns false, if the platform does not support
+        // affinity or a CPU number is out of range.
+        template <typename InputIterator>
+        bool set_affinity(InputIterator first, InputIterator last) BOOST_NOEXCEPT {
+#if defined BOOST_THREAD_HAS_AFFINITY
+          cpu_set_t cpus;
+          return detail::make_cpu_set(first, last, cpus)
+              && pthread_attr_setaffinity_np(&val_, sizeof(cpus), &cpus) == 0;
+#else
+          (void)first;
+          (void)last;
+          return false;
+#endif
+        }
+        bool set_affinity(unsigned cpu) BOOST_NOEXCEPT {
+          return set_affinity(&cpu, &cpu + 1);
+        }
+        // Restricts the new thread to the CPUs of a NUMA node, without changing its memory policy.
+        bool set_numa_node(unsigned node) BOOST_NOEXCEPT {
+#if defined BOOST_THREAD_HAS_AFFINITY
+          cpu_set_t cpus;
+          return detail::make_numa_node_cpu_set(node, cpus)
+              && pthread_attr_setaffinity_np(&val_, sizeof(cpus), &cpus) == 0;
+#else
+          (void)node;
+          return false;
+#endif
+        }
+
+        // name
+        // The name is shown by tools such as top or perf. It is truncated to 15 characters, the limit of Linux.
+        // Returns false, if the platform cannot name threads.
+        bool set_name(const char* name) BOOST_NOEXCEPT {
+          std::strncpy(name_, name, sizeof(name_) - 1);
+          name_[sizeof(name_) - 1] = '\0';
+#if defined(__linux__) || defined(__APPLE__)
+          return true;
+#else
+          return false;
+#endif
+        }
+        const char* get_name() const BOOST_NOEXCEPT {
+          return name_;
+        }
+
     private:
         pthread_attr_t val_;
+        char name_[16];
     };
 
     class thread;
@@ -123,6 +198,8 @@ namespace boost
 
             typedef std::vector<shared_ptr<shared_state_base> > async_states_t;
             async_states_t async_states_;
+            // name given by the thread attributes, the thread sets it itself when it starts
+            char name[16];
 
 //#if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
             // These data must be at the end so that the access to the other fields doesn't change
@@ -143,7 +220,9 @@ namespace boost
                 , interrupt_enabled(true)
                 , interrupt_requested(false)
 //#endif
-            {}
+            {
+                name[0] = '\0';
+            }
             virtual ~thread_data_base();
 
             typedef pthread_t native_handle_type;
@@ -239,6 +318,22 @@ namespace boost
 
         void BOOST_THREAD_DECL yield() BOOST_NOEXCEPT;
 
+        // Restricts the calling thread to the CPUs of [first, last). Returns false, if the platform does not
+        // support affinity or a CPU number is out of range.
+        template <typename InputIterator>
+        bool set_affinity(InputIterator first, InputIterator last) BOOST_NOEXCEPT
+        {
+#if defined BOOST_THREAD_HAS_AFFINITY
+            cpu_set_t cpus;
+            return detail::make_cpu_set(first, last, cpus)
+                && pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+#else
+            (void)first;
+            (void)last;
+            return false;
+#endif
+        }
+
 #if defined BOOST_THREAD_USES_DATETIME
 #ifdef __DECXXX
         /// Workaround of DECCXX issue of incorrect template substitution
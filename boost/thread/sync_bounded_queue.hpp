@@ -74,6 +74,16 @@ namespace boost
     inline bool try_pull(no_block_tag,value_type&);
     inline shared_ptr<ValueType> try_pull();
 
+    // Batch Modifiers
+    // The elements are moved with a single lock of the queue, as long as they fit, and the waiting threads are
+    // notified once per batch.
+    template <typename InputIterator>
+    inline void push_back(InputIterator first, InputIterator last);
+    template <typename OutputIterator>
+    inline size_type pull_front(size_type max_elems, OutputIterator out);
+    template <typename OutputIterator>
+    inline size_type try_pull_front(size_type max_elems, OutputIterator out);
+
   private:
     mutable mutex mtx_;
     condition_variable not_empty_;
@@ -148,6 +158,20 @@ namespace boost
         not_full_.notify_one();
       }
     }
+    // wake up one waiting thread per moved element, but no more than are waiting
+    inline void notify_if_needed(condition_variable& cv, size_type& waiting, size_type moved, unique_lock<mutex>& lk)
+    {
+      size_type const to_notify = moved < waiting ? moved : waiting;
+      if (to_notify > 0)
+      {
+        waiting -= to_notify;
+        lk.unlock();
+        for (size_type i = 0; i < to_notify; ++i)
+        {
+          cv.notify_one();
+        }
+      }
+    }
 
     inline void pull(value_type& elem, unique_lock<mutex>& lk)
     {
@@ -180,6 +204,19 @@ namespace boost
       data_[in_] = boost::move(elem);
       set_in(in_p_1, lk);
     }
+
+    template <typename OutputIterator>
+    inline size_type pull_front(size_type max_elems, OutputIterator& out, unique_lock<mutex>& lk)
+    {
+      size_type n = 0;
+      for (; n < max_elems && out_ != in_; ++n, ++out)
+      {
+        *out = boost::move(data_[out_]);
+        out_ = inc(out_);
+      }
+      notify_if_needed(not_full_, waiting_full_, n, lk);
+      return n;
+    }
   };
 
   template <typename ValueType>
@@ -529,7 +566,7 @@ namespace boost
     try
     {
       unique_lock<mutex> lk(mtx_);
-      return try_push(elem, lk);
+      return try_push(boost::move(elem), lk);
     }
     catch (...)
     {
@@ -548,7 +585,7 @@ namespace boost
       {
         return false;
       }
-      return try_push(elem, lk);
+      return try_push(boost::move(elem), lk);
     }
     catch (...)
     {
@@ -563,7 +600,81 @@ namespace boost
     try
     {
       unique_lock<mutex> lk(mtx_);
-      push_at(elem, wait_until_not_full(lk), lk);
+      size_type in_p_1 = wait_until_not_full(lk);
+      push_at(boost::move(elem), in_p_1, lk);
+    }
+    catch (...)
+    {
+      close();
+      throw;
+    }
+  }
+
+  template <typename ValueType>
+  template <typename InputIterator>
+  void sync_bounded_queue<ValueType>::push_back(InputIterator first, InputIterator last)
+  {
+    try
+    {
+      unique_lock<mutex> lk(mtx_, defer_lock);
+      while (first != last)
+      {
+        if (! lk.owns_lock()) lk.lock();
+        size_type in_p_1 = wait_until_not_full(lk);
+        // waiting can release the lock and let other producers move in_
+        size_type in = in_;
+        size_type n = 0;
+        // fill the free slots, the remaining elements wait for the consumers
+        for (; first != last && in_p_1 != out_; ++first, ++n)
+        {
+          data_[in] = *first;
+          in = in_p_1;
+          in_p_1 = inc(in_p_1);
+        }
+        in_ = in;
+        notify_if_needed(not_empty_, waiting_empty_, n, lk);
+      }
+    }
+    catch (...)
+    {
+      close();
+      throw;
+    }
+  }
+
+  template <typename ValueType>
+  template <typename OutputIterator>
+  typename sync_bounded_queue<ValueType>::size_type
+  sync_bounded_queue<ValueType>::pull_front(size_type max_elems, OutputIterator out)
+  {
+    try
+    {
+      if (max_elems == 0) return 0;
+      unique_lock<mutex> lk(mtx_);
+      wait_until_not_empty(lk);
+      return pull_front(max_elems, out, lk);
+    }
+    catch (...)
+    {
+      close();
+      throw;
+    }
+  }
+
+  template <typename ValueType>
+  template <typename OutputIterator>
+  typename sync_bounded_queue<ValueType>::size_type
+  sync_bounded_queue<ValueType>::try_pull_front(size_type max_elems, OutputIterator out)
+  {
+    try
+    {
+      unique_lock<mutex> lk(mtx_);
+      if (empty(lk))
+      {
+        throw_if_closed(lk);
+        return 0;
+      }
+      return pull_front(max_elems, out, lk);
     }
     catch (...)
     {
@@ -0,0 +1,327 @@
+#ifndef BOOST_THREAD_SYNC_LOCKFREE_QUEUE_HPP
+#define BOOST_THREAD_SYNC_LOCKFREE_QUEUE_HPP
+
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Vicente J. Botet Escriba 2013. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/thread for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/lock_types.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/detail/delete.hpp>
+#include <boost/thread/sync_bounded_queue.hpp>
+#include <boost/lockfree/mpmc_ring.hpp>
+#include <boost/atomic.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+
+  // Bounded queue with the interface of sync_bounded_queue, built on a lock-free ring buffer. Pushing and pulling
+  // take no lock, as long as the queue is neither full nor empty. The mutex and the condition variables are only
+  // used to put threads to sleep, and the threads that push or pull only notify, if another thread sleeps.
+  //
+  // ValueType must be copy constructible and assignable, and copying must not throw. Elements are always copied.
+  template <typename ValueType>
+  class sync_lockfree_queue
+  {
+  public:
+    typedef ValueType value_type;
+    typedef std::size_t size_type;
+
+    // Constructors/Assignment/Destructors
+    BOOST_THREAD_NO_COPYABLE(sync_lockfree_queue)
+    // The capacity is rounded up to the next power of two.
+    explicit sync_lockfree_queue(size_type max_elems) :
+      ring_(max_elems), closed_(false), waiting_empty_(0), waiting_full_(0)
+    {
+    }
+    ~sync_lockfree_queue()
+    {
+    }
+
+    // Observers
+    // The results are only snapshots, if other threads access the queue.
+    bool empty() const
+    {
+      return ring_.empty();
+    }
+    size_type capacity() const
+    {
+      return ring_.capacity();
+    }
+    bool closed() const
+    {
+      return closed_.load(memory_order_acquire);
+    }
+
+    // Modifiers
+    inline void close();
+
+    inline void push(const value_type& x);
+    inline bool try_push(const value_type& x);
+    inline bool try_push(no_block_tag, const value_type& x)
+    {
+      return try_push(x);
+    }
+
+    // Observers/Modifiers
+    inline void pull(value_type&);
+    inline void pull(value_type& elem, bool & closed);
+    inline value_type pull();
+    inline bool try_pull(value_type&);
+    inline bool try_pull(no_block_tag, value_type& elem)
+    {
+      return try_pull(elem);
+    }
+
+    // Batch Modifiers
+    template <typename ForwardIterator>
+    inline void push_back(ForwardIterator first, ForwardIterator last);
+    template <typename OutputIterator>
+    inline size_type pull_front(size_type max_elems, OutputIterator out);
+    template <typename OutputIterator>
+    inline size_type try_pull_front(size_type max_elems, OutputIterator out);
+
+  private:
+    // number of times a blocked thread retries, before it goes to sleep
+    BOOST_STATIC_CONSTANT(int, spin_count = 64);
+
+    lockfree::mpmc_ring<value_type> ring_;
+    atomic<bool> closed_;
+    // number of sleeping threads not notified yet, the fast paths only take the mutex, if they are not zero
+    atomic<size_type> waiting_empty_;
+    atomic<size_type> waiting_full_;
+    mutex mtx_;
+    condition_variable not_empty_;
+    condition_variable not_full_;
+
+    void throw_if_closed()
+    {
+      if (closed())
+      {
+        BOOST_THROW_EXCEPTION( sync_queue_is_closed() );
+      }
+    }
+
+    // Wakes up to moved sleepers, and removes them from the count of sleepers, so that the next operations do not
+    // notify them again before they had the chance to run.
+    void notify_if_needed(condition_variable& cv, atomic<size_type>& waiting, size_type moved)
+    {
+      // pairs with the fence in the waiting loops: either the sleeper sees the change of the ring, or we see it
+      atomic_thread_fence(memory_order_seq_cst);
+      if (waiting.load(memory_order_relaxed) == 0)
+        return;
+      unique_lock<mutex> lk(mtx_);
+      size_type waiting_now = waiting.load(memory_order_relaxed);
+      size_type n = moved < waiting_now ? moved : waiting_now;
+      waiting.fetch_sub(n, memory_order_relaxed);
+      lk.unlock();
+      for (; n != 0; --n)
+        cv.notify_one();
+    }
+
+    // Sleeps until the ring is not empty or the queue is closed. Returns false, if it is closed.
+    bool wait_until_not_empty()
+    {
+      for (int i = 0; i < spin_count; ++i)
+      {
+        if (!ring_.empty()) return true;
+        if (closed()) return false;
+      }
+      unique_lock<mutex> lk(mtx_);
+      for (;;)
+      {
+        // the count is checked by the producers without the mutex, so the ring must be checked after announcing us
+        waiting_empty_.fetch_add(1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        if (!ring_.empty() || closed())
+        {
+          waiting_empty_.fetch_sub(1, memory_order_relaxed);
+          break;
+        }
+        not_empty_.wait(lk);
+      }
+      return !closed() || !ring_.empty();
+    }
+  };
+
+  template <typename ValueType>
+  void sync_lockfree_queue<ValueType>::close()
+  {
+    closed_.store(true, memory_order_release);
+    lock_guard<mutex> lk(mtx_);
+    not_empty_.notify_all();
+    not_full_.notify_all();
+  }
+
+  template <typename ValueType>
+  bool sync_lockfree_queue<ValueType>::try_push(const ValueType& elem)
+  {
+    throw_if_closed();
+    if (!ring_.push(elem))
+      return false;
+    notify_if_needed(not_empty_, waiting_empty_, 1);
+    return true;
+  }
+
+  template <typename ValueType>
+  void sync_lockfree_queue<ValueType>::push(const ValueType& elem)
+  {
+    push_back(&elem, &elem + 1);
+  }
+
+  template <typename ValueType>
+  template <typename ForwardIterator>
+  void sync_lockfree_queue<ValueType>::push_back(ForwardIterator first, ForwardIterator last)
+  {
+    while (first != last)
+    {
+      throw_if_closed();
+      ForwardIterator next = ring_.push(first, last);
+      if (next != first)
+      {
+        notify_if_needed(not_empty_, waiting_empty_, std::distance(first, next));
+        first = next;
+        continue;
+      }
+      // full, wait for a consumer
+      for (int i = 0; i < spin_count && next == first; ++i)
+        next = ring_.push(first, last);
+      if (next != first)
+      {
+        notify_if_needed(not_empty_, waiting_empty_, std::distance(first, next));
+        first = next;
+        continue;
+      }
+      unique_lock<mutex> lk(mtx_);
+      for (;;)
+      {
+        waiting_full_.fetch_add(1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        if (closed() || (next = ring_.push(first, last)) != first)
+        {
+          waiting_full_.fetch_sub(1, memory_order_relaxed);
+          break;
+        }
+        not_full_.wait(lk);
+      }
+      lk.unlock();
+      if (next != first)
+      {
+        notify_if_needed(not_empty_, waiting_empty_, std::distance(first, next));
+        first = next;
+      }
+    }
+  }
+
+  template <typename ValueType>
+  bool sync_lockfree_queue<ValueType>::try_pull(ValueType& elem)
+  {
+    if (!ring_.pop(elem))
+    {
+      throw_if_closed();
+      return false;
+    }
+    notify_if_needed(not_full_, waiting_full_, 1);
+    return true;
+  }
+
+  template <typename ValueType>
+  void sync_lockfree_queue<ValueType>::pull(ValueType& elem)
+  {
+    pull_front(1, &elem);
+  }
+
+  template <typename ValueType>
+  void sync_lockfree_queue<ValueType>::pull(ValueType& elem, bool & closed)
+  {
+    try
+    {
+      pull(elem);
+      closed = false;
+    }
+    catch (sync_queue_is_closed&)
+    {
+      closed = true;
+    }
+  }
+
+  template <typename ValueType>
+  ValueType sync_lockfree_queue<ValueType>::pull()
+  {
+    value_type elem;
+    pull(elem);
+    return elem;
+  }
+
+  template <typename ValueType>
+  template <typename OutputIterator>
+  typename sync_lockfree_queue<ValueType>::size_type
+  sync_lockfree_queue<ValueType>::pull_front(size_type max_elems, OutputIterator out)
+  {
+    if (max_elems == 0) return 0;
+    for (;;)
+    {
+      size_type n = ring_.pop(out, max_elems);
+      if (n != 0)
+      {
+        notify_if_needed(not_full_, waiting_full_, n);
+        return n;
+      }
+      if (!wait_until_not_empty())
+      {
+        // closed, but elements pushed before close() are still delivered
+        n = ring_.pop(out, max_elems);
+        if (n == 0)
+          BOOST_THROW_EXCEPTION( sync_queue_is_closed() );
+        notify_if_needed(not_full_, waiting_full_, n);
+        return n;
+      }
+    }
+  }
+
+  template <typename ValueType>
+  template <typename OutputIterator>
+  typename sync_lockfree_queue<ValueType>::size_type
+  sync_lockfree_queue<ValueType>::try_pull_front(size_type max_elems, OutputIterator out)
+  {
+    size_type n = ring_.pop(out, max_elems);
+    if (n == 0)
+    {
+      throw_if_closed();
+      return 0;
+    }
+    notify_if_needed(not_full_, waiting_full_, n);
+    return n;
+  }
+
+  template <typename ValueType>
+  sync_lockfree_queue<ValueType>& operator<<(sync_lockfree_queue<ValueType>& sbq, ValueType const&elem)
+  {
+    sbq.push(elem);
+    return sbq;
+  }
+
+  template <typename ValueType>
+  sync_lockfree_queue<ValueType>& operator>>(sync_lockfree_queue<ValueType>& sbq, ValueType &elem)
+  {
+    sbq.pull(elem);
+    return sbq;
+  }
+
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
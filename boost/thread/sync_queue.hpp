@@ -68,6 +68,15 @@ namespace boost
     inline bool try_pull(no_block_tag,value_type&);
     inline shared_ptr<ValueType> try_pull();
 
+    // Batch Modifiers
+    // The elements are moved with a single lock of the queue and the waiting threads are notified once.
+    template <typename InputIterator>
+    inline void push_back(InputIterator first, InputIterator last);
+    template <typename OutputIterator>
+    inline size_type pull_front(size_type max_elems, OutputIterator out);
+    template <typename OutputIterator>
+    inline size_type try_pull_front(size_type max_elems, OutputIterator out);
+
   private:
     mutable mutex mtx_;
     condition_variable not_empty_;
@@ -108,6 +117,20 @@ namespace boost
         not_empty_.notify_one();
       }
     }
+    // wakes up one waiting thread per pushed element, but no more than are waiting
+    inline void notify_not_empty_if_needed(unique_lock<mutex>& lk, size_type pushed)
+    {
+      size_type const to_notify = pushed < waiting_empty_ ? pushed : waiting_empty_;
+      if (to_notify > 0)
+      {
+        waiting_empty_ -= to_notify;
+        lk.unlock();
+        for (size_type i = 0; i < to_notify; ++i)
+        {
+          not_empty_.notify_one();
+        }
+      }
+    }
 
     inline void pull(value_type& elem, unique_lock<mutex>& )
     {
@@ -129,9 +152,21 @@ namespace boost
 
     inline void push(BOOST_THREAD_RV_REF(value_type) elem, unique_lock<mutex>& lk)
     {
-      data_.push(boost::move(elem));
+      data_.push_back(boost::move(elem));
       notify_not_empty_if_needed(lk);
     }
+
+    template <typename OutputIterator>
+    inline size_type pull_front(size_type max_elems, OutputIterator& out, unique_lock<mutex>& )
+    {
+      size_type n = 0;
+      for (; n < max_elems && ! data_.empty(); ++n, ++out)
+      {
+        *out = boost::move(data_.front());
+        data_.pop_front();
+      }
+      return n;
+    }
   };
 
   template <typename ValueType>
@@ -441,7 +476,7 @@ namespace boost
     try
     {
       unique_lock<mutex> lk(mtx_);
-      return try_push(elem, lk);
+      return try_push(boost::move(elem), lk);
     }
     catch (...)
     {
@@ -460,7 +495,7 @@ namespace boost
       {
         return false;
       }
-      return try_push(elem, lk);
+      return try_push(boost::move(elem), lk);
     }
     catch (...)
     {
@@ -476,7 +511,70 @@ namespace boost
     {
       unique_lock<mutex> lk(mtx_);
       throw_if_closed(lk);
-      push(elem, lk);
+      push(boost::move(elem), lk);
+    }
+    catch (...)
+    {
+      close();
+      throw;
+    }
+  }
+
+  template <typename ValueType>
+  template <typename InputIterator>
+  void sync_queue<ValueType>::push_back(InputIterator first, InputIterator last)
+  {
+    try
+    {
+      unique_lock<mutex> lk(mtx_);
+      throw_if_closed(lk);
+      size_type n = 0;
+      for (; first != last; ++first, ++n)
+      {
+        data_.push_back(*first);
+      }
+      notify_not_empty_if_needed(lk, n);
+    }
+    catch (...)
+    {
+      close();
+      throw;
+    }
+  }
+
+  template <typename ValueType>
+  template <typename OutputIterator>
+  typename sync_queue<ValueType>::size_type
+  sync_queue<ValueType>::pull_front(size_type max_elems, OutputIterator out)
+  {
+    try
+    {
+      if (max_elems == 0) return 0;
+      unique_lock<mutex> lk(mtx_);
+      wait_until_not_empty(lk);
+      return pull_front(max_elems, out, lk);
+    }
+    catch (...)
+    {
+      close();
+      throw;
+    }
+  }
+
+  template <typename ValueType>
+  template <typename OutputIterator>
+  typename sync_queue<ValueType>::size_type
+  sync_queue<ValueType>::try_pull_front(size_type max_elems, OutputIterator out)
+  {
+    try
+    {
+      unique_lock<mutex> lk(mtx_);
+      if (empty(lk))
+      {
+        throw_if_closed(lk);
+        return 0;
+      }
+      return pull_front(max_elems, out, lk);
     }
     catch (...)
     {
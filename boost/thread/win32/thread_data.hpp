@@ -16,6 +16,9 @@
 #include <boost/chrono/system_clocks.hpp>
 #endif
 
+#include <boost/cstdint.hpp>
+
+#include <cstring>
 #include <map>
 #include <vector>
 #include <utility>
@@ -32,10 +35,20 @@ namespace boost
   class condition_variable;
   class mutex;
 
+  namespace detail
+  {
+    // Fills mask with the CPUs of a NUMA node. Returns false, if the node does not exist.
+    BOOST_THREAD_DECL bool numa_node_affinity_mask(unsigned node, boost::uint64_t& mask) BOOST_NOEXCEPT;
+    // Restricts the calling thread to the CPUs of mask.
+    BOOST_THREAD_DECL bool set_current_thread_affinity_mask(boost::uint64_t mask) BOOST_NOEXCEPT;
+  }
+
   class thread_attributes {
   public:
       thread_attributes() BOOST_NOEXCEPT {
         val_.stack_size = 0;
+        val_.affinity_mask = 0;
+        val_.name[0] = '\0';
         //val_.lpThreadAttributes=0;
       }
       ~thread_attributes() {
@@ -58,8 +71,47 @@ namespace boost
       //  return val_.lpThreadAttributes;
       //}
 
+      // affinity
+      // Restricts the new thread to the CPUs of [first, last). Returns false, if a CPU number does not fit in the
+      // affinity mask.
+      template <typename InputIterator>
+      bool set_affinity(InputIterator first, InputIterator last) BOOST_NOEXCEPT {
+        boost::uint64_t mask = 0;
+        for (; first != last; ++first) {
+          unsigned const cpu = *first;
+          if (cpu >= 64) return false;
+          mask |= boost::uint64_t(1) << cpu;
+        }
+        val_.affinity_mask = mask;
+        return mask != 0;
+      }
+      bool set_affinity(unsigned cpu) BOOST_NOEXCEPT {
+        return set_affinity(&cpu, &cpu + 1);
+      }
+      // Restricts the new thread to the CPUs of a NUMA node.
+      bool set_numa_node(unsigned node) BOOST_NOEXCEPT {
+        boost::uint64_t mask;
+        if (!detail::numa_node_affinity_mask(node, mask)) return false;
+        val_.affinity_mask = mask;
+        return true;
+      }
+
+      // name
+      // Windows threads cannot be named, the name is only kept. Returns false.
+      bool set_name(const char* name) BOOST_NOEXCEPT {
+        std::strncpy(val_.name, name, sizeof(val_.name) - 1);
+        val_.name[sizeof(val_.name) - 1] = '\0';
+        return false;
+      }
+      const char* get_name() const BOOST_NOEXCEPT {
+        return val_.name;
+      }
+
       struct win_attrs {
         std::size_t stack_size;
+        // CPUs the thread is restricted to, 0 if it is not restricted
+        boost::uint64_t affinity_mask;
+        char name[16];
         //LPSECURITY_ATTRIBUTES lpThreadAttributes;
       };
       typedef win_attrs native_handle_type;
@@ -249,6 +301,21 @@ namespace boost
     {
         void BOOST_THREAD_DECL yield() BOOST_NOEXCEPT;
 
+        // Restricts the calling thread to the CPUs of [first, last). Returns false, if a CPU number does not fit in
+        // the affinity mask.
+        template <typename InputIterator>
+        bool set_affinity(InputIterator first, InputIterator last) BOOST_NOEXCEPT
+        {
+            boost::uint64_t mask = 0;
+            for (; first != last; ++first)
+            {
+                unsigned const cpu = *first;
+                if (cpu >= 64) return false;
+                mask |= boost::uint64_t(1) << cpu;
+            }
+            return mask != 0 && detail::set_current_thread_affinity_mask(mask);
+        }
+
         bool BOOST_THREAD_DECL interruptible_wait(detail::win32::handle handle_to_wait_for,detail::timeout target_time);
         inline void interruptible_wait(uintmax_t milliseconds)
         {
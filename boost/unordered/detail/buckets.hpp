@@ -594,6 +594,10 @@ namespace boost { namespace unordered { namespace detail {
     template <typename SizeT>
     struct prime_policy
     {
+        static inline SizeT mix_hash(SizeT key) {
+            return key;
+        }
+
         template <typename Hash, typename T>
         static inline SizeT apply_hash(Hash const& hf, T const& x) {
             return hf(x);
@@ -615,9 +619,7 @@ namespace boost { namespace unordered { namespace detail {
     template <typename SizeT>
     struct mix64_policy
     {
-        template <typename Hash, typename T>
-        static inline SizeT apply_hash(Hash const& hf, T const& x) {
-            SizeT key = hf(x);
+        static inline SizeT mix_hash(SizeT key) {
             key = (~key) + (key << 21); // key = (key << 21) - key - 1;
             key = key ^ (key >> 24);
             key = (key + (key << 3)) + (key << 8); // key * 265
@@ -628,6 +630,11 @@ namespace boost { namespace unordered { namespace detail {
             return key;
         }
 
+        template <typename Hash, typename T>
+        static inline SizeT apply_hash(Hash const& hf, T const& x) {
+            return mix_hash(hf(x));
+        }
+
         static inline SizeT to_bucket(SizeT bucket_count, SizeT hash) {
             return hash & (bucket_count - 1);
         }
@@ -260,7 +260,8 @@ namespace boost { namespace unordered { namespace detail {
             }
         }
 
-        std::size_t count(key_type const& k) const
+        template <class Key>
+        std::size_t count(Key const& k) const
         {
             iterator n = this->find_node(k);
             if (!n.node_) return 0;
@@ -275,8 +276,9 @@ namespace boost { namespace unordered { namespace detail {
             return x;
         }
 
+        template <class Key>
         std::pair<iterator, iterator>
-            equal_range(key_type const& k) const
+            equal_range(Key const& k) const
         {
             iterator n = this->find_node(k);
             return std::make_pair(
@@ -379,7 +381,14 @@ namespace boost { namespace unordered { namespace detail {
                 std::size_t key_hash,
                 iterator pos)
         {
-            node_pointer n = a.release();
+            return add_node(a.release(), key_hash, pos);
+        }
+
+        inline iterator add_node(
+                node_pointer n,
+                std::size_t key_hash,
+                iterator pos)
+        {
             n->hash_ = key_hash;
             if (pos.node_) {
                 this->add_after_node(n, pos.node_);
@@ -505,6 +514,59 @@ namespace boost { namespace unordered { namespace detail {
             }
         }
 
+        ////////////////////////////////////////////////////////////////////////
+        // Node handles
+
+        // Insert a node which isn't in a container.
+        //
+        // Strong exception safety.
+        iterator insert_node(node_pointer n)
+        {
+            key_type const& k = this->get_key(n->value());
+            std::size_t key_hash = this->hash(k);
+            iterator position = this->find_node(key_hash, k);
+
+            this->reserve_for_insert(this->size_ + 1);
+            return this->add_node(n, key_hash, position);
+        }
+
+        // Unlink a node without destroying it, the caller takes ownership.
+        //
+        // no throw
+        node_pointer extract_by_iterator(c_iterator r)
+        {
+            BOOST_ASSERT(r.node_);
+            node_pointer n = r.node_;
+            std::size_t bucket_index = this->hash_to_bucket(n->hash_);
+
+            // Put the node in a group of its own, the same as erase does.
+            link_pointer prev = split_groups(n,
+                static_cast<node_pointer>(n->next_));
+
+            if (!prev) {
+                prev = this->get_previous_start(bucket_index);
+                while (prev->next_ != n)
+                    prev = static_cast<node_pointer>(prev->next_)->group_prev_;
+            }
+
+            prev->next_ = n->next_;
+            --this->size_;
+            this->fix_bucket(bucket_index, prev);
+
+            n->next_ = link_pointer();
+            n->init(n);
+            return n;
+        }
+
+        node_pointer extract_by_key(key_type const& k)
+        {
+            if(!this->size_) return node_pointer();
+
+            iterator it = this->find_node(k);
+            return it.node_ ?
+                extract_by_iterator(c_iterator(it)) : node_pointer();
+        }
+
         ////////////////////////////////////////////////////////////////////////
         // Erase
         //
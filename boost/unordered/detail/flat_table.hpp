@@ -0,0 +1,1379 @@
+// Copyright (C) 2013 Daniel James.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_UNORDERED_DETAIL_FLAT_TABLE_HPP_INCLUDED
+#define BOOST_UNORDERED_DETAIL_FLAT_TABLE_HPP_INCLUDED
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include <boost/unordered/detail/buckets.hpp>
+#include <boost/unordered/detail/extract_key.hpp>
+#include <boost/unordered/detail/util.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/assert.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+
+// Groups of control bytes are matched with SSE2 when it's available, and
+// byte by byte otherwise. Define BOOST_UNORDERED_NO_SSE2 to always use the
+// portable version.
+
+#if !defined(BOOST_UNORDERED_NO_SSE2) && \
+    (defined(__SSE2__) || defined(_M_X64) || \
+        (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#   define BOOST_UNORDERED_FLAT_SSE2
+#   include <emmintrin.h>
+#endif
+
+#if defined(BOOST_MSVC)
+#   include <intrin.h>
+#endif
+
+namespace boost { namespace unordered { namespace detail {
+
+    template <typename Types> struct flat_table;
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Control bytes
+    //
+    // Every slot in a flat table has a control byte. A full slot stores the
+    // low 7 bits of its element's hash (always positive), the other states
+    // are negative. The byte after the last slot is a sentinel which stops
+    // iteration.
+
+    static const signed char flat_empty = -128;
+    static const signed char flat_deleted = -2;
+    static const signed char flat_sentinel = -1;
+
+    inline signed char flat_h2(std::size_t hash)
+    {
+        return static_cast<signed char>(hash & 0x7f);
+    }
+
+    inline std::size_t flat_h1(std::size_t hash)
+    {
+        return hash >> 7;
+    }
+
+    // Index of the lowest bit set in a non-zero match mask.
+
+    inline unsigned flat_first_bit(unsigned mask)
+    {
+        BOOST_ASSERT(mask);
+#if defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_ctz(mask));
+#elif defined(BOOST_MSVC)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<unsigned>(index);
+#else
+        unsigned index = 0;
+        while (!(mask & 1u)) { mask >>= 1; ++index; }
+        return index;
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Group
+    //
+    // The slots are probed a group at a time. Matching returns a bit mask
+    // with a bit set for every control byte in the group that matches.
+
+#if defined(BOOST_UNORDERED_FLAT_SSE2)
+
+    struct flat_group
+    {
+        enum { width = 16 };
+
+        explicit flat_group(signed char const* ctrl) :
+            ctrl_(_mm_loadu_si128(reinterpret_cast<__m128i const*>(ctrl)))
+        {}
+
+        unsigned match(signed char h2) const
+        {
+            return static_cast<unsigned>(_mm_movemask_epi8(
+                _mm_cmpeq_epi8(ctrl_, _mm_set1_epi8(h2))));
+        }
+
+        unsigned match_empty() const
+        {
+            return match(flat_empty);
+        }
+
+        // Empty or deleted slots.
+        unsigned match_available() const
+        {
+            return static_cast<unsigned>(_mm_movemask_epi8(
+                _mm_cmplt_epi8(ctrl_, _mm_set1_epi8(flat_sentinel))));
+        }
+
+    private:
+        __m128i ctrl_;
+    };
+
+#else
+
+    struct flat_group
+    {
+        enum { width = 16 };
+
+        explicit flat_group(signed char const* ctrl) : ctrl_(ctrl) {}
+
+        unsigned match(signed char h2) const
+        {
+            unsigned mask = 0;
+            for (unsigned i = 0; i < width; ++i)
+                if (ctrl_[i] == h2) mask |= 1u << i;
+            return mask;
+        }
+
+        unsigned match_empty() const
+        {
+            return match(flat_empty);
+        }
+
+        unsigned match_available() const
+        {
+            unsigned mask = 0;
+            for (unsigned i = 0; i < width; ++i)
+                if (ctrl_[i] < flat_sentinel) mask |= 1u << i;
+            return mask;
+        }
+
+    private:
+        signed char const* ctrl_;
+    };
+
+#endif
+
+    // The control bytes of a table without slots, so that lookups in it
+    // don't need to check for an allocation.
+
+    template <typename T>
+    struct flat_empty_group
+    {
+        static signed char const ctrl[flat_group::width];
+    };
+
+    template <typename T>
+    signed char const flat_empty_group<T>::ctrl[flat_group::width] = {
+        flat_sentinel, flat_empty, flat_empty, flat_empty,
+        flat_empty, flat_empty, flat_empty, flat_empty,
+        flat_empty, flat_empty, flat_empty, flat_empty,
+        flat_empty, flat_empty, flat_empty, flat_empty
+    };
+
+    // Find a slot for a new element. The probe sequence visits every group
+    // in turn since the group count is a power of two, and the load is kept
+    // low enough that there's always an available slot.
+
+    inline std::size_t flat_find_available(signed char const* ctrl,
+            std::size_t group_mask, std::size_t hash)
+    {
+        std::size_t pos = flat_h1(hash) & group_mask;
+
+        for (std::size_t step = 1;; ++step) {
+            unsigned mask = flat_group(ctrl + pos * flat_group::width)
+                .match_available();
+            if (mask) return pos * flat_group::width + flat_first_bit(mask);
+            pos = (pos + step) & group_mask;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Hash Policy
+    //
+    // The probe position comes from the high bits of the hash and the
+    // control byte from the low bits, so both have to be well mixed.
+    // mix64_policy does that, prime_policy leaves the hash alone so on
+    // other platforms this mixes it with the murmurhash3 finalizer.
+
+    template <typename SizeT>
+    struct mix32_policy
+    {
+        static inline SizeT mix_hash(SizeT key) {
+            key = key ^ (key >> 16);
+            key = static_cast<SizeT>(key * 0x85ebca6bu);
+            key = key ^ (key >> 13);
+            key = static_cast<SizeT>(key * 0xc2b2ae35u);
+            key = key ^ (key >> 16);
+            return key;
+        }
+
+        template <typename Hash, typename T>
+        static inline SizeT apply_hash(Hash const& hf, T const& x) {
+            return mix_hash(hf(x));
+        }
+    };
+
+    template <typename Policy>
+    struct pick_flat_policy_impl {
+        typedef mix32_policy<std::size_t> type;
+    };
+
+    template <typename SizeT>
+    struct pick_flat_policy_impl<mix64_policy<SizeT> > {
+        typedef mix64_policy<SizeT> type;
+    };
+
+    struct pick_flat_policy :
+        pick_flat_policy_impl<pick_policy::type> {};
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Types
+
+    template <typename A, typename T, typename H, typename P>
+    struct flat_set
+    {
+        typedef boost::unordered::detail::flat_set<A, T, H, P> types;
+
+        typedef typename boost::unordered::detail::rebind_wrap<A, T>::type
+            allocator;
+        typedef T value_type;
+        typedef H hasher;
+        typedef P key_equal;
+        typedef T key_type;
+
+        typedef boost::unordered::detail::allocator_traits<allocator> traits;
+
+        typedef boost::unordered::detail::flat_table<types> table;
+        typedef boost::unordered::detail::set_extractor<value_type> extractor;
+
+        typedef boost::unordered::detail::pick_flat_policy::type policy;
+    };
+
+    template <typename A, typename K, typename M, typename H, typename P>
+    struct flat_map
+    {
+        typedef boost::unordered::detail::flat_map<A, K, M, H, P> types;
+
+        typedef std::pair<K const, M> value_type;
+        typedef typename boost::unordered::detail::rebind_wrap<
+            A, value_type>::type allocator;
+        typedef H hasher;
+        typedef P key_equal;
+        typedef K key_type;
+
+        typedef boost::unordered::detail::allocator_traits<allocator> traits;
+
+        typedef boost::unordered::detail::flat_table<types> table;
+        typedef boost::unordered::detail::map_extractor<key_type, value_type>
+            extractor;
+
+        typedef boost::unordered::detail::pick_flat_policy::type policy;
+    };
+}}}
+
+namespace boost { namespace unordered { namespace iterator_detail {
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Iterators
+    //
+    // An iterator points to a control byte and the slot it belongs to, and
+    // skips over the control bytes of empty and deleted slots. Only the
+    // sentinel stops it, so an end iterator points to the sentinel.
+    //
+    // all no throw
+
+    template <typename Value> struct flat_iterator;
+    template <typename Value> struct flat_c_iterator;
+
+    template <typename Value>
+    struct flat_iterator
+        : public boost::iterator<
+            std::forward_iterator_tag,
+            Value,
+            std::ptrdiff_t,
+            Value*,
+            Value&>
+    {
+#if !defined(BOOST_NO_MEMBER_TEMPLATE_FRIENDS)
+        template <typename>
+        friend struct boost::unordered::iterator_detail::flat_c_iterator;
+        template <typename>
+        friend struct boost::unordered::detail::flat_table;
+    private:
+#endif
+        signed char const* ctrl_;
+        Value* slot_;
+
+    public:
+
+        typedef Value value_type;
+
+        flat_iterator() BOOST_NOEXCEPT : ctrl_(), slot_() {}
+
+        flat_iterator(signed char const* c, Value* s) BOOST_NOEXCEPT :
+            ctrl_(c), slot_(s) {}
+
+        value_type& operator*() const {
+            return *slot_;
+        }
+
+        value_type* operator->() const {
+            return slot_;
+        }
+
+        flat_iterator& operator++() {
+            do {
+                ++ctrl_; ++slot_;
+            } while (*ctrl_ < boost::unordered::detail::flat_sentinel);
+            return *this;
+        }
+
+        flat_iterator operator++(int) {
+            flat_iterator tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(flat_iterator const& x) const BOOST_NOEXCEPT {
+            return ctrl_ == x.ctrl_;
+        }
+
+        bool operator!=(flat_iterator const& x) const BOOST_NOEXCEPT {
+            return ctrl_ != x.ctrl_;
+        }
+    };
+
+    template <typename Value>
+    struct flat_c_iterator
+        : public boost::iterator<
+            std::forward_iterator_tag,
+            Value,
+            std::ptrdiff_t,
+            Value const*,
+            Value const&>
+    {
+        friend struct boost::unordered::iterator_detail::flat_iterator<Value>;
+
+#if !defined(BOOST_NO_MEMBER_TEMPLATE_FRIENDS)
+        template <typename>
+        friend struct boost::unordered::detail::flat_table;
+    private:
+#endif
+        typedef boost::unordered::iterator_detail::flat_iterator<Value>
+            iterator;
+        signed char const* ctrl_;
+        Value* slot_;
+
+    public:
+
+        typedef Value value_type;
+
+        flat_c_iterator() BOOST_NOEXCEPT : ctrl_(), slot_() {}
+
+        flat_c_iterator(signed char const* c, Value* s) BOOST_NOEXCEPT :
+            ctrl_(c), slot_(s) {}
+
+        flat_c_iterator(iterator const& x) BOOST_NOEXCEPT :
+            ctrl_(x.ctrl_), slot_(x.slot_) {}
+
+        value_type const& operator*() const {
+            return *slot_;
+        }
+
+        value_type const* operator->() const {
+            return slot_;
+        }
+
+        flat_c_iterator& operator++() {
+            do {
+                ++ctrl_; ++slot_;
+            } while (*ctrl_ < boost::unordered::detail::flat_sentinel);
+            return *this;
+        }
+
+        flat_c_iterator operator++(int) {
+            flat_c_iterator tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+
+        friend bool operator==(flat_c_iterator const& x,
+                flat_c_iterator const& y) BOOST_NOEXCEPT
+        {
+            return x.ctrl_ == y.ctrl_;
+        }
+
+        friend bool operator!=(flat_c_iterator const& x,
+                flat_c_iterator const& y) BOOST_NOEXCEPT
+        {
+            return x.ctrl_ != y.ctrl_;
+        }
+    };
+}}}
+
+namespace boost { namespace unordered { namespace detail {
+
+    ////////////////////////////////////////////////////////////////////////////
+    // flat_array_constructor
+    //
+    // Allocates the control bytes and slots for a table, and holds them
+    // while elements are constructed in them. If an exception is thrown
+    // before the table takes charge of them, the constructed elements are
+    // destroyed and the arrays are freed.
+
+    template <typename Allocator>
+    struct flat_array_constructor
+    {
+    private:
+        flat_array_constructor(flat_array_constructor const&);
+        flat_array_constructor& operator=(flat_array_constructor const&);
+    public:
+        typedef boost::unordered::detail::allocator_traits<Allocator>
+            value_allocator_traits;
+        typedef typename value_allocator_traits::value_type value_type;
+        typedef typename boost::unordered::detail::
+            rebind_wrap<Allocator, signed char>::type ctrl_allocator;
+        typedef boost::unordered::detail::allocator_traits<ctrl_allocator>
+            ctrl_allocator_traits;
+
+        Allocator& alloc_;
+        std::size_t capacity_;
+        signed char* ctrl_;
+        value_type* slots_;
+
+        flat_array_constructor(Allocator& a, std::size_t capacity) :
+            alloc_(a), capacity_(capacity), ctrl_(), slots_()
+        {
+            BOOST_ASSERT(capacity &&
+                !(capacity & (capacity - 1)) &&
+                capacity % flat_group::width == 0);
+
+            ctrl_allocator ctrl_alloc(alloc_);
+            ctrl_ = ctrl_allocator_traits::allocate(ctrl_alloc, capacity + 1);
+            std::memset(ctrl_, flat_empty, capacity);
+            ctrl_[capacity] = flat_sentinel;
+            slots_ = value_allocator_traits::allocate(alloc_, capacity);
+        }
+
+        ~flat_array_constructor()
+        {
+            if (ctrl_) destroy(alloc_, capacity_, ctrl_, slots_);
+        }
+
+        std::size_t group_mask() const
+        {
+            return capacity_ / flat_group::width - 1;
+        }
+
+        // Construct an element whose key is known to not be in the array
+        // yet.
+        template <BOOST_UNORDERED_EMPLACE_TEMPLATE>
+        void construct(std::size_t key_hash, BOOST_UNORDERED_EMPLACE_ARGS)
+        {
+            std::size_t index = boost::unordered::detail::
+                flat_find_available(ctrl_, group_mask(), key_hash);
+            boost::unordered::detail::func::construct_value_impl(
+                alloc_, slots_ + index, BOOST_UNORDERED_EMPLACE_FORWARD);
+            ctrl_[index] = flat_h2(key_hash);
+        }
+
+        void release()
+        {
+            ctrl_ = 0;
+            slots_ = 0;
+        }
+
+        // Destroy the elements in an array, and free it.
+        static void destroy(Allocator& alloc, std::size_t capacity,
+                signed char* ctrl, value_type* slots)
+        {
+            if (!boost::has_trivial_destructor<value_type>::value) {
+                for (std::size_t i = 0; i < capacity; ++i) {
+                    if (ctrl[i] >= 0) {
+                        boost::unordered::detail::func::destroy_value_impl(
+                            alloc, slots + i);
+                    }
+                }
+            }
+
+            ctrl_allocator ctrl_alloc(alloc);
+            ctrl_allocator_traits::deallocate(ctrl_alloc, ctrl, capacity + 1);
+            value_allocator_traits::deallocate(alloc, slots, capacity);
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // flat_value_holder
+    //
+    // Temporary storage for an element that has to be constructed before its
+    // key is known.
+
+    template <typename Allocator>
+    struct flat_value_holder
+    {
+    private:
+        flat_value_holder(flat_value_holder const&);
+        flat_value_holder& operator=(flat_value_holder const&);
+    public:
+        typedef typename boost::unordered::detail::
+            allocator_traits<Allocator>::value_type value_type;
+
+        Allocator& alloc_;
+        typename boost::aligned_storage<
+            sizeof(value_type),
+            boost::alignment_of<value_type>::value>::type data_;
+        bool constructed_;
+
+        explicit flat_value_holder(Allocator& a) :
+            alloc_(a), constructed_(false) {}
+
+        ~flat_value_holder()
+        {
+            if (constructed_) {
+                boost::unordered::detail::func::destroy_value_impl(
+                    alloc_, value_ptr());
+            }
+        }
+
+        template <BOOST_UNORDERED_EMPLACE_TEMPLATE>
+        void construct(BOOST_UNORDERED_EMPLACE_ARGS)
+        {
+            boost::unordered::detail::func::construct_value_impl(
+                alloc_, value_ptr(), BOOST_UNORDERED_EMPLACE_FORWARD);
+            constructed_ = true;
+        }
+
+        value_type* value_ptr()
+        {
+            return static_cast<value_type*>(static_cast<void*>(&data_));
+        }
+
+        value_type& value()
+        {
+            BOOST_ASSERT(constructed_);
+            return *value_ptr();
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // flat_table
+    //
+    // Open addressing hash table with unique keys. Elements are stored
+    // directly in an array of slots, with a parallel array of control bytes
+    // which are searched a group at a time. The number of slots is a power
+    // of two multiple of the group width, and at most 7/8 of them are used.
+    //
+    // Erased elements leave a tombstone ('deleted') unless no probe sequence
+    // can run past their group, which is the case when the group still has
+    // an empty slot. Tombstones are dropped when the table is rehashed.
+    //
+    // Elements are moved when the table is rehashed, so pointers and
+    // references to them are invalidated along with the iterators.
+
+    template <typename Types>
+    struct flat_table :
+        boost::unordered::detail::functions<
+            typename Types::hasher,
+            typename Types::key_equal>
+    {
+    private:
+        flat_table(flat_table const&);
+        flat_table& operator=(flat_table const&);
+    public:
+        typedef typename Types::hasher hasher;
+        typedef typename Types::key_equal key_equal;
+        typedef typename Types::key_type key_type;
+        typedef typename Types::extractor extractor;
+        typedef typename Types::value_type value_type;
+        typedef typename Types::policy policy;
+
+        typedef boost::unordered::detail::functions<
+            typename Types::hasher,
+            typename Types::key_equal> functions;
+        typedef typename functions::set_hash_functions set_hash_functions;
+
+        typedef typename Types::allocator value_allocator;
+        typedef boost::unordered::detail::allocator_traits<value_allocator>
+            value_allocator_traits;
+        typedef boost::unordered::detail::
+            flat_array_constructor<value_allocator> array_constructor;
+        typedef boost::unordered::detail::
+            flat_value_holder<value_allocator> value_holder;
+
+        // The slots are accessed through plain pointers.
+        BOOST_STATIC_ASSERT((boost::is_same<
+            typename value_allocator_traits::pointer, value_type*>::value));
+
+        typedef boost::unordered::iterator_detail::
+            flat_iterator<value_type> iterator;
+        typedef boost::unordered::iterator_detail::
+            flat_c_iterator<value_type> c_iterator;
+
+        typedef std::pair<iterator, bool> emplace_return;
+
+        ////////////////////////////////////////////////////////////////////////
+        // Members
+
+        value_allocator alloc_;
+        signed char* ctrl_;
+        value_type* slots_;
+        std::size_t capacity_;
+        std::size_t size_;
+        std::size_t growth_left_;
+
+        ////////////////////////////////////////////////////////////////////////
+        // Constructors
+
+        flat_table(std::size_t num_buckets,
+                hasher const& hf,
+                key_equal const& eq,
+                value_allocator const& a) :
+            functions(hf, eq),
+            alloc_(a),
+            ctrl_(empty_ctrl()),
+            slots_(),
+            capacity_(0),
+            size_(0),
+            growth_left_(0)
+        {
+            if (num_buckets) rehash_impl(round_capacity(num_buckets));
+        }
+
+        flat_table(flat_table const& x, value_allocator const& a) :
+            functions(x),
+            alloc_(a),
+            ctrl_(empty_ctrl()),
+            slots_(),
+            capacity_(0),
+            size_(0),
+            growth_left_(0)
+        {
+            copy_elements(x);
+        }
+
+        flat_table(flat_table& x, boost::unordered::detail::move_tag m) :
+            functions(x, m),
+            alloc_(x.alloc_),
+            ctrl_(x.ctrl_),
+            slots_(x.slots_),
+            capacity_(x.capacity_),
+            size_(x.size_),
+            growth_left_(x.growth_left_)
+        {
+            x.reset();
+        }
+
+        flat_table(flat_table& x, value_allocator const& a,
+                boost::unordered::detail::move_tag m) :
+            functions(x, m),
+            alloc_(a),
+            ctrl_(empty_ctrl()),
+            slots_(),
+            capacity_(0),
+            size_(0),
+            growth_left_(0)
+        {
+            if (alloc_ == x.alloc_) {
+                move_arrays_from(x);
+            }
+            else if (x.size_) {
+                array_constructor constructor(alloc_, capacity_for(x.size_));
+
+                for (std::size_t i = 0; i < x.capacity_; ++i) {
+                    if (x.ctrl_[i] >= 0) {
+                        constructor.construct(hash(get_key(x.slots_[i])),
+                            BOOST_UNORDERED_EMPLACE_ARGS1(
+                                boost::move(x.slots_[i])));
+                    }
+                }
+
+                take_arrays(constructor, x.size_);
+            }
+        }
+
+        ~flat_table()
+        {
+            delete_arrays();
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Data access
+
+        static signed char* empty_ctrl()
+        {
+            return const_cast<signed char*>(
+                boost::unordered::detail::flat_empty_group<void>::ctrl);
+        }
+
+        std::size_t group_mask() const
+        {
+            return capacity_ ? capacity_ / flat_group::width - 1 : 0;
+        }
+
+        iterator iterator_at(std::size_t index) const
+        {
+            return iterator(ctrl_ + index, slots_ + index);
+        }
+
+        std::size_t index_of(c_iterator it) const
+        {
+            return static_cast<std::size_t>(it.ctrl_ - ctrl_);
+        }
+
+        iterator begin() const
+        {
+            iterator it = iterator_at(0);
+            if (*ctrl_ < flat_sentinel) ++it;
+            return it;
+        }
+
+        iterator end() const
+        {
+            return iterator_at(capacity_);
+        }
+
+        float load_factor() const
+        {
+            return capacity_ ? static_cast<float>(size_)
+                / static_cast<float>(capacity_) : 0.0f;
+        }
+
+        key_type const& get_key(value_type const& x) const
+        {
+            return extractor::extract(x);
+        }
+
+        std::size_t hash(key_type const& k) const
+        {
+            return policy::apply_hash(this->hash_function(), k);
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Load methods
+
+        // The number of elements that fit in 'capacity' slots.
+        static std::size_t max_load(std::size_t capacity)
+        {
+            return capacity - capacity / 8;
+        }
+
+        std::size_t max_bucket_count() const
+        {
+            std::size_t const max = value_allocator_traits::max_size(alloc_);
+            std::size_t capacity = flat_group::width;
+            while (capacity <= max / 2) capacity *= 2;
+            return capacity;
+        }
+
+        std::size_t max_size() const
+        {
+            return max_load(max_bucket_count());
+        }
+
+        // Smallest valid capacity which is at least 'n'.
+        std::size_t round_capacity(std::size_t n) const
+        {
+            if (!n) return 0;
+
+            std::size_t capacity = flat_group::width;
+            while (capacity < n) {
+                if (capacity >= max_bucket_count()) {
+                    boost::throw_exception(std::length_error(
+                        "Too many elements for unordered flat container"));
+                }
+                capacity *= 2;
+            }
+            return capacity;
+        }
+
+        // Smallest valid capacity which can hold 'size' elements.
+        std::size_t capacity_for(std::size_t size) const
+        {
+            return round_capacity(size + (size + 6) / 7);
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Rehash
+        //
+        // Strong exception safety if moving the elements can't throw, or if
+        // they're copied. Basic otherwise.
+
+        void rehash_impl(std::size_t new_capacity)
+        {
+            BOOST_ASSERT(max_load(new_capacity) >= size_);
+
+            if (!new_capacity) {
+                delete_arrays();
+                reset();
+                return;
+            }
+
+            array_constructor a(alloc_, new_capacity);
+
+            for (std::size_t i = 0; i < capacity_; ++i) {
+                if (ctrl_[i] >= 0) {
+                    a.construct(hash(get_key(slots_[i])),
+                        BOOST_UNORDERED_EMPLACE_ARGS1(
+                            boost::move(slots_[i])));
+                }
+            }
+
+            delete_arrays();
+            take_arrays(a, size_);
+        }
+
+        void rehash(std::size_t min_buckets)
+        {
+            std::size_t new_capacity = (std::max)(
+                round_capacity(min_buckets), capacity_for(size_));
+            if (new_capacity != capacity_) rehash_impl(new_capacity);
+        }
+
+        void reserve(std::size_t num_elements)
+        {
+            std::size_t new_capacity = capacity_for(num_elements);
+            if (new_capacity > capacity_) rehash_impl(new_capacity);
+        }
+
+        // Called when there's no space left for an insert. If tombstones take
+        // up at least half of the used slots they're dropped without growing.
+        void reserve_for_insert()
+        {
+            BOOST_ASSERT(!growth_left_);
+            rehash_impl(size_ < max_load(capacity_) / 2 ?
+                capacity_ : capacity_for(size_ + 1));
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Find
+
+        // Returns the index of the element, or 'capacity_' if it isn't
+        // found.
+        template <class Key, class Pred>
+        std::size_t find_node_impl(
+                std::size_t key_hash,
+                Key const& k,
+                Pred const& eq) const
+        {
+            signed char const h2 = flat_h2(key_hash);
+            std::size_t const mask = group_mask();
+            std::size_t pos = flat_h1(key_hash) & mask;
+
+            for (std::size_t step = 1;; ++step) {
+                signed char const* group_ctrl =
+                    ctrl_ + pos * flat_group::width;
+                flat_group g(group_ctrl);
+
+                for (unsigned m = g.match(h2); m; m &= m - 1) {
+                    std::size_t index = pos * flat_group::width +
+                        flat_first_bit(m);
+                    if (eq(k, get_key(slots_[index]))) return index;
+                }
+
+                if (g.match_empty()) return capacity_;
+                pos = (pos + step) & mask;
+            }
+        }
+
+        // 'Key' is either key_type, or a type that the transparent hash
+        // function and equality predicate accept.
+        template <class Key>
+        std::size_t find_node(Key const& k) const
+        {
+            return find_node_impl(
+                policy::apply_hash(this->hash_function(), k),
+                k, this->key_eq());
+        }
+
+        template <class Key>
+        iterator find(Key const& k) const
+        {
+            return iterator_at(find_node(k));
+        }
+
+        // 'hash_value' is the result of calling the hash function, before
+        // the policy mixes it.
+        template <class Key>
+        iterator find_with_hash(std::size_t hash_value, Key const& k) const
+        {
+            return iterator_at(find_node_impl(
+                policy::mix_hash(hash_value), k, this->key_eq()));
+        }
+
+        template <class Key, class Hash, class Pred>
+        iterator generic_find(Key const& k, Hash const& hf,
+                Pred const& eq) const
+        {
+            return iterator_at(find_node_impl(
+                policy::apply_hash(hf, k), k, eq));
+        }
+
+        template <class Key>
+        std::size_t count(Key const& k) const
+        {
+            return find_node(k) != capacity_ ? 1 : 0;
+        }
+
+        template <class Key>
+        std::pair<iterator, iterator> equal_range(Key const& k) const
+        {
+            std::size_t index = find_node(k);
+            iterator first = iterator_at(index), last = first;
+            if (index != capacity_) ++last;
+            return std::make_pair(first, last);
+        }
+
+        value_type& at(key_type const& k) const
+        {
+            std::size_t index = find_node(k);
+            if (index == capacity_) {
+                boost::throw_exception(
+                    std::out_of_range(
+                        "Unable to find key in unordered_flat_map."));
+            }
+            return slots_[index];
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Insert
+
+        // Construct a new element for a key which isn't in the table.
+        template <BOOST_UNORDERED_EMPLACE_TEMPLATE>
+        std::size_t add_node(std::size_t key_hash,
+            BOOST_UNORDERED_EMPLACE_ARGS)
+        {
+            if (!growth_left_) {
+                // The arguments might refer to an element in the table, which
+                // the rehash would move, so construct the new element first.
+                value_holder v(alloc_);
+                v.construct(BOOST_UNORDERED_EMPLACE_FORWARD);
+
+                // rehash has strong exception safety when the elements are
+                // copied, basic when they're moved.
+                reserve_for_insert();
+
+                return construct_node(key_hash,
+                    BOOST_UNORDERED_EMPLACE_ARGS1(boost::move(v.value())));
+            }
+
+            return construct_node(key_hash, BOOST_UNORDERED_EMPLACE_FORWARD);
+        }
+
+        // Construct a new element in a free slot. There must be one left.
+        template <BOOST_UNORDERED_EMPLACE_TEMPLATE>
+        std::size_t construct_node(std::size_t key_hash,
+            BOOST_UNORDERED_EMPLACE_ARGS)
+        {
+            BOOST_ASSERT(growth_left_);
+
+            std::size_t index = flat_find_available(
+                ctrl_, group_mask(), key_hash);
+
+            // If this throws, nothing has changed.
+            boost::unordered::detail::func::construct_value_impl(
+                alloc_, slots_ + index, BOOST_UNORDERED_EMPLACE_FORWARD);
+
+            if (ctrl_[index] == flat_empty) --growth_left_;
+            ctrl_[index] = flat_h2(key_hash);
+            ++size_;
+            return index;
+        }
+
+        value_type& operator[](key_type const& k)
+        {
+            std::size_t key_hash = hash(k);
+            std::size_t index = find_node_impl(key_hash, k, this->key_eq());
+
+            if (index == capacity_) {
+                index = add_node(key_hash, BOOST_UNORDERED_EMPLACE_ARGS3(
+                    boost::unordered::piecewise_construct,
+                    boost::make_tuple(k),
+                    boost::make_tuple()));
+            }
+
+            return slots_[index];
+        }
+
+#if defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+#   if defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+        emplace_return emplace(boost::unordered::detail::emplace_args1<
+                boost::unordered::detail::please_ignore_this_overload> const&)
+        {
+            BOOST_ASSERT(false);
+            return emplace_return(this->begin(), false);
+        }
+#   else
+        emplace_return emplace(
+                boost::unordered::detail::please_ignore_this_overload const&)
+        {
+            BOOST_ASSERT(false);
+            return emplace_return(this->begin(), false);
+        }
+#   endif
+#endif
+
+        template <BOOST_UNORDERED_EMPLACE_TEMPLATE>
+        emplace_return emplace(BOOST_UNORDERED_EMPLACE_ARGS)
+        {
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+            return emplace_impl(
+                extractor::extract(BOOST_UNORDERED_EMPLACE_FORWARD),
+                BOOST_UNORDERED_EMPLACE_FORWARD);
+#else
+            return emplace_impl(
+                extractor::extract(args.a0, args.a1),
+                BOOST_UNORDERED_EMPLACE_FORWARD);
+#endif
+        }
+
+#if defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+        template <typename A0>
+        emplace_return emplace(
+                boost::unordered::detail::emplace_args1<A0> const& args)
+        {
+            return emplace_impl(extractor::extract(args.a0), args);
+        }
+#endif
+
+        template <BOOST_UNORDERED_EMPLACE_TEMPLATE>
+        emplace_return emplace_impl(key_type const& k,
+            BOOST_UNORDERED_EMPLACE_ARGS)
+        {
+            std::size_t key_hash = hash(k);
+            std::size_t index = find_node_impl(key_hash, k, this->key_eq());
+
+            if (index != capacity_)
+                return emplace_return(iterator_at(index), false);
+
+            return emplace_return(iterator_at(
+                add_node(key_hash, BOOST_UNORDERED_EMPLACE_FORWARD)), true);
+        }
+
+        template <BOOST_UNORDERED_EMPLACE_TEMPLATE>
+        emplace_return emplace_impl(no_key, BOOST_UNORDERED_EMPLACE_ARGS)
+        {
+            // Don't have a key, so construct the value first in order
+            // to be able to lookup the position.
+            value_holder v(alloc_);
+            v.construct(BOOST_UNORDERED_EMPLACE_FORWARD);
+
+            key_type const& k = get_key(v.value());
+            std::size_t key_hash = hash(k);
+            std::size_t index = find_node_impl(key_hash, k, this->key_eq());
+
+            if (index != capacity_)
+                return emplace_return(iterator_at(index), false);
+
+            return emplace_return(iterator_at(
+                add_node(key_hash, BOOST_UNORDERED_EMPLACE_ARGS1(
+                    boost::move(v.value())))), true);
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Insert range methods
+        //
+        // if hash function throws, or inserting > 1 element, basic exception
+        // safety strong otherwise
+
+        template <class InputIt>
+        void insert_range(InputIt i, InputIt j)
+        {
+            if (i == j) return;
+
+            if (growth_left_ < boost::unordered::detail::insert_size(i, j))
+                reserve(size_ + boost::unordered::detail::insert_size(i, j));
+
+            for (; i != j; ++i) {
+                emplace_impl(extractor::extract(*i),
+                    BOOST_UNORDERED_EMPLACE_ARGS1(*i));
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Erase
+        //
+        // no throw
+
+        void erase_index(std::size_t index)
+        {
+            BOOST_ASSERT(ctrl_[index] >= 0);
+
+            boost::unordered::detail::func::destroy_value_impl(
+                alloc_, slots_ + index);
+
+            // A probe sequence only passes a group without empty slots, so if
+            // there's still one, this slot can be made empty.
+            if (flat_group(ctrl_ + (index & ~std::size_t(flat_group::width - 1)))
+                    .match_empty()) {
+                ctrl_[index] = flat_empty;
+                ++growth_left_;
+            }
+            else {
+                ctrl_[index] = flat_deleted;
+            }
+
+            --size_;
+        }
+
+        iterator erase(c_iterator pos)
+        {
+            BOOST_ASSERT(pos != c_iterator(end()));
+            std::size_t index = index_of(pos);
+            iterator next = iterator_at(index);
+            ++next;
+            erase_index(index);
+            return next;
+        }
+
+        iterator erase_range(c_iterator first, c_iterator last)
+        {
+            for (std::size_t i = index_of(first), j = index_of(last);
+                    i < j; ++i) {
+                if (ctrl_[i] >= 0) erase_index(i);
+            }
+
+            return iterator_at(index_of(last));
+        }
+
+        std::size_t erase_key(key_type const& k)
+        {
+            if (!size_) return 0;
+            std::size_t index = find_node(k);
+            if (index == capacity_) return 0;
+            erase_index(index);
+            return 1;
+        }
+
+        void clear()
+        {
+            if (!size_) return;
+
+            if (!boost::has_trivial_destructor<value_type>::value) {
+                for (std::size_t i = 0; i < capacity_; ++i) {
+                    if (ctrl_[i] >= 0) {
+                        boost::unordered::detail::func::destroy_value_impl(
+                            alloc_, slots_ + i);
+                    }
+                }
+            }
+
+            std::memset(ctrl_, flat_empty, capacity_);
+            size_ = 0;
+            growth_left_ = max_load(capacity_);
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Equality
+
+        bool equals(flat_table const& other) const
+        {
+            if (size_ != other.size_) return false;
+
+            for (iterator it = begin(), e = end(); it != e; ++it) {
+                std::size_t index = other.find_node(get_key(*it));
+                if (index == other.capacity_ ||
+                        !(*it == other.slots_[index]))
+                    return false;
+            }
+
+            return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Swap and Move
+
+        void swap_allocators(flat_table& other, false_type)
+        {
+            boost::unordered::detail::func::ignore_unused_variable_warning(other);
+
+            // According to 23.2.1.8, if propagate_on_container_swap is
+            // false the behaviour is undefined unless the allocators
+            // are equal.
+            BOOST_ASSERT(alloc_ == other.alloc_);
+        }
+
+        void swap_allocators(flat_table& other, true_type)
+        {
+            boost::swap(alloc_, other.alloc_);
+        }
+
+        // Only swaps the allocators if propagate_on_container_swap
+        void swap(flat_table& x)
+        {
+            set_hash_functions op1(*this, x);
+            set_hash_functions op2(x, *this);
+
+            swap_allocators(x,
+                boost::unordered::detail::integral_constant<bool,
+                    value_allocator_traits::
+                    propagate_on_container_swap::value>());
+
+            boost::swap(ctrl_, x.ctrl_);
+            boost::swap(slots_, x.slots_);
+            boost::swap(capacity_, x.capacity_);
+            boost::swap(size_, x.size_);
+            boost::swap(growth_left_, x.growth_left_);
+            op1.commit();
+            op2.commit();
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Assignment
+
+        void assign(flat_table const& x)
+        {
+            if (this != boost::addressof(x))
+            {
+                assign(x,
+                    boost::unordered::detail::integral_constant<bool,
+                        value_allocator_traits::
+                        propagate_on_container_copy_assignment::value>());
+            }
+        }
+
+        void assign(flat_table const& x, false_type)
+        {
+            set_hash_functions new_func_this(*this, x);
+            new_func_this.commit();
+            clear();
+            copy_elements(x);
+        }
+
+        void assign(flat_table const& x, true_type)
+        {
+            set_hash_functions new_func_this(*this, x);
+
+            // Delete everything with the current allocator before assigning
+            // the new one.
+            delete_arrays();
+            reset();
+            alloc_ = x.alloc_;
+
+            new_func_this.commit();
+            copy_elements(x);
+        }
+
+        void move_assign(flat_table& x)
+        {
+            if (this != boost::addressof(x))
+            {
+                move_assign(x,
+                    boost::unordered::detail::integral_constant<bool,
+                        value_allocator_traits::
+                        propagate_on_container_move_assignment::value>());
+            }
+        }
+
+        void move_assign(flat_table& x, true_type)
+        {
+            set_hash_functions new_func_this(*this, x);
+            delete_arrays();
+            reset();
+            alloc_ = boost::move(x.alloc_);
+            move_arrays_from(x);
+            new_func_this.commit();
+        }
+
+        void move_assign(flat_table& x, false_type)
+        {
+            if (alloc_ == x.alloc_) {
+                set_hash_functions new_func_this(*this, x);
+                delete_arrays();
+                reset();
+                move_arrays_from(x);
+                new_func_this.commit();
+            }
+            else {
+                set_hash_functions new_func_this(*this, x);
+                new_func_this.commit();
+                clear();
+
+                if (x.size_) {
+                    reserve(x.size_);
+                    for (std::size_t i = 0; i < x.capacity_; ++i) {
+                        if (x.ctrl_[i] >= 0) {
+                            add_node(hash(get_key(x.slots_[i])),
+                                BOOST_UNORDERED_EMPLACE_ARGS1(
+                                    boost::move(x.slots_[i])));
+                        }
+                    }
+                }
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////
+        // Array management
+
+        // Copy the elements of 'x' into this table, which must be empty.
+        void copy_elements(flat_table const& x)
+        {
+            BOOST_ASSERT(!size_);
+            if (!x.size_) return;
+
+            if (capacity_for(x.size_) > capacity_) {
+                array_constructor a(alloc_, capacity_for(x.size_));
+
+                for (std::size_t i = 0; i < x.capacity_; ++i) {
+                    if (x.ctrl_[i] >= 0) {
+                        a.construct(hash(get_key(x.slots_[i])),
+                            BOOST_UNORDERED_EMPLACE_ARGS1(x.slots_[i]));
+                    }
+                }
+
+                delete_arrays();
+                take_arrays(a, x.size_);
+            }
+            else {
+                for (std::size_t i = 0; i < x.capacity_; ++i) {
+                    if (x.ctrl_[i] >= 0) {
+                        add_node(hash(get_key(x.slots_[i])),
+                            BOOST_UNORDERED_EMPLACE_ARGS1(x.slots_[i]));
+                    }
+                }
+            }
+        }
+
+        void take_arrays(array_constructor& a, std::size_t size)
+        {
+            ctrl_ = a.ctrl_;
+            slots_ = a.slots_;
+            capacity_ = a.capacity_;
+            size_ = size;
+            growth_left_ = max_load(capacity_) - size;
+            a.release();
+        }
+
+        void move_arrays_from(flat_table& x)
+        {
+            BOOST_ASSERT(alloc_ == x.alloc_);
+            BOOST_ASSERT(!capacity_);
+            ctrl_ = x.ctrl_;
+            slots_ = x.slots_;
+            capacity_ = x.capacity_;
+            size_ = x.size_;
+            growth_left_ = x.growth_left_;
+            x.reset();
+        }
+
+        void delete_arrays()
+        {
+            if (capacity_) {
+                array_constructor::destroy(alloc_, capacity_, ctrl_, slots_);
+            }
+        }
+
+        // Forget the arrays, without freeing them.
+        void reset()
+        {
+            ctrl_ = empty_ctrl();
+            slots_ = 0;
+            capacity_ = 0;
+            size_ = 0;
+            growth_left_ = 0;
+        }
+    };
+}}}
+
+#endif
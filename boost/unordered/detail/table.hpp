@@ -62,6 +62,10 @@ namespace boost { namespace unordered { namespace detail {
             return *(ValueType*) this;
         }
 
+        value_type const& value() const {
+            return *(ValueType const*) this;
+        }
+
         value_type* value_ptr() {
             return (ValueType*) this;
         }
@@ -770,18 +774,34 @@ namespace boost { namespace unordered { namespace detail {
                 find_node_impl(policy::apply_hash(hf, k), k, eq);
         }
 
+        template <typename Key>
         iterator find_node(
                 std::size_t key_hash,
-                key_type const& k) const
+                Key const& k) const
         {
             return static_cast<table_impl const*>(this)->
                 find_node_impl(key_hash, k, this->key_eq());
         }
 
-        iterator find_node(key_type const& k) const
+        // 'Key' is either key_type, or a type that the transparent hash
+        // function and equality predicate accept.
+        template <typename Key>
+        iterator find_node(Key const& k) const
         {
             return static_cast<table_impl const*>(this)->
-                find_node_impl(hash(k), k, this->key_eq());
+                find_node_impl(policy::apply_hash(this->hash_function(), k),
+                    k, this->key_eq());
+        }
+
+        // 'hash_value' is the result of calling the hash function, before
+        // the policy mixes it, so that it can be calculated once and used
+        // for several containers.
+        template <typename Key>
+        iterator find_node_with_hash(
+                std::size_t hash_value,
+                Key const& k) const
+        {
+            return find_node(policy::mix_hash(hash_value), k);
         }
 
         iterator find_matching_node(iterator n) const
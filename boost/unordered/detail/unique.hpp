@@ -255,7 +255,8 @@ namespace boost { namespace unordered { namespace detail {
             }
         }
 
-        std::size_t count(key_type const& k) const
+        template <class Key>
+        std::size_t count(Key const& k) const
         {
             return this->find_node(k).node_ ? 1 : 0;
         }
@@ -271,8 +272,9 @@ namespace boost { namespace unordered { namespace detail {
                 std::out_of_range("Unable to find key in unordered_map."));
         }
 
+        template <class Key>
         std::pair<iterator, iterator>
-            equal_range(key_type const& k) const
+            equal_range(Key const& k) const
         {
             iterator n = this->find_node(k);
             iterator n2 = n;
@@ -303,7 +305,13 @@ namespace boost { namespace unordered { namespace detail {
                 node_constructor& a,
                 std::size_t key_hash)
         {
-            node_pointer n = a.release();
+            return add_node(a.release(), key_hash);
+        }
+
+        inline iterator add_node(
+                node_pointer n,
+                std::size_t key_hash)
+        {
             n->hash_ = key_hash;
     
             bucket_pointer b = this->get_bucket(this->hash_to_bucket(key_hash));
@@ -495,10 +503,67 @@ namespace boost { namespace unordered { namespace detail {
 
             do {
                 a.construct_with_value2(*i);
+
+                // As in insert_range_impl2, when the buckets have to grow,
+                // create enough for the rest of the range rather than
+                // growing them one element at a time.
+                if(this->size_ + 1 > this->max_load_)
+                    this->reserve_for_insert(this->size_ +
+                        boost::unordered::detail::insert_size(i, j));
+
                 emplace_impl_with_node(a);
             } while(++i != j);
         }
 
+        ////////////////////////////////////////////////////////////////////////
+        // Node handles
+
+        // Insert a node which isn't in a container. If there's already an
+        // element with an equivalent key, it's left alone and the caller
+        // keeps ownership.
+        //
+        // Strong exception safety.
+        emplace_return insert_node(node_pointer n)
+        {
+            key_type const& k = this->get_key(n->value());
+            std::size_t key_hash = this->hash(k);
+            iterator pos = this->find_node(key_hash, k);
+
+            if (pos.node_) return emplace_return(pos, false);
+
+            this->reserve_for_insert(this->size_ + 1);
+            return emplace_return(this->add_node(n, key_hash), true);
+        }
+
+        // Unlink a node without destroying it, the caller takes ownership.
+        //
+        // no throw
+        node_pointer extract_by_iterator(c_iterator r)
+        {
+            BOOST_ASSERT(r.node_);
+            node_pointer n = r.node_;
+            std::size_t bucket_index = this->hash_to_bucket(n->hash_);
+
+            link_pointer prev = this->get_previous_start(bucket_index);
+            while(prev->next_ != n) prev = prev->next_;
+
+            prev->next_ = n->next_;
+            --this->size_;
+            this->fix_bucket(bucket_index, prev);
+
+            n->next_ = link_pointer();
+            return n;
+        }
+
+        node_pointer extract_by_key(key_type const& k)
+        {
+            if(!this->size_) return node_pointer();
+
+            iterator it = this->find_node(k);
+            return it.node_ ?
+                extract_by_iterator(c_iterator(it)) : node_pointer();
+        }
+
         ////////////////////////////////////////////////////////////////////////
         // Erase
         //
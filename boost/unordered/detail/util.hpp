@@ -16,6 +16,7 @@
 #include <boost/iterator/iterator_categories.hpp>
 #include <boost/utility/enable_if.hpp>
 #include <boost/detail/select_type.hpp>
+#include <boost/mpl/has_xxx.hpp>
 #include <boost/move/move.hpp>
 #include <boost/preprocessor/seq/size.hpp>
 #include <boost/preprocessor/seq/enum.hpp>
@@ -57,6 +58,33 @@ namespace boost { namespace unordered { namespace detail {
             ReturnType>
     {};
 
+    ////////////////////////////////////////////////////////////////////////////
+    // transparent lookup SFINAE
+    //
+    // Lookup with a key of a different type is only enabled when both the
+    // hash function and the equality predicate declare 'is_transparent', so
+    // that code that relies on the implicit conversion to key_type keeps
+    // working.
+
+    BOOST_MPL_HAS_XXX_TRAIT_NAMED_DEF(has_is_transparent, is_transparent, false)
+
+    template <typename H, typename P>
+    struct is_transparent
+    {
+        BOOST_STATIC_CONSTANT(bool, value =
+            boost::unordered::detail::has_is_transparent<H>::value &&
+            boost::unordered::detail::has_is_transparent<P>::value);
+    };
+
+    // 'Key' isn't used, but the member function templates need a condition
+    // that depends on their template parameter.
+    template <typename H, typename P, typename Key, typename ReturnType>
+    struct enable_if_transparent :
+        boost::enable_if_c<
+            boost::unordered::detail::is_transparent<H, P>::value,
+            ReturnType>
+    {};
+
     ////////////////////////////////////////////////////////////////////////////
     // primes
 
@@ -19,6 +19,7 @@
 #include <boost/unordered/detail/util.hpp>
 #include <boost/functional/hash.hpp>
 #include <boost/move/move.hpp>
+#include <boost/utility/explicit_operator_bool.hpp>
 
 #if !defined(BOOST_NO_CXX11_HDR_INITIALIZER_LIST)
 #include <initializer_list>
@@ -37,6 +38,199 @@ namespace boost
 {
 namespace unordered
 {
+    ////////////////////////////////////////////////////////////////////////////
+    // Node handles
+    //
+    // Own a node that has been extracted from a container, so that it can be
+    // inserted into another container with an equal allocator without
+    // copying or reallocating the element.
+
+    template <class N, class K, class T, class A>
+    class node_handle_map
+    {
+        BOOST_MOVABLE_BUT_NOT_COPYABLE(node_handle_map)
+
+        template <class K2, class T2, class H2, class P2, class A2>
+        friend class boost::unordered::unordered_map;
+        template <class K2, class T2, class H2, class P2, class A2>
+        friend class boost::unordered::unordered_multimap;
+
+        typedef typename boost::unordered::detail::rebind_wrap<A,
+            std::pair<K const, T> >::type value_allocator;
+        typedef typename boost::unordered::detail::rebind_wrap<A, N>::type
+            node_allocator;
+        typedef boost::unordered::detail::allocator_traits<node_allocator>
+            node_allocator_traits;
+        typedef typename node_allocator_traits::pointer node_pointer;
+
+    public:
+
+        typedef K key_type;
+        typedef T mapped_type;
+        typedef value_allocator allocator_type;
+
+    private:
+
+        // The allocator is only constructed while there is a node.
+        node_pointer ptr_;
+        boost::unordered::detail::value_base<node_allocator> alloc_;
+
+        node_handle_map(node_pointer ptr, node_allocator const& a)
+            : ptr_(ptr)
+        {
+            if (ptr_) new (alloc_.address()) node_allocator(a);
+        }
+
+    public:
+
+        node_handle_map() BOOST_NOEXCEPT : ptr_() {}
+
+        ~node_handle_map()
+        {
+            reset();
+        }
+
+        node_handle_map(BOOST_RV_REF(node_handle_map) n) BOOST_NOEXCEPT
+            : ptr_()
+        {
+            take(n);
+        }
+
+        node_handle_map& operator=(BOOST_RV_REF(node_handle_map) n)
+        {
+            BOOST_ASSERT(!ptr_ || !n.ptr_ ||
+                node_allocator_traits::
+                    propagate_on_container_move_assignment::value ||
+                alloc_.value() == n.alloc_.value());
+
+            if (this != &n) {
+                reset();
+                take(n);
+            }
+            return *this;
+        }
+
+        key_type& key() const
+        {
+            BOOST_ASSERT(ptr_);
+            return const_cast<key_type&>(ptr_->value().first);
+        }
+
+        mapped_type& mapped() const
+        {
+            BOOST_ASSERT(ptr_);
+            return ptr_->value().second;
+        }
+
+        allocator_type get_allocator() const
+        {
+            BOOST_ASSERT(ptr_);
+            return allocator_type(alloc_.value());
+        }
+
+        BOOST_EXPLICIT_OPERATOR_BOOL()
+
+        bool operator!() const BOOST_NOEXCEPT
+        {
+            return ptr_ ? false : true;
+        }
+
+        bool empty() const BOOST_NOEXCEPT
+        {
+            return ptr_ ? false : true;
+        }
+
+        void swap(node_handle_map& n)
+        {
+            BOOST_ASSERT(!ptr_ || !n.ptr_ ||
+                node_allocator_traits::propagate_on_container_swap::value ||
+                alloc_.value() == n.alloc_.value());
+
+            if (ptr_ && n.ptr_) {
+                if (node_allocator_traits::propagate_on_container_swap::value)
+                    boost::swap(alloc_.value(), n.alloc_.value());
+                boost::swap(ptr_, n.ptr_);
+            }
+            else if (ptr_) {
+                n.take(*this);
+            }
+            else if (n.ptr_) {
+                take(n);
+            }
+        }
+
+    private:
+
+        // pre: this is empty
+        void take(node_handle_map& n)
+        {
+            BOOST_ASSERT(!ptr_);
+            if (n.ptr_) {
+                new (alloc_.address()) node_allocator(
+                    boost::move(n.alloc_.value()));
+                ptr_ = n.ptr_;
+                n.release();
+            }
+        }
+
+        // Give up the node without destroying it, once it's in a container.
+        void release()
+        {
+            BOOST_ASSERT(ptr_);
+            ptr_ = node_pointer();
+            boost::unordered::detail::func::destroy(alloc_.value_ptr());
+        }
+
+        void reset()
+        {
+            if (ptr_) {
+                boost::unordered::detail::func::destroy_value_impl(
+                    alloc_.value(), ptr_->value_ptr());
+                node_allocator_traits::destroy(alloc_.value(),
+                    boost::addressof(*ptr_));
+                node_allocator_traits::deallocate(alloc_.value(), ptr_, 1);
+                release();
+            }
+        }
+    };
+
+    template <class N, class K, class T, class A>
+    inline void swap(node_handle_map<N, K, T, A>& x,
+            node_handle_map<N, K, T, A>& y)
+    {
+        x.swap(y);
+    }
+
+    template <class N, class K, class T, class A>
+    struct insert_return_type_map
+    {
+    private:
+        BOOST_MOVABLE_BUT_NOT_COPYABLE(insert_return_type_map)
+
+    public:
+        boost::unordered::iterator_detail::iterator<N> position;
+        bool inserted;
+        boost::unordered::node_handle_map<N, K, T, A> node;
+
+        insert_return_type_map() : position(), inserted(false), node() {}
+
+        insert_return_type_map(BOOST_RV_REF(insert_return_type_map) x)
+            BOOST_NOEXCEPT
+            : position(x.position),
+              inserted(x.inserted),
+              node(boost::move(x.node))
+        {}
+
+        insert_return_type_map& operator=(
+                BOOST_RV_REF(insert_return_type_map) x)
+        {
+            position = x.position;
+            inserted = x.inserted;
+            node = boost::move(x.node);
+            return *this;
+        }
+    };
+
     template <class K, class T, class H, class P, class A>
     class unordered_map
     {
@@ -75,6 +269,11 @@ namespace unordered
         typedef typename table::c_iterator const_iterator;
         typedef typename table::iterator iterator;
 
+        typedef boost::unordered::node_handle_map<
+            typename types::node, K, T, A> node_type;
+        typedef boost::unordered::insert_return_type_map<
+            typename types::node, K, T, A> insert_return_type;
+
     private:
 
         table table_;
@@ -405,6 +604,11 @@ namespace unordered
         void insert(std::initializer_list<value_type>);
 #endif
 
+        node_type extract(const_iterator);
+        node_type extract(const key_type&);
+        insert_return_type insert(BOOST_RV_REF(node_type));
+        iterator insert(const_iterator, BOOST_RV_REF(node_type));
+
         iterator erase(const_iterator);
         size_type erase(const key_type&);
         iterator erase(const_iterator, const_iterator);
@@ -449,6 +653,50 @@ namespace unordered
         std::pair<const_iterator, const_iterator>
         equal_range(const key_type&) const;
 
+        // Lookup with a hash value calculated by the caller, it must be
+        // the result of calling hash_function() with the key.
+
+        iterator find(const key_type&, std::size_t);
+        const_iterator find(const key_type&, std::size_t) const;
+
+        // Transparent lookup, only available when both the hash function
+        // and the equality predicate have an 'is_transparent' member type.
+
+        template <class Key>
+        typename boost::unordered::detail::enable_if_transparent<
+            H, P, Key, iterator>::type
+        find(Key const&);
+
+        template <class Key>
+        typename boost::unordered::detail::enable_if_transparent<
+            H, P, Key, const_iterator>::type
+        find(Key const&) const;
+
+        template <class Key>
+        typename boost::unordered::detail::enable_if_transparent<
+            H, P, Key, iterator>::type
+        find(Key const&, std::size_t);
+
+        template <class Key>
+        typename boost::unordered::detail::enable_if_transparent<
+            H, P, Key, const_iterator>::type
+        find(Key const&, std::size_t) const;
+
+        template <class Key>
+        typename boost::unordered::detail::enable_if_transparent<
+            H, P, Key, size_type>::type
+        count(Key const&) const;
+
+        template <class Key>
+        typename boost::unordered::detail::enable_if_transparent<
+            H, P, Key, std::pair<iterator, iterator> >::type
+        equal_range(Key const&);
+
+        template <class Key>
+        typename boost::unordered::detail::enable_if_transparent<
+            H, P, Key, std::pair<const_iterator, const_iterator> >::type
+        equal_range(Key const&) const;
+
         // bucket interface
 
         size_type bucket_count() const BOOST_NOEXCEPT
@@ -558,6 +806,9 @@ namespace unordered
         typedef typename table::c_iterator const_iterator;
         typedef typename table::iterator iterator;
 
+        typedef boost::unordered::node_handle_map<
+            typename types::node, K, T, A> node_type;
+
     private:
 
         table table_;
@@ -889,6 +1140,11 @@ namespace unordered
         void insert(std::initializer_list<value_type>);
 #endif
 
+        node_type extract(const_iterator);
+        node_type extract(const key_type&);
+        iterator insert(BOOST_RV_REF(node_type));
+        iterator insert(const_iterator, BOOST_RV_REF(node_type));
+
         iterator erase(const_iterator);
         size_type erase(const key_type&);
         iterator erase(const_iterator, const_iterator);
@@ -929,6 +1185,50 @@ namespace unordered
         std::pair<const_iterator, const_iterator>
         equal_range(const key_type&) const;
 
+        // Lookup with a hash value calculated by the caller, it must be
+        // the result of calling hash_function() with the key.
+
+        iterator find(const key_type&, std::size_t);
+        const_iterator find(const key_type&, std::size_t) const;
+
+        // Transparent lookup, only available when both the hash function
+        // and the equality predicate have an 'is_transparent' member type.
+
+        template <class Key>
+        typename boost::unordered::detail::enable_if_transparent<
+            H, P, Key, iterator>::type
+        find(Key const&);
+
+        template <class Key>
+        typename boost::unordered::detail::enable_if_transparent<
+            H, P, Key, const_iterator>::type
+        find(Key const&) const;
+
+        template <class Key>
+        typename boost::unordered::detail::enable_if_transparent<
+            H, P, Key, iterator>::type
+        find(Key const&, std::size_t);
+
+        template <class Key>
+        typename boost::unordered::detail::enable_if_transparent<
+            H, P, Key, const_iterator>::type
+        find(Key const&, std::size_t) const;
+
+        template <class Key>
+        typename boost::unordered::detail::enable_if_transparent<
+            H, P, Key, size_type>::type
+        count(Key const&) const;
+
+        template <class Key>
+        typename boost::unordered::detail::enable_if_transparent<
+            H, P, Key, std::pair<iterator, iterator> >::type
+        equal_range(Key const&);
+
+        template <class Key>
+        typename boost::unordered::detail::enable_if_transparent<
+            H, P, Key, std::pair<const_iterator, const_iterator> >::type
+        equal_range(Key const&) const;
+
         // bucket interface
 
         size_type bucket_count() const BOOST_NOEXCEPT
@@ -1132,6 +1432,54 @@ namespace unordered
     }
 #endif
 
+    template <class K, class T, class H, class P, class A>
+    typename unordered_map<K,T,H,P,A>::node_type
+        unordered_map<K,T,H,P,A>::extract(const_iterator position)
+    {
+        return node_type(table_.extract_by_iterator(position),
+            table_.node_alloc());
+    }
+
+    template <class K, class T, class H, class P, class A>
+    typename unordered_map<K,T,H,P,A>::node_type
+        unordered_map<K,T,H,P,A>::extract(const key_type& k)
+    {
+        return node_type(table_.extract_by_key(k), table_.node_alloc());
+    }
+
+    template <class K, class T, class H, class P, class A>
+    typename unordered_map<K,T,H,P,A>::insert_return_type
+        unordered_map<K,T,H,P,A>::insert(BOOST_RV_REF(node_type) np)
+    {
+        node_type& n = np;
+        insert_return_type result;
+
+        if (!n.empty()) {
+            BOOST_ASSERT(table_.node_alloc() == n.alloc_.value());
+            std::pair<iterator, bool> r = table_.insert_node(n.ptr_);
+            result.position = r.first;
+            result.inserted = r.second;
+            if (r.second) n.release();
+            else result.node = boost::move(n);
+        }
+
+        return boost::move(result);
+    }
+
+    template <class K, class T, class H, class P, class A>
+    typename unordered_map<K,T,H,P,A>::iterator
+        unordered_map<K,T,H,P,A>::insert(
+            const_iterator, BOOST_RV_REF(node_type) np)
+    {
+        node_type& n = np;
+        if (n.empty()) return end();
+
+        BOOST_ASSERT(table_.node_alloc() == n.alloc_.value());
+        std::pair<iterator, bool> r = table_.insert_node(n.ptr_);
+        if (r.second) n.release();
+        return r.first;
+    }
+
     template <class K, class T, class H, class P, class A>
     typename unordered_map<K,T,H,P,A>::iterator
         unordered_map<K,T,H,P,A>::erase(const_iterator position)
@@ -1268,6 +1616,91 @@ namespace unordered
         return table_.equal_range(k);
     }
 
+    template <class K, class T, class H, class P, class A>
+    typename unordered_map<K,T,H,P,A>::iterator
+        unordered_map<K,T,H,P,A>::find(
+            const key_type& k, std::size_t hash)
+    {
+        return table_.find_node_with_hash(hash, k);
+    }
+
+    template <class K, class T, class H, class P, class A>
+    typename unordered_map<K,T,H,P,A>::const_iterator
+        unordered_map<K,T,H,P,A>::find(
+            const key_type& k, std::size_t hash) const
+    {
+        return table_.find_node_with_hash(hash, k);
+    }
+
+    template <class K, class T, class H, class P, class A>
+    template <class Key>
+    typename boost::unordered::detail::enable_if_transparent<H, P, Key,
+        typename unordered_map<K,T,H,P,A>::iterator>::type
+        unordered_map<K,T,H,P,A>::find(Key const& k)
+    {
+        return table_.find_node(k);
+    }
+
+    template <class K, class T, class H, class P, class A>
+    template <class Key>
+    typename boost::unordered::detail::enable_if_transparent<H, P, Key,
+        typename unordered_map<K,T,H,P,A>::const_iterator>::type
+        unordered_map<K,T,H,P,A>::find(Key const& k) const
+    {
+        return table_.find_node(k);
+    }
+
+    template <class K, class T, class H, class P, class A>
+    template <class Key>
+    typename boost::unordered::detail::enable_if_transparent<H, P, Key,
+        typename unordered_map<K,T,H,P,A>::iterator>::type
+        unordered_map<K,T,H,P,A>::find(
+            Key const& k, std::size_t hash)
+    {
+        return table_.find_node_with_hash(hash, k);
+    }
+
+    template <class K, class T, class H, class P, class A>
+    template <class Key>
+    typename boost::unordered::detail::enable_if_transparent<H, P, Key,
+        typename unordered_map<K,T,H,P,A>::const_iterator>::type
+        unordered_map<K,T,H,P,A>::find(
+            Key const& k, std::size_t hash) const
+    {
+        return table_.find_node_with_hash(hash, k);
+    }
+
+    template <class K, class T, class H, class P, class A>
+    template <class Key>
+    typename boost::unordered::detail::enable_if_transparent<H, P, Key,
+        typename unordered_map<K,T,H,P,A>::size_type>::type
+        unordered_map<K,T,H,P,A>::count(Key const& k) const
+    {
+        return table_.count(k);
+    }
+
+    template <class K, class T, class H, class P, class A>
+    template <class Key>
+    typename boost::unordered::detail::enable_if_transparent<H, P, Key,
+        std::pair<
+            typename unordered_map<K,T,H,P,A>::iterator,
+            typename unordered_map<K,T,H,P,A>::iterator> >::type
+        unordered_map<K,T,H,P,A>::equal_range(Key const& k)
+    {
+        return table_.equal_range(k);
+    }
+
+    template <class K, class T, class H, class P, class A>
+    template <class Key>
+    typename boost::unordered::detail::enable_if_transparent<H, P, Key,
+        std::pair<
+            typename unordered_map<K,T,H,P,A>::const_iterator,
+            typename unordered_map<K,T,H,P,A>::const_iterator> >::type
+        unordered_map<K,T,H,P,A>::equal_range(Key const& k) const
+    {
+        return table_.equal_range(k);
+    }
+
     template <class K, class T, class H, class P, class A>
     typename unordered_map<K,T,H,P,A>::size_type
         unordered_map<K,T,H,P,A>::bucket_size(size_type n) const
@@ -1465,6 +1898,42 @@ namespace unordered
     }
 #endif
 
+    template <class K, class T, class H, class P, class A>
+    typename unordered_multimap<K,T,H,P,A>::node_type
+        unordered_multimap<K,T,H,P,A>::extract(const_iterator position)
+    {
+        return node_type(table_.extract_by_iterator(position),
+            table_.node_alloc());
+    }
+
+    template <class K, class T, class H, class P, class A>
+    typename unordered_multimap<K,T,H,P,A>::node_type
+        unordered_multimap<K,T,H,P,A>::extract(const key_type& k)
+    {
+        return node_type(table_.extract_by_key(k), table_.node_alloc());
+    }
+
+    template <class K, class T, class H, class P, class A>
+    typename unordered_multimap<K,T,H,P,A>::iterator
+        unordered_multimap<K,T,H,P,A>::insert(BOOST_RV_REF(node_type) np)
+    {
+        node_type& n = np;
+        if (n.empty()) return end();
+
+        BOOST_ASSERT(table_.node_alloc() == n.alloc_.value());
+        iterator pos = table_.insert_node(n.ptr_);
+        n.release();
+        return pos;
+    }
+
+    template <class K, class T, class H, class P, class A>
+    typename unordered_multimap<K,T,H,P,A>::iterator
+        unordered_multimap<K,T,H,P,A>::insert(
+            const_iterator, BOOST_RV_REF(node_type) np)
+    {
+        return insert(boost::move(np));
+    }
+
     template <class K, class T, class H, class P, class A>
     typename unordered_multimap<K,T,H,P,A>::iterator
         unordered_multimap<K,T,H,P,A>::erase(const_iterator position)
@@ -1580,6 +2049,91 @@ namespace unordered
         return table_.equal_range(k);
     }
 
+    template <class K, class T, class H, class P, class A>
+    typename unordered_multimap<K,T,H,P,A>::iterator
+        unordered_multimap<K,T,H,P,A>::find(
+            const key_type& k, std::size_t hash)
+    {
+        return table_.find_node_with_hash(hash, k);
+    }
+
+    template <class K, class T, class H, class P, class A>
+    typename unordered_multimap<K,T,H,P,A>::const_iterator
+        unordered_multimap<K,T,H,P,A>::find(
+            const key_type& k, std::size_t hash) const
+    {
+        return table_.find_node_with_hash(hash, k);
+    }
+
+    template <class K, class T, class H, class P, class A>
+    template <class Key>
+    typename boost::unordered::detail::enable_if_transparent<H, P, Key,
+        typename unordered_multimap<K,T,H,P,A>::iterator>::type
+        unordered_multimap<K,T,H,P,A>::find(Key const& k)
+    {
+        return table_.find_node(k);
+    }
+
+    template <class K, class T, class H, class P, class A>
+    template <class Key>
+    typename boost::unordered::detail::enable_if_transparent<H, P, Key,
+        typename unordered_multimap<K,T,H,P,A>::const_iterator>::type
+        unordered_multimap<K,T,H,P,A>::find(Key const& k) const
+    {
+        return table_.find_node(k);
+    }
+
+    template <class K, class T, class H, class P, class A>
+    template <class Key>
+    typename boost::unordered::detail::enable_if_transparent<H, P, Key,
+        typename unordered_multimap<K,T,H,P,A>::iterator>::type
+        unordered_multimap<K,T,H,P,A>::find(
+            Key const& k, std::size_t hash)
+    {
+        return table_.find_node_with_hash(hash, k);
+    }
+
+    template <class K, class T, class H, class P, class A>
+    template <class Key>
+    typename boost::unordered::detail::enable_if_transparent<H, P, Key,
+        typename unordered_multimap<K,T,H,P,A>::const_iterator>::type
+        unordered_multimap<K,T,H,P,A>::find(
+            Key const& k, std::size_t hash) const
+    {
+        return table_.find_node_with_hash(hash, k);
+    }
+
+    template <class K, class T, class H, class P, class A>
+    template <class Key>
+    typename boost::unordered::detail::enable_if_transparent<H, P, Key,
+        typename unordered_multimap<K,T,H,P,A>::size_type>::type
+        unordered_multimap<K,T,H,P,A>::count(Key const& k) const
+    {
+        return table_.count(k);
+    }
+
+    template <class K, class T, class H, class P, class A>
+    template <class Key>
+    typename boost::unordered::detail::enable_if_transparent<H, P, Key,
+        std::pair<
+            typename unordered_multimap<K,T,H,P,A>::iterator,
+            typename unordered_multimap<K,T,H,P,A>::iterator> >::type
+        unordered_multimap<K,T,H,P,A>::equal_range(Key const& k)
+    {
+        return table_.equal_range(k);
+    }
+
+    template <class K, class T, class H, class P, class A>
+    template <class Key>
+    typename boost::unordered::detail::enable_if_transparent<H, P, Key,
+        std::pair<
+            typename unordered_multimap<K,T,H,P,A>::const_iterator,
+            typename unordered_multimap<K,T,H,P,A>::const_iterator> >::type
+        unordered_multimap<K,T,H,P,A>::equal_range(Key const& k) const
+    {
+        return table_.equal_range(k);
+    }
+
     template <class K, class T, class H, class P, class A>
     typename unordered_multimap<K,T,H,P,A>::size_type
         unordered_multimap<K,T,H,P,A>::bucket_size(size_type n) const
@@ -19,6 +19,7 @@
 #include <boost/unordered/detail/util.hpp>
 #include <boost/functional/hash.hpp>
 #include <boost/move/move.hpp>
+#include <boost/utility/explicit_operator_bool.hpp>
 
 #if !defined(BOOST_NO_CXX11_HDR_INITIALIZER_LIST)
 #include <initializer_list>
@@ -37,6 +38,198 @@ namespace boost
 {
 namespace unordered
 {
+    ////////////////////////////////////////////////////////////////////////////
+    // Node handles
+    //
+    // Own a node that has been extracted from a container, so that it can be
+    // inserted into another container with an equal allocator without
+    // copying or reallocating the element.
+
+    template <class N, class T, class A>
+    class node_handle_set
+    {
+        BOOST_MOVABLE_BUT_NOT_COPYABLE(node_handle_set)
+
+        template <class T2, class H2, class P2, class A2>
+        friend class boost::unordered::unordered_set;
+        template <class T2, class H2, class P2, class A2>
+        friend class boost::unordered::unordered_multiset;
+
+        typedef typename boost::unordered::detail::rebind_wrap<A, T>::type
+            value_allocator;
+        typedef typename boost::unordered::detail::rebind_wrap<A, N>::type
+            node_allocator;
+        typedef boost::unordered::detail::allocator_traits<node_allocator>
+            node_allocator_traits;
+        typedef typename node_allocator_traits::pointer node_pointer;
+
+    public:
+
+        typedef T value_type;
+        typedef value_allocator allocator_type;
+
+    private:
+
+        // The allocator is only constructed while there is a node.
+        node_pointer ptr_;
+        boost::unordered::detail::value_base<node_allocator> alloc_;
+
+        node_handle_set(node_pointer ptr, node_allocator const& a)
+            : ptr_(ptr)
+        {
+            if (ptr_) new (alloc_.address()) node_allocator(a);
+        }
+
+    public:
+
+        node_handle_set() BOOST_NOEXCEPT : ptr_() {}
+
+        ~node_handle_set()
+        {
+            reset();
+        }
+
+        node_handle_set(BOOST_RV_REF(node_handle_set) n) BOOST_NOEXCEPT
+            : ptr_()
+        {
+            take(n);
+        }
+
+        node_handle_set& operator=(BOOST_RV_REF(node_handle_set) n)
+        {
+            BOOST_ASSERT(!ptr_ || !n.ptr_ ||
+                node_allocator_traits::
+                    propagate_on_container_move_assignment::value ||
+                alloc_.value() == n.alloc_.value());
+
+            if (this != &n) {
+                reset();
+                take(n);
+            }
+            return *this;
+        }
+
+        value_type& value() const
+        {
+            BOOST_ASSERT(ptr_);
+            return ptr_->value();
+        }
+
+        allocator_type get_allocator() const
+        {
+            BOOST_ASSERT(ptr_);
+            return allocator_type(alloc_.value());
+        }
+
+        BOOST_EXPLICIT_OPERATOR_BOOL()
+
+        bool operator!() const BOOST_NOEXCEPT
+        {
+            return ptr_ ? false : true;
+        }
+
+        bool empty() const BOOST_NOEXCEPT
+        {
+            return ptr_ ? false : true;
+        }
+
+        void swap(node_handle_set& n)
+        {
+            BOOST_ASSERT(!ptr_ || !n.ptr_ ||
+                node_allocator_traits::propagate_on_container_swap::value ||
+                alloc_.value() == n.alloc_.value());
+
+            if (ptr_ && n.ptr_) {
+                if (node_allocator_traits::propagate_on_container_swap::value)
+                    boost::swap(alloc_.value(), n.alloc_.value());
+                boost::swap(ptr_, n.ptr_);
+            }
+            else if (ptr_) {
+                n.take(*this);
+            }
+            else if (n.ptr_) {
+                take(n);
+            }
+        }
+
+    private:
+
+        // pre: this is empty
+        void take(node_handle_set& n)
+        {
+            BOOST_ASSERT(!ptr_);
+            if (n.ptr_) {
+                new (alloc_.address()) node_allocator(
+                    boost::move(n.alloc_.value()));
+                ptr_ = n.ptr_;
+                n.release();
+            }
+        }
+
+        // Give up the node without destroying it, once it's in a container.
+        void release()
+        {
+            BOOST_ASSERT(ptr_);
+            ptr_ = node_pointer();
+            boost::unordered::detail::func::destroy(alloc_.value_ptr());
+        }
+
+        void reset()
+        {
+            if (ptr_) {
+                boost::unordered::detail::func::destroy_value_impl(
+                    alloc_.value(), ptr_->value_ptr());
+                node_allocator_traits::destroy(alloc_.value(),
+                    boost::addressof(*ptr_));
+                node_allocator_traits::deallocate(alloc_.value(), ptr_, 1);
+                release();
+            }
+        }
+    };
+
+    template <class N, class T, class A>
+    inline void swap(node_handle_set<N, T, A>& x,
+            node_handle_set<N, T, A>& y)
+    {
+        x.swap(y);
+    }
+
+    template <class N, class T, class A>
+    struct insert_return_type_set
+    {
+    private:
+        BOOST_MOVABLE_BUT_NOT_COPYABLE(insert_return_type_set)
+
+        typedef typename boost::unordered::detail::rebind_wrap<A, N>::type
+            node_allocator;
+        typedef typename boost::unordered::detail::allocator_traits<
+            node_allocator>::const_pointer const_node_pointer;
+
+    public:
+        boost::unordered::iterator_detail::c_iterator<N, const_node_pointer>
+            position;
+        bool inserted;
+        boost::unordered::node_handle_set<N, T, A> node;
+
+        insert_return_type_set() : position(), inserted(false), node() {}
+
+        insert_return_type_set(BOOST_RV_REF(insert_return_type_set) x)
+            BOOST_NOEXCEPT
+            : position(x.position),
+              inserted(x.inserted),
+              node(boost::move(x.node))
+        {}
+
+        insert_return_type_set& operator=(
+                BOOST_RV_REF(insert_return_type_set) x)
+        {
+            position = x.position;
+            inserted = x.inserted;
+            node = boost::move(x.node);
+            return *this;
+        }
+    };
+
     template <class T, class H, class P, class A>
     class unordered_set
     {
@@ -73,6 +266,11 @@ namespace unordered
         typedef typename table::c_iterator const_iterator;
         typedef typename table::c_iterator iterator;
 
+        typedef boost::unordered::node_handle_set<
+            typename types::node, T, A> node_type;
+        typedef boost::unordered::insert_return_type_set<
+            typename types::node, T, A> insert_return_type;
+
     private:
 
         table table_;
@@ -404,6 +602,11 @@ namespace unordered
         void insert(std::initializer_list<value_type>);
 #endif
 
+        node_type extract(const_iterator);
+        node_type extract(const key_type&);
+        insert_return_type insert(BOOST_RV_REF(node_type));
+        iterator insert(const_iterator, BOOST_RV_REF(node_type));
+
         iterator erase(const_iterator);
         size_type erase(const key_type&);
         iterator erase(const_iterator, const_iterator);
@@ -434,6 +637,34 @@ namespace unordered
         std::pair<const_iterator, const_iterator>
         equal_range(const key_type&) const;
 
+        // Lookup with a hash value calculated by the caller, it must be
+        // the result of calling hash_function() with the key.
+
+        const_iterator find(const key_type&, std::size_t) const;
+
+        // Transparent lookup, only available when both the hash function
+        // and the equality predicate have an 'is_transparent' member type.
+
+        template <class Key>
+        typename boost::unordered::detail::enable_if_transparent<
+            H, P, Key, const_iterator>::type
+        find(Key const&) const;
+
+        template <class Key>
+        typename boost::unordered::detail::enable_if_transparent<
+            H, P, Key, const_iterator>::type
+        find(Key const&, std::size_t) const;
+
+        template <class Key>
+        typename boost::unordered::detail::enable_if_transparent<
+            H, P, Key, size_type>::type
+        count(Key const&) const;
+
+        template <class Key>
+        typename boost::unordered::detail::enable_if_transparent<
+            H, P, Key, std::pair<const_iterator, const_iterator> >::type
+        equal_range(Key const&) const;
+
         // bucket interface
 
         size_type bucket_count() const BOOST_NOEXCEPT
@@ -542,6 +773,9 @@ namespace unordered
         typedef typename table::c_iterator const_iterator;
         typedef typename table::c_iterator iterator;
 
+        typedef boost::unordered::node_handle_set<
+            typename types::node, T, A> node_type;
+
     private:
 
         table table_;
@@ -874,6 +1108,11 @@ namespace unordered
         void insert(std::initializer_list<value_type>);
 #endif
 
+        node_type extract(const_iterator);
+        node_type extract(const key_type&);
+        iterator insert(BOOST_RV_REF(node_type));
+        iterator insert(const_iterator, BOOST_RV_REF(node_type));
+
         iterator erase(const_iterator);
         size_type erase(const key_type&);
         iterator erase(const_iterator, const_iterator);
@@ -904,6 +1143,34 @@ namespace unordered
         std::pair<const_iterator, const_iterator>
         equal_range(const key_type&) const;
 
+        // Lookup with a hash value calculated by the caller, it must be
+        // the result of calling hash_function() with the key.
+
+        const_iterator find(const key_type&, std::size_t) const;
+
+        // Transparent lookup, only available when both the hash function
+        // and the equality predicate have an 'is_transparent' member type.
+
+        template <class Key>
+        typename boost::unordered::detail::enable_if_transparent<
+            H, P, Key, const_iterator>::type
+        find(Key const&) const;
+
+        template <class Key>
+        typename boost::unordered::detail::enable_if_transparent<
+            H, P, Key, const_iterator>::type
+        find(Key const&, std::size_t) const;
+
+        template <class Key>
+        typename boost::unordered::detail::enable_if_transparent<
+            H, P, Key, size_type>::type
+        count(Key const&) const;
+
+        template <class Key>
+        typename boost::unordered::detail::enable_if_transparent<
+            H, P, Key, std::pair<const_iterator, const_iterator> >::type
+        equal_range(Key const&) const;
+
         // bucket interface
 
         size_type bucket_count() const BOOST_NOEXCEPT
@@ -1107,6 +1374,54 @@ namespace unordered
     }
 #endif
 
+    template <class T, class H, class P, class A>
+    typename unordered_set<T,H,P,A>::node_type
+        unordered_set<T,H,P,A>::extract(const_iterator position)
+    {
+        return node_type(table_.extract_by_iterator(position),
+            table_.node_alloc());
+    }
+
+    template <class T, class H, class P, class A>
+    typename unordered_set<T,H,P,A>::node_type
+        unordered_set<T,H,P,A>::extract(const key_type& k)
+    {
+        return node_type(table_.extract_by_key(k), table_.node_alloc());
+    }
+
+    template <class T, class H, class P, class A>
+    typename unordered_set<T,H,P,A>::insert_return_type
+        unordered_set<T,H,P,A>::insert(BOOST_RV_REF(node_type) np)
+    {
+        node_type& n = np;
+        insert_return_type result;
+
+        if (!n.empty()) {
+            BOOST_ASSERT(table_.node_alloc() == n.alloc_.value());
+            std::pair<iterator, bool> r = table_.insert_node(n.ptr_);
+            result.position = r.first;
+            result.inserted = r.second;
+            if (r.second) n.release();
+            else result.node = boost::move(n);
+        }
+
+        return boost::move(result);
+    }
+
+    template <class T, class H, class P, class A>
+    typename unordered_set<T,H,P,A>::iterator
+        unordered_set<T,H,P,A>::insert(
+            const_iterator, BOOST_RV_REF(node_type) np)
+    {
+        node_type& n = np;
+        if (n.empty()) return end();
+
+        BOOST_ASSERT(table_.node_alloc() == n.alloc_.value());
+        std::pair<iterator, bool> r = table_.insert_node(n.ptr_);
+        if (r.second) n.release();
+        return r.first;
+    }
+
     template <class T, class H, class P, class A>
     typename unordered_set<T,H,P,A>::iterator
         unordered_set<T,H,P,A>::erase(const_iterator position)
@@ -1194,6 +1509,53 @@ namespace unordered
         return table_.equal_range(k);
     }
 
+    template <class T, class H, class P, class A>
+    typename unordered_set<T,H,P,A>::const_iterator
+        unordered_set<T,H,P,A>::find(
+            const key_type& k, std::size_t hash) const
+    {
+        return table_.find_node_with_hash(hash, k);
+    }
+
+    template <class T, class H, class P, class A>
+    template <class Key>
+    typename boost::unordered::detail::enable_if_transparent<H, P, Key,
+        typename unordered_set<T,H,P,A>::const_iterator>::type
+        unordered_set<T,H,P,A>::find(Key const& k) const
+    {
+        return table_.find_node(k);
+    }
+
+    template <class T, class H, class P, class A>
+    template <class Key>
+    typename boost::unordered::detail::enable_if_transparent<H, P, Key,
+        typename unordered_set<T,H,P,A>::const_iterator>::type
+        unordered_set<T,H,P,A>::find(
+            Key const& k, std::size_t hash) const
+    {
+        return table_.find_node_with_hash(hash, k);
+    }
+
+    template <class T, class H, class P, class A>
+    template <class Key>
+    typename boost::unordered::detail::enable_if_transparent<H, P, Key,
+        typename unordered_set<T,H,P,A>::size_type>::type
+        unordered_set<T,H,P,A>::count(Key const& k) const
+    {
+        return table_.count(k);
+    }
+
+    template <class T, class H, class P, class A>
+    template <class Key>
+    typename boost::unordered::detail::enable_if_transparent<H, P, Key,
+        std::pair<
+            typename unordered_set<T,H,P,A>::const_iterator,
+            typename unordered_set<T,H,P,A>::const_iterator> >::type
+        unordered_set<T,H,P,A>::equal_range(Key const& k) const
+    {
+        return table_.equal_range(k);
+    }
+
     template <class T, class H, class P, class A>
     typename unordered_set<T,H,P,A>::size_type
         unordered_set<T,H,P,A>::bucket_size(size_type n) const
@@ -1391,6 +1753,42 @@ namespace unordered
     }
 #endif
 
+    template <class T, class H, class P, class A>
+    typename unordered_multiset<T,H,P,A>::node_type
+        unordered_multiset<T,H,P,A>::extract(const_iterator position)
+    {
+        return node_type(table_.extract_by_iterator(position),
+            table_.node_alloc());
+    }
+
+    template <class T, class H, class P, class A>
+    typename unordered_multiset<T,H,P,A>::node_type
+        unordered_multiset<T,H,P,A>::extract(const key_type& k)
+    {
+        return node_type(table_.extract_by_key(k), table_.node_alloc());
+    }
+
+    template <class T, class H, class P, class A>
+    typename unordered_multiset<T,H,P,A>::iterator
+        unordered_multiset<T,H,P,A>::insert(BOOST_RV_REF(node_type) np)
+    {
+        node_type& n = np;
+        if (n.empty()) return end();
+
+        BOOST_ASSERT(table_.node_alloc() == n.alloc_.value());
+        iterator pos = table_.insert_node(n.ptr_);
+        n.release();
+        return pos;
+    }
+
+    template <class T, class H, class P, class A>
+    typename unordered_multiset<T,H,P,A>::iterator
+        unordered_multiset<T,H,P,A>::insert(
+            const_iterator, BOOST_RV_REF(node_type) np)
+    {
+        return insert(boost::move(np));
+    }
+
     template <class T, class H, class P, class A>
     typename unordered_multiset<T,H,P,A>::iterator
         unordered_multiset<T,H,P,A>::erase(const_iterator position)
@@ -1478,6 +1876,53 @@ namespace unordered
         return table_.equal_range(k);
     }
 
+    template <class T, class H, class P, class A>
+    typename unordered_multiset<T,H,P,A>::const_iterator
+        unordered_multiset<T,H,P,A>::find(
+            const key_type& k, std::size_t hash) const
+    {
+        return table_.find_node_with_hash(hash, k);
+    }
+
+    template <class T, class H, class P, class A>
+    template <class Key>
+    typename boost::unordered::detail::enable_if_transparent<H, P, Key,
+        typename unordered_multiset<T,H,P,A>::const_iterator>::type
+        unordered_multiset<T,H,P,A>::find(Key const& k) const
+    {
+        return table_.find_node(k);
+    }
+
+    template <class T, class H, class P, class A>
+    template <class Key>
+    typename boost::unordered::detail::enable_if_transparent<H, P, Key,
+        typename unordered_multiset<T,H,P,A>::const_iterator>::type
+        unordered_multiset<T,H,P,A>::find(
+            Key const& k, std::size_t hash) const
+    {
+        return table_.find_node_with_hash(hash, k);
+    }
+
+    template <class T, class H, class P, class A>
+    template <class Key>
+    typename boost::unordered::detail::enable_if_transparent<H, P, Key,
+        typename unordered_multiset<T,H,P,A>::size_type>::type
+        unordered_multiset<T,H,P,A>::count(Key const& k) const
+    {
+        return table_.count(k);
+    }
+
+    template <class T, class H, class P, class A>
+    template <class Key>
+    typename boost::unordered::detail::enable_if_transparent<H, P, Key,
+        std::pair<
+            typename unordered_multiset<T,H,P,A>::const_iterator,
+            typename unordered_multiset<T,H,P,A>::const_iterator> >::type
+        unordered_multiset<T,H,P,A>::equal_range(Key const& k) const
+    {
+        return table_.equal_range(k);
+    }
+
     template <class T, class H, class P, class A>
     typename unordered_multiset<T,H,P,A>::size_type
         unordered_multiset<T,H,P,A>::bucket_size(size_type n) const
@@ -0,0 +1,102 @@
+//
+// handler_alloc_hook.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/handler_alloc_hook.hpp>
+
+#include <cstring>
+#include <boost/asio/io_service.hpp>
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+# include <boost/bind.hpp>
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+
+using namespace boost::asio;
+
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif
+
+void chain_handler(io_service* ios, int* count)
+{
+  if (--(*count) > 0)
+    ios->post(bindns::bind(chain_handler, ios, count));
+}
+
+// Frees a block that was allocated outside run(), then allocates a larger
+// size of the same size class, which may reuse the block.
+void free_then_allocate(void** p)
+{
+  asio_handler_deallocate(*p, 17, p);
+  *p = asio_handler_allocate(32, p);
+  std::memset(*p, 0, 32);
+  asio_handler_deallocate(*p, 32, p);
+  *p = 0;
+}
+
+void handler_alloc_hook_test()
+{
+  int dummy = 0;
+  void* p = asio_handler_allocate(100, &dummy);
+  BOOST_ASIO_CHECK(p != 0);
+  asio_handler_deallocate(p, 100, &dummy);
+
+  handler_alloc_stats before = get_handler_alloc_stats();
+
+  // Each handler in the chain posts the next one from within run(), so the
+  // memory released by one operation is available for the next.
+  io_service ios;
+  int count = 100;
+  ios.post(bindns::bind(chain_handler, &ios, &count));
+  ios.run();
+  BOOST_ASIO_CHECK(count == 0);
+
+  handler_alloc_stats after = get_handler_alloc_stats();
+
+#if !defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+  BOOST_ASIO_CHECK(after.hits - before.hits >= 98);
+  BOOST_ASIO_CHECK(after.misses - before.misses <= 1);
+#else // !defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+  BOOST_ASIO_CHECK(after.hits == 0);
+  BOOST_ASIO_CHECK(after.misses == 0);
+  (void)before;
+#endif // !defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+}
+
+void handler_alloc_cross_context_test()
+{
+  // A block allocated outside run() and freed inside it goes to the thread's
+  // cache, so it must be large enough for any size of its class.
+  int dummy = 0;
+  void* p = asio_handler_allocate(17, &dummy);
+  BOOST_ASIO_CHECK(p != 0);
+
+  io_service ios;
+  ios.post(bindns::bind(free_then_allocate, &p));
+  ios.run();
+  BOOST_ASIO_CHECK(p == 0);
+}
+
+BOOST_ASIO_TEST_SUITE
+(
+  "handler_alloc_hook",
+  BOOST_ASIO_TEST_CASE(handler_alloc_hook_test)
+  BOOST_ASIO_TEST_CASE(handler_alloc_cross_context_test)
+)
@@ -17,6 +17,7 @@
 #include <boost/asio/io_service.hpp>
 
 #include <sstream>
+#include <boost/asio/detail/mutex.hpp>
 #include "unit_test.hpp"
 
 #if defined(BOOST_ASIO_HAS_BOOST_DATE_TIME)
@@ -102,6 +103,40 @@ void start_sleep_increments(io_service* ios, int* count)
   ios->post(bindns::bind(sleep_increment, ios, count));
 }
 
+struct concurrency_counter
+{
+  boost::asio::detail::mutex mutex;
+  int running;
+  int max_running;
+  int completed;
+};
+
+void sleep_and_count(io_service* ios, concurrency_counter* counter)
+{
+  {
+    boost::asio::detail::mutex::scoped_lock lock(counter->mutex);
+    if (++counter->running > counter->max_running)
+      counter->max_running = counter->running;
+  }
+
+  timer t(*ios, chronons::milliseconds(20));
+  t.wait();
+
+  boost::asio::detail::mutex::scoped_lock lock(counter->mutex);
+  --counter->running;
+  ++counter->completed;
+}
+
+void start_nested_posts(io_service* ios, concurrency_counter* counter)
+{
+  // Give all threads a chance to start.
+  timer t(*ios, chronons::milliseconds(200));
+  t.wait();
+
+  for (int i = 0; i < 100; ++i)
+    ios->post(bindns::bind(sleep_and_count, ios, counter));
+}
+
 void throw_exception()
 {
   throw 1;
@@ -281,6 +316,31 @@ void io_service_test()
   BOOST_ASIO_CHECK(exception_count == 2);
 }
 
+// Handlers posted from inside a handler must be picked up by all the other
+// threads running the io_service, including one waiting in the reactor,
+// rather than all run by the posting thread.
+void io_service_concurrency_test()
+{
+  io_service ios;
+  concurrency_counter counter;
+  counter.running = 0;
+  counter.max_running = 0;
+  counter.completed = 0;
+
+  ios.post(bindns::bind(start_nested_posts, &ios, &counter));
+  boost::thread thread1(bindns::bind(io_service_run, &ios));
+  boost::thread thread2(bindns::bind(io_service_run, &ios));
+  boost::thread thread3(bindns::bind(io_service_run, &ios));
+  boost::thread thread4(bindns::bind(io_service_run, &ios));
+  thread1.join();
+  thread2.join();
+  thread3.join();
+  thread4.join();
+
+  BOOST_ASIO_CHECK(counter.completed == 100);
+  BOOST_ASIO_CHECK(counter.max_running == 4);
+}
+
 class test_service : public boost::asio::io_service::service
 {
 public:
@@ -355,5 +415,6 @@ BOOST_ASIO_TEST_SUITE
 (
   "io_service",
   BOOST_ASIO_TEST_CASE(io_service_test)
+  BOOST_ASIO_TEST_CASE(io_service_concurrency_test)
   BOOST_ASIO_TEST_CASE(io_service_service_test)
 )
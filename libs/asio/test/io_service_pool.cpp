@@ -0,0 +1,220 @@
+//
+// io_service_pool.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/io_service_pool.hpp>
+
+#include <stdexcept>
+#include <boost/asio/placeholders.hpp>
+#include <boost/detail/atomic_count.hpp>
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_BOOST_DATE_TIME)
+# include <boost/asio/deadline_timer.hpp>
+#else // defined(BOOST_ASIO_HAS_BOOST_DATE_TIME)
+# include <boost/asio/steady_timer.hpp>
+#endif // defined(BOOST_ASIO_HAS_BOOST_DATE_TIME)
+
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+# include <boost/bind.hpp>
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+
+using namespace boost::asio;
+
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif
+
+#if defined(BOOST_ASIO_HAS_BOOST_DATE_TIME)
+typedef deadline_timer timer;
+namespace chronons = boost::posix_time;
+#elif defined(BOOST_ASIO_HAS_STD_CHRONO)
+typedef steady_timer timer;
+namespace chronons = std::chrono;
+#elif defined(BOOST_ASIO_HAS_BOOST_CHRONO)
+typedef steady_timer timer;
+namespace chronons = boost::chrono;
+#endif // defined(BOOST_ASIO_HAS_BOOST_DATE_TIME)
+
+void increment(int* count)
+{
+  ++(*count);
+}
+
+void increment_and_stop_at(io_service_pool* pool,
+    boost::detail::atomic_count* count, long limit)
+{
+  if (++(*count) == limit)
+    pool->stop();
+}
+
+void post_from_handler(io_service_pool* pool,
+    boost::detail::atomic_count* count, long limit, int depth)
+{
+  if (depth > 0)
+  {
+    pool->post(bindns::bind(post_from_handler, pool, count, limit, depth - 1));
+    pool->post(bindns::bind(post_from_handler, pool, count, limit, depth - 1));
+  }
+
+  increment_and_stop_at(pool, count, limit);
+}
+
+void throwing_handler()
+{
+  throw std::runtime_error("throwing_handler");
+}
+
+void timer_handler(io_service_pool* pool, bool* invoked,
+    const boost::system::error_code& ec)
+{
+  *invoked = !ec;
+  pool->stop();
+}
+
+void io_service_pool_test()
+{
+  // Construction with no shards.
+
+  try
+  {
+    io_service_pool pool(0);
+    BOOST_ASIO_ERROR("io_service_pool constructor did not throw");
+  }
+  catch (std::invalid_argument&)
+  {
+  }
+
+  // Shard selection.
+
+  {
+    io_service_pool pool(3);
+    BOOST_ASIO_CHECK(pool.size() == 3);
+    BOOST_ASIO_CHECK(!pool.stopped());
+
+    io_service* first = &pool.get_io_service();
+    io_service* second = &pool.get_io_service();
+    io_service* third = &pool.get_io_service();
+    BOOST_ASIO_CHECK(first != second);
+    BOOST_ASIO_CHECK(second != third);
+    BOOST_ASIO_CHECK(first != third);
+    BOOST_ASIO_CHECK(&pool.get_io_service() == first);
+
+    for (std::size_t i = 0; i < pool.size(); ++i)
+    {
+      io_service* shard = &pool.get_io_service(i);
+      BOOST_ASIO_CHECK(shard == first || shard == second || shard == third);
+    }
+  }
+
+  // Posting handlers to the pool.
+
+  {
+    const long limit = 1000;
+    boost::detail::atomic_count count(0);
+    io_service_pool pool(4);
+    for (long i = 0; i < limit; ++i)
+      pool.post(bindns::bind(increment_and_stop_at, &pool, &count, limit));
+
+    // No handlers can be called until the pool is run.
+    BOOST_ASIO_CHECK(count == 0);
+
+    pool.run();
+    BOOST_ASIO_CHECK(count == limit);
+    BOOST_ASIO_CHECK(pool.stopped());
+
+    // A stopped pool returns from run() immediately.
+    pool.run();
+  }
+
+  // Posting handlers to the pool from inside pool handlers.
+
+  {
+    const int depth = 10;
+    const long limit = (1L << (depth + 1)) - 1;
+    boost::detail::atomic_count count(0);
+    io_service_pool pool(4);
+    pool.post(bindns::bind(post_from_handler, &pool, &count, limit, depth));
+    pool.run();
+    BOOST_ASIO_CHECK(count == limit);
+  }
+
+  // I/O objects bound to a shard.
+
+  {
+    bool invoked = false;
+    io_service_pool pool(2);
+    timer t(pool.get_io_service(1), chronons::milliseconds(10));
+    t.async_wait(bindns::bind(timer_handler, &pool, &invoked,
+          boost::asio::placeholders::error));
+    pool.run();
+    BOOST_ASIO_CHECK(invoked);
+  }
+
+  // Exceptions thrown by handlers do not stop the shard that ran them.
+
+  {
+    const long limit = 100;
+    boost::detail::atomic_count count(0);
+    io_service_pool pool(2);
+    for (long i = 0; i < limit; ++i)
+    {
+      pool.post(throwing_handler);
+      pool.get_io_service(0).post(throwing_handler);
+      pool.post(bindns::bind(increment_and_stop_at, &pool, &count, limit));
+    }
+    pool.run();
+    BOOST_ASIO_CHECK(count == limit);
+  }
+
+  // Stopping a shard's io_service directly stops the pool.
+
+  {
+    io_service_pool pool(2);
+    pool.get_io_service(1).stop();
+    pool.run();
+    BOOST_ASIO_CHECK(pool.stopped());
+  }
+
+  {
+    io_service_pool pool(3);
+    io_service& shard = pool.get_io_service(0);
+    shard.post(bindns::bind(&io_service::stop, &shard));
+    pool.run();
+    BOOST_ASIO_CHECK(pool.stopped());
+  }
+
+  // Handlers not run before the pool is destroyed are not invoked.
+
+  {
+    int count = 0;
+    {
+      io_service_pool pool(2);
+      pool.post(bindns::bind(increment, &count));
+      pool.post(bindns::bind(increment, &count));
+    }
+    BOOST_ASIO_CHECK(count == 0);
+  }
+}
+
+BOOST_ASIO_TEST_SUITE
+(
+  "io_service_pool",
+  BOOST_ASIO_TEST_CASE(io_service_pool_test)
+)
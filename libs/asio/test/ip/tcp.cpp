@@ -20,6 +20,7 @@
 #include <boost/asio/ip/tcp.hpp>
 
 #include <cstring>
+#include <vector>
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/read.hpp>
 #include <boost/asio/write.hpp>
@@ -29,6 +30,10 @@
 #include "../archetypes/io_control_command.hpp"
 #include "../archetypes/settable_socket_option.hpp"
 
+#if defined(BOOST_ASIO_HAS_ACCEPT4)
+# include <fcntl.h>
+#endif // defined(BOOST_ASIO_HAS_ACCEPT4)
+
 #if defined(BOOST_ASIO_HAS_BOOST_ARRAY)
 # include <boost/array.hpp>
 #else // defined(BOOST_ASIO_HAS_BOOST_ARRAY)
@@ -483,6 +488,14 @@ void handle_read(const boost::system::error_code& err,
   BOOST_ASIO_CHECK(bytes_transferred == sizeof(write_data));
 }
 
+void handle_read_twice(const boost::system::error_code& err,
+    size_t bytes_transferred, bool* called)
+{
+  *called = true;
+  BOOST_ASIO_CHECK(!err);
+  BOOST_ASIO_CHECK(bytes_transferred == 2 * sizeof(write_data));
+}
+
 void handle_write(const boost::system::error_code& err,
     size_t bytes_transferred, bool* called)
 {
@@ -491,6 +504,14 @@ void handle_write(const boost::system::error_code& err,
   BOOST_ASIO_CHECK(bytes_transferred == sizeof(write_data));
 }
 
+void handle_read_one(const boost::system::error_code& err,
+    size_t bytes_transferred, size_t* count)
+{
+  ++*count;
+  BOOST_ASIO_CHECK(!err);
+  BOOST_ASIO_CHECK(bytes_transferred == 1);
+}
+
 void handle_read_cancel(const boost::system::error_code& err,
     size_t bytes_transferred, bool* called)
 {
@@ -509,7 +530,7 @@ void handle_read_eof(const boost::system::error_code& err,
 
 void test()
 {
-  using namespace std; // For memcmp.
+  using namespace std; // For memcmp and memset.
   using namespace boost::asio;
   namespace ip = boost::asio::ip;
 
@@ -577,6 +598,159 @@ void test()
   BOOST_ASIO_CHECK(write_completed);
   BOOST_ASIO_CHECK(memcmp(read_buffer, write_data, sizeof(write_data)) == 0);
 
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+  // Zero-copy write, completing once the kernel has released the buffer.
+
+  boost::system::error_code zero_copy_ec;
+  server_side_socket.set_option(
+      socket_base::zero_copy(true), zero_copy_ec);
+  if (!zero_copy_ec)
+  {
+    memset(read_buffer, 0, sizeof(read_buffer));
+    read_completed = false;
+    boost::asio::async_read(client_side_socket,
+        boost::asio::buffer(read_buffer),
+        bindns::bind(handle_read,
+          _1, _2, &read_completed));
+
+    write_completed = false;
+    server_side_socket.async_send(boost::asio::buffer(write_data),
+        socket_base::message_zero_copy,
+        bindns::bind(handle_write,
+          _1, _2, &write_completed));
+
+    ios.reset();
+    ios.run();
+    BOOST_ASIO_CHECK(read_completed);
+    BOOST_ASIO_CHECK(write_completed);
+    BOOST_ASIO_CHECK(
+        memcmp(read_buffer, write_data, sizeof(write_data)) == 0);
+
+    // Several zero-copy writes in flight at once.
+
+    char zero_copy_buffer[2 * sizeof(write_data)];
+    read_completed = false;
+    boost::asio::async_read(client_side_socket,
+        boost::asio::buffer(zero_copy_buffer),
+        bindns::bind(handle_read_twice,
+          _1, _2, &read_completed));
+
+    write_completed = false;
+    server_side_socket.async_send(boost::asio::buffer(write_data),
+        socket_base::message_zero_copy,
+        bindns::bind(handle_write,
+          _1, _2, &write_completed));
+
+    bool zero_copy_write2_completed = false;
+    server_side_socket.async_send(boost::asio::buffer(write_data),
+        socket_base::message_zero_copy,
+        bindns::bind(handle_write,
+          _1, _2, &zero_copy_write2_completed));
+
+    ios.reset();
+    ios.run();
+    BOOST_ASIO_CHECK(read_completed);
+    BOOST_ASIO_CHECK(write_completed);
+    BOOST_ASIO_CHECK(zero_copy_write2_completed);
+    BOOST_ASIO_CHECK(memcmp(zero_copy_buffer,
+          write_data, sizeof(write_data)) == 0);
+    BOOST_ASIO_CHECK(memcmp(zero_copy_buffer + sizeof(write_data),
+          write_data, sizeof(write_data)) == 0);
+
+    // A synchronous send copies the data, and a later zero-copy write still
+    // completes.
+
+    boost::system::error_code send_ec;
+    server_side_socket.send(boost::asio::buffer(write_data),
+        socket_base::message_zero_copy, send_ec);
+    BOOST_ASIO_CHECK(!send_ec);
+
+    memset(read_buffer, 0, sizeof(read_buffer));
+    boost::asio::read(client_side_socket, boost::asio::buffer(read_buffer));
+    BOOST_ASIO_CHECK(
+        memcmp(read_buffer, write_data, sizeof(write_data)) == 0);
+
+    memset(read_buffer, 0, sizeof(read_buffer));
+    read_completed = false;
+    boost::asio::async_read(client_side_socket,
+        boost::asio::buffer(read_buffer),
+        bindns::bind(handle_read,
+          _1, _2, &read_completed));
+
+    write_completed = false;
+    server_side_socket.async_send(boost::asio::buffer(write_data),
+        socket_base::message_zero_copy,
+        bindns::bind(handle_write,
+          _1, _2, &write_completed));
+
+    ios.reset();
+    ios.run();
+    BOOST_ASIO_CHECK(read_completed);
+    BOOST_ASIO_CHECK(write_completed);
+    BOOST_ASIO_CHECK(
+        memcmp(read_buffer, write_data, sizeof(write_data)) == 0);
+  }
+
+  // Without the zero_copy option the flag is ignored, so the send completes
+  // and does not hold up a later write.
+
+  server_side_socket.set_option(
+      socket_base::zero_copy(false), zero_copy_ec);
+
+  char read_buffer2[2 * sizeof(write_data)];
+  read_completed = false;
+  boost::asio::async_read(client_side_socket,
+      boost::asio::buffer(read_buffer2),
+      bindns::bind(handle_read_twice,
+        _1, _2, &read_completed));
+
+  write_completed = false;
+  server_side_socket.async_send(boost::asio::buffer(write_data),
+      socket_base::message_zero_copy,
+      bindns::bind(handle_write,
+        _1, _2, &write_completed));
+
+  bool write2_completed = false;
+  boost::asio::async_write(server_side_socket,
+      boost::asio::buffer(write_data),
+      bindns::bind(handle_write,
+        _1, _2, &write2_completed));
+
+  ios.reset();
+  ios.run();
+  BOOST_ASIO_CHECK(read_completed);
+  BOOST_ASIO_CHECK(write_completed);
+  BOOST_ASIO_CHECK(write2_completed);
+  BOOST_ASIO_CHECK(memcmp(read_buffer2, write_data, sizeof(write_data)) == 0);
+  BOOST_ASIO_CHECK(memcmp(read_buffer2 + sizeof(write_data),
+        write_data, sizeof(write_data)) == 0);
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+  // More outstanding reads than fit in an io_uring completion queue.
+
+  const size_t num_reads = 2000;
+  std::vector<char> read_bytes(num_reads);
+  size_t reads_completed = 0;
+  for (size_t i = 0; i < num_reads; ++i)
+  {
+    client_side_socket.async_read_some(
+        boost::asio::buffer(&read_bytes[i], 1),
+        bindns::bind(handle_read_one,
+          _1, _2, &reads_completed));
+  }
+
+  ios.reset();
+  ios.poll();
+  BOOST_ASIO_CHECK(reads_completed == 0);
+
+  std::vector<char> write_bytes(num_reads, 'x');
+  boost::asio::write(server_side_socket, boost::asio::buffer(write_bytes));
+
+  ios.reset();
+  ios.run();
+  BOOST_ASIO_CHECK(reads_completed == num_reads);
+  BOOST_ASIO_CHECK(read_bytes == write_bytes);
+
   // Cancelled read.
 
   bool read_cancel_completed = false;
@@ -789,6 +963,18 @@ void test()
   client_side_socket.connect(server_endpoint);
   acceptor.accept(server_side_socket);
 
+#if defined(BOOST_ASIO_HAS_ACCEPT4)
+  // The accepted socket is created in non-blocking mode, and the socket object
+  // records it so that synchronous operations still block.
+  BOOST_ASIO_CHECK(server_side_socket.native_non_blocking());
+  BOOST_ASIO_CHECK((::fcntl(server_side_socket.native_handle(), F_GETFL)
+        & O_NONBLOCK) != 0);
+#endif // defined(BOOST_ASIO_HAS_ACCEPT4)
+
+  char data = 'x';
+  client_side_socket.send(buffer(&data, 1));
+  BOOST_ASIO_CHECK(server_side_socket.receive(buffer(&data, 1)) == 1);
+
   client_side_socket.close();
   server_side_socket.close();
 
@@ -816,6 +1002,12 @@ void test()
 
   ios.run();
 
+#if defined(BOOST_ASIO_HAS_ACCEPT4)
+  BOOST_ASIO_CHECK(server_side_socket.native_non_blocking());
+  BOOST_ASIO_CHECK((::fcntl(server_side_socket.native_handle(), F_GETFL)
+        & O_NONBLOCK) != 0);
+#endif // defined(BOOST_ASIO_HAS_ACCEPT4)
+
   client_side_socket.close();
   server_side_socket.close();
 
@@ -837,6 +1029,126 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// ip_tcp_acceptor_pool_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the ip::tcp::acceptor_pool
+// class.
+
+namespace ip_tcp_acceptor_pool_runtime {
+
+#if defined(BOOST_ASIO_HAS_SO_REUSEPORT)
+
+class counting_acceptor
+{
+public:
+  counting_acceptor(boost::asio::ip::tcp::acceptor& acceptor)
+    : acceptor_(acceptor),
+      socket_(acceptor.get_io_service()),
+      count_(0)
+  {
+  }
+
+  void start()
+  {
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+    namespace bindns = boost;
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+    namespace bindns = std;
+    using std::placeholders::_1;
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+
+    acceptor_.async_accept(socket_,
+        bindns::bind(&counting_acceptor::handle_accept, this, _1));
+  }
+
+  int count() const
+  {
+    return count_;
+  }
+
+private:
+  void handle_accept(const boost::system::error_code& err)
+  {
+    if (err == boost::asio::error::operation_aborted)
+      return;
+
+    BOOST_ASIO_CHECK(!err);
+    ++count_;
+    socket_.close();
+    start();
+  }
+
+  boost::asio::ip::tcp::acceptor& acceptor_;
+  boost::asio::ip::tcp::socket socket_;
+  int count_;
+};
+
+void test()
+{
+  using namespace boost::asio;
+  namespace ip = boost::asio::ip;
+
+  const int num_connections = 16;
+
+  io_service ios1;
+  io_service ios2;
+
+  ip::tcp::acceptor_pool pool(ip::tcp::endpoint(ip::tcp::v4(), 0));
+  BOOST_ASIO_CHECK(pool.size() == 0);
+
+  pool.add(ios1);
+  pool.add(ios2);
+  BOOST_ASIO_CHECK(pool.size() == 2);
+
+  ip::tcp::endpoint server_endpoint = pool.local_endpoint();
+  BOOST_ASIO_CHECK(server_endpoint.port() != 0);
+  BOOST_ASIO_CHECK(pool[0].local_endpoint() == server_endpoint);
+  BOOST_ASIO_CHECK(pool[1].local_endpoint() == server_endpoint);
+  server_endpoint.address(ip::address_v4::loopback());
+
+  counting_acceptor acceptor1(pool[0]);
+  counting_acceptor acceptor2(pool[1]);
+  acceptor1.start();
+  acceptor2.start();
+
+  io_service client_ios;
+  ip::tcp::socket client_socket(client_ios);
+  for (int i = 0; i < num_connections; ++i)
+  {
+    client_socket.connect(server_endpoint);
+    client_socket.close();
+  }
+
+  // Every connection is accepted by exactly one of the acceptors.
+  while (acceptor1.count() + acceptor2.count() < num_connections)
+  {
+    ios1.poll_one();
+    ios2.poll_one();
+  }
+  BOOST_ASIO_CHECK(acceptor1.count() + acceptor2.count() == num_connections);
+
+  pool.close();
+  BOOST_ASIO_CHECK(!pool[0].is_open());
+  BOOST_ASIO_CHECK(!pool[1].is_open());
+
+  ios1.reset();
+  ios1.run();
+  ios2.reset();
+  ios2.run();
+}
+
+#else // defined(BOOST_ASIO_HAS_SO_REUSEPORT)
+
+void test()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_SO_REUSEPORT)
+
+} // namespace ip_tcp_acceptor_pool_runtime
+
+//------------------------------------------------------------------------------
+
 // ip_tcp_resolver_compile test
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // The following test checks that all public member functions on the class
@@ -913,5 +1225,6 @@ BOOST_ASIO_TEST_SUITE
   BOOST_ASIO_TEST_CASE(ip_tcp_socket_runtime::test)
   BOOST_ASIO_TEST_CASE(ip_tcp_acceptor_compile::test)
   BOOST_ASIO_TEST_CASE(ip_tcp_acceptor_runtime::test)
+  BOOST_ASIO_TEST_CASE(ip_tcp_acceptor_pool_runtime::test)
   BOOST_ASIO_TEST_CASE(ip_tcp_resolver_compile::test)
 )
@@ -378,6 +378,43 @@ void test()
     int i28 = socket1.async_receive_from(null_buffers(),
         endpoint, in_flags, lazy);
     (void)i28;
+
+#if !defined(BOOST_ASIO_HAS_IOCP)
+    mutable_buffer mutable_buffers[2] = {
+      buffer(mutable_char_buffer, 64), buffer(mutable_char_buffer + 64, 64) };
+    const_buffer const_buffers[2] = {
+      buffer(const_char_buffer, 64), buffer(const_char_buffer + 64, 64) };
+    ip::udp::endpoint endpoints[2];
+    std::size_t sizes[2];
+
+    socket1.send_batch(const_buffers, endpoints, 2);
+    socket1.send_batch(const_buffers, endpoints, 2, in_flags);
+    socket1.send_batch(const_buffers, endpoints, 2, in_flags, ec);
+
+    socket1.async_send_batch(const_buffers, endpoints, 2, &send_handler);
+    socket1.async_send_batch(const_buffers, endpoints, 2,
+        in_flags, &send_handler);
+    int i29 = socket1.async_send_batch(const_buffers, endpoints, 2, lazy);
+    (void)i29;
+    int i30 = socket1.async_send_batch(const_buffers, endpoints, 2,
+        in_flags, lazy);
+    (void)i30;
+
+    socket1.receive_batch(mutable_buffers, endpoints, sizes, 2);
+    socket1.receive_batch(mutable_buffers, endpoints, sizes, 2, in_flags);
+    socket1.receive_batch(mutable_buffers, endpoints, sizes, 2, in_flags, ec);
+
+    socket1.async_receive_batch(mutable_buffers, endpoints, sizes, 2,
+        &receive_handler);
+    socket1.async_receive_batch(mutable_buffers, endpoints, sizes, 2,
+        in_flags, &receive_handler);
+    int i31 = socket1.async_receive_batch(mutable_buffers,
+        endpoints, sizes, 2, lazy);
+    (void)i31;
+    int i32 = socket1.async_receive_batch(mutable_buffers,
+        endpoints, sizes, 2, in_flags, lazy);
+    (void)i32;
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
   }
   catch (std::exception&)
   {
@@ -408,6 +445,13 @@ void handle_recv(size_t expected_bytes_recvd,
   BOOST_ASIO_CHECK(expected_bytes_recvd == bytes_recvd);
 }
 
+void handle_batch_recv(size_t* datagrams_recvd,
+    const boost::system::error_code& err, size_t n)
+{
+  BOOST_ASIO_CHECK(!err);
+  *datagrams_recvd = n;
+}
+
 void test()
 {
   using namespace std; // For memcmp and memset.
@@ -453,6 +497,78 @@ void test()
   ios.run();
 
   BOOST_ASIO_CHECK(memcmp(send_msg, recv_msg, sizeof(send_msg)) == 0);
+
+#if !defined(BOOST_ASIO_HAS_IOCP)
+  const size_t batch_size = 4;
+  char batch_recv_msgs[batch_size][sizeof(send_msg)];
+  const_buffer send_buffers[batch_size];
+  mutable_buffer recv_buffers[batch_size];
+  ip::udp::endpoint destinations[batch_size];
+  ip::udp::endpoint senders[batch_size];
+  size_t sizes[batch_size];
+  for (size_t i = 0; i < batch_size; ++i)
+  {
+    send_buffers[i] = buffer(send_msg, i + 1);
+    recv_buffers[i] = buffer(batch_recv_msgs[i]);
+    destinations[i] = target_endpoint;
+    sizes[i] = 0;
+  }
+
+  size_t datagrams_sent = s1.send_batch(
+      send_buffers, destinations, batch_size);
+  BOOST_ASIO_CHECK(datagrams_sent == batch_size);
+
+  size_t datagrams_recvd = 0;
+  while (datagrams_recvd < batch_size)
+  {
+    size_t n = s2.receive_batch(recv_buffers + datagrams_recvd,
+        senders + datagrams_recvd, sizes + datagrams_recvd,
+        batch_size - datagrams_recvd);
+    BOOST_ASIO_CHECK(n > 0);
+    datagrams_recvd += n;
+  }
+
+  for (size_t i = 0; i < batch_size; ++i)
+  {
+    BOOST_ASIO_CHECK(sizes[i] == i + 1);
+    BOOST_ASIO_CHECK(memcmp(send_msg, batch_recv_msgs[i], i + 1) == 0);
+    BOOST_ASIO_CHECK(senders[i].port() == s1.local_endpoint().port());
+  }
+
+  for (size_t i = 0; i < batch_size; ++i)
+  {
+    memset(batch_recv_msgs[i], 0, sizeof(send_msg));
+    sizes[i] = 0;
+  }
+
+  s1.async_send_batch(send_buffers, destinations, batch_size,
+      bindns::bind(handle_send, batch_size, _1, _2));
+
+  ios.reset();
+  ios.run();
+
+  datagrams_recvd = 0;
+  while (datagrams_recvd < batch_size)
+  {
+    size_t n = 0;
+    s2.async_receive_batch(recv_buffers + datagrams_recvd,
+        senders + datagrams_recvd, sizes + datagrams_recvd,
+        batch_size - datagrams_recvd,
+        bindns::bind(handle_batch_recv, &n, _1, _2));
+
+    ios.reset();
+    ios.run();
+
+    BOOST_ASIO_CHECK(n > 0);
+    datagrams_recvd += n;
+  }
+
+  for (size_t i = 0; i < batch_size; ++i)
+  {
+    BOOST_ASIO_CHECK(sizes[i] == i + 1);
+    BOOST_ASIO_CHECK(memcmp(send_msg, batch_recv_msgs[i], i + 1) == 0);
+  }
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
 }
 
 } // namespace ip_udp_socket_runtime
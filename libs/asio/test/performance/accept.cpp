@@ -0,0 +1,197 @@
+//
+// accept.cpp
+// ~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/placeholders.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/detail/atomic_count.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using boost::asio::ip::tcp;
+using boost::posix_time::ptime;
+using boost::posix_time::microsec_clock;
+
+// Shared by all acceptors. When the last expected connection has been
+// accepted, every io_service is stopped.
+class accept_counter
+{
+public:
+  accept_counter(long total)
+    : total_(total),
+      accepted_(0)
+  {
+  }
+
+  void add(boost::asio::io_service& io_service)
+  {
+    io_services_.push_back(&io_service);
+  }
+
+  void accepted()
+  {
+    if (++accepted_ == total_)
+      for (std::size_t i = 0; i < io_services_.size(); ++i)
+        io_services_[i]->stop();
+  }
+
+private:
+  long total_;
+  boost::detail::atomic_count accepted_;
+  std::vector<boost::asio::io_service*> io_services_;
+};
+
+// Keeps one accept operation outstanding on an acceptor, closing each new
+// connection as soon as it is accepted.
+class acceptor_loop
+{
+public:
+  acceptor_loop(tcp::acceptor& acceptor, accept_counter& counter)
+    : acceptor_(acceptor),
+      socket_(acceptor.get_io_service()),
+      counter_(counter),
+      count_(0)
+  {
+  }
+
+  void start()
+  {
+    acceptor_.async_accept(socket_,
+        boost::bind(&acceptor_loop::handle_accept, this,
+          boost::asio::placeholders::error));
+  }
+
+  long count() const
+  {
+    return count_;
+  }
+
+private:
+  void handle_accept(const boost::system::error_code& err)
+  {
+    if (err)
+      return;
+
+    ++count_;
+    socket_.close();
+    counter_.accepted();
+    start();
+  }
+
+  tcp::acceptor& acceptor_;
+  tcp::socket socket_;
+  accept_counter& counter_;
+  long count_;
+};
+
+void run_clients(tcp::endpoint endpoint, int num_connections)
+{
+  boost::asio::io_service io_service;
+  tcp::socket socket(io_service);
+  for (int i = 0; i < num_connections; ++i)
+  {
+    socket.connect(endpoint);
+    socket.close();
+  }
+}
+
+double run_test(bool use_pool, int num_threads,
+    int num_clients, int num_connections, std::vector<long>& counts)
+{
+  long total = static_cast<long>(num_clients) * num_connections;
+  accept_counter counter(total);
+
+  // A single acceptor shared by all threads, or one acceptor and io_service
+  // per thread.
+  int num_io_services = use_pool ? num_threads : 1;
+  std::vector<boost::shared_ptr<boost::asio::io_service> > io_services;
+  for (int i = 0; i < num_io_services; ++i)
+  {
+    io_services.push_back(boost::shared_ptr<boost::asio::io_service>(
+          new boost::asio::io_service));
+    counter.add(*io_services.back());
+  }
+
+  tcp::acceptor_pool pool(tcp::endpoint(tcp::v4(), 0));
+  for (int i = 0; i < num_io_services; ++i)
+    pool.add(*io_services[i]);
+
+  std::vector<boost::shared_ptr<acceptor_loop> > loops;
+  for (int i = 0; i < num_threads; ++i)
+  {
+    loops.push_back(boost::shared_ptr<acceptor_loop>(
+          new acceptor_loop(pool[i % num_io_services], counter)));
+    loops.back()->start();
+  }
+
+  tcp::endpoint endpoint = pool.local_endpoint();
+  endpoint.address(boost::asio::ip::address_v4::loopback());
+
+  ptime start = microsec_clock::universal_time();
+
+  boost::thread_group threads;
+  for (int i = 0; i < num_threads; ++i)
+    threads.create_thread(boost::bind(&boost::asio::io_service::run,
+          io_services[i % num_io_services].get()));
+
+  boost::thread_group clients;
+  for (int i = 0; i < num_clients; ++i)
+    clients.create_thread(boost::bind(run_clients,
+          endpoint, num_connections));
+
+  clients.join_all();
+  threads.join_all();
+
+  ptime stop = microsec_clock::universal_time();
+
+  counts.clear();
+  for (int i = 0; i < num_threads; ++i)
+    counts.push_back(loops[i]->count());
+
+  double usec = static_cast<double>((stop - start).total_microseconds());
+  return usec > 0 ? total * 1000000.0 / usec : 0;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 5 || (std::strcmp(argv[1], "shared") != 0
+        && std::strcmp(argv[1], "pool") != 0))
+  {
+    std::fprintf(stderr,
+        "Usage: accept <shared|pool> <nthreads> <nclients> <nconnections>\n"
+        "Reports connections accepted per second and how many connections\n"
+        "each thread accepted. In shared mode all threads run one io_service\n"
+        "and one acceptor. In pool mode each thread has its own io_service\n"
+        "and acceptor, bound to the same port using SO_REUSEPORT.\n");
+    return 1;
+  }
+
+  bool use_pool = (std::strcmp(argv[1], "pool") == 0);
+  int num_threads = std::atoi(argv[2]);
+  int num_clients = std::atoi(argv[3]);
+  int num_connections = std::atoi(argv[4]);
+
+  std::vector<long> counts;
+  double rate = run_test(use_pool, num_threads,
+      num_clients, num_connections, counts);
+
+  std::printf("%16s %.0f\n", "accepts/sec", rate);
+  for (std::size_t i = 0; i < counts.size(); ++i)
+    std::printf("%16s %lu: %ld\n", "thread", static_cast<unsigned long>(i),
+        counts[i]);
+
+  return 0;
+}
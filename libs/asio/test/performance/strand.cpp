@@ -0,0 +1,106 @@
+//
+// strand.cpp
+// ~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using boost::posix_time::ptime;
+using boost::posix_time::microsec_clock;
+
+// Each chain repeatedly posts a handler to its own strand, so that the strand
+// is always busy but has at most one handler queued at a time.
+class chain
+{
+public:
+  chain(boost::asio::io_service& io_service, int num_handlers)
+    : strand_(io_service),
+      remaining_(num_handlers)
+  {
+  }
+
+  void start()
+  {
+    strand_.post(boost::bind(&chain::next, this));
+  }
+
+private:
+  void next()
+  {
+    if (--remaining_ > 0)
+      strand_.post(boost::bind(&chain::next, this));
+  }
+
+  boost::asio::io_service::strand strand_;
+  int remaining_;
+};
+
+double run_test(int num_threads, int num_strands,
+    int num_handlers, int pool_size)
+{
+  boost::asio::io_service io_service;
+  if (pool_size >= 0)
+    boost::asio::io_service::strand::set_pool_size(
+        io_service, static_cast<std::size_t>(pool_size));
+
+  std::vector<boost::shared_ptr<chain> > chains;
+  for (int i = 0; i < num_strands; ++i)
+  {
+    chains.push_back(boost::shared_ptr<chain>(
+          new chain(io_service, num_handlers)));
+    chains.back()->start();
+  }
+
+  ptime start = microsec_clock::universal_time();
+
+  boost::thread_group threads;
+  for (int i = 0; i < num_threads; ++i)
+    threads.create_thread(boost::bind(&boost::asio::io_service::run,
+          &io_service));
+  threads.join_all();
+
+  ptime stop = microsec_clock::universal_time();
+
+  double usec = static_cast<double>((stop - start).total_microseconds());
+  double total = static_cast<double>(num_strands) * num_handlers;
+  return usec > 0 ? total * 1000000.0 / usec : 0;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 4 && argc != 5)
+  {
+    std::fprintf(stderr,
+        "Usage: strand <nthreads> <max-nstrands> <nhandlers> [pool-size]\n"
+        "Reports handlers per second for 1, 2, 4, ... <max-nstrands> strands.\n"
+        "A pool size of 0 gives every strand its own implementation.\n");
+    return 1;
+  }
+
+  int num_threads = std::atoi(argv[1]);
+  int max_strands = std::atoi(argv[2]);
+  int num_handlers = std::atoi(argv[3]);
+  int pool_size = (argc == 5) ? std::atoi(argv[4]) : -1;
+
+  std::printf("%10s %16s\n", "strands", "handlers/sec");
+  for (int num_strands = 1; num_strands <= max_strands; num_strands *= 2)
+  {
+    double rate = run_test(num_threads, num_strands, num_handlers, pool_size);
+    std::printf("%10d %16.0f\n", num_strands, rate);
+  }
+
+  return 0;
+}
@@ -19,6 +19,7 @@
 #include <cstring>
 #include "archetypes/async_result.hpp"
 #include <boost/asio/io_service.hpp>
+#include <boost/asio/ring_buffer.hpp>
 #include <boost/asio/streambuf.hpp>
 #include "unit_test.hpp"
 
@@ -302,6 +303,102 @@ namespace asio {
 } // namespace asio
 } // namespace boost
 
+void test_ring_buffer_read_until()
+{
+  boost::asio::io_service ios;
+  test_stream s(ios);
+  boost::asio::ring_buffer rb1;
+  boost::asio::ring_buffer rb2(25);
+  boost::system::error_code ec;
+
+  s.reset(read_data, sizeof(read_data));
+  rb1.consume(rb1.size());
+  std::size_t length = boost::asio::read_until(s, rb1, 'Z');
+  BOOST_ASIO_CHECK(length == 26);
+
+  s.reset(read_data, sizeof(read_data));
+  s.next_read_length(1);
+  rb1.consume(rb1.size());
+  length = boost::asio::read_until(s, rb1, 'Z', ec);
+  BOOST_ASIO_CHECK(!ec);
+  BOOST_ASIO_CHECK(length == 26);
+
+  s.reset(read_data, sizeof(read_data));
+  s.next_read_length(10);
+  rb1.consume(rb1.size());
+  length = boost::asio::read_until(s, rb1, "XYZ");
+  BOOST_ASIO_CHECK(length == 26);
+
+  s.reset(read_data, sizeof(read_data));
+  s.next_read_length(1);
+  rb1.consume(rb1.size());
+  length = boost::asio::read_until(s, rb1, "XYZ", ec);
+  BOOST_ASIO_CHECK(!ec);
+  BOOST_ASIO_CHECK(length == 26);
+
+  s.reset(read_data, sizeof(read_data));
+  s.next_read_length(10);
+  rb2.consume(rb2.size());
+  length = boost::asio::read_until(s, rb2, 'Z', ec);
+  BOOST_ASIO_CHECK(ec == boost::asio::error::not_found);
+  BOOST_ASIO_CHECK(length == 0);
+
+  s.reset(read_data, sizeof(read_data));
+  s.next_read_length(10);
+  rb2.consume(rb2.size());
+  length = boost::asio::read_until(s, rb2, "XYZ", ec);
+  BOOST_ASIO_CHECK(ec == boost::asio::error::not_found);
+  BOOST_ASIO_CHECK(length == 0);
+
+  s.reset(read_data, sizeof(read_data));
+  s.next_read_length(1);
+  rb2.consume(rb2.size());
+  length = boost::asio::read_until(s, rb2, 'Y', ec);
+  BOOST_ASIO_CHECK(!ec);
+  BOOST_ASIO_CHECK(length == 25);
+
+  s.reset(read_data, sizeof(read_data));
+  s.next_read_length(1);
+  rb2.consume(rb2.size());
+  length = boost::asio::read_until(s, rb2, "XY", ec);
+  BOOST_ASIO_CHECK(!ec);
+  BOOST_ASIO_CHECK(length == 25);
+}
+
+void test_ring_buffer_wrapped_read_until()
+{
+  boost::asio::io_service ios;
+  test_stream s(ios);
+  boost::asio::ring_buffer rb(32);
+  boost::system::error_code ec;
+
+  // Leave "abcd" at the end of the 32 byte storage, so that the data read
+  // next wraps around to the beginning.
+  s.reset(read_data, sizeof(read_data));
+  s.next_read_length(10);
+  std::size_t length = boost::asio::read_until(s, rb, 'Z');
+  BOOST_ASIO_CHECK(length == 26);
+  BOOST_ASIO_CHECK(rb.size() == 30);
+  rb.consume(length);
+
+  s.reset(read_data, sizeof(read_data));
+  s.next_read_length(1);
+  length = boost::asio::read_until(s, rb, "ABC", ec);
+  BOOST_ASIO_CHECK(!ec);
+  BOOST_ASIO_CHECK(length == 7);
+  BOOST_ASIO_CHECK(boost::asio::buffer_size(rb.data()[1]) != 0);
+  BOOST_ASIO_CHECK(rb.capacity() == 32);
+
+  length = boost::asio::read_until(s, rb, 'Z', ec);
+  BOOST_ASIO_CHECK(!ec);
+  BOOST_ASIO_CHECK(length == 30);
+  BOOST_ASIO_CHECK(rb.capacity() == 32);
+
+  std::string line(boost::asio::buffers_begin(rb.data()),
+      boost::asio::buffers_begin(rb.data()) + length);
+  BOOST_ASIO_CHECK(line == "abcdABCDEFGHIJKLMNOPQRSTUVWXYZ");
+}
+
 void test_match_condition_read_until()
 {
   boost::asio::io_service ios;
@@ -874,6 +971,93 @@ void test_match_condition_async_read_until()
   ios.run();
 }
 
+void test_ring_buffer_async_read_until()
+{
+#if defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(BOOST_ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+  using std::placeholders::_1;
+  using std::placeholders::_2;
+#endif // defined(BOOST_ASIO_HAS_BOOST_BIND)
+
+  boost::asio::io_service ios;
+  test_stream s(ios);
+  boost::asio::ring_buffer rb1;
+  boost::asio::ring_buffer rb2(25);
+  boost::system::error_code ec;
+  std::size_t length;
+  bool called;
+
+  s.reset(read_data, sizeof(read_data));
+  s.next_read_length(1);
+  ec = boost::system::error_code();
+  length = 0;
+  called = false;
+  rb1.consume(rb1.size());
+  boost::asio::async_read_until(s, rb1, 'Z',
+      bindns::bind(async_read_handler, _1, &ec,
+        _2, &length, &called));
+  ios.reset();
+  ios.run();
+  BOOST_ASIO_CHECK(called);
+  BOOST_ASIO_CHECK(!ec);
+  BOOST_ASIO_CHECK(length == 26);
+
+  s.reset(read_data, sizeof(read_data));
+  s.next_read_length(10);
+  ec = boost::system::error_code();
+  length = 0;
+  called = false;
+  rb1.consume(rb1.size());
+  boost::asio::async_read_until(s, rb1, "XYZ",
+      bindns::bind(async_read_handler, _1, &ec,
+        _2, &length, &called));
+  ios.reset();
+  ios.run();
+  BOOST_ASIO_CHECK(called);
+  BOOST_ASIO_CHECK(!ec);
+  BOOST_ASIO_CHECK(length == 26);
+
+  s.reset(read_data, sizeof(read_data));
+  s.next_read_length(10);
+  ec = boost::system::error_code();
+  length = 0;
+  called = false;
+  rb2.consume(rb2.size());
+  boost::asio::async_read_until(s, rb2, 'Z',
+      bindns::bind(async_read_handler, _1, &ec,
+        _2, &length, &called));
+  ios.reset();
+  ios.run();
+  BOOST_ASIO_CHECK(called);
+  BOOST_ASIO_CHECK(ec == boost::asio::error::not_found);
+  BOOST_ASIO_CHECK(length == 0);
+
+  s.reset(read_data, sizeof(read_data));
+  s.next_read_length(1);
+  ec = boost::system::error_code();
+  length = 0;
+  called = false;
+  rb2.consume(rb2.size());
+  boost::asio::async_read_until(s, rb2, "XY",
+      bindns::bind(async_read_handler, _1, &ec,
+        _2, &length, &called));
+  ios.reset();
+  ios.run();
+  BOOST_ASIO_CHECK(called);
+  BOOST_ASIO_CHECK(!ec);
+  BOOST_ASIO_CHECK(length == 25);
+
+  s.reset(read_data, sizeof(read_data));
+  rb2.consume(rb2.size());
+  int i = boost::asio::async_read_until(s, rb2, 'Y',
+      archetypes::lazy_handler());
+  BOOST_ASIO_CHECK(i == 42);
+  ios.reset();
+  ios.run();
+}
+
 BOOST_ASIO_TEST_SUITE
 (
   "read_until",
@@ -883,4 +1067,7 @@ BOOST_ASIO_TEST_SUITE
   BOOST_ASIO_TEST_CASE(test_char_async_read_until)
   BOOST_ASIO_TEST_CASE(test_string_async_read_until)
   BOOST_ASIO_TEST_CASE(test_match_condition_async_read_until)
+  BOOST_ASIO_TEST_CASE(test_ring_buffer_read_until)
+  BOOST_ASIO_TEST_CASE(test_ring_buffer_wrapped_read_until)
+  BOOST_ASIO_TEST_CASE(test_ring_buffer_async_read_until)
 )
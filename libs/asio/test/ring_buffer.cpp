@@ -0,0 +1,146 @@
+//
+// ring_buffer.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/ring_buffer.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/buffers_iterator.hpp>
+#include "unit_test.hpp"
+
+std::string ring_buffer_contents(const boost::asio::ring_buffer& rb)
+{
+  return std::string(boost::asio::buffers_begin(rb.data()),
+      boost::asio::buffers_end(rb.data()));
+}
+
+void ring_buffer_test()
+{
+  boost::asio::ring_buffer rb;
+
+  boost::asio::buffer_copy(rb.prepare(4), boost::asio::buffer("abcd", 4));
+  rb.commit(4);
+
+  BOOST_ASIO_CHECK(rb.size() == 4);
+
+  std::size_t capacity = rb.capacity();
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    rb.consume(3);
+
+    BOOST_ASIO_CHECK(rb.size() == 1);
+
+    boost::asio::buffer_copy(rb.prepare(10), boost::asio::buffer("bcd", 3));
+    rb.commit(3);
+
+    BOOST_ASIO_CHECK(rb.size() == 4);
+    BOOST_ASIO_CHECK(ring_buffer_contents(rb) == "dbcd");
+
+    rb.consume(1);
+
+    BOOST_ASIO_CHECK(ring_buffer_contents(rb) == "bcd");
+
+    boost::asio::buffer_copy(rb.prepare(1), boost::asio::buffer("d", 1));
+    rb.commit(1);
+
+    BOOST_ASIO_CHECK(ring_buffer_contents(rb) == "bcdd");
+  }
+
+  // The storage is reused in place rather than grown.
+  BOOST_ASIO_CHECK(rb.capacity() == capacity);
+  BOOST_ASIO_CHECK(rb.size() == 4);
+
+  rb.consume(4);
+
+  BOOST_ASIO_CHECK(rb.size() == 0);
+}
+
+void ring_buffer_wrap_test()
+{
+  boost::asio::ring_buffer rb;
+
+  // Fill the storage, then consume all but the last two characters so that
+  // the input sequence ends at the end of the storage and the next output
+  // sequence starts at the beginning.
+  rb.prepare(1);
+  std::size_t capacity = rb.capacity();
+  std::string fill(capacity, 'x');
+  boost::asio::buffer_copy(rb.prepare(capacity), boost::asio::buffer(fill));
+  rb.commit(capacity);
+  rb.consume(capacity - 2);
+
+  boost::asio::ring_buffer::mutable_buffers_type out = rb.prepare(6);
+  BOOST_ASIO_CHECK(boost::asio::buffer_size(out) == 6);
+  BOOST_ASIO_CHECK(boost::asio::buffer_size(out[0]) == 6);
+  BOOST_ASIO_CHECK(boost::asio::buffer_size(out[1]) == 0);
+  boost::asio::buffer_copy(out, boost::asio::buffer("abcdef", 6));
+  rb.commit(6);
+
+  BOOST_ASIO_CHECK(rb.capacity() == capacity);
+  BOOST_ASIO_CHECK(rb.size() == 8);
+  BOOST_ASIO_CHECK(ring_buffer_contents(rb) == "xxabcdef");
+
+  boost::asio::ring_buffer::const_buffers_type in = rb.data();
+  BOOST_ASIO_CHECK(boost::asio::buffer_size(in[0]) == 2);
+  BOOST_ASIO_CHECK(boost::asio::buffer_size(in[1]) == 6);
+
+  // Growing the storage linearises the input sequence.
+  rb.prepare(capacity);
+  BOOST_ASIO_CHECK(rb.capacity() > capacity);
+  BOOST_ASIO_CHECK(ring_buffer_contents(rb) == "xxabcdef");
+  BOOST_ASIO_CHECK(boost::asio::buffer_size(rb.data()[0]) == 8);
+
+  rb.consume(8);
+  BOOST_ASIO_CHECK(rb.size() == 0);
+}
+
+void ring_buffer_max_size_test()
+{
+  boost::asio::ring_buffer rb(16);
+
+  boost::asio::buffer_copy(rb.prepare(16),
+      boost::asio::buffer("0123456789", 10));
+  rb.commit(10);
+  BOOST_ASIO_CHECK(rb.size() == 10);
+
+  bool threw = false;
+  try
+  {
+    rb.prepare(7);
+  }
+  catch (std::length_error&)
+  {
+    threw = true;
+  }
+  BOOST_ASIO_CHECK(threw);
+
+  rb.consume(4);
+  boost::asio::buffer_copy(rb.prepare(10),
+      boost::asio::buffer("abcdefghij", 10));
+  rb.commit(10);
+  BOOST_ASIO_CHECK(rb.size() == 16);
+  BOOST_ASIO_CHECK(ring_buffer_contents(rb) == "456789abcdefghij");
+}
+
+BOOST_ASIO_TEST_SUITE
+(
+  "ring_buffer",
+  BOOST_ASIO_TEST_CASE(ring_buffer_test)
+  BOOST_ASIO_TEST_CASE(ring_buffer_wrap_test)
+  BOOST_ASIO_TEST_CASE(ring_buffer_max_size_test)
+)
@@ -166,6 +166,32 @@ void test()
     (void)static_cast<bool>(!enable_connection_aborted1);
     (void)static_cast<bool>(enable_connection_aborted1.value());
 
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+    // zero_copy class.
+
+    socket_base::zero_copy zero_copy1(true);
+    sock.set_option(zero_copy1);
+    socket_base::zero_copy zero_copy2;
+    sock.get_option(zero_copy2);
+    zero_copy1 = true;
+    (void)static_cast<bool>(zero_copy1);
+    (void)static_cast<bool>(!zero_copy1);
+    (void)static_cast<bool>(zero_copy1.value());
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+#if defined(BOOST_ASIO_HAS_SO_REUSEPORT)
+    // reuse_port class.
+
+    socket_base::reuse_port reuse_port1(true);
+    sock.set_option(reuse_port1);
+    socket_base::reuse_port reuse_port2;
+    sock.get_option(reuse_port2);
+    reuse_port1 = true;
+    (void)static_cast<bool>(reuse_port1);
+    (void)static_cast<bool>(!reuse_port1);
+    (void)static_cast<bool>(reuse_port1.value());
+#endif // defined(BOOST_ASIO_HAS_SO_REUSEPORT)
+
     // non_blocking_io class.
 
     socket_base::non_blocking_io non_blocking_io(true);
@@ -210,8 +210,113 @@ void strand_test()
   BOOST_ASIO_CHECK(count == 0);
 }
 
+void increment_and_check(strand* s, int* count, int expected)
+{
+  BOOST_ASIO_CHECK(s->running_in_this_thread());
+  BOOST_ASIO_CHECK(*count == expected);
+  ++(*count);
+}
+
+void post_increments(strand s, int* count, int n)
+{
+  for (int i = 0; i < n; ++i)
+    s.post(bindns::bind(increment, count));
+}
+
+void strand_pool_size_test()
+{
+  io_service ios;
+  strand::set_pool_size(ios, 0);
+
+  // Strands without a shared implementation are still distinct.
+  strand s1(ios);
+  strand s2(ios);
+  int count = 0;
+
+  s1.post(bindns::bind(increment_and_check, &s1, &count, 0));
+  s1.post(bindns::bind(increment_and_check, &s1, &count, 1));
+  s1.dispatch(bindns::bind(increment_and_check, &s1, &count, 2));
+
+  // No handlers can be called until run() is called.
+  BOOST_ASIO_CHECK(count == 0);
+
+  ios.run();
+
+  // The run() call will not return until all work has finished.
+  BOOST_ASIO_CHECK(count == 3);
+
+  count = 0;
+  ios.reset();
+  s2.post(bindns::bind(increment_without_lock, &s1, &count));
+
+  ios.run();
+  BOOST_ASIO_CHECK(count == 1);
+
+  // Copies refer to the same strand.
+  count = 0;
+  ios.reset();
+  {
+    strand s3(s1);
+    s3.post(bindns::bind(increment_with_lock, &s1, &count));
+  }
+
+  ios.run();
+  BOOST_ASIO_CHECK(count == 1);
+
+  // Handlers posted through a strand that has since been destroyed still run.
+  count = 0;
+  ios.reset();
+  {
+    strand s4(ios);
+    s4.post(bindns::bind(increment, &count));
+    s4.post(bindns::bind(increment, &count));
+  }
+
+  ios.run();
+  BOOST_ASIO_CHECK(count == 2);
+
+  // Handlers from several threads are all run.
+  count = 0;
+  ios.reset();
+  {
+    strand s5(ios);
+    ios.post(bindns::bind(post_increments, s5, &count, 1000));
+    ios.post(bindns::bind(post_increments, s5, &count, 1000));
+  }
+  boost::thread thread1(bindns::bind(io_service_run, &ios));
+  boost::thread thread2(bindns::bind(io_service_run, &ios));
+  thread1.join();
+  thread2.join();
+  BOOST_ASIO_CHECK(count == 2000);
+
+  // Strands constructed after the pool is re-enabled share implementations.
+  count = 0;
+  ios.reset();
+  strand::set_pool_size(ios, 1);
+  strand s6(ios);
+  strand s7(ios);
+  s6.post(bindns::bind(increment_with_lock, &s7, &count));
+
+  ios.run();
+  BOOST_ASIO_CHECK(count == 1);
+
+  // Check for clean shutdown when handlers posted through an orphaned strand
+  // are abandoned.
+  count = 0;
+  ios.reset();
+  strand::set_pool_size(ios, 0);
+  {
+    strand s8(ios);
+    s8.post(bindns::bind(increment, &count));
+  }
+
+  // No handlers can be called until run() is called.
+  BOOST_ASIO_CHECK(count == 0);
+}
+
 BOOST_ASIO_TEST_SUITE
 (
   "strand",
   BOOST_ASIO_TEST_CASE(strand_test)
+  BOOST_ASIO_TEST_CASE(strand_pool_size_test)
 )
@@ -0,0 +1,293 @@
+//
+// timer_queue_wheel.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2013 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/detail/timer_queue_wheel.hpp>
+
+#include <vector>
+#include <boost/asio/detail/cstdint.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include "unit_test.hpp"
+
+using boost::asio::int64_t;
+using boost::asio::detail::operation;
+using boost::asio::detail::op_queue;
+using boost::asio::detail::timer_queue;
+using boost::asio::detail::timer_wheel_traits;
+using boost::asio::detail::wait_op;
+
+// Time traits using a manually advanced clock. Times are in microseconds, and
+// the wheel's default resolution makes each tick one millisecond.
+struct manual_time_traits
+{
+  typedef int64_t time_type;
+  typedef int64_t duration_type;
+
+  static time_type now_;
+
+  static time_type now()
+  {
+    return now_;
+  }
+
+  static time_type add(time_type t, duration_type d)
+  {
+    return t + d;
+  }
+
+  static duration_type subtract(time_type t1, time_type t2)
+  {
+    return t1 - t2;
+  }
+
+  static bool less_than(time_type t1, time_type t2)
+  {
+    return t1 < t2;
+  }
+
+  static boost::posix_time::time_duration to_posix_duration(duration_type d)
+  {
+    return boost::posix_time::microseconds(d);
+  }
+};
+
+manual_time_traits::time_type manual_time_traits::now_ = 0;
+
+typedef timer_queue<timer_wheel_traits<manual_time_traits> > wheel_queue;
+
+const int64_t msec = 1000;
+const int64_t span = int64_t(1) << 32; // The wheel's range, in ticks.
+
+// A wait operation that records nothing itself, so that the test can inspect
+// which operations the queue hands back.
+class test_wait_op : public wait_op
+{
+public:
+  explicit test_wait_op(int id)
+    : wait_op(&test_wait_op::do_complete),
+      id_(id)
+  {
+  }
+
+  static void do_complete(boost::asio::detail::io_service_impl*,
+      operation*, const boost::system::error_code&, std::size_t)
+  {
+  }
+
+  int id_;
+};
+
+struct completion
+{
+  int id_;
+  bool aborted_;
+};
+
+// Drain a queue of operations returned by the timer queue.
+std::vector<completion> drain(op_queue<operation>& ops)
+{
+  std::vector<completion> result;
+  while (operation* op = ops.front())
+  {
+    ops.pop();
+    test_wait_op* w = static_cast<test_wait_op*>(op);
+    completion c = { w->id_,
+      w->ec_ == boost::asio::error::operation_aborted };
+    result.push_back(c);
+  }
+  return result;
+}
+
+// Advance the clock and collect the operations whose timers have expired.
+std::vector<completion> advance_to(wheel_queue& queue, int64_t time)
+{
+  manual_time_traits::now_ = time;
+  op_queue<operation> ops;
+  queue.get_ready_timers(ops);
+  return drain(ops);
+}
+
+void timer_queue_wheel_cascade_test()
+{
+  manual_time_traits::now_ = 0;
+  wheel_queue queue;
+
+  // One timer for each of the upper three levels.
+  wheel_queue::per_timer_data t1, t2, t3;
+  test_wait_op op1(1), op2(2), op3(3);
+  queue.enqueue_timer(300 * msec + 500, t1, &op1);
+  queue.enqueue_timer(70000 * msec, t2, &op2);
+  queue.enqueue_timer(20000000 * msec, t3, &op3);
+
+  // The reactor must not be told to sleep past the first expiry.
+  BOOST_ASIO_CHECK(queue.wait_duration_usec(1000000000) <= 300 * msec + 500);
+
+  BOOST_ASIO_CHECK(advance_to(queue, 256 * msec).empty());
+  BOOST_ASIO_CHECK(advance_to(queue, 300 * msec).empty());
+  BOOST_ASIO_CHECK(advance_to(queue, 300 * msec + 499).empty());
+
+  std::vector<completion> c = advance_to(queue, 300 * msec + 500);
+  BOOST_ASIO_CHECK(c.size() == 1);
+  BOOST_ASIO_CHECK(c.size() == 1 && c[0].id_ == 1 && !c[0].aborted_);
+
+  BOOST_ASIO_CHECK(advance_to(queue, 65536 * msec).empty());
+  BOOST_ASIO_CHECK(advance_to(queue, 69999 * msec).empty());
+  c = advance_to(queue, 70000 * msec);
+  BOOST_ASIO_CHECK(c.size() == 1 && c[0].id_ == 2);
+
+  BOOST_ASIO_CHECK(advance_to(queue, 16777216 * msec).empty());
+  BOOST_ASIO_CHECK(advance_to(queue, 20000000 * msec - 1).empty());
+  c = advance_to(queue, 20000000 * msec);
+  BOOST_ASIO_CHECK(c.size() == 1 && c[0].id_ == 3);
+
+  BOOST_ASIO_CHECK(queue.empty());
+}
+
+void timer_queue_wheel_jump_test()
+{
+  manual_time_traits::now_ = 0;
+  wheel_queue queue;
+
+  wheel_queue::per_timer_data t1, t2, t3;
+  test_wait_op op1(1), op2(2), op3(3);
+  queue.enqueue_timer(20000000 * msec, t3, &op3);
+  queue.enqueue_timer(300 * msec, t1, &op1);
+  queue.enqueue_timer(70000 * msec, t2, &op2);
+
+  // Jumping over several levels at once must still deliver every timer, in
+  // expiry order.
+  std::vector<completion> c = advance_to(queue, 30000000 * msec);
+  BOOST_ASIO_CHECK(c.size() == 3);
+  BOOST_ASIO_CHECK(c.size() == 3
+      && c[0].id_ == 1 && c[1].id_ == 2 && c[2].id_ == 3);
+
+  BOOST_ASIO_CHECK(queue.empty());
+}
+
+void timer_queue_wheel_beyond_span_test()
+{
+  manual_time_traits::now_ = 0;
+  wheel_queue queue;
+
+  // Timers further away than the wheel's range are parked in its last slot.
+  wheel_queue::per_timer_data t1, t2;
+  test_wait_op op1(1), op2(2);
+  queue.enqueue_timer((span + 1000) * msec, t1, &op1);
+  queue.enqueue_timer(2 * span * msec + 7, t2, &op2);
+
+  BOOST_ASIO_CHECK(!queue.empty());
+  BOOST_ASIO_CHECK(advance_to(queue, (span - 1) * msec).empty());
+  BOOST_ASIO_CHECK(advance_to(queue, span * msec).empty());
+  BOOST_ASIO_CHECK(advance_to(queue, (span + 1000) * msec - 1).empty());
+
+  std::vector<completion> c = advance_to(queue, (span + 1000) * msec);
+  BOOST_ASIO_CHECK(c.size() == 1 && c[0].id_ == 1);
+
+  // The second timer needs to be parked twice before it expires.
+  BOOST_ASIO_CHECK(advance_to(queue, (2 * span - 1) * msec).empty());
+  BOOST_ASIO_CHECK(advance_to(queue, 2 * span * msec + 6).empty());
+  c = advance_to(queue, 2 * span * msec + 7);
+  BOOST_ASIO_CHECK(c.size() == 1 && c[0].id_ == 2);
+
+  BOOST_ASIO_CHECK(queue.empty());
+}
+
+void timer_queue_wheel_cancel_test()
+{
+  manual_time_traits::now_ = 0;
+  wheel_queue queue;
+
+  // Two timers sharing a level 2 slot, and one in level 3.
+  wheel_queue::per_timer_data t1, t2, t3;
+  test_wait_op op1(1), op2(2), op3(3);
+  queue.enqueue_timer(100000 * msec, t1, &op1);
+  queue.enqueue_timer(100001 * msec, t2, &op2);
+  queue.enqueue_timer(20000000 * msec, t3, &op3);
+
+  op_queue<operation> ops;
+  BOOST_ASIO_CHECK(queue.cancel_timer(t3, ops) == 1);
+  std::vector<completion> c = drain(ops);
+  BOOST_ASIO_CHECK(c.size() == 1 && c[0].id_ == 3 && c[0].aborted_);
+
+  BOOST_ASIO_CHECK(queue.cancel_timer(t1, ops) == 1);
+  c = drain(ops);
+  BOOST_ASIO_CHECK(c.size() == 1 && c[0].id_ == 1 && c[0].aborted_);
+
+  // Cancelling a timer that is no longer queued has no effect.
+  BOOST_ASIO_CHECK(queue.cancel_timer(t3, ops) == 0);
+  BOOST_ASIO_CHECK(ops.empty());
+
+  c = advance_to(queue, 100001 * msec);
+  BOOST_ASIO_CHECK(c.size() == 1 && c[0].id_ == 2 && !c[0].aborted_);
+  BOOST_ASIO_CHECK(queue.empty());
+  BOOST_ASIO_CHECK(advance_to(queue, 30000000 * msec).empty());
+
+  // Cancel a timer after it has cascaded down from a higher level.
+  wheel_queue::per_timer_data t4;
+  test_wait_op op4(4);
+  queue.enqueue_timer(31000000 * msec, t4, &op4);
+  BOOST_ASIO_CHECK(advance_to(queue, 30999000 * msec).empty());
+  BOOST_ASIO_CHECK(queue.cancel_timer(t4, ops) == 1);
+  c = drain(ops);
+  BOOST_ASIO_CHECK(c.size() == 1 && c[0].id_ == 4 && c[0].aborted_);
+  BOOST_ASIO_CHECK(queue.empty());
+  BOOST_ASIO_CHECK(advance_to(queue, 40000000 * msec).empty());
+}
+
+void timer_queue_wheel_sub_tick_test()
+{
+  manual_time_traits::now_ = 0;
+  wheel_queue queue;
+
+  // Timers within the same tick, added out of order.
+  wheel_queue::per_timer_data t1, t2, t3, t4, t5;
+  test_wait_op op1(1), op2(2), op3(3), op4(4), op5(5);
+  queue.enqueue_timer(5 * msec + 900, t4, &op4);
+  queue.enqueue_timer(5 * msec + 100, t1, &op1);
+  queue.enqueue_timer(5 * msec + 500, t3, &op3);
+  queue.enqueue_timer(5 * msec + 300, t2, &op2);
+  queue.enqueue_timer(6 * msec + 200, t5, &op5);
+
+  // No timer may fire before its expiry time, even once its tick is reached.
+  BOOST_ASIO_CHECK(advance_to(queue, 5 * msec).empty());
+
+  std::vector<completion> c = advance_to(queue, 5 * msec + 400);
+  BOOST_ASIO_CHECK(c.size() == 2);
+  BOOST_ASIO_CHECK(c.size() == 2 && c[0].id_ == 1 && c[1].id_ == 2);
+
+  // The reactor must wake for the next timer in the heap, not the next tick.
+  BOOST_ASIO_CHECK(queue.wait_duration_usec(1000000) == 100);
+
+  c = advance_to(queue, 5 * msec + 500);
+  BOOST_ASIO_CHECK(c.size() == 1 && c[0].id_ == 3);
+
+  // Timers from successive ticks are merged in expiry order.
+  c = advance_to(queue, 7 * msec);
+  BOOST_ASIO_CHECK(c.size() == 2);
+  BOOST_ASIO_CHECK(c.size() == 2 && c[0].id_ == 4 && c[1].id_ == 5);
+
+  BOOST_ASIO_CHECK(queue.empty());
+}
+
+BOOST_ASIO_TEST_SUITE
+(
+  "timer_queue_wheel",
+  BOOST_ASIO_TEST_CASE(timer_queue_wheel_cascade_test)
+  BOOST_ASIO_TEST_CASE(timer_queue_wheel_jump_test)
+  BOOST_ASIO_TEST_CASE(timer_queue_wheel_beyond_span_test)
+  BOOST_ASIO_TEST_CASE(timer_queue_wheel_cancel_test)
+  BOOST_ASIO_TEST_CASE(timer_queue_wheel_sub_tick_test)
+)
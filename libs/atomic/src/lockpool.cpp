@@ -1,13 +1,30 @@
 #include <cstddef>
 #include <boost/config.hpp>
+#include <boost/static_assert.hpp>
 #include <boost/atomic.hpp>
 
+#if defined(BOOST_ATOMIC_FLAG_LOCK_FREE)
+#include <boost/smart_ptr/detail/yield_k.hpp>
+#if defined(__linux__) && !defined(BOOST_ATOMIC_NO_FUTEX) && defined(__ATOMIC_ACQUIRE) && defined(BOOST_ATOMIC_INT_LOCK_FREE) && BOOST_ATOMIC_INT_LOCK_FREE == 2
+#define BOOST_ATOMIC_USE_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#endif
+
 //  Copyright (c) 2011 Helge Bahmann
 //
 //  Distributed under the Boost Software License, Version 1.0.
 //  See accompanying file LICENSE_1_0.txt or copy at
 //  http://www.boost.org/LICENSE_1_0.txt)
 
+// The number of locks in the pool. Objects are distributed among the locks by their address, so a larger pool
+// reduces the probability that unrelated atomic objects contend for the same lock. Must be a power of two.
+#if !defined(BOOST_ATOMIC_LOCK_POOL_SIZE)
+#define BOOST_ATOMIC_LOCK_POOL_SIZE 1024
+#endif
+
 namespace boost {
 namespace atomics {
 namespace detail {
@@ -28,28 +45,158 @@ struct padding< 0 >
 {
 };
 
+template< std::size_t N >
+struct log2_of
+{
+    static const unsigned int value = 1u + log2_of< N / 2u >::value;
+};
+template< >
+struct log2_of< 1u >
+{
+    static const unsigned int value = 0u;
+};
+
+BOOST_STATIC_ASSERT_MSG(BOOST_ATOMIC_LOCK_POOL_SIZE > 0 && (BOOST_ATOMIC_LOCK_POOL_SIZE & (BOOST_ATOMIC_LOCK_POOL_SIZE - 1)) == 0,
+    "BOOST_ATOMIC_LOCK_POOL_SIZE must be a power of two");
+
+#if !defined(BOOST_ATOMIC_FLAG_LOCK_FREE)
+
+typedef boost::detail::lightweight_mutex lock_type;
+
+#elif defined(BOOST_ATOMIC_USE_FUTEX)
+
+// The lock word is 0 if the lock is free, 1 if it is locked and 2 if it is locked and there may be threads
+// sleeping on the futex, which have to be woken up on unlock. The word is a plain int operated on with the
+// compiler builtins rather than atomic< int >: a translation unit built with BOOST_ATOMIC_FORCE_FALLBACK would
+// otherwise emit a lock based atomic< int > under the same name, which would itself take locks from this pool.
+typedef int lock_type;
+
+#else
+
+typedef atomic_flag lock_type;
+
+#endif
+
 struct BOOST_ALIGNMENT(BOOST_ATOMIC_CACHE_LINE_SIZE) padded_lock
 {
-    lockpool::lock_type lock;
+    lock_type lock;
     // The additional padding is needed to avoid false sharing between locks
-    enum { padding_size = (sizeof(lockpool::lock_type) <= BOOST_ATOMIC_CACHE_LINE_SIZE ?
-        (BOOST_ATOMIC_CACHE_LINE_SIZE - sizeof(lockpool::lock_type)) :
-        (BOOST_ATOMIC_CACHE_LINE_SIZE - sizeof(lockpool::lock_type) % BOOST_ATOMIC_CACHE_LINE_SIZE)) };
+    enum { padding_size = (sizeof(lock_type) <= BOOST_ATOMIC_CACHE_LINE_SIZE ?
+        (BOOST_ATOMIC_CACHE_LINE_SIZE - sizeof(lock_type)) :
+        (BOOST_ATOMIC_CACHE_LINE_SIZE - sizeof(lock_type) % BOOST_ATOMIC_CACHE_LINE_SIZE)) };
     padding< padding_size > pad;
 };
 
-static padded_lock lock_pool_[41];
+static padded_lock lock_pool_[BOOST_ATOMIC_LOCK_POOL_SIZE];
+
+// Fibonacci hashing of the object address. Taking the upper bits of the product makes the index depend on all
+// bits of the address, so objects laid out with a power of two stride are still spread across the whole pool.
+inline padded_lock& get_lock_for(const volatile void* addr)
+{
+    const std::size_t multiplier = sizeof(std::size_t) > 4u ?
+        static_cast< std::size_t >(UINT64_C(0x9E3779B97F4A7C15)) : static_cast< std::size_t >(0x9E3779B9u);
+    const unsigned int shift = sizeof(std::size_t) * 8u - log2_of< BOOST_ATOMIC_LOCK_POOL_SIZE >::value;
+    const std::size_t hash = reinterpret_cast< std::size_t >(addr) * multiplier;
+    return lock_pool_[shift < sizeof(std::size_t) * 8u ? (hash >> shift) : 0u];
+}
+
+#if defined(BOOST_ATOMIC_FLAG_LOCK_FREE)
+
+// The number of pause iterations after which a contended lock stops spinning on the CPU
+const unsigned int max_spin_count = 64u;
+
+inline void pause_for(unsigned int count)
+{
+    for (unsigned int i = 0; i < count; ++i)
+    {
+#if defined(BOOST_ATOMIC_X86_PAUSE)
+        BOOST_ATOMIC_X86_PAUSE();
+#else
+        atomic_signal_fence(memory_order_seq_cst);
+#endif
+    }
+}
+
+#endif // defined(BOOST_ATOMIC_FLAG_LOCK_FREE)
 
 } // namespace
 
 
-// NOTE: This function must NOT be inline. Otherwise MSVC 9 will sometimes generate broken code for modulus operation which result in crashes.
+#if !defined(BOOST_ATOMIC_FLAG_LOCK_FREE)
+
 BOOST_ATOMIC_DECL lockpool::lock_type& lockpool::get_lock_for(const volatile void* addr)
 {
-    std::size_t index = reinterpret_cast<std::size_t>(addr) % (sizeof(lock_pool_) / sizeof(*lock_pool_));
-    return lock_pool_[index].lock;
+    return detail::get_lock_for(addr).lock;
+}
+
+#elif defined(BOOST_ATOMIC_USE_FUTEX)
+
+BOOST_ATOMIC_DECL void* lockpool::lock_for(const volatile void* addr)
+{
+    lock_type& lock = detail::get_lock_for(addr).lock;
+
+    int state = 0;
+    if (__atomic_compare_exchange_n(&lock, &state, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        return &lock;
+
+    // Critical sections guarded by the pool are tiny, so spin for a while with exponential backoff,
+    // only looking at the lock word until it is observed free
+    for (unsigned int spin_count = 1u; spin_count <= max_spin_count; spin_count *= 2u)
+    {
+        pause_for(spin_count);
+        state = 0;
+        if (__atomic_load_n(&lock, __ATOMIC_RELAXED) == 0 &&
+            __atomic_compare_exchange_n(&lock, &state, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+            return &lock;
+        }
+    }
+
+    // The owner is probably preempted, so sleep in the kernel. The lock is taken in the contended state, since
+    // we cannot know whether there are other sleeping threads left.
+    while (__atomic_exchange_n(&lock, 2, __ATOMIC_ACQUIRE) != 0)
+        ::syscall(SYS_futex, &lock, FUTEX_WAIT_PRIVATE, 2, 0, 0, 0);
+
+    return &lock;
 }
 
+BOOST_ATOMIC_DECL void lockpool::unlock(void* p)
+{
+    lock_type& lock = *static_cast< lock_type* >(p);
+    if (__atomic_exchange_n(&lock, 0, __ATOMIC_RELEASE) == 2)
+        ::syscall(SYS_futex, &lock, FUTEX_WAKE_PRIVATE, 1, 0, 0, 0);
+}
+
+#else
+
+BOOST_ATOMIC_DECL void* lockpool::lock_for(const volatile void* addr)
+{
+    lock_type& lock = detail::get_lock_for(addr).lock;
+
+    for (unsigned int spin_count = 1u; lock.test_and_set(memory_order_acquire); )
+    {
+        if (spin_count <= max_spin_count)
+        {
+            pause_for(spin_count);
+            spin_count *= 2u;
+        }
+        else
+        {
+            // Give up the time slice or sleep, the owner is probably preempted
+            boost::detail::yield(32u);
+        }
+    }
+
+    return &lock;
+}
+
+BOOST_ATOMIC_DECL void lockpool::unlock(void* p)
+{
+    static_cast< lock_type* >(p)->clear(memory_order_release);
+}
+
+#endif
+
 }
 }
 }
@@ -0,0 +1,76 @@
+//  Copyright (c) 2011 Helge Bahmann
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Let several threads modify an array of atomic objects, which are too
+//  large to be lock-free, and verify that the locks of the lock pool
+//  provide mutual exclusion, also when the threads are forced to sleep
+//  on a contended lock.
+
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+#include <boost/test/minimal.hpp>
+
+/* three words, so that it cannot be implemented by any native instruction */
+struct counter
+{
+    unsigned long first;
+    unsigned long second;
+    unsigned long third;
+};
+
+static const unsigned int thread_count = 4;
+static const unsigned int counter_count = 257;
+static const unsigned int iterations = 20000;
+
+static boost::atomic<counter> counters[counter_count];
+static boost::atomic<bool> torn(false);
+
+static void
+increment_counters(unsigned int instance)
+{
+    for (unsigned int n = 0; n < iterations; ++n) {
+        boost::atomic<counter> & c = counters[(n * 7 + instance) % counter_count];
+
+        counter expected = c.load(boost::memory_order_relaxed);
+        counter desired;
+        do {
+            if (expected.first != expected.second || expected.second != expected.third)
+                torn.store(true, boost::memory_order_relaxed);
+
+            desired.first = desired.second = desired.third = expected.first + 1;
+        } while (!c.compare_exchange_weak(expected, desired));
+
+        if ((n & 1023) == 0)
+            boost::this_thread::yield();
+    }
+}
+
+int test_main(int, char *[])
+{
+    BOOST_CHECK(!counters[0].is_lock_free());
+
+    counter zero = {0, 0, 0};
+    for (unsigned int i = 0; i < counter_count; ++i)
+        counters[i].store(zero);
+
+    boost::thread_group threads;
+    for (unsigned int i = 0; i < thread_count; ++i)
+        threads.create_thread(boost::bind(&increment_counters, i));
+    threads.join_all();
+
+    unsigned long sum = 0;
+    for (unsigned int i = 0; i < counter_count; ++i) {
+        counter c = counters[i].load();
+        BOOST_CHECK(c.first == c.second && c.second == c.third);
+        sum += c.first;
+    }
+
+    BOOST_CHECK(!torn.load());
+    BOOST_CHECK(sum == thread_count * iterations);
+
+    return 0;
+}
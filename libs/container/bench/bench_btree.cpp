@@ -0,0 +1,148 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2013. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//Compares btree_map with map and flat_map for a big map with random keys:
+//construction, lookups, in-order traversal and erasure of half of the keys.
+
+#include "boost/container/btree_map.hpp"
+#include "boost/container/flat_map.hpp"
+#include "boost/container/map.hpp"
+#include <boost/timer/timer.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+using boost::timer::cpu_timer;
+using boost::timer::cpu_times;
+
+#ifdef NDEBUG
+static const std::size_t NumElements = 1000000;
+#else
+static const std::size_t NumElements = 10000;
+#endif
+
+typedef std::pair<int, int> value_t;
+
+typedef boost::container::btree_map<int, int>   btree_map_t;
+typedef boost::container::map<int, int>         map_t;
+typedef boost::container::flat_map<int, int>    flat_map_t;
+
+std::vector<value_t> make_values()
+{
+   std::srand(0);
+   std::vector<value_t> values(NumElements);
+   for(std::size_t i = 0; i != NumElements; ++i){
+      values[i] = value_t(std::rand(), int(i));
+   }
+   return values;
+}
+
+bool key_less(const value_t &a, const value_t &b)
+{  return a.first < b.first;  }
+
+bool key_equal(const value_t &a, const value_t &b)
+{  return a.first == b.first;  }
+
+template<class Map>
+void fill(Map &m, const std::vector<value_t> &values)
+{  m.insert(values.begin(), values.end());  }
+
+//Inserting unordered elements in a flat_map takes quadratic time, so values
+//are sorted first, keeping the first value of each key like the other maps
+void fill(flat_map_t &m, const std::vector<value_t> &values)
+{
+   std::vector<value_t> sorted(values);
+   std::stable_sort(sorted.begin(), sorted.end(), key_less);
+   sorted.erase(std::unique(sorted.begin(), sorted.end(), key_equal), sorted.end());
+   m.insert(boost::container::ordered_unique_range, sorted.begin(), sorted.end());
+}
+
+//flat_map erases in linear time, so erasing half of the keys is only done with
+//the node based maps
+template<class Map>
+cpu_times time_it(const std::vector<value_t> &values, bool erase)
+{
+   cpu_timer construct_time, lookup_time, traverse_time, erase_time;
+   lookup_time.stop(); traverse_time.stop(); erase_time.stop();
+   cpu_timer total_time;
+   int sum = 0;
+   {
+      Map m;
+      fill(m, values);
+      construct_time.stop();
+
+      lookup_time.resume();
+      for(std::size_t i = 0; i != NumElements; ++i){
+         typename Map::const_iterator it = m.find(values[i].first);
+         sum += it->second;
+      }
+      lookup_time.stop();
+
+      traverse_time.resume();
+      for(typename Map::const_iterator it = m.begin(), itend = m.end(); it != itend; ++it){
+         sum += it->second;
+      }
+      traverse_time.stop();
+
+      if(erase){
+         erase_time.resume();
+         for(std::size_t i = 0; i < NumElements; i += 2){
+            m.erase(values[i].first);
+         }
+         erase_time.stop();
+      }
+      sum += int(m.size());
+   }
+   total_time.stop();
+   std::cout << "  construction took " << boost::timer::format(construct_time.elapsed());
+   std::cout << "  lookup took       " << boost::timer::format(lookup_time.elapsed());
+   std::cout << "  traversal took    " << boost::timer::format(traverse_time.elapsed());
+   if(erase){
+      std::cout << "  erasure took      " << boost::timer::format(erase_time.elapsed());
+   }
+   std::cout << "  Total time =      " << boost::timer::format(total_time.elapsed());
+   std::cout << "  (sum = " << sum << ")\n" << std::endl;
+   return total_time.elapsed();
+}
+
+void compare_times(cpu_times time_numerator, cpu_times time_denominator){
+   std::cout
+   << "\n  wall        = " << ((double)time_numerator.wall/(double)time_denominator.wall)
+   << "\n  user        = " << ((double)time_numerator.user/(double)time_denominator.user)
+   << "\n  system      = " << ((double)time_numerator.system/(double)time_denominator.system)
+   << "\n  (user+system) = " << ((double)(time_numerator.system+time_numerator.user)/(double)(time_denominator.system+time_denominator.user)) << "\n\n";
+}
+
+int main()
+{
+   const std::vector<value_t> values = make_values();
+   std::cout << "NumElements = " << NumElements << "\n\n";
+
+   std::cout << "boost::container::btree_map benchmark" << std::endl;
+   cpu_times time_btree_map = time_it<btree_map_t>(values, true);
+
+   std::cout << "boost::container::map benchmark" << std::endl;
+   cpu_times time_map = time_it<map_t>(values, true);
+
+   std::cout << "boost::container::btree_map benchmark without erasure" << std::endl;
+   cpu_times time_btree_map_noerase = time_it<btree_map_t>(values, false);
+
+   std::cout << "boost::container::flat_map benchmark without erasure" << std::endl;
+   cpu_times time_flat_map = time_it<flat_map_t>(values, false);
+
+   std::cout << "btree_map/map total time comparison:";
+   compare_times(time_btree_map, time_map);
+
+   std::cout << "btree_map/flat_map total time comparison (without erasure):";
+   compare_times(time_btree_map_noerase, time_flat_map);
+   return 0;
+}
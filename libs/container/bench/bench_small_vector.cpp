@@ -0,0 +1,151 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2013. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+//Compares small_vector with vector and static_vector when a program creates
+//many containers that hold a few elements, like the child lists of the
+//nodes of a syntax tree: most containers hold less than 8 elements, and
+//a few hold more.
+
+#include "boost/container/small_vector.hpp"
+#include "boost/container/static_vector.hpp"
+#include "boost/container/vector.hpp"
+#include <boost/timer/timer.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using boost::timer::cpu_timer;
+using boost::timer::cpu_times;
+
+#ifdef NDEBUG
+static const std::size_t NumContainers = 1000000;
+#else
+static const std::size_t NumContainers = 10000;
+#endif
+
+//Elements stored without allocating in small_vector and static_vector
+static const std::size_t InlineElements = 8;
+
+//static_vector can't grow, so it is only used in the small test
+static const std::size_t MaxSmallSize = InlineElements;
+static const std::size_t MaxMixedSize = 4*InlineElements;
+
+typedef int value_t;
+
+//Returns the sizes of the containers: uniform in [0, InlineElements),
+//and for the mixed test, one container out of 16 is larger
+std::vector<std::size_t> make_sizes(std::size_t max_size)
+{
+   std::srand(0);
+   std::vector<std::size_t> sizes(NumContainers);
+   for(std::size_t i = 0; i != NumContainers; ++i){
+      sizes[i] = std::size_t(std::rand()) % InlineElements;
+      if(max_size > InlineElements && (std::rand() % 16) == 0){
+         sizes[i] = InlineElements + std::size_t(std::rand()) % (max_size - InlineElements);
+      }
+   }
+   return sizes;
+}
+
+template<class Vector>
+cpu_times time_it(const std::vector<std::size_t> &sizes)
+{
+   cpu_timer construct_time, traverse_time, destruction_time;
+   traverse_time.stop(); destruction_time.stop();
+   cpu_timer total_time;
+   value_t sum = 0;
+   {
+      //The containers are owned by a vector, like the nodes of a tree owned by an arena
+      boost::container::vector<Vector> containers(NumContainers);
+      for(std::size_t i = 0; i != NumContainers; ++i){
+         Vector &v = containers[i];
+         for(std::size_t j = 0, max = sizes[i]; j != max; ++j){
+            v.push_back(value_t(j));
+         }
+      }
+      construct_time.stop();
+
+      traverse_time.resume();
+      for(std::size_t i = 0; i != NumContainers; ++i){
+         const Vector &v = containers[i];
+         for(typename Vector::const_iterator it = v.begin(), itend = v.end(); it != itend; ++it){
+            sum += *it;
+         }
+      }
+      traverse_time.stop();
+      destruction_time.resume();
+   }
+   destruction_time.stop();
+   total_time.stop();
+   std::cout << "  construction took " << boost::timer::format(construct_time.elapsed());
+   std::cout << "  traversal took    " << boost::timer::format(traverse_time.elapsed());
+   std::cout << "  destruction took  " << boost::timer::format(destruction_time.elapsed());
+   std::cout << "  Total time =      " << boost::timer::format(total_time.elapsed());
+   std::cout << "  (sum = " << sum << ")\n" << std::endl;
+   return total_time.elapsed();
+}
+
+void compare_times(cpu_times time_numerator, cpu_times time_denominator){
+   std::cout
+   << "\n  wall        = " << ((double)time_numerator.wall/(double)time_denominator.wall)
+   << "\n  user        = " << ((double)time_numerator.user/(double)time_denominator.user)
+   << "\n  system      = " << ((double)time_numerator.system/(double)time_denominator.system)
+   << "\n  (user+system) = " << ((double)(time_numerator.system+time_numerator.user)/(double)(time_denominator.system+time_denominator.user)) << "\n\n";
+}
+
+int main()
+{
+   typedef boost::container::small_vector<value_t, InlineElements>   small_vector_t;
+   typedef boost::container::static_vector<value_t, MaxSmallSize>    static_vector_t;
+   typedef boost::container::vector<value_t>                         vector_t;
+   typedef std::vector<value_t>                                      std_vector_t;
+
+   std::cout << "NumContainers = " << NumContainers << ", InlineElements = " << InlineElements << "\n\n";
+
+   {
+      const std::vector<std::size_t> sizes = make_sizes(MaxSmallSize);
+      std::cout << "Containers with less than " << InlineElements << " elements\n" << std::endl;
+
+      std::cout << "boost::container::small_vector benchmark" << std::endl;
+      cpu_times time_small_vector = time_it<small_vector_t>(sizes);
+
+      std::cout << "boost::container::static_vector benchmark" << std::endl;
+      cpu_times time_static_vector = time_it<static_vector_t>(sizes);
+
+      std::cout << "boost::container::vector benchmark" << std::endl;
+      cpu_times time_vector = time_it<vector_t>(sizes);
+
+      std::cout << "std::vector benchmark" << std::endl;
+      cpu_times time_std_vector = time_it<std_vector_t>(sizes);
+
+      std::cout << "small_vector/boost::container::vector total time comparison:";
+      compare_times(time_small_vector, time_vector);
+
+      std::cout << "small_vector/boost::container::static_vector total time comparison:";
+      compare_times(time_small_vector, time_static_vector);
+
+      std::cout << "small_vector/std::vector total time comparison:";
+      compare_times(time_small_vector, time_std_vector);
+   }
+   {
+      const std::vector<std::size_t> sizes = make_sizes(MaxMixedSize);
+      std::cout << "Containers with up to " << MaxMixedSize << " elements\n" << std::endl;
+
+      std::cout << "boost::container::small_vector benchmark" << std::endl;
+      cpu_times time_small_vector = time_it<small_vector_t>(sizes);
+
+      std::cout << "boost::container::vector benchmark" << std::endl;
+      cpu_times time_vector = time_it<vector_t>(sizes);
+
+      std::cout << "small_vector/boost::container::vector total time comparison:";
+      compare_times(time_small_vector, time_vector);
+   }
+   return 0;
+}
@@ -0,0 +1,727 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2013. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#include <boost/container/detail/config_begin.hpp>
+#include <set>
+#include <map>
+#include <cstdlib>
+#include <boost/container/btree_set.hpp>
+#include <boost/container/btree_map.hpp>
+#include "print_container.hpp"
+#include "dummy_test_allocator.hpp"
+#include "movable_int.hpp"
+#include "set_test.hpp"
+#include "map_test.hpp"
+#include "propagate_allocator_test.hpp"
+#include "emplace_test.hpp"
+#include <boost/container/detail/btree.hpp>
+
+using namespace boost::container;
+
+namespace boost {
+namespace container {
+
+//Explicit instantiation to detect compilation errors
+
+//btree_map
+template class btree_map
+   < test::movable_and_copyable_int
+   , test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , test::dummy_test_allocator
+      < std::pair<test::movable_and_copyable_int, test::movable_and_copyable_int> >
+   >;
+
+template class btree_map
+   < test::movable_and_copyable_int
+   , test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , test::simple_allocator
+      < std::pair<test::movable_and_copyable_int, test::movable_and_copyable_int> >
+   >;
+
+template class btree_map
+   < test::movable_and_copyable_int
+   , test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , std::allocator
+      < std::pair<test::movable_and_copyable_int, test::movable_and_copyable_int> >
+   >;
+
+//btree_multimap
+template class btree_multimap
+   < test::movable_and_copyable_int
+   , test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , test::dummy_test_allocator
+      < std::pair<test::movable_and_copyable_int, test::movable_and_copyable_int> >
+   >;
+
+template class btree_multimap
+   < test::movable_and_copyable_int
+   , test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , test::simple_allocator
+      < std::pair<test::movable_and_copyable_int, test::movable_and_copyable_int> >
+   >;
+
+template class btree_multimap
+   < test::movable_and_copyable_int
+   , test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , std::allocator
+      < std::pair<test::movable_and_copyable_int, test::movable_and_copyable_int> >
+   >;
+//btree_set
+template class btree_set
+   < test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , test::dummy_test_allocator<test::movable_and_copyable_int>
+   >;
+
+template class btree_set
+   < test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , test::simple_allocator<test::movable_and_copyable_int>
+   >;
+
+template class btree_set
+   < test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , std::allocator<test::movable_and_copyable_int>
+   >;
+
+//btree_multiset
+template class btree_multiset
+   < test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , test::dummy_test_allocator<test::movable_and_copyable_int>
+   >;
+
+template class btree_multiset
+   < test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , test::simple_allocator<test::movable_and_copyable_int>
+   >;
+
+template class btree_multiset
+   < test::movable_and_copyable_int
+   , std::less<test::movable_and_copyable_int>
+   , std::allocator<test::movable_and_copyable_int>
+   >;
+
+//btree iterators
+template class container_detail::btree_iterator
+   < container_detail::btree_node<int, void*>*, int, false>;
+template class container_detail::btree_iterator
+   < container_detail::btree_node<int, void*>*, int, true>;
+
+}} //boost::container
+
+
+//Alias allocator type
+typedef std::allocator<int> allocator_t;
+typedef std::allocator<test::movable_int>
+   movable_allocator_t;
+typedef std::allocator<std::pair<int, int> >
+   pair_allocator_t;
+typedef std::allocator<std::pair<test::movable_int, test::movable_int> >
+   movable_pair_allocator_t;
+typedef std::allocator<test::movable_and_copyable_int >
+   move_copy_allocator_t;
+typedef std::allocator<std::pair<test::movable_and_copyable_int, test::movable_and_copyable_int> >
+   move_copy_pair_allocator_t;
+typedef std::allocator<test::copyable_int >
+   copy_allocator_t;
+typedef std::allocator<std::pair<test::copyable_int, test::copyable_int> >
+   copy_pair_allocator_t;
+
+
+//Alias set types
+typedef std::set<int>                                                   MyStdSet;
+typedef std::multiset<int>                                              MyStdMultiSet;
+typedef std::map<int, int>                                              MyStdMap;
+typedef std::multimap<int, int>                                         MyStdMultiMap;
+
+typedef btree_set<int, std::less<int>, allocator_t>                MyBoostSet;
+typedef btree_multiset<int, std::less<int>, allocator_t>           MyBoostMultiSet;
+typedef btree_map<int, int, std::less<int>, pair_allocator_t>      MyBoostMap;
+typedef btree_multimap<int, int, std::less<int>, pair_allocator_t> MyBoostMultiMap;
+
+typedef btree_set<test::movable_int, std::less<test::movable_int>
+                ,movable_allocator_t>                             MyMovableBoostSet;
+typedef btree_multiset<test::movable_int,std::less<test::movable_int>
+                     ,movable_allocator_t>                        MyMovableBoostMultiSet;
+typedef btree_map<test::movable_int, test::movable_int
+                ,std::less<test::movable_int>
+                ,movable_pair_allocator_t>                        MyMovableBoostMap;
+typedef btree_multimap<test::movable_int, test::movable_int
+                ,std::less<test::movable_int>
+                ,movable_pair_allocator_t>                        MyMovableBoostMultiMap;
+
+typedef btree_set<test::movable_and_copyable_int, std::less<test::movable_and_copyable_int>
+                ,move_copy_allocator_t>                             MyMoveCopyBoostSet;
+typedef btree_multiset<test::movable_and_copyable_int,std::less<test::movable_and_copyable_int>
+                     ,move_copy_allocator_t>                        MyMoveCopyBoostMultiSet;
+typedef btree_map<test::movable_and_copyable_int, test::movable_and_copyable_int
+                ,std::less<test::movable_and_copyable_int>
+                ,move_copy_pair_allocator_t>                        MyMoveCopyBoostMap;
+typedef btree_multimap<test::movable_and_copyable_int, test::movable_and_copyable_int
+                ,std::less<test::movable_and_copyable_int>
+                ,move_copy_pair_allocator_t>                        MyMoveCopyBoostMultiMap;
+
+typedef btree_set<test::copyable_int, std::less<test::copyable_int>
+                ,copy_allocator_t>                             MyCopyBoostSet;
+typedef btree_multiset<test::copyable_int,std::less<test::copyable_int>
+                     ,copy_allocator_t>                        MyCopyBoostMultiSet;
+typedef btree_map<test::copyable_int, test::copyable_int
+                ,std::less<test::copyable_int>
+                ,copy_pair_allocator_t>                        MyCopyBoostMap;
+typedef btree_multimap<test::copyable_int, test::copyable_int
+                ,std::less<test::copyable_int>
+                ,copy_pair_allocator_t>                        MyCopyBoostMultiMap;
+
+
+//Test recursive structures
+class recursive_btree_set
+{
+   public:
+   recursive_btree_set(const recursive_btree_set &c)
+      : id_(c.id_), btree_set_(c.btree_set_)
+   {}
+
+   recursive_btree_set & operator =(const recursive_btree_set &c)
+   {
+      id_ = c.id_;
+      btree_set_= c.btree_set_;
+      return *this;
+   }
+   int id_;
+   btree_set<recursive_btree_set> btree_set_;
+   friend bool operator< (const recursive_btree_set &a, const recursive_btree_set &b)
+   {  return a.id_ < b.id_;   }
+};
+
+
+
+class recursive_btree_map
+{
+   public:
+   recursive_btree_map(const recursive_btree_map &c)
+      : id_(c.id_), map_(c.map_)
+   {}
+
+   recursive_btree_map & operator =(const recursive_btree_map &c)
+   {
+      id_ = c.id_;
+      map_= c.map_;
+      return *this;
+   }
+
+   int id_;
+   btree_map<recursive_btree_map, recursive_btree_map> map_;
+
+   friend bool operator< (const recursive_btree_map &a, const recursive_btree_map &b)
+   {  return a.id_ < b.id_;   }
+};
+
+//Test recursive structures
+class recursive_btree_multiset
+{
+   public:
+   recursive_btree_multiset(const recursive_btree_multiset &c)
+      : id_(c.id_), btree_multiset_(c.btree_multiset_)
+   {}
+
+   recursive_btree_multiset & operator =(const recursive_btree_multiset &c)
+   {
+      id_ = c.id_;
+      btree_multiset_= c.btree_multiset_;
+      return *this;
+   }
+   int id_;
+   btree_multiset<recursive_btree_multiset> btree_multiset_;
+   friend bool operator< (const recursive_btree_multiset &a, const recursive_btree_multiset &b)
+   {  return a.id_ < b.id_;   }
+};
+
+class recursive_btree_multimap
+{
+public:
+   recursive_btree_multimap(const recursive_btree_multimap &c)
+      : id_(c.id_), map_(c.map_)
+   {}
+
+   recursive_btree_multimap & operator =(const recursive_btree_multimap &c)
+   {
+      id_ = c.id_;
+      map_= c.map_;
+      return *this;
+   }
+   int id_;
+   btree_map<recursive_btree_multimap, recursive_btree_multimap> map_;
+   friend bool operator< (const recursive_btree_multimap &a, const recursive_btree_multimap &b)
+   {  return a.id_ < b.id_;   }
+};
+
+template<class C>
+void test_move()
+{
+   //Now test move semantics
+   C original;
+   C move_ctor(boost::move(original));
+   C move_assign;
+   move_assign = boost::move(move_ctor);
+   move_assign.swap(original);
+}
+
+template<class T, class A>
+class btree_propagate_test_wrapper
+   : public container_detail::btree<T, T, container_detail::identity<T>, std::less<T>, A>
+{
+   BOOST_COPYABLE_AND_MOVABLE(btree_propagate_test_wrapper)
+   typedef container_detail::btree<T, T, container_detail::identity<T>, std::less<T>, A> Base;
+   public:
+   btree_propagate_test_wrapper()
+      : Base()
+   {}
+
+   btree_propagate_test_wrapper(const btree_propagate_test_wrapper &x)
+      : Base(x)
+   {}
+
+   btree_propagate_test_wrapper(BOOST_RV_REF(btree_propagate_test_wrapper) x)
+      : Base(boost::move(static_cast<Base&>(x)))
+   {}
+
+   btree_propagate_test_wrapper &operator=(BOOST_COPY_ASSIGN_REF(btree_propagate_test_wrapper) x)
+   {  this->Base::operator=(x);  return *this; }
+
+   btree_propagate_test_wrapper &operator=(BOOST_RV_REF(btree_propagate_test_wrapper) x)
+   {  this->Base::operator=(boost::move(static_cast<Base&>(x)));  return *this; }
+
+   void swap(btree_propagate_test_wrapper &x)
+   {  this->Base::swap(x);  }
+};
+
+namespace boost{
+namespace container {
+namespace test{
+
+bool btree_ordered_insertion_test()
+{
+   using namespace boost::container;
+   const std::size_t NumElements = 100;
+
+   //Ordered insertion multiset
+   {
+      std::multiset<int> int_mset;
+      for(std::size_t i = 0; i != NumElements; ++i){
+         int_mset.insert(static_cast<int>(i));
+      }
+      //Construction insertion
+      btree_multiset<int> fmset(ordered_range, int_mset.begin(), int_mset.end());
+      if(!CheckEqualContainers(&int_mset, &fmset))
+         return false;
+      //Insertion when empty
+      fmset.clear();
+      fmset.insert(ordered_range, int_mset.begin(), int_mset.end());
+      if(!CheckEqualContainers(&int_mset, &fmset))
+         return false;
+      //Re-insertion
+      fmset.insert(ordered_range, int_mset.begin(), int_mset.end());
+      std::multiset<int> int_mset2(int_mset);
+      int_mset2.insert(int_mset.begin(), int_mset.end());
+      if(!CheckEqualContainers(&int_mset2, &fmset))
+         return false;
+      //Re-re-insertion
+      fmset.insert(ordered_range, int_mset2.begin(), int_mset2.end());
+      std::multiset<int> int_mset4(int_mset2);
+      int_mset4.insert(int_mset2.begin(), int_mset2.end());
+      if(!CheckEqualContainers(&int_mset4, &fmset))
+         return false;
+      //Re-re-insertion of even
+      std::multiset<int> int_even_mset;
+      for(std::size_t i = 0; i < NumElements; i+=2){
+         int_mset.insert(static_cast<int>(i));
+      }
+      fmset.insert(ordered_range, int_even_mset.begin(), int_even_mset.end());
+      int_mset4.insert(int_even_mset.begin(), int_even_mset.end());
+      if(!CheckEqualContainers(&int_mset4, &fmset))
+         return false;
+   }
+   //Ordered insertion multimap
+   {
+      std::multimap<int, int> int_mmap;
+      for(std::size_t i = 0; i != NumElements; ++i){
+         int_mmap.insert(std::multimap<int, int>::value_type(static_cast<int>(i), static_cast<int>(i)));
+      }
+      //Construction insertion
+      btree_multimap<int, int> fmmap(ordered_range, int_mmap.begin(), int_mmap.end());
+      if(!CheckEqualContainers(&int_mmap, &fmmap))
+         return false;
+      //Insertion when empty
+      fmmap.clear();
+      fmmap.insert(ordered_range, int_mmap.begin(), int_mmap.end());
+      if(!CheckEqualContainers(&int_mmap, &fmmap))
+         return false;
+      //Re-insertion
+      fmmap.insert(ordered_range, int_mmap.begin(), int_mmap.end());
+      std::multimap<int, int> int_mmap2(int_mmap);
+      int_mmap2.insert(int_mmap.begin(), int_mmap.end());
+      if(!CheckEqualContainers(&int_mmap2, &fmmap))
+         return false;
+      //Re-re-insertion
+      fmmap.insert(ordered_range, int_mmap2.begin(), int_mmap2.end());
+      std::multimap<int, int> int_mmap4(int_mmap2);
+      int_mmap4.insert(int_mmap2.begin(), int_mmap2.end());
+      if(!CheckEqualContainers(&int_mmap4, &fmmap))
+         return false;
+      //Re-re-insertion of even
+      std::multimap<int, int> int_even_mmap;
+      for(std::size_t i = 0; i < NumElements; i+=2){
+         int_mmap.insert(std::multimap<int, int>::value_type(static_cast<int>(i), static_cast<int>(i)));
+      }
+      fmmap.insert(ordered_range, int_even_mmap.begin(), int_even_mmap.end());
+      int_mmap4.insert(int_even_mmap.begin(), int_even_mmap.end());
+      if(!CheckEqualContainers(&int_mmap4, &fmmap))
+         return false;
+   }
+
+   //Ordered insertion set
+   {
+      std::set<int> int_set;
+      for(std::size_t i = 0; i != NumElements; ++i){
+         int_set.insert(static_cast<int>(i));
+      }
+      //Construction insertion
+      btree_set<int> fset(ordered_unique_range, int_set.begin(), int_set.end());
+      if(!CheckEqualContainers(&int_set, &fset))
+         return false;
+      //Insertion when empty
+      fset.clear();
+      fset.insert(ordered_unique_range, int_set.begin(), int_set.end());
+      if(!CheckEqualContainers(&int_set, &fset))
+         return false;
+      //Re-insertion
+      fset.insert(ordered_unique_range, int_set.begin(), int_set.end());
+      std::set<int> int_set2(int_set);
+      int_set2.insert(int_set.begin(), int_set.end());
+      if(!CheckEqualContainers(&int_set2, &fset))
+         return false;
+      //Re-re-insertion
+      fset.insert(ordered_unique_range, int_set2.begin(), int_set2.end());
+      std::set<int> int_set4(int_set2);
+      int_set4.insert(int_set2.begin(), int_set2.end());
+      if(!CheckEqualContainers(&int_set4, &fset))
+         return false;
+      //Re-re-insertion of even
+      std::set<int> int_even_set;
+      for(std::size_t i = 0; i < NumElements; i+=2){
+         int_set.insert(static_cast<int>(i));
+      }
+      fset.insert(ordered_unique_range, int_even_set.begin(), int_even_set.end());
+      int_set4.insert(int_even_set.begin(), int_even_set.end());
+      if(!CheckEqualContainers(&int_set4, &fset))
+         return false;
+   }
+   //Ordered insertion map
+   {
+      std::map<int, int> int_map;
+      for(std::size_t i = 0; i != NumElements; ++i){
+         int_map.insert(std::map<int, int>::value_type(static_cast<int>(i), static_cast<int>(i)));
+      }
+      //Construction insertion
+      btree_map<int, int> fmap(ordered_unique_range, int_map.begin(), int_map.end());
+      if(!CheckEqualContainers(&int_map, &fmap))
+         return false;
+      //Insertion when empty
+      fmap.clear();
+      fmap.insert(ordered_unique_range, int_map.begin(), int_map.end());
+      if(!CheckEqualContainers(&int_map, &fmap))
+         return false;
+      //Re-insertion
+      fmap.insert(ordered_unique_range, int_map.begin(), int_map.end());
+      std::map<int, int> int_map2(int_map);
+      int_map2.insert(int_map.begin(), int_map.end());
+      if(!CheckEqualContainers(&int_map2, &fmap))
+         return false;
+      //Re-re-insertion
+      fmap.insert(ordered_unique_range, int_map2.begin(), int_map2.end());
+      std::map<int, int> int_map4(int_map2);
+      int_map4.insert(int_map2.begin(), int_map2.end());
+      if(!CheckEqualContainers(&int_map4, &fmap))
+         return false;
+      //Re-re-insertion of even
+      std::map<int, int> int_even_map;
+      for(std::size_t i = 0; i < NumElements; i+=2){
+         int_map.insert(std::map<int, int>::value_type(static_cast<int>(i), static_cast<int>(i)));
+      }
+      fmap.insert(ordered_unique_range, int_even_map.begin(), int_even_map.end());
+      int_map4.insert(int_even_map.begin(), int_even_map.end());
+      if(!CheckEqualContainers(&int_map4, &fmap))
+         return false;
+   }
+
+   return true;
+}
+
+//Inserts and erases many random values, so that nodes are split, merged and
+//rebalanced at several levels, and checks the result against std containers
+bool btree_random_insert_erase_test()
+{
+   using namespace boost::container;
+   const int NumOperations = 20000;
+   const int KeyRanges[] = { 16, 500, 20000 };
+
+   for(std::size_t r = 0; r != sizeof(KeyRanges)/sizeof(KeyRanges[0]); ++r){
+      std::srand(static_cast<unsigned>(r));
+      std::multimap<int, int> std_mmap;
+      btree_multimap<int, int> btmmap;
+      std::set<int> std_set;
+      btree_set<int> btset;
+      for(int i = 0; i != NumOperations; ++i){
+         const int key = std::rand() % KeyRanges[r];
+         switch(std::rand() % 5){
+            case 0:
+            case 1:
+               std_mmap.insert(std::multimap<int, int>::value_type(key, i));
+               btmmap.insert(std::pair<int, int>(key, i));
+               std_set.insert(key);
+               btset.insert(key);
+            break;
+            case 2:
+            {
+               //Hinted insertion with the position the value is inserted at
+               const btree_set<int>::iterator hint = btset.lower_bound(key);
+               std_set.insert(key);
+               if(*btset.insert(hint, key) != key)
+                  return false;
+               std_mmap.insert(std_mmap.upper_bound(key), std::multimap<int, int>::value_type(key, i));
+               btmmap.insert(btmmap.upper_bound(key), std::pair<int, int>(key, i));
+            }
+            break;
+            case 3:
+            {
+               std::multimap<int, int>::iterator sit = std_mmap.lower_bound(key);
+               btree_multimap<int, int>::iterator bit = btmmap.lower_bound(key);
+               if((sit == std_mmap.end()) != (bit == btmmap.end()))
+                  return false;
+               if(sit != std_mmap.end()){
+                  std_mmap.erase(sit++);
+                  bit = btmmap.erase(bit);
+                  if((sit == std_mmap.end()) != (bit == btmmap.end()))
+                     return false;
+                  if(sit != std_mmap.end() && (sit->first != bit->first || sit->second != bit->second))
+                     return false;
+               }
+               if(std_set.erase(key) != btset.erase(key))
+                  return false;
+            }
+            break;
+            default:
+               if(std_mmap.erase(key) != btmmap.erase(key))
+                  return false;
+            break;
+         }
+         if(btmmap.count(key) != std_mmap.count(key))
+            return false;
+      }
+      if(!CheckEqualContainers(&btmmap, &std_mmap) || !CheckEqualContainers(&btset, &std_set))
+         return false;
+      if(!std::equal(btset.rbegin(), btset.rend(), std_set.rbegin()))
+         return false;
+      //Erase a range in the middle
+      std::multimap<int, int>::iterator sfirst = std_mmap.begin(), slast = std_mmap.end();
+      btree_multimap<int, int>::iterator bfirst = btmmap.begin(), blast = btmmap.end();
+      for(std::size_t i = 0, max = std_mmap.size()/4; i != max; ++i){
+         ++sfirst; ++bfirst; --slast; --blast;
+      }
+      std_mmap.erase(sfirst, slast);
+      btmmap.erase(bfirst, blast);
+      if(!CheckEqualContainers(&btmmap, &std_mmap))
+         return false;
+   }
+   return true;
+}
+
+}}}
+
+int main()
+{
+   using namespace boost::container::test;
+
+   //Allocator argument container
+   {
+      btree_set<int> set_((std::allocator<int>()));
+      btree_multiset<int> multiset_((std::allocator<int>()));
+      btree_map<int, int> map_((std::allocator<std::pair<int, int> >()));
+      btree_multimap<int, int> multimap_((std::allocator<std::pair<int, int> >()));
+   }
+   //Now test move semantics
+   {
+      test_move<btree_set<recursive_btree_set> >();
+      test_move<btree_multiset<recursive_btree_multiset> >();
+      test_move<btree_map<recursive_btree_map, recursive_btree_map> >();
+      test_move<btree_multimap<recursive_btree_multimap, recursive_btree_multimap> >();
+   }
+
+   if(!btree_ordered_insertion_test()){
+      return 1;
+   }
+
+   if(!btree_random_insert_erase_test()){
+      return 1;
+   }
+
+   if (0 != set_test<
+                  MyBoostSet
+                  ,MyStdSet
+                  ,MyBoostMultiSet
+                  ,MyStdMultiSet>()){
+      std::cout << "Error in set_test<MyBoostSet>" << std::endl;
+      return 1;
+   }
+
+   if (0 != set_test_copyable<
+                  MyBoostSet
+                  ,MyStdSet
+                  ,MyBoostMultiSet
+                  ,MyStdMultiSet>()){
+      std::cout << "Error in set_test<MyBoostSet>" << std::endl;
+      return 1;
+   }
+
+   if (0 != set_test<
+                  MyMovableBoostSet
+                  ,MyStdSet
+                  ,MyMovableBoostMultiSet
+                  ,MyStdMultiSet>()){
+      std::cout << "Error in set_test<MyMovableBoostSet>" << std::endl;
+      return 1;
+   }
+
+   if (0 != set_test<
+                  MyMoveCopyBoostSet
+                  ,MyStdSet
+                  ,MyMoveCopyBoostMultiSet
+                  ,MyStdMultiSet>()){
+      std::cout << "Error in set_test<MyMoveCopyBoostSet>" << std::endl;
+      return 1;
+   }
+
+   if (0 != set_test_copyable<
+                  MyMoveCopyBoostSet
+                  ,MyStdSet
+                  ,MyMoveCopyBoostMultiSet
+                  ,MyStdMultiSet>()){
+      std::cout << "Error in set_test<MyBoostSet>" << std::endl;
+      return 1;
+   }
+
+   if (0 != set_test<
+                  MyCopyBoostSet
+                  ,MyStdSet
+                  ,MyCopyBoostMultiSet
+                  ,MyStdMultiSet>()){
+      std::cout << "Error in set_test<MyCopyBoostSet>" << std::endl;
+      return 1;
+   }
+
+   if (0 != set_test_copyable<
+                  MyCopyBoostSet
+                  ,MyStdSet
+                  ,MyCopyBoostMultiSet
+                  ,MyStdMultiSet>()){
+      std::cout << "Error in set_test<MyBoostSet>" << std::endl;
+      return 1;
+   }
+
+   if (0 != map_test<
+                  MyBoostMap
+                  ,MyStdMap
+                  ,MyBoostMultiMap
+                  ,MyStdMultiMap>()){
+      std::cout << "Error in set_test<MyBoostMap>" << std::endl;
+      return 1;
+   }
+
+   if (0 != map_test_copyable<
+                  MyBoostMap
+                  ,MyStdMap
+                  ,MyBoostMultiMap
+                  ,MyStdMultiMap>()){
+      std::cout << "Error in set_test<MyBoostMap>" << std::endl;
+      return 1;
+   }
+
+   if (0 != map_test<
+                  MyMovableBoostMap
+                  ,MyStdMap
+                  ,MyMovableBoostMultiMap
+                  ,MyStdMultiMap>()){
+      return 1;
+   }
+
+   if (0 != map_test<
+                  MyMoveCopyBoostMap
+                  ,MyStdMap
+                  ,MyMoveCopyBoostMultiMap
+                  ,MyStdMultiMap>()){
+      std::cout << "Error in set_test<MyMoveCopyBoostMap>" << std::endl;
+      return 1;
+   }
+
+   if (0 != map_test_copyable<
+                  MyMoveCopyBoostMap
+                  ,MyStdMap
+                  ,MyMoveCopyBoostMultiMap
+                  ,MyStdMultiMap>()){
+      std::cout << "Error in set_test<MyBoostMap>" << std::endl;
+      return 1;
+   }
+
+   if (0 != map_test<
+                  MyCopyBoostMap
+                  ,MyStdMap
+                  ,MyCopyBoostMultiMap
+                  ,MyStdMultiMap>()){
+      std::cout << "Error in set_test<MyCopyBoostMap>" << std::endl;
+      return 1;
+   }
+
+   if (0 != map_test_copyable<
+                  MyCopyBoostMap
+                  ,MyStdMap
+                  ,MyCopyBoostMultiMap
+                  ,MyStdMultiMap>()){
+      std::cout << "Error in set_test<MyBoostMap>" << std::endl;
+      return 1;
+   }
+
+   const test::EmplaceOptions SetOptions = (test::EmplaceOptions)(test::EMPLACE_HINT | test::EMPLACE_ASSOC);
+   const test::EmplaceOptions MapOptions = (test::EmplaceOptions)(test::EMPLACE_HINT_PAIR | test::EMPLACE_ASSOC_PAIR);
+
+   if(!boost::container::test::test_emplace<btree_map<test::EmplaceInt, test::EmplaceInt>, MapOptions>())
+      return 1;
+   if(!boost::container::test::test_emplace<btree_multimap<test::EmplaceInt, test::EmplaceInt>, MapOptions>())
+      return 1;
+   if(!boost::container::test::test_emplace<btree_set<test::EmplaceInt>, SetOptions>())
+      return 1;
+   if(!boost::container::test::test_emplace<btree_multiset<test::EmplaceInt>, SetOptions>())
+      return 1;
+   if(!boost::container::test::test_propagate_allocator<btree_propagate_test_wrapper>())
+      return 1;
+
+   return 0;
+}
+
+#include <boost/container/detail/config_end.hpp>
+
@@ -0,0 +1,402 @@
+//////////////////////////////////////////////////////////////////////////////
+//
+// (C) Copyright Ion Gaztanaga 2013. Distributed under the Boost
+// Software License, Version 1.0. (See accompanying file
+// LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// See http://www.boost.org/libs/container for documentation.
+//
+//////////////////////////////////////////////////////////////////////////////
+#include <boost/container/detail/config_begin.hpp>
+#include <memory>
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+
+#include <boost/container/small_vector.hpp>
+#include <boost/move/utility.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include "check_equal_containers.hpp"
+#include "movable_int.hpp"
+#include "emplace_test.hpp"
+#include "vector_test.hpp"
+
+using namespace boost::container;
+
+namespace boost {
+namespace container {
+
+//Explicit instantiation to detect compilation errors
+template class boost::container::small_vector<test::movable_and_copyable_int, 10>;
+
+template class boost::container::vector<test::movable_and_copyable_int,
+   container_detail::small_vector_allocator<test::movable_and_copyable_int, 10,
+      std::allocator<test::movable_and_copyable_int> > >;
+
+}}
+
+//A minimal allocator that counts the live allocations
+template<class T>
+class counting_allocator
+{
+   public:
+   typedef T value_type;
+
+   static int allocations;
+
+   counting_allocator()
+   {}
+
+   template<class U>
+   counting_allocator(const counting_allocator<U> &)
+   {}
+
+   T *allocate(std::size_t n)
+   {
+      ++allocations;
+      return static_cast<T*>(::operator new(n*sizeof(T)));
+   }
+
+   void deallocate(T *p, std::size_t)
+   {
+      --allocations;
+      ::operator delete(p);
+   }
+
+   friend bool operator==(const counting_allocator &, const counting_allocator &)
+   {  return true;  }
+
+   friend bool operator!=(const counting_allocator &, const counting_allocator &)
+   {  return false;  }
+};
+
+template<class T>
+int counting_allocator<T>::allocations = 0;
+
+typedef counting_allocator<test::movable_int> counting_alloc_t;
+typedef small_vector<test::movable_int, 4, counting_alloc_t> counting_vector_t;
+
+//A stateful allocator without a default constructor that counts the live
+//allocations of the arena it was constructed with
+template<class T>
+class arena_allocator
+{
+   public:
+   typedef T value_type;
+
+   explicit arena_allocator(int &live)
+      : live_(&live)
+   {}
+
+   template<class U>
+   arena_allocator(const arena_allocator<U> &other)
+      : live_(other.live_)
+   {}
+
+   T *allocate(std::size_t n)
+   {
+      ++*live_;
+      return static_cast<T*>(::operator new(n*sizeof(T)));
+   }
+
+   void deallocate(T *p, std::size_t)
+   {
+      --*live_;
+      ::operator delete(p);
+   }
+
+   friend bool operator==(const arena_allocator &x, const arena_allocator &y)
+   {  return x.live_ == y.live_;  }
+
+   friend bool operator!=(const arena_allocator &x, const arena_allocator &y)
+   {  return x.live_ != y.live_;  }
+
+   int *live_;
+};
+
+typedef arena_allocator<int> arena_alloc_t;
+typedef small_vector<int, 4, arena_alloc_t> arena_vector_t;
+
+template<class V>
+bool is_internal(const V &v)
+{
+   const char *const data = static_cast<const char*>(static_cast<const void*>(v.data()));
+   const char *const obj  = static_cast<const char*>(static_cast<const void*>(&v));
+   return data >= obj && data < obj + sizeof(V);
+}
+
+void fill(counting_vector_t &v, int n, int first = 0)
+{
+   v.clear();
+   for(int i = 0; i != n; ++i){
+      v.push_back(test::movable_int(first + i));
+   }
+}
+
+bool check_values(const counting_vector_t &v, int n, int first = 0)
+{
+   if(v.size() != std::size_t(n))
+      return false;
+   for(int i = 0; i != n; ++i){
+      if(v[i] != test::movable_int(first + i))
+         return false;
+   }
+   return true;
+}
+
+void test_internal_storage()
+{
+   {
+      counting_vector_t v;
+      BOOST_TEST(v.capacity() == 4u);
+      BOOST_TEST(counting_vector_t::static_capacity == 4u);
+      BOOST_TEST(v.empty());
+      BOOST_TEST(is_internal(v));
+
+      //Up to N elements no memory is allocated
+      fill(v, 4);
+      BOOST_TEST(check_values(v, 4));
+      BOOST_TEST(is_internal(v));
+      BOOST_TEST(counting_alloc_t::allocations == 0);
+
+      //Then the elements are moved to allocated memory
+      v.push_back(test::movable_int(4));
+      BOOST_TEST(check_values(v, 5));
+      BOOST_TEST(!is_internal(v));
+      BOOST_TEST(v.capacity() > 4u);
+      BOOST_TEST(counting_alloc_t::allocations == 1);
+
+      //Shrinking moves them back
+      v.pop_back();
+      v.shrink_to_fit();
+      BOOST_TEST(check_values(v, 4));
+      BOOST_TEST(is_internal(v));
+      BOOST_TEST(v.capacity() == 4u);
+      BOOST_TEST(counting_alloc_t::allocations == 0);
+
+      //reserve allocates only beyond N
+      v.reserve(3);
+      BOOST_TEST(is_internal(v));
+      v.reserve(40);
+      BOOST_TEST(!is_internal(v));
+      BOOST_TEST(v.capacity() >= 40u);
+      BOOST_TEST(check_values(v, 4));
+      v.reserve(80);
+      BOOST_TEST(counting_alloc_t::allocations == 1);
+      BOOST_TEST(check_values(v, 4));
+
+      //shrink_to_fit keeps allocated memory for more than N elements
+      fill(v, 10);
+      v.shrink_to_fit();
+      BOOST_TEST(v.capacity() == 10u);
+      BOOST_TEST(check_values(v, 10));
+   }
+   BOOST_TEST(counting_alloc_t::allocations == 0);
+   {
+      counting_vector_t v(3);
+      BOOST_TEST(is_internal(v) && v.size() == 3u);
+      counting_vector_t w(7);
+      BOOST_TEST(!is_internal(w) && w.size() == 7u);
+      BOOST_TEST(counting_alloc_t::allocations == 1);
+   }
+   BOOST_TEST(counting_alloc_t::allocations == 0);
+}
+
+void test_move_and_swap()
+{
+   const int sizes[] = { 0, 2, 4, 6, 9 };
+   const int num_sizes = sizeof(sizes)/sizeof(sizes[0]);
+
+   //Move construction
+   for(int i = 0; i != num_sizes; ++i){
+      counting_vector_t a;
+      fill(a, sizes[i]);
+      const bool internal = is_internal(a);
+      const test::movable_int *const data = a.data();
+      counting_vector_t b(boost::move(a));
+      BOOST_TEST(check_values(b, sizes[i]));
+      BOOST_TEST(a.empty() && is_internal(a) && a.capacity() == 4u);
+      BOOST_TEST(is_internal(b) == internal);
+      //Allocated memory is taken, not copied
+      BOOST_TEST(internal || b.data() == data);
+   }
+   BOOST_TEST(counting_alloc_t::allocations == 0);
+
+   //Move assignment and swap for every combination of sizes
+   for(int i = 0; i != num_sizes; ++i){
+      for(int j = 0; j != num_sizes; ++j){
+         {
+            counting_vector_t a, b;
+            fill(a, sizes[i], 0);
+            fill(b, sizes[j], 100);
+            b = boost::move(a);
+            BOOST_TEST(check_values(b, sizes[i], 0));
+            BOOST_TEST(a.empty() || is_internal(a));
+            a.push_back(test::movable_int(1));
+            BOOST_TEST(a.size() == 1u);
+         }
+         {
+            counting_vector_t a, b;
+            fill(a, sizes[i], 0);
+            fill(b, sizes[j], 100);
+            a.swap(b);
+            BOOST_TEST(check_values(a, sizes[j], 100));
+            BOOST_TEST(check_values(b, sizes[i], 0));
+            BOOST_TEST(is_internal(a) == (sizes[j] <= 4));
+            BOOST_TEST(is_internal(b) == (sizes[i] <= 4));
+            swap(a, b);
+            BOOST_TEST(check_values(a, sizes[i], 0));
+            BOOST_TEST(check_values(b, sizes[j], 100));
+            //The containers are still usable
+            a.push_back(test::movable_int(-1));
+            b.insert(b.begin(), test::movable_int(-1));
+            BOOST_TEST(a.back() == test::movable_int(-1));
+            BOOST_TEST(b.front() == test::movable_int(-1));
+         }
+         BOOST_TEST(counting_alloc_t::allocations == 0);
+      }
+   }
+}
+
+//An element whose copy constructor throws once the budget runs out
+struct throwing_int
+{
+   explicit throwing_int(int v)
+      : value(v)
+   {}
+
+   throwing_int(const throwing_int &other)
+      : value(other.value)
+   {
+      if(budget >= 0 && budget-- == 0){
+         throw std::runtime_error("throwing_int");
+      }
+   }
+
+   throwing_int &operator=(const throwing_int &other)
+   {
+      value = other.value;
+      return *this;
+   }
+
+   int value;
+   static int budget;
+};
+
+int throwing_int::budget = -1;
+
+void test_throwing_move()
+{
+   typedef small_vector<throwing_int, 4> throwing_vector_t;
+   throwing_vector_t a, b;
+   a.push_back(throwing_int(1));
+   a.push_back(throwing_int(2));
+   b.push_back(throwing_int(3));
+
+   //Elements in the internal storage are moved one by one, so the
+   //exception reaches the caller
+   int caught = 0;
+   throwing_int::budget = 0;
+   try{  throwing_vector_t c(boost::move(a));  }
+   catch(std::runtime_error &){  ++caught;  }
+   throwing_int::budget = 0;
+   try{  b = boost::move(a);  }
+   catch(std::runtime_error &){  ++caught;  }
+   throwing_int::budget = 0;
+   try{  a.swap(b);  }
+   catch(std::runtime_error &){  ++caught;  }
+   throwing_int::budget = -1;
+   BOOST_TEST(caught == 3);
+
+   //The containers are still usable
+   a.clear();
+   a.push_back(throwing_int(4));
+   b = boost::move(a);
+   BOOST_TEST(b.size() == 1u && b[0].value == 4);
+}
+
+void test_stateful_allocator()
+{
+   int live = 0;
+   {
+      const arena_alloc_t a(live);
+      arena_vector_t v(a);
+      for(int i = 0; i != 6; ++i){
+         v.push_back(i);
+      }
+      BOOST_TEST(!is_internal(v));
+      BOOST_TEST(live == 1);
+
+      //The allocated memory is freed through the container's allocator
+      v.pop_back();
+      v.pop_back();
+      v.shrink_to_fit();
+      BOOST_TEST(is_internal(v));
+      BOOST_TEST(live == 0);
+      BOOST_TEST(v.size() == 4u && v[0] == 0 && v[3] == 3);
+      BOOST_TEST(v.get_allocator() == arena_vector_t::allocator_type(a));
+
+      const int values[] = { 0, 1, 2, 3, 4, 5 };
+      arena_vector_t w(values, values + 6, a);
+      BOOST_TEST(!is_internal(w) && w.size() == 6u && w[5] == 5);
+      BOOST_TEST(live == 1);
+      w.resize(2);
+      w.shrink_to_fit();
+      BOOST_TEST(is_internal(w) && w.size() == 2u && w[1] == 1);
+      BOOST_TEST(live == 0);
+   }
+   BOOST_TEST(live == 0);
+}
+
+void test_copy()
+{
+   typedef small_vector<int, 3> small_int_vector_t;
+   for(int n = 0; n != 8; ++n){
+      small_int_vector_t a;
+      for(int i = 0; i != n; ++i){
+         a.push_back(i);
+      }
+      small_int_vector_t b(a);
+      BOOST_TEST(a == b);
+      BOOST_TEST(is_internal(b) == (n <= 3));
+      small_int_vector_t c(2, 7);
+      c = a;
+      BOOST_TEST(a == c);
+      c = c;
+      BOOST_TEST(a == c);
+      const small_int_vector_t d(a.begin(), a.end());
+      BOOST_TEST(a == d);
+   }
+}
+
+int main()
+{
+   typedef small_vector<int, 10> MyVector;
+   typedef small_vector<test::movable_int, 10> MyMoveVector;
+   typedef small_vector<test::movable_and_copyable_int, 10> MyCopyMoveVector;
+   typedef small_vector<test::copyable_int, 10> MyCopyVector;
+
+   if(test::vector_test<MyVector>())
+      return 1;
+   if(test::vector_test<MyMoveVector>())
+      return 1;
+   if(test::vector_test<MyCopyMoveVector>())
+      return 1;
+   if(test::vector_test<MyCopyVector>())
+      return 1;
+
+   const test::EmplaceOptions Options = (test::EmplaceOptions)(test::EMPLACE_BACK | test::EMPLACE_BEFORE);
+   if(!boost::container::test::test_emplace< small_vector<test::EmplaceInt, 5>, Options>()){
+      return 1;
+   }
+
+   test_internal_storage();
+   test_move_and_swap();
+   test_throwing_move();
+   test_stateful_allocator();
+   test_copy();
+
+   return boost::report_errors();
+}
+
+#include <boost/container/detail/config_end.hpp>
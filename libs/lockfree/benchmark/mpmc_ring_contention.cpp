@@ -0,0 +1,181 @@
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Compares the throughput of boost::lockfree::mpmc_ring with boost::lockfree::queue and a mutex-protected
+//  std::deque, when several producers and consumers contend for the same queue.
+//
+//  usage: mpmc_ring_contention <producers> <consumers> <items per producer> [batch size]
+
+#include <boost/lockfree/mpmc_ring.hpp>
+#include <boost/lockfree/queue.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/chrono.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+using namespace boost;
+
+class locked_deque
+{
+public:
+    bool push(long const & t)
+    {
+        lock_guard<mutex> lock(mutex_);
+        data_.push_back(t);
+        return true;
+    }
+
+    bool pop(long & ret)
+    {
+        lock_guard<mutex> lock(mutex_);
+        if (data_.empty())
+            return false;
+        ret = data_.front();
+        data_.pop_front();
+        return true;
+    }
+
+private:
+    mutex mutex_;
+    std::deque<long> data_;
+};
+
+template <typename Queue>
+struct single_ops
+{
+    static void produce(Queue & q, long first, long count, long)
+    {
+        for (long i = first; i != first + count; ++i)
+            while (!q.push(i))
+                this_thread::yield();
+    }
+
+    static long consume(Queue & q, lockfree::detail::atomic<long> & remaining, long)
+    {
+        long sum = 0;
+        long value;
+        while (remaining.load(lockfree::memory_order_relaxed) > 0) {
+            if (q.pop(value)) {
+                sum += value;
+                --remaining;
+            } else
+                this_thread::yield();
+        }
+        return sum;
+    }
+};
+
+template <typename Queue>
+struct batch_ops
+{
+    static void produce(Queue & q, long first, long count, long batch)
+    {
+        long buffer[256];
+        for (long i = first; i < first + count; i += batch) {
+            long n = (std::min)(batch, first + count - i);
+            for (long j = 0; j != n; ++j)
+                buffer[j] = i + j;
+
+            long const * next = buffer;
+            long const * end = buffer + n;
+            while (next != end) {
+                long const * pushed = q.push(next, end);
+                if (pushed == next)
+                    this_thread::yield();
+                next = pushed;
+            }
+        }
+    }
+
+    static long consume(Queue & q, lockfree::detail::atomic<long> & remaining, long batch)
+    {
+        long sum = 0;
+        long buffer[256];
+        while (remaining.load(lockfree::memory_order_relaxed) > 0) {
+            long n = static_cast<long>(q.pop(buffer, batch));
+            if (n == 0) {
+                this_thread::yield();
+                continue;
+            }
+            for (long j = 0; j != n; ++j)
+                sum += buffer[j];
+            remaining -= n;
+        }
+        return sum;
+    }
+};
+
+template <typename Ops, typename Queue>
+void consumer(Queue & q, lockfree::detail::atomic<long> & remaining, long batch, long & sum)
+{
+    sum = Ops::consume(q, remaining, batch);
+}
+
+template <typename Ops, typename Queue>
+void run(const char * name, Queue & q, int producers, int consumers, long items, long batch)
+{
+    lockfree::detail::atomic<long> remaining(producers * items);
+    std::vector<long> sums(consumers);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    thread_group threads;
+    for (int i = 0; i != consumers; ++i)
+        threads.create_thread(bind(&consumer<Ops, Queue>, ref(q), ref(remaining), batch, ref(sums[i])));
+    for (int i = 0; i != producers; ++i)
+        threads.create_thread(bind(&Ops::produce, ref(q), i * items, items, batch));
+    threads.join_all();
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    long total = producers * items;
+    long sum = 0;
+    for (int i = 0; i != consumers; ++i)
+        sum += sums[i];
+    bool valid = (sum == total * (total - 1) / 2);
+
+    std::printf("%-24s %12.0f items/sec%s\n", name, total / elapsed.count(), valid ? "" : " (checksum mismatch)");
+}
+
+int main(int argc, char * argv[])
+{
+    if (argc != 4 && argc != 5) {
+        std::fprintf(stderr, "usage: mpmc_ring_contention <producers> <consumers> <items per producer> [batch size]\n");
+        return 1;
+    }
+
+    int producers = std::atoi(argv[1]);
+    int consumers = std::atoi(argv[2]);
+    long items = std::atol(argv[3]);
+    long batch = (argc == 5) ? (std::min)(std::atol(argv[4]), 256L) : 16;
+
+    {
+        lockfree::mpmc_ring<long> q(1024);
+        run<single_ops<lockfree::mpmc_ring<long> > >("mpmc_ring", q, producers, consumers, items, batch);
+    }
+    {
+        lockfree::mpmc_ring<long> q(1024);
+        run<batch_ops<lockfree::mpmc_ring<long> > >("mpmc_ring (batched)", q, producers, consumers, items, batch);
+    }
+    {
+        lockfree::queue<long> q(1024);
+        run<single_ops<lockfree::queue<long> > >("queue", q, producers, consumers, items, batch);
+    }
+    {
+        locked_deque q;
+        run<single_ops<locked_deque> >("mutex + deque", q, producers, consumers, items, batch);
+    }
+
+    return 0;
+}
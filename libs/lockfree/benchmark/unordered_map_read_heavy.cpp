@@ -0,0 +1,125 @@
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Compares the throughput of boost::lockfree::unordered_map with a boost::unordered_map protected by a
+//  boost::shared_mutex, when several threads mostly look up keys and occasionally insert or erase them.
+//
+//  usage: unordered_map_read_heavy <threads> <operations per thread> [percentage of lookups] [keys]
+
+#include <boost/lockfree/unordered_map.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/chrono.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/unordered_map.hpp>
+
+using namespace boost;
+
+class locked_unordered_map
+{
+public:
+    bool insert(long key, long value)
+    {
+        unique_lock<shared_mutex> lock(mutex_);
+        return data_.insert(std::make_pair(key, value)).second;
+    }
+
+    bool erase(long key)
+    {
+        unique_lock<shared_mutex> lock(mutex_);
+        return data_.erase(key) != 0;
+    }
+
+    bool find(long key, long & value) const
+    {
+        shared_lock<shared_mutex> lock(mutex_);
+        boost::unordered_map<long, long>::const_iterator it = data_.find(key);
+        if (it == data_.end())
+            return false;
+        value = it->second;
+        return true;
+    }
+
+private:
+    mutable shared_mutex mutex_;
+    boost::unordered_map<long, long> data_;
+};
+
+/* xorshift, so that the threads do not contend for the state of a shared random number generator */
+inline unsigned long next_random(unsigned long & state)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+template <typename Map>
+void worker(Map & m, int id, long operations, int lookup_percentage, long keys, long & hits)
+{
+    unsigned long state = 88172645463325252UL + id;
+    long found = 0;
+    for (long i = 0; i != operations; ++i) {
+        long key = static_cast<long>(next_random(state) % keys);
+        long value;
+        if (static_cast<int>(next_random(state) % 100) < lookup_percentage)
+            found += m.find(key, value);
+        else if (!m.erase(key))
+            m.insert(key, key);
+    }
+    hits = found;
+}
+
+template <typename Map>
+void run(const char * name, Map & m, int threads, long operations, int lookup_percentage, long keys)
+{
+    for (long key = 0; key < keys; key += 2)
+        m.insert(key, key);
+
+    std::vector<long> hits(threads);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    thread_group group;
+    for (int i = 0; i != threads; ++i)
+        group.create_thread(boost::bind(&worker<Map>, boost::ref(m), i, operations, lookup_percentage, keys,
+                                        boost::ref(hits[i])));
+    group.join_all();
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    std::printf("%-32s %12.0f operations/sec\n", name, threads * operations / elapsed.count());
+}
+
+int main(int argc, char * argv[])
+{
+    if (argc < 3 || argc > 5) {
+        std::fprintf(stderr, "usage: unordered_map_read_heavy <threads> <operations per thread> [percentage of lookups] [keys]\n");
+        return 1;
+    }
+
+    int threads = std::atoi(argv[1]);
+    long operations = std::atol(argv[2]);
+    int lookup_percentage = (argc > 3) ? std::atoi(argv[3]) : 95;
+    long keys = (argc > 4) ? std::atol(argv[4]) : 100000;
+
+    {
+        lockfree::unordered_map<long, long> m(keys);
+        run("lockfree::unordered_map", m, threads, operations, lookup_percentage, keys);
+    }
+    {
+        locked_unordered_map m;
+        run("unordered_map + shared_mutex", m, threads, operations, lookup_percentage, keys);
+    }
+
+    return 0;
+}
@@ -0,0 +1,88 @@
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/blocking_spsc_queue.hpp>
+#include <boost/thread.hpp>
+
+#define BOOST_TEST_MAIN
+#ifdef BOOST_LOCKFREE_INCLUDE_TESTS
+#include <boost/test/included/unit_test.hpp>
+#else
+#include <boost/test/unit_test.hpp>
+#endif
+
+#include <vector>
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+BOOST_AUTO_TEST_CASE( simple_blocking_spsc_queue_test )
+{
+    blocking_spsc_queue<int> f(4);
+
+    BOOST_WARN(f.is_lock_free());
+    BOOST_REQUIRE(f.empty());
+
+    f.blocking_push(1);
+    BOOST_REQUIRE(f.push(2));
+
+    int out = 0;
+    f.blocking_pop(out);
+    BOOST_REQUIRE_EQUAL(out, 1);
+    BOOST_REQUIRE(f.pop(out));
+    BOOST_REQUIRE_EQUAL(out, 2);
+    BOOST_REQUIRE(!f.pop(out));
+    BOOST_REQUIRE(f.empty());
+}
+
+static const int element_count = 100000;
+
+struct blocking_producer
+{
+    blocking_producer(blocking_spsc_queue<int, capacity<16> > & q):
+        q_(q)
+    {}
+
+    void operator()(void)
+    {
+        for (int i = 0; i != element_count; ++i)
+            q_.blocking_push(i);
+    }
+
+    blocking_spsc_queue<int, capacity<16> > & q_;
+};
+
+BOOST_AUTO_TEST_CASE( blocking_spsc_queue_stress_test )
+{
+    blocking_spsc_queue<int, capacity<16> > q;
+
+    /* the small capacity makes both the producer and the consumer block frequently */
+    boost::thread producer((blocking_producer(q)));
+
+    for (int i = 0; i != element_count; ++i) {
+        int out = -1;
+        q.blocking_pop(out);
+        BOOST_REQUIRE_EQUAL(out, i);
+    }
+
+    producer.join();
+    BOOST_REQUIRE(q.empty());
+}
+
+BOOST_AUTO_TEST_CASE( blocking_spsc_queue_wakeup_test )
+{
+    blocking_spsc_queue<int> q(16);
+
+    /* the consumer blocks before anything is pushed */
+    int out = -1;
+    boost::thread consumer(boost::bind(&blocking_spsc_queue<int>::blocking_pop, &q, boost::ref(out)));
+    boost::this_thread::sleep_for(boost::chrono::milliseconds(50));
+
+    BOOST_REQUIRE(q.push(42));
+    consumer.join();
+    BOOST_REQUIRE_EQUAL(out, 42);
+}
@@ -0,0 +1,263 @@
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/mpmc_ring.hpp>
+
+#define BOOST_TEST_MAIN
+#ifdef BOOST_LOCKFREE_INCLUDE_TESTS
+#include <boost/test/included/unit_test.hpp>
+#else
+#include <boost/test/unit_test.hpp>
+#endif
+
+#include <string>
+#include <vector>
+
+#include <boost/scoped_ptr.hpp>
+
+#include "test_helpers.hpp"
+#include "test_common.hpp"
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+BOOST_AUTO_TEST_CASE( simple_mpmc_ring_test )
+{
+    mpmc_ring<int> f(64);
+
+    BOOST_WARN(f.is_lock_free());
+    BOOST_REQUIRE_EQUAL(f.capacity(), 64u);
+
+    BOOST_REQUIRE(f.empty());
+    f.push(1);
+    f.push(2);
+
+    int i1(0), i2(0);
+
+    BOOST_REQUIRE(f.pop(i1));
+    BOOST_REQUIRE_EQUAL(i1, 1);
+
+    BOOST_REQUIRE(f.pop(i2));
+    BOOST_REQUIRE_EQUAL(i2, 2);
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( simple_mpmc_ring_test_compile_time_size )
+{
+    mpmc_ring<int, capacity<50> > f;
+
+    BOOST_REQUIRE_EQUAL(f.capacity(), 64u);
+
+    BOOST_REQUIRE(f.empty());
+    f.push(1);
+    f.push(2);
+
+    int i1(0), i2(0);
+
+    BOOST_REQUIRE(f.pop(i1));
+    BOOST_REQUIRE_EQUAL(i1, 1);
+
+    BOOST_REQUIRE(f.pop(i2));
+    BOOST_REQUIRE_EQUAL(i2, 2);
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_ring_full_test )
+{
+    mpmc_ring<int> f(4);
+
+    for (int i = 0; i != 4; ++i)
+        BOOST_REQUIRE(f.push(i));
+    BOOST_REQUIRE(!f.push(4));
+
+    int out;
+    for (int round = 0; round != 10; ++round) {
+        BOOST_REQUIRE(f.pop(out));
+        BOOST_REQUIRE_EQUAL(out, round);
+        BOOST_REQUIRE(f.push(round + 4));
+        BOOST_REQUIRE(!f.push(0));
+    }
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_ring_ranged_push_pop_test )
+{
+    mpmc_ring<int> f(8);
+
+    int data[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    BOOST_REQUIRE_EQUAL(f.push(data, data + 10), data + 8);
+    BOOST_REQUIRE_EQUAL(f.push(data, 2), 0u);
+
+    int out[5];
+    BOOST_REQUIRE_EQUAL(f.pop(out), 5u);
+    for (int i = 0; i != 5; ++i)
+        BOOST_REQUIRE_EQUAL(out[i], i);
+
+    /* wraps around the end of the ringbuffer */
+    BOOST_REQUIRE_EQUAL(f.push(data + 8, 2), 2u);
+
+    std::vector<int> rest;
+    BOOST_REQUIRE_EQUAL(f.pop(std::back_inserter(rest), 100), 5u);
+    BOOST_REQUIRE_EQUAL(rest.size(), 5u);
+    for (int i = 0; i != 5; ++i)
+        BOOST_REQUIRE_EQUAL(rest[i], i + 5);
+
+    BOOST_REQUIRE(f.empty());
+    BOOST_REQUIRE_EQUAL(f.pop(out), 0u);
+}
+
+namespace {
+
+int g_instance_count = 0;
+
+struct counted
+{
+    counted(void): value(new std::string()) { ++g_instance_count; }
+    counted(std::string const & v): value(new std::string(v)) { ++g_instance_count; }
+    counted(counted const & rhs): value(new std::string(*rhs.value)) { ++g_instance_count; }
+    ~counted(void) { delete value; --g_instance_count; }
+
+    counted & operator=(counted const & rhs)
+    {
+        *value = *rhs.value;
+        return *this;
+    }
+
+    std::string * value;
+};
+
+struct append_to
+{
+    append_to(std::string & s): s_(s) {}
+
+    void operator()(counted const & c) const
+    {
+        s_ += *c.value;
+    }
+
+    std::string & s_;
+};
+
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_ring_non_trivial_type_test )
+{
+    {
+        mpmc_ring<counted> f(4);
+
+        BOOST_REQUIRE(f.push(counted("a")));
+        BOOST_REQUIRE(f.push(counted("b")));
+        BOOST_REQUIRE(f.push(counted("c")));
+        BOOST_REQUIRE_EQUAL(g_instance_count, 3);
+
+        counted out;
+        BOOST_REQUIRE(f.pop(out));
+        BOOST_REQUIRE_EQUAL(*out.value, "a");
+
+        std::string consumed;
+        BOOST_REQUIRE(f.consume_one(append_to(consumed)));
+        BOOST_REQUIRE_EQUAL(consumed, "b");
+
+        BOOST_REQUIRE(f.push(counted("d")));
+        BOOST_REQUIRE(f.push(counted("e")));
+        BOOST_REQUIRE_EQUAL(g_instance_count, 4);
+    }
+
+    /* the destructor destroys the remaining elements */
+    BOOST_REQUIRE_EQUAL(g_instance_count, 0);
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_ring_consume_all_test )
+{
+    mpmc_ring<counted> f(16);
+
+    f.push(counted("x"));
+    f.push(counted("y"));
+    f.push(counted("z"));
+
+    std::string consumed;
+    BOOST_REQUIRE_EQUAL(f.consume_all(append_to(consumed)), 3u);
+    BOOST_REQUIRE_EQUAL(consumed, "xyz");
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_ring_stress_test )
+{
+    typedef queue_stress_tester<false> tester_type;
+    boost::scoped_ptr<tester_type> tester(new tester_type(4, 4) );
+
+    mpmc_ring<long> q(128);
+    tester->run(q);
+}
+
+namespace {
+
+/* pushes and pops in batches, checking that each batch stays together */
+struct batch_tester
+{
+    static const long batch_size = 4;
+    static const long batch_count = 5000;
+
+    mpmc_ring<long> q;
+    boost::lockfree::detail::atomic<long> popped;
+    boost::lockfree::detail::atomic<long> sum;
+
+    batch_tester(void):
+        q(64), popped(0), sum(0)
+    {}
+
+    void produce(long id)
+    {
+        for (long b = 0; b != batch_count; ++b) {
+            long batch[batch_size];
+            for (long i = 0; i != batch_size; ++i)
+                batch[i] = id * batch_count * batch_size + b * batch_size + i;
+
+            long const * next = batch;
+            long const * end = batch + batch_size;
+            while (next != end) {
+                long const * pushed = q.push(next, end);
+                if (pushed == next)
+                    boost::this_thread::yield();
+                next = pushed;
+            }
+        }
+    }
+
+    void consume(long total)
+    {
+        long out[batch_size * 2];
+        while (popped.load() != total) {
+            long n = static_cast<long>(q.pop(out, batch_size * 2));
+            if (n == 0)
+                boost::this_thread::yield();
+            for (long i = 0; i != n; ++i)
+                sum += out[i];
+            popped += n;
+        }
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE( mpmc_ring_batch_stress_test )
+{
+    const long producers = 4;
+    batch_tester tester;
+    const long total = producers * batch_tester::batch_count * batch_tester::batch_size;
+
+    thread_group threads;
+    for (long i = 0; i != 4; ++i)
+        threads.create_thread(boost::bind(&batch_tester::consume, &tester, total));
+    for (long i = 0; i != producers; ++i)
+        threads.create_thread(boost::bind(&batch_tester::produce, &tester, i));
+    threads.join_all();
+
+    BOOST_REQUIRE_EQUAL(tester.popped.load(), total);
+    BOOST_REQUIRE_EQUAL(tester.sum.load(), total * (total - 1) / 2);
+    BOOST_REQUIRE(tester.q.empty());
+}
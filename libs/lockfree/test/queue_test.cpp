@@ -186,3 +186,52 @@ BOOST_AUTO_TEST_CASE( reserve_test )
     ms.reserve(1);
     ms.reserve_unsafe(1);
 }
+
+template <typename Container>
+void reclamation_test(void)
+{
+    const long initial_bytes = counting_allocator_bytes();
+    {
+        Container c(0);
+
+        for (long i = 0; i != 10000; ++i)
+            BOOST_REQUIRE(c.push(i));
+        const long peak_bytes = counting_allocator_bytes() - initial_bytes;
+
+        long out;
+        for (long i = 0; i != 10000; ++i)
+            BOOST_REQUIRE(c.pop(out));
+        BOOST_REQUIRE(!c.pop(out));
+
+        /* nodes are reclaimed, while the queue is in use */
+        for (long i = 0; i != 1000; ++i) {
+            BOOST_REQUIRE(c.push(i));
+            BOOST_REQUIRE(c.pop(out));
+            BOOST_REQUIRE_EQUAL(out, i);
+        }
+        BOOST_REQUIRE_LT(counting_allocator_bytes() - initial_bytes, peak_bytes / 10);
+    }
+    BOOST_REQUIRE_EQUAL(counting_allocator_bytes(), initial_bytes);
+
+    /* bounded_push is limited by the number of reserved nodes */
+    Container c(2);
+    BOOST_REQUIRE(c.bounded_push(1));
+    BOOST_REQUIRE(c.bounded_push(2));
+    BOOST_REQUIRE(!c.bounded_push(3));
+    c.reserve(1);
+    BOOST_REQUIRE(c.bounded_push(3));
+}
+
+BOOST_AUTO_TEST_CASE( queue_epoch_reclamation_test )
+{
+    reclamation_test<boost::lockfree::queue<long,
+                                           boost::lockfree::allocator<counting_allocator<long> >,
+                                           boost::lockfree::reclamation<boost::lockfree::epoch_based> > >();
+}
+
+BOOST_AUTO_TEST_CASE( queue_hazard_pointer_reclamation_test )
+{
+    reclamation_test<boost::lockfree::queue<long,
+                                           boost::lockfree::allocator<counting_allocator<long> >,
+                                           boost::lockfree::reclamation<boost::lockfree::hazard_pointers> > >();
+}
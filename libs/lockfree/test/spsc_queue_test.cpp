@@ -306,3 +306,76 @@ BOOST_AUTO_TEST_CASE( spsc_queue_buffer_pop_test )
     spsc_queue_buffer_pop<reference_to_array, 7, 16, 64>();
     spsc_queue_buffer_pop<output_iterator_, 7, 16, 64>();
 }
+
+struct span_collector
+{
+    span_collector(vector<int> & out, size_t & spans):
+        out_(out), spans_(spans)
+    {}
+
+    void operator()(int * first, size_t count) const
+    {
+        out_.insert(out_.end(), first, first + count);
+        spans_ += 1;
+    }
+
+    vector<int> & out_;
+    size_t & spans_;
+};
+
+BOOST_AUTO_TEST_CASE( spsc_queue_consume_all_spans_test )
+{
+    spsc_queue<int> f(8);
+
+    vector<int> out;
+    size_t spans = 0;
+    BOOST_REQUIRE_EQUAL(f.consume_all_spans(span_collector(out, spans)), 0u);
+    BOOST_REQUIRE_EQUAL(spans, 0u);
+
+    int data[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    BOOST_REQUIRE_EQUAL(f.push(data, 6), 6u);
+    BOOST_REQUIRE_EQUAL(f.consume_all_spans(span_collector(out, spans)), 6u);
+    BOOST_REQUIRE_EQUAL(spans, 1u);
+    BOOST_REQUIRE(f.empty());
+
+    /* the elements wrap around the end of the internal buffer */
+    out.clear();
+    spans = 0;
+    BOOST_REQUIRE_EQUAL(f.push(data, 7), 7u);
+    BOOST_REQUIRE_EQUAL(f.consume_all_spans(span_collector(out, spans)), 7u);
+    BOOST_REQUIRE_EQUAL(spans, 2u);
+    BOOST_REQUIRE_EQUAL(out.size(), 7u);
+    for (size_t i = 0; i != out.size(); ++i)
+        BOOST_REQUIRE_EQUAL(out[i], data[i]);
+    BOOST_REQUIRE(f.empty());
+}
+
+BOOST_AUTO_TEST_CASE( spsc_queue_cached_index_test )
+{
+    spsc_queue<int, capacity<3> > f;
+
+    /* fill and drain repeatedly, so that the cached indices lag behind the real ones */
+    int out;
+    for (int round = 0; round != 20; ++round) {
+        BOOST_REQUIRE(f.push(round));
+        BOOST_REQUIRE(f.push(round + 1));
+        BOOST_REQUIRE(f.push(round + 2));
+        BOOST_REQUIRE(!f.push(0));
+
+        BOOST_REQUIRE(f.pop(out));
+        BOOST_REQUIRE_EQUAL(out, round);
+        BOOST_REQUIRE(f.push(round + 3));
+        BOOST_REQUIRE(!f.push(0));
+
+        BOOST_REQUIRE(f.pop(out)); BOOST_REQUIRE_EQUAL(out, round + 1);
+        BOOST_REQUIRE(f.pop(out)); BOOST_REQUIRE_EQUAL(out, round + 2);
+        BOOST_REQUIRE(f.pop(out)); BOOST_REQUIRE_EQUAL(out, round + 3);
+        BOOST_REQUIRE(!f.pop(out));
+    }
+
+    f.reset();
+    BOOST_REQUIRE(f.empty());
+    BOOST_REQUIRE(f.push(1));
+    BOOST_REQUIRE(f.pop(out));
+    BOOST_REQUIRE_EQUAL(out, 1);
+}
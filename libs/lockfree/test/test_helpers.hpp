@@ -7,6 +7,7 @@
 #ifndef BOOST_LOCKFREE_TEST_HELPERS
 #define BOOST_LOCKFREE_TEST_HELPERS
 
+#include <memory>
 #include <set>
 #include <boost/array.hpp>
 #include <boost/lockfree/detail/atomic.hpp>
@@ -106,5 +107,42 @@ struct dummy_functor
     }
 };
 
+/* counts the bytes, which are allocated via any rebound copy of the allocator */
+inline boost::lockfree::detail::atomic<long> & counting_allocator_bytes(void)
+{
+    static boost::lockfree::detail::atomic<long> bytes(0);
+    return bytes;
+}
+
+template <typename T>
+struct counting_allocator:
+    std::allocator<T>
+{
+    template <typename U>
+    struct rebind
+    {
+        typedef counting_allocator<U> other;
+    };
+
+    counting_allocator(void)
+    {}
+
+    template <typename U>
+    counting_allocator(counting_allocator<U> const &)
+    {}
+
+    T * allocate(std::size_t n, void const * /* hint */ = 0)
+    {
+        counting_allocator_bytes() += static_cast<long>(n * sizeof(T));
+        return std::allocator<T>::allocate(n);
+    }
+
+    void deallocate(T * p, std::size_t n)
+    {
+        counting_allocator_bytes() -= static_cast<long>(n * sizeof(T));
+        std::allocator<T>::deallocate(p, n);
+    }
+};
+
 
 #endif
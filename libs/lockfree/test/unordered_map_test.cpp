@@ -0,0 +1,177 @@
+//  Copyright (C) 2013 Tim Blechmann
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/unordered_map.hpp>
+#include <boost/thread.hpp>
+
+#define BOOST_TEST_MAIN
+#ifdef BOOST_LOCKFREE_INCLUDE_TESTS
+#include <boost/test/included/unit_test.hpp>
+#else
+#include <boost/test/unit_test.hpp>
+#endif
+
+#include <string>
+
+#include "test_helpers.hpp"
+
+using namespace boost;
+using namespace boost::lockfree;
+using namespace std;
+
+BOOST_AUTO_TEST_CASE( simple_unordered_map_test )
+{
+    unordered_map<int, int> m;
+
+    BOOST_WARN(m.is_lock_free());
+    BOOST_REQUIRE(m.empty());
+
+    BOOST_REQUIRE(m.insert(1, 10));
+    BOOST_REQUIRE(m.insert(2, 20));
+    BOOST_REQUIRE(!m.insert(1, 11));
+    BOOST_REQUIRE_EQUAL(m.size(), 2u);
+
+    int value = 0;
+    BOOST_REQUIRE(m.find(1, value));
+    BOOST_REQUIRE_EQUAL(value, 10);
+    BOOST_REQUIRE(m.find(2, value));
+    BOOST_REQUIRE_EQUAL(value, 20);
+    BOOST_REQUIRE(!m.find(3, value));
+    BOOST_REQUIRE_EQUAL(m.count(1), 1u);
+    BOOST_REQUIRE_EQUAL(m.count(3), 0u);
+
+    BOOST_REQUIRE(m.erase(1));
+    BOOST_REQUIRE(!m.erase(1));
+    BOOST_REQUIRE(!m.find(1, value));
+    BOOST_REQUIRE_EQUAL(m.size(), 1u);
+
+    BOOST_REQUIRE(m.insert(1, 12));
+    BOOST_REQUIRE(m.find(1, value));
+    BOOST_REQUIRE_EQUAL(value, 12);
+}
+
+BOOST_AUTO_TEST_CASE( unordered_map_string_test )
+{
+    unordered_map<string, string> m;
+
+    BOOST_REQUIRE(m.insert(string("one"), string("eins")));
+    BOOST_REQUIRE(m.insert(string("two"), string("zwei")));
+
+    string value;
+    BOOST_REQUIRE(m.find("one", value));
+    BOOST_REQUIRE_EQUAL(value, "eins");
+    BOOST_REQUIRE(m.erase("two"));
+    BOOST_REQUIRE(!m.find("two", value));
+}
+
+struct constant_hash
+{
+    std::size_t operator()(int) const
+    {
+        return 42;
+    }
+};
+
+BOOST_AUTO_TEST_CASE( unordered_map_collision_test )
+{
+    unordered_map<int, int, constant_hash> m;
+
+    for (int i = 0; i != 100; ++i)
+        BOOST_REQUIRE(m.insert(i, -i));
+    BOOST_REQUIRE(!m.insert(50, 0));
+
+    for (int i = 0; i < 100; i += 2)
+        BOOST_REQUIRE(m.erase(i));
+
+    for (int i = 0; i != 100; ++i) {
+        int value;
+        BOOST_REQUIRE_EQUAL(m.find(i, value), (i % 2) == 1);
+        if (i % 2)
+            BOOST_REQUIRE_EQUAL(value, -i);
+    }
+    BOOST_REQUIRE_EQUAL(m.size(), 50u);
+}
+
+BOOST_AUTO_TEST_CASE( unordered_map_growth_test )
+{
+    const long initial_bytes = counting_allocator_bytes();
+    {
+        unordered_map<long, long, boost::hash<long>, std::equal_to<long>,
+                      lockfree::allocator<counting_allocator<long> > > m(2);
+        BOOST_REQUIRE_EQUAL(m.bucket_count(), 2u);
+
+        for (long i = 0; i != 10000; ++i)
+            BOOST_REQUIRE(m.insert(i, i * 2));
+
+        BOOST_REQUIRE_EQUAL(m.size(), 10000u);
+        BOOST_REQUIRE_GE(m.bucket_count() * 2, m.size());
+
+        for (long i = 0; i != 10000; ++i) {
+            long value;
+            BOOST_REQUIRE(m.find(i, value));
+            BOOST_REQUIRE_EQUAL(value, i * 2);
+        }
+
+        for (long i = 0; i != 10000; ++i)
+            BOOST_REQUIRE(m.erase(i));
+        BOOST_REQUIRE(m.empty());
+    }
+    BOOST_REQUIRE_EQUAL(counting_allocator_bytes(), initial_bytes);
+}
+
+typedef unordered_map<long, long> stress_map;
+
+static const long keys_per_thread = 2000;
+
+void insert_erase_keys(stress_map & m, long first, int rounds)
+{
+    for (int round = 0; round != rounds; ++round) {
+        for (long i = first; i != first + keys_per_thread; ++i)
+            BOOST_REQUIRE(m.insert(i, i + round));
+        for (long i = first; i != first + keys_per_thread; ++i) {
+            long value;
+            BOOST_REQUIRE(m.find(i, value));
+            BOOST_REQUIRE_EQUAL(value, i + round);
+        }
+        for (long i = first; i != first + keys_per_thread; ++i)
+            BOOST_REQUIRE(m.erase(i));
+        boost::this_thread::yield();
+    }
+}
+
+void find_keys(stress_map & m, long key_count, boost::lockfree::detail::atomic<bool> & running, long & mismatches)
+{
+    while (running.load()) {
+        for (long i = 0; i != key_count; ++i) {
+            long value;
+            if (m.find(i, value) && (value < i || value >= i + 10))
+                ++mismatches;
+        }
+        boost::this_thread::yield();
+    }
+}
+
+BOOST_AUTO_TEST_CASE( unordered_map_stress_test )
+{
+    const int writer_threads = 4;
+    stress_map m(4);
+
+    boost::lockfree::detail::atomic<bool> running(true);
+    long mismatches = 0;
+    boost::thread reader(boost::bind(find_keys, boost::ref(m), writer_threads * keys_per_thread, boost::ref(running),
+                                     boost::ref(mismatches)));
+
+    boost::thread_group writers;
+    for (int i = 0; i != writer_threads; ++i)
+        writers.create_thread(boost::bind(insert_erase_keys, boost::ref(m), i * keys_per_thread, 10));
+    writers.join_all();
+
+    running.store(false);
+    reader.join();
+
+    BOOST_REQUIRE_EQUAL(mismatches, 0);
+    BOOST_REQUIRE(m.empty());
+}
@@ -0,0 +1,122 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares the futex based locks with the locks based on pthread mutexes and condition variables.
+// - read mostly: every thread takes the lock in shared mode, but one of write_ratio operations, that writes
+//   shared_mutex vs big_reader_shared_mutex
+// - short critical sections: every thread increments a counter under the lock
+//   mutex vs adaptive_mutex
+
+#define BOOST_THREAD_VERSION 4
+#define BOOST_THREAD_USES_CHRONO
+
+#include <boost/thread/adaptive_mutex.hpp>
+#include <boost/thread/big_reader_shared_mutex.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/chrono/chrono_io.hpp>
+#include <cstdlib>
+#include <iostream>
+
+typedef boost::chrono::high_resolution_clock clock_type;
+
+// read mostly
+
+template <typename SharedMutex>
+struct read_mostly
+{
+  SharedMutex mtx;
+  long data[8];
+
+  read_mostly()
+  {
+    for (int i = 0; i < 8; ++i)
+      data[i] = 0;
+  }
+
+  void run(boost::barrier& start, long iterations, long write_ratio)
+  {
+    long sum = 0;
+    start.count_down_and_wait();
+    for (long i = 0; i < iterations; ++i)
+    {
+      if (write_ratio && i % write_ratio == 0)
+      {
+        mtx.lock();
+        ++data[i % 8];
+        mtx.unlock();
+      }
+      else
+      {
+        mtx.lock_shared();
+        sum += data[i % 8];
+        mtx.unlock_shared();
+      }
+    }
+    if (sum == -1)
+      std::cout << sum;
+  }
+};
+
+// short critical sections
+
+template <typename Mutex>
+struct counting
+{
+  Mutex mtx;
+  long counter;
+
+  counting() : counter(0) {}
+
+  void run(boost::barrier& start, long iterations, long)
+  {
+    start.count_down_and_wait();
+    for (long i = 0; i < iterations; ++i)
+    {
+      mtx.lock();
+      ++counter;
+      mtx.unlock();
+    }
+  }
+};
+
+template <typename Test>
+void measure(const char* name, unsigned threads, long iterations, long write_ratio)
+{
+  Test test;
+  boost::barrier start(threads + 1);
+  boost::thread_group group;
+  for (unsigned i = 0; i < threads; ++i)
+    group.create_thread(boost::bind(&Test::run, &test, boost::ref(start), iterations, write_ratio));
+  start.count_down_and_wait();
+  clock_type::time_point t0 = clock_type::now();
+  group.join_all();
+  clock_type::duration d = clock_type::now() - t0;
+  std::cout << name << ": " << boost::chrono::duration_cast<boost::chrono::milliseconds>(d) << ", "
+            << boost::chrono::duration_cast<boost::chrono::nanoseconds>(d).count() / (long(threads) * iterations)
+            << " ns/op" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  const unsigned threads = argc > 1 ? std::atoi(argv[1]) : boost::thread::hardware_concurrency();
+  const long iterations = argc > 2 ? std::atol(argv[2]) : 1000000;
+  const long write_ratio = argc > 3 ? std::atol(argv[3]) : 1000;
+  std::cout << "threads: " << threads << ", iterations: " << iterations << ", one write every " << write_ratio
+            << " operations" << std::endl;
+
+  measure<read_mostly<boost::shared_mutex> >("read mostly, shared_mutex           ", threads, iterations, write_ratio);
+  measure<read_mostly<boost::big_reader_shared_mutex> >("read mostly, big_reader_shared_mutex", threads, iterations,
+                                                        write_ratio);
+  measure<read_mostly<boost::shared_mutex> >("read only,   shared_mutex           ", threads, iterations, 0);
+  measure<read_mostly<boost::big_reader_shared_mutex> >("read only,   big_reader_shared_mutex", threads, iterations, 0);
+  measure<counting<boost::mutex> >("counting,    mutex                  ", threads, iterations, 0);
+  measure<counting<boost::adaptive_mutex> >("counting,    adaptive_mutex         ", threads, iterations, 0);
+
+  return 0;
+}
@@ -0,0 +1,115 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures chains of future continuations:
+// - then(f), the continuations are run by the thread that sets the value of the promise
+// - then(launch::async, f), every continuation is run by a new thread
+// - then(executor, f), the continuations are submitted to a work_stealing_pool
+// and fan-in of many futures with when_all.
+
+#define BOOST_THREAD_VERSION 4
+#define BOOST_THREAD_USES_CHRONO
+
+#include <boost/thread/future.hpp>
+#include <boost/thread/executors/work_stealing_pool.hpp>
+#include <boost/chrono/chrono_io.hpp>
+#include <cstdlib>
+#include <iostream>
+
+#if defined BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION
+
+typedef boost::chrono::high_resolution_clock clock_type;
+
+int increment(boost::future<int> f)
+{
+  return f.get() + 1;
+}
+
+int sum(boost::future<boost::container::vector<boost::shared_future<int> > > f)
+{
+  boost::container::vector<boost::shared_future<int> > v = f.get();
+  int s = 0;
+  for (std::size_t i = 0; i < v.size(); ++i)
+    s += v[i].get();
+  return s;
+}
+
+template <typename Attach>
+void chain(const char* name, int length, Attach attach)
+{
+  clock_type::time_point start = clock_type::now();
+  boost::promise<int> p;
+  boost::future<int> f = p.get_future();
+  for (int i = 0; i < length; ++i)
+    f = attach(f);
+  p.set_value(0);
+  int result = f.get();
+  std::cout << "chain of " << length << " continuations, " << name << ": "
+            << boost::chrono::duration_cast<boost::chrono::microseconds>(clock_type::now() - start)
+            << " (" << result << ")" << std::endl;
+}
+
+struct attach_inline
+{
+  boost::future<int> operator()(boost::future<int>& f) const
+  {
+    return f.then(&increment);
+  }
+};
+
+struct attach_async
+{
+  boost::future<int> operator()(boost::future<int>& f) const
+  {
+    return f.then(boost::launch::async, &increment);
+  }
+};
+
+struct attach_executor
+{
+  boost::executors::work_stealing_pool* pool;
+  boost::future<int> operator()(boost::future<int>& f) const
+  {
+    return f.then(*pool, &increment);
+  }
+};
+
+int main(int argc, char* argv[])
+{
+  const int length = argc > 1 ? std::atoi(argv[1]) : 10000;
+  const int async_length = argc > 2 ? std::atoi(argv[2]) : 500;
+
+  chain("inline", length, attach_inline());
+  chain("launch::async", async_length, attach_async());
+  {
+    boost::executors::work_stealing_pool pool;
+    attach_executor attach = { &pool };
+    chain("work_stealing_pool", length, attach);
+  }
+
+  {
+    clock_type::time_point start = clock_type::now();
+    boost::container::vector<boost::promise<int> > promises(length);
+    boost::container::vector<boost::shared_future<int> > futures;
+    for (int i = 0; i < length; ++i)
+      futures.push_back(promises[i].get_future().share());
+    boost::future<int> total = boost::when_all(futures.begin(), futures.end()).then(&sum);
+    for (int i = 0; i < length; ++i)
+      promises[i].set_value(1);
+    int result = total.get();
+    std::cout << "when_all of " << length << " futures: "
+              << boost::chrono::duration_cast<boost::chrono::microseconds>(clock_type::now() - start)
+              << " (" << result << ")" << std::endl;
+  }
+  return 0;
+}
+
+#else
+
+int main()
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,129 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares the synchronized queues, with the same number of producer and consumer threads
+// - single: every element is pushed and pulled by its own call
+// - batch: the elements are pushed with push_back and pulled with pull_front in batches of batch_size
+
+#define BOOST_THREAD_VERSION 4
+#define BOOST_THREAD_USES_CHRONO
+
+#include <boost/thread/sync_queue.hpp>
+#include <boost/thread/sync_bounded_queue.hpp>
+#include <boost/thread/sync_lockfree_queue.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/chrono/chrono_io.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+typedef boost::chrono::high_resolution_clock clock_type;
+
+const std::size_t capacity = 1024;
+
+template <typename Queue>
+struct queue_holder
+{
+  Queue q;
+  queue_holder() : q(capacity) {}
+};
+
+template <typename T>
+struct queue_holder<boost::sync_queue<T> >
+{
+  boost::sync_queue<T> q;
+};
+
+template <typename Queue>
+struct transfer
+{
+  queue_holder<Queue> holder;
+  boost::atomic<long> sum;
+
+  transfer() : sum(0) {}
+
+  void produce(boost::barrier& start, long elements, std::size_t batch_size)
+  {
+    std::vector<long> batch(batch_size, 1);
+    start.count_down_and_wait();
+    if (batch_size == 1)
+    {
+      for (long i = 0; i < elements; ++i)
+        holder.q.push(1);
+    }
+    else
+    {
+      for (long i = 0; i < elements; i += batch_size)
+        holder.q.push_back(batch.begin(), batch.end());
+    }
+  }
+
+  void consume(boost::barrier& start, long elements, std::size_t batch_size)
+  {
+    std::vector<long> batch(batch_size);
+    long local = 0;
+    start.count_down_and_wait();
+    for (long i = 0; i < elements; )
+    {
+      if (batch_size == 1)
+      {
+        local += holder.q.pull();
+        ++i;
+      }
+      else
+      {
+        std::size_t n = holder.q.pull_front(batch_size, batch.begin());
+        for (std::size_t j = 0; j < n; ++j)
+          local += batch[j];
+        i += n;
+      }
+    }
+    sum += local;
+  }
+};
+
+template <typename Queue>
+void measure(const char* name, unsigned threads, long elements, std::size_t batch_size)
+{
+  // every producer pushes, and every consumer pulls, a multiple of batch_size elements
+  elements -= elements % batch_size;
+  transfer<Queue> test;
+  boost::barrier start(2 * threads + 1);
+  boost::thread_group group;
+  for (unsigned i = 0; i < threads; ++i)
+  {
+    group.create_thread(boost::bind(&transfer<Queue>::produce, &test, boost::ref(start), elements, batch_size));
+    group.create_thread(boost::bind(&transfer<Queue>::consume, &test, boost::ref(start), elements, batch_size));
+  }
+  start.count_down_and_wait();
+  clock_type::time_point t0 = clock_type::now();
+  group.join_all();
+  clock_type::duration d = clock_type::now() - t0;
+  if (test.sum != long(threads) * elements)
+    std::cout << "error: " << test.sum << " elements transferred" << std::endl;
+  std::cout << name << ": " << boost::chrono::duration_cast<boost::chrono::microseconds>(d) << ", "
+            << boost::chrono::duration_cast<boost::chrono::nanoseconds>(d).count() / (long(threads) * elements)
+            << " ns/element" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  const unsigned threads = argc > 1 ? std::atoi(argv[1]) : boost::thread::hardware_concurrency();
+  const long elements = argc > 2 ? std::atol(argv[2]) : 1000000;
+  const std::size_t batch_size = argc > 3 ? std::atol(argv[3]) : 32;
+  std::cout << "producers/consumers: " << threads << ", elements: " << elements << ", batch size: " << batch_size
+            << std::endl;
+
+  measure<boost::sync_queue<long> >("single, sync_queue         ", threads, elements, 1);
+  measure<boost::sync_queue<long> >("batch,  sync_queue         ", threads, elements, batch_size);
+  measure<boost::sync_bounded_queue<long> >("single, sync_bounded_queue ", threads, elements, 1);
+  measure<boost::sync_bounded_queue<long> >("batch,  sync_bounded_queue ", threads, elements, batch_size);
+  measure<boost::sync_lockfree_queue<long> >("single, sync_lockfree_queue", threads, elements, 1);
+  measure<boost::sync_lockfree_queue<long> >("batch,  sync_lockfree_queue", threads, elements, batch_size);
+
+  return 0;
+}
@@ -0,0 +1,169 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares work_stealing_pool with a pool of threads pulling from a single sync_queue. Both return a future for
+// every task.
+// - fork-join: recursive fibonacci, every call forks one task and helps the pool while waiting for it
+// - tiny tasks: one thread submits many tasks that do almost nothing
+
+#include <boost/config.hpp>
+#if ! defined  BOOST_NO_CXX11_DECLTYPE
+#define BOOST_RESULT_OF_USE_DECLTYPE
+#endif
+
+#define BOOST_THREAD_VERSION 4
+#define BOOST_THREAD_USES_CHRONO
+
+#include <boost/thread/executors/work_stealing_pool.hpp>
+#include <boost/thread/sync_queue.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/chrono/chrono_io.hpp>
+#include <cstdlib>
+#include <iostream>
+
+typedef boost::chrono::high_resolution_clock clock_type;
+
+// the usual hand written pool: every worker pulls from the same queue
+class sync_queue_pool
+{
+public:
+  explicit sync_queue_pool(unsigned thread_count)
+  {
+    for (unsigned i = 0; i < thread_count; ++i)
+      threads_.create_thread(boost::bind(&sync_queue_pool::worker_loop, this));
+  }
+  ~sync_queue_pool()
+  {
+    queue_.close();
+    threads_.join_all();
+  }
+  template <typename F>
+  boost::future<typename boost::result_of<F()>::type> submit(F f)
+  {
+    typedef typename boost::result_of<F()>::type R;
+    boost::shared_ptr<boost::packaged_task<R()> > pt = boost::make_shared<boost::packaged_task<R()> >(f);
+    boost::future<R> ret = pt->get_future();
+    queue_.push(run_task<R>(pt));
+    return boost::move(ret);
+  }
+  bool try_executing_one()
+  {
+    work w;
+    if (! queue_.try_pull(boost::no_block, w))
+      return false;
+    w();
+    return true;
+  }
+
+private:
+  typedef boost::function<void()> work;
+
+  template <typename R>
+  struct run_task
+  {
+    boost::shared_ptr<boost::packaged_task<R()> > pt_;
+    explicit run_task(boost::shared_ptr<boost::packaged_task<R()> > const& pt) : pt_(pt) {}
+    void operator()() const
+    {
+      (*pt_)();
+    }
+  };
+
+  void worker_loop()
+  {
+    try
+    {
+      for (;;)
+        queue_.pull()();
+    }
+    catch (boost::sync_queue_is_closed&)
+    {
+    }
+  }
+
+  boost::sync_queue<work> queue_;
+  boost::thread_group threads_;
+};
+
+// fork-join
+
+template <typename Pool>
+long fib(Pool& pool, int n)
+{
+  if (n < 2)
+    return n;
+  boost::future<long> first = pool.submit(boost::bind(&fib<Pool>, boost::ref(pool), n - 1));
+  long second = fib(pool, n - 2);
+  // help the pool instead of blocking the thread
+  while (! first.is_ready())
+    if (! pool.try_executing_one())
+      boost::this_thread::yield();
+  return first.get() + second;
+}
+
+// tiny tasks
+
+boost::atomic<long> g_done(0);
+
+void tiny_task()
+{
+  g_done.fetch_add(1, boost::memory_order_relaxed);
+}
+
+void wait_for_tiny_tasks(long count)
+{
+  while (g_done.load(boost::memory_order_relaxed) != count)
+    boost::this_thread::yield();
+}
+
+int main(int argc, char* argv[])
+{
+  const unsigned threads = argc > 1 ? std::atoi(argv[1]) : boost::thread::hardware_concurrency();
+  const int fib_n = argc > 2 ? std::atoi(argv[2]) : 24;
+  const long tasks = argc > 3 ? std::atol(argv[3]) : 200000;
+  std::cout << "threads: " << threads << std::endl;
+
+  {
+    boost::executors::work_stealing_pool pool(threads);
+    clock_type::time_point start = clock_type::now();
+    long result = pool.submit(boost::bind(&fib<boost::executors::work_stealing_pool>, boost::ref(pool), fib_n)).get();
+    std::cout << "fork-join fib(" << fib_n << ") = " << result << ", work_stealing_pool: "
+              << boost::chrono::duration_cast<boost::chrono::milliseconds>(clock_type::now() - start) << std::endl;
+  }
+  {
+    sync_queue_pool pool(threads);
+    clock_type::time_point start = clock_type::now();
+    long result = pool.submit(boost::bind(&fib<sync_queue_pool>, boost::ref(pool), fib_n)).get();
+    std::cout << "fork-join fib(" << fib_n << ") = " << result << ", sync_queue pool:   "
+              << boost::chrono::duration_cast<boost::chrono::milliseconds>(clock_type::now() - start) << std::endl;
+  }
+
+  {
+    g_done = 0;
+    boost::executors::work_stealing_pool pool(threads);
+    clock_type::time_point start = clock_type::now();
+    for (long i = 0; i < tasks; ++i)
+      pool.submit(&tiny_task);
+    wait_for_tiny_tasks(tasks);
+    std::cout << tasks << " tiny tasks, work_stealing_pool: "
+              << boost::chrono::duration_cast<boost::chrono::milliseconds>(clock_type::now() - start) << std::endl;
+  }
+  {
+    g_done = 0;
+    sync_queue_pool pool(threads);
+    clock_type::time_point start = clock_type::now();
+    for (long i = 0; i < tasks; ++i)
+      pool.submit(&tiny_task);
+    wait_for_tiny_tasks(tasks);
+    std::cout << tasks << " tiny tasks, sync_queue pool:   "
+              << boost::chrono::duration_cast<boost::chrono::milliseconds>(clock_type::now() - start) << std::endl;
+  }
+
+  return 0;
+}
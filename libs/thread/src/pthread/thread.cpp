@@ -26,6 +26,12 @@
 #elif defined BOOST_HAS_UNISTD_H
 #include <unistd.h>
 #endif
+#if defined(__linux__)
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#endif
 
 #include "./timeconv.inl"
 
@@ -157,6 +163,10 @@ namespace boost
                 boost::detail::thread_data_ptr thread_info = static_cast<boost::detail::thread_data_base*>(param)->self;
                 thread_info->self.reset();
                 detail::set_current_thread_data(thread_info.get());
+                if (thread_info->name[0])
+                {
+                    this_thread::set_name(thread_info->name);
+                }
 #if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
                 BOOST_TRY
                 {
@@ -249,6 +259,7 @@ namespace boost
     bool thread::start_thread_noexcept(const attributes& attr)
     {
         thread_info->self=thread_info;
+        std::strcpy(thread_info->name, attr.get_name());
         const attributes::native_handle_type* h = attr.native_handle();
         int res = pthread_create(&thread_info->thread_handle, h, &thread_proxy, thread_info.get());
         if (res != 0)
@@ -517,6 +528,38 @@ namespace boost
             hiden::sleep_for(ts);
 #   endif
         }
+
+        bool set_affinity(unsigned cpu) BOOST_NOEXCEPT
+        {
+            return set_affinity(&cpu, &cpu + 1);
+        }
+
+        bool set_numa_node(unsigned node) BOOST_NOEXCEPT
+        {
+#if defined BOOST_THREAD_HAS_AFFINITY
+            cpu_set_t cpus;
+            return detail::make_numa_node_cpu_set(node, cpus)
+                && pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+#else
+            (void)node;
+            return false;
+#endif
+        }
+
+        bool set_name(const char* name) BOOST_NOEXCEPT
+        {
+            // Linux refuses names longer than 15 characters instead of truncating them
+            char truncated[16];
+            std::strncpy(truncated, name, sizeof(truncated) - 1);
+            truncated[sizeof(truncated) - 1] = '\0';
+#if defined(__linux__) && defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 12))
+            return pthread_setname_np(pthread_self(), truncated) == 0;
+#elif defined(__APPLE__)
+            return pthread_setname_np(truncated) == 0;
+#else
+            return false;
+#endif
+        }
     }
     unsigned thread::hardware_concurrency() BOOST_NOEXCEPT
     {
@@ -536,6 +579,231 @@ namespace boost
 #endif
     }
 
+#if defined(__linux__)
+    namespace
+    {
+        // Reads the first line of a sysfs file. Returns false, if it cannot be read.
+        bool read_sysfs(std::string const& path, std::string& value)
+        {
+            std::ifstream file(path.c_str());
+            return !!std::getline(file, value);
+        }
+
+        template <typename T>
+        bool read_sysfs(std::string const& path, T& value)
+        {
+            std::string line;
+            if (!read_sysfs(path, line)) return false;
+            std::istringstream in(line);
+            return !!(in >> value);
+        }
+
+        std::string id_string(unsigned id)
+        {
+            std::ostringstream out;
+            out << id;
+            return out.str();
+        }
+
+        // Parses a CPU or node list such as "0-3,8,10-11".
+        bool parse_list(std::string const& list, std::vector<unsigned>& ids)
+        {
+            std::istringstream in(list);
+            unsigned first, last;
+            while (in >> first)
+            {
+                last = first;
+                if (in.peek() == '-')
+                {
+                    in.get();
+                    if (!(in >> last)) return false;
+                }
+                for (unsigned id = first; id <= last; ++id)
+                {
+                    ids.push_back(id);
+                }
+                if (in.peek() != ',') break;
+                in.get();
+            }
+            return !ids.empty();
+        }
+
+        bool read_sysfs_list(std::string const& path, std::vector<unsigned>& ids)
+        {
+            std::string list;
+            return read_sysfs(path, list) && parse_list(list, ids);
+        }
+
+        struct cache_info
+        {
+            std::size_t size;
+            std::size_t line_size;
+            unsigned sharing;
+        };
+
+        // Describes the data or unified cache of the given level of the first CPU, the other ones are assumed to
+        // be alike.
+        bool find_cache(unsigned level, cache_info& info)
+        {
+            const std::string cpu0 = "/sys/devices/system/cpu/cpu0/cache/index";
+            for (unsigned index = 0; ; ++index)
+            {
+                const std::string dir = cpu0 + id_string(index) + "/";
+                unsigned cache_level;
+                if (!read_sysfs(dir + "level", cache_level)) return false;
+                std::string type;
+                if (cache_level != level || !read_sysfs(dir + "type", type) || type == "Instruction") continue;
+
+                // the size is given in KiB, as in "32K"
+                std::string size;
+                if (!read_sysfs(dir + "size", size)) return false;
+                std::istringstream in(size);
+                std::size_t kib = 0;
+                in >> kib;
+                info.size = in.peek() == 'M' ? kib * 1024 * 1024 : kib * 1024;
+                info.line_size = 0;
+                read_sysfs(dir + "coherency_line_size", info.line_size);
+                std::vector<unsigned> cpus;
+                info.sharing = read_sysfs_list(dir + "shared_cpu_list", cpus) ? static_cast<unsigned>(cpus.size()) : 0;
+                return true;
+            }
+        }
+    }
+#endif
+
+#if defined BOOST_THREAD_HAS_AFFINITY
+    namespace detail
+    {
+        bool make_numa_node_cpu_set(unsigned node, cpu_set_t& cpus) BOOST_NOEXCEPT
+        {
+            BOOST_TRY
+            {
+                std::vector<unsigned> ids;
+                return read_sysfs_list("/sys/devices/system/node/node" + id_string(node) + "/cpulist", ids)
+                    && make_cpu_set(ids.begin(), ids.end(), cpus);
+            }
+            BOOST_CATCH(...)
+            {
+                return false;
+            }
+            BOOST_CATCH_END
+        }
+    }
+#endif
+
+    unsigned thread::physical_concurrency() BOOST_NOEXCEPT
+    {
+#if defined(__linux__)
+        BOOST_TRY
+        {
+            // the cores are identified by their package and their number in the package
+            std::vector<unsigned> cpus;
+            if (!read_sysfs_list("/sys/devices/system/cpu/online", cpus)) return hardware_concurrency();
+            std::set<std::pair<unsigned, unsigned> > cores;
+            for (std::vector<unsigned>::const_iterator it = cpus.begin(); it != cpus.end(); ++it)
+            {
+                const std::string dir = "/sys/devices/system/cpu/cpu" + id_string(*it) + "/topology/";
+                std::pair<unsigned, unsigned> core;
+                if (!read_sysfs(dir + "physical_package_id", core.first) || !read_sysfs(dir + "core_id", core.second))
+                {
+                    return hardware_concurrency();
+                }
+                cores.insert(core);
+            }
+            return static_cast<unsigned>(cores.size());
+        }
+        BOOST_CATCH(...)
+        {
+            return hardware_concurrency();
+        }
+        BOOST_CATCH_END
+#elif defined(__APPLE__)
+        int count;
+        size_t size=sizeof(count);
+        return sysctlbyname("hw.physicalcpu",&count,&size,NULL,0)?0:count;
+#else
+        return hardware_concurrency();
+#endif
+    }
+
+    unsigned thread::numa_node_count() BOOST_NOEXCEPT
+    {
+#if defined(__linux__)
+        BOOST_TRY
+        {
+            std::vector<unsigned> nodes;
+            return read_sysfs_list("/sys/devices/system/node/online", nodes) ? static_cast<unsigned>(nodes.size()) : 0;
+        }
+        BOOST_CATCH(...)
+        {
+            return 0;
+        }
+        BOOST_CATCH_END
+#else
+        return 0;
+#endif
+    }
+
+    std::size_t thread::cache_line_size() BOOST_NOEXCEPT
+    {
+#if defined(__linux__)
+        BOOST_TRY
+        {
+            cache_info info;
+            return find_cache(1, info) ? info.line_size : 0;
+        }
+        BOOST_CATCH(...)
+        {
+            return 0;
+        }
+        BOOST_CATCH_END
+#elif defined(__APPLE__)
+        size_t line_size;
+        size_t size=sizeof(line_size);
+        return sysctlbyname("hw.cachelinesize",&line_size,&size,NULL,0)?0:line_size;
+#else
+        return 0;
+#endif
+    }
+
+    std::size_t thread::cache_size(unsigned level) BOOST_NOEXCEPT
+    {
+#if defined(__linux__)
+        BOOST_TRY
+        {
+            cache_info info;
+            return find_cache(level, info) ? info.size : 0;
+        }
+        BOOST_CATCH(...)
+        {
+            return 0;
+        }
+        BOOST_CATCH_END
+#else
+        (void)level;
+        return 0;
+#endif
+    }
+
+    unsigned thread::cache_sharing(unsigned level) BOOST_NOEXCEPT
+    {
+#if defined(__linux__)
+        BOOST_TRY
+        {
+            cache_info info;
+            return find_cache(level, info) ? info.sharing : 0;
+        }
+        BOOST_CATCH(...)
+        {
+            return 0;
+        }
+        BOOST_CATCH_END
+#else
+        (void)level;
+        return 0;
+#endif
+    }
+
 #if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
     void thread::interrupt()
     {
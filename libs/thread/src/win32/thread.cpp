@@ -52,6 +52,28 @@ namespace boost
             (*i)->make_ready();
         }
     }
+
+    bool numa_node_affinity_mask(unsigned node, boost::uint64_t& mask) BOOST_NOEXCEPT
+    {
+      // GetNumaNodeProcessorMask is not declared for the Windows version targeted here
+      typedef BOOL (WINAPI *get_numa_node_processor_mask_t)(UCHAR, PULONGLONG);
+      HMODULE const kernel32 = GetModuleHandleA("kernel32.dll");
+      get_numa_node_processor_mask_t const get_numa_node_processor_mask = kernel32 ?
+          reinterpret_cast<get_numa_node_processor_mask_t>(GetProcAddress(kernel32, "GetNumaNodeProcessorMask")) : 0;
+      ULONGLONG node_mask = 0;
+      if (!get_numa_node_processor_mask || node > 0xff || !get_numa_node_processor_mask(static_cast<UCHAR>(node), &node_mask)
+          || node_mask == 0)
+      {
+        return false;
+      }
+      mask = node_mask;
+      return true;
+    }
+
+    bool set_current_thread_affinity_mask(boost::uint64_t mask) BOOST_NOEXCEPT
+    {
+      return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(mask)) != 0;
+    }
   }
 
     namespace
@@ -259,6 +281,10 @@ namespace boost
       }
       intrusive_ptr_add_ref(thread_info.get());
       thread_info->thread_handle=(detail::win32::handle)(new_thread);
+      if (attr.native_handle()->affinity_mask)
+      {
+        SetThreadAffinityMask(thread_info->thread_handle, static_cast<DWORD_PTR>(attr.native_handle()->affinity_mask));
+      }
       ResumeThread(thread_info->thread_handle);
       return true;
     }
@@ -410,6 +436,33 @@ namespace boost
     }
 #endif
 
+    // The topology functions of Windows are not available for the Windows versions this library is built for, only
+    // the number of logical processors is known.
+    unsigned thread::physical_concurrency() BOOST_NOEXCEPT
+    {
+        return hardware_concurrency();
+    }
+
+    unsigned thread::numa_node_count() BOOST_NOEXCEPT
+    {
+        return 0;
+    }
+
+    std::size_t thread::cache_line_size() BOOST_NOEXCEPT
+    {
+        return 0;
+    }
+
+    std::size_t thread::cache_size(unsigned) BOOST_NOEXCEPT
+    {
+        return 0;
+    }
+
+    unsigned thread::cache_sharing(unsigned) BOOST_NOEXCEPT
+    {
+        return 0;
+    }
+
     thread::native_handle_type thread::native_handle()
     {
         detail::thread_data_ptr local_thread_info=(get_thread_info)();
@@ -613,6 +666,22 @@ namespace boost
             detail::win32::Sleep(0);
         }
 
+        bool set_affinity(unsigned cpu) BOOST_NOEXCEPT
+        {
+            return set_affinity(&cpu, &cpu + 1);
+        }
+
+        bool set_numa_node(unsigned node) BOOST_NOEXCEPT
+        {
+            boost::uint64_t mask;
+            return detail::numa_node_affinity_mask(node, mask) && detail::set_current_thread_affinity_mask(mask);
+        }
+
+        bool set_name(const char*) BOOST_NOEXCEPT
+        {
+            return false;
+        }
+
 #if defined BOOST_THREAD_PROVIDES_INTERRUPTIONS
         disable_interruption::disable_interruption() BOOST_NOEXCEPT:
             interruption_was_enabled(interruption_enabled())
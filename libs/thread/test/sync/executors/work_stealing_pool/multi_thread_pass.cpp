@@ -0,0 +1,83 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/executors/work_stealing_pool.hpp>
+
+// class work_stealing_pool
+
+//    fork-join, concurrent submit, ~work_stealing_pool();
+
+#include <boost/config.hpp>
+#if ! defined  BOOST_NO_CXX11_DECLTYPE
+#define BOOST_RESULT_OF_USE_DECLTYPE
+#endif
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/executors/work_stealing_pool.hpp>
+#include <boost/thread/thread_only.hpp>
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+
+#include <boost/detail/lightweight_test.hpp>
+
+struct fib
+{
+  boost::executors::work_stealing_pool& pool_;
+  int n_;
+  fib(boost::executors::work_stealing_pool& pool, int n) : pool_(pool), n_(n) {}
+  typedef long result_type;
+  long operator()() const
+  {
+    if (n_ < 2)
+      return n_;
+    boost::future<long> first = pool_.submit(fib(pool_, n_ - 1));
+    long second = fib(pool_, n_ - 2)();
+    // help the pool instead of blocking the worker
+    while (! first.is_ready())
+    {
+      if (! pool_.try_executing_one())
+        boost::this_thread::yield();
+    }
+    return first.get() + second;
+  }
+};
+
+boost::atomic<int> g_counter(0);
+
+void increment()
+{
+  g_counter.fetch_add(1, boost::memory_order_relaxed);
+}
+
+void submit_increments(boost::executors::work_stealing_pool& pool, int count)
+{
+  for (int i = 0; i < count; ++i)
+    pool.submit_to(i, &increment);
+}
+
+int main()
+{
+  {
+    // recursive fork-join
+    boost::executors::work_stealing_pool pool(4);
+    boost::future<long> f = pool.submit(fib(pool, 18));
+    BOOST_TEST_EQ(f.get(), 2584);
+  }
+  {
+    // concurrent submissions from several threads, the destructor runs all pending tasks
+    g_counter = 0;
+    {
+      boost::executors::work_stealing_pool pool(3);
+      boost::thread t1(boost::bind(&submit_increments, boost::ref(pool), 5000));
+      boost::thread t2(boost::bind(&submit_increments, boost::ref(pool), 5000));
+      submit_increments(pool, 5000);
+      t1.join();
+      t2.join();
+    }
+    BOOST_TEST_EQ(g_counter.load(), 15000);
+  }
+  return boost::report_errors();
+}
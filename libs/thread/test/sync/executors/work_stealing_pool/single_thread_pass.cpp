@@ -0,0 +1,114 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/executors/work_stealing_pool.hpp>
+
+// class work_stealing_pool
+
+//    submit(f), submit_to(i, f), close();
+
+#include <boost/config.hpp>
+#if ! defined  BOOST_NO_CXX11_DECLTYPE
+#define BOOST_RESULT_OF_USE_DECLTYPE
+#endif
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/executors/work_stealing_pool.hpp>
+
+#include <boost/detail/lightweight_test.hpp>
+#include <stdexcept>
+
+int f42()
+{
+  return 42;
+}
+
+int g_called = 0;
+void set_called()
+{
+  g_called = 1;
+}
+
+int throw_runtime_error()
+{
+  throw std::runtime_error("task");
+}
+
+struct worker_index
+{
+  boost::executors::work_stealing_pool& pool_;
+  explicit worker_index(boost::executors::work_stealing_pool& pool) : pool_(pool) {}
+  typedef std::size_t result_type;
+  std::size_t operator()() const
+  {
+    return pool_.this_worker_index();
+  }
+};
+
+int main()
+{
+  {
+    // default pool invariants
+    boost::executors::work_stealing_pool pool;
+    BOOST_TEST(pool.size() >= 1u);
+    BOOST_TEST(! pool.closed());
+    BOOST_TEST_EQ(pool.this_worker_index(), pool.size());
+  }
+  {
+    // submit returns the result through the future
+    boost::executors::work_stealing_pool pool(2);
+    BOOST_TEST_EQ(pool.size(), 2u);
+    boost::future<int> f = pool.submit(&f42);
+    BOOST_TEST_EQ(f.get(), 42);
+  }
+  {
+    // void tasks
+    boost::executors::work_stealing_pool pool(2);
+    boost::future<void> f = pool.submit(&set_called);
+    f.get();
+    BOOST_TEST_EQ(g_called, 1);
+  }
+  {
+    // exceptions are transported to the future
+    boost::executors::work_stealing_pool pool(1);
+    boost::future<int> f = pool.submit(&throw_runtime_error);
+    bool thrown = false;
+    try
+    {
+      f.get();
+    }
+    catch (std::runtime_error&)
+    {
+      thrown = true;
+    }
+    BOOST_TEST(thrown);
+  }
+  {
+    // tasks run on a worker of the pool, the hinted one unless they have been stolen
+    boost::executors::work_stealing_pool pool(3);
+    boost::future<std::size_t> f = pool.submit_to(1, worker_index(pool));
+    BOOST_TEST(f.get() < 3u);
+    boost::future<std::size_t> g = pool.submit_to(4, worker_index(pool));
+    BOOST_TEST(g.get() < 3u);
+  }
+  {
+    // submit after close fails
+    boost::executors::work_stealing_pool pool(2);
+    pool.close();
+    BOOST_TEST(pool.closed());
+    bool thrown = false;
+    try
+    {
+      pool.submit(&f42);
+    }
+    catch (boost::sync_queue_is_closed&)
+    {
+      thrown = true;
+    }
+    BOOST_TEST(thrown);
+  }
+  return boost::report_errors();
+}
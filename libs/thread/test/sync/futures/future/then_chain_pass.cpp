@@ -0,0 +1,124 @@
+// Copyright (C) 2013 Vicente Botet
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/future.hpp>
+
+// class future<R>
+
+// template<typename F>
+// auto then(F&& func) -> future<decltype(func(*this))>;
+
+// The continuations are run by the thread that makes the future ready, without creating threads.
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/future.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <stdexcept>
+
+#if defined BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION
+
+boost::thread::id continuation_thread;
+
+int increment(boost::future<int> f)
+{
+  continuation_thread = boost::this_thread::get_id();
+  return f.get() + 1;
+}
+
+int increment_shared(boost::shared_future<int> f)
+{
+  return f.get() + 1;
+}
+
+int throw_logic_error(boost::future<int> f)
+{
+  f.get();
+  throw std::logic_error("continuation");
+}
+
+int one()
+{
+  return 1;
+}
+
+void set_value(boost::promise<int>* p)
+{
+  p->set_value(0);
+}
+
+int main()
+{
+  const int chain_length = 10000;
+  {
+    // the whole chain is run by set_value, deep chains must not overflow the stack
+    boost::promise<int> p;
+    boost::future<int> f = p.get_future();
+    for (int i = 0; i < chain_length; ++i)
+      f = f.then(&increment);
+    BOOST_TEST(! f.is_ready());
+    p.set_value(0);
+    BOOST_TEST(f.is_ready());
+    BOOST_TEST(f.get() == chain_length);
+    BOOST_TEST(continuation_thread == boost::this_thread::get_id());
+  }
+  {
+    // the parent is ready, the continuation is run by then()
+    boost::future<int> f = boost::make_ready_future(1);
+    for (int i = 0; i < chain_length; ++i)
+      f = f.then(&increment);
+    BOOST_TEST(f.is_ready());
+    BOOST_TEST(f.get() == chain_length + 1);
+  }
+  {
+    // the continuation is run by the thread that sets the value
+    boost::promise<int> p;
+    boost::future<int> f = p.get_future().then(&increment);
+    boost::thread t(&set_value, &p);
+    boost::thread::id setter = t.get_id();
+    BOOST_TEST(f.get() == 1);
+    t.join();
+    BOOST_TEST(continuation_thread == setter);
+  }
+  {
+    // the continuations of a shared_future are all run
+    boost::promise<int> p;
+    boost::shared_future<int> sf = p.get_future().share();
+    boost::future<int> f1 = sf.then(&increment_shared);
+    boost::future<int> f2 = sf.then(&increment_shared);
+    p.set_value(1);
+    BOOST_TEST(f1.get() == 2);
+    BOOST_TEST(f2.get() == 2);
+  }
+  {
+    // exceptions are propagated along the chain
+    boost::promise<int> p;
+    boost::future<int> f = p.get_future().then(&throw_logic_error).then(&increment);
+    p.set_value(0);
+    try
+    {
+      f.get();
+      BOOST_TEST(false);
+    }
+    catch (std::logic_error&)
+    {
+    }
+  }
+  {
+    // the continuation releases the last reference to the async state on its own thread
+    boost::future<int> f = boost::async(boost::launch::async, &one).then(&increment);
+    BOOST_TEST(f.get() == 2);
+  }
+
+  return boost::report_errors();
+}
+
+#else
+
+int main()
+{
+  return 0;
+}
+#endif
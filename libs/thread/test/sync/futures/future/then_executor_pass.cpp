@@ -0,0 +1,81 @@
+// Copyright (C) 2013 Vicente Botet
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/future.hpp>
+
+// class future<R>
+
+// template<typename Ex, typename F>
+// auto then(Ex& ex, F&& func) -> future<decltype(func(*this))>;
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/future.hpp>
+#include <boost/thread/executors/work_stealing_pool.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#if defined BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION
+
+boost::executors::work_stealing_pool* pool = 0;
+
+int increment(boost::future<int> f)
+{
+  BOOST_TEST(pool->this_worker_index() < pool->size());
+  return f.get() + 1;
+}
+
+void check(boost::shared_future<int> f)
+{
+  BOOST_TEST(pool->this_worker_index() < pool->size());
+  BOOST_TEST(f.get() == 1);
+}
+
+int main()
+{
+  {
+    boost::executors::work_stealing_pool ex(2);
+    pool = &ex;
+    boost::promise<int> p;
+    boost::future<int> f = p.get_future();
+    for (int i = 0; i < 100; ++i)
+      f = f.then(ex, &increment);
+    p.set_value(0);
+    BOOST_TEST(f.get() == 100);
+  }
+  {
+    boost::executors::work_stealing_pool ex(2);
+    pool = &ex;
+    boost::shared_future<int> sf = boost::make_ready_future(1).share();
+    boost::future<void> f = sf.then(ex, &check);
+    f.get();
+  }
+  {
+    // a closed executor breaks the continuation
+    boost::executors::work_stealing_pool ex(1);
+    pool = &ex;
+    boost::promise<int> p;
+    boost::future<int> f = p.get_future().then(ex, &increment);
+    ex.close();
+    p.set_value(0);
+    try
+    {
+      f.get();
+      BOOST_TEST(false);
+    }
+    catch (boost::sync_queue_is_closed&)
+    {
+    }
+  }
+
+  return boost::report_errors();
+}
+
+#else
+
+int main()
+{
+  return 0;
+}
+#endif
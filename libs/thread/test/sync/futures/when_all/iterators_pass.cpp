@@ -0,0 +1,87 @@
+// Copyright (C) 2013 Vicente Botet
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/future.hpp>
+
+// template <class InputIterator>
+// future<vector<typename InputIterator::value_type>>
+//    when_all(InputIterator first, InputIterator last);
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/future.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <stdexcept>
+
+#if defined BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION
+
+int sum(boost::future<boost::container::vector<boost::shared_future<int> > > f)
+{
+  boost::container::vector<boost::shared_future<int> > v = f.get();
+  int s = 0;
+  for (std::size_t i = 0; i < v.size(); ++i)
+    s += v[i].get();
+  return s;
+}
+
+int main()
+{
+  // in C++03 the vector of the result can only be moved out of the future, if it contains shared_futures
+#if ! defined BOOST_NO_CXX11_RVALUE_REFERENCES
+  {
+    boost::promise<int> p1, p2, p3;
+    boost::container::vector<boost::future<int> > v;
+    v.push_back(p1.get_future());
+    v.push_back(p2.get_future());
+    v.push_back(p3.get_future());
+    boost::future<boost::container::vector<boost::future<int> > > all = boost::when_all(v.begin(), v.end());
+    BOOST_TEST(! v[0].valid());
+    BOOST_TEST(! all.is_ready());
+    p2.set_value(2);
+    p1.set_value(1);
+    BOOST_TEST(! all.is_ready());
+    p3.set_exception(boost::copy_exception(std::logic_error("p3")));
+    BOOST_TEST(all.is_ready());
+    boost::container::vector<boost::future<int> > r = all.get();
+    BOOST_TEST(r.size() == 3);
+    BOOST_TEST(r[0].get() == 1);
+    BOOST_TEST(r[1].get() == 2);
+    BOOST_TEST(r[2].has_exception());
+  }
+#endif
+  {
+    // shared_futures are copied
+    boost::promise<int> p1, p2;
+    boost::shared_future<int> v[2] = { p1.get_future().share(), p2.get_future().share() };
+    boost::future<boost::container::vector<boost::shared_future<int> > > all = boost::when_all(v, v + 2);
+    BOOST_TEST(v[0].valid());
+    p1.set_value(1);
+    p2.set_value(2);
+    BOOST_TEST(all.get()[1].get() == 2);
+  }
+  {
+    // the parents are ready already, and the result can be chained
+    boost::container::vector<boost::shared_future<int> > v;
+    for (int i = 1; i <= 10; ++i)
+      v.push_back(boost::make_ready_future(i).share());
+    BOOST_TEST(boost::when_all(v.begin(), v.end()).then(&sum).get() == 55);
+  }
+  {
+    boost::container::vector<boost::shared_future<int> > v;
+    boost::future<boost::container::vector<boost::shared_future<int> > > all = boost::when_all(v.begin(), v.end());
+    BOOST_TEST(all.is_ready());
+    BOOST_TEST(all.get().empty());
+  }
+
+  return boost::report_errors();
+}
+
+#else
+
+int main()
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,78 @@
+// Copyright (C) 2013 Vicente Botet
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/future.hpp>
+
+// template <class InputIterator>
+// future<vector<typename InputIterator::value_type>>
+//    when_any(InputIterator first, InputIterator last);
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/future.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#if defined BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION
+
+void set_value(boost::promise<int>* p, int i)
+{
+  p->set_value(i);
+}
+
+int main()
+{
+  // in C++03 the vector of the result can only be moved out of the future, if it contains shared_futures
+#if ! defined BOOST_NO_CXX11_RVALUE_REFERENCES
+  {
+    boost::promise<int> p1, p2, p3;
+    boost::container::vector<boost::future<int> > v;
+    v.push_back(p1.get_future());
+    v.push_back(p2.get_future());
+    v.push_back(p3.get_future());
+    boost::future<boost::container::vector<boost::future<int> > > any = boost::when_any(v.begin(), v.end());
+    BOOST_TEST(! v[0].valid());
+    BOOST_TEST(! any.is_ready());
+    p2.set_value(2);
+    BOOST_TEST(any.is_ready());
+    boost::container::vector<boost::future<int> > r = any.get();
+    BOOST_TEST(r.size() == 3);
+    BOOST_TEST(! r[0].is_ready());
+    BOOST_TEST(r[1].get() == 2);
+    // the other futures still become ready
+    p1.set_value(1);
+    p3.set_value(3);
+    BOOST_TEST(r[0].get() == 1);
+    BOOST_TEST(r[2].get() == 3);
+  }
+#endif
+  {
+    boost::promise<int> p1, p2;
+    boost::shared_future<int> v[2] = { p1.get_future().share(), p2.get_future().share() };
+    boost::future<boost::container::vector<boost::shared_future<int> > > any = boost::when_any(v, v + 2);
+    boost::thread t1(&set_value, &p1, 1);
+    boost::thread t2(&set_value, &p2, 2);
+    boost::container::vector<boost::shared_future<int> > r = any.get();
+    BOOST_TEST(r[0].is_ready() || r[1].is_ready());
+    t1.join();
+    t2.join();
+    BOOST_TEST(v[0].get() == 1);
+  }
+  {
+    boost::container::vector<boost::shared_future<int> > v;
+    v.push_back(boost::make_ready_future(1).share());
+    v.push_back(boost::promise<int>().get_future().share());
+    BOOST_TEST(boost::when_any(v.begin(), v.end()).get()[0].get() == 1);
+  }
+
+  return boost::report_errors();
+}
+
+#else
+
+int main()
+{
+  return 0;
+}
+#endif
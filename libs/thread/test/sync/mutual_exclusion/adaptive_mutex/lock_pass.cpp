@@ -0,0 +1,60 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/adaptive_mutex.hpp>
+
+// class adaptive_mutex;
+
+// void lock();
+// void unlock();
+
+// Several threads increment a counter under the lock. Some critical sections are long enough that the waiters
+// stop spinning and sleep.
+
+#include <boost/thread/adaptive_mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+boost::adaptive_mutex m;
+long counter = 0;
+
+const int thread_count = 4;
+const int iterations = 20000;
+
+void f()
+{
+  for (int i = 0; i < iterations; ++i)
+  {
+    boost::lock_guard<boost::adaptive_mutex> lk(m);
+    long c = counter;
+    if (i % 1000 == 0)
+      boost::this_thread::yield();
+    counter = c + 1;
+  }
+}
+
+int main()
+{
+  {
+    boost::thread_group threads;
+    for (int i = 0; i < thread_count; ++i)
+      threads.create_thread(&f);
+    threads.join_all();
+    BOOST_TEST_EQ(counter, long(thread_count) * iterations);
+  }
+  {
+    m.lock();
+    boost::thread t(&f);
+    boost::this_thread::sleep(boost::posix_time::milliseconds(250));
+    BOOST_TEST_EQ(counter, long(thread_count) * iterations);
+    m.unlock();
+    t.join();
+    BOOST_TEST_EQ(counter, long(thread_count + 1) * iterations);
+  }
+
+  return boost::report_errors();
+}
+
@@ -0,0 +1,75 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/adaptive_mutex.hpp>
+
+// class adaptive_mutex;
+
+// bool try_lock();
+// template <class Rep, class Period>
+//     bool try_lock_for(const chrono::duration<Rep, Period>& rel_time);
+// template <class Clock, class Duration>
+//     bool try_lock_until(const chrono::time_point<Clock, Duration>& abs_time);
+
+#include <boost/thread/adaptive_mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+boost::adaptive_mutex m;
+
+#if defined BOOST_THREAD_USES_CHRONO
+typedef boost::chrono::steady_clock Clock;
+typedef Clock::time_point time_point;
+typedef boost::chrono::milliseconds ms;
+typedef boost::chrono::nanoseconds ns;
+
+void times_out()
+{
+  BOOST_TEST(!m.try_lock());
+  time_point t0 = Clock::now();
+  BOOST_TEST(!m.try_lock_for(ms(250)));
+  time_point t1 = Clock::now();
+  BOOST_TEST(t1 - t0 >= ms(250));
+  // This test is spurious as it depends on the time the thread system switches the threads
+  BOOST_TEST(t1 - t0 < ms(250) + ms(1000));
+}
+
+void gets_the_lock()
+{
+  time_point t0 = Clock::now();
+  BOOST_TEST(m.try_lock_until(Clock::now() + ms(250) + ms(1000)));
+  time_point t1 = Clock::now();
+  m.unlock();
+  // This test is spurious as it depends on the time the thread system switches the threads
+  BOOST_TEST(t1 - t0 < ms(250) + ms(1000));
+}
+#endif
+
+int main()
+{
+  BOOST_TEST(m.try_lock());
+  BOOST_TEST(!m.try_lock());
+  m.unlock();
+#if defined BOOST_THREAD_USES_CHRONO
+  {
+    m.lock();
+    boost::thread t(times_out);
+    t.join();
+    m.unlock();
+  }
+  {
+    m.lock();
+    boost::thread t(gets_the_lock);
+    boost::this_thread::sleep_for(ms(250));
+    m.unlock();
+    t.join();
+  }
+  BOOST_TEST(m.try_lock_for(ms(10)));
+  m.unlock();
+#endif
+
+  return boost::report_errors();
+}
+
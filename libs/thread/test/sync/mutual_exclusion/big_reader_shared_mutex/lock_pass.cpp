@@ -0,0 +1,116 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/big_reader_shared_mutex.hpp>
+
+// class big_reader_shared_mutex;
+
+// void lock_shared();
+// void unlock_shared();
+// void lock();
+// void unlock();
+
+// Readers and writers check that no writer runs concurrently with any other thread, while several readers may
+// hold the lock at the same time. The readers may migrate between CPUs while they hold the lock.
+
+#include <boost/thread/big_reader_shared_mutex.hpp>
+#include <boost/thread/lock_types.hpp>
+#include <boost/thread/shared_lock_guard.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/atomic.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+boost::big_reader_shared_mutex m;
+boost::atomic<int> readers(0);
+boost::atomic<int> writers(0);
+boost::atomic<int> max_readers(0);
+boost::atomic<bool> failed(false);
+long data = 0;
+
+const int reader_count = 4;
+const int writer_count = 2;
+const int iterations = 10000;
+
+void reader()
+{
+  for (int i = 0; i < iterations; ++i)
+  {
+    boost::shared_lock_guard<boost::big_reader_shared_mutex> lk(m);
+    int const r = readers.fetch_add(1) + 1;
+    int mr = max_readers.load();
+    while (r > mr && !max_readers.compare_exchange_weak(mr, r))
+    {
+    }
+    if (writers.load() != 0)
+      failed = true;
+    if (i % 500 == 0)
+      boost::this_thread::yield();
+    readers.fetch_sub(1);
+  }
+}
+
+void writer()
+{
+  for (int i = 0; i < iterations / 10; ++i)
+  {
+    boost::unique_lock<boost::big_reader_shared_mutex> lk(m);
+    if (writers.fetch_add(1) != 0 || readers.load() != 0)
+      failed = true;
+    ++data;
+    writers.fetch_sub(1);
+  }
+}
+
+void hold_shared()
+{
+  m.lock_shared();
+  boost::this_thread::sleep(boost::posix_time::milliseconds(250));
+  m.unlock_shared();
+}
+
+int main()
+{
+  {
+    boost::thread_group threads;
+    for (int i = 0; i < reader_count; ++i)
+      threads.create_thread(&reader);
+    for (int i = 0; i < writer_count; ++i)
+      threads.create_thread(&writer);
+    threads.join_all();
+    BOOST_TEST(!failed);
+    BOOST_TEST_EQ(data, long(writer_count) * (iterations / 10));
+    BOOST_TEST(max_readers >= 1);
+  }
+  {
+    // a reader does not block other readers
+    m.lock_shared();
+    boost::thread t(&hold_shared);
+    t.join();
+    m.unlock_shared();
+  }
+  {
+    // a writer waits for the readers
+    boost::thread t(&hold_shared);
+    boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+    BOOST_TEST(!m.try_lock());
+    m.lock();
+    m.unlock();
+    t.join();
+  }
+  {
+    // readers wait for the writer
+    m.lock();
+    BOOST_TEST(!m.try_lock_shared());
+    boost::thread t(&hold_shared);
+    boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+    m.unlock();
+    t.join();
+    BOOST_TEST(m.try_lock_shared());
+    m.unlock_shared();
+  }
+
+  return boost::report_errors();
+}
+
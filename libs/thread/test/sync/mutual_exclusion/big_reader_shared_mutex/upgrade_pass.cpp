@@ -0,0 +1,124 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/big_reader_shared_mutex.hpp>
+
+// class big_reader_shared_mutex;
+
+// Timed locks, upgrade ownership and the conversions between the ownership modes.
+
+#define BOOST_THREAD_VERSION 4
+#define BOOST_THREAD_PROVIDES_SHARED_MUTEX_UPWARDS_CONVERSIONS
+
+#include <boost/thread/big_reader_shared_mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+boost::big_reader_shared_mutex m;
+
+typedef boost::chrono::steady_clock Clock;
+typedef Clock::time_point time_point;
+typedef boost::chrono::milliseconds ms;
+
+void try_lock_times_out()
+{
+  time_point t0 = Clock::now();
+  BOOST_TEST(!m.try_lock_for(ms(100)));
+  BOOST_TEST(Clock::now() - t0 >= ms(100));
+}
+
+void try_lock_shared_times_out()
+{
+  time_point t0 = Clock::now();
+  BOOST_TEST(!m.try_lock_shared_for(ms(100)));
+  BOOST_TEST(Clock::now() - t0 >= ms(100));
+}
+
+void try_lock_upgrade_times_out()
+{
+  BOOST_TEST(!m.try_lock_upgrade());
+  BOOST_TEST(!m.try_lock_upgrade_for(ms(100)));
+}
+
+void lock_shared_succeeds()
+{
+  BOOST_TEST(m.try_lock_shared_for(ms(1000)));
+  m.unlock_shared();
+}
+
+void hold_shared()
+{
+  m.lock_shared();
+  boost::this_thread::sleep_for(ms(200));
+  m.unlock_shared();
+}
+
+int main()
+{
+  {
+    // timed locks give up, while the lock is held in a conflicting mode
+    m.lock_shared();
+    boost::thread(&try_lock_times_out).join();
+    m.unlock_shared();
+
+    m.lock();
+    boost::thread(&try_lock_shared_times_out).join();
+    boost::thread(&try_lock_upgrade_times_out).join();
+    m.unlock();
+
+    // a reader that gave up does not block the next writer
+    BOOST_TEST(m.try_lock_for(ms(100)));
+    m.unlock();
+  }
+  {
+    // upgrade ownership excludes other upgraders, but not readers
+    m.lock_upgrade();
+    boost::thread(&try_lock_upgrade_times_out).join();
+    boost::thread(&lock_shared_succeeds).join();
+    BOOST_TEST(!m.try_lock());
+
+    // upgrade -> exclusive waits for the readers
+    boost::thread t(&hold_shared);
+    boost::this_thread::sleep_for(ms(50));
+    BOOST_TEST(!m.try_unlock_upgrade_and_lock());
+    m.unlock_upgrade_and_lock();
+    t.join();
+    boost::thread(&try_lock_shared_times_out).join();
+
+    // exclusive -> upgrade -> shared
+    m.unlock_and_lock_upgrade();
+    boost::thread(&lock_shared_succeeds).join();
+    m.unlock_upgrade_and_lock_shared();
+    BOOST_TEST(m.try_lock_upgrade_for(ms(10)));
+    m.unlock_upgrade();
+    m.unlock_shared();
+  }
+  {
+    // exclusive -> shared
+    m.lock();
+    m.unlock_and_lock_shared();
+    boost::thread(&lock_shared_succeeds).join();
+    boost::thread(&try_lock_times_out).join();
+
+    // shared -> upgrade -> exclusive
+    BOOST_TEST(m.try_unlock_shared_and_lock_upgrade());
+    BOOST_TEST(m.try_unlock_upgrade_and_lock_for(ms(100)));
+    m.unlock_and_lock_shared();
+    BOOST_TEST(m.try_unlock_shared_and_lock());
+    m.unlock();
+
+    // shared -> exclusive fails, while another thread reads
+    m.lock_shared();
+    boost::thread t(&hold_shared);
+    boost::this_thread::sleep_for(ms(50));
+    BOOST_TEST(!m.try_unlock_shared_and_lock());
+    BOOST_TEST(m.try_unlock_shared_and_lock_for(ms(1000)));
+    t.join();
+    m.unlock();
+  }
+
+  return boost::report_errors();
+}
+
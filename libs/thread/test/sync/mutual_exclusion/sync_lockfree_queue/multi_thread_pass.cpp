@@ -0,0 +1,115 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/sync_lockfree_queue.hpp>
+
+// class sync_lockfree_queue<T>
+
+//    push || pull;
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/sync_lockfree_queue.hpp>
+#include <boost/thread/thread_only.hpp>
+#include <boost/thread/barrier.hpp>
+
+#include <boost/detail/lightweight_test.hpp>
+
+const int n_threads = 3;
+const int n_elems = 10000;
+
+struct call_push
+{
+  boost::sync_lockfree_queue<int> &q_;
+  boost::barrier& go_;
+
+  call_push(boost::sync_lockfree_queue<int> &q, boost::barrier &go) :
+    q_(q), go_(go)
+  {
+  }
+  typedef void result_type;
+  void operator()()
+  {
+    go_.count_down_and_wait();
+    int batch[7];
+    for (int i = 0; i < n_elems; )
+    {
+      if (i % 2)
+      {
+        q_.push(1);
+        ++i;
+      }
+      else
+      {
+        int n = 0;
+        for (; n < 7 && i < n_elems; ++n, ++i)
+          batch[n] = 1;
+        q_.push_back(batch, batch + n);
+      }
+    }
+  }
+};
+
+struct call_pull
+{
+  boost::sync_lockfree_queue<int> &q_;
+  boost::barrier& go_;
+  long& sum_;
+
+  call_pull(boost::sync_lockfree_queue<int> &q, boost::barrier &go, long &sum) :
+    q_(q), go_(go), sum_(sum)
+  {
+  }
+  typedef void result_type;
+  void operator()()
+  {
+    go_.count_down_and_wait();
+    int batch[5];
+    bool closed = false;
+    while (! closed)
+    {
+      try
+      {
+        std::size_t n = q_.pull_front(5, batch);
+        for (std::size_t i = 0; i < n; ++i)
+          sum_ += batch[i];
+      }
+      catch (boost::sync_queue_is_closed&)
+      {
+        closed = true;
+      }
+    }
+  }
+};
+
+int main()
+{
+  {
+    // producers and consumers block on a small queue, and no element is lost
+    boost::sync_lockfree_queue<int> q(4);
+    boost::barrier go(2 * n_threads);
+    boost::thread producers[n_threads];
+    boost::thread consumers[n_threads];
+    long sums[n_threads] = { 0, 0, 0 };
+    for (int i = 0; i < n_threads; ++i)
+    {
+      producers[i] = boost::thread(call_push(q, go));
+      consumers[i] = boost::thread(call_pull(q, go, sums[i]));
+    }
+    for (int i = 0; i < n_threads; ++i)
+      producers[i].join();
+    q.close();
+    long sum = 0;
+    for (int i = 0; i < n_threads; ++i)
+    {
+      consumers[i].join();
+      sum += sums[i];
+    }
+    BOOST_TEST_EQ(sum, long(n_threads) * n_elems);
+    BOOST_TEST(q.empty());
+  }
+  return boost::report_errors();
+}
+
@@ -0,0 +1,102 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/sync_lockfree_queue.hpp>
+
+// class sync_lockfree_queue<T>
+
+//    sync_lockfree_queue(size_type max_elems);
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/sync_lockfree_queue.hpp>
+
+#include <boost/detail/lightweight_test.hpp>
+
+int main()
+{
+  {
+    // default queue invariants
+    boost::sync_lockfree_queue<int> q(2);
+    BOOST_TEST(q.empty());
+    BOOST_TEST(! q.closed());
+    BOOST_TEST_EQ(q.capacity(), 2u);
+  }
+  {
+    // the capacity is rounded up to a power of two
+    boost::sync_lockfree_queue<int> q(3);
+    BOOST_TEST_EQ(q.capacity(), 4u);
+  }
+  {
+    // empty queue try_pull fails
+    boost::sync_lockfree_queue<int> q(2);
+    int i;
+    BOOST_TEST(! q.try_pull(i));
+    BOOST_TEST(! q.try_pull(boost::no_block, i));
+    BOOST_TEST(q.empty());
+  }
+  {
+    // push then pull
+    boost::sync_lockfree_queue<int> q(2);
+    q.push(1);
+    q << 2;
+    BOOST_TEST(! q.empty());
+    BOOST_TEST_EQ(q.pull(), 1);
+    int i;
+    q >> i;
+    BOOST_TEST_EQ(i, 2);
+    BOOST_TEST(q.empty());
+  }
+  {
+    // full queue try_push fails
+    boost::sync_lockfree_queue<int> q(2);
+    BOOST_TEST(q.try_push(1));
+    BOOST_TEST(q.try_push(boost::no_block, 2));
+    BOOST_TEST(! q.try_push(3));
+    int i;
+    BOOST_TEST(q.try_pull(i));
+    BOOST_TEST_EQ(i, 1);
+    BOOST_TEST(q.try_push(3));
+  }
+  {
+    // batch push then batch pull
+    boost::sync_lockfree_queue<int> q(4);
+    int in[] = { 1, 2, 3 };
+    q.push_back(in, in + 3);
+    int out[3] = { 0, 0, 0 };
+    BOOST_TEST_EQ(q.pull_front(2, out), 2u);
+    BOOST_TEST_EQ(out[0], 1);
+    BOOST_TEST_EQ(out[1], 2);
+    BOOST_TEST_EQ(q.try_pull_front(3, out), 1u);
+    BOOST_TEST_EQ(out[0], 3);
+    BOOST_TEST_EQ(q.try_pull_front(3, out), 0u);
+  }
+  {
+    // closed queue push fails, the pending elements can still be pulled
+    boost::sync_lockfree_queue<int> q(2);
+    q.push(1);
+    q.close();
+    BOOST_TEST(q.closed());
+    try {
+      q.push(2);
+      BOOST_TEST(false);
+    } catch (boost::sync_queue_is_closed&) {
+    }
+    int i;
+    bool closed;
+    q.pull(i, closed);
+    BOOST_TEST(! closed);
+    BOOST_TEST_EQ(i, 1);
+    q.pull(i, closed);
+    BOOST_TEST(closed);
+    try {
+      q.try_pull(i);
+      BOOST_TEST(false);
+    } catch (boost::sync_queue_is_closed&) {
+    }
+  }
+  return boost::report_errors();
+}
+
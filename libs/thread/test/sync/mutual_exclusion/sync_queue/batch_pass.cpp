@@ -0,0 +1,106 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/sync_queue.hpp>
+
+// class sync_queue<T>
+
+//    template <typename InputIterator> void push_back(InputIterator first, InputIterator last);
+//    template <typename OutputIterator> size_type pull_front(size_type max_elems, OutputIterator out);
+//    template <typename OutputIterator> size_type try_pull_front(size_type max_elems, OutputIterator out);
+
+#define BOOST_THREAD_VERSION 4
+
+#include <boost/thread/sync_queue.hpp>
+#include <boost/thread/thread_only.hpp>
+
+#include <boost/detail/lightweight_test.hpp>
+
+#include <vector>
+
+struct call_pull_all
+{
+  boost::sync_queue<int> &q_;
+  std::vector<int> &v_;
+
+  call_pull_all(boost::sync_queue<int> &q, std::vector<int> &v) :
+    q_(q), v_(v)
+  {
+  }
+  typedef void result_type;
+  void operator()()
+  {
+    try
+    {
+      for (;;)
+        q_.pull_front(3, std::back_inserter(v_));
+    }
+    catch (boost::sync_queue_is_closed&)
+    {
+    }
+  }
+};
+
+int main()
+{
+  {
+    // empty queue try_pull_front fails
+    boost::sync_queue<int> q;
+    int v[2];
+    BOOST_TEST_EQ(q.try_pull_front(2, v), 0u);
+    BOOST_TEST_EQ(q.pull_front(0, v), 0u);
+  }
+  {
+    // batch push then partial pulls keep the order
+    boost::sync_queue<int> q;
+    int in[] = { 1, 2, 3 };
+    q.push_back(in, in + 3);
+    BOOST_TEST(! q.empty());
+    int out[3] = { 0, 0, 0 };
+    BOOST_TEST_EQ(q.pull_front(2, out), 2u);
+    BOOST_TEST_EQ(out[0], 1);
+    BOOST_TEST_EQ(out[1], 2);
+    BOOST_TEST_EQ(q.try_pull_front(2, out), 1u);
+    BOOST_TEST_EQ(out[0], 3);
+    BOOST_TEST(q.empty());
+  }
+  {
+    // closed queue try_pull_front throws once it is empty
+    boost::sync_queue<int> q;
+    int in[] = { 1, 2 };
+    q.push_back(in, in + 2);
+    q.close();
+    int out[4];
+    BOOST_TEST_EQ(q.pull_front(4, out), 2u);
+    try {
+      q.try_pull_front(4, out);
+      BOOST_TEST(false);
+    } catch (boost::sync_queue_is_closed&) {
+    }
+    try {
+      q.push_back(in, in + 2);
+      BOOST_TEST(false);
+    } catch (boost::sync_queue_is_closed&) {
+    }
+  }
+  {
+    // a batch larger than the capacity is handed over to a concurrent consumer
+    boost::sync_queue<int> q;
+    std::vector<int> in;
+    for (int i = 0; i < 100; ++i)
+      in.push_back(i);
+    std::vector<int> out;
+    boost::thread t(call_pull_all(q, out));
+    q.push_back(in.begin(), in.end());
+    q.push_back(in.begin(), in.end());
+    q.close();
+    t.join();
+    BOOST_TEST_EQ(out.size(), 200u);
+    for (std::size_t i = 0; i < out.size(); ++i)
+      BOOST_TEST_EQ(out[i], int(i % 100));
+  }
+  return boost::report_errors();
+}
+
@@ -0,0 +1,49 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/thread.hpp>
+
+// bool this_thread::set_affinity(unsigned cpu);
+// template <class InputIterator> bool this_thread::set_affinity(InputIterator first, InputIterator last);
+// bool this_thread::set_numa_node(unsigned node);
+// bool this_thread::set_name(const char* name);
+
+#include <boost/thread/thread_only.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#include <vector>
+#include <cstring>
+
+int main()
+{
+#if defined BOOST_THREAD_HAS_AFFINITY
+  {
+    BOOST_TEST(boost::this_thread::set_affinity(0));
+    BOOST_TEST_EQ(sched_getcpu(), 0);
+    // CPU numbers that cannot be represented are refused
+    BOOST_TEST(! boost::this_thread::set_affinity(CPU_SETSIZE));
+    std::vector<unsigned> cpus;
+    for (unsigned cpu = 0; cpu < boost::thread::hardware_concurrency(); ++cpu)
+      cpus.push_back(cpu);
+    BOOST_TEST(boost::this_thread::set_affinity(cpus.begin(), cpus.end()));
+    BOOST_TEST(! boost::this_thread::set_affinity(cpus.begin(), cpus.begin()));
+  }
+  {
+    // node 0 exists on NUMA kernels, non-NUMA kernels have no nodes
+    BOOST_TEST_EQ(boost::this_thread::set_numa_node(0), boost::thread::numa_node_count() > 0);
+    BOOST_TEST(! boost::this_thread::set_numa_node(1024));
+  }
+#endif
+#if defined(__linux__) && defined(__GLIBC__)
+  {
+    BOOST_TEST(boost::this_thread::set_name("a_thread_name_longer_than_15"));
+    char name[16];
+    BOOST_TEST_EQ(pthread_getname_np(pthread_self(), name, sizeof(name)), 0);
+    BOOST_TEST(std::strcmp(name, "a_thread_name_l") == 0);
+  }
+#endif
+  return boost::report_errors();
+}
+
@@ -0,0 +1,68 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/thread.hpp>
+
+// class thread::attributes
+
+// bool set_affinity(unsigned cpu);
+// template <class InputIterator> bool set_affinity(InputIterator first, InputIterator last);
+// bool set_numa_node(unsigned node);
+// bool set_name(const char* name);
+// const char* get_name() const;
+
+#include <boost/thread/thread_only.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+#include <cstring>
+#include <string>
+
+int cpu = -1;
+std::string name;
+
+void f()
+{
+#if defined BOOST_THREAD_HAS_AFFINITY
+  cpu = sched_getcpu();
+#endif
+#if defined(__linux__) && defined(__GLIBC__)
+  char buffer[16];
+  if (pthread_getname_np(pthread_self(), buffer, sizeof(buffer)) == 0)
+    name = buffer;
+#endif
+}
+
+int main()
+{
+  {
+    boost::thread::attributes attrs;
+    BOOST_TEST(std::strcmp(attrs.get_name(), "") == 0);
+    attrs.set_name("worker-with-a-long-name");
+    // truncated to 15 characters
+    BOOST_TEST(std::strcmp(attrs.get_name(), "worker-with-a-l") == 0);
+  }
+#if defined BOOST_THREAD_HAS_AFFINITY
+  {
+    boost::thread::attributes attrs;
+    BOOST_TEST(attrs.set_affinity(0));
+    BOOST_TEST(attrs.set_name("pinned"));
+    boost::thread t(attrs, f);
+    t.join();
+    BOOST_TEST_EQ(cpu, 0);
+#if defined(__GLIBC__)
+    BOOST_TEST_EQ(name, "pinned");
+#endif
+  }
+  {
+    boost::thread::attributes attrs;
+    BOOST_TEST(! attrs.set_affinity(CPU_SETSIZE));
+    BOOST_TEST_EQ(attrs.set_numa_node(0), boost::thread::numa_node_count() > 0);
+    boost::thread t(attrs, f);
+    t.join();
+  }
+#endif
+  return boost::report_errors();
+}
+
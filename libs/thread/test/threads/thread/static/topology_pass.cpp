@@ -0,0 +1,36 @@
+// Copyright (C) 2013 Vicente J. Botet Escriba
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// <boost/thread/thread.hpp>
+
+// class thread
+
+// static unsigned physical_concurrency();
+// static unsigned numa_node_count();
+// static std::size_t cache_line_size();
+// static std::size_t cache_size(unsigned level);
+// static unsigned cache_sharing(unsigned level);
+
+#include <boost/thread/thread_only.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+int main()
+{
+  BOOST_TEST(boost::thread::physical_concurrency() > 0);
+  BOOST_TEST(boost::thread::physical_concurrency() <= boost::thread::hardware_concurrency());
+  BOOST_TEST(boost::thread::numa_node_count() <= boost::thread::hardware_concurrency());
+  // all of them may be unknown, but a known cache has a known size and its lines fit in it
+  std::size_t const line_size = boost::thread::cache_line_size();
+  BOOST_TEST(line_size == 0 || (line_size & (line_size - 1)) == 0);
+  for (unsigned level = 1; level <= 4; ++level)
+  {
+    std::size_t const size = boost::thread::cache_size(level);
+    BOOST_TEST(size == 0 || size >= line_size);
+    BOOST_TEST(boost::thread::cache_sharing(level) <= boost::thread::hardware_concurrency());
+  }
+  BOOST_TEST_EQ(boost::thread::cache_size(0), 0u);
+  return boost::report_errors();
+}
+
@@ -0,0 +1,129 @@
+
+// Copyright 2013 Daniel James.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Loads a boost::unordered_map from a vector of rows in different ways:
+// inserting one element at a time, a single range insert, a range insert
+// with a pool allocator for the nodes and moving the nodes of one container
+// into another with node handles.
+//
+// The first argument is the number of rows (default 1000000).
+
+#include <boost/unordered_map.hpp>
+#include <boost/pool/pool_alloc.hpp>
+#include <boost/timer/timer.hpp>
+#include <boost/cstdint.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+using boost::timer::cpu_timer;
+using boost::timer::cpu_times;
+
+typedef boost::uint64_t key_type;
+typedef boost::uint32_t mapped_type;
+typedef std::pair<key_type, mapped_type> row;
+
+typedef boost::unordered_map<key_type, mapped_type> map;
+
+// A pool allocator takes its nodes from large blocks of memory, so it
+// doesn't call operator new for every node. The memory is kept by the pool
+// until it is explicitly released.
+typedef boost::unordered_map<key_type, mapped_type,
+    boost::hash<key_type>, std::equal_to<key_type>,
+    boost::fast_pool_allocator<std::pair<key_type const, mapped_type> > >
+    pool_map;
+
+// Scatters the keys, so that they don't arrive in hash order.
+key_type make_key(std::size_t i)
+{
+    key_type x = key_type(i) + 1;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return x;
+}
+
+void report(char const* name, cpu_times const& t, std::size_t n)
+{
+    std::cout << "  " << name << ": "
+        << double(t.wall) / double(n) << " ns/element"
+        << boost::timer::format(t);
+}
+
+template <class Map>
+void check(Map const& m, std::size_t n)
+{
+    if (m.size() != n)
+        std::cout << "error: " << m.size() << " elements" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t const n = argc > 1 ? std::atol(argv[1]) : 1000000;
+
+    std::vector<row> rows;
+    rows.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+        rows.push_back(row(make_key(i), mapped_type(i)));
+
+    std::cout << "N = " << n << "\n\n";
+
+    {
+        cpu_timer timer;
+        map m;
+        for (std::size_t i = 0; i < n; ++i) m.insert(rows[i]);
+        report("insert loop        ", timer.elapsed(), n);
+        check(m, n);
+    }
+
+    {
+        cpu_timer timer;
+        map m;
+        m.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) m.insert(rows[i]);
+        report("reserve, loop      ", timer.elapsed(), n);
+        check(m, n);
+    }
+
+    {
+        cpu_timer timer;
+        map m(rows.begin(), rows.end());
+        report("range insert       ", timer.elapsed(), n);
+        check(m, n);
+    }
+
+    {
+        cpu_timer timer;
+        pool_map m(rows.begin(), rows.end());
+        report("range insert, pool ", timer.elapsed(), n);
+        check(m, n);
+    }
+
+    {
+        map source(rows.begin(), rows.end());
+        map m;
+        m.reserve(n);
+
+        cpu_timer timer;
+        while (!source.empty()) m.insert(source.extract(source.begin()));
+        report("move nodes         ", timer.elapsed(), n);
+        check(m, n);
+    }
+
+    {
+        map source(rows.begin(), rows.end());
+        map m;
+        m.reserve(n);
+
+        cpu_timer timer;
+        m.insert(source.begin(), source.end());
+        source.clear();
+        report("copy and clear     ", timer.elapsed(), n);
+        check(m, n);
+    }
+
+    return 0;
+}
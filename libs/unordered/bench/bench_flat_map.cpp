@@ -0,0 +1,121 @@
+
+// Copyright 2013 Daniel James.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares boost::unordered_flat_map to boost::unordered_map, with integer
+// keys: insertion, successful and failed lookup, iteration and erasure.
+//
+// The first argument is the number of elements (default 1000000).
+
+#include <boost/unordered_flat_map.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/timer/timer.hpp>
+#include <boost/cstdint.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using boost::timer::cpu_timer;
+using boost::timer::cpu_times;
+
+typedef boost::uint64_t key_type;
+typedef boost::uint32_t mapped_type;
+
+// Scatters the keys, so that they don't arrive in hash order.
+key_type make_key(std::size_t i)
+{
+    key_type x = key_type(i) + 1;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return x;
+}
+
+void report(char const* name, cpu_times const& t, std::size_t n)
+{
+    std::cout << "  " << name << ": "
+        << double(t.wall) / double(n) << " ns/element"
+        << boost::timer::format(t);
+}
+
+template <class Map>
+cpu_times time_it(std::vector<key_type> const& keys,
+        std::vector<key_type> const& missing)
+{
+    std::size_t const n = keys.size();
+    cpu_timer total;
+    cpu_timer timer;
+
+    Map m;
+    for (std::size_t i = 0; i < n; ++i)
+        m.insert(typename Map::value_type(keys[i], mapped_type(i)));
+    report("insert     ", timer.elapsed(), n);
+
+    timer.start();
+    Map r;
+    r.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+        r.insert(typename Map::value_type(keys[i], mapped_type(i)));
+    report("reserved   ", timer.elapsed(), n);
+
+    timer.start();
+    std::size_t found = 0;
+    for (std::size_t i = 0; i < n; ++i)
+        found += m.find(keys[i]) != m.end();
+    report("find       ", timer.elapsed(), n);
+
+    timer.start();
+    for (std::size_t i = 0; i < n; ++i)
+        found += m.find(missing[i]) != m.end();
+    report("find failed", timer.elapsed(), n);
+
+    timer.start();
+    boost::uint64_t sum = 0;
+    for (typename Map::const_iterator it = m.begin(), end = m.end();
+            it != end; ++it)
+        sum += it->second;
+    report("iterate    ", timer.elapsed(), n);
+
+    timer.start();
+    for (std::size_t i = 0; i < n; i += 2)
+        m.erase(keys[i]);
+    for (std::size_t i = 0; i < n; ++i)
+        found += m.find(keys[i]) != m.end();
+    report("erase, find", timer.elapsed(), n + n / 2);
+
+    total.stop();
+    if (found != n + n / 2 || m.size() != n / 2)
+        std::cout << "error: " << found << " elements found" << std::endl;
+    std::cout << "  (checksum " << sum << ")" << std::endl;
+    return total.elapsed();
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t const n = argc > 1 ? std::atol(argv[1]) : 1000000;
+
+    std::vector<key_type> keys, missing;
+    keys.reserve(n);
+    missing.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        keys.push_back(make_key(i));
+        missing.push_back(make_key(i + n));
+    }
+
+    std::cout << "N = " << n << "\n\n";
+
+    std::cout << "boost::unordered_map:" << std::endl;
+    cpu_times node = time_it<boost::unordered_map<key_type, mapped_type> >(
+        keys, missing);
+
+    std::cout << "boost::unordered_flat_map:" << std::endl;
+    cpu_times flat =
+        time_it<boost::unordered_flat_map<key_type, mapped_type> >(
+            keys, missing);
+
+    std::cout << "unordered_flat_map/unordered_map wall time: "
+        << double(flat.wall) / double(node.wall) << std::endl;
+    return 0;
+}
@@ -10,6 +10,8 @@
 #include <boost/type_traits/is_same.hpp>
 #include <boost/unordered_set.hpp>
 #include <boost/unordered_map.hpp>
+#include <boost/unordered_flat_set.hpp>
+#include <boost/unordered_flat_map.hpp>
 
 namespace test
 {
@@ -36,6 +38,18 @@ namespace test
     {
         BOOST_STATIC_CONSTANT(bool, value = true);
     };
+
+    template <class V, class H, class P, class A>
+    struct has_unique_keys<boost::unordered_flat_set<V, H, P, A> >
+    {
+        BOOST_STATIC_CONSTANT(bool, value = true);
+    };
+
+    template <class K, class M, class H, class P, class A>
+    struct has_unique_keys<boost::unordered_flat_map<K, M, H, P, A> >
+    {
+        BOOST_STATIC_CONSTANT(bool, value = true);
+    };
 }
 
 #endif
@@ -95,6 +95,22 @@ namespace test
             type;
     };
 
+    template <class V, class H, class P, class A>
+    struct ordered_base<boost::unordered_flat_set<V, H, P, A> >
+    {
+        typedef std::set<V,
+            BOOST_DEDUCED_TYPENAME equals_to_compare<P>::type>
+            type;
+    };
+
+    template <class K, class M, class H, class P, class A>
+    struct ordered_base<boost::unordered_flat_map<K, M, H, P, A> >
+    {
+        typedef std::map<K, M,
+            BOOST_DEDUCED_TYPENAME equals_to_compare<P>::type>
+            type;
+    };
+
     template <class X>
     class ordered : public ordered_base<X>::type
     {
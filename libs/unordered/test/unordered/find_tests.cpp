@@ -45,6 +45,10 @@ void find_tests1(X*, test::random_generator generator)
             BOOST_TEST(const_pos != x_const.end() &&
                     x_const.key_eq()(key, test::get_key<X>(*const_pos)));
 
+            BOOST_TEST(x.find(key, x.hash_function()(key)) == pos);
+            BOOST_TEST(x_const.find(key, x.hash_function()(key)) ==
+                    const_pos);
+
             BOOST_TEST(x.count(key) == tracker.count(key));
 
             test::compare_pairs(x.equal_range(key),
@@ -64,6 +68,7 @@ void find_tests1(X*, test::random_generator generator)
             {
                 BOOST_TEST(x.find(key) == x.end());
                 BOOST_TEST(x_const.find(key) == x_const.end());
+                BOOST_TEST(x.find(key, x.hash_function()(key)) == x.end());
                 BOOST_TEST(x.count(key) == 0);
                 std::pair<iterator, iterator> range = x.equal_range(key);
                 BOOST_TEST(range.first == range.second);
@@ -139,6 +144,71 @@ void find_compatible_keys_test(X*, test::random_generator generator)
     }
 }
 
+// Only the transparent function objects accept compatible_key, so lookup has
+// to use the transparent overloads to compile.
+
+struct transparent_hash
+{
+    typedef void is_transparent;
+
+    test::hash hash_;
+
+    std::size_t operator()(test::object const& k) const {
+        return hash_(k);
+    }
+
+    std::size_t operator()(compatible_key const& k) const {
+        return hash_(k.o_);
+    }
+};
+
+struct transparent_predicate
+{
+    typedef void is_transparent;
+
+    test::equal_to equal_;
+
+    bool operator()(test::object const& k1, test::object const& k2) const {
+        return equal_(k1, k2);
+    }
+
+    bool operator()(compatible_key const& k1, test::object const& k2) const {
+        return equal_(k1.o_, k2);
+    }
+};
+
+template <class X>
+void find_transparent_keys_test(X*, test::random_generator generator)
+{
+    typedef BOOST_DEDUCED_TYPENAME X::iterator iterator;
+    typedef BOOST_DEDUCED_TYPENAME X::const_iterator const_iterator;
+    typedef BOOST_DEDUCED_TYPENAME test::random_values<X>::iterator
+        value_iterator;
+    test::random_values<X> v(500, generator);
+    X x(v.begin(), v.end());
+    X const& x_const = x;
+
+    test::random_values<X> v2(20, generator);
+    v.insert(v2.begin(), v2.end());
+
+    for(value_iterator it = v.begin(), end = v.end(); it != end; ++it) {
+        BOOST_DEDUCED_TYPENAME X::key_type key = test::get_key<X>(*it);
+        compatible_key k(key);
+        iterator pos = x.find(key);
+
+        BOOST_TEST(x.find(k) == pos);
+        BOOST_TEST(x_const.find(k) == const_iterator(pos));
+        BOOST_TEST(x.find(k, x.hash_function()(k)) == pos);
+        BOOST_TEST(x.count(k) == x.count(key));
+
+        std::pair<iterator, iterator> range = x.equal_range(k);
+        BOOST_TEST(range == x.equal_range(key));
+        std::pair<const_iterator, const_iterator> const_range =
+            x_const.equal_range(k);
+        BOOST_TEST(const_range == x_const.equal_range(key));
+    }
+}
+
 boost::unordered_set<test::object,
     test::hash, test::equal_to,
     test::allocator2<test::object> >* test_set;
@@ -152,6 +222,19 @@ boost::unordered_multimap<test::object, test::object,
     test::hash, test::equal_to,
     test::allocator1<test::object> >* test_multimap;
 
+boost::unordered_set<test::object,
+    transparent_hash, transparent_predicate,
+    test::allocator1<test::object> >* test_transparent_set;
+boost::unordered_multiset<test::object,
+    transparent_hash, transparent_predicate,
+    test::allocator2<test::object> >* test_transparent_multiset;
+boost::unordered_map<test::object, test::object,
+    transparent_hash, transparent_predicate,
+    test::allocator1<test::object> >* test_transparent_map;
+boost::unordered_multimap<test::object, test::object,
+    transparent_hash, transparent_predicate,
+    test::allocator2<test::object> >* test_transparent_multimap;
+
 using test::default_generator;
 using test::generate_collisions;
 
@@ -163,6 +246,11 @@ UNORDERED_TEST(find_compatible_keys_test,
     ((test_set)(test_multiset)(test_map)(test_multimap))
     ((default_generator)(generate_collisions))
 )
+UNORDERED_TEST(find_transparent_keys_test,
+    ((test_transparent_set)(test_transparent_multiset)
+        (test_transparent_map)(test_transparent_multimap))
+    ((default_generator)(generate_collisions))
+)
 
 }
 
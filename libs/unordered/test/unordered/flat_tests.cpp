@@ -0,0 +1,610 @@
+// Copyright 2013 Daniel James.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Tests for the open addressing containers, which don't have a bucket
+// interface so they can't use the invariant checks of the other tests.
+
+#include "../helpers/prefix.hpp"
+#include <boost/unordered_flat_set.hpp>
+#include <boost/unordered_flat_map.hpp>
+#include "../helpers/postfix.hpp"
+
+#include "../helpers/test.hpp"
+#include "../objects/test.hpp"
+#include "../objects/cxx11_allocator.hpp"
+#include "../helpers/random_values.hpp"
+#include "../helpers/tracker.hpp"
+#include "../helpers/helpers.hpp"
+#include "../helpers/equivalent.hpp"
+#include <boost/next_prior.hpp>
+#include <string>
+#include <iterator>
+#include <cstring>
+
+#if defined(BOOST_MSVC)
+#pragma warning(disable:4127) // conditional expression is constant
+#endif
+
+namespace flat_tests
+{
+
+test::seed_t initialize_seed(13476);
+
+#if defined(BOOST_UNORDERED_USE_MOVE) || !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+#define BOOST_UNORDERED_TEST_MOVING 1
+#else
+#define BOOST_UNORDERED_TEST_MOVING 0
+#endif
+
+template <class X>
+void check_flat_invariants(X const& x)
+{
+    typedef BOOST_DEDUCED_TYPENAME X::const_iterator const_iterator;
+    typedef BOOST_DEDUCED_TYPENAME X::size_type size_type;
+
+    size_type size = 0;
+    for (const_iterator it = x.begin(), end = x.end(); it != end; ++it) {
+        ++size;
+        const_iterator pos = x.find(test::get_key<X>(*it));
+        if (pos != it) BOOST_ERROR("Unable to find element with find.");
+        if (x.count(test::get_key<X>(*it)) != 1)
+            BOOST_ERROR("Incorrect output of count.");
+    }
+
+    BOOST_TEST(x.size() == size);
+    BOOST_TEST(x.empty() == (x.begin() == x.end()));
+
+    // The capacity is zero or a power of two multiple of the group size,
+    // and is never more than 7/8 full.
+    size_type buckets = x.bucket_count();
+    BOOST_TEST(buckets == 0 ||
+        (buckets % 16 == 0 && !(buckets & (buckets - 1))));
+    BOOST_TEST(x.size() <= buckets - buckets / 8);
+    BOOST_TEST(x.load_factor() <= x.max_load_factor());
+}
+
+template <class X>
+void insert_find_tests(X*, test::random_generator generator)
+{
+    std::cerr<<"insert_find_tests.1\n";
+    {
+        test::check_instances check_;
+
+        X x;
+        check_flat_invariants(x);
+        BOOST_TEST(x.bucket_count() == 0);
+
+        test::ordered<X> tracker = test::create_ordered(x);
+        test::random_values<X> v(1000, generator);
+
+        for (BOOST_DEDUCED_TYPENAME test::random_values<X>::iterator
+                it = v.begin(); it != v.end(); ++it)
+        {
+            std::pair<BOOST_DEDUCED_TYPENAME X::iterator, bool> r1 =
+                x.insert(*it);
+            std::pair<BOOST_DEDUCED_TYPENAME test::ordered<X>::iterator,
+                bool> r2 = tracker.insert(*it);
+
+            BOOST_TEST(r1.second == r2.second);
+            BOOST_TEST(*r1.first == *r2.first);
+            tracker.compare_key(x, *it);
+        }
+
+        tracker.compare(x);
+        check_flat_invariants(x);
+    }
+
+    std::cerr<<"insert_find_tests.2\n";
+    {
+        test::check_instances check_;
+
+        test::random_values<X> v(1000, generator);
+        X x(v.begin(), v.end());
+        X const& x_const = x;
+        test::check_container(x, v);
+        check_flat_invariants(x);
+
+        test::random_values<X> v2(500, generator);
+        test::ordered<X> tracker = test::create_ordered(x);
+        tracker.insert_range(v.begin(), v.end());
+
+        for (BOOST_DEDUCED_TYPENAME test::random_values<X>::iterator
+                it = v2.begin(); it != v2.end(); ++it)
+        {
+            BOOST_DEDUCED_TYPENAME X::key_type key = test::get_key<X>(*it);
+            if (tracker.find(key) == tracker.end()) {
+                BOOST_TEST(x.find(key) == x.end());
+                BOOST_TEST(x_const.find(key) == x_const.end());
+                BOOST_TEST(x.count(key) == 0);
+                BOOST_TEST(x.equal_range(key).first == x.end());
+                BOOST_TEST(x.equal_range(key).second == x.end());
+            }
+            else {
+                tracker.compare_key(x, *it);
+            }
+        }
+    }
+}
+
+template <class X>
+void erase_tests(X*, test::random_generator generator)
+{
+    std::cerr<<"erase_tests.1\n";
+    {
+        test::check_instances check_;
+
+        test::random_values<X> v(1000, generator);
+        X x(v.begin(), v.end());
+        test::ordered<X> tracker = test::create_ordered(x);
+        tracker.insert_range(v.begin(), v.end());
+
+        int count = 0;
+        for (BOOST_DEDUCED_TYPENAME test::random_values<X>::iterator
+                it = v.begin(); it != v.end(); ++it)
+        {
+            if (++count % 2) continue;
+            BOOST_DEDUCED_TYPENAME X::key_type key = test::get_key<X>(*it);
+            BOOST_TEST(x.erase(key) == tracker.erase(key));
+            BOOST_TEST(x.find(key) == x.end());
+        }
+
+        tracker.compare(x);
+        check_flat_invariants(x);
+    }
+
+    std::cerr<<"erase_tests.2\n";
+    {
+        test::check_instances check_;
+
+        test::random_values<X> v(1000, generator);
+        X x(v.begin(), v.end());
+        std::size_t size = x.size();
+
+        while (size) {
+            BOOST_DEDUCED_TYPENAME X::key_type key =
+                test::get_key<X>(*x.begin());
+            BOOST_DEDUCED_TYPENAME X::iterator next = x.erase(x.begin());
+            --size;
+            BOOST_TEST(x.size() == size);
+            BOOST_TEST(next == x.begin());
+            BOOST_TEST(x.find(key) == x.end());
+        }
+
+        BOOST_TEST(x.empty());
+        check_flat_invariants(x);
+    }
+
+    std::cerr<<"erase_tests.3\n";
+    {
+        test::check_instances check_;
+
+        test::random_values<X> v(500, generator);
+        X x(v.begin(), v.end());
+        std::size_t size = x.size();
+
+        BOOST_DEDUCED_TYPENAME X::const_iterator first =
+            boost::next(x.cbegin(), static_cast<std::ptrdiff_t>(size / 4));
+        BOOST_DEDUCED_TYPENAME X::const_iterator last =
+            boost::next(first, static_cast<std::ptrdiff_t>(size / 2));
+        test::ordered<X> tracker = test::create_ordered(x);
+        tracker.insert_range(x.cbegin(), first);
+        tracker.insert_range(last, x.cend());
+
+        BOOST_TEST(x.erase(first, last) == last);
+        tracker.compare(x);
+        BOOST_TEST(x.erase(x.begin(), x.end()) == x.end());
+        BOOST_TEST(x.empty());
+        check_flat_invariants(x);
+    }
+
+    std::cerr<<"erase_tests.4\n";
+    {
+        // Erase and insert over and over, the tombstones have to be cleaned
+        // up without the table growing.
+        test::check_instances check_;
+
+        test::random_values<X> v(2000, generator);
+        X x;
+        test::ordered<X> tracker = test::create_ordered(x);
+
+        BOOST_DEDUCED_TYPENAME test::random_values<X>::iterator
+            it = v.begin(), erase_it = v.begin();
+        for (int i = 0; i < 100 && it != v.end(); ++i, ++it) {
+            x.insert(*it);
+            tracker.insert(*it);
+        }
+        std::size_t buckets = x.bucket_count();
+
+        for (; it != v.end(); ++it, ++erase_it) {
+            x.erase(test::get_key<X>(*erase_it));
+            tracker.erase(test::get_key<X>(*erase_it));
+            x.insert(*it);
+            tracker.insert(*it);
+        }
+
+        tracker.compare(x);
+        check_flat_invariants(x);
+        BOOST_TEST(x.bucket_count() <= buckets * 2);
+    }
+}
+
+template <class X>
+void rehash_tests(X*, test::random_generator generator)
+{
+    std::cerr<<"rehash_tests.1\n";
+    {
+        test::check_instances check_;
+
+        X x;
+        x.rehash(0);
+        BOOST_TEST(x.bucket_count() == 0);
+        x.rehash(100);
+        BOOST_TEST(x.bucket_count() >= 100);
+        x.rehash(0);
+        BOOST_TEST(x.bucket_count() == 0);
+
+        X y(1000);
+        BOOST_TEST(y.bucket_count() >= 1000);
+        check_flat_invariants(y);
+    }
+
+    std::cerr<<"rehash_tests.2\n";
+    {
+        test::check_instances check_;
+
+        test::random_values<X> v(1000, generator);
+        X x;
+        x.reserve(v.size());
+        std::size_t buckets = x.bucket_count();
+        x.insert(v.begin(), v.end());
+        BOOST_TEST(x.bucket_count() == buckets);
+        test::check_container(x, v);
+
+        x.rehash(x.bucket_count() * 4);
+        BOOST_TEST(x.bucket_count() >= buckets * 4);
+        test::check_container(x, v);
+        check_flat_invariants(x);
+
+        x.rehash(0);
+        BOOST_TEST(x.bucket_count() <= buckets);
+        test::check_container(x, v);
+        check_flat_invariants(x);
+
+        buckets = x.bucket_count();
+        x.clear();
+        BOOST_TEST(x.empty());
+        BOOST_TEST(x.bucket_count() == buckets);
+        check_flat_invariants(x);
+        x.insert(v.begin(), v.end());
+        test::check_container(x, v);
+    }
+}
+
+template <class X>
+void copy_move_tests(X*, test::random_generator generator)
+{
+    BOOST_DEDUCED_TYPENAME X::hasher hf1(1);
+    BOOST_DEDUCED_TYPENAME X::key_equal eq1(1);
+    BOOST_DEDUCED_TYPENAME X::allocator_type al1(1);
+    BOOST_DEDUCED_TYPENAME X::allocator_type al2(2);
+
+    std::cerr<<"copy_move_tests.1\n";
+    {
+        test::check_instances check_;
+
+        test::random_values<X> v(1000, generator);
+        X x(v.begin(), v.end(), 0, hf1, eq1, al1);
+
+        X y(x);
+        test::check_container(y, v);
+        BOOST_TEST(test::equivalent(y.hash_function(), hf1));
+        BOOST_TEST(test::equivalent(y.key_eq(), eq1));
+        BOOST_TEST(x == y);
+
+        X z(x, al2);
+        test::check_container(z, v);
+        BOOST_TEST(test::equivalent(z.get_allocator(), al2));
+        check_flat_invariants(z);
+
+        X w(boost::move(y));
+        test::check_container(w, v);
+#if BOOST_UNORDERED_TEST_MOVING
+        BOOST_TEST(y.empty());
+#endif
+        check_flat_invariants(y);
+        y.clear();
+        y.insert(v.begin(), v.end());
+        test::check_container(y, v);
+    }
+
+    std::cerr<<"copy_move_tests.2\n";
+    {
+        test::check_instances check_;
+
+        test::random_values<X> v1(500, generator), v2(100, generator);
+        X x1(v1.begin(), v1.end(), 0, hf1, eq1, al1);
+        X x2(v2.begin(), v2.end(), 0, BOOST_DEDUCED_TYPENAME X::hasher(),
+            BOOST_DEDUCED_TYPENAME X::key_equal(), al2);
+
+        x2 = x1;
+        test::check_container(x2, v1);
+        BOOST_TEST(test::equivalent(x2.hash_function(), hf1));
+        BOOST_TEST(test::equivalent(x2.key_eq(), eq1));
+        check_flat_invariants(x2);
+
+        X x3(v2.begin(), v2.end(), 0, BOOST_DEDUCED_TYPENAME X::hasher(),
+            BOOST_DEDUCED_TYPENAME X::key_equal(), al2);
+        x3 = boost::move(x2);
+        test::check_container(x3, v1);
+        check_flat_invariants(x3);
+
+        x1.swap(x1);
+        test::check_container(x1, v1);
+    }
+
+    std::cerr<<"copy_move_tests.3\n";
+    {
+        test::check_instances check_;
+
+        test::random_values<X> v1(500, generator), v2(100, generator);
+        X x1(v1.begin(), v1.end(), 0, hf1, eq1, al1);
+        X x2(v2.begin(), v2.end(), 0, BOOST_DEDUCED_TYPENAME X::hasher(),
+            BOOST_DEDUCED_TYPENAME X::key_equal(), al1);
+
+        x1.swap(x2);
+        test::check_container(x1, v2);
+        test::check_container(x2, v1);
+        BOOST_TEST(test::equivalent(x2.hash_function(), hf1));
+        BOOST_TEST(test::equivalent(x2.key_eq(), eq1));
+
+        boost::swap(x1, x2);
+        test::check_container(x1, v1);
+        test::check_container(x2, v2);
+    }
+}
+
+template <class X>
+void equality_tests(X*, test::random_generator generator)
+{
+    test::check_instances check_;
+
+    test::random_values<X> v(500, generator);
+    X x1(v.begin(), v.end());
+    X x2;
+
+    BOOST_TEST(x1 != x2);
+    BOOST_TEST(!(x1 == x2));
+
+    // Insert in a different order, with a different capacity.
+    x2.rehash(x1.bucket_count() * 2);
+    // Copy the values from x1, the generated values can contain a key more
+    // than once, with different mapped values.
+    test::list<BOOST_DEDUCED_TYPENAME X::value_type> values(
+        x1.begin(), x1.end());
+    values.sort();
+    x2.insert(values.begin(), values.end());
+    BOOST_TEST(x1 == x2);
+    BOOST_TEST(!(x1 != x2));
+
+    x2.erase(x2.begin());
+    BOOST_TEST(x1 != x2);
+}
+
+template <class X>
+void compatible_keys_tests(X*, test::random_generator generator)
+{
+    test::random_values<X> v(500, generator);
+    X x(v.begin(), v.end());
+
+    test::hash hf;
+    test::equal_to eq;
+
+    for (BOOST_DEDUCED_TYPENAME test::random_values<X>::iterator
+            it = v.begin(); it != v.end(); ++it)
+    {
+        BOOST_DEDUCED_TYPENAME X::key_type key = test::get_key<X>(*it);
+        BOOST_TEST(x.find(key) == x.find(key, hf, eq));
+        BOOST_TEST(x.find(key) == x.find(key, x.hash_function()(key)));
+    }
+}
+
+struct transparent_string_hash
+{
+    typedef void is_transparent;
+
+    std::size_t operator()(std::string const& x) const {
+        return boost::hash_range(x.begin(), x.end());
+    }
+
+    std::size_t operator()(char const* x) const {
+        return boost::hash_range(x, x + std::strlen(x));
+    }
+};
+
+struct transparent_string_equal
+{
+    typedef void is_transparent;
+
+    bool operator()(std::string const& x, std::string const& y) const {
+        return x == y;
+    }
+
+    bool operator()(char const* x, std::string const& y) const {
+        return y == x;
+    }
+};
+
+boost::unordered_flat_set<test::object,
+    test::hash, test::equal_to,
+    test::allocator1<test::object> >* test_set;
+boost::unordered_flat_map<test::object, test::object,
+    test::hash, test::equal_to,
+    test::allocator1<test::object> >* test_map;
+
+boost::unordered_flat_set<test::object,
+        test::hash, test::equal_to,
+        test::cxx11_allocator<test::object, test::propagate_swap> >*
+    test_set_prop_swap;
+boost::unordered_flat_map<test::object, test::object,
+        test::hash, test::equal_to,
+        test::cxx11_allocator<test::object, test::propagate_swap> >*
+    test_map_prop_swap;
+
+boost::unordered_flat_set<test::object,
+        test::hash, test::equal_to,
+        test::cxx11_allocator<test::object, test::propagate_assign> >*
+    test_set_prop_assign;
+boost::unordered_flat_map<test::object, test::object,
+        test::hash, test::equal_to,
+        test::cxx11_allocator<test::object, test::propagate_assign> >*
+    test_map_prop_assign;
+
+boost::unordered_flat_set<test::object,
+        test::hash, test::equal_to,
+        test::cxx11_allocator<test::object, test::propagate_move> >*
+    test_set_prop_move;
+boost::unordered_flat_map<test::object, test::object,
+        test::hash, test::equal_to,
+        test::cxx11_allocator<test::object, test::propagate_move> >*
+    test_map_prop_move;
+
+using test::default_generator;
+using test::generate_collisions;
+
+UNORDERED_TEST(insert_find_tests,
+    ((test_set)(test_map))
+    ((default_generator)(generate_collisions))
+)
+UNORDERED_TEST(erase_tests,
+    ((test_set)(test_map))
+    ((default_generator)(generate_collisions))
+)
+UNORDERED_TEST(rehash_tests,
+    ((test_set)(test_map))
+    ((default_generator)(generate_collisions))
+)
+UNORDERED_TEST(copy_move_tests,
+    ((test_set)(test_map)
+        (test_set_prop_swap)(test_map_prop_swap)
+        (test_set_prop_assign)(test_map_prop_assign)
+        (test_set_prop_move)(test_map_prop_move))
+    ((default_generator)(generate_collisions))
+)
+UNORDERED_TEST(equality_tests,
+    ((test_set)(test_map))
+    ((default_generator)(generate_collisions))
+)
+UNORDERED_TEST(compatible_keys_tests,
+    ((test_set)(test_map))
+    ((default_generator)(generate_collisions))
+)
+
+UNORDERED_AUTO_TEST(map_access_tests)
+{
+    boost::unordered_flat_map<std::string, int> x;
+
+    x["one"] = 1;
+    x["two"] = 2;
+    BOOST_TEST(x.size() == 2);
+    BOOST_TEST(x["one"] == 1);
+    BOOST_TEST(x.at("two") == 2);
+
+    try {
+        x.at("three");
+        BOOST_ERROR("Should have thrown.");
+    }
+    catch(std::out_of_range&) {
+    }
+
+    BOOST_TEST(x.emplace("three", 3).second);
+    BOOST_TEST(!x.emplace("three", 4).second);
+    BOOST_TEST(x.at("three") == 3);
+
+    BOOST_TEST(x.emplace(boost::unordered::piecewise_construct,
+        boost::make_tuple("four"), boost::make_tuple(4)).second);
+    BOOST_TEST(x["four"] == 4);
+
+    boost::unordered_flat_map<std::string, int>::iterator it =
+        x.emplace_hint(x.cbegin(), std::make_pair(std::string("five"), 5));
+    BOOST_TEST(it->first == "five" && it->second == 5);
+    BOOST_TEST(x.insert(x.cend(), std::make_pair(std::string("five"), 6)) == it);
+    BOOST_TEST(x.size() == 5);
+
+    // Keep the values after a rehash.
+    for (int i = 0; i < 1000; ++i) x[std::string(1, static_cast<char>(i % 128))
+        + std::string(1, static_cast<char>(i / 128))] = i;
+    BOOST_TEST(x.at("one") == 1);
+    BOOST_TEST(x.at("five") == 5);
+    check_flat_invariants(x);
+}
+
+// The arguments to emplace can refer to an element which is moved when the
+// insert rehashes the table.
+UNORDERED_AUTO_TEST(emplace_aliasing_tests)
+{
+    boost::unordered_flat_map<int, std::string> x;
+    std::string const value(100, 'x');
+    x.emplace(-1, value);
+
+    for (int i = 0; i < 200; ++i) {
+        BOOST_TEST(x.emplace(i, x.begin()->second).second);
+        BOOST_TEST(x.at(i) == value);
+    }
+
+    for (int i = -1; i < 200; ++i) BOOST_TEST(x.at(i) == value);
+    check_flat_invariants(x);
+}
+
+UNORDERED_AUTO_TEST(transparent_tests)
+{
+    typedef boost::unordered_flat_map<std::string, int,
+        transparent_string_hash, transparent_string_equal> map;
+    typedef boost::unordered_flat_set<std::string,
+        transparent_string_hash, transparent_string_equal> set;
+
+    map x;
+    set y;
+    for (int i = 0; i < 100; ++i) {
+        x[std::string(1, static_cast<char>('a' + i % 26)) +
+            static_cast<char>('a' + i / 26)] = i;
+    }
+    x["one"] = 1;
+    y.insert("one");
+    y.insert("two");
+
+    char const* one = "one";
+    BOOST_TEST(x.find(one) != x.end() && x.find(one)->second == 1);
+    BOOST_TEST(x.find("two") == x.end());
+    BOOST_TEST(x.count(one) == 1 && x.count("two") == 0);
+    BOOST_TEST(x.equal_range(one).first == x.find(one));
+    BOOST_TEST(y.find(one) != y.end() && y.count("two") == 1);
+
+    // Hash once, look up in both containers.
+    std::size_t hash = x.hash_function()(one);
+    BOOST_TEST(x.find(one, hash) == x.find(one));
+    BOOST_TEST(y.find(one, hash) == y.find(one));
+    BOOST_TEST(y.find(std::string("one"), hash) == y.find(one));
+
+    map const& x_const = x;
+    BOOST_TEST(x_const.find(one) == x.find(one));
+    BOOST_TEST(x_const.equal_range("three").first == x_const.end());
+}
+
+#if !defined(BOOST_NO_CXX11_HDR_INITIALIZER_LIST)
+
+UNORDERED_AUTO_TEST(initializer_list_tests)
+{
+    boost::unordered_flat_set<int> x = { 1, 2, 3, 1 };
+    BOOST_TEST(x.size() == 3);
+    x = { 4, 5 };
+    BOOST_TEST(x.size() == 2 && x.count(4) && !x.count(1));
+    x.insert({ 6, 7 });
+    BOOST_TEST(x.size() == 4);
+}
+
+#endif
+
+}
+
+RUN_TESTS()
@@ -0,0 +1,261 @@
+
+// Copyright 2013 Daniel James.
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "../helpers/prefix.hpp"
+#include <boost/unordered_set.hpp>
+#include <boost/unordered_map.hpp>
+#include "../helpers/postfix.hpp"
+
+#include "../helpers/test.hpp"
+#include <boost/next_prior.hpp>
+#include "../objects/test.hpp"
+#include "../helpers/random_values.hpp"
+#include "../helpers/tracker.hpp"
+#include "../helpers/equivalent.hpp"
+#include "../helpers/helpers.hpp"
+#include "../helpers/invariants.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace node_handle_tests
+{
+
+test::seed_t initialize_seed(27184);
+
+template <class N, class K, class T, class A>
+K const& node_key(boost::unordered::node_handle_map<N, K, T, A> const& n)
+{
+    return n.key();
+}
+
+template <class N, class T, class A>
+T const& node_key(boost::unordered::node_handle_set<N, T, A> const& n)
+{
+    return n.value();
+}
+
+template <class Container>
+void extract_tests1(Container*, test::random_generator generator)
+{
+    typedef BOOST_DEDUCED_TYPENAME Container::node_type node_type;
+
+    std::cerr<<"Extract by key.\n";
+    {
+        test::check_instances check_;
+
+        test::random_values<Container> v(1000, generator);
+        Container x(v.begin(), v.end());
+        Container y;
+        int iterations = 0;
+        for(BOOST_DEDUCED_TYPENAME test::random_values<Container>::iterator
+            it = v.begin(); it != v.end(); ++it)
+        {
+            BOOST_DEDUCED_TYPENAME Container::key_type const&
+                key = test::get_key<Container>(*it);
+            std::size_t count = x.count(key);
+            std::size_t old_size = x.size();
+
+            node_type n = x.extract(key);
+            if (count) {
+                BOOST_TEST(!n.empty());
+                BOOST_TEST(node_key(n) == key);
+                BOOST_TEST(x.count(key) == count - 1);
+                BOOST_TEST(x.size() == old_size - 1);
+                y.insert(boost::move(n));
+                BOOST_TEST(n.empty());
+            }
+            else {
+                BOOST_TEST(n.empty());
+                BOOST_TEST(!n);
+                BOOST_TEST(x.size() == old_size);
+            }
+            if (++iterations % 20 == 0) {
+                test::check_equivalent_keys(x);
+                test::check_equivalent_keys(y);
+            }
+        }
+
+        // Every element in 'v' was extracted, so all the nodes are in 'y'.
+        BOOST_TEST(x.empty());
+        BOOST_TEST(y == Container(v.begin(), v.end()));
+        test::check_equivalent_keys(y);
+    }
+
+    std::cerr<<"Extract by iterator.\n";
+    {
+        test::check_instances check_;
+
+        test::random_values<Container> v(1000, generator);
+        Container x(v.begin(), v.end());
+        std::size_t size = x.size();
+        int iterations = 0;
+        while(size > 0 && !x.empty())
+        {
+            using namespace std;
+            int index = rand() % (int) x.size();
+            BOOST_DEDUCED_TYPENAME Container::const_iterator
+                pos = boost::next(x.cbegin(), index);
+            BOOST_DEDUCED_TYPENAME Container::key_type
+                key = test::get_key<Container>(*pos);
+            std::size_t count = x.count(key);
+
+            // The node handle is destroyed at the end of the loop, and frees
+            // the element.
+            node_type n = x.extract(pos);
+            --size;
+            BOOST_TEST(!n.empty());
+            BOOST_TEST(node_key(n) == key);
+            BOOST_TEST(x.count(key) == count - 1);
+            BOOST_TEST(x.size() == size);
+            if (++iterations % 20 == 0) test::check_equivalent_keys(x);
+        }
+        BOOST_TEST(x.empty());
+    }
+
+    std::cerr<<"Move and swap node handles.\n";
+    {
+        test::check_instances check_;
+
+        test::random_values<Container> v(10, generator);
+        Container x(v.begin(), v.end());
+        std::size_t size = x.size();
+
+        node_type n1 = x.extract(x.cbegin());
+        node_type n2;
+        BOOST_TEST(!n1.empty() && n2.empty());
+
+        n2 = boost::move(n1);
+        BOOST_TEST(n1.empty() && !n2.empty());
+
+        swap(n1, n2);
+        BOOST_TEST(!n1.empty() && n2.empty());
+
+        n2 = x.extract(x.cbegin());
+        n1.swap(n2);
+        BOOST_TEST(!n1.empty() && !n2.empty());
+        BOOST_TEST(n1.get_allocator() == x.get_allocator());
+
+        x.insert(x.cbegin(), boost::move(n1));
+        x.insert(boost::move(n2));
+        BOOST_TEST(x.size() == size);
+        BOOST_TEST(x == Container(v.begin(), v.end()));
+    }
+
+    std::cerr<<"\n";
+}
+
+UNORDERED_AUTO_TEST(insert_node_unique_tests)
+{
+    typedef boost::unordered_map<int, int> map;
+    typedef boost::unordered_set<int> set;
+
+    map x, y;
+    for (int i = 0; i < 10; ++i) x[i] = i * 2;
+    y[5] = 100;
+
+    map::insert_return_type r = y.insert(x.extract(1));
+    BOOST_TEST(r.inserted);
+    BOOST_TEST(r.node.empty());
+    BOOST_TEST(r.position == y.find(1));
+    BOOST_TEST(r.position->second == 2);
+
+    // A failed insert returns the node, and leaves the existing element.
+    r = y.insert(x.extract(5));
+    BOOST_TEST(!r.inserted);
+    BOOST_TEST(!r.node.empty());
+    BOOST_TEST(r.node.key() == 5 && r.node.mapped() == 10);
+    BOOST_TEST(r.position == y.find(5));
+    BOOST_TEST(r.position->second == 100);
+    BOOST_TEST(x.size() == 8 && y.size() == 2);
+
+    // The key can be changed while the node isn't in a container.
+    r.node.key() = 20;
+    map::iterator pos = y.insert(y.cend(), boost::move(r.node));
+    BOOST_TEST(r.node.empty());
+    BOOST_TEST(pos == y.find(20));
+    BOOST_TEST(pos->second == 10);
+
+    map::node_type empty;
+    r = y.insert(boost::move(empty));
+    BOOST_TEST(!r.inserted);
+    BOOST_TEST(r.node.empty());
+    BOOST_TEST(r.position == y.end());
+    BOOST_TEST(y.insert(y.cbegin(), boost::move(empty)) == y.end());
+
+    set s1, s2;
+    s1.insert(1);
+    s1.insert(2);
+    s2.insert(2);
+
+    set::node_type n = s1.extract(2);
+    BOOST_TEST(n.value() == 2);
+    set::iterator it = s2.insert(s2.cbegin(), boost::move(n));
+    BOOST_TEST(*it == 2);
+    BOOST_TEST(!n.empty());
+    BOOST_TEST(s1.size() == 1 && s2.size() == 1);
+
+    n.value() = 3;
+    set::insert_return_type r2 = s2.insert(boost::move(n));
+    BOOST_TEST(r2.inserted && *r2.position == 3 && r2.node.empty());
+    BOOST_TEST(s2.size() == 2);
+    BOOST_TEST(s1.extract(10).empty());
+}
+
+UNORDERED_AUTO_TEST(insert_range_bucket_count_tests)
+{
+    // When a range insert from forward iterators has to create buckets, it
+    // creates enough for the rest of the range, so it gets the same bucket
+    // count as reserve. The elements here have to be constructed before
+    // their keys can be looked up.
+    static char const* words[] = { "zero", "one", "two", "three", "four",
+        "five", "six", "seven", "eight", "nine" };
+    std::vector<char const*> values;
+    for (int i = 0; i < 1000; ++i) values.push_back(words[i % 10] + i % 3);
+
+    boost::unordered_set<std::string> x;
+    x.insert(values.begin(), values.end());
+
+    boost::unordered_set<std::string> y;
+    y.reserve(values.size());
+    BOOST_TEST(x.bucket_count() == y.bucket_count());
+
+    std::vector<std::pair<int, int> > pairs;
+    for (int i = 0; i < 10000; ++i) pairs.push_back(std::make_pair(i / 3, i));
+
+    boost::unordered_multimap<int, int> z;
+    z.insert(pairs.begin(), pairs.end());
+
+    boost::unordered_multimap<int, int> w;
+    w.reserve(pairs.size());
+    BOOST_TEST(z.bucket_count() == w.bucket_count());
+    test::check_equivalent_keys(z);
+}
+
+boost::unordered_set<test::object,
+    test::hash, test::equal_to,
+    test::allocator1<test::object> >* test_set;
+boost::unordered_multiset<test::object,
+    test::hash, test::equal_to,
+    test::allocator2<test::object> >* test_multiset;
+boost::unordered_map<test::object, test::object,
+    test::hash, test::equal_to,
+    test::allocator1<test::object> >* test_map;
+boost::unordered_multimap<test::object, test::object,
+    test::hash, test::equal_to,
+    test::allocator2<test::object> >* test_multimap;
+
+using test::default_generator;
+using test::generate_collisions;
+
+UNORDERED_TEST(extract_tests1,
+    ((test_set)(test_multiset)(test_map)(test_multimap))
+    ((default_generator)(generate_collisions))
+)
+
+}
+
+RUN_TESTS()